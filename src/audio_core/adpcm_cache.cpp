@@ -0,0 +1,169 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "audio_core/adpcm_cache.h"
+#include "common/cityhash.h"
+#include "core/memory.h"
+
+namespace AudioCore {
+namespace {
+constexpr std::size_t FRAME_LEN = 8;
+constexpr std::size_t SAMPLES_PER_FRAME = 14;
+
+bool operator==(const ADPCMContext& lhs, const ADPCMContext& rhs) {
+    return lhs.header == rhs.header && lhs.yn1 == rhs.yn1 && lhs.yn2 == rhs.yn2;
+}
+} // Anonymous namespace
+
+void DecodeAdpcmSamples(std::span<const u8> frames, std::size_t first_sample,
+                        const Codec::ADPCM_Coeff& coeffs, ADPCMContext& context,
+                        std::span<s16> output) {
+    static constexpr std::array<s32, 16> SIGNED_NIBBLES{
+        0, 1, 2, 3, 4, 5, 6, 7, -8, -7, -6, -5, -4, -3, -2, -1,
+    };
+
+    s32 idx = (context.header >> 4) & 0xf;
+    s32 scale = context.header & 0xf;
+    s32 coef1 = coeffs[idx * 2];
+    s32 coef2 = coeffs[idx * 2 + 1];
+    s16 yn1 = context.yn1;
+    s16 yn2 = context.yn2;
+
+    const std::size_t first_frame = first_sample / SAMPLES_PER_FRAME;
+    for (std::size_t i = 0; i < output.size(); ++i) {
+        const std::size_t sample = first_sample + i;
+        const std::size_t frame_offset = (sample / SAMPLES_PER_FRAME - first_frame) * FRAME_LEN;
+        const std::size_t index = sample % SAMPLES_PER_FRAME;
+        if (index == 0) {
+            context.header = frames[frame_offset];
+            idx = (context.header >> 4) & 0xf;
+            scale = context.header & 0xf;
+            coef1 = coeffs[idx * 2];
+            coef2 = coeffs[idx * 2 + 1];
+        }
+        const u8 data = frames[frame_offset + 1 + index / 2];
+        const s32 nibble = SIGNED_NIBBLES[index % 2 == 0 ? data >> 4 : data & 0xf];
+
+        const s32 xn = nibble * (1 << scale);
+        // We first transform everything into 11 bit fixed point, perform the second order
+        // digital filter, then transform back.
+        // 0x400 == 0.5 in 11 bit fixed point.
+        // Filter: y[n] = x[n] + 0.5 + c1 * y[n-1] + c2 * y[n-2]
+        const s32 val = ((xn << 11) + 0x400 + coef1 * yn1 + coef2 * yn2) >> 11;
+        // Clamp to output range and advance output feedback.
+        yn2 = yn1;
+        yn1 = static_cast<s16>(std::clamp<s32>(val, -32768, 32767));
+        output[i] = yn1;
+    }
+    context.yn1 = yn1;
+    context.yn2 = yn2;
+}
+
+std::vector<u8> ReadAdpcmFrames(Core::Memory::Memory& memory, VAddr address,
+                                std::size_t first_sample, std::size_t sample_count) {
+    if (sample_count == 0) {
+        return {};
+    }
+    const std::size_t first_frame = first_sample / SAMPLES_PER_FRAME;
+    const std::size_t last_frame = (first_sample + sample_count - 1) / SAMPLES_PER_FRAME;
+    std::vector<u8> frames((last_frame - first_frame + 1) * FRAME_LEN);
+    memory.ReadBlock(address + first_frame * FRAME_LEN, frames.data(), frames.size());
+    return frames;
+}
+
+AdpcmCache::Entry::Entry(std::vector<u8> frames_, std::size_t start_sample_,
+                         std::size_t sample_count, const Codec::ADPCM_Coeff& coeffs,
+                         const ADPCMContext& initial_context_)
+    : frames{std::move(frames_)}, samples(sample_count), start_sample{start_sample_},
+      initial_context{initial_context_} {
+    ADPCMContext context = initial_context;
+    DecodeAdpcmSamples(frames, start_sample, coeffs, context, samples);
+}
+
+ADPCMContext AdpcmCache::Entry::ContextAt(std::size_t num_samples) const {
+    if (num_samples == 0) {
+        return initial_context;
+    }
+    ADPCMContext context = initial_context;
+    const std::size_t last_sample = start_sample + num_samples - 1;
+    const std::size_t frame_start = last_sample - last_sample % SAMPLES_PER_FRAME;
+    if (frame_start >= start_sample) {
+        // The header of the last frame was read while decoding
+        const std::size_t first_frame = start_sample / SAMPLES_PER_FRAME;
+        context.header = frames[(frame_start / SAMPLES_PER_FRAME - first_frame) * FRAME_LEN];
+    }
+    context.yn1 = samples[num_samples - 1];
+    context.yn2 = num_samples >= 2 ? samples[num_samples - 2] : initial_context.yn1;
+    return context;
+}
+
+std::size_t AdpcmCache::KeyHash::operator()(const Key& key) const noexcept {
+    return static_cast<std::size_t>(
+        Common::CityHash64(reinterpret_cast<const char*>(&key), sizeof(key)));
+}
+
+std::shared_ptr<const AdpcmCache::Entry> AdpcmCache::Get(Core::Memory::Memory& memory,
+                                                        VAddr address, s32 start_sample,
+                                                        s32 end_sample,
+                                                        const Codec::ADPCM_Coeff& coeffs,
+                                                        s32 offset, const ADPCMContext& context) {
+    if (start_sample < 0 || end_sample <= start_sample || offset < 0) {
+        return nullptr;
+    }
+    const auto sample_count = static_cast<std::size_t>(end_sample - start_sample);
+    if (sample_count > MAX_CACHED_SAMPLES) {
+        return nullptr;
+    }
+    const Key key{
+        .address = address,
+        .start_sample = start_sample,
+        .end_sample = end_sample,
+        .coeffs = coeffs,
+    };
+    std::shared_ptr<const Entry> entry;
+    {
+        std::scoped_lock lock{mutex};
+        const auto it = entries.find(key);
+        if (it != entries.end()) {
+            entry = it->second;
+        }
+    }
+    if (offset > 0) {
+        // Mid pass, the cached samples are only valid if they were decoded from the same state
+        if (entry && entry->ContextAt(static_cast<std::size_t>(offset)) == context) {
+            return entry;
+        }
+        return nullptr;
+    }
+
+    // A new pass begins, make sure the guest hasn't modified the wave buffer since it was decoded
+    std::vector<u8> frames =
+        ReadAdpcmFrames(memory, address, static_cast<std::size_t>(start_sample), sample_count);
+    if (entry && entry->InitialContext() == context && entry->Frames().size() == frames.size() &&
+        std::memcmp(entry->Frames().data(), frames.data(), frames.size()) == 0) {
+        return entry;
+    }
+    auto new_entry = std::make_shared<const Entry>(
+        std::move(frames), static_cast<std::size_t>(start_sample), sample_count, coeffs, context);
+    const std::size_t entry_size = new_entry->Samples().size_bytes() + new_entry->Frames().size();
+
+    std::scoped_lock lock{mutex};
+    if (cache_size + entry_size > MAX_CACHE_SIZE) {
+        entries.clear();
+        cache_size = 0;
+    }
+    auto [it, is_new] = entries.try_emplace(key);
+    if (!is_new) {
+        cache_size -= it->second->Samples().size_bytes() + it->second->Frames().size();
+    }
+    it->second = new_entry;
+    cache_size += entry_size;
+    return new_entry;
+}
+
+} // namespace AudioCore
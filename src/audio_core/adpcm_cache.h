@@ -0,0 +1,106 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "audio_core/codec.h"
+#include "audio_core/voice_context.h"
+#include "common/common_types.h"
+
+namespace Core::Memory {
+class Memory;
+}
+
+namespace AudioCore {
+
+/**
+ * Decodes ADPCM samples starting at an absolute sample position of a wave buffer
+ * @param frames Encoded data, starting at the frame containing first_sample
+ * @param first_sample Absolute position of the first sample to decode
+ * @param coeffs ADPCM coefficients
+ * @param context Decoder context, this is updated with the new state
+ * @param output Decoded samples, its size is the number of samples to decode
+ */
+void DecodeAdpcmSamples(std::span<const u8> frames, std::size_t first_sample,
+                        const Codec::ADPCM_Coeff& coeffs, ADPCMContext& context,
+                        std::span<s16> output);
+
+/// Reads the ADPCM frames holding sample_count samples starting at first_sample
+std::vector<u8> ReadAdpcmFrames(Core::Memory::Memory& memory, VAddr address,
+                                std::size_t first_sample, std::size_t sample_count);
+
+/// Cache of fully decoded ADPCM wave buffers, so looping voices don't decode the same data on
+/// every pass.
+class AdpcmCache {
+public:
+    class Entry {
+    public:
+        explicit Entry(std::vector<u8> frames_, std::size_t start_sample_,
+                       std::size_t sample_count, const Codec::ADPCM_Coeff& coeffs,
+                       const ADPCMContext& initial_context_);
+
+        /// Returns the decoder context after decoding the first num_samples samples
+        [[nodiscard]] ADPCMContext ContextAt(std::size_t num_samples) const;
+
+        [[nodiscard]] std::span<const s16> Samples() const noexcept {
+            return samples;
+        }
+
+        [[nodiscard]] std::span<const u8> Frames() const noexcept {
+            return frames;
+        }
+
+        [[nodiscard]] const ADPCMContext& InitialContext() const noexcept {
+            return initial_context;
+        }
+
+    private:
+        std::vector<u8> frames;
+        std::vector<s16> samples;
+        std::size_t start_sample;
+        ADPCMContext initial_context;
+    };
+
+    /**
+     * Returns the decoded samples of a wave buffer range when they can be used from the given
+     * position and decoder context, or null when the caller has to decode them itself.
+     * Guest data is compared against the cached copy each time a pass over the range begins.
+     */
+    [[nodiscard]] std::shared_ptr<const Entry> Get(Core::Memory::Memory& memory, VAddr address,
+                                                   s32 start_sample, s32 end_sample,
+                                                   const Codec::ADPCM_Coeff& coeffs, s32 offset,
+                                                   const ADPCMContext& context);
+
+private:
+    /// Largest range in samples to cache, about 20 seconds at 48KHz
+    static constexpr std::size_t MAX_CACHED_SAMPLES = 1ULL << 20;
+    /// Decoded bytes held before the cache is flushed
+    static constexpr std::size_t MAX_CACHE_SIZE = 64ULL << 20;
+
+    struct Key {
+        VAddr address;
+        s32 start_sample;
+        s32 end_sample;
+        Codec::ADPCM_Coeff coeffs;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const noexcept;
+    };
+
+    std::mutex mutex;
+    std::unordered_map<Key, std::shared_ptr<const Entry>, KeyHash> entries;
+    std::size_t cache_size = 0;
+};
+
+} // namespace AudioCore
@@ -199,7 +199,7 @@ std::vector<s16> Interpolate(InterpolationState& state, std::vector<s16> input,
 }
 
 void Resample(s32* output, const s32* input, s32 pitch, s32& fraction, std::size_t sample_count) {
-    const std::array<s16, 512>& lut = [pitch] {
+    const std::array<s16, 512>& lut = [pitch]() -> const std::array<s16, 512>& {
         if (pitch > 0xaaaa) {
             return curve_lut0;
         }
@@ -209,6 +209,22 @@ void Resample(s32* output, const s32* input, s32 pitch, s32& fraction, std::size
         return curve_lut2;
     }();
 
+    if (pitch == 0x8000) {
+        // Without a rate change the phase never moves, so the filter taps stay the same for the
+        // whole buffer and the loop can be vectorized.
+        const std::size_t lut_index{(static_cast<std::size_t>(fraction) >> 8) * 4};
+        const s32 l0 = lut[lut_index + 0];
+        const s32 l1 = lut[lut_index + 1];
+        const s32 l2 = lut[lut_index + 2];
+        const s32 l3 = lut[lut_index + 3];
+        for (std::size_t i = 0; i < sample_count; i++) {
+            output[i] =
+                (l0 * input[i + 0] + l1 * input[i + 1] + l2 * input[i + 2] + l3 * input[i + 3]) >>
+                15;
+        }
+        return;
+    }
+
     std::size_t index{};
 
     for (std::size_t i = 0; i < sample_count; i++) {
@@ -230,4 +246,21 @@ void Resample(s32* output, const s32* input, s32 pitch, s32& fraction, std::size
     }
 }
 
+void ResampleLinear(s32* output, const s32* input, s32 pitch, s32& fraction,
+                    std::size_t sample_count) {
+    std::size_t index{};
+
+    for (std::size_t i = 0; i < sample_count; i++) {
+        // Interpolate between the two middle taps of the four tap window, so both resamplers
+        // delay the signal by the same amount and switching between them doesn't skip samples.
+        const auto s1 = static_cast<s64>(input[index + 1]);
+        const auto s2 = static_cast<s64>(input[index + 2]);
+
+        output[i] = static_cast<s32>(s1 + (((s2 - s1) * fraction) >> 15));
+        fraction += pitch;
+        index += (fraction >> 15);
+        fraction &= 0x7fff;
+    }
+}
+
 } // namespace AudioCore
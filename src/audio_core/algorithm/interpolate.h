@@ -41,4 +41,9 @@ inline std::vector<s16> Interpolate(InterpolationState& state, std::vector<s16>
 /// Nintendo Switchs DSP resampling algorithm. Based on a single channel
 void Resample(s32* output, const s32* input, s32 pitch, s32& fraction, std::size_t sample_count);
 
+/// Linear interpolation resampler, used for voices requesting low quality sample rate conversion.
+/// Takes the same input layout and fraction state as Resample.
+void ResampleLinear(s32* output, const s32* input, s32 pitch, s32& fraction,
+                    std::size_t sample_count);
+
 } // namespace AudioCore
@@ -0,0 +1,196 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstddef>
+#include <span>
+
+#include "audio_core/algorithm/mix.h"
+#include "common/common_types.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+#elif defined(ARCHITECTURE_ARM64)
+#include <arm_neon.h>
+#endif
+
+#if defined(ARCHITECTURE_x86_64) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE41
+#define TARGET_AVX2
+#endif
+
+namespace AudioCore {
+namespace {
+
+using MixFunction = void (*)(s32*, const s32*, s32, std::size_t);
+using GainFunction = void (*)(s32*, const s32*, s32, s32, std::size_t);
+
+s32 Scale(s32 sample, s32 gain) {
+    return static_cast<s32>((static_cast<s64>(sample) * gain + 0x4000) >> 15);
+}
+
+void MixGeneric(s32* output, const s32* input, s32 gain, std::size_t sample_count) {
+    for (std::size_t i = 0; i < sample_count; ++i) {
+        output[i] += Scale(input[i], gain);
+    }
+}
+
+void GainGeneric(s32* output, const s32* input, s32 gain, s32 delta, std::size_t sample_count) {
+    for (std::size_t i = 0; i < sample_count; ++i) {
+        output[i] = Scale(input[i], gain);
+        gain += delta;
+    }
+}
+
+#ifdef ARCHITECTURE_x86_64
+
+// There are no 64-bit arithmetic shifts before AVX-512. The result is truncated to 32 bits, and
+// those bits are the same for logical and arithmetic shifts, so logical shifts are used instead.
+
+TARGET_SSE41 __m128i ScaleSSE41(__m128i input, __m128i gain) {
+    const __m128i round = _mm_set1_epi64x(0x4000);
+    const __m128i even = _mm_add_epi64(_mm_mul_epi32(input, gain), round);
+    const __m128i odd = _mm_add_epi64(
+        _mm_mul_epi32(_mm_srli_epi64(input, 32), _mm_srli_epi64(gain, 32)), round);
+    return _mm_blend_epi16(_mm_srli_epi64(even, 15), _mm_slli_epi64(odd, 17), 0xCC);
+}
+
+TARGET_SSE41 void MixSSE41(s32* output, const s32* input, s32 gain, std::size_t sample_count) {
+    const __m128i gains = _mm_set1_epi32(gain);
+    std::size_t i = 0;
+    for (; i + 4 <= sample_count; i += 4) {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        const __m128i mixed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(output + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),
+                         _mm_add_epi32(mixed, ScaleSSE41(samples, gains)));
+    }
+    MixGeneric(output + i, input + i, gain, sample_count - i);
+}
+
+TARGET_SSE41 void GainSSE41(s32* output, const s32* input, s32 gain, s32 delta,
+                            std::size_t sample_count) {
+    __m128i gains = _mm_setr_epi32(gain, gain + delta, gain + delta * 2, gain + delta * 3);
+    const __m128i step = _mm_set1_epi32(delta * 4);
+    std::size_t i = 0;
+    for (; i + 4 <= sample_count; i += 4) {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), ScaleSSE41(samples, gains));
+        gains = _mm_add_epi32(gains, step);
+    }
+    GainGeneric(output + i, input + i, _mm_cvtsi128_si32(gains), delta, sample_count - i);
+}
+
+TARGET_AVX2 __m256i ScaleAVX2(__m256i input, __m256i gain) {
+    const __m256i round = _mm256_set1_epi64x(0x4000);
+    const __m256i even = _mm256_add_epi64(_mm256_mul_epi32(input, gain), round);
+    const __m256i odd = _mm256_add_epi64(
+        _mm256_mul_epi32(_mm256_srli_epi64(input, 32), _mm256_srli_epi64(gain, 32)), round);
+    return _mm256_blend_epi32(_mm256_srli_epi64(even, 15), _mm256_slli_epi64(odd, 17), 0xAA);
+}
+
+TARGET_AVX2 void MixAVX2(s32* output, const s32* input, s32 gain, std::size_t sample_count) {
+    const __m256i gains = _mm256_set1_epi32(gain);
+    std::size_t i = 0;
+    for (; i + 8 <= sample_count; i += 8) {
+        const __m256i samples = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        const __m256i mixed = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(output + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i),
+                            _mm256_add_epi32(mixed, ScaleAVX2(samples, gains)));
+    }
+    MixGeneric(output + i, input + i, gain, sample_count - i);
+}
+
+TARGET_AVX2 void GainAVX2(s32* output, const s32* input, s32 gain, s32 delta,
+                          std::size_t sample_count) {
+    const __m256i lane_steps = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i gains = _mm256_add_epi32(_mm256_set1_epi32(gain),
+                                     _mm256_mullo_epi32(_mm256_set1_epi32(delta), lane_steps));
+    const __m256i step = _mm256_set1_epi32(delta * 8);
+    std::size_t i = 0;
+    for (; i + 8 <= sample_count; i += 8) {
+        const __m256i samples = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), ScaleAVX2(samples, gains));
+        gains = _mm256_add_epi32(gains, step);
+    }
+    GainGeneric(output + i, input + i, _mm256_cvtsi256_si32(gains), delta, sample_count - i);
+}
+
+#elif defined(ARCHITECTURE_ARM64)
+
+// The rounding narrowing shift adds 0x4000 before shifting and truncates to 32 bits, matching the
+// scalar code bit for bit.
+
+int32x4_t ScaleNEON(int32x4_t input, int32x4_t gain) {
+    const int64x2_t low = vmull_s32(vget_low_s32(input), vget_low_s32(gain));
+    const int64x2_t high = vmull_high_s32(input, gain);
+    return vcombine_s32(vrshrn_n_s64(low, 15), vrshrn_n_s64(high, 15));
+}
+
+void MixNEON(s32* output, const s32* input, s32 gain, std::size_t sample_count) {
+    const int32x4_t gains = vdupq_n_s32(gain);
+    std::size_t i = 0;
+    for (; i + 4 <= sample_count; i += 4) {
+        const int32x4_t samples = vld1q_s32(input + i);
+        vst1q_s32(output + i, vaddq_s32(vld1q_s32(output + i), ScaleNEON(samples, gains)));
+    }
+    MixGeneric(output + i, input + i, gain, sample_count - i);
+}
+
+void GainNEON(s32* output, const s32* input, s32 gain, s32 delta, std::size_t sample_count) {
+    static constexpr s32 lane_steps[4]{0, 1, 2, 3};
+    int32x4_t gains = vmlaq_n_s32(vdupq_n_s32(gain), vld1q_s32(lane_steps), delta);
+    const int32x4_t step = vdupq_n_s32(delta * 4);
+    std::size_t i = 0;
+    for (; i + 4 <= sample_count; i += 4) {
+        vst1q_s32(output + i, ScaleNEON(vld1q_s32(input + i), gains));
+        gains = vaddq_s32(gains, step);
+    }
+    GainGeneric(output + i, input + i, vgetq_lane_s32(gains, 0), delta, sample_count - i);
+}
+
+#endif
+
+struct Kernels {
+    MixFunction mix;
+    GainFunction gain;
+};
+
+Kernels SelectKernels() {
+#ifdef ARCHITECTURE_x86_64
+    const auto& caps = Common::GetCPUCaps();
+    if (caps.avx2) {
+        return {MixAVX2, GainAVX2};
+    }
+    if (caps.sse4_1) {
+        return {MixSSE41, GainSSE41};
+    }
+    return {MixGeneric, GainGeneric};
+#elif defined(ARCHITECTURE_ARM64)
+    return {MixNEON, GainNEON};
+#else
+    return {MixGeneric, GainGeneric};
+#endif
+}
+
+const Kernels& GetKernels() {
+    static const Kernels kernels = SelectKernels();
+    return kernels;
+}
+
+} // Anonymous namespace
+
+void MixScaled(std::span<s32> output, std::span<const s32> input, s32 gain,
+               std::size_t sample_count) {
+    GetKernels().mix(output.data(), input.data(), gain, sample_count);
+}
+
+void ApplyScaledGain(std::span<s32> output, std::span<const s32> input, s32 gain, s32 delta,
+                     std::size_t sample_count) {
+    GetKernels().gain(output.data(), input.data(), gain, delta, sample_count);
+}
+
+} // namespace AudioCore
@@ -0,0 +1,31 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include "common/common_types.h"
+
+namespace AudioCore {
+
+/// Adds input scaled by a Q15 gain to output, rounding each product to nearest.
+/// @param output Mix buffer to accumulate into.
+/// @param input Samples to scale, may not alias output.
+/// @param gain Q15 fixed point gain.
+/// @param sample_count Number of samples to mix.
+void MixScaled(std::span<s32> output, std::span<const s32> input, s32 gain,
+               std::size_t sample_count);
+
+/// Writes input scaled by a Q15 gain ramp to output, rounding each product to nearest.
+/// @param output Buffer to write to, may be the same buffer as input.
+/// @param input Samples to scale.
+/// @param gain Q15 fixed point gain applied to the first sample.
+/// @param delta Value added to the gain after each sample.
+/// @param sample_count Number of samples to write.
+void ApplyScaledGain(std::span<s32> output, std::span<const s32> input, s32 gain, s32 delta,
+                     std::size_t sample_count);
+
+} // namespace AudioCore
@@ -10,6 +10,7 @@
 #include "audio_core/common.h"
 #include "audio_core/info_updater.h"
 #include "audio_core/voice_context.h"
+#include "common/fs/path_util.h"
 #include "common/logging/log.h"
 #include "common/settings.h"
 #include "core/core_timing.h"
@@ -69,6 +70,10 @@ namespace {
 
 namespace AudioCore {
 constexpr s32 NUM_BUFFERS = 2;
+/// Most frames rendered in a single buffer
+constexpr std::size_t MAX_BATCH_FRAMES = 4;
+/// Frames the sink is refilled to when it is about to run out of samples
+constexpr std::size_t SINK_REFILL_FRAMES = 2;
 
 AudioRenderer::AudioRenderer(Core::Timing::CoreTiming& core_timing_, Core::Memory::Memory& memory_,
                              AudioCommon::AudioRendererParameter params,
@@ -91,7 +96,15 @@ AudioRenderer::AudioRenderer(Core::Timing::CoreTiming& core_timing_, Core::Memor
         fmt::format("AudioRenderer-Instance{}", instance_number), std::move(release_callback));
     process_event = Core::Timing::CreateEvent(
         fmt::format("AudioRenderer-Instance{}-Process", instance_number),
-        [this](std::uintptr_t, std::chrono::nanoseconds) { ReleaseAndQueueBuffers(); });
+        [this](std::uintptr_t, std::chrono::nanoseconds ns_late) {
+            ReleaseAndQueueBuffers(ns_late);
+        });
+    if (Settings::values.dump_audio_renderer.GetValue()) {
+        const auto capture_dir =
+            Common::FS::GetYuzuPath(Common::FS::YuzuPath::DumpDir) / "audio_renderer";
+        capture = std::make_unique<Capture::RendererCapture>(
+            capture_dir / fmt::format("instance{}.yarc", instance_number), worker_params);
+    }
     for (s32 i = 0; i < NUM_BUFFERS; ++i) {
         QueueMixedBuffer(i);
     }
@@ -126,9 +139,12 @@ Stream::State AudioRenderer::GetStreamState() const {
     return stream->GetState();
 }
 
-ResultCode AudioRenderer::UpdateAudioRenderer(const std::vector<u8>& input_params,
+ResultCode AudioRenderer::UpdateAudioRenderer(std::span<const u8> input_params,
                                               std::vector<u8>& output_params) {
     std::scoped_lock lock{mutex};
+    if (capture) {
+        capture->RecordUpdate(input_params);
+    }
     InfoUpdater info_updater{input_params, output_params, behavior_info};
 
     if (!info_updater.UpdateBehaviorInfo(behavior_info)) {
@@ -208,10 +224,29 @@ ResultCode AudioRenderer::UpdateAudioRenderer(const std::vector<u8>& input_param
         LOG_ERROR(Audio, "Audio buffers were not consumed!");
         return AudioCommon::Audren::ERR_INVALID_PARAMETERS;
     }
+    if (capture) {
+        capture->RecordVoiceMemory(memory, voice_context);
+    }
     return ResultSuccess;
 }
 
-void AudioRenderer::QueueMixedBuffer(Buffer::Tag tag) {
+void AudioRenderer::QueueMixedBuffer(Buffer::Tag tag, std::size_t frame_count) {
+    const std::size_t frame_size = worker_params.sample_count * stream->GetNumChannels();
+    // Samples, making sure to clear
+    std::vector<s16> buffer(frame_size * frame_count, 0);
+    for (std::size_t frame = 0; frame < frame_count; ++frame) {
+        const auto frame_buffer = std::span(buffer).subspan(frame * frame_size, frame_size);
+        MixFrame(frame_buffer);
+        if (capture) {
+            capture->RecordFrame(frame_buffer);
+        }
+        elapsed_frame_count++;
+        voice_context.UpdateStateByDspShared();
+    }
+    audio_out->QueueBuffer(stream, tag, std::move(buffer));
+}
+
+void AudioRenderer::MixFrame(std::span<s16> buffer) {
     command_generator.PreCommand();
     // Clear mix buffers before our next operation
     command_generator.ClearMixBuffers();
@@ -231,8 +266,6 @@ void AudioRenderer::QueueMixedBuffer(Buffer::Tag tag) {
     command_generator.PostCommand();
     // Base sample size
     std::size_t BUFFER_SIZE{worker_params.sample_count};
-    // Samples, making sure to clear
-    std::vector<s16> buffer(BUFFER_SIZE * stream->GetNumChannels(), 0);
 
     if (sink_context.InUse()) {
         const auto stream_channel_count = stream->GetNumChannels();
@@ -310,13 +343,26 @@ void AudioRenderer::QueueMixedBuffer(Buffer::Tag tag) {
             }
         }
     }
+}
 
-    audio_out->QueueBuffer(stream, tag, std::move(buffer));
-    elapsed_frame_count++;
-    voice_context.UpdateStateByDspShared();
+std::size_t AudioRenderer::GetBatchFrameCount(std::chrono::nanoseconds ns_late) const {
+    const std::chrono::nanoseconds frame_duration{
+        static_cast<u64>(GetSampleCount()) * 1'000'000'000ULL / GetSampleRate()};
+    std::size_t frame_count = 1;
+    if (ns_late > frame_duration) {
+        // Render the frames the late event missed along with the current one
+        frame_count += static_cast<std::size_t>(ns_late / frame_duration);
+    }
+    if (const std::optional<std::size_t> sink_queue_size = stream->GetSinkQueueSize()) {
+        const std::size_t queued_frames = *sink_queue_size / GetSampleCount();
+        if (queued_frames == 0) {
+            frame_count = std::max(frame_count, SINK_REFILL_FRAMES);
+        }
+    }
+    return std::min(frame_count, MAX_BATCH_FRAMES);
 }
 
-void AudioRenderer::ReleaseAndQueueBuffers() {
+void AudioRenderer::ReleaseAndQueueBuffers(std::chrono::nanoseconds ns_late) {
     if (!stream->IsPlaying()) {
         return;
     }
@@ -324,8 +370,11 @@ void AudioRenderer::ReleaseAndQueueBuffers() {
     {
         std::scoped_lock lock{mutex};
         const auto released_buffers{audio_out->GetTagsAndReleaseBuffers(stream)};
+        if (!released_buffers.empty()) {
+            batch_frame_count = GetBatchFrameCount(ns_late);
+        }
         for (const auto& tag : released_buffers) {
-            QueueMixedBuffer(tag);
+            QueueMixedBuffer(tag, batch_frame_count);
         }
     }
 
@@ -333,7 +382,9 @@ void AudioRenderer::ReleaseAndQueueBuffers() {
     const f32 sample_count = static_cast<f32>(GetSampleCount());
     const f32 consume_rate = sample_rate / (sample_count * (sample_count / 240));
     const s32 ms = (1000 / static_cast<s32>(consume_rate)) - 1;
-    const std::chrono::milliseconds next_event_time(std::max(ms / NUM_BUFFERS, 1));
+    // Buffers holding several frames are released that many times less often
+    const s32 batched_ms = ms * static_cast<s32>(batch_frame_count);
+    const std::chrono::milliseconds next_event_time(std::max(batched_ms / NUM_BUFFERS, 1));
     core_timing.ScheduleEvent(next_event_time, process_event, {});
 }
 
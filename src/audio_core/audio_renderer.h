@@ -5,8 +5,10 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <vector>
 
 #include "audio_core/behavior_info.h"
@@ -15,6 +17,7 @@
 #include "audio_core/effect_context.h"
 #include "audio_core/memory_pool.h"
 #include "audio_core/mix_context.h"
+#include "audio_core/renderer_capture.h"
 #include "audio_core/sink_context.h"
 #include "audio_core/splitter_context.h"
 #include "audio_core/stream.h"
@@ -44,18 +47,29 @@ public:
                   Stream::ReleaseCallback&& release_callback, std::size_t instance_number);
     ~AudioRenderer();
 
-    [[nodiscard]] ResultCode UpdateAudioRenderer(const std::vector<u8>& input_params,
+    [[nodiscard]] ResultCode UpdateAudioRenderer(std::span<const u8> input_params,
                                                  std::vector<u8>& output_params);
     [[nodiscard]] ResultCode Start();
     [[nodiscard]] ResultCode Stop();
-    void QueueMixedBuffer(Buffer::Tag tag);
-    void ReleaseAndQueueBuffers();
+    /// Renders the given number of frames into a single buffer and queues it
+    void QueueMixedBuffer(Buffer::Tag tag, std::size_t frame_count = 1);
+    void ReleaseAndQueueBuffers(std::chrono::nanoseconds ns_late = {});
     [[nodiscard]] u32 GetSampleRate() const;
     [[nodiscard]] u32 GetSampleCount() const;
     [[nodiscard]] u32 GetMixBufferCount() const;
     [[nodiscard]] Stream::State GetStreamState() const;
 
 private:
+    /// Runs the commands of one frame and downmixes its final mix into buffer
+    void MixFrame(std::span<s16> buffer);
+
+    /**
+     * Returns the number of frames to render in each buffer queued by the next event. Frames are
+     * rendered one at a time unless the event is late, when catching up after a pause or a load,
+     * or the sink is about to run out of samples.
+     */
+    [[nodiscard]] std::size_t GetBatchFrameCount(std::chrono::nanoseconds ns_late) const;
+
     BehaviorInfo behavior_info{};
 
     AudioCommon::AudioRendererParameter worker_params;
@@ -70,7 +84,10 @@ private:
     StreamPtr stream;
     Core::Memory::Memory& memory;
     CommandGenerator command_generator;
+    std::unique_ptr<Capture::RendererCapture> capture;
     std::size_t elapsed_frame_count{};
+    /// Frames rendered in each buffer by the last event
+    std::size_t batch_frame_count{1};
     Core::Timing::CoreTiming& core_timing;
     std::shared_ptr<Core::Timing::EventType> process_event;
     std::mutex mutex;
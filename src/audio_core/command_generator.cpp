@@ -2,19 +2,26 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cmath>
 #include <numbers>
+#include <thread>
+#include "audio_core/adpcm_cache.h"
 #include "audio_core/algorithm/interpolate.h"
+#include "audio_core/algorithm/mix.h"
 #include "audio_core/command_generator.h"
 #include "audio_core/effect_context.h"
 #include "audio_core/mix_context.h"
 #include "audio_core/voice_context.h"
+#include "common/thread_worker.h"
 #include "core/memory.h"
 
 namespace AudioCore {
 namespace {
 constexpr std::size_t MIX_BUFFER_SIZE = 0x3f00;
 constexpr std::size_t SCALED_MIX_BUFFER_SIZE = MIX_BUFFER_SIZE << 15ULL;
+// Minimum number of queued voices to decode them on the voice workers
+constexpr std::size_t PARALLEL_VOICE_THRESHOLD = 16;
 using DelayLineTimes = std::array<f32, AudioCommon::I3DL2REVERB_DELAY_LINE_COUNT>;
 
 constexpr DelayLineTimes FDN_MIN_DELAY_LINE_TIMES{5.0f, 6.0f, 13.0f, 14.0f};
@@ -30,16 +37,6 @@ constexpr std::array<f32, AudioCommon::I3DL2REVERB_TAPS> EARLY_GAIN{
     0.24712f, 0.45945f, 0.45021f, 0.64196f, 0.54879f, 0.92925f, 0.38270f,
     0.72867f, 0.69794f, 0.5464f,  0.24563f, 0.45214f, 0.44042f};
 
-template <std::size_t N>
-void ApplyMix(std::span<s32> output, std::span<const s32> input, s32 gain, s32 sample_count) {
-    for (std::size_t i = 0; i < static_cast<std::size_t>(sample_count); i += N) {
-        for (std::size_t j = 0; j < N; j++) {
-            output[i + j] +=
-                static_cast<s32>((static_cast<s64>(input[i + j]) * gain + 0x4000) >> 15);
-        }
-    }
-}
-
 s32 ApplyMixRamp(std::span<s32> output, std::span<const s32> input, float gain, float delta,
                  s32 sample_count) {
     // XC2 passes in NaN mix volumes, causing further issues as we handle everything as s32 rather
@@ -60,21 +57,6 @@ s32 ApplyMixRamp(std::span<s32> output, std::span<const s32> input, float gain,
     return x;
 }
 
-void ApplyGain(std::span<s32> output, std::span<const s32> input, s32 gain, s32 delta,
-               s32 sample_count) {
-    for (s32 i = 0; i < sample_count; i++) {
-        output[i] = static_cast<s32>((static_cast<s64>(input[i]) * gain + 0x4000) >> 15);
-        gain += delta;
-    }
-}
-
-void ApplyGainWithoutDelta(std::span<s32> output, std::span<const s32> input, s32 gain,
-                           s32 sample_count) {
-    for (s32 i = 0; i < sample_count; i++) {
-        output[i] = static_cast<s32>((static_cast<s64>(input[i]) * gain + 0x4000) >> 15);
-    }
-}
-
 s32 ApplyMixDepop(std::span<s32> output, s32 first_sample, s32 delta, s32 sample_count) {
     const bool positive = first_sample > 0;
     auto final_sample = std::abs(first_sample);
@@ -267,6 +249,7 @@ void CommandGenerator::GenerateVoiceCommands() {
         LOG_DEBUG(Audio, "(DSP_TRACE) GenerateVoiceCommands");
     }
     // Grab all our voices
+    queued_voices.clear();
     const auto voice_count = voice_context.GetVoiceCount();
     for (std::size_t i = 0; i < voice_count; i++) {
         auto& voice_info = voice_context.GetSortedInfo(i);
@@ -274,48 +257,122 @@ void CommandGenerator::GenerateVoiceCommands() {
         if (voice_info.ShouldSkip() || !voice_info.UpdateForCommandGeneration(voice_context)) {
             continue;
         }
-
-        // Queue our voice
-        GenerateVoiceCommand(voice_info);
+        queued_voices.push_back(&voice_info);
+    }
+    if (queued_voices.size() >= PARALLEL_VOICE_THRESHOLD) {
+        GenerateVoiceCommandsParallel();
+    } else {
+        for (ServerVoiceInfo* const voice_info : queued_voices) {
+            GenerateVoiceCommand(*voice_info);
+        }
     }
     // Update our splitters
     splitter_context.UpdateInternalState();
 }
 
+void CommandGenerator::GenerateVoiceCommandsParallel() {
+    if (!voice_workers) {
+        const std::size_t num_workers =
+            std::clamp<std::size_t>(std::thread::hardware_concurrency(), 2, 5) - 1;
+        voice_workers = std::make_unique<Common::StatefulThreadWorker<std::vector<s32>>>(
+            num_workers, "yuzu:AudioVoice", [] { return std::vector<s32>(MIX_BUFFER_SIZE); });
+    }
+    const std::size_t voice_buffer_size =
+        AudioCommon::MAX_CHANNEL_COUNT * static_cast<std::size_t>(worker_params.sample_count);
+    voice_buffers.resize(queued_voices.size() * voice_buffer_size);
+
+    // Decoding and resampling only touch the voice's own state, so each voice is processed
+    // independently into its own buffers
+    for (std::size_t i = 0; i < queued_voices.size(); ++i) {
+        ServerVoiceInfo* const voice_info = queued_voices[i];
+        const std::span<s32> channel_buffers(voice_buffers.data() + i * voice_buffer_size,
+                                             voice_buffer_size);
+        voice_workers->QueueWork([this, voice_info, channel_buffers](std::vector<s32>* scratch) {
+            GenerateVoiceSourceCommand(*voice_info, channel_buffers, *scratch);
+        });
+    }
+    voice_workers->WaitForRequests();
+
+    // Mixing is done in voice order to match the serial path
+    for (std::size_t i = 0; i < queued_voices.size(); ++i) {
+        const std::span<const s32> channel_buffers(voice_buffers.data() + i * voice_buffer_size,
+                                                   voice_buffer_size);
+        GenerateVoiceMixCommands(*queued_voices[i], channel_buffers);
+    }
+}
+
 void CommandGenerator::GenerateVoiceCommand(ServerVoiceInfo& voice_info) {
+    const std::span<s32> channel_buffers(
+        mix_buffer.data() + GetMixChannelBufferOffset(0) * worker_params.sample_count,
+        AudioCommon::MAX_CHANNEL_COUNT * static_cast<std::size_t>(worker_params.sample_count));
+    GenerateVoiceSourceCommand(voice_info, channel_buffers, sample_buffer);
+    GenerateVoiceMixCommands(voice_info, channel_buffers);
+}
+
+void CommandGenerator::GenerateVoiceSourceCommand(ServerVoiceInfo& voice_info,
+                                                  std::span<s32> channel_buffers,
+                                                  std::span<s32> scratch) {
     auto& in_params = voice_info.GetInParams();
     const auto channel_count = in_params.channel_count;
 
     for (s32 channel = 0; channel < channel_count; channel++) {
         const auto resource_id = in_params.voice_channel_resource_id[channel];
         auto& dsp_state = voice_context.GetDspSharedState(resource_id);
-        auto& channel_resource = voice_context.GetChannelResource(resource_id);
-
-        // Decode our samples for our channel
-        GenerateDataSourceCommand(voice_info, dsp_state, channel);
+        const std::span<s32> output = GetVoiceChannelBuffer(channel_buffers, channel);
 
         if (in_params.should_depop) {
+            // Depop is prepared when the voice is mixed
             in_params.last_volume = 0.0f;
-        } else if (in_params.splitter_info_id != AudioCommon::NO_SPLITTER ||
-                   in_params.mix_id != AudioCommon::NO_MIX) {
+            continue;
+        }
+
+        // Decode our samples for our channel
+        GenerateDataSourceCommand(voice_info, dsp_state, channel_buffers, channel, scratch);
+
+        if (in_params.splitter_info_id != AudioCommon::NO_SPLITTER ||
+            in_params.mix_id != AudioCommon::NO_MIX) {
             // Apply a biquad filter if needed
             GenerateBiquadFilterCommandForVoice(voice_info, dsp_state,
                                                 worker_params.mix_buffer_count, channel);
             // Base voice volume ramping
-            GenerateVolumeRampCommand(in_params.last_volume, in_params.volume, channel,
+            GenerateVolumeRampCommand(in_params.last_volume, in_params.volume, output, channel,
                                       in_params.node_id);
             in_params.last_volume = in_params.volume;
 
+            // Update biquad filter enabled states
+            for (std::size_t i = 0; i < AudioCommon::MAX_BIQUAD_FILTERS; i++) {
+                in_params.was_biquad_filter_enabled[i] = in_params.biquad_filter[i].enabled;
+            }
+        }
+    }
+}
+
+void CommandGenerator::GenerateVoiceMixCommands(ServerVoiceInfo& voice_info,
+                                                std::span<const s32> channel_buffers) {
+    const auto& in_params = voice_info.GetInParams();
+    const auto channel_count = in_params.channel_count;
+
+    for (s32 channel = 0; channel < channel_count; channel++) {
+        const auto resource_id = in_params.voice_channel_resource_id[channel];
+        auto& dsp_state = voice_context.GetDspSharedState(resource_id);
+        auto& channel_resource = voice_context.GetChannelResource(resource_id);
+        const std::span<const s32> input = GetVoiceChannelBuffer(channel_buffers, channel);
+
+        if (in_params.should_depop) {
+            GenerateVoiceDepopCommand(voice_info, dsp_state);
+        } else if (in_params.splitter_info_id != AudioCommon::NO_SPLITTER ||
+                   in_params.mix_id != AudioCommon::NO_MIX) {
             if (in_params.mix_id != AudioCommon::NO_MIX) {
                 // If we're using a mix id
                 auto& mix_info = mix_context.GetInfo(in_params.mix_id);
                 const auto& dest_mix_params = mix_info.GetInParams();
 
                 // Voice Mixing
-                GenerateVoiceMixCommand(
-                    channel_resource.GetCurrentMixVolume(), channel_resource.GetLastMixVolume(),
-                    dsp_state, dest_mix_params.buffer_offset, dest_mix_params.buffer_count,
-                    worker_params.mix_buffer_count + channel, in_params.node_id);
+                GenerateVoiceMixCommand(channel_resource.GetCurrentMixVolume(),
+                                        channel_resource.GetLastMixVolume(), dsp_state,
+                                        dest_mix_params.buffer_offset, dest_mix_params.buffer_count,
+                                        input, worker_params.mix_buffer_count + channel,
+                                        in_params.node_id);
 
                 // Update last mix volumes
                 channel_resource.UpdateLastMixVolumes();
@@ -337,28 +394,150 @@ void CommandGenerator::GenerateVoiceCommand(ServerVoiceInfo& voice_info) {
                     GenerateVoiceMixCommand(
                         destination_data->CurrentMixVolumes(), destination_data->LastMixVolumes(),
                         dsp_state, dest_mix_params.buffer_offset, dest_mix_params.buffer_count,
-                        worker_params.mix_buffer_count + channel, in_params.node_id);
+                        input, worker_params.mix_buffer_count + channel, in_params.node_id);
                     destination_data->MarkDirty();
                 }
             }
-            // Update biquad filter enabled states
-            for (std::size_t i = 0; i < AudioCommon::MAX_BIQUAD_FILTERS; i++) {
-                in_params.was_biquad_filter_enabled[i] = in_params.biquad_filter[i].enabled;
-            }
         }
     }
 }
 
 void CommandGenerator::GenerateSubMixCommands() {
     const auto mix_count = mix_context.GetCount();
+    const std::size_t total_buffer_count = GetTotalMixBufferCount();
+    pending_mix_buffers.assign(total_buffer_count, false);
+    bool has_pending_effects = false;
     for (std::size_t i = 0; i < mix_count; i++) {
         auto& mix_info = mix_context.GetSortedInfo(i);
         const auto& in_params = mix_info.GetInParams();
         if (!in_params.in_use || in_params.mix_id == AudioCommon::FINAL_MIX) {
             continue;
         }
+        mix_buffer_usage.assign(total_buffer_count, false);
+        MarkSubMixBuffers(mix_info, mix_buffer_usage);
+
+        if (HasEffectForDspThread(mix_info)) {
+            if (!effect_worker) {
+                effect_worker =
+                    std::make_unique<Common::StatefulThreadWorker<void>>(1, "yuzu:AudioEffect");
+            }
+            // Work runs in order on a single thread, so queued mixes never need to wait for each
+            // other, only for mixes processed inline
+            for (std::size_t j = 0; j < total_buffer_count; j++) {
+                if (mix_buffer_usage[j]) {
+                    pending_mix_buffers[j] = true;
+                }
+            }
+            has_pending_effects = true;
+            effect_worker->QueueWork([this, &mix_info] { GenerateSubMixCommand(mix_info); });
+            continue;
+        }
+
+        if (has_pending_effects) {
+            bool depends_on_pending = false;
+            for (std::size_t j = 0; j < total_buffer_count; j++) {
+                depends_on_pending |= mix_buffer_usage[j] && pending_mix_buffers[j];
+            }
+            if (depends_on_pending) {
+                effect_worker->WaitForRequests();
+                pending_mix_buffers.assign(total_buffer_count, false);
+                has_pending_effects = false;
+            }
+        }
         GenerateSubMixCommand(mix_info);
     }
+
+    // The final mix reads every sub mix, join before it is generated
+    if (has_pending_effects) {
+        effect_worker->WaitForRequests();
+    }
+}
+
+bool CommandGenerator::HasEffectForDspThread(const ServerMixInfo& mix_info) const {
+    const std::size_t effect_count = effect_context.GetCount();
+    for (std::size_t i = 0; i < effect_count; i++) {
+        const auto index = mix_info.GetEffectOrder(i);
+        if (index == AudioCommon::NO_EFFECT_ORDER) {
+            break;
+        }
+        const auto* info = effect_context.GetInfo(index);
+        if (info->GetType() == EffectType::I3dl2Reverb && info->IsEnabled()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CommandGenerator::MarkSubMixBuffers(const ServerMixInfo& mix_info,
+                                         std::vector<bool>& usage) {
+    const auto& in_params = mix_info.GetInParams();
+    const auto mark_range = [&usage](s32 offset, s32 count) {
+        for (s32 i = std::max(offset, 0); i < offset + count; i++) {
+            if (static_cast<std::size_t>(i) < usage.size()) {
+                usage[static_cast<std::size_t>(i)] = true;
+            }
+        }
+    };
+    const auto mark_effect_buffers = [&](const auto& input, const auto& output, s32 count) {
+        for (s32 i = 0; i < count; i++) {
+            mark_range(in_params.buffer_offset + input[i], 1);
+            mark_range(in_params.buffer_offset + output[i], 1);
+        }
+    };
+    mark_range(in_params.buffer_offset, in_params.buffer_count);
+
+    // Effects address buffers relative to the mix, which may reach past its own buffers
+    const std::size_t effect_count = effect_context.GetCount();
+    for (std::size_t i = 0; i < effect_count; i++) {
+        const auto index = mix_info.GetEffectOrder(i);
+        if (index == AudioCommon::NO_EFFECT_ORDER) {
+            break;
+        }
+        auto* info = effect_context.GetInfo(index);
+        switch (info->GetType()) {
+        case EffectType::Aux: {
+            const auto& params = dynamic_cast<EffectAuxInfo*>(info)->GetParams();
+            const auto count = std::min(static_cast<s32>(params.count),
+                                        static_cast<s32>(AudioCommon::MAX_MIX_BUFFERS));
+            mark_effect_buffers(params.input_mix_buffers, params.output_mix_buffers, count);
+            break;
+        }
+        case EffectType::I3dl2Reverb: {
+            const auto& params = dynamic_cast<EffectI3dl2Reverb*>(info)->GetParams();
+            const auto count = std::min(static_cast<s32>(params.channel_count),
+                                        static_cast<s32>(AudioCommon::MAX_CHANNEL_COUNT));
+            mark_effect_buffers(params.input, params.output, count);
+            break;
+        }
+        case EffectType::BiquadFilter: {
+            const auto& params = dynamic_cast<EffectBiquadFilter*>(info)->GetParams();
+            const auto count = std::min(static_cast<s32>(params.channel_count),
+                                        static_cast<s32>(AudioCommon::MAX_CHANNEL_COUNT));
+            mark_effect_buffers(params.input, params.output, count);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    if (!mix_info.HasAnyConnection()) {
+        return;
+    }
+    if (in_params.dest_mix_id != AudioCommon::NO_MIX) {
+        const auto& dest_in_params = mix_context.GetInfo(in_params.dest_mix_id).GetInParams();
+        mark_range(dest_in_params.buffer_offset, dest_in_params.buffer_count);
+    } else if (in_params.splitter_id != AudioCommon::NO_SPLITTER) {
+        s32 base{};
+        while (const auto* destination_data = GetDestinationData(in_params.splitter_id, base++)) {
+            if (!destination_data->IsConfigured()) {
+                continue;
+            }
+            const auto& dest_in_params =
+                mix_context.GetInfo(destination_data->GetMixId()).GetInParams();
+            mark_range(dest_in_params.buffer_offset, dest_in_params.buffer_count);
+        }
+    }
 }
 
 void CommandGenerator::GenerateFinalMixCommands() {
@@ -389,45 +568,45 @@ void CommandGenerator::PostCommand() {
 }
 
 void CommandGenerator::GenerateDataSourceCommand(ServerVoiceInfo& voice_info, VoiceState& dsp_state,
-                                                 s32 channel) {
+                                                 std::span<s32> channel_buffers, s32 channel,
+                                                 std::span<s32> scratch) {
     const auto& in_params = voice_info.GetInParams();
-    const auto depop = in_params.should_depop;
+    switch (in_params.sample_format) {
+    case SampleFormat::Pcm8:
+    case SampleFormat::Pcm16:
+    case SampleFormat::Pcm32:
+    case SampleFormat::PcmFloat:
+        DecodeFromWaveBuffers(voice_info, GetVoiceChannelBuffer(channel_buffers, channel),
+                              dsp_state, channel, worker_params.sample_rate,
+                              worker_params.sample_count, in_params.node_id, scratch);
+        break;
+    case SampleFormat::Adpcm:
+        ASSERT(channel == 0 && in_params.channel_count == 1);
+        DecodeFromWaveBuffers(voice_info, GetVoiceChannelBuffer(channel_buffers, 0), dsp_state,
+                              0, worker_params.sample_rate, worker_params.sample_count,
+                              in_params.node_id, scratch);
+        break;
+    default:
+        UNREACHABLE_MSG("Unimplemented sample format={}", in_params.sample_format);
+    }
+}
 
-    if (depop) {
-        if (in_params.mix_id != AudioCommon::NO_MIX) {
-            auto& mix_info = mix_context.GetInfo(in_params.mix_id);
+void CommandGenerator::GenerateVoiceDepopCommand(ServerVoiceInfo& voice_info,
+                                                 VoiceState& dsp_state) {
+    const auto& in_params = voice_info.GetInParams();
+    if (in_params.mix_id != AudioCommon::NO_MIX) {
+        auto& mix_info = mix_context.GetInfo(in_params.mix_id);
+        const auto& mix_in = mix_info.GetInParams();
+        GenerateDepopPrepareCommand(dsp_state, mix_in.buffer_count, mix_in.buffer_offset);
+    } else if (in_params.splitter_info_id != AudioCommon::NO_SPLITTER) {
+        s32 index{};
+        while (const auto* destination = GetDestinationData(in_params.splitter_info_id, index++)) {
+            if (!destination->IsConfigured()) {
+                continue;
+            }
+            auto& mix_info = mix_context.GetInfo(destination->GetMixId());
             const auto& mix_in = mix_info.GetInParams();
             GenerateDepopPrepareCommand(dsp_state, mix_in.buffer_count, mix_in.buffer_offset);
-        } else if (in_params.splitter_info_id != AudioCommon::NO_SPLITTER) {
-            s32 index{};
-            while (const auto* destination =
-                       GetDestinationData(in_params.splitter_info_id, index++)) {
-                if (!destination->IsConfigured()) {
-                    continue;
-                }
-                auto& mix_info = mix_context.GetInfo(destination->GetMixId());
-                const auto& mix_in = mix_info.GetInParams();
-                GenerateDepopPrepareCommand(dsp_state, mix_in.buffer_count, mix_in.buffer_offset);
-            }
-        }
-    } else {
-        switch (in_params.sample_format) {
-        case SampleFormat::Pcm8:
-        case SampleFormat::Pcm16:
-        case SampleFormat::Pcm32:
-        case SampleFormat::PcmFloat:
-            DecodeFromWaveBuffers(voice_info, GetChannelMixBuffer(channel), dsp_state, channel,
-                                  worker_params.sample_rate, worker_params.sample_count,
-                                  in_params.node_id);
-            break;
-        case SampleFormat::Adpcm:
-            ASSERT(channel == 0 && in_params.channel_count == 1);
-            DecodeFromWaveBuffers(voice_info, GetChannelMixBuffer(0), dsp_state, 0,
-                                  worker_params.sample_rate, worker_params.sample_count,
-                                  in_params.node_id);
-            break;
-        default:
-            UNREACHABLE_MSG("Unimplemented sample format={}", in_params.sample_format);
         }
     }
 }
@@ -618,7 +797,7 @@ void CommandGenerator::GenerateBiquadFilterEffectCommand(s32 mix_buffer_offset,
         if (params.input[i] != params.output[i]) {
             std::span<const s32> input = GetMixBuffer(mix_buffer_offset + params.input[i]);
             std::span<s32> output = GetMixBuffer(mix_buffer_offset + params.output[i]);
-            ApplyMix<1>(output, input, 32768, worker_params.sample_count);
+            MixScaled(output, input, 32768, static_cast<std::size_t>(worker_params.sample_count));
         }
     }
 }
@@ -870,7 +1049,7 @@ void CommandGenerator::UpdateI3dl2Reverb(I3dl2ReverbParams& info, I3dl2ReverbSta
 }
 
 void CommandGenerator::GenerateVolumeRampCommand(float last_volume, float current_volume,
-                                                 s32 channel, s32 node_id) {
+                                                 std::span<s32> buffer, s32 channel, s32 node_id) {
     const auto last = static_cast<s32>(last_volume * 32768.0f);
     const auto current = static_cast<s32>(current_volume * 32768.0f);
     const auto delta = static_cast<s32>((static_cast<float>(current) - static_cast<float>(last)) /
@@ -884,14 +1063,15 @@ void CommandGenerator::GenerateVolumeRampCommand(float last_volume, float curren
                   last_volume, current_volume);
     }
     // Apply generic gain on samples
-    ApplyGain(GetChannelMixBuffer(channel), GetChannelMixBuffer(channel), last, delta,
-              worker_params.sample_count);
+    const auto sample_count = static_cast<std::size_t>(worker_params.sample_count);
+    ApplyScaledGain(buffer, buffer, last, delta, sample_count);
 }
 
 void CommandGenerator::GenerateVoiceMixCommand(const MixVolumeBuffer& mix_volumes,
                                                const MixVolumeBuffer& last_mix_volumes,
                                                VoiceState& dsp_state, s32 mix_buffer_offset,
-                                               s32 mix_buffer_count, s32 voice_index, s32 node_id) {
+                                               s32 mix_buffer_count, std::span<const s32> input,
+                                               s32 voice_index, s32 node_id) {
     // Loop all our mix buffers
     for (s32 i = 0; i < mix_buffer_count; i++) {
         if (last_mix_volumes[i] != 0.0f || mix_volumes[i] != 0.0f) {
@@ -907,8 +1087,8 @@ void CommandGenerator::GenerateVoiceMixCommand(const MixVolumeBuffer& mix_volume
             }
 
             dsp_state.previous_samples[i] =
-                ApplyMixRamp(GetMixBuffer(mix_buffer_offset + i), GetMixBuffer(voice_index),
-                             last_mix_volumes[i], delta, worker_params.sample_count);
+                ApplyMixRamp(GetMixBuffer(mix_buffer_offset + i), input, last_mix_volumes[i],
+                             delta, worker_params.sample_count);
         } else {
             dsp_state.previous_samples[i] = 0;
         }
@@ -984,14 +1164,7 @@ void CommandGenerator::GenerateMixCommand(std::size_t output_offset, std::size_t
     std::span<const s32> input = GetMixBuffer(input_offset);
 
     const s32 gain = static_cast<s32>(volume * 32768.0f);
-    // Mix with loop unrolling
-    if (worker_params.sample_count % 4 == 0) {
-        ApplyMix<4>(output, input, gain, worker_params.sample_count);
-    } else if (worker_params.sample_count % 2 == 0) {
-        ApplyMix<2>(output, input, gain, worker_params.sample_count);
-    } else {
-        ApplyMix<1>(output, input, gain, worker_params.sample_count);
-    }
+    MixScaled(output, input, gain, static_cast<std::size_t>(worker_params.sample_count));
 }
 
 void CommandGenerator::GenerateFinalMixCommand() {
@@ -1015,16 +1188,16 @@ void CommandGenerator::GenerateFinalMixCommand() {
                 in_params.node_id, in_params.buffer_offset + i, in_params.buffer_offset + i,
                 in_params.volume);
         }
-        ApplyGainWithoutDelta(GetMixBuffer(in_params.buffer_offset + i),
-                              GetMixBuffer(in_params.buffer_offset + i), gain,
-                              worker_params.sample_count);
+        ApplyScaledGain(GetMixBuffer(in_params.buffer_offset + i),
+                        GetMixBuffer(in_params.buffer_offset + i), gain, 0,
+                        static_cast<std::size_t>(worker_params.sample_count));
     }
 }
 
 template <typename T>
 s32 CommandGenerator::DecodePcm(ServerVoiceInfo& voice_info, VoiceState& dsp_state,
                                 s32 sample_start_offset, s32 sample_end_offset, s32 sample_count,
-                                s32 channel, std::size_t mix_offset) {
+                                s32 channel, std::size_t mix_offset, std::span<s32> scratch) {
     const auto& in_params = voice_info.GetInParams();
     const auto& wave_buffer = in_params.wave_buffer[dsp_state.wave_buffer_index];
     if (wave_buffer.buffer_address == 0) {
@@ -1048,23 +1221,23 @@ s32 CommandGenerator::DecodePcm(ServerVoiceInfo& voice_info, VoiceState& dsp_sta
 
     if constexpr (std::is_floating_point_v<T>) {
         for (std::size_t i = 0; i < static_cast<std::size_t>(samples_processed); i++) {
-            sample_buffer[mix_offset + i] = static_cast<s32>(buffer[i * channel_count + channel] *
+            scratch[mix_offset + i] = static_cast<s32>(buffer[i * channel_count + channel] *
                                                              std::numeric_limits<s16>::max());
         }
     } else if constexpr (sizeof(T) == 1) {
         for (std::size_t i = 0; i < static_cast<std::size_t>(samples_processed); i++) {
-            sample_buffer[mix_offset + i] =
+            scratch[mix_offset + i] =
                 static_cast<s32>(static_cast<f32>(buffer[i * channel_count + channel] /
                                                   std::numeric_limits<s8>::max()) *
                                  std::numeric_limits<s16>::max());
         }
     } else if constexpr (sizeof(T) == 2) {
         for (std::size_t i = 0; i < static_cast<std::size_t>(samples_processed); i++) {
-            sample_buffer[mix_offset + i] = buffer[i * channel_count + channel];
+            scratch[mix_offset + i] = buffer[i * channel_count + channel];
         }
     } else {
         for (std::size_t i = 0; i < static_cast<std::size_t>(samples_processed); i++) {
-            sample_buffer[mix_offset + i] =
+            scratch[mix_offset + i] =
                 static_cast<s32>(static_cast<f32>(buffer[i * channel_count + channel] /
                                                   std::numeric_limits<s32>::max()) *
                                  std::numeric_limits<s16>::max());
@@ -1076,7 +1249,8 @@ s32 CommandGenerator::DecodePcm(ServerVoiceInfo& voice_info, VoiceState& dsp_sta
 
 s32 CommandGenerator::DecodeAdpcm(ServerVoiceInfo& voice_info, VoiceState& dsp_state,
                                   s32 sample_start_offset, s32 sample_end_offset, s32 sample_count,
-                                  [[maybe_unused]] s32 channel, std::size_t mix_offset) {
+                                  [[maybe_unused]] s32 channel, std::size_t mix_offset,
+                                  std::span<s32> scratch) {
     const auto& in_params = voice_info.GetInParams();
     const auto& wave_buffer = in_params.wave_buffer[dsp_state.wave_buffer_index];
     if (wave_buffer.buffer_address == 0) {
@@ -1089,100 +1263,35 @@ s32 CommandGenerator::DecodeAdpcm(ServerVoiceInfo& voice_info, VoiceState& dsp_s
         return 0;
     }
 
-    static constexpr std::array<int, 16> SIGNED_NIBBLES{
-        0, 1, 2, 3, 4, 5, 6, 7, -8, -7, -6, -5, -4, -3, -2, -1,
-    };
-
-    constexpr std::size_t FRAME_LEN = 8;
-    constexpr std::size_t NIBBLES_PER_SAMPLE = 16;
-    constexpr std::size_t SAMPLES_PER_FRAME = 14;
-
-    auto frame_header = dsp_state.context.header;
-    s32 idx = (frame_header >> 4) & 0xf;
-    s32 scale = frame_header & 0xf;
-    s16 yn1 = dsp_state.context.yn1;
-    s16 yn2 = dsp_state.context.yn2;
-
     Codec::ADPCM_Coeff coeffs;
     memory.ReadBlock(in_params.additional_params_address, coeffs.data(),
                      sizeof(Codec::ADPCM_Coeff));
 
-    s32 coef1 = coeffs[idx * 2];
-    s32 coef2 = coeffs[idx * 2 + 1];
-
     const auto samples_remaining = (sample_end_offset - sample_start_offset) - dsp_state.offset;
     const auto samples_processed = std::min(sample_count, samples_remaining);
-    const auto sample_pos = dsp_state.offset + sample_start_offset;
-
-    const auto samples_remaining_in_frame = sample_pos % SAMPLES_PER_FRAME;
-    auto position_in_frame = ((sample_pos / SAMPLES_PER_FRAME) * NIBBLES_PER_SAMPLE) +
-                             samples_remaining_in_frame + (samples_remaining_in_frame != 0 ? 2 : 0);
-
-    const auto decode_sample = [&](const int nibble) -> s16 {
-        const int xn = nibble * (1 << scale);
-        // We first transform everything into 11 bit fixed point, perform the second order
-        // digital filter, then transform back.
-        // 0x400 == 0.5 in 11 bit fixed point.
-        // Filter: y[n] = x[n] + 0.5 + c1 * y[n-1] + c2 * y[n-2]
-        int val = ((xn << 11) + 0x400 + coef1 * yn1 + coef2 * yn2) >> 11;
-        // Clamp to output range.
-        val = std::clamp<s32>(val, -32768, 32767);
-        // Advance output feedback.
-        yn2 = yn1;
-        yn1 = static_cast<s16>(val);
-        return yn1;
-    };
+    if (samples_processed <= 0) {
+        return 0;
+    }
+    const auto output = scratch.subspan(mix_offset, static_cast<std::size_t>(samples_processed));
 
-    std::size_t buffer_offset{};
-    std::vector<u8> buffer(
-        std::max((samples_processed / FRAME_LEN) * SAMPLES_PER_FRAME, FRAME_LEN));
-    memory.ReadBlock(wave_buffer.buffer_address + (position_in_frame / 2), buffer.data(),
-                     buffer.size());
-    std::size_t cur_mix_offset = mix_offset;
-
-    auto remaining_samples = samples_processed;
-    while (remaining_samples > 0) {
-        if (position_in_frame % NIBBLES_PER_SAMPLE == 0) {
-            // Read header
-            frame_header = buffer[buffer_offset++];
-            idx = (frame_header >> 4) & 0xf;
-            scale = frame_header & 0xf;
-            coef1 = coeffs[idx * 2];
-            coef2 = coeffs[idx * 2 + 1];
-            position_in_frame += 2;
-
-            // Decode entire frame
-            if (remaining_samples >= static_cast<int>(SAMPLES_PER_FRAME)) {
-                for (std::size_t i = 0; i < SAMPLES_PER_FRAME / 2; i++) {
-                    // Sample 1
-                    const s32 s0 = SIGNED_NIBBLES[buffer[buffer_offset] >> 4];
-                    const s32 s1 = SIGNED_NIBBLES[buffer[buffer_offset++] & 0xf];
-                    const s16 sample_1 = decode_sample(s0);
-                    const s16 sample_2 = decode_sample(s1);
-                    sample_buffer[cur_mix_offset++] = sample_1;
-                    sample_buffer[cur_mix_offset++] = sample_2;
-                }
-                remaining_samples -= static_cast<int>(SAMPLES_PER_FRAME);
-                position_in_frame += SAMPLES_PER_FRAME;
-                continue;
-            }
-        }
-        // Decode mid frame
-        s32 current_nibble = buffer[buffer_offset];
-        if (position_in_frame++ & 0x1) {
-            current_nibble &= 0xf;
-            buffer_offset++;
-        } else {
-            current_nibble >>= 4;
-        }
-        const s16 sample = decode_sample(SIGNED_NIBBLES[current_nibble]);
-        sample_buffer[cur_mix_offset++] = sample;
-        remaining_samples--;
+    // Looping voices go through the same wave buffer many times, use the cached samples if they
+    // were decoded from the same guest data and decoder state
+    if (const auto entry = adpcm_cache.Get(memory, wave_buffer.buffer_address,
+                                           sample_start_offset, sample_end_offset, coeffs,
+                                           dsp_state.offset, dsp_state.context)) {
+        const auto offset = static_cast<std::size_t>(dsp_state.offset);
+        const auto samples = entry->Samples().subspan(offset, output.size());
+        std::copy(samples.begin(), samples.end(), output.begin());
+        dsp_state.context = entry->ContextAt(offset + output.size());
+        return samples_processed;
     }
 
-    dsp_state.context.header = frame_header;
-    dsp_state.context.yn1 = yn1;
-    dsp_state.context.yn2 = yn2;
+    const auto sample_pos = static_cast<std::size_t>(dsp_state.offset + sample_start_offset);
+    const std::vector<u8> frames =
+        ReadAdpcmFrames(memory, wave_buffer.buffer_address, sample_pos, output.size());
+    std::vector<s16> samples(output.size());
+    DecodeAdpcmSamples(frames, sample_pos, coeffs, dsp_state.context, samples);
+    std::copy(samples.begin(), samples.end(), output.begin());
 
     return samples_processed;
 }
@@ -1205,6 +1314,18 @@ std::size_t CommandGenerator::GetTotalMixBufferCount() const {
     return worker_params.mix_buffer_count + AudioCommon::MAX_CHANNEL_COUNT;
 }
 
+std::span<s32> CommandGenerator::GetVoiceChannelBuffer(std::span<s32> channel_buffers,
+                                                       s32 channel) const {
+    return channel_buffers.subspan(channel * worker_params.sample_count,
+                                   worker_params.sample_count);
+}
+
+std::span<const s32> CommandGenerator::GetVoiceChannelBuffer(
+    std::span<const s32> channel_buffers, s32 channel) const {
+    return channel_buffers.subspan(channel * worker_params.sample_count,
+                                   worker_params.sample_count);
+}
+
 std::span<s32> CommandGenerator::GetChannelMixBuffer(s32 channel) {
     return GetMixBuffer(worker_params.mix_buffer_count + channel);
 }
@@ -1216,7 +1337,7 @@ std::span<const s32> CommandGenerator::GetChannelMixBuffer(s32 channel) const {
 void CommandGenerator::DecodeFromWaveBuffers(ServerVoiceInfo& voice_info, std::span<s32> output,
                                              VoiceState& dsp_state, s32 channel,
                                              s32 target_sample_rate, s32 sample_count,
-                                             s32 node_id) {
+                                             s32 node_id, std::span<s32> scratch) {
     const auto& in_params = voice_info.GetInParams();
     if (dumping_frame) {
         LOG_DEBUG(Audio,
@@ -1251,7 +1372,7 @@ void CommandGenerator::DecodeFromWaveBuffers(ServerVoiceInfo& voice_info, std::s
         if (!in_params.behavior_flags.is_pitch_and_src_skipped) {
             // Append sample histtory for resampler
             for (std::size_t i = 0; i < AudioCommon::MAX_SAMPLE_HISTORY; i++) {
-                sample_buffer[temp_mix_offset + i] = dsp_state.sample_history[i];
+                scratch[temp_mix_offset + i] = dsp_state.sample_history[i];
             }
             temp_mix_offset += 4;
         }
@@ -1287,27 +1408,32 @@ void CommandGenerator::DecodeFromWaveBuffers(ServerVoiceInfo& voice_info, std::s
             case SampleFormat::Pcm8:
                 samples_decoded =
                     DecodePcm<s8>(voice_info, dsp_state, samples_offset_start, samples_offset_end,
-                                  samples_to_read - samples_read, channel, temp_mix_offset);
+                                  samples_to_read - samples_read, channel, temp_mix_offset,
+                                  scratch);
                 break;
             case SampleFormat::Pcm16:
                 samples_decoded =
                     DecodePcm<s16>(voice_info, dsp_state, samples_offset_start, samples_offset_end,
-                                   samples_to_read - samples_read, channel, temp_mix_offset);
+                                   samples_to_read - samples_read, channel, temp_mix_offset,
+                                   scratch);
                 break;
             case SampleFormat::Pcm32:
                 samples_decoded =
                     DecodePcm<s32>(voice_info, dsp_state, samples_offset_start, samples_offset_end,
-                                   samples_to_read - samples_read, channel, temp_mix_offset);
+                                   samples_to_read - samples_read, channel, temp_mix_offset,
+                                   scratch);
                 break;
             case SampleFormat::PcmFloat:
                 samples_decoded =
                     DecodePcm<f32>(voice_info, dsp_state, samples_offset_start, samples_offset_end,
-                                   samples_to_read - samples_read, channel, temp_mix_offset);
+                                   samples_to_read - samples_read, channel, temp_mix_offset,
+                                   scratch);
                 break;
             case SampleFormat::Adpcm:
                 samples_decoded =
                     DecodeAdpcm(voice_info, dsp_state, samples_offset_start, samples_offset_end,
-                                samples_to_read - samples_read, channel, temp_mix_offset);
+                                samples_to_read - samples_read, channel, temp_mix_offset,
+                                scratch);
                 break;
             default:
                 UNREACHABLE_MSG("Unimplemented sample format={}", in_params.sample_format);
@@ -1346,17 +1472,22 @@ void CommandGenerator::DecodeFromWaveBuffers(ServerVoiceInfo& voice_info, std::s
 
         if (in_params.behavior_flags.is_pitch_and_src_skipped.Value()) {
             // No need to resample
-            std::memcpy(output.data() + samples_output, sample_buffer.data(),
+            std::memcpy(output.data() + samples_output, scratch.data(),
                         samples_read * sizeof(s32));
         } else {
-            std::fill(sample_buffer.begin() + temp_mix_offset,
-                      sample_buffer.begin() + temp_mix_offset + (samples_to_read - samples_read),
+            std::fill(scratch.begin() + temp_mix_offset,
+                      scratch.begin() + temp_mix_offset + (samples_to_read - samples_read),
                       0);
-            AudioCore::Resample(output.data() + samples_output, sample_buffer.data(), resample_rate,
-                                dsp_state.fraction, samples_to_output);
+            if (in_params.src_quality == SrcQuality::Low) {
+                AudioCore::ResampleLinear(output.data() + samples_output, scratch.data(),
+                                          resample_rate, dsp_state.fraction, samples_to_output);
+            } else {
+                AudioCore::Resample(output.data() + samples_output, scratch.data(),
+                                    resample_rate, dsp_state.fraction, samples_to_output);
+            }
             // Resample
             for (std::size_t i = 0; i < AudioCommon::MAX_SAMPLE_HISTORY; i++) {
-                dsp_state.sample_history[i] = sample_buffer[samples_to_read + i];
+                dsp_state.sample_history[i] = scratch[samples_to_read + i];
             }
         }
         samples_remaining -= samples_to_output;
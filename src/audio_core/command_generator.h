@@ -5,11 +5,19 @@
 #pragma once
 
 #include <array>
+#include <memory>
 #include <span>
+#include <vector>
+#include "audio_core/adpcm_cache.h"
 #include "audio_core/common.h"
 #include "audio_core/voice_context.h"
 #include "common/common_types.h"
 
+namespace Common {
+template <class StateType>
+class StatefulThreadWorker;
+}
+
 namespace Core::Memory {
 class Memory;
 }
@@ -51,15 +59,26 @@ public:
     [[nodiscard]] std::size_t GetTotalMixBufferCount() const;
 
 private:
-    void GenerateDataSourceCommand(ServerVoiceInfo& voice_info, VoiceState& dsp_state, s32 channel);
+    /// Decodes the voices queued this frame on the voice workers, then mixes them in order
+    void GenerateVoiceCommandsParallel();
+    /// Decodes, resamples and ramps the volume of each voice channel into channel_buffers
+    void GenerateVoiceSourceCommand(ServerVoiceInfo& voice_info, std::span<s32> channel_buffers,
+                                    std::span<s32> scratch);
+    /// Mixes the voice channels in channel_buffers into their destination mix buffers
+    void GenerateVoiceMixCommands(ServerVoiceInfo& voice_info,
+                                  std::span<const s32> channel_buffers);
+    void GenerateDataSourceCommand(ServerVoiceInfo& voice_info, VoiceState& dsp_state,
+                                   std::span<s32> channel_buffers, s32 channel,
+                                   std::span<s32> scratch);
+    void GenerateVoiceDepopCommand(ServerVoiceInfo& voice_info, VoiceState& dsp_state);
     void GenerateBiquadFilterCommandForVoice(ServerVoiceInfo& voice_info, VoiceState& dsp_state,
                                              s32 mix_buffer_count, s32 channel);
-    void GenerateVolumeRampCommand(float last_volume, float current_volume, s32 channel,
-                                   s32 node_id);
+    void GenerateVolumeRampCommand(float last_volume, float current_volume,
+                                   std::span<s32> buffer, s32 channel, s32 node_id);
     void GenerateVoiceMixCommand(const MixVolumeBuffer& mix_volumes,
                                  const MixVolumeBuffer& last_mix_volumes, VoiceState& dsp_state,
-                                 s32 mix_buffer_offset, s32 mix_buffer_count, s32 voice_index,
-                                 s32 node_id);
+                                 s32 mix_buffer_offset, s32 mix_buffer_count,
+                                 std::span<const s32> input, s32 voice_index, s32 node_id);
     void GenerateSubMixCommand(ServerMixInfo& mix_info);
     void GenerateMixCommands(ServerMixInfo& mix_info);
     void GenerateMixCommand(std::size_t output_offset, std::size_t input_offset, float volume,
@@ -73,10 +92,18 @@ private:
     void GenerateDepopForMixBuffersCommand(std::size_t mix_buffer_count,
                                            std::size_t mix_buffer_offset, s32 sample_rate);
     void GenerateEffectCommand(ServerMixInfo& mix_info);
+    /// Returns true when the mix has an effect heavy enough to run on the DSP thread
+    [[nodiscard]] bool HasEffectForDspThread(const ServerMixInfo& mix_info) const;
+    /// Marks every mix buffer read or written while generating the sub mix
+    void MarkSubMixBuffers(const ServerMixInfo& mix_info, std::vector<bool>& usage);
     void GenerateI3dl2ReverbEffectCommand(s32 mix_buffer_offset, EffectBase* info, bool enabled);
     void GenerateBiquadFilterEffectCommand(s32 mix_buffer_offset, EffectBase* info, bool enabled);
     void GenerateAuxCommand(s32 mix_buffer_offset, EffectBase* info, bool enabled);
     [[nodiscard]] ServerSplitterDestinationData* GetDestinationData(s32 splitter_id, s32 index);
+    [[nodiscard]] std::span<s32> GetVoiceChannelBuffer(std::span<s32> channel_buffers,
+                                                       s32 channel) const;
+    [[nodiscard]] std::span<const s32> GetVoiceChannelBuffer(std::span<const s32> channel_buffers,
+                                                             s32 channel) const;
 
     s32 WriteAuxBuffer(AuxInfoDSP& dsp_info, VAddr send_buffer, u32 max_samples,
                        std::span<const s32> data, u32 sample_count, u32 write_offset,
@@ -90,12 +117,14 @@ private:
     // DSP Code
     template <typename T>
     s32 DecodePcm(ServerVoiceInfo& voice_info, VoiceState& dsp_state, s32 sample_start_offset,
-                  s32 sample_end_offset, s32 sample_count, s32 channel, std::size_t mix_offset);
+                  s32 sample_end_offset, s32 sample_count, s32 channel, std::size_t mix_offset,
+                  std::span<s32> scratch);
     s32 DecodeAdpcm(ServerVoiceInfo& voice_info, VoiceState& dsp_state, s32 sample_start_offset,
-                    s32 sample_end_offset, s32 sample_count, s32 channel, std::size_t mix_offset);
+                    s32 sample_end_offset, s32 sample_count, s32 channel, std::size_t mix_offset,
+                    std::span<s32> scratch);
     void DecodeFromWaveBuffers(ServerVoiceInfo& voice_info, std::span<s32> output,
                                VoiceState& dsp_state, s32 channel, s32 target_sample_rate,
-                               s32 sample_count, s32 node_id);
+                               s32 sample_count, s32 node_id, std::span<s32> scratch);
 
     AudioCommon::AudioRendererParameter& worker_params;
     VoiceContext& voice_context;
@@ -106,6 +135,13 @@ private:
     std::vector<s32> mix_buffer{};
     std::vector<s32> sample_buffer{};
     std::vector<s32> depop_buffer{};
+    std::vector<ServerVoiceInfo*> queued_voices;
+    std::vector<s32> voice_buffers;
+    AdpcmCache adpcm_cache;
+    std::unique_ptr<Common::StatefulThreadWorker<std::vector<s32>>> voice_workers;
+    std::unique_ptr<Common::StatefulThreadWorker<void>> effect_worker;
+    std::vector<bool> pending_mix_buffers;
+    std::vector<bool> mix_buffer_usage;
     bool dumping_frame{false};
 };
 } // namespace AudioCore
@@ -3,9 +3,13 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <cmath>
 #include <cstring>
 #include "audio_core/cubeb_sink.h"
+#include "audio_core/sink_stats.h"
 #include "audio_core/stream.h"
 #include "audio_core/time_stretch.h"
 #include "common/assert.h"
@@ -21,13 +25,14 @@ namespace AudioCore {
 
 class CubebSinkStream final : public SinkStream {
 public:
-    CubebSinkStream(cubeb* ctx_, u32 sample_rate, u32 num_channels_, cubeb_devid output_device,
+    CubebSinkStream(cubeb* ctx_, u32 sample_rate_, u32 num_channels_, cubeb_devid output_device,
                     const std::string& name)
-        : ctx{ctx_}, num_channels{std::min(num_channels_, 6u)}, time_stretch{sample_rate,
-                                                                             num_channels} {
+        : ctx{ctx_}, num_channels{std::min(num_channels_, 6u)}, sample_rate{sample_rate_},
+          low_latency{Settings::values.audio_low_latency.GetValue()},
+          time_stretch{sample_rate_, num_channels} {
 
         cubeb_stream_params params{};
-        params.rate = sample_rate;
+        params.rate = sample_rate_;
         params.channels = num_channels;
         params.format = CUBEB_SAMPLE_S16NE;
         params.prefs = CUBEB_STREAM_PREF_PERSIST;
@@ -48,8 +53,12 @@ public:
             LOG_CRITICAL(Audio_Sink, "Error getting minimum latency");
         }
 
+        // The low latency mode trusts the backend's minimum, the queue is trimmed at runtime
+        const u32 latency_frames = low_latency && minimum_latency != 0
+                                       ? minimum_latency
+                                       : std::max(512u, minimum_latency);
         if (cubeb_stream_init(ctx, &stream_backend, name.c_str(), nullptr, nullptr, output_device,
-                              &params, std::max(512u, minimum_latency),
+                              &params, latency_frames,
                               &CubebSinkStream::DataCallback, &CubebSinkStream::StateCallback,
                               this) != CUBEB_OK) {
             LOG_CRITICAL(Audio_Sink, "Error initializing cubeb stream");
@@ -99,10 +108,12 @@ public:
                 buf.push_back(static_cast<s16>(right + (clev * center / 1000) +
                                                (slev * surround_right / 1000)));
             }
+            TrackEnqueueSize(buf.size() / num_channels);
             queue.Push(buf);
             return;
         }
 
+        TrackEnqueueSize(samples.size() / num_channels);
         queue.Push(samples);
     }
 
@@ -121,12 +132,90 @@ public:
         return num_channels;
     }
 
+    /// Updates the queue statistics and, in low latency mode, trims the queue to its target
+    /// depth. Called from the device callback before samples are consumed.
+    void UpdateQueue(std::size_t num_frames) {
+        const std::size_t queued_frames = queue.Size() / num_channels;
+        RecordSinkQueueDepth(static_cast<u32>(queued_frames * 1000 / sample_rate));
+        if (!low_latency) {
+            return;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (last_callback != std::chrono::steady_clock::time_point{}) {
+            const std::chrono::duration<double> interval = now - last_callback;
+            const double interval_frames = interval.count() * static_cast<double>(sample_rate);
+            const double deviation = std::abs(interval_frames - static_cast<double>(num_frames));
+            callback_jitter_frames += (deviation - callback_jitter_frames) / 16.0;
+        }
+        last_callback = now;
+
+        // Keep enough samples to cover the next callback, its measured jitter and the margin
+        // built by recent underruns. Excess beyond one producer buffer past the target is
+        // dropped, as it would only add latency.
+        const std::size_t target_frames = num_frames +
+                                          static_cast<std::size_t>(callback_jitter_frames * 2.0) +
+                                          underrun_margin_frames;
+        const std::size_t limit_frames =
+            target_frames + max_enqueue_frames.load(std::memory_order_relaxed);
+        if (queued_frames <= limit_frames) {
+            return;
+        }
+        std::size_t samples_to_drop = (queued_frames - target_frames) * num_channels;
+        RecordSinkDroppedSamples(samples_to_drop);
+        std::array<s16, 512> discard;
+        while (samples_to_drop > 0) {
+            const std::size_t popped =
+                queue.Pop(discard.data(), std::min(samples_to_drop, discard.size()));
+            if (popped == 0) {
+                break;
+            }
+            samples_to_drop -= popped;
+        }
+    }
+
+    /// Records the result of a device callback, growing the low latency margin on underruns
+    void ReportCallback(std::size_t samples_written, std::size_t samples_requested,
+                        std::size_t num_frames) {
+        const bool is_underrun = samples_written < samples_requested;
+        if (is_underrun && (samples_written > 0 || was_playing)) {
+            RecordSinkUnderrun();
+            if (low_latency) {
+                underrun_margin_frames =
+                    std::min(underrun_margin_frames + num_frames, MAX_UNDERRUN_MARGIN_FRAMES);
+            }
+        } else if (underrun_margin_frames > 0) {
+            --underrun_margin_frames;
+        }
+        was_playing = !is_underrun;
+    }
+
 private:
+    /// Largest margin added to the low latency queue target after underruns
+    static constexpr std::size_t MAX_UNDERRUN_MARGIN_FRAMES = 4096;
+
+    void TrackEnqueueSize(std::size_t num_frames) {
+        std::size_t current = max_enqueue_frames.load(std::memory_order_relaxed);
+        while (current < num_frames && !max_enqueue_frames.compare_exchange_weak(
+                                           current, num_frames, std::memory_order_relaxed)) {
+        }
+    }
+
     std::vector<std::string> device_list;
 
     cubeb* ctx{};
     cubeb_stream* stream_backend{};
     u32 num_channels{};
+    u32 sample_rate{};
+    bool low_latency{};
+
+    // Only accessed from the device callback
+    std::chrono::steady_clock::time_point last_callback{};
+    double callback_jitter_frames{};
+    std::size_t underrun_margin_frames{};
+    bool was_playing{};
+
+    std::atomic<std::size_t> max_enqueue_frames{};
 
     Common::RingBuffer<s16, 0x10000> queue;
     std::array<s16, 2> last_frame{};
@@ -207,6 +296,8 @@ long CubebSinkStream::DataCallback([[maybe_unused]] cubeb_stream* stream, void*
     const std::size_t samples_to_write = num_channels * num_frames;
     std::size_t samples_written;
 
+    impl->UpdateQueue(static_cast<std::size_t>(num_frames));
+
     /*
     if (Settings::values.enable_audio_stretching.GetValue()) {
         const std::vector<s16> in{impl->queue.Pop()};
@@ -224,6 +315,7 @@ long CubebSinkStream::DataCallback([[maybe_unused]] cubeb_stream* stream, void*
         samples_written = impl->queue.Pop(buffer, samples_to_write);
     }*/
     samples_written = impl->queue.Pop(buffer, samples_to_write);
+    impl->ReportCallback(samples_written, samples_to_write, static_cast<std::size_t>(num_frames));
 
     if (samples_written >= num_channels) {
         std::memcpy(&impl->last_frame[0], buffer + (samples_written - num_channels) * sizeof(s16),
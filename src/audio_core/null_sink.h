@@ -26,6 +26,10 @@ private:
             return 0;
         }
 
+        bool IsOutputting() const override {
+            return false;
+        }
+
         void Flush() override {}
     } null_sink_stream;
 };
@@ -0,0 +1,177 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+
+#include "audio_core/renderer_capture.h"
+#include "audio_core/voice_context.h"
+#include "common/cityhash.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "core/memory.h"
+
+namespace AudioCore::Capture {
+namespace {
+/// Buffered capture data written to the file at once
+constexpr std::size_t FLUSH_THRESHOLD = 1ULL << 20;
+/// Guest ranges larger than this are not captured
+constexpr std::size_t MAX_MEMORY_RECORD_SIZE = 64ULL << 20;
+
+template <typename T>
+void Append(std::vector<u8>& out, const T& value) {
+    const std::size_t offset = out.size();
+    out.resize(offset + sizeof(T));
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+} // Anonymous namespace
+
+void EncodeHeader(std::vector<u8>& out, const AudioCommon::AudioRendererParameter& params) {
+    Append(out, FileHeader{
+                    .magic = MAGIC,
+                    .version = VERSION,
+                    .params = params,
+                });
+}
+
+void EncodeRecord(std::vector<u8>& out, RecordType type, u64 address,
+                  std::span<const u8> payload) {
+    Append(out, RecordHeader{
+                    .type = type,
+                    .reserved = 0,
+                    .address = address,
+                    .size = payload.size(),
+                });
+    out.insert(out.end(), payload.begin(), payload.end());
+}
+
+void EncodeFrame(std::vector<u8>& out, std::span<const s16> samples) {
+    const FrameRecord frame{
+        .sample_count = samples.size(),
+        .hash = Common::CityHash64(reinterpret_cast<const char*>(samples.data()),
+                                   samples.size_bytes()),
+    };
+    EncodeRecord(out, RecordType::Frame, 0,
+                 std::span(reinterpret_cast<const u8*>(&frame), sizeof(frame)));
+}
+
+Reader::Reader(std::span<const u8> data_) : data{data_} {
+    if (data.size() < sizeof(FileHeader)) {
+        return;
+    }
+    std::memcpy(&header, data.data(), sizeof(FileHeader));
+    offset = sizeof(FileHeader);
+    is_valid = header.magic == MAGIC && header.version == VERSION;
+}
+
+std::optional<Record> Reader::Next() {
+    if (!is_valid || data.size() - offset < sizeof(RecordHeader)) {
+        return std::nullopt;
+    }
+    RecordHeader record_header;
+    std::memcpy(&record_header, data.data() + offset, sizeof(RecordHeader));
+    if (data.size() - offset - sizeof(RecordHeader) < record_header.size) {
+        return std::nullopt;
+    }
+    const Record record{
+        .type = record_header.type,
+        .address = record_header.address,
+        .payload = data.subspan(offset + sizeof(RecordHeader),
+                                static_cast<std::size_t>(record_header.size)),
+    };
+    offset += sizeof(RecordHeader) + static_cast<std::size_t>(record_header.size);
+    return record;
+}
+
+RendererCapture::RendererCapture(const std::filesystem::path& path,
+                                 const AudioCommon::AudioRendererParameter& params) {
+    if (!Common::FS::CreateParentDirs(path)) {
+        LOG_ERROR(Audio, "Failed to create the directory of audio renderer capture path={}",
+                  Common::FS::PathToUTF8String(path));
+        return;
+    }
+    file = std::make_unique<Common::FS::IOFile>(path, Common::FS::FileAccessMode::Write,
+                                                Common::FS::FileType::BinaryFile);
+    if (!file->IsOpen()) {
+        LOG_ERROR(Audio, "Failed to open audio renderer capture path={}",
+                  Common::FS::PathToUTF8String(path));
+        return;
+    }
+    LOG_INFO(Audio, "Capturing audio renderer to path={}", Common::FS::PathToUTF8String(path));
+    EncodeHeader(pending, params);
+}
+
+RendererCapture::~RendererCapture() {
+    FlushIfNeeded(true);
+}
+
+bool RendererCapture::IsOpen() const {
+    return file && file->IsOpen();
+}
+
+void RendererCapture::RecordVoiceMemory(Core::Memory::Memory& memory,
+                                        const VoiceContext& voice_context) {
+    const std::size_t voice_count = voice_context.GetVoiceCount();
+    for (std::size_t i = 0; i < voice_count; i++) {
+        const auto& in_params = voice_context.GetInfo(i).GetInParams();
+        if (!in_params.in_use) {
+            continue;
+        }
+        for (const auto& wave_buffer : in_params.wave_buffer) {
+            RecordMemory(memory, wave_buffer.buffer_address, wave_buffer.buffer_size);
+        }
+        RecordMemory(memory, in_params.additional_params_address,
+                     in_params.additional_params_size);
+    }
+}
+
+void RendererCapture::RecordUpdate(std::span<const u8> input_params) {
+    if (!IsOpen()) {
+        return;
+    }
+    EncodeRecord(pending, RecordType::Update, 0, input_params);
+    FlushIfNeeded(false);
+}
+
+void RendererCapture::RecordFrame(std::span<const s16> samples) {
+    if (!IsOpen()) {
+        return;
+    }
+    EncodeFrame(pending, samples);
+    FlushIfNeeded(false);
+}
+
+void RendererCapture::RecordMemory(Core::Memory::Memory& memory, VAddr address,
+                                   std::size_t size) {
+    if (!IsOpen() || address == 0 || size == 0 || size > MAX_MEMORY_RECORD_SIZE) {
+        return;
+    }
+    read_buffer.resize(size);
+    memory.ReadBlock(address, read_buffer.data(), size);
+    const u64 hash = Common::CityHash64(reinterpret_cast<const char*>(read_buffer.data()), size);
+
+    const auto [it, is_new] = recorded_memory.try_emplace(address, size, hash);
+    if (!is_new) {
+        if (it->second.first == size && it->second.second == hash) {
+            return;
+        }
+        it->second = {size, hash};
+    }
+    EncodeRecord(pending, RecordType::Memory, address, read_buffer);
+    FlushIfNeeded(false);
+}
+
+void RendererCapture::FlushIfNeeded(bool force) {
+    if (!IsOpen() || pending.empty() || (!force && pending.size() < FLUSH_THRESHOLD)) {
+        return;
+    }
+    if (file->WriteSpan(std::span<const u8>(pending)) != pending.size()) {
+        LOG_ERROR(Audio, "Failed to write audio renderer capture, stopping capture");
+        file.reset();
+    }
+    pending.clear();
+}
+
+} // namespace AudioCore::Capture
@@ -0,0 +1,142 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "audio_core/common.h"
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+
+namespace Common::FS {
+class IOFile;
+}
+
+namespace Core::Memory {
+class Memory;
+}
+
+namespace AudioCore {
+class VoiceContext;
+}
+
+namespace AudioCore::Capture {
+
+/**
+ * Audio renderer captures hold everything needed to reproduce the output of a renderer offline.
+ * A capture is a FileHeader followed by records, each one a RecordHeader followed by its payload.
+ * Update records hold the input of AudioRenderer::UpdateAudioRenderer. Memory records hold guest
+ * memory referenced by voices, written after the update that first references it and again
+ * whenever it changes, and must be applied before the next frame is mixed. Frame records hold a
+ * hash of each mixed output buffer, for bit comparisons.
+ */
+constexpr u32 MAGIC = Common::MakeMagic('Y', 'A', 'R', 'C');
+constexpr u32 VERSION = 1;
+
+enum class RecordType : u32 {
+    Update = 0,
+    Memory = 1,
+    Frame = 2,
+};
+
+struct FileHeader {
+    u32 magic;
+    u32 version;
+    AudioCommon::AudioRendererParameter params;
+};
+
+struct RecordHeader {
+    RecordType type;
+    u32 reserved;
+    /// Guest address of memory records, zero otherwise
+    u64 address;
+    u64 size;
+};
+static_assert(sizeof(RecordHeader) == 0x18, "RecordHeader is an invalid size");
+
+struct FrameRecord {
+    u64 sample_count;
+    u64 hash;
+};
+
+struct Record {
+    RecordType type;
+    u64 address;
+    std::span<const u8> payload;
+};
+
+/// Appends the capture header to out
+void EncodeHeader(std::vector<u8>& out, const AudioCommon::AudioRendererParameter& params);
+
+/// Appends a record to out
+void EncodeRecord(std::vector<u8>& out, RecordType type, u64 address,
+                  std::span<const u8> payload);
+
+/// Appends a frame record with the hash of an output buffer to out
+void EncodeFrame(std::vector<u8>& out, std::span<const s16> samples);
+
+/// Iterates the records of a capture held in memory
+class Reader {
+public:
+    explicit Reader(std::span<const u8> data_);
+
+    /// Returns true when the capture has a valid header of a supported version
+    [[nodiscard]] bool IsValid() const noexcept {
+        return is_valid;
+    }
+
+    [[nodiscard]] const AudioCommon::AudioRendererParameter& Params() const noexcept {
+        return header.params;
+    }
+
+    /// Returns the next record, or nothing at the end of the capture or on a truncated record
+    [[nodiscard]] std::optional<Record> Next();
+
+private:
+    std::span<const u8> data;
+    std::size_t offset = 0;
+    FileHeader header{};
+    bool is_valid = false;
+};
+
+/// Streams the inputs and outputs of an audio renderer instance to a capture file
+class RendererCapture {
+public:
+    explicit RendererCapture(const std::filesystem::path& path,
+                             const AudioCommon::AudioRendererParameter& params);
+    ~RendererCapture();
+
+    RendererCapture(const RendererCapture&) = delete;
+    RendererCapture& operator=(const RendererCapture&) = delete;
+
+    [[nodiscard]] bool IsOpen() const;
+
+    /// Records the guest memory read by the voices, when it changed since it was last recorded
+    void RecordVoiceMemory(Core::Memory::Memory& memory, const VoiceContext& voice_context);
+
+    /// Records the input of an audio renderer update
+    void RecordUpdate(std::span<const u8> input_params);
+
+    /// Records the hash of a mixed output buffer
+    void RecordFrame(std::span<const s16> samples);
+
+private:
+    void RecordMemory(Core::Memory::Memory& memory, VAddr address, std::size_t size);
+    void FlushIfNeeded(bool force);
+
+    std::unique_ptr<Common::FS::IOFile> file;
+    std::vector<u8> pending;
+    std::vector<u8> read_buffer;
+    /// Hash of the last recorded contents of each guest range, keyed by address
+    std::unordered_map<VAddr, std::pair<std::size_t, u64>> recorded_memory;
+};
+
+} // namespace AudioCore::Capture
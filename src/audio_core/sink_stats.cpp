@@ -0,0 +1,40 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <atomic>
+
+#include "audio_core/sink_stats.h"
+
+namespace AudioCore {
+namespace {
+// Device callbacks run on threads owned by the audio backends, so the counters are global
+std::atomic<u64> underruns;
+std::atomic<u32> max_queue_depth_ms;
+std::atomic<u64> dropped_samples;
+} // Anonymous namespace
+
+void RecordSinkUnderrun() {
+    underruns.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RecordSinkQueueDepth(u32 depth_ms) {
+    u32 current = max_queue_depth_ms.load(std::memory_order_relaxed);
+    while (current < depth_ms && !max_queue_depth_ms.compare_exchange_weak(
+                                     current, depth_ms, std::memory_order_relaxed)) {
+    }
+}
+
+void RecordSinkDroppedSamples(u64 num_samples) {
+    dropped_samples.fetch_add(num_samples, std::memory_order_relaxed);
+}
+
+SinkStats GetAndResetSinkStats() {
+    return {
+        .underruns = underruns.exchange(0, std::memory_order_relaxed),
+        .max_queue_depth_ms = max_queue_depth_ms.exchange(0, std::memory_order_relaxed),
+        .dropped_samples = dropped_samples.exchange(0, std::memory_order_relaxed),
+    };
+}
+
+} // namespace AudioCore
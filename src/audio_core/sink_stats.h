@@ -0,0 +1,33 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "common/common_types.h"
+
+namespace AudioCore {
+
+/// Output statistics of every sink stream, accumulated since the last reset
+struct SinkStats {
+    /// Number of device callbacks that ran out of queued samples while playing
+    u64 underruns;
+    /// Deepest sample queue seen by a device callback, in milliseconds
+    u32 max_queue_depth_ms;
+    /// Number of samples dropped to keep the queue at its target depth
+    u64 dropped_samples;
+};
+
+/// Records a device callback that ran out of queued samples
+void RecordSinkUnderrun();
+
+/// Records the depth of the sample queue seen by a device callback
+void RecordSinkQueueDepth(u32 depth_ms);
+
+/// Records samples dropped from a sample queue
+void RecordSinkDroppedSamples(u64 num_samples);
+
+/// Returns the statistics accumulated since the last call and resets them
+SinkStats GetAndResetSinkStats();
+
+} // namespace AudioCore
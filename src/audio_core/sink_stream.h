@@ -28,6 +28,11 @@ public:
 
     virtual std::size_t SamplesInQueue(u32 num_channels) const = 0;
 
+    /// Returns false when the sink discards its samples, its queue is then always empty
+    virtual bool IsOutputting() const {
+        return true;
+    }
+
     virtual void Flush() = 0;
 };
 
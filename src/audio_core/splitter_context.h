@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <span>
 #include <stack>
 #include <vector>
 #include "audio_core/common.h"
@@ -185,7 +186,7 @@ public:
     void Initialize(BehaviorInfo& behavior_info, std::size_t splitter_count,
                     std::size_t data_count);
 
-    bool Update(const std::vector<u8>& input, std::size_t& input_offset, std::size_t& bytes_read);
+    bool Update(std::span<const u8> input, std::size_t& input_offset, std::size_t& bytes_read);
     bool UsingSplitter() const;
 
     ServerSplitterInfo& GetInfo(std::size_t i);
@@ -202,12 +203,12 @@ public:
 
 private:
     void Setup(std::size_t info_count, std::size_t data_count, bool is_splitter_bug_fixed);
-    bool UpdateInfo(const std::vector<u8>& input, std::size_t& input_offset,
+    bool UpdateInfo(std::span<const u8> input, std::size_t& input_offset,
                     std::size_t& bytes_read, s32 in_splitter_count);
-    bool UpdateData(const std::vector<u8>& input, std::size_t& input_offset,
+    bool UpdateData(std::span<const u8> input, std::size_t& input_offset,
                     std::size_t& bytes_read, s32 in_data_count);
     bool RecomposeDestination(ServerSplitterInfo& info, SplitterInfo::InInfoPrams& header,
-                              const std::vector<u8>& input, const std::size_t& input_offset);
+                              std::span<const u8> input, const std::size_t& input_offset);
 
     std::vector<ServerSplitterInfo> infos{};
     std::vector<ServerSplitterDestinationData> datas{};
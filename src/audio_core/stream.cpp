@@ -63,6 +63,13 @@ void Stream::SetVolume(float volume) {
     game_volume = volume;
 }
 
+std::optional<std::size_t> Stream::GetSinkQueueSize() const {
+    if (!sink_stream.IsOutputting()) {
+        return std::nullopt;
+    }
+    return sink_stream.SamplesInQueue(GetNumChannels());
+}
+
 Stream::State Stream::GetState() const {
     return state;
 }
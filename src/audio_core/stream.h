@@ -7,6 +7,7 @@
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 #include <queue>
@@ -97,6 +98,10 @@ public:
     /// Gets the number of channels
     [[nodiscard]] u32 GetNumChannels() const;
 
+    /// Returns the number of samples per channel the sink has yet to play, or std::nullopt when
+    /// the sink discards them
+    [[nodiscard]] std::optional<std::size_t> GetSinkQueueSize() const;
+
     /// Get the state
     [[nodiscard]] State GetState() const;
 
@@ -62,6 +62,7 @@ void ServerVoiceInfo::Initialize() {
     in_params.sample_format = SampleFormat::Invalid;
     in_params.channel_count = 0;
     in_params.pitch = 0.0f;
+    in_params.src_quality = SrcQuality::Default;
     in_params.volume = 0.0f;
     in_params.last_volume = 0.0f;
     in_params.biquad_filter.fill({});
@@ -123,6 +124,7 @@ void ServerVoiceInfo::UpdateParameters(const VoiceInfo::InParams& voice_in,
     in_params.sample_format = voice_in.sample_format;
     in_params.channel_count = voice_in.channel_count;
     in_params.pitch = voice_in.pitch;
+    in_params.src_quality = voice_in.src_quality;
     in_params.volume = voice_in.volume;
     in_params.biquad_filter = voice_in.biquad_filter;
     in_params.wave_buffer_count = voice_in.wave_buffer_count;
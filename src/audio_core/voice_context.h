@@ -31,6 +31,12 @@ enum class SampleFormat : u8 {
     Adpcm = 6,
 };
 
+enum class SrcQuality : u32 {
+    Default = 0,
+    High = 1,
+    Low = 2,
+};
+
 enum class PlayState : u8 {
     Started = 0,
     Stopped = 1,
@@ -178,7 +184,8 @@ public:
         u8 wave_buffer_flush_request_count{};
         INSERT_PADDING_BYTES(2);
         BehaviorFlags behavior_flags{};
-        INSERT_PADDING_BYTES(16);
+        SrcQuality src_quality{};
+        INSERT_PADDING_BYTES(12);
     };
     static_assert(sizeof(InParams) == 0x170, "InParams is an invalid size");
 
@@ -215,6 +222,7 @@ public:
         s16 wave_buffer_head{};
         INSERT_PADDING_BYTES(2);
         BehaviorFlags behavior_flags{};
+        SrcQuality src_quality{};
         VAddr additional_params_address{};
         std::size_t additional_params_size{};
         std::array<ServerWaveBuffer, AudioCommon::MAX_WAVE_BUFFERS> wave_buffer{};
@@ -0,0 +1,167 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+
+#include "common/common_types.h"
+
+namespace Common {
+
+/// Fixed capacity single reader, single writer queue.
+/// Elements are stored in pre-allocated slots that are reused, so pushing never allocates.
+/// Multiple writers must be serialized by the caller.
+/// A reader waiting on an empty queue spins for a short while before parking on a condition
+/// variable, and a writer parks while the queue is full.
+/// @tparam T        Element type, it must be default constructible
+/// @tparam capacity Number of slots in the queue
+template <typename T, std::size_t capacity>
+class BoundedSPSCQueue {
+    static_assert(capacity > 0 && (capacity & (capacity - 1)) == 0,
+                  "capacity must be a power of two");
+    static_assert(std::atomic_size_t::is_always_lock_free);
+
+public:
+    [[nodiscard]] std::size_t Size() const {
+        return m_write_index.load() - m_read_index.load();
+    }
+
+    [[nodiscard]] bool Empty() const {
+        return Size() == 0;
+    }
+
+    [[nodiscard]] constexpr std::size_t Capacity() const {
+        return capacity;
+    }
+
+    /// Returns the element at the front of the queue. Only valid for the reader on a non-empty
+    /// queue.
+    [[nodiscard]] T& Front() {
+        return m_slots[m_read_index.load(std::memory_order_relaxed) % capacity];
+    }
+
+    template <typename Arg>
+    void Push(Arg&& t) {
+        const std::size_t write_index = m_write_index.load(std::memory_order_relaxed);
+        if (write_index - m_read_index.load() == capacity) {
+            WaitNotFull(write_index);
+        }
+        m_slots[write_index % capacity] = std::forward<Arg>(t);
+        m_write_index.store(write_index + 1);
+
+        if (m_reader_waiting.load()) {
+            std::lock_guard lock{m_mutex};
+            m_reader_cv.notify_one();
+        }
+    }
+
+    /// Pushes an element unless the queue is full, never blocks.
+    /// @returns true if the element was pushed
+    template <typename Arg>
+    bool TryPush(Arg&& t) {
+        const std::size_t write_index = m_write_index.load(std::memory_order_relaxed);
+        if (write_index - m_read_index.load() == capacity) {
+            return false;
+        }
+        m_slots[write_index % capacity] = std::forward<Arg>(t);
+        m_write_index.store(write_index + 1);
+
+        if (m_reader_waiting.load()) {
+            std::lock_guard lock{m_mutex};
+            m_reader_cv.notify_one();
+        }
+        return true;
+    }
+
+    void Pop() {
+        const std::size_t read_index = m_read_index.load(std::memory_order_relaxed);
+        // Release the resources held by the element now instead of when the slot is reused
+        m_slots[read_index % capacity] = T{};
+        m_read_index.store(read_index + 1);
+
+        if (m_writer_waiting.load()) {
+            std::lock_guard lock{m_mutex};
+            m_writer_cv.notify_one();
+        }
+    }
+
+    bool Pop(T& t) {
+        if (Empty()) {
+            return false;
+        }
+        t = std::move(Front());
+        Pop();
+        return true;
+    }
+
+    /// Waits until the queue holds at least one element.
+    void Wait() {
+        for (u32 spin = 0; spin < SPIN_COUNT; ++spin) {
+            if (!Empty()) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+        // The writer checks the waiting flag after publishing an element, and the reader checks
+        // the queue after raising the flag, so at least one of them sees the other.
+        m_reader_waiting.store(true);
+        {
+            std::unique_lock lock{m_mutex};
+            m_reader_cv.wait(lock, [this] { return !Empty(); });
+        }
+        m_reader_waiting.store(false);
+    }
+
+    T PopWait() {
+        Wait();
+        T t;
+        Pop(t);
+        return t;
+    }
+
+private:
+    /// Number of times the reader polls an empty queue before parking
+    static constexpr u32 SPIN_COUNT = 64;
+
+    void WaitNotFull(std::size_t write_index) {
+        const auto is_not_full = [this, write_index] {
+            return write_index - m_read_index.load() < capacity;
+        };
+        m_writer_waiting.store(true);
+        {
+            std::unique_lock lock{m_mutex};
+            m_writer_cv.wait(lock, is_not_full);
+        }
+        m_writer_waiting.store(false);
+    }
+
+    // Keep the indices written by each side on their own cache line to avoid false sharing.
+    // TODO: Remove this ifdef whenever clang and GCC support
+    //       std::hardware_destructive_interference_size.
+#if defined(_MSC_VER) && _MSC_VER >= 1911
+    alignas(std::hardware_destructive_interference_size) std::atomic_size_t m_read_index{0};
+    alignas(std::hardware_destructive_interference_size) std::atomic_size_t m_write_index{0};
+#else
+    alignas(128) std::atomic_size_t m_read_index{0};
+    alignas(128) std::atomic_size_t m_write_index{0};
+#endif
+
+    alignas(128) std::atomic_bool m_reader_waiting{false};
+    std::atomic_bool m_writer_waiting{false};
+    std::mutex m_mutex;
+    std::condition_variable m_reader_cv;
+    std::condition_variable m_writer_cv;
+
+    std::array<T, capacity> m_slots;
+};
+
+} // namespace Common
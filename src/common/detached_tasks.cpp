@@ -2,9 +2,9 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
-#include <thread>
 #include "common/assert.h"
 #include "common/detached_tasks.h"
+#include "common/thread_pool.h"
 
 namespace Common {
 
@@ -29,14 +29,18 @@ DetachedTasks::~DetachedTasks() {
 }
 
 void DetachedTasks::AddTask(std::function<void()> task) {
-    std::unique_lock lock{instance->mutex};
-    ++instance->count;
-    std::thread([task{std::move(task)}]() {
+    {
+        std::scoped_lock lock{instance->mutex};
+        ++instance->count;
+    }
+    // Detached tasks are mostly telemetry and file writes, so they run on the I/O threads
+    ThreadPool::Instance().Submit(TaskPriority::IO, [task{std::move(task)}](std::stop_token) {
         task();
-        std::unique_lock lock{instance->mutex};
-        --instance->count;
-        std::notify_all_at_thread_exit(instance->cv, std::move(lock));
-    }).detach();
+        std::scoped_lock lock{instance->mutex};
+        if (--instance->count == 0) {
+            instance->cv.notify_all();
+        }
+    });
 }
 
 } // namespace Common
@@ -24,7 +24,7 @@ struct Fiber::FiberImpl {
     std::function<void(void*)> rewind_point;
     void* rewind_parameter{};
     void* start_parameter{};
-    std::shared_ptr<Fiber> previous_fiber;
+    Fiber* previous_fiber{};
     bool is_thread_fiber{};
     bool released{};
 
@@ -47,7 +47,7 @@ void Fiber::Start(boost::context::detail::transfer_t& transfer) {
     ASSERT(impl->previous_fiber != nullptr);
     impl->previous_fiber->impl->context = transfer.fctx;
     impl->previous_fiber->impl->guard.unlock();
-    impl->previous_fiber.reset();
+    impl->previous_fiber = nullptr;
     impl->entry_point(impl->start_parameter);
     UNREACHABLE();
 }
@@ -118,7 +118,9 @@ void Fiber::Rewind() {
 
 void Fiber::YieldTo(std::weak_ptr<Fiber> weak_from, Fiber& to) {
     to.impl->guard.lock();
-    to.impl->previous_fiber = weak_from.lock();
+    // "from" stays locked until "to" has saved its context, so it can't be destroyed before then
+    // and a plain pointer avoids two reference count updates on every switch.
+    to.impl->previous_fiber = weak_from.lock().get();
 
     auto transfer = boost::context::detail::jump_fcontext(to.impl->context, &to);
 
@@ -127,7 +129,7 @@ void Fiber::YieldTo(std::weak_ptr<Fiber> weak_from, Fiber& to) {
         ASSERT(from->impl->previous_fiber != nullptr);
         from->impl->previous_fiber->impl->context = transfer.fctx;
         from->impl->previous_fiber->impl->guard.unlock();
-        from->impl->previous_fiber.reset();
+        from->impl->previous_fiber = nullptr;
     }
 }
 
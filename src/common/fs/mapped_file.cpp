@@ -0,0 +1,105 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "common/fs/mapped_file.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+
+namespace Common::FS {
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::filesystem::path& path, MappedFileAccess access) {
+    DWORD flags = FILE_ATTRIBUTE_NORMAL;
+    if (access == MappedFileAccess::Sequential) {
+        flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+    } else if (access == MappedFileAccess::Random) {
+        flags |= FILE_FLAG_RANDOM_ACCESS;
+    }
+    const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                    OPEN_EXISTING, flags, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOG_ERROR(Common_Filesystem, "Failed to open the file at path={} for mapping",
+                  PathToUTF8String(path));
+        return;
+    }
+    file_handle = file;
+
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        return;
+    }
+    mapping_handle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_handle == nullptr) {
+        LOG_ERROR(Common_Filesystem, "Failed to create a mapping of path={}",
+                  PathToUTF8String(path));
+        return;
+    }
+    base = static_cast<const u8*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+    if (base != nullptr) {
+        size = static_cast<std::size_t>(file_size.QuadPart);
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (base != nullptr) {
+        UnmapViewOfFile(base);
+    }
+    if (mapping_handle != nullptr) {
+        CloseHandle(mapping_handle);
+    }
+    if (file_handle != nullptr) {
+        CloseHandle(file_handle);
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& path, MappedFileAccess access) {
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        LOG_ERROR(Common_Filesystem, "Failed to open the file at path={} for mapping",
+                  PathToUTF8String(path));
+        return;
+    }
+    struct stat file_stat {};
+    if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+        const auto file_size = static_cast<std::size_t>(file_stat.st_size);
+        void* const pointer = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (pointer != MAP_FAILED) {
+            base = static_cast<const u8*>(pointer);
+            size = file_size;
+
+            if (access == MappedFileAccess::Sequential) {
+                madvise(pointer, size, MADV_SEQUENTIAL);
+            } else if (access == MappedFileAccess::Random) {
+                madvise(pointer, size, MADV_RANDOM);
+            }
+        } else {
+            LOG_ERROR(Common_Filesystem, "Failed to map the file at path={}",
+                      PathToUTF8String(path));
+        }
+    }
+    // The mapping keeps its own reference to the file
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (base != nullptr) {
+        munmap(const_cast<u8*>(base), size);
+    }
+}
+
+#endif
+
+} // namespace Common::FS
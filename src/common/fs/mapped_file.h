@@ -0,0 +1,63 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+#include "common/common_types.h"
+
+namespace Common::FS {
+
+/// Expected access pattern of a mapped file, forwarded to the OS as a paging hint.
+enum class MappedFileAccess {
+    Normal,     // Default OS readahead.
+    Sequential, // Aggressive readahead, pages may be dropped early once read.
+    Random,     // No readahead around faulting pages.
+};
+
+/**
+ * Read-only memory mapping of a whole file. Reads are served by the OS page cache without going
+ * through a file stream, so they are safe to perform concurrently.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path& path,
+                        MappedFileAccess access = MappedFileAccess::Normal);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    /// Returns true when the file was mapped successfully.
+    [[nodiscard]] bool IsOpen() const {
+        return base != nullptr;
+    }
+
+    /// Returns the mapped contents of the file.
+    [[nodiscard]] std::span<const u8> Data() const {
+        return {base, size};
+    }
+
+    /// Returns the size of the mapped file in bytes.
+    [[nodiscard]] std::size_t GetSize() const {
+        return size;
+    }
+
+private:
+    const u8* base{};
+    std::size_t size{};
+
+#ifdef _WIN32
+    void* file_handle{};
+    void* mapping_handle{};
+#endif
+};
+
+} // namespace Common::FS
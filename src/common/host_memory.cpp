@@ -17,6 +17,7 @@
 
 #endif // ^^^ Linux ^^^
 
+#include <cstring>
 #include <mutex>
 
 #include "common/alignment.h"
@@ -152,6 +153,16 @@ public:
         }
     }
 
+    void EnableHugePages() {
+        // Large page sections need SeLockMemoryPrivilege and can't be mapped into placeholders
+        // at page granularity
+    }
+
+    void ClearBackingRegion(size_t host_offset, size_t length) {
+        // Pagefile backed sections can't release pages while they are mapped
+        std::memset(backing_base + host_offset, 0, length);
+    }
+
     void Protect(size_t virtual_offset, size_t length, bool read, bool write) {
         DWORD new_flags{};
         if (read && write) {
@@ -398,6 +409,11 @@ public:
         void* ret = mmap(virtual_base + virtual_offset, length, PROT_READ | PROT_WRITE,
                          MAP_SHARED | MAP_FIXED, fd, host_offset);
         ASSERT_MSG(ret != MAP_FAILED, "mmap failed: {}", strerror(errno));
+
+        if (huge_pages) {
+            // Every new mapping is a new VMA, so the advice has to be given again
+            AdviseHugePages(virtual_base + virtual_offset, length);
+        }
     }
 
     void Unmap(size_t virtual_offset, size_t length) {
@@ -409,6 +425,23 @@ public:
         ASSERT_MSG(ret != MAP_FAILED, "mmap failed: {}", strerror(errno));
     }
 
+    void EnableHugePages() {
+        huge_pages = true;
+        if (!AdviseHugePages(backing_base, backing_size)) {
+            LOG_WARNING(HW_Memory, "Transparent huge pages are not available: {}",
+                        strerror(errno));
+        }
+    }
+
+    void ClearBackingRegion(size_t host_offset, size_t length) {
+        // Punching a hole releases the host pages, they read back as zeros until touched again
+        const int ret = fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                                  static_cast<off_t>(host_offset), static_cast<off_t>(length));
+        if (ret != 0) {
+            std::memset(backing_base + host_offset, 0, length);
+        }
+    }
+
     void Protect(size_t virtual_offset, size_t length, bool read, bool write) {
         int flags = 0;
         if (read) {
@@ -428,6 +461,16 @@ public:
     u8* virtual_base{reinterpret_cast<u8*>(MAP_FAILED)};
 
 private:
+    /// Asks the kernel to back a range with transparent huge pages. Shared memory only gets them
+    /// when /sys/kernel/mm/transparent_hugepage/shmem_enabled is "advise" or "always", and only
+    /// for 2MiB blocks where the virtual address and the backing offset are equally aligned.
+    static bool AdviseHugePages(u8* pointer, size_t length) {
+        if (length < HugePageSize) {
+            return true;
+        }
+        return madvise(pointer, length, MADV_HUGEPAGE) == 0;
+    }
+
     /// Release all resources in the object
     void Release() {
         if (virtual_base != MAP_FAILED) {
@@ -447,6 +490,7 @@ private:
     }
 
     int fd{-1}; // memfd file descriptor, -1 is the error value of memfd_create
+    bool huge_pages{};
 };
 
 #else // ^^^ Linux ^^^ vvv Generic vvv
@@ -465,13 +509,17 @@ public:
 
     void Protect(size_t virtual_offset, size_t length, bool read, bool write) {}
 
+    void EnableHugePages() {}
+
+    void ClearBackingRegion(size_t host_offset, size_t length) {}
+
     u8* backing_base{nullptr};
     u8* virtual_base{nullptr};
 };
 
 #endif // ^^^ Generic ^^^
 
-HostMemory::HostMemory(size_t backing_size_, size_t virtual_size_)
+HostMemory::HostMemory(size_t backing_size_, size_t virtual_size_, bool huge_pages_)
     : backing_size(backing_size_), virtual_size(virtual_size_) {
     try {
         // Try to allocate a fastmem arena.
@@ -481,6 +529,9 @@ HostMemory::HostMemory(size_t backing_size_, size_t virtual_size_)
                                                       3 * HugePageSize);
         backing_base = impl->backing_base;
         virtual_base = impl->virtual_base;
+        if (huge_pages_) {
+            impl->EnableHugePages();
+        }
 
         if (virtual_base) {
             virtual_base += 2 * HugePageSize - 1;
@@ -535,4 +586,16 @@ void HostMemory::Protect(size_t virtual_offset, size_t length, bool read, bool w
     impl->Protect(virtual_offset + virtual_base_offset, length, read, write);
 }
 
+void HostMemory::ClearBackingRegion(size_t host_offset, size_t length) {
+    ASSERT(host_offset + length <= backing_size);
+    if (length == 0) {
+        return;
+    }
+    if (!impl) {
+        std::memset(backing_base + host_offset, 0, length);
+        return;
+    }
+    impl->ClearBackingRegion(host_offset, length);
+}
+
 } // namespace Common
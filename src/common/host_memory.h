@@ -16,7 +16,12 @@ namespace Common {
  */
 class HostMemory {
 public:
-    explicit HostMemory(size_t backing_size_, size_t virtual_size_);
+    /**
+     * @param backing_size_ Size of the backing memory
+     * @param virtual_size_ Size of the virtual address space the backing memory is mapped into
+     * @param huge_pages_ Whether to ask the host to back the memory with huge pages
+     */
+    explicit HostMemory(size_t backing_size_, size_t virtual_size_, bool huge_pages_ = false);
     ~HostMemory();
 
     /**
@@ -38,6 +43,12 @@ public:
 
     void Protect(size_t virtual_offset, size_t length, bool read, bool write);
 
+    /**
+     * Zeroes a region of the backing memory. When the platform supports it, the host pages are
+     * released and only committed again once they are touched.
+     */
+    void ClearBackingRegion(size_t host_offset, size_t length);
+
     [[nodiscard]] u8* BackingBasePointer() noexcept {
         return backing_base;
     }
@@ -3,13 +3,15 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
-#include <climits>
 #include <condition_variable>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #ifdef _WIN32
@@ -17,6 +19,7 @@
 #endif
 
 #include "common/assert.h"
+#include "common/bounded_threadsafe_queue.h"
 #include "common/fs/file.h"
 #include "common/fs/fs.h"
 #include "common/literals.h"
@@ -26,10 +29,23 @@
 #include "common/logging/text_formatter.h"
 #include "common/settings.h"
 #include "common/string_util.h"
-#include "common/threadsafe_queue.h"
 
 namespace Common::Log {
 
+namespace Detail {
+namespace {
+template <std::size_t... indices>
+std::array<std::atomic<Level>, sizeof...(indices)> MakeClassLevels(
+    std::index_sequence<indices...>) {
+    // Matches the default constructed filter of the logging backend
+    return {(static_cast<void>(indices), Level::Info)...};
+}
+} // Anonymous namespace
+
+std::array<std::atomic<Level>, static_cast<std::size_t>(Class::Count)> class_levels =
+    MakeClassLevels(std::make_index_sequence<static_cast<std::size_t>(Class::Count)>{});
+} // namespace Detail
+
 /**
  * Static state as a singleton.
  */
@@ -48,8 +64,16 @@ public:
 
     void PushEntry(Class log_class, Level log_level, const char* filename, unsigned int line_num,
                    const char* function, std::string message) {
-        message_queue.Push(
-            CreateEntry(log_class, log_level, filename, line_num, function, std::move(message)));
+        Entry entry =
+            CreateEntry(log_class, log_level, filename, line_num, function, std::move(message));
+        if (!GetThreadBuffer().TryPush(std::move(entry))) {
+            dropped_entries.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        // Only the first entry after the backend thread drained the buffers wakes it up
+        if (!entries_pending.exchange(true)) {
+            backend_cv.notify_one();
+        }
     }
 
     void AddBackend(std::unique_ptr<Backend> backend) {
@@ -71,6 +95,10 @@ public:
 
     void SetGlobalFilter(const Filter& f) {
         filter = f;
+        for (std::size_t i = 0; i < Detail::class_levels.size(); ++i) {
+            Detail::class_levels[i].store(filter.GetClassLevel(static_cast<Class>(i)),
+                                          std::memory_order_relaxed);
+        }
     }
 
     Backend* GetBackend(std::string_view backend_name) {
@@ -83,40 +111,97 @@ public:
     }
 
 private:
+    /// Entries each thread can have in flight before new ones are dropped
+    static constexpr std::size_t THREAD_BUFFER_SIZE = 1024;
+    /// Upper bound on the time a pushed entry waits when its wake up was missed
+    static constexpr std::chrono::milliseconds FLUSH_INTERVAL{10};
+
+    using ThreadBuffer = BoundedSPSCQueue<Entry, THREAD_BUFFER_SIZE>;
+
     Impl() {
         backend_thread = std::thread([&] {
-            Entry entry;
-            auto write_logs = [&](Entry& e) {
+            std::vector<Entry> entries;
+            auto write_logs = [&] {
                 std::lock_guard lock{writing_mutex};
-                for (const auto& backend : backends) {
-                    backend->Write(e);
+                for (const auto& entry : entries) {
+                    for (const auto& backend : backends) {
+                        backend->Write(entry);
+                    }
                 }
+                entries.clear();
             };
-            while (true) {
-                entry = message_queue.PopWait();
-                if (entry.final_entry) {
-                    break;
+            while (!stop_requested) {
+                {
+                    std::unique_lock lock{backend_mutex};
+                    backend_cv.wait_for(lock, FLUSH_INTERVAL, [this] {
+                        return entries_pending.load() || stop_requested.load();
+                    });
                 }
-                write_logs(entry);
+                entries_pending = false;
+                CollectEntries(entries, std::numeric_limits<std::size_t>::max());
+                write_logs();
             }
 
             // Drain the logging queue. Only writes out up to MAX_LOGS_TO_WRITE to prevent a
             // case where a system is repeatedly spamming logs even on close.
-            const int MAX_LOGS_TO_WRITE = filter.IsDebug() ? INT_MAX : 100;
-            int logs_written = 0;
-            while (logs_written++ < MAX_LOGS_TO_WRITE && message_queue.Pop(entry)) {
-                write_logs(entry);
-            }
+            const std::size_t MAX_LOGS_TO_WRITE =
+                filter.IsDebug() ? std::numeric_limits<std::size_t>::max() : 100;
+            CollectEntries(entries, MAX_LOGS_TO_WRITE);
+            write_logs();
         });
     }
 
     ~Impl() {
-        Entry entry;
-        entry.final_entry = true;
-        message_queue.Push(entry);
+        {
+            std::lock_guard lock{backend_mutex};
+            stop_requested = true;
+        }
+        backend_cv.notify_one();
         backend_thread.join();
     }
 
+    /// Returns the calling thread's buffer, registering it on first use
+    ThreadBuffer& GetThreadBuffer() {
+        thread_local const std::shared_ptr<ThreadBuffer> buffer = [this] {
+            auto new_buffer = std::make_shared<ThreadBuffer>();
+            std::lock_guard lock{thread_buffers_mutex};
+            thread_buffers.push_back(new_buffer);
+            return new_buffer;
+        }();
+        return *buffer;
+    }
+
+    /// Moves up to max_entries entries out of the thread buffers, in timestamp order
+    void CollectEntries(std::vector<Entry>& entries, std::size_t max_entries) {
+        {
+            std::lock_guard lock{thread_buffers_mutex};
+            for (const auto& buffer : thread_buffers) {
+                Entry entry;
+                while (buffer->Pop(entry)) {
+                    entries.push_back(std::move(entry));
+                }
+            }
+            // Only the registry holds buffers of threads that have exited
+            std::erase_if(thread_buffers, [](const std::shared_ptr<ThreadBuffer>& buffer) {
+                return buffer.use_count() == 1 && buffer->Empty();
+            });
+        }
+        // Each buffer is already ordered, this interleaves the threads
+        std::stable_sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) {
+            return lhs.timestamp < rhs.timestamp;
+        });
+        if (entries.size() > max_entries) {
+            entries.resize(max_entries);
+        }
+
+        const std::size_t dropped = dropped_entries.exchange(0, std::memory_order_relaxed);
+        if (dropped != 0) {
+            entries.push_back(CreateEntry(Class::Log, Level::Warning, "common/logging/backend.cpp",
+                                          __LINE__, __func__,
+                                          fmt::format("{} log entries were dropped", dropped)));
+        }
+    }
+
     Entry CreateEntry(Class log_class, Level log_level, const char* filename, unsigned int line_nr,
                       const char* function, std::string message) const {
         using std::chrono::duration_cast;
@@ -131,14 +216,22 @@ private:
             .line_num = line_nr,
             .function = function,
             .message = std::move(message),
-            .final_entry = false,
         };
     }
 
     std::mutex writing_mutex;
     std::thread backend_thread;
     std::vector<std::unique_ptr<Backend>> backends;
-    MPSCQueue<Entry> message_queue;
+
+    std::mutex thread_buffers_mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> thread_buffers;
+
+    std::mutex backend_mutex;
+    std::condition_variable backend_cv;
+    std::atomic_bool entries_pending{false};
+    std::atomic_bool stop_requested{false};
+    std::atomic_size_t dropped_entries{0};
+
     Filter filter;
     std::chrono::steady_clock::time_point time_origin{std::chrono::steady_clock::now()};
 };
@@ -220,6 +220,10 @@ void Filter::ParseFilterString(std::string_view filter_view) {
     }
 }
 
+Level Filter::GetClassLevel(Class log_class) const {
+    return class_levels[static_cast<std::size_t>(log_class)];
+}
+
 bool Filter::CheckMessage(Class log_class, Level level) const {
     return static_cast<u8>(level) >=
            static_cast<u8>(class_levels[static_cast<std::size_t>(log_class)]);
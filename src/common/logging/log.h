@@ -4,11 +4,41 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <fmt/format.h>
 #include "common/logging/types.h"
 
+// Lowest log level compiled in, as its index in Common::Log::Level. Messages below it are removed
+// at compile time, trace messages are not even compiled in that case.
+#ifndef YUZU_LOG_MIN_LEVEL
+#ifdef _DEBUG
+#define YUZU_LOG_MIN_LEVEL 0
+#else
+#define YUZU_LOG_MIN_LEVEL 1
+#endif
+#endif
+
 namespace Common::Log {
 
+constexpr Level MIN_COMPILED_LEVEL = static_cast<Level>(YUZU_LOG_MIN_LEVEL);
+
+namespace Detail {
+/// Minimum level of each class in the global filter, read before a message's arguments are
+/// evaluated
+extern std::array<std::atomic<Level>, static_cast<std::size_t>(Class::Count)> class_levels;
+} // namespace Detail
+
+/// Returns true if a message of the class and level would pass the global filter
+[[nodiscard]] inline bool IsLevelEnabled(Class log_class, Level log_level) {
+    if (log_level < MIN_COMPILED_LEVEL) {
+        return false;
+    }
+    const auto& class_level = Detail::class_levels[static_cast<std::size_t>(log_class)];
+    return log_level >= class_level.load(std::memory_order_relaxed);
+}
+
 // trims up to and including the last of ../, ..\, src/, src\ in a string
 constexpr const char* TrimSourcePath(std::string_view source) {
     const auto rfind = [source](const std::string_view match) {
@@ -32,32 +62,26 @@ void FmtLogMessage(Class log_class, Level log_level, const char* filename, unsig
 
 } // namespace Common::Log
 
-#ifdef _DEBUG
+#define LOG_GENERIC(log_class, log_level, ...)                                                     \
+    (Common::Log::IsLevelEnabled(log_class, log_level)                                             \
+         ? Common::Log::FmtLogMessage(log_class, log_level, Common::Log::TrimSourcePath(__FILE__), \
+                                      __LINE__, __func__, __VA_ARGS__)                             \
+         : void())
+
+#if YUZU_LOG_MIN_LEVEL == 0
 #define LOG_TRACE(log_class, ...)                                                                  \
-    Common::Log::FmtLogMessage(Common::Log::Class::log_class, Common::Log::Level::Trace,           \
-                               Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__,          \
-                               __VA_ARGS__)
+    LOG_GENERIC(Common::Log::Class::log_class, Common::Log::Level::Trace, __VA_ARGS__)
 #else
 #define LOG_TRACE(log_class, fmt, ...) (void(0))
 #endif
 
 #define LOG_DEBUG(log_class, ...)                                                                  \
-    Common::Log::FmtLogMessage(Common::Log::Class::log_class, Common::Log::Level::Debug,           \
-                               Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__,          \
-                               __VA_ARGS__)
+    LOG_GENERIC(Common::Log::Class::log_class, Common::Log::Level::Debug, __VA_ARGS__)
 #define LOG_INFO(log_class, ...)                                                                   \
-    Common::Log::FmtLogMessage(Common::Log::Class::log_class, Common::Log::Level::Info,            \
-                               Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__,          \
-                               __VA_ARGS__)
+    LOG_GENERIC(Common::Log::Class::log_class, Common::Log::Level::Info, __VA_ARGS__)
 #define LOG_WARNING(log_class, ...)                                                                \
-    Common::Log::FmtLogMessage(Common::Log::Class::log_class, Common::Log::Level::Warning,         \
-                               Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__,          \
-                               __VA_ARGS__)
+    LOG_GENERIC(Common::Log::Class::log_class, Common::Log::Level::Warning, __VA_ARGS__)
 #define LOG_ERROR(log_class, ...)                                                                  \
-    Common::Log::FmtLogMessage(Common::Log::Class::log_class, Common::Log::Level::Error,           \
-                               Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__,          \
-                               __VA_ARGS__)
+    LOG_GENERIC(Common::Log::Class::log_class, Common::Log::Level::Error, __VA_ARGS__)
 #define LOG_CRITICAL(log_class, ...)                                                               \
-    Common::Log::FmtLogMessage(Common::Log::Class::log_class, Common::Log::Level::Critical,        \
-                               Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__,          \
-                               __VA_ARGS__)
+    LOG_GENERIC(Common::Log::Class::log_class, Common::Log::Level::Critical, __VA_ARGS__)
@@ -61,10 +61,7 @@ std::vector<u8> CompressDataLZ4HCMax(const u8* source, std::size_t source_size)
 
 std::vector<u8> DecompressDataLZ4(std::span<const u8> compressed, std::size_t uncompressed_size) {
     std::vector<u8> uncompressed(uncompressed_size);
-    const int size_check = LZ4_decompress_safe(reinterpret_cast<const char*>(compressed.data()),
-                                               reinterpret_cast<char*>(uncompressed.data()),
-                                               static_cast<int>(compressed.size()),
-                                               static_cast<int>(uncompressed.size()));
+    const int size_check = DecompressDataLZ4(compressed, std::span<u8>{uncompressed});
     if (static_cast<int>(uncompressed_size) != size_check) {
         // Decompression failed
         return {};
@@ -72,4 +69,11 @@ std::vector<u8> DecompressDataLZ4(std::span<const u8> compressed, std::size_t un
     return uncompressed;
 }
 
+int DecompressDataLZ4(std::span<const u8> compressed, std::span<u8> uncompressed) {
+    return LZ4_decompress_safe(reinterpret_cast<const char*>(compressed.data()),
+                               reinterpret_cast<char*>(uncompressed.data()),
+                               static_cast<int>(compressed.size()),
+                               static_cast<int>(uncompressed.size()));
+}
+
 } // namespace Common::Compression
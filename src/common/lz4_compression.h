@@ -57,4 +57,14 @@ namespace Common::Compression {
 [[nodiscard]] std::vector<u8> DecompressDataLZ4(std::span<const u8> compressed,
                                                 std::size_t uncompressed_size);
 
+/**
+ * Decompresses a source memory region with LZ4 into a caller provided buffer.
+ *
+ * @param compressed the compressed source memory region.
+ * @param uncompressed the destination buffer, its size is the maximum uncompressed size.
+ *
+ * @return the number of bytes written to uncompressed, or a negative value on failure.
+ */
+[[nodiscard]] int DecompressDataLZ4(std::span<const u8> compressed, std::span<u8> uncompressed);
+
 } // namespace Common::Compression
@@ -5,3 +5,35 @@
 // Includes the MicroProfile implementation in this file for compilation
 #define MICROPROFILE_IMPL 1
 #include "common/microprofile.h"
+
+namespace Common::TraceRecorder::Detail {
+
+#if MICROPROFILE_ENABLED
+const char* GetScopeName(u64 token) {
+    return MicroProfileGet()->TimerInfo[MicroProfileGetTimerIndex(token)].pName;
+}
+
+const char* GetScopeGroupName(u64 token) {
+    const MicroProfile* const state = MicroProfileGet();
+    return state->GroupInfo[state->TimerToGroup[MicroProfileGetTimerIndex(token)]].pName;
+}
+
+const char* GetThreadName() {
+    const MicroProfileThreadLog* const log = MicroProfileGetThreadLog();
+    return log ? log->ThreadName : "";
+}
+#else
+const char* GetScopeName(u64) {
+    return "";
+}
+
+const char* GetScopeGroupName(u64) {
+    return "";
+}
+
+const char* GetThreadName() {
+    return "";
+}
+#endif
+
+} // namespace Common::TraceRecorder::Detail
@@ -22,6 +22,16 @@ typedef void* HANDLE;
 
 #include <microprofile.h>
 
+#include "common/trace_recorder.h"
+
+// Scopes are also stored by the trace recorder while it is recording
+#if MICROPROFILE_ENABLED
+#undef MICROPROFILE_SCOPE
+#define MICROPROFILE_SCOPE(var)                                                                    \
+    MicroProfileScopeHandler MICROPROFILE_TOKEN_PASTE(foo, __LINE__)(g_mp_##var);                  \
+    Common::TraceRecorder::ScopeRecorder MICROPROFILE_TOKEN_PASTE(trace, __LINE__)(g_mp_##var)
+#endif
+
 #define MP_RGB(r, g, b) ((r) << 16 | (g) << 8 | (b) << 0)
 
 // On OS X, some Mach header included by MicroProfile defines these as macros, conflicting with
@@ -46,24 +46,50 @@ void LogSettings() {
     log_setting("System_RegionIndex", values.region_index.GetValue());
     log_setting("System_TimeZoneIndex", values.time_zone_index.GetValue());
     log_setting("Core_UseMultiCore", values.use_multi_core.GetValue());
+    log_setting("Core_ServiceThreadAffinity", values.service_thread_affinity.GetValue());
+    log_setting("Core_ServiceThreadPriority", values.service_thread_priority.GetValue());
+    log_setting("Core_PreciseCoreTiming", values.precise_core_timing.GetValue());
+    log_setting("Core_UseHugePages", values.use_huge_pages.GetValue());
+    log_setting("Core_UseThreadPlacement", values.use_thread_placement.GetValue());
+    log_setting("Core_PerfTuning", values.perf_tuning.GetValue());
     log_setting("CPU_Accuracy", values.cpu_accuracy.GetValue());
+    log_setting("CPU_CodeCacheSize", values.cpu_code_cache_size.GetValue());
     log_setting("Renderer_UseResolutionFactor", values.resolution_factor.GetValue());
+    log_setting("Renderer_RenderScale", values.render_scale.GetValue());
     log_setting("Renderer_UseFrameLimit", values.use_frame_limit.GetValue());
     log_setting("Renderer_FrameLimit", values.frame_limit.GetValue());
     log_setting("Renderer_UseDiskShaderCache", values.use_disk_shader_cache.GetValue());
+    log_setting("Renderer_UseAstcDiskCache", values.use_astc_disk_cache.GetValue());
+    log_setting("Renderer_UseTextureDeduplication", values.use_texture_deduplication.GetValue());
+    log_setting("Renderer_UseTextureStreaming", values.use_texture_streaming.GetValue());
     log_setting("Renderer_GPUAccuracyLevel", values.gpu_accuracy.GetValue());
     log_setting("Renderer_UseAsynchronousGpuEmulation",
                 values.use_asynchronous_gpu_emulation.GetValue());
     log_setting("Renderer_UseNvdecEmulation", values.use_nvdec_emulation.GetValue());
+    log_setting("Renderer_UseNvdecHwaccel", values.use_nvdec_hwaccel.GetValue());
     log_setting("Renderer_AccelerateASTC", values.accelerate_astc.GetValue());
+    log_setting("Renderer_TranscodeASTC", values.transcode_astc.GetValue());
+    log_setting("Renderer_VramBudget", values.vram_budget.GetValue());
+    log_setting("Renderer_UseAsynchronousDownloads",
+                values.use_asynchronous_downloads.GetValue());
     log_setting("Renderer_UseVsync", values.use_vsync.GetValue());
+    log_setting("Renderer_PresentMode", values.present_mode.GetValue());
     log_setting("Renderer_UseAssemblyShaders", values.use_assembly_shaders.GetValue());
     log_setting("Renderer_UseAsynchronousShaders", values.use_asynchronous_shaders.GetValue());
+    log_setting("Renderer_AsyncShaderWaitTime", values.async_shader_wait_time.GetValue());
+    log_setting("Renderer_UseSpirvOptimizer", values.use_spirv_optimizer.GetValue());
+    log_setting("Renderer_UseShaderSpecialization", values.use_shader_specialization.GetValue());
+    log_setting("Renderer_UseBindlessTextures", values.use_bindless_textures.GetValue());
+    log_setting("Renderer_UseDrawBatching", values.use_draw_batching.GetValue());
+    log_setting("Renderer_UseTransferQueue", values.use_transfer_queue.GetValue());
+    log_setting("Renderer_UseAsyncCompute", values.use_async_compute.GetValue());
+    log_setting("Renderer_UseMemoryDefragmentation", values.use_memory_defragmentation.GetValue());
     log_setting("Renderer_UseGarbageCollection", values.use_caches_gc.GetValue());
     log_setting("Renderer_AnisotropicFilteringLevel", values.max_anisotropy.GetValue());
     log_setting("Audio_OutputEngine", values.sink_id.GetValue());
     log_setting("Audio_EnableAudioStretching", values.enable_audio_stretching.GetValue());
     log_setting("Audio_OutputDevice", values.audio_device_id.GetValue());
+    log_setting("Audio_LowLatency", values.audio_low_latency.GetValue());
     log_setting("DataStorage_UseVirtualSd", values.use_virtual_sd.GetValue());
     log_path("DataStorage_CacheDir", Common::FS::GetYuzuPath(Common::FS::YuzuPath::CacheDir));
     log_path("DataStorage_ConfigDir", Common::FS::GetYuzuPath(Common::FS::YuzuPath::ConfigDir));
@@ -99,6 +125,13 @@ bool IsFastmemEnabled() {
     return true;
 }
 
+bool IsHleMemoryFunctionsEnabled() {
+    if (values.cpu_debug_mode) {
+        return static_cast<bool>(values.cpuopt_hle_memory_functions);
+    }
+    return true;
+}
+
 float Volume() {
     if (values.audio_muted) {
         return 0.0f;
@@ -121,6 +154,7 @@ void RestoreGlobalState(bool is_powered_on) {
 
     // CPU
     values.cpu_accuracy.SetGlobal(true);
+    values.cpu_code_cache_size.SetGlobal(true);
     values.cpuopt_unsafe_unfuse_fma.SetGlobal(true);
     values.cpuopt_unsafe_reduce_fp_error.SetGlobal(true);
     values.cpuopt_unsafe_ignore_standard_fpcr.SetGlobal(true);
@@ -130,6 +164,7 @@ void RestoreGlobalState(bool is_powered_on) {
     // Renderer
     values.renderer_backend.SetGlobal(true);
     values.vulkan_device.SetGlobal(true);
+    values.render_scale.SetGlobal(true);
     values.aspect_ratio.SetGlobal(true);
     values.max_anisotropy.SetGlobal(true);
     values.use_frame_limit.SetGlobal(true);
@@ -140,8 +175,16 @@ void RestoreGlobalState(bool is_powered_on) {
     values.use_nvdec_emulation.SetGlobal(true);
     values.accelerate_astc.SetGlobal(true);
     values.use_vsync.SetGlobal(true);
+    values.present_mode.SetGlobal(true);
     values.use_assembly_shaders.SetGlobal(true);
     values.use_asynchronous_shaders.SetGlobal(true);
+    values.async_shader_wait_time.SetGlobal(true);
+    values.use_shader_specialization.SetGlobal(true);
+    values.use_bindless_textures.SetGlobal(true);
+    values.use_draw_batching.SetGlobal(true);
+    values.use_transfer_queue.SetGlobal(true);
+    values.use_async_compute.SetGlobal(true);
+    values.use_memory_defragmentation.SetGlobal(true);
     values.use_fast_gpu_time.SetGlobal(true);
     values.use_caches_gc.SetGlobal(true);
     values.bg_red.SetGlobal(true);
@@ -22,6 +22,7 @@ namespace Settings {
 enum class RendererBackend : u32 {
     OpenGL = 0,
     Vulkan = 1,
+    Null = 2,
 };
 
 enum class GPUAccuracy : u32 {
@@ -30,12 +31,32 @@ enum class GPUAccuracy : u32 {
     Extreme = 2,
 };
 
+enum class PresentMode : u32 {
+    Automatic = 0,
+    Fifo = 1,
+    FifoRelaxed = 2,
+    Mailbox = 3,
+    Immediate = 4,
+};
+
+enum class RenderScale : u32 {
+    Native = 0,
+    ThreeQuarters = 1,
+    Half = 2,
+};
+
 enum class CPUAccuracy : u32 {
     Auto = 0,
     Accurate = 1,
     Unsafe = 2,
 };
 
+enum class PerfTuning : u32 {
+    Disabled = 0,
+    Record = 1,
+    AutoTune = 2,
+};
+
 /** The BasicSetting class is a simple resource manager. It defines a label and default value
  * alongside the actual value of the setting for simpler and less-error prone use with frontend
  * configurations. Setting a default value and label is required, though subclasses may deviate from
@@ -277,17 +298,34 @@ struct Values {
     BasicSetting<std::string> audio_device_id{"auto", "output_device"};
     BasicSetting<std::string> sink_id{"auto", "output_engine"};
     BasicSetting<bool> audio_muted{false, "audio_muted"};
+    BasicSetting<bool> audio_low_latency{false, "audio_low_latency"};
     Setting<bool> enable_audio_stretching{true, "enable_audio_stretching"};
     Setting<u8> volume{100, "volume"};
 
     // Core
     Setting<bool> use_multi_core{true, "use_multi_core"};
 
+    // HLE service threads. Affinities are host core masks where 0 leaves the host scheduler free,
+    // priorities follow Common::ThreadPriority.
+    BasicSetting<u32> service_thread_affinity{0, "service_thread_affinity"};
+    BasicSetting<u8> service_thread_priority{1, "service_thread_priority"};
+    BasicSetting<u32> fs_service_thread_affinity{0, "fs_service_thread_affinity"};
+    BasicSetting<u8> fs_service_thread_priority{1, "fs_service_thread_priority"};
+    BasicSetting<u32> nvdrv_service_thread_affinity{0, "nvdrv_service_thread_affinity"};
+    BasicSetting<u8> nvdrv_service_thread_priority{1, "nvdrv_service_thread_priority"};
+    BasicSetting<u32> audio_service_thread_affinity{0, "audio_service_thread_affinity"};
+    BasicSetting<u8> audio_service_thread_priority{1, "audio_service_thread_priority"};
+    BasicSetting<bool> precise_core_timing{false, "precise_core_timing"};
+    BasicSetting<bool> use_huge_pages{false, "use_huge_pages"};
+    BasicSetting<bool> use_thread_placement{false, "use_thread_placement"};
+    BasicSetting<PerfTuning> perf_tuning{PerfTuning::Disabled, "perf_tuning"};
+
     // Cpu
     Setting<CPUAccuracy> cpu_accuracy{CPUAccuracy::Auto, "cpu_accuracy"};
     // TODO: remove cpu_accuracy_first_time, migration setting added 8 July 2021
     BasicSetting<bool> cpu_accuracy_first_time{true, "cpu_accuracy_first_time"};
     BasicSetting<bool> cpu_debug_mode{false, "cpu_debug_mode"};
+    Setting<u32> cpu_code_cache_size{512, "cpu_code_cache_size"};
 
     BasicSetting<bool> cpuopt_page_tables{true, "cpuopt_page_tables"};
     BasicSetting<bool> cpuopt_block_linking{true, "cpuopt_block_linking"};
@@ -298,6 +336,7 @@ struct Values {
     BasicSetting<bool> cpuopt_misc_ir{true, "cpuopt_misc_ir"};
     BasicSetting<bool> cpuopt_reduce_misalign_checks{true, "cpuopt_reduce_misalign_checks"};
     BasicSetting<bool> cpuopt_fastmem{true, "cpuopt_fastmem"};
+    BasicSetting<bool> cpuopt_hle_memory_functions{true, "cpuopt_hle_memory_functions"};
 
     Setting<bool> cpuopt_unsafe_unfuse_fma{true, "cpuopt_unsafe_unfuse_fma"};
     Setting<bool> cpuopt_unsafe_reduce_fp_error{true, "cpuopt_unsafe_reduce_fp_error"};
@@ -311,6 +350,7 @@ struct Values {
     Setting<int> vulkan_device{0, "vulkan_device"};
 
     Setting<u16> resolution_factor{1, "resolution_factor"};
+    Setting<RenderScale> render_scale{RenderScale::Native, "render_scale"};
     // *nix platforms may have issues with the borderless windowed fullscreen mode.
     // Default to exclusive fullscreen on these platforms for now.
     Setting<int> fullscreen_mode{
@@ -325,14 +365,31 @@ struct Values {
     Setting<bool> use_frame_limit{true, "use_frame_limit"};
     Setting<u16> frame_limit{100, "frame_limit"};
     Setting<bool> use_disk_shader_cache{true, "use_disk_shader_cache"};
+    BasicSetting<bool> use_astc_disk_cache{false, "use_astc_disk_cache"};
+    BasicSetting<bool> use_texture_deduplication{false, "use_texture_deduplication"};
+    BasicSetting<bool> use_texture_streaming{false, "use_texture_streaming"};
     Setting<GPUAccuracy> gpu_accuracy{GPUAccuracy::High, "gpu_accuracy"};
     Setting<bool> use_asynchronous_gpu_emulation{true, "use_asynchronous_gpu_emulation"};
     Setting<bool> use_nvdec_emulation{true, "use_nvdec_emulation"};
+    BasicSetting<bool> use_nvdec_hwaccel{true, "use_nvdec_hwaccel"};
     Setting<bool> accelerate_astc{true, "accelerate_astc"};
+    BasicSetting<bool> transcode_astc{false, "transcode_astc"};
+    BasicSetting<u32> vram_budget{0, "vram_budget"};
+    BasicSetting<bool> use_asynchronous_downloads{false, "use_asynchronous_downloads"};
     Setting<bool> use_vsync{true, "use_vsync"};
+    Setting<PresentMode> present_mode{PresentMode::Automatic, "present_mode"};
     BasicSetting<bool> disable_fps_limit{false, "disable_fps_limit"};
     Setting<bool> use_assembly_shaders{false, "use_assembly_shaders"};
     Setting<bool> use_asynchronous_shaders{false, "use_asynchronous_shaders"};
+    // Milliseconds a draw waits for an asynchronous pipeline before it's skipped
+    Setting<u16> async_shader_wait_time{0, "async_shader_wait_time"};
+    BasicSetting<bool> use_spirv_optimizer{false, "use_spirv_optimizer"};
+    Setting<bool> use_shader_specialization{false, "use_shader_specialization"};
+    Setting<bool> use_bindless_textures{false, "use_bindless_textures"};
+    Setting<bool> use_draw_batching{false, "use_draw_batching"};
+    Setting<bool> use_transfer_queue{false, "use_transfer_queue"};
+    Setting<bool> use_async_compute{false, "use_async_compute"};
+    Setting<bool> use_memory_defragmentation{false, "use_memory_defragmentation"};
     Setting<bool> use_fast_gpu_time{true, "use_fast_gpu_time"};
     Setting<bool> use_caches_gc{false, "use_caches_gc"};
 
@@ -397,6 +454,8 @@ struct Values {
     BasicSetting<bool> gamecard_inserted{false, "gamecard_inserted"};
     BasicSetting<bool> gamecard_current_game{false, "gamecard_current_game"};
     BasicSetting<std::string> gamecard_path{std::string(), "gamecard_path"};
+    BasicSetting<u32> romfs_cache_size{4, "romfs_cache_size"};
+    BasicSetting<bool> use_shared_content_cache{false, "use_shared_content_cache"};
 
     // Debugging
     bool record_frame_times;
@@ -409,6 +468,9 @@ struct Values {
     BasicSetting<bool> reporting_services{false, "reporting_services"};
     BasicSetting<bool> quest_flag{false, "quest_flag"};
     BasicSetting<bool> disable_macro_jit{false, "disable_macro_jit"};
+    BasicSetting<bool> dump_macro_profile{false, "dump_macro_profile"};
+    BasicSetting<bool> dump_audio_renderer{false, "dump_audio_renderer"};
+    BasicSetting<u32> gpu_capture_frames{0, "gpu_capture_frames"};
     BasicSetting<bool> extended_logging{false, "extended_logging"};
     BasicSetting<bool> use_debug_asserts{false, "use_debug_asserts"};
     BasicSetting<bool> use_auto_stub{false, "use_auto_stub"};
@@ -440,6 +502,7 @@ bool IsGPULevelExtreme();
 bool IsGPULevelHigh();
 
 bool IsFastmemEnabled();
+bool IsHleMemoryFunctionsEnabled();
 
 float Volume();
 
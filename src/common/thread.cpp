@@ -20,6 +20,11 @@
 #ifndef _WIN32
 #include <unistd.h>
 #endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#elif defined(__x86_64__)
+#include <xmmintrin.h>
+#endif
 
 #include <string>
 
@@ -54,6 +59,13 @@ void SetCurrentThreadPriority(ThreadPriority new_priority) {
     SetThreadPriority(handle, windows_priority);
 }
 
+void SetCurrentThreadAffinity(u64 mask) {
+    if (mask == 0) {
+        return;
+    }
+    SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(mask));
+}
+
 #else
 
 void SetCurrentThreadPriority(ThreadPriority new_priority) {
@@ -73,6 +85,27 @@ void SetCurrentThreadPriority(ThreadPriority new_priority) {
     pthread_setschedparam(this_thread, SCHED_OTHER, &params);
 }
 
+void SetCurrentThreadAffinity(u64 mask) {
+    if (mask == 0) {
+        return;
+    }
+#if defined(__linux__) || defined(__FreeBSD__)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; ++cpu) {
+        if ((mask >> cpu) & 1) {
+            CPU_SET(cpu, &cpu_set);
+        }
+    }
+    if (int e = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set)) {
+        errno = e;
+        LOG_ERROR(Common, "Failed to set thread affinity to {:#x}: {}", mask, GetLastErrorMsg());
+    }
+#else
+    // Thread affinity is not supported on this host
+#endif
+}
+
 #endif
 
 #ifdef _MSC_VER
@@ -136,4 +169,14 @@ void SetCurrentThreadName(const char* name) {
 
 #endif
 
+void ThreadPause() {
+#if defined(_M_AMD64) || defined(__x86_64__)
+    _mm_pause();
+#elif defined(_M_ARM64)
+    __yield();
+#elif defined(__aarch64__)
+    asm("yield");
+#endif
+}
+
 } // namespace Common
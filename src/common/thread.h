@@ -96,6 +96,12 @@ enum class ThreadPriority : u32 {
 
 void SetCurrentThreadPriority(ThreadPriority new_priority);
 
+/// Restricts the current thread to the host cores set in the mask. A mask of 0 is ignored.
+void SetCurrentThreadAffinity(u64 mask);
+
 void SetCurrentThreadName(const char* name);
 
+/// Hints the host core that the current thread is spin waiting
+void ThreadPause();
+
 } // namespace Common
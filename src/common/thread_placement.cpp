@@ -0,0 +1,100 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <span>
+#include <vector>
+#include "common/settings.h"
+#include "common/thread.h"
+#include "common/thread_placement.h"
+
+namespace Common {
+
+#ifdef ARCHITECTURE_x86_64
+
+namespace {
+struct PhysicalCore {
+    u64 mask;
+    u32 cache_group;
+    u32 efficiency_class;
+};
+} // Anonymous namespace
+
+ThreadPlacement MakeThreadPlacement(const CPUTopology& topology, u32 num_guest_cores) {
+    std::vector<PhysicalCore> cores(topology.num_physical_cores);
+    for (const LogicalProcessor& processor : topology.processors) {
+        PhysicalCore& core = cores[processor.physical_core];
+        core.mask |= u64{1} << processor.id;
+        core.cache_group = processor.cache_group;
+        core.efficiency_class = processor.efficiency_class;
+    }
+    // The guest cores and both GPU threads need their own core, with one left for the others
+    const std::size_t num_critical = num_guest_cores + 2;
+    ThreadPlacement placement{};
+    if (cores.size() <= num_critical) {
+        return placement;
+    }
+
+    // Cores are taken fastest first, from the cache groups with the most of the fastest cores, so
+    // the critical threads share their last level cache
+    const u32 fastest_class = std::ranges::max(cores, {}, &PhysicalCore::efficiency_class)
+                                  .efficiency_class;
+    std::vector<u32> fast_cores_per_group(topology.num_cache_groups);
+    for (const PhysicalCore& core : cores) {
+        if (core.efficiency_class == fastest_class) {
+            ++fast_cores_per_group[core.cache_group];
+        }
+    }
+    std::ranges::stable_sort(cores, [&](const PhysicalCore& lhs, const PhysicalCore& rhs) {
+        if (lhs.efficiency_class != rhs.efficiency_class) {
+            return lhs.efficiency_class > rhs.efficiency_class;
+        }
+        const u32 lhs_fast_cores = fast_cores_per_group[lhs.cache_group];
+        const u32 rhs_fast_cores = fast_cores_per_group[rhs.cache_group];
+        if (lhs_fast_cores != rhs_fast_cores) {
+            return lhs_fast_cores > rhs_fast_cores;
+        }
+        return lhs.cache_group < rhs.cache_group;
+    });
+
+    const auto set_mask = [&placement](PlacedThread thread, u64 mask) {
+        placement.masks[static_cast<std::size_t>(thread)] = mask;
+    };
+    for (u32 core = 0; core < num_guest_cores; ++core) {
+        set_mask(CpuCoreThread(core), cores[core].mask);
+    }
+    set_mask(PlacedThread::Gpu, cores[num_guest_cores].mask);
+    set_mask(PlacedThread::GpuSubmission, cores[num_guest_cores + 1].mask);
+
+    const auto remaining = std::span(cores).subspan(num_critical);
+    const u32 slowest_class = remaining.back().efficiency_class;
+    u64 shared_mask = 0;
+    u64 compile_mask = 0;
+    for (const PhysicalCore& core : remaining) {
+        shared_mask |= core.mask;
+        if (core.efficiency_class == slowest_class) {
+            compile_mask |= core.mask;
+        }
+    }
+    set_mask(PlacedThread::CoreTiming, shared_mask);
+    set_mask(PlacedThread::Service, shared_mask);
+    set_mask(PlacedThread::ShaderCompile, compile_mask);
+    return placement;
+}
+
+#endif
+
+void PlaceCurrentThread([[maybe_unused]] PlacedThread thread) {
+#ifdef ARCHITECTURE_x86_64
+    if (!Settings::values.use_thread_placement.GetValue()) {
+        return;
+    }
+    const u32 num_guest_cores =
+        Settings::values.use_multi_core.GetValue() ? NUM_PLACED_CPU_CORES : 1;
+    const ThreadPlacement placement = MakeThreadPlacement(GetCPUTopology(), num_guest_cores);
+    SetCurrentThreadAffinity(placement.GetMask(thread));
+#endif
+}
+
+} // namespace Common
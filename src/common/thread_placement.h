@@ -0,0 +1,64 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include "common/common_types.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include "common/x64/cpu_detect.h"
+#endif
+
+namespace Common {
+
+/// Host threads given a place by the thread placement policy
+enum class PlacedThread : u32 {
+    CpuCore0,
+    CpuCore1,
+    CpuCore2,
+    CpuCore3,
+    Gpu,           ///< GPU command processing thread
+    GpuSubmission, ///< Vulkan scheduler worker recording and submitting command buffers
+    CoreTiming,    ///< Host timing thread of CoreTiming
+    Service,       ///< HLE service threads without a configured affinity
+    ShaderCompile, ///< Asynchronous shader compile workers
+    Count,
+};
+
+/// Number of guest cores run in multicore mode, each on its own host thread
+constexpr u32 NUM_PLACED_CPU_CORES = 4;
+
+/// Returns the placed thread running the given guest core
+constexpr PlacedThread CpuCoreThread(std::size_t core) {
+    return static_cast<PlacedThread>(static_cast<u32>(PlacedThread::CpuCore0) + core);
+}
+
+/// Host core masks of each placed thread, a mask of 0 leaves the thread to the host scheduler
+struct ThreadPlacement {
+    std::array<u64, static_cast<std::size_t>(PlacedThread::Count)> masks{};
+
+    [[nodiscard]] u64 GetMask(PlacedThread thread) const {
+        return masks[static_cast<std::size_t>(thread)];
+    }
+};
+
+#ifdef ARCHITECTURE_x86_64
+/**
+ * Gives the latency critical threads, the guest cores and the GPU threads, a physical core each,
+ * taking the fastest cores first and keeping them on one cache group when possible. The service and
+ * timing threads share the remaining cores, and shader compiles keep to the slowest of them.
+ * Nothing is placed when the host doesn't have a core left over for the other threads.
+ * @param topology        Layout of the host processors
+ * @param num_guest_cores Number of host threads running guest code, 1 in single core mode
+ */
+[[nodiscard]] ThreadPlacement MakeThreadPlacement(const CPUTopology& topology,
+                                                  u32 num_guest_cores);
+#endif
+
+/// Restricts the current thread to the host cores chosen for it, when thread placement is enabled
+void PlaceCurrentThread(PlacedThread thread);
+
+} // namespace Common
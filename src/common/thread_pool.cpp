@@ -0,0 +1,194 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <utility>
+
+#include "common/thread.h"
+#include "common/thread_pool.h"
+
+namespace Common {
+namespace {
+/// Threads running I/O tasks in the shared pool
+constexpr std::size_t NUM_IO_WORKERS = 2;
+
+/// Pool the current thread is a compute worker of, if any
+thread_local const ThreadPool* current_pool = nullptr;
+/// Index of the current thread in its pool
+thread_local std::size_t current_worker = 0;
+} // Anonymous namespace
+
+TaskGroup::~TaskGroup() {
+    Wait();
+}
+
+void TaskGroup::Wait() {
+    std::unique_lock lock{mutex};
+    cv.wait(lock, [this] { return pending == 0; });
+}
+
+void TaskGroup::Add() {
+    std::scoped_lock lock{mutex};
+    ++pending;
+}
+
+void TaskGroup::Done() {
+    std::scoped_lock lock{mutex};
+    if (--pending == 0) {
+        cv.notify_all();
+    }
+}
+
+ThreadPool::ThreadPool(std::size_t num_workers, std::size_t num_io_workers) {
+    num_workers = std::max<std::size_t>(num_workers, 1);
+    queues.reserve(num_workers);
+    for (std::size_t i = 0; i < num_workers; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    workers.reserve(num_workers);
+    for (std::size_t i = 0; i < num_workers; ++i) {
+        workers.emplace_back([this, i](std::stop_token stop_token) { WorkerLoop(stop_token, i); });
+    }
+    io_workers.reserve(num_io_workers);
+    for (std::size_t i = 0; i < num_io_workers; ++i) {
+        io_workers.emplace_back([this](std::stop_token stop_token) { IOWorkerLoop(stop_token); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    workers.clear();
+    io_workers.clear();
+
+    // Tasks that never ran still have to release their groups
+    for (auto& queue : queues) {
+        for (auto& tasks : queue->tasks) {
+            for (QueuedTask& queued : tasks) {
+                if (queued.group) {
+                    queued.group->Done();
+                }
+            }
+        }
+    }
+    for (QueuedTask& queued : io_tasks) {
+        if (queued.group) {
+            queued.group->Done();
+        }
+    }
+}
+
+ThreadPool& ThreadPool::Instance() {
+    static ThreadPool pool(std::max(std::thread::hardware_concurrency(), 2U) - 1, NUM_IO_WORKERS);
+    return pool;
+}
+
+void ThreadPool::Submit(TaskPriority priority, Task task, std::stop_token cancel,
+                        TaskGroup* group) {
+    if (group) {
+        group->Add();
+    }
+    QueuedTask queued{
+        .task = std::move(task),
+        .cancel = std::move(cancel),
+        .group = group,
+    };
+    if (priority == TaskPriority::IO) {
+        {
+            std::scoped_lock lock{io_mutex};
+            io_tasks.push_back(std::move(queued));
+        }
+        io_cv.notify_one();
+        return;
+    }
+    // Workers keep the tasks they spawn, other threads spread them across the pool
+    const std::size_t queue_index = current_pool == this
+                                        ? current_worker
+                                        : next_queue.fetch_add(1, std::memory_order_relaxed) %
+                                              queues.size();
+    WorkerQueue& queue = *queues[queue_index];
+    {
+        std::scoped_lock lock{queue.mutex};
+        queue.tasks[static_cast<std::size_t>(priority)].push_back(std::move(queued));
+    }
+    {
+        std::scoped_lock lock{sleep_mutex};
+        num_queued.fetch_add(1, std::memory_order_relaxed);
+    }
+    sleep_cv.notify_one();
+}
+
+void ThreadPool::WorkerLoop(std::stop_token stop_token, std::size_t worker_index) {
+    Common::SetCurrentThreadName("yuzu:PoolWorker");
+    current_pool = this;
+    current_worker = worker_index;
+    while (!stop_token.stop_requested()) {
+        QueuedTask queued;
+        bool found = false;
+        for (std::size_t priority = 0; priority < NUM_COMPUTE_PRIORITIES && !found; ++priority) {
+            found = TryPop(worker_index, priority, queued);
+        }
+        if (found) {
+            num_queued.fetch_sub(1, std::memory_order_relaxed);
+            Run(queued);
+            continue;
+        }
+        std::unique_lock lock{sleep_mutex};
+        sleep_cv.wait(lock, stop_token,
+                      [this] { return num_queued.load(std::memory_order_relaxed) > 0; });
+    }
+}
+
+void ThreadPool::IOWorkerLoop(std::stop_token stop_token) {
+    Common::SetCurrentThreadName("yuzu:IOWorker");
+    while (!stop_token.stop_requested()) {
+        QueuedTask queued;
+        {
+            std::unique_lock lock{io_mutex};
+            if (!io_cv.wait(lock, stop_token, [this] { return !io_tasks.empty(); })) {
+                return;
+            }
+            queued = std::move(io_tasks.front());
+            io_tasks.pop_front();
+        }
+        Run(queued);
+    }
+}
+
+bool ThreadPool::TryPop(std::size_t worker_index, std::size_t priority, QueuedTask& out) {
+    // The owner takes its newest task, as its data is more likely to be in cache
+    {
+        WorkerQueue& queue = *queues[worker_index];
+        std::scoped_lock lock{queue.mutex};
+        auto& tasks = queue.tasks[priority];
+        if (!tasks.empty()) {
+            out = std::move(tasks.back());
+            tasks.pop_back();
+            return true;
+        }
+    }
+    // Thieves take the oldest task of the other queues
+    for (std::size_t offset = 1; offset < queues.size(); ++offset) {
+        WorkerQueue& queue = *queues[(worker_index + offset) % queues.size()];
+        std::scoped_lock lock{queue.mutex};
+        auto& tasks = queue.tasks[priority];
+        if (!tasks.empty()) {
+            out = std::move(tasks.front());
+            tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::Run(QueuedTask& queued) {
+    if (!queued.cancel.stop_requested()) {
+        queued.task(std::stop_token{queued.cancel});
+    }
+    // Destroy the captures before notifying, waiters may own what they reference
+    queued.task = {};
+    if (queued.group) {
+        queued.group->Done();
+    }
+}
+
+} // namespace Common
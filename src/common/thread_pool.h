@@ -0,0 +1,129 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/unique_function.h"
+
+namespace Common {
+
+/// Scheduling class of a pool task
+enum class TaskPriority : u32 {
+    LatencyCritical,   ///< Work emulation is waiting on, taken before any other work
+    BackgroundCompile, ///< Work that only makes later frames faster, like shader builds
+    IO,                ///< Work that blocks on the host, run on its own threads
+};
+
+/// Tracks the completion of a set of pool tasks
+class TaskGroup {
+public:
+    TaskGroup() = default;
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    /// Blocks until every task submitted with this group has finished or been cancelled
+    void Wait();
+
+private:
+    friend class ThreadPool;
+
+    void Add();
+    void Done();
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::size_t pending = 0;
+};
+
+/**
+ * Pool of host threads shared by the whole emulator.
+ * Compute tasks go to per-worker queues and idle workers steal from the others, latency-critical
+ * tasks are taken before background ones when a worker becomes free. I/O tasks run on a few
+ * separate threads so blocking on the host doesn't keep compute workers from running.
+ * All public functions of this class are thread-safe.
+ */
+class ThreadPool {
+public:
+    using Task = UniqueFunction<void, std::stop_token>;
+
+    explicit ThreadPool(std::size_t num_workers, std::size_t num_io_workers);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Returns the pool shared by the emulator, with a compute worker per host core but one.
+    [[nodiscard]] static ThreadPool& Instance();
+
+    /**
+     * Queues a task.
+     * @param priority Scheduling class of the task.
+     * @param task     Called with the cancellation token, it may poll it to stop early.
+     * @param cancel   The task is dropped without being called when a stop is requested on it
+     *                 before it starts.
+     * @param group    Group notified when the task finishes or is dropped, it may be null.
+     */
+    void Submit(TaskPriority priority, Task task, std::stop_token cancel = {},
+                TaskGroup* group = nullptr);
+
+    /// Returns the number of threads running compute tasks.
+    [[nodiscard]] std::size_t NumWorkers() const noexcept {
+        return queues.size();
+    }
+
+private:
+    /// Number of priorities run on compute workers
+    static constexpr std::size_t NUM_COMPUTE_PRIORITIES = 2;
+
+    struct QueuedTask {
+        Task task;
+        std::stop_token cancel;
+        TaskGroup* group{};
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::array<std::deque<QueuedTask>, NUM_COMPUTE_PRIORITIES> tasks;
+    };
+
+    void WorkerLoop(std::stop_token stop_token, std::size_t worker_index);
+
+    void IOWorkerLoop(std::stop_token stop_token);
+
+    /// Pops a task of the given priority, from the worker's own queue first and then stealing
+    bool TryPop(std::size_t worker_index, std::size_t priority, QueuedTask& out);
+
+    /// Runs a task unless it has been cancelled and notifies its group
+    static void Run(QueuedTask& queued);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::atomic_size_t next_queue{0};
+
+    std::mutex sleep_mutex;
+    std::condition_variable_any sleep_cv;
+    std::atomic<std::ptrdiff_t> num_queued{0}; ///< Compute tasks queued, briefly negative on pops
+
+    std::mutex io_mutex;
+    std::condition_variable_any io_cv;
+    std::deque<QueuedTask> io_tasks;
+
+    std::vector<std::jthread> workers;
+    std::vector<std::jthread> io_workers;
+};
+
+} // namespace Common
@@ -0,0 +1,302 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/fs/file.h"
+#include "common/logging/log.h"
+#include "common/trace_recorder.h"
+
+namespace Common::TraceRecorder {
+namespace {
+/// Scopes each thread keeps, the oldest ones are overwritten once a buffer wraps around
+constexpr std::size_t THREAD_BUFFER_SIZE = 1U << 15;
+
+struct Event {
+    u64 token;
+    u64 begin_ns;
+    u64 end_ns;
+};
+
+struct ThreadBuffer {
+    std::array<Event, THREAD_BUFFER_SIZE> events;
+    std::size_t num_events{};
+    /// Set while the owning thread stores an event
+    std::atomic_bool writing{false};
+    u32 thread_id{};
+    std::string thread_name;
+};
+
+struct GpuEvent {
+    std::string name;
+    u32 track;
+    u64 begin_ns;
+    u64 end_ns;
+};
+
+struct State {
+    std::mutex buffers_mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    u64 start_ns{};
+
+    /// GPU passes are resolved off the hot paths, a single locked ring buffer holds them
+    std::mutex gpu_mutex;
+    std::vector<std::string> gpu_tracks;
+    std::vector<GpuEvent> gpu_events;
+    std::size_t num_gpu_events{};
+
+    std::mutex frames_mutex;
+    std::filesystem::path frames_path;
+    u64 frame{};
+    u64 first_frame{};
+    u64 num_frames{};
+    bool frames_pending{};
+};
+
+State& GetState() {
+    static State state;
+    return state;
+}
+
+ThreadBuffer& GetThreadBuffer() {
+    thread_local const std::shared_ptr<ThreadBuffer> buffer = [] {
+        auto new_buffer = std::make_shared<ThreadBuffer>();
+        new_buffer->thread_name = Detail::GetThreadName();
+
+        State& state = GetState();
+        std::scoped_lock lock{state.buffers_mutex};
+        new_buffer->thread_id = static_cast<u32>(state.buffers.size() + 1);
+        state.buffers.push_back(new_buffer);
+        return new_buffer;
+    }();
+    return *buffer;
+}
+
+void WriteEscaped(std::string& out, const char* string) {
+    for (; *string != '\0'; ++string) {
+        if (*string == '"' || *string == '\\') {
+            out += '\\';
+        }
+        out += *string;
+    }
+}
+} // Anonymous namespace
+
+namespace Detail {
+std::atomic_bool recording{false};
+
+void RecordScope(u64 token, u64 begin_ns) {
+    ThreadBuffer& buffer = GetThreadBuffer();
+    // Stop clears the recording flag before waiting on the writing flag, so either it waits for
+    // this store or it is seen here
+    buffer.writing.store(true);
+    if (recording.load()) {
+        buffer.events[buffer.num_events % THREAD_BUFFER_SIZE] = {
+            .token = token,
+            .begin_ns = begin_ns,
+            .end_ns = Now(),
+        };
+        ++buffer.num_events;
+    }
+    buffer.writing.store(false, std::memory_order_release);
+}
+} // namespace Detail
+
+void RecordGpuScope(std::string_view track, std::string name, u64 begin_ns, u64 end_ns) {
+    if (!IsRecording()) {
+        return;
+    }
+    State& state = GetState();
+    std::scoped_lock lock{state.gpu_mutex};
+    auto track_it = std::ranges::find(state.gpu_tracks, track);
+    if (track_it == state.gpu_tracks.end()) {
+        track_it = state.gpu_tracks.emplace(track_it, track);
+    }
+    GpuEvent event{
+        .name = std::move(name),
+        .track = static_cast<u32>(std::distance(state.gpu_tracks.begin(), track_it)),
+        .begin_ns = begin_ns,
+        .end_ns = end_ns,
+    };
+    if (state.gpu_events.size() < THREAD_BUFFER_SIZE) {
+        state.gpu_events.push_back(std::move(event));
+    } else {
+        state.gpu_events[state.num_gpu_events % THREAD_BUFFER_SIZE] = std::move(event);
+    }
+    ++state.num_gpu_events;
+}
+
+void Start() {
+    if (IsRecording()) {
+        Stop();
+    }
+    State& state = GetState();
+    {
+        std::scoped_lock lock{state.buffers_mutex};
+        for (const auto& buffer : state.buffers) {
+            buffer->num_events = 0;
+        }
+        state.start_ns = Detail::Now();
+    }
+    {
+        std::scoped_lock lock{state.gpu_mutex};
+        state.gpu_events.clear();
+        state.num_gpu_events = 0;
+    }
+    Detail::recording.store(true);
+}
+
+void Stop() {
+    Detail::recording.store(false);
+
+    State& state = GetState();
+    std::scoped_lock lock{state.buffers_mutex};
+    for (const auto& buffer : state.buffers) {
+        while (buffer->writing.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool Export(const std::filesystem::path& path) {
+    FS::IOFile file{path, FS::FileAccessMode::Write, FS::FileType::TextFile};
+    if (!file.IsOpen()) {
+        LOG_ERROR(Common, "Failed to open trace file {}", path.string());
+        return false;
+    }
+
+    State& state = GetState();
+    std::scoped_lock lock{state.buffers_mutex};
+
+    std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool first_event = true;
+    const auto begin_event = [&] {
+        if (!first_event) {
+            out += ",\n";
+        }
+        first_event = false;
+    };
+    std::size_t num_exported = 0;
+    for (const auto& buffer : state.buffers) {
+        begin_event();
+        out += fmt::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},"
+                           "\"args\":{{\"name\":\"",
+                           buffer->thread_id);
+        WriteEscaped(out, buffer->thread_name.c_str());
+        out += "\"}}";
+
+        const std::size_t num_events = std::min(buffer->num_events, THREAD_BUFFER_SIZE);
+        const std::size_t first = buffer->num_events - num_events;
+        for (std::size_t i = first; i < buffer->num_events; ++i) {
+            const Event& event = buffer->events[i % THREAD_BUFFER_SIZE];
+            begin_event();
+            out += "{\"name\":\"";
+            WriteEscaped(out, Detail::GetScopeName(event.token));
+            out += "\",\"cat\":\"";
+            WriteEscaped(out, Detail::GetScopeGroupName(event.token));
+            // Timestamps are in microseconds, keep the nanoseconds as decimals
+            out += fmt::format("\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                               buffer->thread_id,
+                               static_cast<double>(event.begin_ns - state.start_ns) / 1000.0,
+                               static_cast<double>(event.end_ns - event.begin_ns) / 1000.0);
+            if (out.size() > 1U << 20) {
+                void(file.WriteString(out));
+                out.clear();
+            }
+        }
+        num_exported += num_events;
+    }
+
+    std::scoped_lock gpu_lock{state.gpu_mutex};
+    // GPU tracks are numbered after the threads that may still show up later
+    constexpr u32 FIRST_GPU_TRACK_ID = 1U << 16;
+    for (std::size_t track = 0; track < state.gpu_tracks.size(); ++track) {
+        begin_event();
+        out += fmt::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},"
+                           "\"args\":{{\"name\":\"",
+                           FIRST_GPU_TRACK_ID + track);
+        WriteEscaped(out, state.gpu_tracks[track].c_str());
+        out += "\"}}";
+    }
+    for (const GpuEvent& event : state.gpu_events) {
+        if (event.begin_ns < state.start_ns) {
+            continue;
+        }
+        begin_event();
+        out += "{\"name\":\"";
+        WriteEscaped(out, event.name.c_str());
+        out += fmt::format("\",\"cat\":\"GPU\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},"
+                           "\"dur\":{:.3f}}}",
+                           FIRST_GPU_TRACK_ID + event.track,
+                           static_cast<double>(event.begin_ns - state.start_ns) / 1000.0,
+                           static_cast<double>(event.end_ns - event.begin_ns) / 1000.0);
+        if (out.size() > 1U << 20) {
+            void(file.WriteString(out));
+            out.clear();
+        }
+        ++num_exported;
+    }
+
+    out += "\n]}\n";
+    if (file.WriteString(out) != out.size()) {
+        LOG_ERROR(Common, "Failed to write trace file {}", path.string());
+        return false;
+    }
+    LOG_INFO(Common, "Exported {} scopes to {}", num_exported, path.string());
+    return true;
+}
+
+void RecordFrames(std::filesystem::path path, u64 first_frame, u64 num_frames) {
+    State& state = GetState();
+    std::scoped_lock lock{state.frames_mutex};
+    state.frames_path = std::move(path);
+    state.first_frame = state.frame + first_frame;
+    state.num_frames = num_frames;
+    state.frames_pending = true;
+    if (first_frame == 0) {
+        Start();
+    }
+}
+
+void OnFrame() {
+    State& state = GetState();
+    std::scoped_lock lock{state.frames_mutex};
+    ++state.frame;
+    if (!state.frames_pending) {
+        return;
+    }
+    if (state.frame == state.first_frame) {
+        Start();
+    } else if (state.num_frames != 0 && state.frame == state.first_frame + state.num_frames) {
+        Stop();
+        void(Export(state.frames_path));
+        state.frames_pending = false;
+    }
+}
+
+void Finish() {
+    State& state = GetState();
+    std::scoped_lock lock{state.frames_mutex};
+    if (!state.frames_pending) {
+        return;
+    }
+    state.frames_pending = false;
+    if (!IsRecording()) {
+        LOG_WARNING(Common, "Trace recording finished before frame {} was presented",
+                    state.first_frame);
+        return;
+    }
+    Stop();
+    void(Export(state.frames_path));
+}
+
+} // namespace Common::TraceRecorder
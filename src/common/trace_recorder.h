@@ -0,0 +1,103 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "common/common_types.h"
+
+/**
+ * Headless recorder of MicroProfile scopes. While it is recording, every MICROPROFILE_SCOPE is
+ * stored in a ring buffer of the thread that entered it, and the recording can be exported as a
+ * Chrome trace event file, which both chrome://tracing and Perfetto load. Renderers add the GPU
+ * time of their passes on tracks of their own, once the GPU has executed them.
+ */
+namespace Common::TraceRecorder {
+
+namespace Detail {
+extern std::atomic_bool recording;
+
+/// Stores a scope that began at begin_ns and ends now
+void RecordScope(u64 token, u64 begin_ns);
+
+// Implemented next to the MicroProfile state in microprofile.cpp
+[[nodiscard]] const char* GetScopeName(u64 token);
+[[nodiscard]] const char* GetScopeGroupName(u64 token);
+[[nodiscard]] const char* GetThreadName();
+
+/// Returns the current time of the clock used by the recorder in nanoseconds
+[[nodiscard]] inline u64 Now() {
+    return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now().time_since_epoch())
+                                .count());
+}
+} // namespace Detail
+
+/// Returns true while scopes are being recorded
+[[nodiscard]] inline bool IsRecording() {
+    return Detail::recording.load(std::memory_order_relaxed);
+}
+
+/**
+ * Stores a pass the GPU executed while recording, on the given track of the trace.
+ * @param track    Name of the track, passes of a track should nest
+ * @param name     Label of the pass
+ * @param begin_ns Time the pass began, in the clock of Detail::Now
+ * @param end_ns   Time the pass ended, in the clock of Detail::Now
+ */
+void RecordGpuScope(std::string_view track, std::string name, u64 begin_ns, u64 end_ns);
+
+/// Discards previously recorded scopes and starts recording
+void Start();
+
+/// Stops recording, waiting for threads in the middle of storing a scope
+void Stop();
+
+/**
+ * Writes the recorded scopes to a Chrome trace event JSON file. Recording must be stopped.
+ * @returns true on success
+ */
+bool Export(const std::filesystem::path& path);
+
+/**
+ * Records the frames [first_frame, first_frame + num_frames) and exports them to path once the
+ * last one has been presented. When num_frames is zero, recording lasts until Finish.
+ */
+void RecordFrames(std::filesystem::path path, u64 first_frame, u64 num_frames);
+
+/// Counts a presented frame, starting or finishing a recording requested with RecordFrames
+void OnFrame();
+
+/// Stops and exports a recording requested with RecordFrames that hasn't finished yet
+void Finish();
+
+/// Records the scope it lives in, pairs with a MicroProfile scope handler
+class ScopeRecorder {
+public:
+    explicit ScopeRecorder(u64 token_) : token{token_} {
+        if (IsRecording()) {
+            begin_ns = Detail::Now();
+        }
+    }
+
+    ~ScopeRecorder() {
+        if (begin_ns != 0) {
+            Detail::RecordScope(token, begin_ns);
+        }
+    }
+
+    ScopeRecorder(const ScopeRecorder&) = delete;
+    ScopeRecorder& operator=(const ScopeRecorder&) = delete;
+
+private:
+    u64 token;
+    u64 begin_ns{};
+};
+
+} // namespace Common::TraceRecorder
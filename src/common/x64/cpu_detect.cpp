@@ -2,10 +2,25 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cstring>
+#include <thread>
 #include "common/common_types.h"
 #include "common/x64/cpu_detect.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <charconv>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <fmt/format.h>
+#include "common/fs/file.h"
+#endif
+
 #ifdef _MSC_VER
 #include <intrin.h>
 #else
@@ -176,4 +191,193 @@ const CPUCaps& GetCPUCaps() {
     return caps;
 }
 
+namespace {
+
+/// Logical processors that fit in an affinity mask
+constexpr u32 MAX_PROCESSORS = 64;
+
+/// Location of a logical processor as reported by the host, before it is given dense indices
+struct ProcessorLocation {
+    u32 id;
+    u64 core_key;
+    u64 cache_key;
+    u32 efficiency_class;
+};
+
+CPUTopology MakeTopology(const std::vector<ProcessorLocation>& locations) {
+    std::vector<u64> core_keys;
+    std::vector<u64> cache_keys;
+    const auto index_of = [](std::vector<u64>& keys, u64 key) {
+        const auto it = std::ranges::find(keys, key);
+        if (it != keys.end()) {
+            return static_cast<u32>(std::distance(keys.begin(), it));
+        }
+        keys.push_back(key);
+        return static_cast<u32>(keys.size() - 1);
+    };
+    CPUTopology topology{};
+    for (const ProcessorLocation& location : locations) {
+        topology.processors.push_back(LogicalProcessor{
+            .id = location.id,
+            .physical_core = index_of(core_keys, location.core_key),
+            .cache_group = index_of(cache_keys, location.cache_key),
+            .efficiency_class = location.efficiency_class,
+        });
+    }
+    topology.num_physical_cores = static_cast<u32>(core_keys.size());
+    topology.num_cache_groups = static_cast<u32>(cache_keys.size());
+    topology.has_smt = topology.num_physical_cores < topology.processors.size();
+    topology.is_hybrid = std::ranges::any_of(topology.processors, [&](const auto& processor) {
+        return processor.efficiency_class != topology.processors.front().efficiency_class;
+    });
+    return topology;
+}
+
+/// Treats every logical processor as its own core, all of them sharing one cache
+std::vector<ProcessorLocation> DetectFallbackLocations() {
+    const u32 num_processors = std::clamp(std::thread::hardware_concurrency(), 1U, MAX_PROCESSORS);
+    std::vector<ProcessorLocation> locations;
+    for (u32 id = 0; id < num_processors; ++id) {
+        locations.push_back({id, id, 0, 0});
+    }
+    return locations;
+}
+
+#ifdef _WIN32
+
+std::vector<ProcessorLocation> DetectLocations() {
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+    std::vector<u8> buffer(length);
+    if (length == 0 ||
+        !GetLogicalProcessorInformationEx(
+            RelationAll, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()),
+            &length)) {
+        return DetectFallbackLocations();
+    }
+    // Affinity masks of the current thread only address processor group 0
+    const auto group_mask = [](const GROUP_AFFINITY& affinity) -> u64 {
+        return affinity.Group == 0 ? static_cast<u64>(affinity.Mask) : 0;
+    };
+    std::array<ProcessorLocation, MAX_PROCESSORS> by_id{};
+    u64 present = 0;
+    u64 num_cores = 0;
+    u64 num_caches = 0;
+    for (DWORD offset = 0; offset < length;) {
+        const auto& info =
+            *reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(&buffer[offset]);
+        offset += info.Size;
+        if (info.Relationship == RelationProcessorCore) {
+            for (u64 mask = group_mask(info.Processor.GroupMask[0]); mask != 0; mask &= mask - 1) {
+                const u32 id = static_cast<u32>(std::countr_zero(mask));
+                by_id[id].id = id;
+                by_id[id].core_key = num_cores;
+                by_id[id].efficiency_class = info.Processor.EfficiencyClass;
+                present |= u64{1} << id;
+            }
+            ++num_cores;
+        } else if (info.Relationship == RelationCache && info.Cache.Level == 3) {
+            ++num_caches;
+            for (u64 mask = group_mask(info.Cache.GroupMask); mask != 0; mask &= mask - 1) {
+                by_id[std::countr_zero(mask)].cache_key = num_caches;
+            }
+        }
+    }
+    std::vector<ProcessorLocation> locations;
+    for (; present != 0; present &= present - 1) {
+        locations.push_back(by_id[std::countr_zero(present)]);
+    }
+    return locations.empty() ? DetectFallbackLocations() : locations;
+}
+
+#elif defined(__linux__)
+
+std::string ReadSysfs(const std::string& path) {
+    return Common::FS::ReadStringFromFile(path, Common::FS::FileType::TextFile);
+}
+
+/// Parses a sysfs CPU list like "0-3,8-11" into its processor ids
+std::vector<u32> ParseCpuList(std::string_view list) {
+    std::vector<u32> ids;
+    const char* it = list.data();
+    const char* const end = list.data() + list.size();
+    while (it != end) {
+        u32 first = 0;
+        auto result = std::from_chars(it, end, first);
+        if (result.ec != std::errc{}) {
+            break;
+        }
+        u32 last = first;
+        if (result.ptr != end && *result.ptr == '-') {
+            result = std::from_chars(result.ptr + 1, end, last);
+            if (result.ec != std::errc{}) {
+                break;
+            }
+        }
+        for (u32 id = first; id <= last && id < MAX_PROCESSORS; ++id) {
+            ids.push_back(id);
+        }
+        it = result.ptr;
+        if (it != end && *it == ',') {
+            ++it;
+        } else {
+            break;
+        }
+    }
+    return ids;
+}
+
+/// Returns the first processor of the list in the given sysfs file, used as a key of the group
+std::optional<u32> ReadFirstCpu(const std::string& path) {
+    const std::vector<u32> ids = ParseCpuList(ReadSysfs(path));
+    if (ids.empty()) {
+        return std::nullopt;
+    }
+    return ids.front();
+}
+
+std::vector<ProcessorLocation> DetectLocations() {
+    const std::vector<u32> online = ParseCpuList(ReadSysfs("/sys/devices/system/cpu/online"));
+    if (online.empty()) {
+        return DetectFallbackLocations();
+    }
+    // Hybrid Intel processors expose their performance cores as a separate PMU
+    const std::vector<u32> performance_cores =
+        ParseCpuList(ReadSysfs("/sys/devices/cpu_core/cpus"));
+    std::vector<ProcessorLocation> locations;
+    for (const u32 id : online) {
+        const std::string cpu_path = fmt::format("/sys/devices/system/cpu/cpu{}", id);
+        const std::optional<u32> core =
+            ReadFirstCpu(cpu_path + "/topology/thread_siblings_list");
+        // Processors without a level 3 cache are grouped by package
+        std::optional<u32> cache = ReadFirstCpu(cpu_path + "/cache/index3/shared_cpu_list");
+        if (!cache) {
+            cache = ReadFirstCpu(cpu_path + "/topology/core_siblings_list");
+        }
+        locations.push_back(ProcessorLocation{
+            .id = id,
+            .core_key = core.value_or(id),
+            .cache_key = cache.value_or(0),
+            .efficiency_class =
+                std::ranges::find(performance_cores, id) != performance_cores.end() ? 1U : 0U,
+        });
+    }
+    return locations;
+}
+
+#else
+
+std::vector<ProcessorLocation> DetectLocations() {
+    return DetectFallbackLocations();
+}
+
+#endif
+
+} // Anonymous namespace
+
+const CPUTopology& GetCPUTopology() {
+    static const CPUTopology topology = MakeTopology(DetectLocations());
+    return topology;
+}
+
 } // namespace Common
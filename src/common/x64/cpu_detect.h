@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <vector>
+#include "common/common_types.h"
+
 namespace Common {
 
 enum class Manufacturer : u32 {
@@ -45,4 +48,28 @@ struct CPUCaps {
  */
 const CPUCaps& GetCPUCaps();
 
+/// Logical processor of the host, as addressed by thread affinity masks
+struct LogicalProcessor {
+    u32 id;               ///< Bit of the processor in affinity masks
+    u32 physical_core;    ///< Physical core running the processor, shared by SMT siblings
+    u32 cache_group;      ///< Cores sharing the last level cache, an AMD CCX or CCD
+    u32 efficiency_class; ///< Relative performance of the core, higher is faster
+};
+
+/// Layout of the host processors, limited to the ones addressable by a 64-bit affinity mask
+struct CPUTopology {
+    std::vector<LogicalProcessor> processors;
+    u32 num_physical_cores;
+    u32 num_cache_groups;
+    bool has_smt;   ///< True when some physical core runs several logical processors
+    bool is_hybrid; ///< True when the cores don't all share the same efficiency class
+};
+
+/**
+ * Gets the layout of the host processors
+ * @return Reference to a CPUTopology struct, with one core per processor when the layout can't be
+ *         detected
+ */
+const CPUTopology& GetCPUTopology();
+
 } // namespace Common
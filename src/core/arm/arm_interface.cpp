@@ -275,4 +275,22 @@ void ARM_Interface::LogBacktrace() const {
     }
 }
 
+ARM_Interface::ExecutionStats ARM_Interface::GetAndResetExecutionStats() {
+    return {
+        .jit_time = std::chrono::nanoseconds{
+            static_cast<s64>(jit_time_ns.exchange(0, std::memory_order_relaxed))},
+        .svc_exits = svc_exits.exchange(0, std::memory_order_relaxed),
+        .halt_exits = halt_exits.exchange(0, std::memory_order_relaxed),
+    };
+}
+
+void ARM_Interface::RecordJitExit(std::chrono::nanoseconds jit_time, bool svc_called) {
+    jit_time_ns.fetch_add(static_cast<u64>(jit_time.count()), std::memory_order_relaxed);
+    if (svc_called) {
+        svc_exits.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        halt_exits.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
 } // namespace Core
@@ -5,6 +5,8 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <vector>
 #include "common/common_types.h"
 #include "core/hardware_properties.h"
@@ -59,9 +61,22 @@ public:
     // thread context to be 800 bytes in size.
     static_assert(sizeof(ThreadContext64) == 0x320);
 
+    /// Guest execution counters of this core since they were last reset
+    struct ExecutionStats {
+        /// Host time spent running guest code, excluding supervisor calls
+        std::chrono::nanoseconds jit_time;
+        /// Number of times the JIT returned to dispatch a supervisor call
+        u64 svc_exits;
+        /// Number of times the JIT was halted for an interrupt or a reschedule
+        u64 halt_exits;
+    };
+
     /// Runs the CPU until an event happens
     virtual void Run() = 0;
 
+    /// Returns the execution counters and resets them, threadsafe.
+    ExecutionStats GetAndResetExecutionStats();
+
     /// Step CPU by one instruction
     virtual void Step() = 0;
 
@@ -189,10 +204,18 @@ public:
     void LogBacktrace() const;
 
 protected:
+    /// Accounts a return from the JIT. Called by Run on the host thread of this core.
+    void RecordJitExit(std::chrono::nanoseconds jit_time, bool svc_called);
+
     /// System context that this ARM interface is running under.
     System& system;
     CPUInterrupts& interrupt_handlers;
     bool uses_wall_clock;
+
+private:
+    std::atomic<u64> jit_time_ns{};
+    std::atomic<u64> svc_exits{};
+    std::atomic<u64> halt_exits{};
 };
 
 } // namespace Core
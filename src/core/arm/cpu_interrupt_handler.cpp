@@ -2,24 +2,82 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+
 #include "common/thread.h"
 #include "core/arm/cpu_interrupt_handler.h"
 
 namespace Core {
+namespace {
+// Bounds of the spin before parking, guest thread handoffs usually interrupt an idle core soon
+constexpr u32 MIN_SPIN_COUNT = 16;
+constexpr u32 MAX_SPIN_COUNT = 1024;
+
+s64 Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+} // Anonymous namespace
 
-CPUInterruptHandler::CPUInterruptHandler() : interrupt_event{std::make_unique<Common::Event>()} {}
+CPUInterruptHandler::CPUInterruptHandler() : spin_count{MIN_SPIN_COUNT} {}
 
 CPUInterruptHandler::~CPUInterruptHandler() = default;
 
 void CPUInterruptHandler::SetInterrupt(bool is_interrupted_) {
-    if (is_interrupted_) {
-        interrupt_event->Set();
+    if (is_interrupted_ && !is_wake_pending.load(std::memory_order_relaxed)) {
+        interrupt_time_ns.store(Now(), std::memory_order_relaxed);
+        // The wait is a futex on Linux and WaitOnAddress on Windows, waking it is cheap when
+        // nobody is parked on it
+        is_wake_pending.store(true, std::memory_order_release);
+        is_wake_pending.notify_one();
     }
     is_interrupted = is_interrupted_;
 }
 
 void CPUInterruptHandler::AwaitInterrupt() {
-    interrupt_event->Wait();
+    if (is_wake_pending.exchange(false, std::memory_order_acquire)) {
+        // Interrupted before the core had to wait, there's no wake latency to account
+        return;
+    }
+    const s64 wait_begin_ns = Now();
+    for (u32 spin = 0; spin < spin_count; ++spin) {
+        Common::ThreadPause();
+        if (is_wake_pending.exchange(false, std::memory_order_acquire)) {
+            // The spin paid off, keep spinning longer next time
+            spin_count = std::min(spin_count * 2, MAX_SPIN_COUNT);
+            RecordWake(wait_begin_ns);
+            return;
+        }
+    }
+    spin_count = std::max(spin_count / 2, MIN_SPIN_COUNT);
+    while (!is_wake_pending.exchange(false, std::memory_order_acquire)) {
+        is_wake_pending.wait(false, std::memory_order_relaxed);
+    }
+    RecordWake(wait_begin_ns);
+}
+
+CPUInterruptHandler::WakeStats CPUInterruptHandler::GetAndResetWakeStats() {
+    return WakeStats{
+        .wakes = num_wakes.exchange(0, std::memory_order_relaxed),
+        .total_latency = std::chrono::nanoseconds{static_cast<s64>(
+            total_latency_ns.exchange(0, std::memory_order_relaxed))},
+        .max_latency = std::chrono::nanoseconds{
+            static_cast<s64>(max_latency_ns.exchange(0, std::memory_order_relaxed))},
+    };
+}
+
+void CPUInterruptHandler::RecordWake(s64 wait_begin_ns) {
+    // The interrupt may have been sent right before the wait began, only the wait is latency
+    const s64 interrupt_ns = interrupt_time_ns.load(std::memory_order_relaxed);
+    const s64 signal_ns = std::max(interrupt_ns, wait_begin_ns);
+    const u64 latency_ns = static_cast<u64>(std::max<s64>(Now() - signal_ns, 0));
+    num_wakes.fetch_add(1, std::memory_order_relaxed);
+    total_latency_ns.fetch_add(latency_ns, std::memory_order_relaxed);
+    u64 max_ns = max_latency_ns.load(std::memory_order_relaxed);
+    while (max_ns < latency_ns &&
+           !max_latency_ns.compare_exchange_weak(max_ns, latency_ns, std::memory_order_relaxed)) {
+    }
 }
 
 } // namespace Core
@@ -5,16 +5,21 @@
 #pragma once
 
 #include <atomic>
-#include <memory>
+#include <chrono>
 
-namespace Common {
-class Event;
-}
+#include "common/common_types.h"
 
 namespace Core {
 
 class CPUInterruptHandler {
 public:
+    /// Time the core took to resume after being interrupted while waiting for it
+    struct WakeStats {
+        u64 wakes;
+        std::chrono::nanoseconds total_latency;
+        std::chrono::nanoseconds max_latency;
+    };
+
     CPUInterruptHandler();
     ~CPUInterruptHandler();
 
@@ -30,11 +35,25 @@ public:
 
     void SetInterrupt(bool is_interrupted);
 
+    /// Spins briefly and then parks the calling thread until the next interrupt
     void AwaitInterrupt();
 
+    /// Returns the wake statistics since the last call, and resets them
+    WakeStats GetAndResetWakeStats();
+
 private:
-    std::unique_ptr<Common::Event> interrupt_event;
+    void RecordWake(s64 wait_begin_ns);
+
+    std::atomic_bool is_wake_pending{false};
     std::atomic_bool is_interrupted{false};
+    std::atomic<s64> interrupt_time_ns{0};
+
+    /// Number of pauses spun before parking, adapted to how soon recent interrupts arrived
+    u32 spin_count;
+
+    std::atomic<u64> num_wakes{0};
+    std::atomic<u64> total_latency_ns{0};
+    std::atomic<u64> max_latency_ns{0};
 };
 
 } // namespace Core
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cinttypes>
 #include <memory>
 #include <dynarmic/interface/A32/a32.h>
@@ -145,9 +146,12 @@ std::shared_ptr<Dynarmic::A32::Jit> ARM_Dynarmic_32::MakeJit(Common::PageTable*
     // Timing
     config.wall_clock_cntpct = uses_wall_clock;
 
-    // Code cache size
-    config.code_cache_size = 512_MiB;
-    config.far_code_offset = 400_MiB;
+    // Code cache size, far code takes the last part of it. Dynarmic flushes the whole cache when
+    // it fills, so titles with a lot of code can be given a bigger one.
+    const u32 code_cache_size =
+        std::clamp<u32>(Settings::values.cpu_code_cache_size.GetValue(), 64, 1536) * 1_MiB;
+    config.code_cache_size = code_cache_size;
+    config.far_code_offset = code_cache_size / 32 * 25;
 
     // Safe optimizations
     if (Settings::values.cpu_debug_mode) {
@@ -210,7 +214,9 @@ std::shared_ptr<Dynarmic::A32::Jit> ARM_Dynarmic_32::MakeJit(Common::PageTable*
 
 void ARM_Dynarmic_32::Run() {
     while (true) {
+        const auto run_start = std::chrono::steady_clock::now();
         jit->Run();
+        RecordJitExit(std::chrono::steady_clock::now() - run_start, svc_called);
         if (!svc_called) {
             break;
         }
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cinttypes>
 #include <memory>
 #include <dynarmic/interface/A64/a64.h>
@@ -14,6 +15,7 @@
 #include "core/arm/cpu_interrupt_handler.h"
 #include "core/arm/dynarmic/arm_dynarmic_64.h"
 #include "core/arm/dynarmic/arm_exclusive_monitor.h"
+#include "core/arm/guest_hooks.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hardware_properties.h"
@@ -103,6 +105,11 @@ public:
     }
 
     void CallSVC(u32 swi) override {
+        if (GuestHooks::IsHook(swi)) {
+            // Host replacements of guest functions run without leaving the JIT
+            GuestHooks::Call(parent, memory, swi);
+            return;
+        }
         parent.svc_called = true;
         parent.svc_swi = swi;
         parent.jit->HaltExecution();
@@ -185,9 +192,12 @@ std::shared_ptr<Dynarmic::A64::Jit> ARM_Dynarmic_64::MakeJit(Common::PageTable*
     // Timing
     config.wall_clock_cntpct = uses_wall_clock;
 
-    // Code cache size
-    config.code_cache_size = 512_MiB;
-    config.far_code_offset = 400_MiB;
+    // Code cache size, far code takes the last part of it. Dynarmic flushes the whole cache when
+    // it fills, so titles with a lot of code can be given a bigger one.
+    const u32 code_cache_size =
+        std::clamp<u32>(Settings::values.cpu_code_cache_size.GetValue(), 64, 1536) * 1_MiB;
+    config.code_cache_size = code_cache_size;
+    config.far_code_offset = code_cache_size / 32 * 25;
 
     // Safe optimizations
     if (Settings::values.cpu_debug_mode) {
@@ -250,7 +260,9 @@ std::shared_ptr<Dynarmic::A64::Jit> ARM_Dynarmic_64::MakeJit(Common::PageTable*
 
 void ARM_Dynarmic_64::Run() {
     while (true) {
+        const auto run_start = std::chrono::steady_clock::now();
         jit->Run();
+        RecordJitExit(std::chrono::steady_clock::now() - run_start, svc_called);
         if (!svc_called) {
             break;
         }
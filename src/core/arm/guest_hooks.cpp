@@ -0,0 +1,214 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "common/common_funcs.h"
+#include "common/logging/log.h"
+#include "core/arm/arm_interface.h"
+#include "core/arm/guest_hooks.h"
+#include "core/memory.h"
+
+namespace Core::GuestHooks {
+namespace {
+
+constexpr u64 ELF_DYNAMIC_TAG_NULL = 0;
+constexpr u64 ELF_DYNAMIC_TAG_STRTAB = 5;
+constexpr u64 ELF_DYNAMIC_TAG_SYMTAB = 6;
+constexpr u64 ELF_DYNAMIC_TAG_SYMENT = 11;
+
+constexpr u8 ELF_SYMBOL_TYPE_FUNCTION = 2;
+
+struct ELFSymbol {
+    u32 name_index;
+    u8 info;
+    u8 visibility;
+    u16 sh_index;
+    u64 value;
+    u64 size;
+};
+static_assert(sizeof(ELFSymbol) == 0x18, "ELFSymbol has incorrect size.");
+
+constexpr std::array<std::pair<std::string_view, Hook>, NUM_HOOKS> HOOKED_SYMBOLS{{
+    {"memcpy", Hook::Memcpy},
+    {"memmove", Hook::Memmove},
+    {"memset", Hook::Memset},
+    {"strlen", Hook::Strlen},
+}};
+
+/// Instructions written over the entry point of a hooked function
+constexpr u32 PATCH_SIZE = 2 * sizeof(u32);
+
+constexpr u32 INSTRUCTION_RET = 0xD65F03C0U;
+
+constexpr u32 EncodeSvc(u32 immediate) {
+    return 0xD4000001U | (immediate << 5);
+}
+
+/// Size of the buffer used to fill guest memory with a non-zero value
+constexpr std::size_t FILL_CHUNK_SIZE = 0x1000;
+
+/// Size of the buffer strings are scanned through, strings are usually short
+constexpr std::size_t SCAN_CHUNK_SIZE = 0x100;
+
+template <typename T>
+std::optional<T> ReadObject(std::span<const u8> image, u64 offset) {
+    if (offset > image.size() || image.size() - offset < sizeof(T)) {
+        return std::nullopt;
+    }
+    T value;
+    std::memcpy(&value, image.data() + offset, sizeof(T));
+    return value;
+}
+
+std::string_view ReadString(std::span<const u8> image, u64 offset) {
+    if (offset >= image.size()) {
+        return {};
+    }
+    const auto begin = image.begin() + static_cast<std::ptrdiff_t>(offset);
+    const auto end = std::find(begin, image.end(), u8{0});
+    return std::string_view(reinterpret_cast<const char*>(&*begin),
+                            static_cast<std::size_t>(end - begin));
+}
+
+void Move(Memory::Memory& memory, VAddr dest_addr, VAddr src_addr, std::size_t size) {
+    if (size == 0 || dest_addr == src_addr) {
+        return;
+    }
+    if (dest_addr + size <= src_addr || src_addr + size <= dest_addr) {
+        memory.CopyBlock(dest_addr, src_addr, size);
+        return;
+    }
+    // Overlapping ranges go through a temporary copy, guests also call memcpy on them
+    std::vector<u8> buffer(size);
+    memory.ReadBlock(src_addr, buffer.data(), size);
+    memory.WriteBlock(dest_addr, buffer.data(), size);
+}
+
+void Fill(Memory::Memory& memory, VAddr dest_addr, u8 value, std::size_t size) {
+    if (value == 0) {
+        memory.ZeroBlock(dest_addr, size);
+        return;
+    }
+    std::array<u8, FILL_CHUNK_SIZE> chunk;
+    chunk.fill(value);
+    while (size > 0) {
+        const std::size_t copy_size = std::min(size, chunk.size());
+        memory.WriteBlock(dest_addr, chunk.data(), copy_size);
+        dest_addr += copy_size;
+        size -= copy_size;
+    }
+}
+
+std::size_t StringLength(Memory::Memory& memory, VAddr addr) {
+    std::array<u8, SCAN_CHUNK_SIZE> chunk;
+    std::size_t length = 0;
+    while (true) {
+        // Chunks never cross a page, so the scan doesn't read pages past the terminator
+        const VAddr chunk_addr = addr + length;
+        const std::size_t page_left = Memory::PAGE_SIZE - (chunk_addr & Memory::PAGE_MASK);
+        const std::size_t chunk_size = std::min(chunk.size(), page_left);
+        memory.ReadBlock(chunk_addr, chunk.data(), chunk_size);
+        const auto end = chunk.begin() + static_cast<std::ptrdiff_t>(chunk_size);
+        const auto terminator = std::find(chunk.begin(), end, u8{0});
+        length += static_cast<std::size_t>(terminator - chunk.begin());
+        if (terminator != end) {
+            return length;
+        }
+    }
+}
+
+} // Anonymous namespace
+
+std::size_t PatchModule(std::span<u8> image, std::size_t code_size) {
+    const std::optional<u32> mod_offset = ReadObject<u32>(image, 4);
+    if (!mod_offset || (*mod_offset & 0b11) != 0 ||
+        ReadObject<u32>(image, *mod_offset) != Common::MakeMagic('M', 'O', 'D', '0')) {
+        return 0;
+    }
+    const std::optional<u32> dynamic_offset = ReadObject<u32>(image, *mod_offset + 4);
+    if (!dynamic_offset) {
+        return 0;
+    }
+
+    u64 string_table_offset{};
+    u64 symbol_table_offset{};
+    u64 symbol_entry_size{};
+    for (u64 dynamic_index = u64{*mod_offset} + *dynamic_offset;; dynamic_index += 0x10) {
+        const std::optional<u64> tag = ReadObject<u64>(image, dynamic_index);
+        const std::optional<u64> value = ReadObject<u64>(image, dynamic_index + 8);
+        if (!tag || !value || *tag == ELF_DYNAMIC_TAG_NULL) {
+            break;
+        }
+        if (*tag == ELF_DYNAMIC_TAG_STRTAB) {
+            string_table_offset = *value;
+        } else if (*tag == ELF_DYNAMIC_TAG_SYMTAB) {
+            symbol_table_offset = *value;
+        } else if (*tag == ELF_DYNAMIC_TAG_SYMENT) {
+            symbol_entry_size = *value;
+        }
+    }
+    if (string_table_offset == 0 || symbol_table_offset == 0 ||
+        symbol_entry_size < sizeof(ELFSymbol)) {
+        return 0;
+    }
+
+    std::size_t num_patched = 0;
+    for (u64 offset = symbol_table_offset; offset < string_table_offset;
+         offset += symbol_entry_size) {
+        const std::optional<ELFSymbol> symbol = ReadObject<ELFSymbol>(image, offset);
+        if (!symbol) {
+            break;
+        }
+        // Only functions defined in this module, large enough to hold the patch
+        if ((symbol->info & 0xF) != ELF_SYMBOL_TYPE_FUNCTION || symbol->sh_index == 0 ||
+            symbol->size < PATCH_SIZE || (symbol->value & 0b11) != 0 ||
+            symbol->value + PATCH_SIZE > code_size) {
+            continue;
+        }
+        const std::string_view name =
+            ReadString(image, string_table_offset + symbol->name_index);
+        const auto it = std::ranges::find_if(
+            HOOKED_SYMBOLS, [name](const auto& hooked) { return hooked.first == name; });
+        if (it == HOOKED_SYMBOLS.end()) {
+            continue;
+        }
+        const std::array<u32, 2> patch{
+            EncodeSvc(HOOK_SVC_BASE + static_cast<u32>(it->second)),
+            INSTRUCTION_RET,
+        };
+        std::memcpy(image.data() + symbol->value, patch.data(), PATCH_SIZE);
+        LOG_DEBUG(Core_ARM, "Replaced {} at module offset 0x{:X} with a host implementation", name,
+                  symbol->value);
+        ++num_patched;
+    }
+    return num_patched;
+}
+
+void Call(ARM_Interface& arm, Memory::Memory& memory, u32 swi) {
+    // Memory functions return their destination, which is already in X0
+    const VAddr dest_addr = arm.GetReg(0);
+    const u64 argument = arm.GetReg(1);
+    const std::size_t size = arm.GetReg(2);
+    switch (static_cast<Hook>(swi - HOOK_SVC_BASE)) {
+    case Hook::Memcpy:
+    case Hook::Memmove:
+        Move(memory, dest_addr, argument, size);
+        break;
+    case Hook::Memset:
+        Fill(memory, dest_addr, static_cast<u8>(argument), size);
+        break;
+    case Hook::Strlen:
+        arm.SetReg(0, StringLength(memory, dest_addr));
+        break;
+    }
+}
+
+} // namespace Core::GuestHooks
@@ -0,0 +1,52 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include "common/common_types.h"
+
+namespace Core {
+class ARM_Interface;
+}
+
+namespace Core::Memory {
+class Memory;
+}
+
+namespace Core::GuestHooks {
+
+/// First supervisor call number used by hooks, above the range of the kernel
+constexpr u32 HOOK_SVC_BASE = 0x8000;
+
+/// Guest functions replaced with host implementations
+enum class Hook : u32 {
+    Memcpy,
+    Memmove,
+    Memset,
+    Strlen,
+};
+
+constexpr std::size_t NUM_HOOKS = 4;
+
+/**
+ * Replaces the entry points of the guest functions exported by a 64-bit module image with a
+ * supervisor call to their host implementation, followed by a return.
+ * @param image      Image of the module, as it will be loaded in guest memory.
+ * @param code_size  Size of the code segment at the beginning of the image.
+ * @returns Number of functions replaced.
+ */
+std::size_t PatchModule(std::span<u8> image, std::size_t code_size);
+
+/// Returns true when a supervisor call number belongs to a hook
+[[nodiscard]] constexpr bool IsHook(u32 swi) noexcept {
+    return swi >= HOOK_SVC_BASE && swi < HOOK_SVC_BASE + NUM_HOOKS;
+}
+
+/// Runs the host implementation of a hook with the arguments in the guest registers
+void Call(ARM_Interface& arm, Memory::Memory& memory, u32 swi);
+
+} // namespace Core::GuestHooks
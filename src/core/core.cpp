@@ -7,12 +7,15 @@
 #include <memory>
 #include <utility>
 
+#include "audio_core/sink_stats.h"
 #include "common/fs/fs.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
 #include "common/settings.h"
 #include "common/string_util.h"
 #include "core/arm/exclusive_monitor.h"
+#include "core/crypto/ctr_encryption_layer.h"
+#include "core/crypto/key_manager.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/cpu_manager.h"
@@ -39,6 +42,7 @@
 #include "core/hle/service/filesystem/filesystem.h"
 #include "core/hle/service/glue/glue_manager.h"
 #include "core/hle/service/hid/hid.h"
+#include "core/hle/service/ipc_profiler.h"
 #include "core/hle/service/service.h"
 #include "core/hle/service/sm/sm.h"
 #include "core/hle/service/time/time_manager.h"
@@ -46,10 +50,13 @@
 #include "core/memory.h"
 #include "core/memory/cheat_engine.h"
 #include "core/network/network.h"
+#include "core/perf_profile.h"
 #include "core/perf_stats.h"
 #include "core/reporter.h"
+#include "core/startup_timeline.h"
 #include "core/telemetry_session.h"
 #include "core/tools/freezer.h"
+#include "video_core/rasterizer_interface.h"
 #include "video_core/renderer_base.h"
 #include "video_core/video_core.h"
 
@@ -190,13 +197,17 @@ struct System::Impl {
 
         telemetry_session = std::make_unique<Core::TelemetrySession>();
 
+        startup_timeline.BeginPhase("renderer");
         gpu_core = VideoCore::CreateGPU(emu_window, system);
+        startup_timeline.EndPhase();
         if (!gpu_core) {
             return ResultStatus::ErrorVideoCore;
         }
 
+        startup_timeline.BeginPhase("services");
         service_manager = std::make_shared<Service::SM::ServiceManager>(kernel);
         services = std::make_unique<Service::Services>(service_manager, system);
+        startup_timeline.EndPhase();
         interrupt_manager = std::make_unique<Hardware::InterruptManager>(system);
 
         // Initialize time manager, which must happen after kernel is created
@@ -217,15 +228,36 @@ struct System::Impl {
 
     ResultStatus Load(System& system, Frontend::EmuWindow& emu_window, const std::string& filepath,
                       std::size_t program_index) {
-        app_loader = Loader::GetLoader(system, GetGameFileFromPath(virtual_filesystem, filepath),
-                                       program_index);
+        startup_timeline.Reset();
+        ScopedStartupPhase load_phase{startup_timeline, "load"};
+
+        startup_timeline.BeginPhase("filesystem");
+        FileSys::VirtualFile game_file = GetGameFileFromPath(virtual_filesystem, filepath);
+        startup_timeline.EndPhase();
+
+        // Keys are loaded on first use, do it here so NCA parsing doesn't account for it
+        startup_timeline.BeginPhase("crypto");
+        void(Core::Crypto::KeyManager::Instance());
+        startup_timeline.EndPhase();
+
+        startup_timeline.BeginPhase("loader");
+        app_loader = Loader::GetLoader(system, std::move(game_file), program_index);
+        startup_timeline.EndPhase();
 
         if (!app_loader) {
             LOG_CRITICAL(Core, "Failed to obtain loader for {}!", filepath);
             return ResultStatus::ErrorGetLoader;
         }
 
+        // Tuned settings have to be in effect before the emulated hardware is initialized
+        if (u64 profile_title_id{};
+            app_loader->ReadProgramId(profile_title_id) == Loader::ResultStatus::Success) {
+            perf_profile.Begin(profile_title_id);
+        }
+
+        startup_timeline.BeginPhase("init");
         ResultStatus init_result{Init(system, emu_window)};
+        startup_timeline.EndPhase();
         if (init_result != ResultStatus::Success) {
             LOG_CRITICAL(Core, "Failed to initialize system (Error {})!",
                          static_cast<int>(init_result));
@@ -239,7 +271,9 @@ struct System::Impl {
                                             Kernel::KProcess::ProcessType::Userland)
                    .IsSuccess());
         main_process->Open();
+        startup_timeline.BeginPhase("process");
         const auto [load_result, load_parameters] = app_loader->Load(*main_process, system);
+        startup_timeline.EndPhase();
         if (load_result != Loader::ResultStatus::Success) {
             LOG_CRITICAL(Core, "Failed to load ROM (Error {})!", load_result);
             Shutdown();
@@ -248,8 +282,10 @@ struct System::Impl {
                                              static_cast<u32>(load_result));
         }
         AddGlueRegistrationForProcess(*app_loader, *main_process);
+        startup_timeline.BeginPhase("jit");
         kernel.MakeCurrentProcess(main_process);
         kernel.InitializeCores();
+        startup_timeline.EndPhase();
 
         // Initialize cheat engine
         if (cheat_engine) {
@@ -296,8 +332,63 @@ struct System::Impl {
                                         perf_results.frametime * 1000.0);
             telemetry_session->AddField(performance, "Mean_Frametime_MS",
                                         perf_stats->GetMeanFrametime());
+            const auto& lateness = perf_results.event_lateness;
+            LOG_DEBUG(Core,
+                      "Core timing event lateness <=10us: {}, <=50us: {}, <=200us: {}, <=1ms: {}, "
+                      "<=5ms: {}, more: {}",
+                      lateness[0], lateness[1], lateness[2], lateness[3], lateness[4], lateness[5]);
+            LOG_DEBUG(Core, "Audio output: {} underruns, {} ms max queue, {} samples dropped",
+                      perf_results.audio_underruns, perf_results.audio_queue_depth_ms,
+                      perf_results.audio_dropped_samples);
+            LOG_DEBUG(Core, "Guest physical memory committed: {} MiB",
+                      perf_results.committed_memory >> 20);
+            LOG_DEBUG(Core, "Startup to first frame: {:.2f} ms", perf_results.startup_time_ms);
+            LOG_DEBUG(Core, "GPU buffer joins: {}, {} KiB copied", perf_results.buffer_joins,
+                      perf_results.buffer_join_bytes >> 10);
+            LOG_DEBUG(Core, "Host GPU idle: {:.1f}%", perf_results.gpu_idle * 100.0);
+            const auto& causes = perf_results.stutter_causes;
+            LOG_DEBUG(Core,
+                      "Frame time p50 {:.2f} ms, p95 {:.2f} ms, p99 {:.2f} ms, {} stutters "
+                      "({} shader compile, {} texture decode, {} GPU flush)",
+                      perf_results.frametime_p50 * 1000.0, perf_results.frametime_p95 * 1000.0,
+                      perf_results.frametime_p99 * 1000.0, perf_results.stutters, causes[0],
+                      causes[1], causes[2]);
+            for (std::size_t core = 0; core < perf_results.cores.size(); ++core) {
+                const auto& stats = perf_results.cores[core];
+                LOG_DEBUG(Core,
+                          "CPU core {}: busy {:.2f}, idle {:.2f}, {} SVC exits, {} halts, {} wakes "
+                          "({:.1f} us average, {:.1f} us max)",
+                          core, stats.busy, stats.idle, stats.svc_exits, stats.halt_exits,
+                          stats.wakes, stats.average_wake_latency_us, stats.max_wake_latency_us);
+            }
+            if (ipc_profiler.IsEnabled()) {
+                // Services that cost the most host time first
+                constexpr std::size_t NUM_LOGGED_COMMANDS = 16;
+                const auto commands = ipc_profiler.Commands();
+                for (std::size_t i = 0; i < std::min(commands.size(), NUM_LOGGED_COMMANDS); ++i) {
+                    const auto& stats = commands[i];
+                    LOG_DEBUG(Core, "IPC {} {} ({}): {} calls, {} us total, {} us max",
+                              stats.service, stats.command, stats.name, stats.calls,
+                              std::chrono::duration_cast<std::chrono::microseconds>(
+                                  stats.total_time)
+                                  .count(),
+                              std::chrono::duration_cast<std::chrono::microseconds>(stats.max_time)
+                                  .count());
+                }
+            }
+            for (std::size_t svc = 0; svc < perf_results.svcs.size(); ++svc) {
+                const auto& stats = perf_results.svcs[svc];
+                if (stats.calls != 0) {
+                    LOG_DEBUG(Core, "SVC 0x{:02X}: {} calls, {} us", svc, stats.calls,
+                              std::chrono::duration_cast<std::chrono::microseconds>(stats.time)
+                                  .count());
+                }
+            }
         }
 
+        perf_profile.End(perf_stats ? perf_stats->GetMeanFrametime() : 0.0,
+                         perf_stats ? perf_stats->GetFrametimeCount() : 0);
+
         is_powered_on = false;
         exit_lock = false;
 
@@ -361,7 +452,49 @@ struct System::Impl {
     }
 
     PerfStatsResults GetAndResetPerfStats() {
-        return perf_stats->GetAndResetStats(core_timing.GetGlobalTimeUs());
+        std::array<CoreActivity, Hardware::NUM_CPU_CORES> core_activity{};
+        for (std::size_t core = 0; core < core_activity.size(); ++core) {
+            auto& physical_core = kernel.PhysicalCore(core);
+            const auto execution = physical_core.ArmInterface().GetAndResetExecutionStats();
+            const auto wake = physical_core.GetAndResetWakeStats();
+            core_activity[core] = {
+                .busy_time = execution.jit_time,
+                .idle_time = physical_core.GetAndResetIdleTime(),
+                .svc_exits = execution.svc_exits,
+                .halt_exits = execution.halt_exits,
+                .wakes = wake.wakes,
+                .wake_latency = wake.total_latency,
+                .max_wake_latency = wake.max_latency,
+            };
+        }
+        PerfStatsResults results =
+            perf_stats->GetAndResetStats(core_timing.GetGlobalTimeUs(), core_activity);
+        results.event_lateness = core_timing.GetAndResetEventLateness();
+        results.svcs = kernel.GetAndResetSvcStats();
+        const AudioCore::SinkStats sink_stats = AudioCore::GetAndResetSinkStats();
+        results.audio_underruns = sink_stats.underruns;
+        results.audio_queue_depth_ms = sink_stats.max_queue_depth_ms;
+        results.audio_dropped_samples = sink_stats.dropped_samples;
+        results.committed_memory = device_memory->GetCommittedSize();
+        return results;
+    }
+
+    MemoryUsage GetMemoryUsage() const {
+        MemoryUsage usage{
+            .guest_memory = device_memory ? device_memory->GetCommittedSize() : 0,
+            .texture_cache = 0,
+            .buffer_cache = 0,
+            .staging_buffers = 0,
+            .file_cache = Crypto::CTREncryptionLayer::GetCachedBytes(),
+        };
+        if (gpu_core) {
+            const VideoCore::RasterizerMemoryUsage gpu_usage =
+                gpu_core->Renderer().ReadRasterizer()->GetMemoryUsage();
+            usage.texture_cache = gpu_usage.texture_cache;
+            usage.buffer_cache = gpu_usage.buffer_cache;
+            usage.staging_buffers = gpu_usage.staging_buffers;
+        }
+        return usage;
     }
 
     Timing::CoreTiming core_timing;
@@ -412,6 +545,9 @@ struct System::Impl {
     std::string status_details = "";
 
     std::unique_ptr<Core::PerfStats> perf_stats;
+    Core::PerfProfile perf_profile;
+    Core::StartupTimeline startup_timeline;
+    Service::IPCProfiler ipc_profiler;
     Core::FrameLimiter frame_limiter;
 
     bool is_multicore{};
@@ -479,6 +615,10 @@ PerfStatsResults System::GetAndResetPerfStats() {
     return impl->GetAndResetPerfStats();
 }
 
+MemoryUsage System::GetMemoryUsage() const {
+    return impl->GetMemoryUsage();
+}
+
 TelemetrySession& System::TelemetrySession() {
     return *impl->telemetry_session;
 }
@@ -607,6 +747,22 @@ const Core::PerfStats& System::GetPerfStats() const {
     return *impl->perf_stats;
 }
 
+Core::StartupTimeline& System::GetStartupTimeline() {
+    return impl->startup_timeline;
+}
+
+const Core::StartupTimeline& System::GetStartupTimeline() const {
+    return impl->startup_timeline;
+}
+
+Service::IPCProfiler& System::GetIPCProfiler() {
+    return impl->ipc_profiler;
+}
+
+const Service::IPCProfiler& System::GetIPCProfiler() const {
+    return impl->ipc_profiler;
+}
+
 Core::FrameLimiter& System::FrameLimiter() {
     return impl->frame_limiter;
 }
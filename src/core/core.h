@@ -44,6 +44,8 @@ class Memory;
 
 namespace Service {
 
+class IPCProfiler;
+
 namespace AM::Applets {
 struct AppletFrontendSet;
 class AppletManager;
@@ -97,8 +99,10 @@ class ExclusiveMonitor;
 class FrameLimiter;
 class PerfStats;
 class Reporter;
+class StartupTimeline;
 class TelemetrySession;
 
+struct MemoryUsage;
 struct PerfStatsResults;
 
 FileSys::VirtualFile GetGameFileFromPath(const FileSys::VirtualFilesystem& vfs,
@@ -199,6 +203,9 @@ public:
     /// Gets and resets core performance statistics
     [[nodiscard]] PerfStatsResults GetAndResetPerfStats();
 
+    /// Gets the host memory currently held by each subsystem, can be called from any thread
+    [[nodiscard]] MemoryUsage GetMemoryUsage() const;
+
     /// Gets an ARM interface to the CPU core that is currently running
     [[nodiscard]] ARM_Interface& CurrentArmInterface();
 
@@ -292,6 +299,18 @@ public:
     /// Provides a constant reference to the internal PerfStats instance.
     [[nodiscard]] const Core::PerfStats& GetPerfStats() const;
 
+    /// Provides a reference to the timeline of the current boot.
+    [[nodiscard]] Core::StartupTimeline& GetStartupTimeline();
+
+    /// Provides a constant reference to the timeline of the current boot.
+    [[nodiscard]] const Core::StartupTimeline& GetStartupTimeline() const;
+
+    /// Provides a reference to the HLE service command profiler.
+    [[nodiscard]] Service::IPCProfiler& GetIPCProfiler();
+
+    /// Provides a constant reference to the HLE service command profiler.
+    [[nodiscard]] const Service::IPCProfiler& GetIPCProfiler() const;
+
     /// Provides a reference to the frame limiter;
     [[nodiscard]] Core::FrameLimiter& FrameLimiter();
 
@@ -8,6 +8,8 @@
 #include <tuple>
 
 #include "common/microprofile.h"
+#include "common/settings.h"
+#include "common/thread_placement.h"
 #include "core/core_timing.h"
 #include "core/core_timing_util.h"
 #include "core/hardware_properties.h"
@@ -16,6 +18,10 @@ namespace Core::Timing {
 
 constexpr s64 MAX_SLICE_LENGTH = 4000;
 
+/// Time before a deadline the precise timing thread stops sleeping and starts spinning. OS timers
+/// commonly overshoot by up to a millisecond, so the sleep aims short of the deadline.
+constexpr std::chrono::nanoseconds PRECISE_SPIN_THRESHOLD{std::chrono::microseconds{200}};
+
 std::shared_ptr<EventType> CreateEvent(std::string name, TimedCallback&& callback) {
     return std::make_shared<EventType>(std::move(callback), std::move(name));
 }
@@ -25,6 +31,8 @@ struct CoreTiming::Event {
     u64 fifo_order;
     std::uintptr_t user_data;
     std::weak_ptr<EventType> type;
+    /// Identity of the event type, compared when unscheduling without locking the weak pointer
+    const EventType* type_id;
 
     // Sort by time, unless the times are the same, in which case sort by
     // the order added to the queue
@@ -47,6 +55,7 @@ void CoreTiming::ThreadEntry(CoreTiming& instance) {
     MicroProfileOnThreadCreate(name);
     Common::SetCurrentThreadName(name);
     Common::SetCurrentThreadPriority(Common::ThreadPriority::VeryHigh);
+    Common::PlaceCurrentThread(Common::PlacedThread::CoreTiming);
     instance.on_thread_init();
     instance.ThreadLoop();
     MicroProfileOnThreadExit();
@@ -57,6 +66,7 @@ void CoreTiming::Initialize(std::function<void()>&& on_thread_init_) {
     event_fifo_id = 0;
     shutting_down = false;
     ticks = 0;
+    precise_timing = Settings::values.precise_core_timing.GetValue();
     const auto empty_timed_callback = [](std::uintptr_t, std::chrono::nanoseconds) {};
     ev_lost = CreateEvent("_lost_event", empty_timed_callback);
     if (is_multicore) {
@@ -112,9 +122,11 @@ void CoreTiming::ScheduleEvent(std::chrono::nanoseconds ns_into_future,
         std::scoped_lock scope{basic_lock};
         const u64 timeout = static_cast<u64>((GetGlobalTimeNs() + ns_into_future).count());
 
-        event_queue.emplace_back(Event{timeout, event_fifo_id++, user_data, event_type});
+        event_queue.emplace_back(
+            Event{timeout, event_fifo_id++, user_data, event_type, event_type.get()});
 
         std::push_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+        UpdateNextEventTime();
     }
     event.Set();
 }
@@ -122,15 +134,69 @@ void CoreTiming::ScheduleEvent(std::chrono::nanoseconds ns_into_future,
 void CoreTiming::UnscheduleEvent(const std::shared_ptr<EventType>& event_type,
                                  std::uintptr_t user_data) {
     std::scoped_lock scope{basic_lock};
-    const auto itr = std::remove_if(event_queue.begin(), event_queue.end(), [&](const Event& e) {
-        return e.type.lock().get() == event_type.get() && e.user_data == user_data;
+    EraseEvents([type_id = event_type.get(), user_data](const Event& e) {
+        return e.type_id == type_id && e.user_data == user_data;
     });
+}
 
-    // Removing random items breaks the invariant so we have to re-establish it.
-    if (itr != event_queue.end()) {
-        event_queue.erase(itr, event_queue.end());
-        std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+template <typename Predicate>
+void CoreTiming::EraseEvents(Predicate&& pred) {
+    // Each erased event is replaced by the last one, which is then sifted into place. This keeps
+    // the heap valid without rebuilding it.
+    const auto sift_up = [this](std::size_t index) {
+        while (index > 0) {
+            const std::size_t parent = (index - 1) / 2;
+            if (!(event_queue[parent] > event_queue[index])) {
+                return;
+            }
+            std::swap(event_queue[parent], event_queue[index]);
+            index = parent;
+        }
+    };
+    const auto sift_down = [this](std::size_t index) {
+        const std::size_t size = event_queue.size();
+        while (true) {
+            const std::size_t left = index * 2 + 1;
+            if (left >= size) {
+                return;
+            }
+            const std::size_t right = left + 1;
+            const std::size_t child =
+                right < size && event_queue[left] > event_queue[right] ? right : left;
+            if (!(event_queue[index] > event_queue[child])) {
+                return;
+            }
+            std::swap(event_queue[index], event_queue[child]);
+            index = child;
+        }
+    };
+    std::size_t index = 0;
+    while (index < event_queue.size()) {
+        if (!pred(event_queue[index])) {
+            ++index;
+            continue;
+        }
+        // Drop trailing matches first so the event moved into this slot is known to be kept.
+        while (!event_queue.empty() && pred(event_queue.back())) {
+            event_queue.pop_back();
+        }
+        if (index >= event_queue.size()) {
+            break;
+        }
+        event_queue[index] = std::move(event_queue.back());
+        event_queue.pop_back();
+        if (index < event_queue.size()) {
+            sift_up(index);
+            sift_down(index);
+        }
+        // The slot is checked again, as sifting may have moved an unchecked event into it.
     }
+    UpdateNextEventTime();
+}
+
+void CoreTiming::UpdateNextEventTime() {
+    next_event_time.store(event_queue.empty() ? NO_EVENT : event_queue.front().time,
+                          std::memory_order_release);
 }
 
 void CoreTiming::AddTicks(u64 ticks_to_add) {
@@ -140,8 +206,8 @@ void CoreTiming::AddTicks(u64 ticks_to_add) {
 
 void CoreTiming::Idle() {
     if (!event_queue.empty()) {
-        const u64 next_event_time = event_queue.front().time;
-        const u64 next_ticks = nsToCycles(std::chrono::nanoseconds(next_event_time)) + 10U;
+        const u64 front_time = event_queue.front().time;
+        const u64 next_ticks = nsToCycles(std::chrono::nanoseconds(front_time)) + 10U;
         if (next_ticks > ticks) {
             ticks = next_ticks;
         }
@@ -151,7 +217,11 @@ void CoreTiming::Idle() {
 }
 
 void CoreTiming::ResetTicks() {
-    downcount = MAX_SLICE_LENGTH;
+    ResetTicks(MAX_SLICE_LENGTH);
+}
+
+void CoreTiming::ResetTicks(s64 slice_length) {
+    downcount = slice_length;
 }
 
 u64 CoreTiming::GetCPUTicks() const {
@@ -170,23 +240,26 @@ u64 CoreTiming::GetClockTicks() const {
 
 void CoreTiming::ClearPendingEvents() {
     event_queue.clear();
+    UpdateNextEventTime();
 }
 
 void CoreTiming::RemoveEvent(const std::shared_ptr<EventType>& event_type) {
     std::scoped_lock lock{basic_lock};
-
-    const auto itr = std::remove_if(event_queue.begin(), event_queue.end(), [&](const Event& e) {
-        return e.type.lock().get() == event_type.get();
-    });
-
-    // Removing random items breaks the invariant so we have to re-establish it.
-    if (itr != event_queue.end()) {
-        event_queue.erase(itr, event_queue.end());
-        std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>());
-    }
+    EraseEvents([type_id = event_type.get()](const Event& e) { return e.type_id == type_id; });
 }
 
 std::optional<s64> CoreTiming::Advance() {
+    // Most wakeups happen before anything is due, so check the cached deadline before locking.
+    // An event scheduled concurrently signals the timing thread, so a stale value is harmless.
+    const u64 cached_next_time = next_event_time.load(std::memory_order_acquire);
+    if (cached_next_time == NO_EVENT) {
+        return std::nullopt;
+    }
+    const u64 current_time = static_cast<u64>(GetGlobalTimeNs().count());
+    if (cached_next_time > current_time) {
+        return static_cast<s64>(cached_next_time - current_time);
+    }
+
     std::scoped_lock lock{advance_lock, basic_lock};
     global_timer = GetGlobalTimeNs().count();
 
@@ -194,11 +267,13 @@ std::optional<s64> CoreTiming::Advance() {
         Event evt = std::move(event_queue.front());
         std::pop_heap(event_queue.begin(), event_queue.end(), std::greater<>());
         event_queue.pop_back();
+        UpdateNextEventTime();
         basic_lock.unlock();
 
+        const s64 lateness = static_cast<s64>(global_timer - evt.time);
+        RecordEventLateness(lateness);
         if (const auto event_type{evt.type.lock()}) {
-            event_type->callback(
-                evt.user_data, std::chrono::nanoseconds{static_cast<s64>(global_timer - evt.time)});
+            event_type->callback(evt.user_data, std::chrono::nanoseconds{lateness});
         }
 
         basic_lock.lock();
@@ -221,8 +296,7 @@ void CoreTiming::ThreadLoop() {
             const auto next_time = Advance();
             if (next_time) {
                 if (*next_time > 0) {
-                    std::chrono::nanoseconds next_time_ns = std::chrono::nanoseconds(*next_time);
-                    event.WaitFor(next_time_ns);
+                    WaitForNextEvent(std::chrono::nanoseconds(*next_time));
                 }
             } else {
                 wait_set = true;
@@ -237,6 +311,39 @@ void CoreTiming::ThreadLoop() {
     }
 }
 
+void CoreTiming::WaitForNextEvent(std::chrono::nanoseconds wait_time) {
+    if (!precise_timing) {
+        event.WaitFor(wait_time);
+        return;
+    }
+    if (wait_time > PRECISE_SPIN_THRESHOLD) {
+        // Wake up early and let the next iteration spin for the remainder. Returns early as well
+        // when a new event is scheduled.
+        event.WaitFor(wait_time - PRECISE_SPIN_THRESHOLD);
+        return;
+    }
+    const auto deadline = clock->GetTimeNS() + wait_time;
+    while (clock->GetTimeNS() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+void CoreTiming::RecordEventLateness(s64 lateness_ns) {
+    const u64 lateness_us = static_cast<u64>(std::max<s64>(lateness_ns, 0)) / 1000;
+    const auto bucket = std::ranges::find_if(
+        EVENT_LATENESS_BOUNDS_US, [lateness_us](u32 bound) { return lateness_us <= bound; });
+    const auto index = static_cast<std::size_t>(bucket - EVENT_LATENESS_BOUNDS_US.begin());
+    event_lateness[index].fetch_add(1, std::memory_order_relaxed);
+}
+
+EventLatenessHistogram CoreTiming::GetAndResetEventLateness() {
+    EventLatenessHistogram histogram{};
+    for (std::size_t i = 0; i < histogram.size(); ++i) {
+        histogram[i] = event_lateness[i].exchange(0, std::memory_order_relaxed);
+    }
+    return histogram;
+}
+
 std::chrono::nanoseconds CoreTiming::GetGlobalTimeNs() const {
     if (is_multicore) {
         return clock->GetTimeNS();
@@ -4,9 +4,11 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -18,6 +20,7 @@
 #include "common/spin_lock.h"
 #include "common/thread.h"
 #include "common/wall_clock.h"
+#include "core/perf_stats.h"
 
 namespace Core::Timing {
 
@@ -106,6 +109,9 @@ public:
 
     void ResetTicks();
 
+    /// Starts a new time slice lasting the given number of CPU cycles
+    void ResetTicks(s64 slice_length);
+
     void Idle();
 
     s64 GetDowncount() const {
@@ -127,15 +133,33 @@ public:
     /// Checks for events manually and returns time in nanoseconds for next event, threadsafe.
     std::optional<s64> Advance();
 
+    /// Returns how late events fired since the last call and clears the histogram, threadsafe.
+    EventLatenessHistogram GetAndResetEventLateness();
+
 private:
     struct Event;
 
     /// Clear all pending events. This should ONLY be done on exit.
     void ClearPendingEvents();
 
+    /// Erases every queued event matching the predicate while keeping the heap invariant.
+    /// basic_lock must be held.
+    template <typename Predicate>
+    void EraseEvents(Predicate&& pred);
+
+    /// Publishes the deadline of the earliest queued event. basic_lock must be held.
+    void UpdateNextEventTime();
+
     static void ThreadEntry(CoreTiming& instance);
     void ThreadLoop();
 
+    /// Waits for the given time on the timing thread, spinning for the end of the wait when
+    /// precise timing is enabled.
+    void WaitForNextEvent(std::chrono::nanoseconds wait_time);
+
+    /// Counts an event that fired the given number of nanoseconds after its deadline.
+    void RecordEventLateness(s64 lateness_ns);
+
     std::unique_ptr<Common::WallClock> clock;
 
     u64 global_timer = 0;
@@ -143,10 +167,17 @@ private:
     // The queue is a min-heap using std::make_heap/push_heap/pop_heap.
     // We don't use std::priority_queue because we need to be able to serialize, unserialize and
     // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't
-    // accomodated by the standard adaptor class.
+    // accomodated by the standard adaptor class. Erased events are replaced in place, so removal
+    // does not need to rebuild the heap.
     std::vector<Event> event_queue;
     u64 event_fifo_id = 0;
 
+    static constexpr u64 NO_EVENT = std::numeric_limits<u64>::max();
+    /// Time of the earliest queued event, readable without taking basic_lock.
+    std::atomic<u64> next_event_time{NO_EVENT};
+
+    std::array<std::atomic<u32>, std::tuple_size_v<EventLatenessHistogram>> event_lateness{};
+
     std::shared_ptr<EventType> ev_lost;
     Common::Event event{};
     Common::Event pause_event{};
@@ -161,6 +192,7 @@ private:
     std::function<void()> on_thread_init{};
 
     bool is_multicore{};
+    bool precise_timing{};
 
     /// Cycle timing
     u64 ticks{};
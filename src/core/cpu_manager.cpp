@@ -2,10 +2,13 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+
 #include "common/fiber.h"
 #include "common/microprofile.h"
 #include "common/scope_exit.h"
 #include "common/thread.h"
+#include "common/thread_placement.h"
 #include "core/arm/exclusive_monitor.h"
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -18,7 +21,9 @@
 
 namespace Core {
 
-CpuManager::CpuManager(System& system_) : system{system_} {}
+CpuManager::CpuManager(System& system_) : system{system_} {
+    slice_lengths.fill(default_slice_length);
+}
 CpuManager::~CpuManager() = default;
 
 void CpuManager::ThreadStart(CpuManager& cpu_manager, std::size_t core) {
@@ -257,6 +262,8 @@ void CpuManager::PreemptSingleCore(bool from_running_enviroment) {
         auto& kernel = system.Kernel();
         auto& scheduler = kernel.Scheduler(current_core);
         Kernel::KThread* current_thread = scheduler.GetCurrentThread();
+        UpdateSliceLength(current_core, !from_running_enviroment || scheduler.IsIdle(),
+                          system.CoreTiming().GetDowncount() <= 0);
         if (idle_count >= 4 || from_running_enviroment) {
             if (!from_running_enviroment) {
                 system.CoreTiming().Idle();
@@ -267,7 +274,7 @@ void CpuManager::PreemptSingleCore(bool from_running_enviroment) {
             kernel.SetIsPhantomModeForSingleCore(false);
         }
         current_core.store((current_core + 1) % Core::Hardware::NUM_CPU_CORES);
-        system.CoreTiming().ResetTicks();
+        system.CoreTiming().ResetTicks(slice_lengths[current_core]);
         scheduler.Unload(scheduler.GetCurrentThread());
 
         auto& next_scheduler = kernel.Scheduler(current_core);
@@ -284,6 +291,20 @@ void CpuManager::PreemptSingleCore(bool from_running_enviroment) {
     }
 }
 
+void CpuManager::UpdateSliceLength(std::size_t core, bool was_idle, bool used_whole_slice) {
+    s64& slice_length = slice_lengths[core];
+    if (was_idle) {
+        // Idle cores only wait for interrupts, give the host time to the others
+        slice_length = min_slice_length;
+    } else if (used_whole_slice) {
+        // Compute bound, switching away less often saves the context switches
+        slice_length = std::min(slice_length * 2, max_slice_length);
+    } else {
+        // The core gave its slice back early, it is likely spinning on a yield or a wait
+        slice_length = std::max(slice_length / 2, min_slice_length);
+    }
+}
+
 void CpuManager::SingleCorePause(bool paused) {
     if (!paused) {
         bool all_not_barrier = false;
@@ -329,6 +350,7 @@ void CpuManager::RunThread(std::size_t core) {
     MicroProfileOnThreadCreate(name.c_str());
     Common::SetCurrentThreadName(name.c_str());
     Common::SetCurrentThreadPriority(Common::ThreadPriority::High);
+    Common::PlaceCurrentThread(Common::CpuCoreThread(core));
     auto& data = core_data[core];
     data.enter_barrier = std::make_unique<Common::Event>();
     data.exit_barrier = std::make_unique<Common::Event>();
@@ -10,6 +10,7 @@
 #include <memory>
 #include <thread>
 
+#include "common/common_types.h"
 #include "common/fiber.h"
 #include "common/thread.h"
 #include "core/hardware_properties.h"
@@ -78,6 +79,9 @@ private:
     void SingleCoreRunSuspendThread();
     void SingleCorePause(bool paused);
 
+    /// Adapts the time slice of a core in single-core mode to how it used its last one
+    void UpdateSliceLength(std::size_t core, bool was_idle, bool used_whole_slice);
+
     static void ThreadStart(CpuManager& cpu_manager, std::size_t core);
 
     void RunThread(std::size_t core);
@@ -103,6 +107,12 @@ private:
     std::size_t idle_count{};
     static constexpr std::size_t max_cycle_runs = 5;
 
+    /// Bounds of the single-core time slices, in CPU cycles
+    static constexpr s64 min_slice_length = 1000;
+    static constexpr s64 default_slice_length = 4000;
+    static constexpr s64 max_slice_length = 16000;
+    std::array<s64, Core::Hardware::NUM_CPU_CORES> slice_lengths{};
+
     System& system;
 };
 
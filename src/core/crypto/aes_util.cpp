@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <array>
+#include <cstring>
 #include <mbedtls/cipher.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
@@ -73,7 +74,26 @@ void AESCipher<Key, KeySize>::Transcode(const u8* src, std::size_t size, u8* des
     mbedtls_cipher_reset(context);
 
     std::size_t written = 0;
-    if (mbedtls_cipher_get_cipher_mode(context) == MBEDTLS_MODE_XTS) {
+    const auto mode = mbedtls_cipher_get_cipher_mode(context);
+    if (mode == MBEDTLS_MODE_CTR) {
+        // CTR is a stream mode, the whole buffer can be processed at once. mbedtls refuses to
+        // process a partial last block in place, so that one goes through a temporary block.
+        const std::size_t tail_size = src == dest ? size % 0x10 : 0;
+        const std::size_t head_size = size - tail_size;
+        mbedtls_cipher_update(context, src, head_size, dest, &written);
+        if (tail_size != 0 && written == head_size) {
+            std::array<u8, 0x10> block{};
+            std::memcpy(block.data(), src + head_size, tail_size);
+            std::size_t tail_written = 0;
+            mbedtls_cipher_update(context, block.data(), tail_size, dest + head_size,
+                                  &tail_written);
+            written += tail_written;
+        }
+        if (written != size) {
+            LOG_WARNING(Crypto, "Not all data was decrypted requested={:016X}, actual={:016X}.",
+                        size, written);
+        }
+    } else if (mode == MBEDTLS_MODE_XTS) {
         mbedtls_cipher_update(context, src, size, dest, &written);
         if (written != size) {
             LOG_WARNING(Crypto, "Not all data was decrypted requested={:016X}, actual={:016X}.",
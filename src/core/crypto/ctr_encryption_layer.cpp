@@ -3,44 +3,176 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 #include "common/assert.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
 #include "core/crypto/ctr_encryption_layer.h"
 
 namespace Core::Crypto {
+namespace {
+/// Decrypted bytes held by the caches of every layer alive
+std::atomic<u64> total_cached_bytes{0};
+} // Anonymous namespace
 
 CTREncryptionLayer::CTREncryptionLayer(FileSys::VirtualFile base_, Key128 key_,
                                        std::size_t base_offset_)
-    : EncryptionLayer(std::move(base_)), base_offset(base_offset_), cipher(key_, Mode::CTR) {}
+    : EncryptionLayer(std::move(base_)), base_offset(base_offset_), cipher(key_, Mode::CTR),
+      cache_capacity{(std::size_t{Settings::values.romfs_cache_size.GetValue()} << 20) /
+                     CACHE_BLOCK_SIZE} {}
+
+CTREncryptionLayer::~CTREncryptionLayer() {
+    total_cached_bytes.fetch_sub(cached_bytes, std::memory_order_relaxed);
+    if (cache_hits + cache_misses != 0) {
+        LOG_DEBUG(Crypto, "Decrypted block cache of {}: {} hits, {} misses", base->GetName(),
+                  cache_hits, cache_misses);
+    }
+}
 
 std::size_t CTREncryptionLayer::Read(u8* data, std::size_t length, std::size_t offset) const {
     if (length == 0)
         return 0;
 
+    std::scoped_lock lock{cache_mutex};
+    if (cache_capacity != 0 && length <= MAX_CACHED_READ_SIZE) {
+        return ReadCached(data, length, offset);
+    }
+    return ReadDirect(data, length, offset);
+}
+
+std::size_t CTREncryptionLayer::ReadDirect(u8* data, std::size_t length, std::size_t offset) const {
+    std::size_t read = 0;
     const auto sector_offset = offset & 0xF;
-    if (sector_offset == 0) {
-        UpdateIV(base_offset + offset);
-        std::vector<u8> raw = base->ReadBytes(length, offset);
-        cipher.Transcode(raw.data(), raw.size(), data, Op::Decrypt);
-        return length;
+    if (sector_offset != 0) {
+        // offset does not fall on block boundary (0x10)
+        std::array<u8, 0x10> block{};
+        const std::size_t block_read =
+            base->Read(block.data(), block.size(), offset - sector_offset);
+        if (block_read <= sector_offset) {
+            return 0;
+        }
+        UpdateIV(base_offset + offset - sector_offset);
+        cipher.Transcode(block.data(), block.size(), block.data(), Op::Decrypt);
+
+        read = std::min(length, block_read - sector_offset);
+        std::memcpy(data, block.data() + sector_offset, read);
+        if (read == length || block_read < block.size()) {
+            return read;
+        }
+        data += read;
+        length -= read;
+        offset += read;
+    }
+
+    UpdateIV(base_offset + offset);
+    if (const auto view = base->GetReadView(length, offset); !view.empty()) {
+        // Decrypt straight from the mapped base file
+        cipher.Transcode(view.data(), view.size(), data, Op::Decrypt);
+        return read + view.size();
+    }
+    // Read straight into the destination and decrypt it in place
+    const std::size_t body_read = base->Read(data, length, offset);
+    cipher.Transcode(data, body_read, data, Op::Decrypt);
+    return read + body_read;
+}
+
+std::size_t CTREncryptionLayer::ReadCached(u8* data, std::size_t length, std::size_t offset) const {
+    std::size_t read = 0;
+    while (length > 0) {
+        const std::size_t block_offset = offset % CACHE_BLOCK_SIZE;
+        const CachedBlock* const block = GetBlock(offset / CACHE_BLOCK_SIZE);
+        if (block == nullptr || block_offset >= block->data.size()) {
+            break;
+        }
+        const std::size_t copy_size = std::min(length, block->data.size() - block_offset);
+        std::memcpy(data, block->data.data() + block_offset, copy_size);
+        data += copy_size;
+        length -= copy_size;
+        offset += copy_size;
+        read += copy_size;
+        if (block->data.size() < CACHE_BLOCK_SIZE) {
+            // Reached the end of the file
+            break;
+        }
     }
+    return read;
+}
+
+const CTREncryptionLayer::CachedBlock* CTREncryptionLayer::GetBlock(std::size_t index) const {
+    if (const auto it = cache_lookup.find(index); it != cache_lookup.end()) {
+        ++cache_hits;
+        cache_blocks.splice(cache_blocks.begin(), cache_blocks, it->second);
+        return &cache_blocks.front();
+    }
+    ++cache_misses;
 
-    // offset does not fall on block boundary (0x10)
-    std::vector<u8> block = base->ReadBytes(0x10, offset - sector_offset);
-    UpdateIV(base_offset + offset - sector_offset);
-    cipher.Transcode(block.data(), block.size(), block.data(), Op::Decrypt);
-    std::size_t read = 0x10 - sector_offset;
+    // Sequential misses load the following blocks in the same read
+    std::size_t num_blocks = 1;
+    if (index == next_sequential_block) {
+        const std::size_t max_blocks = std::min(READAHEAD_BLOCKS, cache_capacity);
+        while (num_blocks < max_blocks && !cache_lookup.contains(index + num_blocks)) {
+            ++num_blocks;
+        }
+    }
+
+    std::vector<u8> buffer(num_blocks * CACHE_BLOCK_SIZE);
+    const std::size_t block_start = index * CACHE_BLOCK_SIZE;
+    UpdateIV(base_offset + block_start);
+    std::size_t read = 0;
+    if (const auto view = base->GetReadView(buffer.size(), block_start); !view.empty()) {
+        read = view.size();
+        cipher.Transcode(view.data(), read, buffer.data(), Op::Decrypt);
+    } else {
+        read = base->Read(buffer.data(), buffer.size(), block_start);
+        cipher.Transcode(buffer.data(), read, buffer.data(), Op::Decrypt);
+    }
+    if (read == 0) {
+        return nullptr;
+    }
 
-    if (length + sector_offset < 0x10) {
-        std::memcpy(data, block.data() + sector_offset, std::min<u64>(length, read));
-        return std::min<u64>(length, read);
+    // Insert backwards so the requested block ends up as the most recently used one
+    const std::size_t loaded_blocks = (read + CACHE_BLOCK_SIZE - 1) / CACHE_BLOCK_SIZE;
+    for (std::size_t i = loaded_blocks; i-- > 0;) {
+        const auto begin = buffer.begin() + static_cast<std::ptrdiff_t>(i * CACHE_BLOCK_SIZE);
+        const auto end = buffer.begin() +
+                         static_cast<std::ptrdiff_t>(std::min(read, (i + 1) * CACHE_BLOCK_SIZE));
+        cache_blocks.push_front(CachedBlock{
+            .index = index + i,
+            .data = std::vector<u8>(begin, end),
+        });
+        cache_lookup.insert_or_assign(index + i, cache_blocks.begin());
+        cached_bytes += cache_blocks.front().data.size();
+    }
+    u64 evicted_bytes = 0;
+    while (cache_blocks.size() > cache_capacity) {
+        cache_lookup.erase(cache_blocks.back().index);
+        evicted_bytes += cache_blocks.back().data.size();
+        cache_blocks.pop_back();
     }
-    std::memcpy(data, block.data() + sector_offset, read);
-    return read + Read(data + read, length - read, offset + read);
+    cached_bytes -= evicted_bytes;
+    total_cached_bytes.fetch_add(read, std::memory_order_relaxed);
+    total_cached_bytes.fetch_sub(evicted_bytes, std::memory_order_relaxed);
+    next_sequential_block = index + loaded_blocks;
+    return &cache_blocks.front();
 }
 
 void CTREncryptionLayer::SetIV(const IVData& iv_) {
+    std::scoped_lock lock{cache_mutex};
     iv = iv_;
+    // Blocks decrypted with the previous IV are no longer valid
+    ClearCache();
+}
+
+u64 CTREncryptionLayer::GetCachedBytes() {
+    return total_cached_bytes.load(std::memory_order_relaxed);
+}
+
+void CTREncryptionLayer::ClearCache() const {
+    cache_blocks.clear();
+    cache_lookup.clear();
+    total_cached_bytes.fetch_sub(cached_bytes, std::memory_order_relaxed);
+    cached_bytes = 0;
 }
 
 void CTREncryptionLayer::UpdateIV(std::size_t offset) const {
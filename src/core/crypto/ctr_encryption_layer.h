@@ -5,6 +5,11 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include "core/crypto/aes_util.h"
 #include "core/crypto/encryption_layer.h"
@@ -18,19 +23,60 @@ public:
     using IVData = std::array<u8, 16>;
 
     CTREncryptionLayer(FileSys::VirtualFile base_, Key128 key_, std::size_t base_offset_);
+    ~CTREncryptionLayer() override;
 
     std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
 
     void SetIV(const IVData& iv);
 
+    /// Returns the decrypted bytes held by the caches of every layer, can be called from any thread
+    [[nodiscard]] static u64 GetCachedBytes();
+
 private:
+    /// Size of the decrypted blocks kept in the cache
+    static constexpr std::size_t CACHE_BLOCK_SIZE = 0x10000;
+    /// Reads larger than this bypass the cache, they are unlikely to be read again soon
+    static constexpr std::size_t MAX_CACHED_READ_SIZE = CACHE_BLOCK_SIZE * 4;
+    /// Number of blocks loaded at once when misses are sequential
+    static constexpr std::size_t READAHEAD_BLOCKS = 4;
+
+    struct CachedBlock {
+        std::size_t index;
+        /// Decrypted contents, shorter than CACHE_BLOCK_SIZE at the end of the file
+        std::vector<u8> data;
+    };
+
+    /// Drops every cached block. cache_mutex must be held.
+    void ClearCache() const;
+
+    /// Reads and decrypts without going through the cache. cache_mutex must be held.
+    std::size_t ReadDirect(u8* data, std::size_t length, std::size_t offset) const;
+
+    /// Reads through the block cache. cache_mutex must be held.
+    std::size_t ReadCached(u8* data, std::size_t length, std::size_t offset) const;
+
+    /// Returns the given block, decrypting it on a miss. cache_mutex must be held.
+    const CachedBlock* GetBlock(std::size_t index) const;
+
+    void UpdateIV(std::size_t offset) const;
+
     std::size_t base_offset;
 
     // Must be mutable as operations modify cipher contexts.
     mutable AESCipher<Key128> cipher;
     mutable IVData iv{};
 
-    void UpdateIV(std::size_t offset) const;
+    /// Maximum number of cached blocks, zero disables the cache
+    std::size_t cache_capacity;
+    mutable std::mutex cache_mutex;
+    /// Cached blocks, most recently used first
+    mutable std::list<CachedBlock> cache_blocks;
+    mutable std::unordered_map<std::size_t, std::list<CachedBlock>::iterator> cache_lookup;
+    /// Decrypted bytes held by cache_blocks
+    mutable u64 cached_bytes{};
+    mutable std::size_t next_sequential_block{};
+    mutable u64 cache_hits{};
+    mutable u64 cache_misses{};
 };
 
 } // namespace Core::Crypto
@@ -798,8 +798,8 @@ void KeyManager::WriteKeyToFile(KeyCategory category, std::string_view keyname,
             "# If you are experiencing issues involving keys, it may help to delete this file\n"));
     }
 
+    // Callers store the key themselves, so the file doesn't have to be parsed again
     void(file.WriteString(fmt::format("\n{} = {}", keyname, Common::HexToString(key))));
-    LoadFromFile(path, category == KeyCategory::Title);
 }
 
 void KeyManager::SetKey(S128KeyType id, Key128 key, u64 field1, u64 field2) {
@@ -1108,6 +1108,7 @@ void KeyManager::DeriveETicket(PartitionDataManager& data,
 
     eticket_extended_kek = data.GetETicketExtendedKek();
     WriteKeyToFile(KeyCategory::Console, "eticket_extended_kek", eticket_extended_kek);
+    tickets_populated = false;
     PopulateTickets();
 }
 
@@ -1118,9 +1119,11 @@ void KeyManager::PopulateTickets() {
         return;
     }
 
-    if (!common_tickets.empty() && !personal_tickets.empty()) {
+    // The ticket saves are only read once, tickets installed afterwards are added directly
+    if (tickets_populated) {
         return;
     }
+    tickets_populated = true;
 
     const auto system_save_e1_path =
         Common::FS::GetYuzuPath(Common::FS::YuzuPath::NANDDir) / "system/save/80000000000000e1";
@@ -18,6 +18,12 @@ std::size_t XTSEncryptionLayer::Read(u8* data, std::size_t length, std::size_t o
     if (length == 0)
         return 0;
 
+    // Sectors are decrypted whole, the padding after the end of the file must not be returned
+    const std::size_t size = base->GetSize();
+    if (offset >= size)
+        return 0;
+    length = std::min(length, size - offset);
+
     const auto sector_offset = offset & 0x3FFF;
     if (sector_offset == 0) {
         if (length % XTS_SECTOR_SIZE == 0) {
@@ -2,11 +2,13 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include "common/settings.h"
 #include "core/device_memory.h"
 
 namespace Core {
 
-DeviceMemory::DeviceMemory() : buffer{DramMemoryMap::Size, 1ULL << 39} {}
+DeviceMemory::DeviceMemory()
+    : buffer{DramMemoryMap::Size, 1ULL << 39, Settings::values.use_huge_pages.GetValue()} {}
 DeviceMemory::~DeviceMemory() = default;
 
 } // namespace Core
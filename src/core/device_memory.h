@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+
 #include "common/common_types.h"
 #include "common/host_memory.h"
 
@@ -44,7 +47,31 @@ public:
         return buffer.BackingBasePointer() + (addr - DramMemoryMap::Base);
     }
 
+    /// Zeroes a physical range, its host pages are only committed again once they are touched
+    void ClearRange(PAddr addr, std::size_t size) {
+        buffer.ClearBackingRegion(addr - DramMemoryMap::Base, size);
+    }
+
+    /// Accounts a physical range handed out to the guest
+    void Commit(std::size_t size) {
+        committed_size.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    /// Releases the host pages of a physical range returned by the guest
+    void Decommit(PAddr addr, std::size_t size) {
+        ClearRange(addr, size);
+        committed_size.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    /// Returns the number of bytes of physical memory currently handed out to the guest
+    [[nodiscard]] std::size_t GetCommittedSize() const {
+        return committed_size.load(std::memory_order_relaxed);
+    }
+
     Common::HostMemory buffer;
+
+private:
+    std::atomic<std::size_t> committed_size{};
 };
 
 } // namespace Core
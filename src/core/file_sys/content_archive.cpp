@@ -7,6 +7,9 @@
 #include <optional>
 #include <utility>
 
+#include <fmt/format.h>
+
+#include "common/cityhash.h"
 #include "common/logging/log.h"
 #include "core/crypto/aes_util.h"
 #include "core/crypto/ctr_encryption_layer.h"
@@ -14,6 +17,7 @@
 #include "core/file_sys/content_archive.h"
 #include "core/file_sys/nca_patch.h"
 #include "core/file_sys/partition_filesystem.h"
+#include "core/file_sys/shared_content_cache.h"
 #include "core/file_sys/vfs_offset.h"
 #include "core/loader/loader.h"
 
@@ -247,6 +251,13 @@ bool NCA::ReadRomFSSection(const NCASectionHeader& section, const NCASectionTabl
     const std::size_t romfs_size = section.romfs.ivfc.levels[IVFC_MAX_LEVEL - 1].size;
     auto raw = std::make_shared<OffsetVfsFile>(file, romfs_size, romfs_offset);
     auto dec = Decrypt(section, raw, romfs_offset);
+    if (dec != raw && section.raw.header.crypto_type != NCASectionCryptoType::BKTR) {
+        // Keyed on the header, every section of an NCA is described by it
+        const u64 header_hash =
+            Common::CityHash64(reinterpret_cast<const char*>(&header), sizeof(header));
+        dec = OpenSharedSection(std::move(dec), fmt::format("{:016X}_{:016X}_{:X}", header.title_id,
+                                                            header_hash, entry.media_offset));
+    }
 
     if (dec == nullptr) {
         if (status != Loader::ResultStatus::Success)
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cstring>
 #include <map>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -65,15 +66,93 @@ static bool IsEOF(IPSFileType type, const std::vector<u8>& data) {
     return type == IPSFileType::IPS32 && std::equal(data.begin(), data.end(), eeof.begin());
 }
 
-VirtualFile PatchIPS(const VirtualFile& in, const VirtualFile& ips) {
-    if (in == nullptr || ips == nullptr)
-        return nullptr;
+namespace {
+struct IPSRecord {
+    u32 offset;
+    u32 size;
+    // Run-length encoded records have no data and fill their range with this byte
+    u8 fill;
+    std::vector<u8> data;
+};
+
+// Applies the records of an IPS patch to a range of the patched file, starting at offset
+void ApplyIPSRecords(const std::vector<IPSRecord>& records, u8* data, std::size_t length,
+                     std::size_t offset) {
+    // Records are applied in order, as later records override earlier ones
+    for (const IPSRecord& record : records) {
+        const std::size_t begin = std::max<std::size_t>(record.offset, offset);
+        const std::size_t end =
+            std::min<std::size_t>(std::size_t{record.offset} + record.size, offset + length);
+        if (begin >= end) {
+            continue;
+        }
+        if (record.data.empty()) {
+            std::memset(data + (begin - offset), record.fill, end - begin);
+        } else {
+            std::memcpy(data + (begin - offset), record.data.data() + (begin - record.offset),
+                        end - begin);
+        }
+    }
+}
+
+// A file that applies the records of an IPS patch to the data of another file as it is read, so
+// that the patched file never has to be copied to memory as a whole.
+class IPSPatchedFile final : public VfsFile {
+public:
+    explicit IPSPatchedFile(VirtualFile base_, std::vector<IPSRecord> records_)
+        : base(std::move(base_)), records(std::move(records_)) {}
+
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override {
+        const std::size_t read = base->Read(data, length, offset);
+        ApplyIPSRecords(records, data, read, offset);
+        return read;
+    }
+
+    std::string GetName() const override {
+        return base->GetName();
+    }
+
+    std::size_t GetSize() const override {
+        return base->GetSize();
+    }
+
+    bool Resize(std::size_t new_size) override {
+        return false;
+    }
+
+    VirtualDir GetContainingDirectory() const override {
+        return base->GetContainingDirectory();
+    }
+
+    bool IsWritable() const override {
+        return false;
+    }
+
+    bool IsReadable() const override {
+        return true;
+    }
+
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override {
+        return 0;
+    }
+
+    bool Rename(std::string_view name) override {
+        return false;
+    }
 
+private:
+    VirtualFile base;
+    std::vector<IPSRecord> records;
+};
+
+// Parses the records of an IPS patch for a file of in_size bytes, rejecting malformed patches
+std::optional<std::vector<IPSRecord>> ParseIPSRecords(const VirtualFile& ips,
+                                                      std::size_t in_size) {
     const auto type = IdentifyMagic(ips->ReadBytes(0x5));
     if (type == IPSFileType::Error)
-        return nullptr;
+        return std::nullopt;
 
-    auto in_data = in->ReadAllBytes();
+    std::vector<IPSRecord> records;
 
     std::vector<u8> temp(type == IPSFileType::IPS ? 3 : 4);
     u64 offset = 5; // After header
@@ -91,40 +170,67 @@ VirtualFile PatchIPS(const VirtualFile& in, const VirtualFile& ips) {
 
         u16 data_size{};
         if (ips->ReadObject(&data_size, offset) != sizeof(u16))
-            return nullptr;
+            return std::nullopt;
         data_size = Common::swap16(data_size);
         offset += sizeof(u16);
 
         if (data_size == 0) { // RLE
             u16 rle_size{};
             if (ips->ReadObject(&rle_size, offset) != sizeof(u16))
-                return nullptr;
+                return std::nullopt;
             rle_size = Common::swap16(rle_size);
             offset += sizeof(u16);
 
             const auto data = ips->ReadByte(offset++);
             if (!data)
-                return nullptr;
+                return std::nullopt;
 
-            if (real_offset + rle_size > in_data.size())
-                rle_size = static_cast<u16>(in_data.size() - real_offset);
-            std::memset(in_data.data() + real_offset, *data, rle_size);
+            if (real_offset >= in_size)
+                continue;
+            const auto size =
+                static_cast<u32>(std::min<std::size_t>(rle_size, in_size - real_offset));
+            records.push_back({real_offset, size, *data, {}});
         } else { // Standard Patch
-            auto read = data_size;
-            if (real_offset + read > in_data.size())
-                read = static_cast<u16>(in_data.size() - real_offset);
-            if (ips->Read(in_data.data() + real_offset, read, offset) != data_size)
-                return nullptr;
+            // Records that extend past the end of the file are rejected
+            if (std::size_t{real_offset} + data_size > in_size)
+                return std::nullopt;
+            std::vector<u8> data(data_size);
+            if (ips->Read(data.data(), data.size(), offset) != data_size)
+                return std::nullopt;
             offset += data_size;
+            records.push_back({real_offset, data_size, 0, std::move(data)});
         }
     }
 
     if (!IsEOF(type, temp)) {
-        return nullptr;
+        return std::nullopt;
     }
 
-    return std::make_shared<VectorVfsFile>(std::move(in_data), in->GetName(),
-                                           in->GetContainingDirectory());
+    return records;
+}
+} // Anonymous namespace
+
+VirtualFile PatchIPS(const VirtualFile& in, const VirtualFile& ips) {
+    if (in == nullptr || ips == nullptr)
+        return nullptr;
+
+    auto records = ParseIPSRecords(ips, in->GetSize());
+    if (!records)
+        return nullptr;
+
+    return std::make_shared<IPSPatchedFile>(in, std::move(*records));
+}
+
+bool PatchIPSInPlace(std::span<u8> data, const VirtualFile& ips) {
+    if (ips == nullptr)
+        return false;
+
+    const auto records = ParseIPSRecords(ips, data.size());
+    if (!records)
+        return false;
+
+    ApplyIPSRecords(*records, data.data(), data.size(), 0);
+    return true;
 }
 
 struct IPSwitchCompiler::IPSwitchPatch {
@@ -316,24 +422,28 @@ VirtualFile IPSwitchCompiler::Apply(const VirtualFile& in) const {
         return nullptr;
 
     auto in_data = in->ReadAllBytes();
+    ApplyInPlace(in_data);
+
+    return std::make_shared<VectorVfsFile>(std::move(in_data), in->GetName(),
+                                           in->GetContainingDirectory());
+}
+
+void IPSwitchCompiler::ApplyInPlace(std::span<u8> data) const {
+    if (!valid)
+        return;
 
     for (const auto& patch : patches) {
         if (!patch.enabled)
             continue;
 
         for (const auto& record : patch.records) {
-            if (record.first >= in_data.size())
+            if (record.first >= data.size())
                 continue;
-            auto replace_size = record.second.size();
-            if (record.first + replace_size > in_data.size())
-                replace_size = in_data.size() - record.first;
-            for (std::size_t i = 0; i < replace_size; ++i)
-                in_data[i + record.first] = record.second[i];
+            const auto replace_size =
+                std::min<std::size_t>(record.second.size(), data.size() - record.first);
+            std::memcpy(data.data() + record.first, record.second.data(), replace_size);
         }
     }
-
-    return std::make_shared<VectorVfsFile>(std::move(in_data), in->GetName(),
-                                           in->GetContainingDirectory());
 }
 
 } // namespace FileSys
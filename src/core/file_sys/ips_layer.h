@@ -6,6 +6,7 @@
 
 #include <array>
 #include <memory>
+#include <span>
 #include <vector>
 
 #include "common/common_types.h"
@@ -15,6 +16,10 @@ namespace FileSys {
 
 VirtualFile PatchIPS(const VirtualFile& in, const VirtualFile& ips);
 
+// Applies an IPS patch directly to data, returning false and leaving data untouched when the patch
+// is malformed.
+bool PatchIPSInPlace(std::span<u8> data, const VirtualFile& ips);
+
 class IPSwitchCompiler {
 public:
     explicit IPSwitchCompiler(VirtualFile patch_text);
@@ -23,6 +28,8 @@ public:
     std::array<u8, 0x20> GetBuildID() const;
     bool IsValid() const;
     VirtualFile Apply(const VirtualFile& in) const;
+    // Applies the enabled patches directly to data
+    void ApplyInPlace(std::span<u8> data) const;
 
 private:
     struct IPSwitchPatch;
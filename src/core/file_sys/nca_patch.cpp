@@ -12,71 +12,27 @@
 #include "core/file_sys/nca_patch.h"
 
 namespace FileSys {
-namespace {
-template <bool Subsection, typename BlockType, typename BucketType>
-std::pair<std::size_t, std::size_t> SearchBucketEntry(u64 offset, const BlockType& block,
-                                                      const BucketType& buckets) {
-    if constexpr (Subsection) {
-        const auto& last_bucket = buckets[block.number_buckets - 1];
-        if (offset >= last_bucket.entries[last_bucket.number_entries].address_patch) {
-            return {block.number_buckets - 1, last_bucket.number_entries};
-        }
-    } else {
-        ASSERT_MSG(offset <= block.size, "Offset is out of bounds in BKTR relocation block.");
-    }
-
-    std::size_t bucket_id = std::count_if(
-        block.base_offsets.begin() + 1, block.base_offsets.begin() + block.number_buckets,
-        [&offset](u64 base_offset) { return base_offset <= offset; });
-
-    const auto& bucket = buckets[bucket_id];
-
-    if (bucket.number_entries == 1) {
-        return {bucket_id, 0};
-    }
-
-    std::size_t low = 0;
-    std::size_t mid = 0;
-    std::size_t high = bucket.number_entries - 1;
-    while (low <= high) {
-        mid = (low + high) / 2;
-        if (bucket.entries[mid].address_patch > offset) {
-            high = mid - 1;
-        } else {
-            if (mid == bucket.number_entries - 1 ||
-                bucket.entries[mid + 1].address_patch > offset) {
-                return {bucket_id, mid};
-            }
-
-            low = mid + 1;
-        }
-    }
-    UNREACHABLE_MSG("Offset could not be found in BKTR block.");
-    return {0, 0};
-}
-} // Anonymous namespace
 
 BKTR::BKTR(VirtualFile base_romfs_, VirtualFile bktr_romfs_, RelocationBlock relocation_,
            std::vector<RelocationBucket> relocation_buckets_, SubsectionBlock subsection_,
            std::vector<SubsectionBucket> subsection_buckets_, bool is_encrypted_,
            Core::Crypto::Key128 key_, u64 base_offset_, u64 ivfc_offset_,
            std::array<u8, 8> section_ctr_)
-    : relocation(relocation_), relocation_buckets(std::move(relocation_buckets_)),
-      subsection(subsection_), subsection_buckets(std::move(subsection_buckets_)),
-      base_romfs(std::move(base_romfs_)), bktr_romfs(std::move(bktr_romfs_)),
-      encrypted(is_encrypted_), key(key_), base_offset(base_offset_), ivfc_offset(ivfc_offset_),
+    : relocation(relocation_), base_romfs(std::move(base_romfs_)),
+      bktr_romfs(std::move(bktr_romfs_)), encrypted(is_encrypted_), key(key_),
+      cipher(key_, Core::Crypto::Mode::CTR), base_offset(base_offset_), ivfc_offset(ivfc_offset_),
       section_ctr(section_ctr_) {
-    for (std::size_t i = 0; i < relocation.number_buckets - 1; ++i) {
-        relocation_buckets[i].entries.push_back({relocation.base_offsets[i + 1], 0, 0});
+    // Flatten the buckets, so that lookups are a single binary search and consecutive entries
+    // can be walked without searching again.
+    for (const RelocationBucket& bucket : relocation_buckets_) {
+        relocations.insert(relocations.end(), bucket.entries.begin(), bucket.entries.end());
     }
+    relocations.push_back({relocation.size, 0, 0});
 
-    for (std::size_t i = 0; i < subsection.number_buckets - 1; ++i) {
-        subsection_buckets[i].entries.push_back({subsection_buckets[i + 1].entries[0].address_patch,
-                                                 {0},
-                                                 subsection_buckets[i + 1].entries[0].ctr});
+    // The last subsection bucket already ends with the entry marking the end of the table.
+    for (const SubsectionBucket& bucket : subsection_buckets_) {
+        subsections.insert(subsections.end(), bucket.entries.begin(), bucket.entries.end());
     }
-
-    relocation_buckets.back().entries.push_back({relocation.size, 0, 0});
 }
 
 BKTR::~BKTR() = default;
@@ -86,101 +42,124 @@ std::size_t BKTR::Read(u8* data, std::size_t length, std::size_t offset) const {
     if (offset >= relocation.size) {
         return 0;
     }
+    length = std::min<std::size_t>(length, relocation.size - offset);
+
+    const u64 end_offset = offset + length;
+    std::size_t index = FindRelocationEntry(offset);
+    std::size_t total_read = 0;
+    while (total_read < length) {
+        const u64 current = offset + total_read;
+        const RelocationEntry& entry = relocations[index];
+        const u64 section_offset = current - entry.address_patch + entry.address_source;
+
+        // Merge the following entries that continue the same backing range, so that they are
+        // serviced by a single read.
+        ++index;
+        while (relocations[index].address_patch < end_offset && index + 1 < relocations.size()) {
+            const RelocationEntry& next = relocations[index];
+            if (next.from_patch != entry.from_patch ||
+                next.address_source - entry.address_source !=
+                    next.address_patch - entry.address_patch) {
+                break;
+            }
+            ++index;
+        }
+        const std::size_t chunk_size =
+            std::min<u64>(relocations[index].address_patch, end_offset) - current;
 
-    const auto relocation_entry = GetRelocationEntry(offset);
-    const auto section_offset =
-        offset - relocation_entry.address_patch + relocation_entry.address_source;
-    const auto bktr_read = relocation_entry.from_patch;
+        std::size_t read;
+        if (entry.from_patch) {
+            read = ReadPatch(data + total_read, chunk_size, section_offset);
+        } else {
+            ASSERT_MSG(section_offset >= ivfc_offset, "Offset calculation negative.");
+            read = base_romfs->Read(data + total_read, chunk_size, section_offset - ivfc_offset);
+        }
+        total_read += read;
+        if (read < chunk_size) {
+            break;
+        }
+    }
+    return total_read;
+}
 
-    const auto next_relocation = GetNextRelocationEntry(offset);
+std::size_t BKTR::FindRelocationEntry(u64 offset) const {
+    const auto it = std::upper_bound(relocations.begin(), relocations.end() - 1, offset,
+                                     [](u64 value, const RelocationEntry& entry) {
+                                         return value < entry.address_patch;
+                                     });
+    ASSERT_MSG(it != relocations.begin(), "Offset could not be found in BKTR block.");
+    return static_cast<std::size_t>(std::distance(relocations.begin(), it)) - 1;
+}
 
-    if (offset + length > next_relocation.address_patch) {
-        const u64 partition = next_relocation.address_patch - offset;
-        return Read(data, partition, offset) +
-               Read(data + partition, length - partition, offset + partition);
-    }
+std::size_t BKTR::FindSubsectionEntry(u64 offset) const {
+    const auto it = std::upper_bound(subsections.begin(), subsections.end() - 1, offset,
+                                     [](u64 value, const SubsectionEntry& entry) {
+                                         return value < entry.address_patch;
+                                     });
+    ASSERT_MSG(it != subsections.begin(), "Offset could not be found in BKTR block.");
+    return static_cast<std::size_t>(std::distance(subsections.begin(), it)) - 1;
+}
 
-    if (!bktr_read) {
-        ASSERT_MSG(section_offset >= ivfc_offset, "Offset calculation negative.");
-        return base_romfs->Read(data, length, section_offset - ivfc_offset);
+std::size_t BKTR::ReadPatch(u8* data, std::size_t length, u64 section_offset) const {
+    const std::size_t read = bktr_romfs->Read(data, length, section_offset);
+    if (!encrypted) {
+        return read;
     }
 
-    if (!encrypted) {
-        return bktr_romfs->Read(data, length, section_offset);
+    std::scoped_lock lock{cipher_mutex};
+    std::size_t index = FindSubsectionEntry(section_offset);
+    std::size_t decrypted = 0;
+    while (decrypted < read) {
+        const u64 current = section_offset + decrypted;
+        std::size_t size = read - decrypted;
+        if (index + 1 < subsections.size()) {
+            size = std::min<std::size_t>(size, subsections[index + 1].address_patch - current);
+        }
+        DecryptPatch(data + decrypted, size, current, subsections[index].ctr);
+        decrypted += size;
+        ++index;
     }
+    return read;
+}
 
-    const auto subsection_entry = GetSubsectionEntry(section_offset);
-    Core::Crypto::AESCipher<Core::Crypto::Key128> cipher(key, Core::Crypto::Mode::CTR);
+void BKTR::DecryptPatch(u8* data, std::size_t length, u64 section_offset, u32 ctr) const {
+    // Decrypt an unaligned head in a temporary block. Bytes of a CTR block decrypt independently,
+    // so the rest of the block does not have to be read.
+    const std::size_t block_offset = section_offset & 0xF;
+    if (block_offset != 0) {
+        const std::size_t head_size = std::min<std::size_t>(length, 0x10 - block_offset);
+        std::array<u8, 0x10> block{};
+        std::memcpy(block.data() + block_offset, data, head_size);
+        cipher.SetIV(CalculateIV(section_offset & ~0xFULL, ctr));
+        cipher.Transcode(block.data(), block.size(), block.data(), Core::Crypto::Op::Decrypt);
+        std::memcpy(data, block.data() + block_offset, head_size);
 
-    // Calculate AES IV
-    std::array<u8, 16> iv{};
-    auto subsection_ctr = subsection_entry.ctr;
-    auto offset_iv = section_offset + base_offset;
+        data += head_size;
+        length -= head_size;
+        section_offset += head_size;
+    }
+    if (length == 0) {
+        return;
+    }
+    cipher.SetIV(CalculateIV(section_offset, ctr));
+    cipher.Transcode(data, length, data, Core::Crypto::Op::Decrypt);
+}
+
+std::array<u8, 0x10> BKTR::CalculateIV(u64 section_offset, u32 ctr) const {
+    std::array<u8, 0x10> iv{};
     for (std::size_t i = 0; i < section_ctr.size(); ++i) {
         iv[i] = section_ctr[0x8 - i - 1];
     }
-    offset_iv >>= 4;
+    u64 offset_iv = (section_offset + base_offset) >> 4;
     for (std::size_t i = 0; i < sizeof(u64); ++i) {
         iv[0xF - i] = static_cast<u8>(offset_iv & 0xFF);
         offset_iv >>= 8;
     }
     for (std::size_t i = 0; i < sizeof(u32); ++i) {
-        iv[0x7 - i] = static_cast<u8>(subsection_ctr & 0xFF);
-        subsection_ctr >>= 8;
-    }
-    cipher.SetIV(iv);
-
-    const auto next_subsection = GetNextSubsectionEntry(section_offset);
-
-    if (section_offset + length > next_subsection.address_patch) {
-        const u64 partition = next_subsection.address_patch - section_offset;
-        return Read(data, partition, offset) +
-               Read(data + partition, length - partition, offset + partition);
-    }
-
-    const auto block_offset = section_offset & 0xF;
-    if (block_offset != 0) {
-        auto block = bktr_romfs->ReadBytes(0x10, section_offset & ~0xF);
-        cipher.Transcode(block.data(), block.size(), block.data(), Core::Crypto::Op::Decrypt);
-        if (length + block_offset < 0x10) {
-            std::memcpy(data, block.data() + block_offset, std::min(length, block.size()));
-            return std::min(length, block.size());
-        }
-
-        const auto read = 0x10 - block_offset;
-        std::memcpy(data, block.data() + block_offset, read);
-        return read + Read(data + read, length - read, offset + read);
+        iv[0x7 - i] = static_cast<u8>(ctr & 0xFF);
+        ctr >>= 8;
     }
-
-    const auto raw_read = bktr_romfs->Read(data, length, section_offset);
-    cipher.Transcode(data, raw_read, data, Core::Crypto::Op::Decrypt);
-    return raw_read;
-}
-
-RelocationEntry BKTR::GetRelocationEntry(u64 offset) const {
-    const auto res = SearchBucketEntry<false>(offset, relocation, relocation_buckets);
-    return relocation_buckets[res.first].entries[res.second];
-}
-
-RelocationEntry BKTR::GetNextRelocationEntry(u64 offset) const {
-    const auto res = SearchBucketEntry<false>(offset, relocation, relocation_buckets);
-    const auto bucket = relocation_buckets[res.first];
-    if (res.second + 1 < bucket.entries.size())
-        return bucket.entries[res.second + 1];
-    return relocation_buckets[res.first + 1].entries[0];
-}
-
-SubsectionEntry BKTR::GetSubsectionEntry(u64 offset) const {
-    const auto res = SearchBucketEntry<true>(offset, subsection, subsection_buckets);
-    return subsection_buckets[res.first].entries[res.second];
-}
-
-SubsectionEntry BKTR::GetNextSubsectionEntry(u64 offset) const {
-    const auto res = SearchBucketEntry<true>(offset, subsection, subsection_buckets);
-    const auto bucket = subsection_buckets[res.first];
-    if (res.second + 1 < bucket.entries.size())
-        return bucket.entries[res.second + 1];
-    return subsection_buckets[res.first + 1].entries[0];
+    return iv;
 }
 
 std::string BKTR::GetName() const {
@@ -6,11 +6,13 @@
 
 #include <array>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "common/common_funcs.h"
 #include "common/common_types.h"
 #include "common/swap.h"
+#include "core/crypto/aes_util.h"
 #include "core/crypto/key_manager.h"
 
 namespace FileSys {
@@ -117,16 +119,22 @@ public:
     bool Rename(std::string_view name) override;
 
 private:
-    RelocationEntry GetRelocationEntry(u64 offset) const;
-    RelocationEntry GetNextRelocationEntry(u64 offset) const;
+    /// Returns the index of the relocation entry containing the given patched offset.
+    std::size_t FindRelocationEntry(u64 offset) const;
+    /// Returns the index of the subsection entry containing the given patch section offset.
+    std::size_t FindSubsectionEntry(u64 offset) const;
 
-    SubsectionEntry GetSubsectionEntry(u64 offset) const;
-    SubsectionEntry GetNextSubsectionEntry(u64 offset) const;
+    /// Reads from the patch RomFS, decrypting each subsection with its own counter.
+    std::size_t ReadPatch(u8* data, std::size_t length, u64 section_offset) const;
+    /// Decrypts data lying within a single subsection in place. cipher_mutex must be held.
+    void DecryptPatch(u8* data, std::size_t length, u64 section_offset, u32 ctr) const;
+    std::array<u8, 0x10> CalculateIV(u64 section_offset, u32 ctr) const;
 
     RelocationBlock relocation;
-    std::vector<RelocationBucket> relocation_buckets;
-    SubsectionBlock subsection;
-    std::vector<SubsectionBucket> subsection_buckets;
+    // Relocation and subsection entries of all buckets, sorted by patched address. The last entry
+    // of each only marks the end of the table.
+    std::vector<RelocationEntry> relocations;
+    std::vector<SubsectionEntry> subsections;
 
     // Should be the raw base romfs, decrypted.
     VirtualFile base_romfs;
@@ -135,6 +143,9 @@ private:
 
     bool encrypted;
     Core::Crypto::Key128 key;
+    // Must be mutable as operations modify cipher contexts.
+    mutable Core::Crypto::AESCipher<Core::Crypto::Key128> cipher;
+    mutable std::mutex cipher_mutex;
 
     // Base offset into NCA, used for IV calculation.
     u64 base_offset;
@@ -154,7 +154,7 @@ VirtualDir PatchManager::PatchExeFS(VirtualDir exefs) const {
 
     // LayeredExeFS
     const auto load_dir = fs_controller.GetModificationLoadRoot(title_id);
-    if (load_dir != nullptr && load_dir->GetSize() > 0) {
+    if (IsDirValidAndNonEmpty(load_dir)) {
         auto patch_dirs = load_dir->GetSubdirectories();
         std::sort(
             patch_dirs.begin(), patch_dirs.end(),
@@ -182,11 +182,11 @@ VirtualDir PatchManager::PatchExeFS(VirtualDir exefs) const {
     return exefs;
 }
 
-std::vector<VirtualFile> PatchManager::CollectPatches(const std::vector<VirtualDir>& patch_dirs,
-                                                      const std::string& build_id) const {
+std::vector<PatchManager::ExeFSPatch> PatchManager::CollectPatches(
+    const std::vector<VirtualDir>& patch_dirs, const std::string& build_id) const {
     const auto& disabled = Settings::values.disabled_addons[title_id];
 
-    std::vector<VirtualFile> out;
+    std::vector<ExeFSPatch> out;
     out.reserve(patch_dirs.size());
     for (const auto& subdir : patch_dirs) {
         if (std::find(disabled.cbegin(), disabled.cend(), subdir->GetName()) != disabled.cend())
@@ -201,18 +201,19 @@ std::vector<VirtualFile> PatchManager::CollectPatches(const std::vector<VirtualD
                     const auto this_build_id = p1.substr(0, p1.find_last_not_of('0') + 1);
 
                     if (build_id == this_build_id)
-                        out.push_back(file);
+                        out.push_back({file, nullptr});
                 } else if (file->GetExtension() == "pchtxt") {
-                    IPSwitchCompiler compiler{file};
-                    if (!compiler.IsValid())
+                    // Keep the compiled patch, so applying it doesn't parse the text again
+                    auto compiler = std::make_shared<const IPSwitchCompiler>(file);
+                    if (!compiler->IsValid())
                         continue;
 
-                    auto this_build_id = Common::HexToString(compiler.GetBuildID());
+                    auto this_build_id = Common::HexToString(compiler->GetBuildID());
                     this_build_id =
                         this_build_id.substr(0, this_build_id.find_last_not_of('0') + 1);
 
                     if (build_id == this_build_id)
-                        out.push_back(file);
+                        out.push_back({file, std::move(compiler)});
                 }
             }
         }
@@ -262,21 +263,16 @@ std::vector<u8> PatchManager::PatchNSO(const std::vector<u8>& nso, const std::st
               [](const VirtualDir& l, const VirtualDir& r) { return l->GetName() < r->GetName(); });
     const auto patches = CollectPatches(patch_dirs, build_id);
 
+    // Every patch is applied in place to a single copy of the image
     auto out = nso;
-    for (const auto& patch_file : patches) {
-        if (patch_file->GetExtension() == "ips") {
-            LOG_INFO(Loader, "    - Applying IPS patch from mod \"{}\"",
-                     patch_file->GetContainingDirectory()->GetParentDirectory()->GetName());
-            const auto patched = PatchIPS(std::make_shared<VectorVfsFile>(out), patch_file);
-            if (patched != nullptr)
-                out = patched->ReadAllBytes();
-        } else if (patch_file->GetExtension() == "pchtxt") {
-            LOG_INFO(Loader, "    - Applying IPSwitch patch from mod \"{}\"",
-                     patch_file->GetContainingDirectory()->GetParentDirectory()->GetName());
-            const IPSwitchCompiler compiler{patch_file};
-            const auto patched = compiler.Apply(std::make_shared<VectorVfsFile>(out));
-            if (patched != nullptr)
-                out = patched->ReadAllBytes();
+    for (const auto& patch : patches) {
+        const auto mod_name = patch.file->GetContainingDirectory()->GetParentDirectory()->GetName();
+        if (patch.ipswitch == nullptr) {
+            LOG_INFO(Loader, "    - Applying IPS patch from mod \"{}\"", mod_name);
+            PatchIPSInPlace(out, patch.file);
+        } else {
+            LOG_INFO(Loader, "    - Applying IPSwitch patch from mod \"{}\"", mod_name);
+            patch.ipswitch->ApplyInPlace(out);
         }
     }
 
@@ -347,8 +343,7 @@ static void ApplyLayeredFS(VirtualFile& romfs, u64 title_id, ContentRecordType t
     const auto load_dir = fs_controller.GetModificationLoadRoot(title_id);
     const auto sdmc_load_dir = fs_controller.GetSDMCModificationLoadRoot(title_id);
     if ((type != ContentRecordType::Program && type != ContentRecordType::Data) ||
-        ((load_dir == nullptr || load_dir->GetSize() <= 0) &&
-         (sdmc_load_dir == nullptr || sdmc_load_dir->GetSize() <= 0))) {
+        (!IsDirValidAndNonEmpty(load_dir) && !IsDirValidAndNonEmpty(sdmc_load_dir))) {
         return;
     }
 
@@ -489,7 +484,7 @@ PatchManager::PatchVersionNames PatchManager::GetPatchVersionNames(VirtualFile u
 
     // General Mods (LayeredFS and IPS)
     const auto mod_dir = fs_controller.GetModificationLoadRoot(title_id);
-    if (mod_dir != nullptr && mod_dir->GetSize() > 0) {
+    if (IsDirValidAndNonEmpty(mod_dir)) {
         for (const auto& mod : mod_dir->GetSubdirectories()) {
             std::string types;
 
@@ -533,7 +528,7 @@ PatchManager::PatchVersionNames PatchManager::GetPatchVersionNames(VirtualFile u
 
     // SDMC mod directory (RomFS LayeredFS)
     const auto sdmc_mod_dir = fs_controller.GetSDMCModificationLoadRoot(title_id);
-    if (sdmc_mod_dir != nullptr && sdmc_mod_dir->GetSize() > 0 &&
+    if (IsDirValidAndNonEmpty(sdmc_mod_dir) &&
         IsDirValidAndNonEmpty(FindSubdirectoryCaseless(sdmc_mod_dir, "romfs"))) {
         const auto mod_disabled =
             std::find(disabled.begin(), disabled.end(), "SDMC") != disabled.end();
@@ -24,6 +24,7 @@ class FileSystemController;
 namespace FileSys {
 
 class ContentProvider;
+class IPSwitchCompiler;
 class NCA;
 class NACP;
 
@@ -84,8 +85,14 @@ public:
     [[nodiscard]] Metadata ParseControlNCA(const NCA& nca) const;
 
 private:
-    [[nodiscard]] std::vector<VirtualFile> CollectPatches(const std::vector<VirtualDir>& patch_dirs,
-                                                          const std::string& build_id) const;
+    struct ExeFSPatch {
+        VirtualFile file;
+        // Patch compiled from an IPSwitch text file, null for IPS files
+        std::shared_ptr<const IPSwitchCompiler> ipswitch;
+    };
+
+    [[nodiscard]] std::vector<ExeFSPatch> CollectPatches(const std::vector<VirtualDir>& patch_dirs,
+                                                         const std::string& build_id) const;
 
     u64 title_id;
     const Service::FileSystem::FileSystemController& fs_controller;
@@ -10,6 +10,7 @@
 #include "common/fs/path_util.h"
 #include "common/hex_util.h"
 #include "common/logging/log.h"
+#include "common/thread_pool.h"
 #include "core/crypto/key_manager.h"
 #include "core/file_sys/card_image.h"
 #include "core/file_sys/common_funcs.h"
@@ -409,28 +410,80 @@ std::vector<NcaID> RegisteredCache::AccumulateFiles() const {
     return ids;
 }
 
+RegisteredCache::CachedNca RegisteredCache::ParseNca(const ContentProviderParsingFunction& parser,
+                                                     const VirtualFile& file, const NcaID& id) {
+    CachedNca parsed{.file_size = file->GetSize()};
+    const NCA nca(parser(file, id), nullptr, 0);
+    if (nca.GetStatus() != Loader::ResultStatus::Success ||
+        nca.GetType() != NCAContentType::Meta) {
+        return parsed;
+    }
+
+    const auto section0 = nca.GetSubdirectories()[0];
+
+    for (const auto& section0_file : section0->GetFiles()) {
+        if (section0_file->GetExtension() != "cnmt")
+            continue;
+
+        parsed.title_id = nca.GetTitleId();
+        parsed.cnmt = std::make_shared<const CNMT>(section0_file);
+        break;
+    }
+    return parsed;
+}
+
 void RegisteredCache::ProcessFiles(const std::vector<NcaID>& ids) {
+    struct PendingNca {
+        NcaID id;
+        VirtualFile file;
+        CachedNca parsed;
+    };
+
+    // Files are opened on this thread, the filesystem isn't thread safe. NCA ids are derived from
+    // the contents of the NCA, entries with the same size as on the last refresh are reused.
+    std::map<NcaID, CachedNca> new_cache;
+    std::vector<PendingNca> pending;
     for (const auto& id : ids) {
         const auto file = GetFileAtID(id);
 
         if (file == nullptr)
             continue;
-        const auto nca = std::make_shared<NCA>(parser(file, id), nullptr, 0);
-        if (nca->GetStatus() != Loader::ResultStatus::Success ||
-            nca->GetType() != NCAContentType::Meta) {
+        if (const auto it = nca_cache.find(id);
+            it != nca_cache.end() && it->second.file_size == file->GetSize()) {
+            new_cache.insert_or_assign(id, std::move(it->second));
             continue;
         }
+        pending.push_back({id, file, {}});
+    }
 
-        const auto section0 = nca->GetSubdirectories()[0];
+    // Decrypting the headers dominates, parse the changed entries in parallel. The first one is
+    // parsed here, so the key manager derives its lazy keys before other threads read them.
+    const auto parse = [this](PendingNca& entry) {
+        entry.parsed = ParseNca(parser, entry.file, entry.id);
+    };
+    if (!pending.empty()) {
+        parse(pending.front());
+    }
+    Common::TaskGroup group;
+    for (std::size_t i = 1; i < pending.size(); ++i) {
+        Common::ThreadPool::Instance().Submit(
+            Common::TaskPriority::IO,
+            [&parse, &entry = pending[i]](std::stop_token) { parse(entry); }, {}, &group);
+    }
+    group.Wait();
 
-        for (const auto& section0_file : section0->GetFiles()) {
-            if (section0_file->GetExtension() != "cnmt")
-                continue;
+    for (auto& entry : pending) {
+        new_cache.insert_or_assign(entry.id, std::move(entry.parsed));
+    }
+    nca_cache = std::move(new_cache);
 
-            meta.insert_or_assign(nca->GetTitleId(), CNMT(section0_file));
-            meta_id.insert_or_assign(nca->GetTitleId(), id);
-            break;
-        }
+    for (const auto& id : ids) {
+        const auto it = nca_cache.find(id);
+        if (it == nca_cache.end() || it->second.cnmt == nullptr)
+            continue;
+
+        meta.insert_or_assign(it->second.title_id, *it->second.cnmt);
+        meta_id.insert_or_assign(it->second.title_id, id);
     }
 }
 
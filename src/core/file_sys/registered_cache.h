@@ -188,9 +188,23 @@ private:
                                 bool overwrite_if_exists, std::optional<NcaID> override_id = {});
     bool RawInstallYuzuMeta(const CNMT& cnmt);
 
+    // Metadata parsed from an NCA on a previous refresh
+    struct CachedNca {
+        u64 file_size{};
+        u64 title_id{};
+        // Metadata of the title, null when the NCA isn't a valid meta NCA
+        std::shared_ptr<const CNMT> cnmt;
+    };
+
+    static CachedNca ParseNca(const ContentProviderParsingFunction& parser, const VirtualFile& file,
+                              const NcaID& id);
+
     VirtualDir dir;
     ContentProviderParsingFunction parser;
 
+    // maps NcaID -> metadata parsed on the last refresh
+    std::map<NcaID, CachedNca> nca_cache;
+
     // maps tid -> NcaID of meta
     std::map<u64, NcaID> meta_id;
     // maps tid -> meta
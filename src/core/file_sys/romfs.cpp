@@ -2,7 +2,13 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
 
 #include "common/common_types.h"
 #include "common/string_util.h"
@@ -53,54 +59,177 @@ struct FileEntry {
 };
 static_assert(sizeof(FileEntry) == 0x20, "FileEntry has incorrect size.");
 
+// Hash used by the RomFS directory and file hash tables, see romfs_calc_path_hash
+u32 CalculatePathHash(u32 parent, std::string_view name) {
+    u32 hash = parent ^ 123456789;
+    for (const char c : name) {
+        hash = (hash >> 5) | (hash << 27);
+        hash ^= static_cast<u8>(c);
+    }
+    return hash;
+}
+
+bool IsAscii(std::string_view name) {
+    return std::all_of(name.begin(), name.end(),
+                       [](char c) { return static_cast<u8>(c) < 0x80; });
+}
+
 template <typename Entry>
-std::pair<Entry, std::string> GetEntry(const VirtualFile& file, std::size_t offset) {
+std::optional<std::pair<Entry, std::string_view>> GetEntry(std::span<const u8> table,
+                                                            std::size_t offset) {
+    if (offset > table.size() || table.size() - offset < sizeof(Entry)) {
+        return std::nullopt;
+    }
     Entry entry{};
-    if (file->ReadObject(&entry, offset) != sizeof(Entry))
-        return {};
-    std::string string(entry.name_length, '\0');
-    if (file->ReadArray(&string[0], string.size(), offset + sizeof(Entry)) != string.size())
-        return {};
-    return {entry, string};
+    std::memcpy(&entry, table.data() + offset, sizeof(Entry));
+    if (entry.name_length > table.size() - offset - sizeof(Entry)) {
+        return std::nullopt;
+    }
+    const auto* const name = reinterpret_cast<const char*>(table.data() + offset + sizeof(Entry));
+    return std::make_pair(entry, std::string_view{name, entry.name_length});
 }
 
-void ProcessFile(VirtualFile file, std::size_t file_offset, std::size_t data_offset,
-                 u32 this_file_offset, std::shared_ptr<VectorVfsDirectory> parent) {
-    while (true) {
-        auto entry = GetEntry<FileEntry>(file, file_offset + this_file_offset);
+// Directory entries start with the offset of their parent, which DirectoryEntry does not include
+std::optional<std::pair<DirectoryEntry, std::string_view>> GetDirectoryEntry(
+    std::span<const u8> table, u32 offset) {
+    return GetEntry<DirectoryEntry>(table, std::size_t{offset} + sizeof(u32));
+}
 
-        parent->AddFile(std::make_shared<OffsetVfsFile>(
-            file, entry.first.size, entry.first.offset + data_offset, entry.second));
+std::optional<u32> GetDirectoryParent(std::span<const u8> table, u32 offset) {
+    if (offset > table.size() || table.size() - offset < sizeof(u32)) {
+        return std::nullopt;
+    }
+    u32_le parent;
+    std::memcpy(&parent, table.data() + offset, sizeof(parent));
+    return parent;
+}
 
-        if (entry.first.sibling == ROMFS_ENTRY_EMPTY)
-            break;
+// Metadata of a RomFS, shared by all of its directories
+struct RomFSTables {
+    VirtualFile file;
+    u64 data_offset;
+    std::vector<u32_le> directory_hash;
+    std::vector<u8> directory_meta;
+    std::vector<u32_le> file_hash;
+    std::vector<u8> file_meta;
+};
+
+// Directory of a RomFS that parses its entries from the metadata tables when they are requested,
+// instead of building the whole tree upfront. Name lookups go through the RomFS hash tables.
+class RomFSDirectory final : public ReadOnlyVfsDirectory {
+public:
+    explicit RomFSDirectory(std::shared_ptr<const RomFSTables> tables_, u32 entry_offset_,
+                            const DirectoryEntry& entry, std::string_view name_)
+        : tables(std::move(tables_)), entry_offset(entry_offset_), child_dir(entry.child_dir),
+          child_file(entry.child_file), name(name_) {}
 
-        this_file_offset = entry.first.sibling;
+    static std::shared_ptr<RomFSDirectory> Make(std::shared_ptr<const RomFSTables> tables,
+                                                u32 entry_offset) {
+        const auto entry = GetDirectoryEntry(tables->directory_meta, entry_offset);
+        if (!entry) {
+            return nullptr;
+        }
+        return std::make_shared<RomFSDirectory>(std::move(tables), entry_offset, entry->first,
+                                                entry->second);
     }
-}
 
-void ProcessDirectory(VirtualFile file, std::size_t dir_offset, std::size_t file_offset,
-                      std::size_t data_offset, u32 this_dir_offset,
-                      std::shared_ptr<VectorVfsDirectory> parent) {
-    while (true) {
-        auto entry = GetEntry<DirectoryEntry>(file, dir_offset + this_dir_offset);
-        auto current = std::make_shared<VectorVfsDirectory>(
-            std::vector<VirtualFile>{}, std::vector<VirtualDir>{}, entry.second);
+    std::vector<VirtualFile> GetFiles() const override {
+        std::vector<VirtualFile> out;
+        for (u32 offset = child_file; offset != ROMFS_ENTRY_EMPTY;) {
+            const auto entry = GetEntry<FileEntry>(tables->file_meta, offset);
+            if (!entry) {
+                break;
+            }
+            out.push_back(MakeFile(entry->first, entry->second));
+            offset = entry->first.sibling;
+        }
+        return out;
+    }
 
-        if (entry.first.child_file != ROMFS_ENTRY_EMPTY) {
-            ProcessFile(file, file_offset, data_offset, entry.first.child_file, current);
+    std::vector<VirtualDir> GetSubdirectories() const override {
+        std::vector<VirtualDir> out;
+        for (u32 offset = child_dir; offset != ROMFS_ENTRY_EMPTY;) {
+            const auto entry = GetDirectoryEntry(tables->directory_meta, offset);
+            if (!entry) {
+                break;
+            }
+            out.push_back(
+                std::make_shared<RomFSDirectory>(tables, offset, entry->first, entry->second));
+            offset = entry->first.sibling;
         }
+        return out;
+    }
 
-        if (entry.first.child_dir != ROMFS_ENTRY_EMPTY) {
-            ProcessDirectory(file, dir_offset, file_offset, data_offset, entry.first.child_dir,
-                             current);
+    VirtualFile GetFile(std::string_view file_name) const override {
+        const auto& hash_table = tables->file_hash;
+        if (hash_table.empty() || !IsAscii(file_name)) {
+            return ReadOnlyVfsDirectory::GetFile(file_name);
         }
+        const u32 hash = CalculatePathHash(entry_offset, file_name);
+        for (u32 offset = hash_table[hash % hash_table.size()]; offset != ROMFS_ENTRY_EMPTY;) {
+            const auto entry = GetEntry<FileEntry>(tables->file_meta, offset);
+            if (!entry) {
+                break;
+            }
+            if (entry->first.parent == entry_offset && entry->second == file_name) {
+                return MakeFile(entry->first, entry->second);
+            }
+            // The hash field links the entries of a hash bucket
+            offset = entry->first.hash;
+        }
+        return nullptr;
+    }
 
-        parent->AddDirectory(current);
-        if (entry.first.sibling == ROMFS_ENTRY_EMPTY)
-            break;
-        this_dir_offset = entry.first.sibling;
+    VirtualDir GetSubdirectory(std::string_view dir_name) const override {
+        const auto& hash_table = tables->directory_hash;
+        if (hash_table.empty() || !IsAscii(dir_name)) {
+            return ReadOnlyVfsDirectory::GetSubdirectory(dir_name);
+        }
+        const u32 hash = CalculatePathHash(entry_offset, dir_name);
+        for (u32 offset = hash_table[hash % hash_table.size()]; offset != ROMFS_ENTRY_EMPTY;) {
+            const auto entry = GetDirectoryEntry(tables->directory_meta, offset);
+            if (!entry) {
+                break;
+            }
+            if (GetDirectoryParent(tables->directory_meta, offset) == entry_offset &&
+                entry->second == dir_name) {
+                return std::make_shared<RomFSDirectory>(tables, offset, entry->first,
+                                                        entry->second);
+            }
+            offset = entry->first.hash;
+        }
+        return nullptr;
+    }
+
+    std::string GetName() const override {
+        return name;
+    }
+
+    VirtualDir GetParentDirectory() const override {
+        return nullptr;
     }
+
+private:
+    VirtualFile MakeFile(const FileEntry& entry, std::string_view file_name) const {
+        return std::make_shared<OffsetVfsFile>(tables->file, entry.size,
+                                               entry.offset + tables->data_offset,
+                                               std::string{file_name});
+    }
+
+    std::shared_ptr<const RomFSTables> tables;
+    u32 entry_offset;
+    u32 child_dir;
+    u32 child_file;
+    std::string name;
+};
+
+template <typename T>
+bool ReadTable(const VirtualFile& file, const TableLocation& location, std::vector<T>& out) {
+    if (location.size % sizeof(T) != 0 || location.size > file->GetSize()) {
+        return false;
+    }
+    out.resize(location.size / sizeof(T));
+    return file->ReadBytes(out.data(), location.size, location.offset) == location.size;
 }
 } // Anonymous namespace
 
@@ -112,16 +241,24 @@ VirtualDir ExtractRomFS(VirtualFile file, RomFSExtractionType type) {
     if (header.header_size != sizeof(RomFSHeader))
         return nullptr;
 
-    const u64 file_offset = header.file_meta.offset;
-    const u64 dir_offset = header.directory_meta.offset + 4;
-
-    auto root =
-        std::make_shared<VectorVfsDirectory>(std::vector<VirtualFile>{}, std::vector<VirtualDir>{},
-                                             file->GetName(), file->GetContainingDirectory());
+    // The metadata tables are read as a whole, so that entries need no further reads
+    auto tables = std::make_shared<RomFSTables>();
+    tables->file = file;
+    tables->data_offset = header.data_offset;
+    if (!ReadTable(file, header.directory_hash, tables->directory_hash) ||
+        !ReadTable(file, header.directory_meta, tables->directory_meta) ||
+        !ReadTable(file, header.file_hash, tables->file_hash) ||
+        !ReadTable(file, header.file_meta, tables->file_meta)) {
+        return nullptr;
+    }
 
-    ProcessDirectory(file, dir_offset, file_offset, header.data_offset, 0, root);
+    auto romfs_root = RomFSDirectory::Make(std::move(tables), 0);
+    if (romfs_root == nullptr)
+        return nullptr;
 
-    VirtualDir out = std::move(root);
+    VirtualDir out = std::make_shared<VectorVfsDirectory>(
+        std::vector<VirtualFile>{}, std::vector<VirtualDir>{std::move(romfs_root)},
+        file->GetName(), file->GetContainingDirectory());
 
     if (type == RomFSExtractionType::SingleDiscard)
         return out->GetSubdirectories().front();
@@ -0,0 +1,110 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <mutex>
+#include <random>
+#include <span>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "core/file_sys/shared_content_cache.h"
+#include "core/file_sys/vfs.h"
+#include "core/file_sys/vfs_real.h"
+
+namespace FileSys {
+namespace {
+// Sections are copied to the cache in chunks of this size, checking for shutdown in between
+constexpr std::size_t COPY_CHUNK_SIZE = 1ULL << 20;
+
+class SharedContentCache {
+public:
+    ~SharedContentCache() {
+        std::scoped_lock lock{mutex};
+        for (std::jthread& writer : writers) {
+            writer.request_stop();
+        }
+    }
+
+    VirtualFile Open(VirtualFile decrypted, const std::string& key) {
+        const auto path = GetDir() / fmt::format("{}.romfs", key);
+        std::scoped_lock lock{mutex};
+        const VirtualFile cached =
+            filesystem.OpenFile(Common::FS::PathToUTF8String(path), Mode::Read);
+        if (cached != nullptr && cached->GetSize() == decrypted->GetSize()) {
+            return cached;
+        }
+        if (!pending_keys.contains(key)) {
+            pending_keys.insert(key);
+            writers.emplace_back([this, decrypted, key, path](std::stop_token stop_token) {
+                Write(stop_token, *decrypted, key, path);
+            });
+        }
+        return decrypted;
+    }
+
+private:
+    static std::filesystem::path GetDir() {
+        return Common::FS::GetYuzuPath(Common::FS::YuzuPath::CacheDir) / "shared_content";
+    }
+
+    void Write(std::stop_token stop_token, const VfsFile& decrypted, const std::string& key,
+               const std::filesystem::path& path) {
+        // Instances filling the same section write their own temporary copy, the first one
+        // renamed into place is kept and readers never see a partial file
+        const auto temp_path =
+            GetDir() / fmt::format("{}.{:08x}.tmp", key, std::random_device{}());
+        if (!Common::FS::CreateDirs(GetDir())) {
+            return;
+        }
+        bool is_complete = false;
+        {
+            Common::FS::IOFile file(temp_path, Common::FS::FileAccessMode::Write,
+                                    Common::FS::FileType::BinaryFile);
+            if (!file.IsOpen()) {
+                return;
+            }
+            std::vector<u8> chunk(COPY_CHUNK_SIZE);
+            const std::size_t size = decrypted.GetSize();
+            std::size_t offset = 0;
+            while (offset < size && !stop_token.stop_requested()) {
+                const std::size_t read = decrypted.Read(chunk.data(), chunk.size(), offset);
+                if (read == 0 || file.WriteSpan(std::span<const u8>(chunk.data(), read)) != read) {
+                    break;
+                }
+                offset += read;
+            }
+            is_complete = offset == size;
+        }
+        if (!is_complete || !Common::FS::RenameFile(temp_path, path)) {
+            Common::FS::RemoveFile(temp_path);
+            return;
+        }
+        LOG_INFO(Service_FS, "Added {} to the shared content cache", key);
+    }
+
+    std::mutex mutex;
+    RealVfsFilesystem filesystem;
+    std::unordered_set<std::string> pending_keys;
+    std::vector<std::jthread> writers;
+};
+} // Anonymous namespace
+
+VirtualFile OpenSharedSection(VirtualFile decrypted, const std::string& key) {
+    if (!Settings::values.use_shared_content_cache.GetValue() || decrypted == nullptr) {
+        return decrypted;
+    }
+    static SharedContentCache cache;
+    return cache.Open(std::move(decrypted), key);
+}
+
+} // namespace FileSys
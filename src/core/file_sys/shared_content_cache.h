@@ -0,0 +1,23 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <string>
+
+#include "core/file_sys/vfs_types.h"
+
+namespace FileSys {
+
+/**
+ * Returns a decrypted NCA section from the cache shared by every emulator instance on the host,
+ * when use_shared_content_cache is enabled. The cached copy is memory mapped read-only, so
+ * instances running the same content keep it in host memory only once. On a miss the section is
+ * copied to the cache in the background and the given file is returned.
+ * @param decrypted Decrypting view of the section
+ * @param key       Name of the cached copy, unique to the section contents
+ */
+[[nodiscard]] VirtualFile OpenSharedSection(VirtualFile decrypted, const std::string& key);
+
+} // namespace FileSys
@@ -3,6 +3,8 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
+#include <future>
 #include <numeric>
 #include <string>
 #include "common/fs/path_util.h"
@@ -174,6 +176,18 @@ std::optional<u8> VfsFile::ReadByte(std::size_t offset) const {
     return std::nullopt;
 }
 
+std::size_t VfsFile::ReadScatter(std::span<const VfsReadRequest> requests) const {
+    std::size_t read_size = 0;
+    for (const VfsReadRequest& request : requests) {
+        read_size += ReadInto(request.output, request.offset);
+    }
+    return read_size;
+}
+
+std::span<const u8> VfsFile::GetReadView(std::size_t length, std::size_t offset) const {
+    return {};
+}
+
 std::vector<u8> VfsFile::ReadBytes(std::size_t size, std::size_t offset) const {
     std::vector<u8> out(size);
     std::size_t read_size = Read(out.data(), size, offset);
@@ -529,6 +543,50 @@ bool VfsRawCopy(const VirtualFile& src, const VirtualFile& dest, std::size_t blo
     return true;
 }
 
+bool VfsRawCopyPipelined(const VirtualFile& src, const VirtualFile& dest, std::size_t block_size,
+                         const std::function<bool(std::size_t)>& progress) {
+    if (src == nullptr || dest == nullptr || !src->IsReadable() || !dest->IsWritable())
+        return false;
+    const std::size_t size = src->GetSize();
+    if (!dest->Resize(size))
+        return false;
+
+    std::array<std::vector<u8>, 2> buffers;
+    for (auto& buffer : buffers) {
+        buffer.resize(std::min(block_size, size));
+    }
+    const auto read_block = [&src, &buffers, block_size, size](std::size_t index,
+                                                                std::size_t offset) {
+        const auto read = std::min(block_size, size - offset);
+        return src->Read(buffers[index].data(), read, offset) == read;
+    };
+
+    bool read_success = size == 0 || read_block(0, 0);
+    for (std::size_t i = 0, index = 0; i < size; i += block_size, index ^= 1) {
+        if (!read_success) {
+            return false;
+        }
+        const auto length = std::min(block_size, size - i);
+
+        std::future<bool> next_read;
+        if (i + length < size) {
+            next_read = std::async(std::launch::async, read_block, index ^ 1, i + length);
+        }
+        const bool write_success = dest->Write(buffers[index].data(), length, i) == length;
+        read_success = !next_read.valid() || next_read.get();
+
+        if (!write_success) {
+            return false;
+        }
+        if (!progress(length)) {
+            dest->Resize(0);
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool VfsRawCopyD(const VirtualDir& src, const VirtualDir& dest, std::size_t block_size) {
     if (src == nullptr || dest == nullptr || !src->IsReadable() || !dest->IsWritable())
         return false;
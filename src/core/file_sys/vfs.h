@@ -8,6 +8,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -20,6 +21,12 @@ namespace FileSys {
 
 enum class Mode : u32;
 
+// One read of a scatter read, filling output with the bytes starting at offset into the file.
+struct VfsReadRequest {
+    std::span<u8> output;
+    std::size_t offset;
+};
+
 // An enumeration representing what can be at the end of a path in a VfsFilesystem
 enum class VfsEntryType {
     None,
@@ -105,6 +112,19 @@ public:
     // into file. Returns number of bytes successfully written.
     virtual std::size_t Write(const u8* data, std::size_t length, std::size_t offset = 0) = 0;
 
+    // Reads data.size() bytes starting at offset into file into data. Returns number of bytes
+    // successfully read.
+    std::size_t ReadInto(std::span<u8> data, std::size_t offset = 0) const {
+        return Read(data.data(), data.size(), offset);
+    }
+    // Serves several reads at once, layers forward the batch to the file they wrap without
+    // copying. Returns the total number of bytes successfully read.
+    virtual std::size_t ReadScatter(std::span<const VfsReadRequest> requests) const;
+
+    // Returns a view of up to length bytes starting at offset without copying them, or an empty
+    // span if the file is not backed by memory. The view is valid as long as the file is alive.
+    virtual std::span<const u8> GetReadView(std::size_t length, std::size_t offset = 0) const;
+
     // Reads exactly one byte at the offset provided, returning std::nullopt on error.
     virtual std::optional<u8> ReadByte(std::size_t offset = 0) const;
     // Reads size bytes starting at offset in file into a vector.
@@ -302,6 +322,12 @@ bool DeepEquals(const VirtualFile& file1, const VirtualFile& file2,
 // directory of src/dest.
 bool VfsRawCopy(const VirtualFile& src, const VirtualFile& dest, std::size_t block_size = 0x1000);
 
+// A method that performs a similar function to VfsRawCopy above, but reads the next block while the
+// current one is being written, so that reading and writing overlap. progress is called with the
+// size of every block written and may return false to cancel the copy, which truncates dest.
+bool VfsRawCopyPipelined(const VirtualFile& src, const VirtualFile& dest, std::size_t block_size,
+                         const std::function<bool(std::size_t)>& progress);
+
 // A method that performs a similar function to VfsRawCopy above, but instead copies entire
 // directories. It suffers the same performance penalties as above and an implementation-specific
 // Copy should always be preferred.
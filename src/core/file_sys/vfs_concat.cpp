@@ -25,16 +25,23 @@ static bool VerifyConcatenationMapContinuity(const std::multimap<u64, VirtualFil
 
 ConcatenatedVfsFile::ConcatenatedVfsFile(std::vector<VirtualFile> files_, std::string name_)
     : name(std::move(name_)) {
+    files.reserve(files_.size());
     std::size_t next_offset = 0;
-    for (const auto& file : files_) {
-        files.emplace(next_offset, file);
-        next_offset += file->GetSize();
+    for (auto& file : files_) {
+        const u64 size = file->GetSize();
+        files.push_back({next_offset, size, std::move(file)});
+        next_offset += size;
     }
 }
 
 ConcatenatedVfsFile::ConcatenatedVfsFile(std::multimap<u64, VirtualFile> files_, std::string name_)
-    : files(std::move(files_)), name(std::move(name_)) {
-    ASSERT(VerifyConcatenationMapContinuity(files));
+    : name(std::move(name_)) {
+    ASSERT(VerifyConcatenationMapContinuity(files_));
+    files.reserve(files_.size());
+    for (auto& [offset, file] : files_) {
+        const u64 size = file->GetSize();
+        files.push_back({offset, size, std::move(file)});
+    }
 }
 
 ConcatenatedVfsFile::~ConcatenatedVfsFile() = default;
@@ -81,14 +88,14 @@ std::string ConcatenatedVfsFile::GetName() const {
     if (!name.empty()) {
         return name;
     }
-    return files.begin()->second->GetName();
+    return files.front().file->GetName();
 }
 
 std::size_t ConcatenatedVfsFile::GetSize() const {
     if (files.empty()) {
         return 0;
     }
-    return files.rbegin()->first + files.rbegin()->second->GetSize();
+    return files.back().offset + files.back().size;
 }
 
 bool ConcatenatedVfsFile::Resize(std::size_t new_size) {
@@ -99,7 +106,7 @@ VirtualDir ConcatenatedVfsFile::GetContainingDirectory() const {
     if (files.empty()) {
         return nullptr;
     }
-    return files.begin()->second->GetContainingDirectory();
+    return files.front().file->GetContainingDirectory();
 }
 
 bool ConcatenatedVfsFile::IsWritable() const {
@@ -111,25 +118,31 @@ bool ConcatenatedVfsFile::IsReadable() const {
 }
 
 std::size_t ConcatenatedVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
-    auto entry = --files.end();
-    for (auto iter = files.begin(); iter != files.end(); ++iter) {
-        if (iter->first > offset) {
-            entry = --iter;
+    // Find the last part starting at or before the offset
+    auto entry = std::ranges::upper_bound(files, u64{offset}, {}, &ConcatenationEntry::offset);
+    if (entry == files.begin()) {
+        return 0;
+    }
+    --entry;
+
+    // Split the read across every part it spans
+    std::size_t read_size = 0;
+    for (; entry != files.end() && length > 0; ++entry) {
+        const u64 part_offset = offset - entry->offset;
+        if (part_offset >= entry->size) {
+            continue;
+        }
+        const std::size_t part_length = std::min<u64>(length, entry->size - part_offset);
+        const std::size_t part_read = entry->file->Read(data, part_length, part_offset);
+        read_size += part_read;
+        if (part_read != part_length) {
             break;
         }
+        data += part_read;
+        length -= part_read;
+        offset += part_read;
     }
-
-    if (entry->first + entry->second->GetSize() <= offset)
-        return 0;
-
-    const auto read_in =
-        std::min<u64>(entry->first + entry->second->GetSize() - offset, entry->second->GetSize());
-    if (length > read_in) {
-        return entry->second->Read(data, read_in, offset - entry->first) +
-               Read(data + read_in, length - read_in, offset + read_in);
-    }
-
-    return entry->second->Read(data, std::min<u64>(read_in, length), offset - entry->first);
+    return read_size;
 }
 
 std::size_t ConcatenatedVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
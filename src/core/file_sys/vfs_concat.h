@@ -7,6 +7,7 @@
 #include <map>
 #include <memory>
 #include <string_view>
+#include <vector>
 #include "core/file_sys/vfs.h"
 
 namespace FileSys {
@@ -39,8 +40,14 @@ public:
     bool Rename(std::string_view new_name) override;
 
 private:
-    // Maps starting offset to file -- more efficient.
-    std::multimap<u64, VirtualFile> files;
+    struct ConcatenationEntry {
+        u64 offset;
+        u64 size;
+        VirtualFile file;
+    };
+
+    // Parts of the file sorted by starting offset, searched with a binary search.
+    std::vector<ConcatenationEntry> files;
     std::string name;
 };
 
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
 #include <utility>
 
 #include "core/file_sys/vfs_offset.h"
@@ -57,6 +58,35 @@ std::size_t OffsetVfsFile::Write(const u8* data, std::size_t length, std::size_t
     return file->Write(data, TrimToFit(length, r_offset), offset + r_offset);
 }
 
+std::size_t OffsetVfsFile::ReadScatter(std::span<const VfsReadRequest> requests) const {
+    // Translate the requests in batches on the stack, so forwarding never allocates
+    constexpr std::size_t BATCH_SIZE = 16;
+    std::array<VfsReadRequest, BATCH_SIZE> batch;
+    std::size_t read_size = 0;
+    while (!requests.empty()) {
+        const std::size_t batch_size = std::min(requests.size(), BATCH_SIZE);
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            const VfsReadRequest& request = requests[i];
+            const std::size_t length =
+                request.offset < size ? TrimToFit(request.output.size(), request.offset) : 0;
+            batch[i] = {
+                .output = request.output.first(length),
+                .offset = offset + request.offset,
+            };
+        }
+        read_size += file->ReadScatter({batch.data(), batch_size});
+        requests = requests.subspan(batch_size);
+    }
+    return read_size;
+}
+
+std::span<const u8> OffsetVfsFile::GetReadView(std::size_t length, std::size_t r_offset) const {
+    if (r_offset >= size) {
+        return {};
+    }
+    return file->GetReadView(TrimToFit(length, r_offset), offset + r_offset);
+}
+
 std::optional<u8> OffsetVfsFile::ReadByte(std::size_t r_offset) const {
     if (r_offset >= size) {
         return std::nullopt;
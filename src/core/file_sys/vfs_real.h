@@ -11,7 +11,8 @@
 
 namespace Common::FS {
 class IOFile;
-}
+class MappedFile;
+} // namespace Common::FS
 
 namespace FileSys {
 
@@ -37,6 +38,7 @@ public:
 
 private:
     boost::container::flat_map<std::string, std::weak_ptr<Common::FS::IOFile>> cache;
+    boost::container::flat_map<std::string, std::weak_ptr<Common::FS::MappedFile>> mapped_cache;
 };
 
 // An implmentation of VfsFile that represents a file on the user's computer.
@@ -55,16 +57,20 @@ public:
     bool IsReadable() const override;
     std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
     std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    std::span<const u8> GetReadView(std::size_t length, std::size_t offset) const override;
     bool Rename(std::string_view name) override;
 
 private:
     RealVfsFile(RealVfsFilesystem& base, std::shared_ptr<Common::FS::IOFile> backing,
-                const std::string& path, Mode perms = Mode::Read);
+                const std::string& path, Mode perms = Mode::Read,
+                std::shared_ptr<Common::FS::MappedFile> mapping = nullptr);
 
     void Close();
 
     RealVfsFilesystem& base;
     std::shared_ptr<Common::FS::IOFile> backing;
+    /// Read-only mapping of the whole file, used instead of backing for reads when present
+    std::shared_ptr<Common::FS::MappedFile> mapping;
     std::string path;
     std::string parent_path;
     std::vector<std::string> path_components;
@@ -0,0 +1,349 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+#include "common/logging/log.h"
+#include "common/thread.h"
+#include "core/file_sys/vfs_write_back.h"
+
+namespace FileSys {
+
+// Buffered data is written back once it grows past this size
+constexpr std::size_t MAX_BUFFERED_SIZE = 16ULL * 1024 * 1024;
+// Buffered data is written back once its oldest write is this old
+constexpr std::chrono::seconds MAX_WRITE_AGE{5};
+// Period at which the age of the buffered data is checked
+constexpr std::chrono::seconds FLUSH_CHECK_PERIOD{1};
+
+WriteBackBuffer::WriteBackBuffer(VirtualFile base_) : base(std::move(base_)) {}
+
+WriteBackBuffer::~WriteBackBuffer() {
+    Flush();
+}
+
+void WriteBackBuffer::Attach(VirtualFile file) {
+    std::scoped_lock lock{mutex};
+    if (!base->IsWritable() && file->IsWritable()) {
+        base = std::move(file);
+    }
+}
+
+bool WriteBackBuffer::Flush() {
+    std::scoped_lock lock{mutex};
+    return FlushLocked();
+}
+
+void WriteBackBuffer::FlushIfOlderThan(std::chrono::steady_clock::duration age) {
+    std::scoped_lock lock{mutex};
+    // Data that failed to be written back is retried on the next flush or write instead
+    if (write_failed || !oldest_write || std::chrono::steady_clock::now() - *oldest_write < age) {
+        return;
+    }
+    FlushLocked();
+}
+
+std::string WriteBackBuffer::GetName() const {
+    std::scoped_lock lock{mutex};
+    return base->GetName();
+}
+
+std::size_t WriteBackBuffer::GetSize() const {
+    std::scoped_lock lock{mutex};
+    return GetSizeLocked();
+}
+
+bool WriteBackBuffer::Resize(std::size_t new_size) {
+    std::scoped_lock lock{mutex};
+    if (!FlushLocked()) {
+        return false;
+    }
+    return base->Resize(new_size);
+}
+
+VirtualDir WriteBackBuffer::GetContainingDirectory() const {
+    std::scoped_lock lock{mutex};
+    return base->GetContainingDirectory();
+}
+
+std::size_t WriteBackBuffer::Read(u8* data, std::size_t length, std::size_t offset) const {
+    std::scoped_lock lock{mutex};
+    const std::size_t size = GetSizeLocked();
+    if (offset >= size) {
+        return 0;
+    }
+    length = std::min(length, size - offset);
+
+    // Past the end of the file only buffered data exists, the gaps between it read as zeros
+    const std::size_t base_read = base->Read(data, length, offset);
+    std::memset(data + base_read, 0, length - base_read);
+
+    // Buffered data is newer than the file contents it overlaps
+    const std::size_t end = offset + length;
+    auto it = ranges.upper_bound(offset);
+    if (it != ranges.begin()) {
+        it = std::prev(it);
+    }
+    for (; it != ranges.end() && it->first < end; ++it) {
+        const auto& [range_offset, range_data] = *it;
+        const std::size_t copy_begin = std::max(range_offset, offset);
+        const std::size_t copy_end = std::min(range_offset + range_data.size(), end);
+        if (copy_begin < copy_end) {
+            std::memcpy(data + (copy_begin - offset),
+                        range_data.data() + (copy_begin - range_offset), copy_end - copy_begin);
+        }
+    }
+    return length;
+}
+
+std::size_t WriteBackBuffer::Write(const u8* data, std::size_t length, std::size_t offset) {
+    if (length == 0) {
+        return 0;
+    }
+    std::scoped_lock lock{mutex};
+    if (write_failed && !FlushLocked()) {
+        // Don't accept more data while the data already held can't be written back
+        return 0;
+    }
+    if (!oldest_write) {
+        oldest_write = std::chrono::steady_clock::now();
+    }
+
+    // Extend the range the write starts in or touches, or start a new one
+    const std::size_t end = offset + length;
+    auto it = ranges.upper_bound(offset);
+    if (it != ranges.begin()) {
+        const auto prev = std::prev(it);
+        if (prev->first + prev->second.size() >= offset) {
+            it = prev;
+        }
+    }
+    if (it == ranges.end() || it->first > offset) {
+        it = ranges.emplace_hint(it, offset, std::vector<u8>{});
+    }
+    const std::size_t begin = it->first;
+    std::vector<u8>& buffer = it->second;
+
+    // Absorb the following ranges the write overlaps or touches
+    const auto first_absorbed = std::next(it);
+    auto last_absorbed = first_absorbed;
+    std::size_t new_end = std::max(begin + buffer.size(), end);
+    for (; last_absorbed != ranges.end() && last_absorbed->first <= end; ++last_absorbed) {
+        new_end = std::max(new_end, last_absorbed->first + last_absorbed->second.size());
+    }
+    buffered_size -= buffer.size();
+    buffer.resize(new_end - begin);
+    for (auto absorbed = first_absorbed; absorbed != last_absorbed; ++absorbed) {
+        std::memcpy(buffer.data() + (absorbed->first - begin), absorbed->second.data(),
+                    absorbed->second.size());
+        buffered_size -= absorbed->second.size();
+    }
+    ranges.erase(first_absorbed, last_absorbed);
+
+    // The new data is copied last, it overrides the data it overlaps
+    std::memcpy(buffer.data() + (offset - begin), data, length);
+    buffered_size += buffer.size();
+
+    if (buffered_size >= MAX_BUFFERED_SIZE) {
+        FlushLocked();
+    }
+    return length;
+}
+
+bool WriteBackBuffer::Rename(std::string_view name) {
+    std::scoped_lock lock{mutex};
+    if (!FlushLocked()) {
+        return false;
+    }
+    return base->Rename(name);
+}
+
+std::string WriteBackBuffer::GetFullPath() const {
+    std::scoped_lock lock{mutex};
+    return base->GetFullPath();
+}
+
+bool WriteBackBuffer::FlushLocked() {
+    for (auto it = ranges.begin(); it != ranges.end();) {
+        const auto& [offset, data] = *it;
+        if (base->Write(data.data(), data.size(), offset) != data.size()) {
+            LOG_ERROR(Service_FS, "Failed to write back {} bytes at offset 0x{:X} of {}",
+                      data.size(), offset, base->GetFullPath());
+            ++it;
+            continue;
+        }
+        buffered_size -= data.size();
+        it = ranges.erase(it);
+    }
+    write_failed = !ranges.empty();
+    if (!write_failed) {
+        oldest_write.reset();
+    }
+    return !write_failed;
+}
+
+std::size_t WriteBackBuffer::GetSizeLocked() const {
+    const std::size_t base_size = base->GetSize();
+    if (ranges.empty()) {
+        return base_size;
+    }
+    const auto& [last_offset, last_data] = *ranges.rbegin();
+    return std::max(base_size, last_offset + last_data.size());
+}
+
+WriteBackVfsFile::WriteBackVfsFile(std::shared_ptr<WriteBackBuffer> buffer_, VirtualFile handle_)
+    : buffer(std::move(buffer_)), handle(std::move(handle_)) {}
+
+WriteBackVfsFile::~WriteBackVfsFile() {
+    // Closing a handle the file was written through writes the buffered data back
+    if (handle->IsWritable()) {
+        buffer->Flush();
+    }
+}
+
+bool WriteBackVfsFile::Flush() {
+    return buffer->Flush();
+}
+
+std::string WriteBackVfsFile::GetName() const {
+    return buffer->GetName();
+}
+
+std::size_t WriteBackVfsFile::GetSize() const {
+    return buffer->GetSize();
+}
+
+bool WriteBackVfsFile::Resize(std::size_t new_size) {
+    if (!handle->IsWritable()) {
+        return false;
+    }
+    return buffer->Resize(new_size);
+}
+
+VirtualDir WriteBackVfsFile::GetContainingDirectory() const {
+    return buffer->GetContainingDirectory();
+}
+
+bool WriteBackVfsFile::IsWritable() const {
+    return handle->IsWritable();
+}
+
+bool WriteBackVfsFile::IsReadable() const {
+    return handle->IsReadable();
+}
+
+std::size_t WriteBackVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    if (!handle->IsReadable()) {
+        return 0;
+    }
+    return buffer->Read(data, length, offset);
+}
+
+std::size_t WriteBackVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    if (!handle->IsWritable()) {
+        return 0;
+    }
+    return buffer->Write(data, length, offset);
+}
+
+bool WriteBackVfsFile::Rename(std::string_view name) {
+    if (!handle->IsWritable()) {
+        return false;
+    }
+    return buffer->Rename(name);
+}
+
+std::string WriteBackVfsFile::GetFullPath() const {
+    return buffer->GetFullPath();
+}
+
+WriteBackCache::WriteBackCache() = default;
+
+WriteBackCache::~WriteBackCache() = default;
+
+VirtualFile WriteBackCache::Open(VirtualFile file) {
+    std::string path = file->GetFullPath();
+    std::shared_ptr<WriteBackBuffer> buffer;
+    {
+        std::scoped_lock lock{mutex};
+        if (!flush_thread.joinable()) {
+            flush_thread = std::jthread([this](std::stop_token stop_token) {
+                FlushAgedWrites(stop_token);
+            });
+        }
+        auto it = buffers.find(path);
+        if (it != buffers.end()) {
+            buffer = it->second.lock();
+        }
+        if (buffer != nullptr && buffer->GetFullPath() != path) {
+            // The file the buffer belongs to was renamed since it was keyed
+            buffer = nullptr;
+        }
+        if (buffer == nullptr) {
+            // The file may have been renamed into this path, look again with fresh keys
+            CollectBuffers();
+            it = buffers.find(path);
+            if (it != buffers.end()) {
+                buffer = it->second.lock();
+            }
+        }
+        if (buffer == nullptr) {
+            buffer = std::make_shared<WriteBackBuffer>(file);
+            buffers.insert_or_assign(std::move(path), buffer);
+        }
+    }
+    buffer->Attach(file);
+    return std::make_shared<WriteBackVfsFile>(std::move(buffer), std::move(file));
+}
+
+bool WriteBackCache::FlushAll() {
+    std::vector<std::shared_ptr<WriteBackBuffer>> live_buffers;
+    {
+        std::scoped_lock lock{mutex};
+        live_buffers = CollectBuffers();
+    }
+    bool success = true;
+    for (const auto& buffer : live_buffers) {
+        if (!buffer->Flush()) {
+            success = false;
+        }
+    }
+    return success;
+}
+
+std::vector<std::shared_ptr<WriteBackBuffer>> WriteBackCache::CollectBuffers() {
+    std::vector<std::shared_ptr<WriteBackBuffer>> live_buffers;
+    live_buffers.reserve(buffers.size());
+    for (const auto& [path, weak] : buffers) {
+        if (auto buffer = weak.lock()) {
+            live_buffers.push_back(std::move(buffer));
+        }
+    }
+    buffers.clear();
+    for (const auto& buffer : live_buffers) {
+        buffers.try_emplace(buffer->GetFullPath(), buffer);
+    }
+    return live_buffers;
+}
+
+void WriteBackCache::FlushAgedWrites(std::stop_token stop_token) {
+    Common::SetCurrentThreadName("yuzu:FsWriteBack");
+    std::unique_lock lock{mutex};
+    while (!flush_cv.wait_for(lock, stop_token, FLUSH_CHECK_PERIOD, [] { return false; }) &&
+           !stop_token.stop_requested()) {
+        std::vector<std::shared_ptr<WriteBackBuffer>> live_buffers = CollectBuffers();
+        lock.unlock();
+        for (const auto& buffer : live_buffers) {
+            buffer->FlushIfOlderThan(MAX_WRITE_AGE);
+        }
+        // The last reference to a buffer may be dropped here, which flushes it without the lock
+        live_buffers.clear();
+        lock.lock();
+    }
+}
+
+} // namespace FileSys
@@ -0,0 +1,124 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "core/file_sys/vfs.h"
+
+namespace FileSys {
+
+// The writes buffered in memory for one file, shared by every handle the file is open with.
+// Overlapping and adjacent writes are merged, and the buffered data is written back to the file
+// in as few writes as possible when it is flushed, when too much of it has been buffered, when it
+// has been held for too long or when the last handle is closed. Reads see the buffered data.
+class WriteBackBuffer {
+public:
+    explicit WriteBackBuffer(VirtualFile base);
+    ~WriteBackBuffer();
+
+    WriteBackBuffer(const WriteBackBuffer&) = delete;
+    WriteBackBuffer& operator=(const WriteBackBuffer&) = delete;
+
+    // Makes the buffer write back through the given handle if the current one isn't writable
+    void Attach(VirtualFile file);
+
+    // Writes every buffered range to the file, returns false if any write failed. Ranges that
+    // failed to be written stay buffered.
+    bool Flush();
+
+    // Flushes the buffered data if its oldest write is at least the given age
+    void FlushIfOlderThan(std::chrono::steady_clock::duration age);
+
+    std::string GetName() const;
+    std::size_t GetSize() const;
+    bool Resize(std::size_t new_size);
+    VirtualDir GetContainingDirectory() const;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset);
+    bool Rename(std::string_view name);
+    std::string GetFullPath() const;
+
+private:
+    bool FlushLocked();
+
+    std::size_t GetSizeLocked() const;
+
+    VirtualFile base;
+
+    mutable std::mutex mutex;
+    // Buffered data keyed by offset, ranges never overlap nor touch each other
+    std::map<std::size_t, std::vector<u8>> ranges;
+    std::size_t buffered_size = 0;
+    std::optional<std::chrono::steady_clock::time_point> oldest_write;
+    // Set when buffered data could not be written back, more writes are refused until it is
+    bool write_failed = false;
+};
+
+// A handle to a file whose writes go through the buffer shared by every handle to that file
+class WriteBackVfsFile final : public VfsFile {
+public:
+    explicit WriteBackVfsFile(std::shared_ptr<WriteBackBuffer> buffer, VirtualFile handle);
+    ~WriteBackVfsFile() override;
+
+    // Writes every buffered range of the file back, returns false if any write failed
+    bool Flush();
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    VirtualDir GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    bool Rename(std::string_view name) override;
+    std::string GetFullPath() const override;
+
+private:
+    std::shared_ptr<WriteBackBuffer> buffer;
+    VirtualFile handle;
+};
+
+// Hands out the write back handles of files, keyed by path so every handle to a file shares the
+// same buffered writes. A background thread writes back the data held for too long.
+class WriteBackCache {
+public:
+    WriteBackCache();
+    ~WriteBackCache();
+
+    WriteBackCache(const WriteBackCache&) = delete;
+    WriteBackCache& operator=(const WriteBackCache&) = delete;
+
+    // Returns a handle reading and writing the given file through its shared buffer
+    VirtualFile Open(VirtualFile file);
+
+    // Writes back the buffered data of every file, returns false if any write failed
+    bool FlushAll();
+
+private:
+    // Returns the buffers of the files still open, keying them again by their current path
+    std::vector<std::shared_ptr<WriteBackBuffer>> CollectBuffers();
+
+    void FlushAgedWrites(std::stop_token stop_token);
+
+    std::mutex mutex;
+    std::condition_variable_any flush_cv;
+    std::unordered_map<std::string, std::weak_ptr<WriteBackBuffer>> buffers;
+    std::jthread flush_thread;
+};
+
+} // namespace FileSys
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <tuple>
 #include <utility>
 #include "common/common_types.h"
@@ -163,9 +164,11 @@ public:
 
     /**
      * Gets the framebuffer layout (width, height, and screen regions)
-     * @note This method is thread-safe
+     * @note This method is thread-safe, the renderer picks up layouts published by the window
+     *       thread without ever waiting on it
      */
-    const Layout::FramebufferLayout& GetFramebufferLayout() const {
+    Layout::FramebufferLayout GetFramebufferLayout() const {
+        std::scoped_lock lock{framebuffer_layout_mutex};
         return framebuffer_layout;
     }
 
@@ -201,6 +204,7 @@ protected:
      * @note EmuWindow implementations will usually use this in window resize event handlers.
      */
     void NotifyFramebufferLayoutChanged(const Layout::FramebufferLayout& layout) {
+        std::scoped_lock lock{framebuffer_layout_mutex};
         framebuffer_layout = layout;
     }
 
@@ -231,6 +235,8 @@ private:
     std::pair<u32, u32> ClipToTouchScreen(u32 new_x, u32 new_y) const;
 
     Layout::FramebufferLayout framebuffer_layout; ///< Current framebuffer layout
+    /// Guards framebuffer_layout, which is written by the window and read by the renderer
+    mutable std::mutex framebuffer_layout_mutex;
 
     u32 client_area_width;  ///< Current client width, should be set by window impl.
     u32 client_area_height; ///< Current client height, should be set by window impl.
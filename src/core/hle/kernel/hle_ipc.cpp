@@ -72,6 +72,39 @@ HLERequestContext::HLERequestContext(KernelCore& kernel_, Core::Memory::Memory&
 
 HLERequestContext::~HLERequestContext() = default;
 
+void HLERequestContext::Reset(KServerSession* server_session_, KThread* thread_) {
+    server_session = server_session_;
+    thread = thread_;
+    cmd_buf[0] = 0;
+
+    incoming_move_handles.clear();
+    incoming_copy_handles.clear();
+    outgoing_move_objects.clear();
+    outgoing_copy_objects.clear();
+    outgoing_domain_objects.clear();
+
+    command_header.reset();
+    handle_descriptor_header.reset();
+    data_payload_header.reset();
+    domain_message_header.reset();
+    buffer_x_desciptors.clear();
+    buffer_a_desciptors.clear();
+    buffer_b_desciptors.clear();
+    buffer_w_desciptors.clear();
+    buffer_c_desciptors.clear();
+
+    command = 0;
+    pid = 0;
+    write_size = 0;
+    data_payload_offset = 0;
+    handles_offset = 0;
+    domain_offset = 0;
+
+    manager.reset();
+    is_thread_waiting = false;
+    read_buffer_copies.clear();
+}
+
 void HLERequestContext::ParseCommandBuffer(const KHandleTable& handle_table, u32_le* src_cmdbuf,
                                            bool incoming) {
     IPC::RequestParser rp(src_cmdbuf);
@@ -263,6 +296,30 @@ std::vector<u8> HLERequestContext::ReadBuffer(std::size_t buffer_index) const {
     return buffer;
 }
 
+std::span<const u8> HLERequestContext::ReadBufferSpan(std::size_t buffer_index) const {
+    const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
+                           BufferDescriptorA()[buffer_index].Size()};
+    if (!is_buffer_a) {
+        ASSERT_OR_EXECUTE_MSG(
+            BufferDescriptorX().size() > buffer_index, { return {}; },
+            "BufferDescriptorX invalid buffer_index {}", buffer_index);
+    }
+    const VAddr address = is_buffer_a ? BufferDescriptorA()[buffer_index].Address()
+                                      : BufferDescriptorX()[buffer_index].Address();
+    const std::size_t size = is_buffer_a ? BufferDescriptorA()[buffer_index].Size()
+                                         : BufferDescriptorX()[buffer_index].Size();
+    if (size == 0) {
+        return {};
+    }
+    if (const u8* const pointer = memory.GetContiguousPointer(address, size)) {
+        return {pointer, size};
+    }
+    // The buffer is not contiguous in host memory or has to be flushed from the GPU, copy it
+    std::vector<u8>& buffer = read_buffer_copies.emplace_back(size);
+    memory.ReadBlock(address, buffer.data(), buffer.size());
+    return buffer;
+}
+
 std::size_t HLERequestContext::WriteBuffer(const void* buffer, std::size_t size,
                                            std::size_t buffer_index) const {
     if (size == 0) {
@@ -296,6 +353,25 @@ std::size_t HLERequestContext::WriteBuffer(const void* buffer, std::size_t size,
     return size;
 }
 
+std::span<u8> HLERequestContext::WriteBufferSpan(std::size_t buffer_index) const {
+    const bool is_buffer_b{BufferDescriptorB().size() > buffer_index &&
+                           BufferDescriptorB()[buffer_index].Size()};
+    if (!is_buffer_b && BufferDescriptorC().size() <= buffer_index) {
+        return {};
+    }
+    const VAddr address = is_buffer_b ? BufferDescriptorB()[buffer_index].Address()
+                                      : BufferDescriptorC()[buffer_index].Address();
+    const std::size_t size = is_buffer_b ? BufferDescriptorB()[buffer_index].Size()
+                                         : BufferDescriptorC()[buffer_index].Size();
+    if (size == 0) {
+        return {};
+    }
+    if (u8* const pointer = memory.GetContiguousPointer(address, size)) {
+        return {pointer, size};
+    }
+    return {};
+}
+
 std::size_t HLERequestContext::GetReadBufferSize(std::size_t buffer_index) const {
     const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
                            BufferDescriptorA()[buffer_index].Size()};
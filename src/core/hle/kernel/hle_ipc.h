@@ -8,6 +8,7 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -192,6 +193,10 @@ public:
                                KServerSession* session, KThread* thread);
     ~HLERequestContext();
 
+    /// Clears the state of a previous request so the context can be reused for a new one.
+    /// Allocations made for buffer descriptors and objects are kept.
+    void Reset(KServerSession* session, KThread* thread);
+
     /// Returns a pointer to the IPC command buffer for this request.
     u32* CommandBuffer() {
         return cmd_buf.data();
@@ -268,10 +273,25 @@ public:
     /// Helper function to read a buffer using the appropriate buffer descriptor
     std::vector<u8> ReadBuffer(std::size_t buffer_index = 0) const;
 
+    /**
+     * Helper function to get a view of a buffer using the appropriate buffer descriptor. Buffers
+     * backed by contiguous host memory are not copied, so the view aliases guest memory and
+     * reflects writes done to it after this call. The view is valid while the context is alive.
+     */
+    std::span<const u8> ReadBufferSpan(std::size_t buffer_index = 0) const;
+
     /// Helper function to write a buffer using the appropriate buffer descriptor
     std::size_t WriteBuffer(const void* buffer, std::size_t size,
                             std::size_t buffer_index = 0) const;
 
+    /**
+     * Helper function to get a writable view of the buffer selected by the appropriate buffer
+     * descriptor, so that data can be produced directly into guest memory. Returns an empty span
+     * when the buffer is empty or not backed by contiguous host memory; WriteBuffer has to be
+     * used in that case.
+     */
+    std::span<u8> WriteBufferSpan(std::size_t buffer_index = 0) const;
+
     /* Helper function to write a buffer using the appropriate buffer descriptor
      *
      * @tparam T an arbitrary container that satisfies the
@@ -381,6 +401,9 @@ private:
     std::shared_ptr<SessionRequestManager> manager;
     bool is_thread_waiting{};
 
+    /// Storage for buffers read with ReadBufferSpan that had to be copied
+    mutable std::vector<std::vector<u8>> read_buffer_copies;
+
     KernelCore& kernel;
     Core::Memory::Memory& memory;
 };
@@ -71,15 +71,7 @@ public:
         // Lock and look up in table.
         KScopedSpinLock lk(m_lock);
 
-        if constexpr (std::is_same_v<T, KAutoObject>) {
-            return this->GetObjectImpl(handle);
-        } else {
-            if (auto* obj = this->GetObjectImpl(handle); obj != nullptr) {
-                return obj->DynamicCast<T*>();
-            } else {
-                return nullptr;
-            }
-        }
+        return this->template GetTypedObjectImpl<T>(handle);
     }
 
     template <typename T = KAutoObject>
@@ -128,14 +120,8 @@ public:
                 // Get the current handle.
                 const auto cur_handle = handles[num_opened];
 
-                // Get the object for the current handle.
-                KAutoObject* cur_object = this->GetObjectImpl(cur_handle);
-                if (cur_object == nullptr) {
-                    break;
-                }
-
-                // Cast the current object to the desired type.
-                T* cur_t = cur_object->DynamicCast<T*>();
+                // Get the object for the current handle, cast to the desired type.
+                T* cur_t = this->template GetTypedObjectImpl<T>(cur_handle);
                 if (cur_t == nullptr) {
                     break;
                 }
@@ -239,6 +225,27 @@ private:
         }
     }
 
+    /// Looks up the object of a handle and casts it to T. The type is checked against the class
+    /// token stored in the entry, so the object itself is only touched once it's known to match.
+    template <typename T>
+    T* GetTypedObjectImpl(Handle handle) const {
+        // Handles must not have reserved bits set.
+        const auto handle_pack = HandlePack(handle);
+        if (handle_pack.reserved != 0 || !this->IsValidHandle(handle)) {
+            return nullptr;
+        }
+
+        const auto index = handle_pack.index;
+        if constexpr (!std::is_same_v<T, KAutoObject>) {
+            constexpr ClassTokenType Token = T::GetStaticTypeObj().GetClassToken();
+            const ClassTokenType entry_token = m_entry_infos[index].GetType();
+            if ((entry_token | Token) != entry_token) {
+                return nullptr;
+            }
+        }
+        return static_cast<T*>(m_objects[index]);
+    }
+
     KAutoObject* GetObjectByIndexImpl(Handle* out_handle, size_t index) const {
 
         // Index must be in bounds.
@@ -10,20 +10,17 @@ namespace Kernel {
 KMemoryBlockManager::KMemoryBlockManager(VAddr start_addr_, VAddr end_addr_)
     : start_addr{start_addr_}, end_addr{end_addr_} {
     const u64 num_pages{(end_addr - start_addr) / PageSize};
-    memory_block_tree.emplace_back(start_addr, num_pages, KMemoryState::Free,
-                                   KMemoryPermission::None, KMemoryAttribute::None);
+    KMemoryBlock* const block{AllocateBlock()};
+    *block = KMemoryBlock(start_addr, num_pages, KMemoryState::Free, KMemoryPermission::None,
+                          KMemoryAttribute::None);
+    memory_block_tree.insert(*block);
 }
 
+KMemoryBlockManager::~KMemoryBlockManager() = default;
+
 KMemoryBlockManager::iterator KMemoryBlockManager::FindIterator(VAddr addr) {
-    auto node{memory_block_tree.begin()};
-    while (node != end()) {
-        const VAddr node_end_addr{node->GetNumPages() * PageSize + node->GetAddress()};
-        if (node->GetAddress() <= addr && node_end_addr - 1 >= addr) {
-            return node;
-        }
-        node = std::next(node);
-    }
-    return end();
+    return memory_block_tree.find(KMemoryBlock(addr, 1, KMemoryState::Free,
+                                               KMemoryPermission::None, KMemoryAttribute::None));
 }
 
 VAddr KMemoryBlockManager::FindFreeArea(VAddr region_start, std::size_t region_num_pages,
@@ -35,7 +32,7 @@ VAddr KMemoryBlockManager::FindFreeArea(VAddr region_start, std::size_t region_n
 
     const VAddr region_end{region_start + region_num_pages * PageSize};
     const VAddr region_last{region_end - 1};
-    for (auto it{FindIterator(region_start)}; it != memory_block_tree.cend(); it++) {
+    for (auto it{FindIterator(region_start)}; it != end(); it++) {
         const auto info{it->GetMemoryInfo()};
         if (region_last < info.GetAddress()) {
             break;
@@ -68,7 +65,7 @@ void KMemoryBlockManager::Update(VAddr addr, std::size_t num_pages, KMemoryState
                                  KMemoryState state, KMemoryPermission perm,
                                  KMemoryAttribute attribute) {
     const VAddr update_end_addr{addr + num_pages * PageSize};
-    iterator node{memory_block_tree.begin()};
+    iterator node{FindIterator(addr)};
 
     prev_attribute |= KMemoryAttribute::IpcAndDeviceMapped;
 
@@ -86,11 +83,11 @@ void KMemoryBlockManager::Update(VAddr addr, std::size_t num_pages, KMemoryState
 
             iterator new_node{node};
             if (addr > cur_addr) {
-                memory_block_tree.insert(node, block->Split(addr));
+                SplitBlock(node, addr);
             }
 
             if (update_end_addr < cur_end_addr) {
-                new_node = memory_block_tree.insert(node, block->Split(update_end_addr));
+                new_node = SplitBlock(node, update_end_addr);
             }
 
             new_node->Update(state, perm, attribute);
@@ -109,7 +106,7 @@ void KMemoryBlockManager::Update(VAddr addr, std::size_t num_pages, KMemoryState
 void KMemoryBlockManager::Update(VAddr addr, std::size_t num_pages, KMemoryState state,
                                  KMemoryPermission perm, KMemoryAttribute attribute) {
     const VAddr update_end_addr{addr + num_pages * PageSize};
-    iterator node{memory_block_tree.begin()};
+    iterator node{FindIterator(addr)};
 
     while (node != memory_block_tree.end()) {
         KMemoryBlock* block{&(*node)};
@@ -121,11 +118,11 @@ void KMemoryBlockManager::Update(VAddr addr, std::size_t num_pages, KMemoryState
             iterator new_node{node};
 
             if (addr > cur_addr) {
-                memory_block_tree.insert(node, block->Split(addr));
+                SplitBlock(node, addr);
             }
 
             if (update_end_addr < cur_end_addr) {
-                new_node = memory_block_tree.insert(node, block->Split(update_end_addr));
+                new_node = SplitBlock(node, update_end_addr);
             }
 
             new_node->Update(state, perm, attribute);
@@ -144,7 +141,7 @@ void KMemoryBlockManager::Update(VAddr addr, std::size_t num_pages, KMemoryState
 void KMemoryBlockManager::UpdateLock(VAddr addr, std::size_t num_pages, LockFunc&& lock_func,
                                      KMemoryPermission perm) {
     const VAddr update_end_addr{addr + num_pages * PageSize};
-    iterator node{memory_block_tree.begin()};
+    iterator node{FindIterator(addr)};
 
     while (node != memory_block_tree.end()) {
         KMemoryBlock* block{&(*node)};
@@ -156,11 +153,11 @@ void KMemoryBlockManager::UpdateLock(VAddr addr, std::size_t num_pages, LockFunc
             iterator new_node{node};
 
             if (addr > cur_addr) {
-                memory_block_tree.insert(node, block->Split(addr));
+                SplitBlock(node, addr);
             }
 
             if (update_end_addr < cur_end_addr) {
-                new_node = memory_block_tree.insert(node, block->Split(update_end_addr));
+                new_node = SplitBlock(node, update_end_addr);
             }
 
             lock_func(new_node, perm);
@@ -186,6 +183,13 @@ void KMemoryBlockManager::IterateForRange(VAddr start, VAddr end, IterateFunc&&
     } while (info.addr + info.size - 1 < end - 1 && it != cend());
 }
 
+KMemoryBlockManager::iterator KMemoryBlockManager::SplitBlock(iterator node, VAddr split_addr) {
+    // The lower half keeps its place in the ordering, as the split block now starts after it
+    KMemoryBlock* const block{AllocateBlock()};
+    node->Split(block, split_addr);
+    return memory_block_tree.insert(*block);
+}
+
 void KMemoryBlockManager::MergeAdjacent(iterator it, iterator& next_it) {
     KMemoryBlock* block{&(*it)};
 
@@ -193,15 +197,16 @@ void KMemoryBlockManager::MergeAdjacent(iterator it, iterator& next_it) {
         if (next_it == it_to_erase) {
             next_it = std::next(next_it);
         }
+        KMemoryBlock* const erased_block{&(*it_to_erase)};
         memory_block_tree.erase(it_to_erase);
+        FreeBlock(erased_block);
     };
 
     if (it != memory_block_tree.begin()) {
-        KMemoryBlock* prev{&(*std::prev(it))};
+        const iterator prev_it{std::prev(it)};
+        KMemoryBlock* prev{&(*prev_it)};
 
         if (block->HasSameProperties(*prev)) {
-            const iterator prev_it{std::prev(it)};
-
             prev->Add(block->GetNumPages());
             EraseIt(it);
 
@@ -210,14 +215,32 @@ void KMemoryBlockManager::MergeAdjacent(iterator it, iterator& next_it) {
         }
     }
 
-    if (it != cend()) {
-        const KMemoryBlock* const next{&(*std::next(it))};
+    if (const iterator following_it{std::next(it)}; following_it != end()) {
+        const KMemoryBlock* const next{&(*following_it)};
 
         if (block->HasSameProperties(*next)) {
             block->Add(next->GetNumPages());
-            EraseIt(std::next(it));
+            EraseIt(following_it);
         }
     }
 }
 
+KMemoryBlock* KMemoryBlockManager::AllocateBlock() {
+    if (free_blocks.empty()) {
+        auto& chunk = slab_chunks.emplace_back(std::make_unique<KMemoryBlock[]>(SlabChunkSize));
+        free_blocks.reserve(free_blocks.capacity() + SlabChunkSize);
+        for (std::size_t i = SlabChunkSize; i > 0; --i) {
+            free_blocks.push_back(&chunk[i - 1]);
+        }
+    }
+    KMemoryBlock* const block{free_blocks.back()};
+    free_blocks.pop_back();
+    return block;
+}
+
+void KMemoryBlockManager::FreeBlock(KMemoryBlock* block) {
+    *block = KMemoryBlock{};
+    free_blocks.push_back(block);
+}
+
 } // namespace Kernel
@@ -5,7 +5,8 @@
 #pragma once
 
 #include <functional>
-#include <list>
+#include <memory>
+#include <vector>
 
 #include "common/common_types.h"
 #include "core/hle/kernel/k_memory_block.h"
@@ -14,12 +15,17 @@ namespace Kernel {
 
 class KMemoryBlockManager final {
 public:
-    using MemoryBlockTree = std::list<KMemoryBlock>;
+    using MemoryBlockTree =
+        Common::IntrusiveRedBlackTreeBaseTraits<KMemoryBlock>::TreeType<KMemoryBlock>;
     using iterator = MemoryBlockTree::iterator;
     using const_iterator = MemoryBlockTree::const_iterator;
 
 public:
     KMemoryBlockManager(VAddr start_addr_, VAddr end_addr_);
+    ~KMemoryBlockManager();
+
+    KMemoryBlockManager(const KMemoryBlockManager&) = delete;
+    KMemoryBlockManager& operator=(const KMemoryBlockManager&) = delete;
 
     iterator end() {
         return memory_block_tree.end();
@@ -56,12 +62,25 @@ public:
     }
 
 private:
+    /// Number of blocks allocated at once when the slab runs out of free blocks
+    static constexpr std::size_t SlabChunkSize = 256;
+
+    /// Splits the block pointed by node at split_addr, returns the newly inserted lower half
+    iterator SplitBlock(iterator node, VAddr split_addr);
+
     void MergeAdjacent(iterator it, iterator& next_it);
 
+    KMemoryBlock* AllocateBlock();
+    void FreeBlock(KMemoryBlock* block);
+
     [[maybe_unused]] const VAddr start_addr;
     [[maybe_unused]] const VAddr end_addr;
 
     MemoryBlockTree memory_block_tree;
+
+    // Blocks are linked into the tree intrusively, their storage is owned by this slab
+    std::vector<std::unique_ptr<KMemoryBlock[]>> slab_chunks;
+    std::vector<KMemoryBlock*> free_blocks;
 };
 
 } // namespace Kernel
@@ -8,12 +8,16 @@
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "common/scope_exit.h"
+#include "core/device_memory.h"
 #include "core/hle/kernel/k_memory_manager.h"
 #include "core/hle/kernel/k_page_linked_list.h"
 #include "core/hle/kernel/svc_results.h"
 
 namespace Kernel {
 
+KMemoryManager::KMemoryManager(Core::DeviceMemory& device_memory_)
+    : device_memory{device_memory_} {}
+
 std::size_t KMemoryManager::Impl::Initialize(Pool new_pool, u64 start_address, u64 end_address) {
     const auto size{end_address - start_address};
 
@@ -146,6 +150,7 @@ ResultCode KMemoryManager::Allocate(KPageLinkedList& page_list, std::size_t num_
 
     // We succeeded!
     group_guard.Cancel();
+    device_memory.Commit(page_list.GetNumPages() * PageSize);
     return ResultSuccess;
 }
 
@@ -168,6 +173,7 @@ ResultCode KMemoryManager::Free(KPageLinkedList& page_list, std::size_t num_page
         const auto min_num_pages{std::min<size_t>(
             it.GetNumPages(), (chosen_manager.GetEndAddress() - it.GetAddress()) / PageSize)};
         chosen_manager.Free(it.GetAddress(), min_num_pages);
+        device_memory.Decommit(it.GetAddress(), min_num_pages * PageSize);
     }
 
     return ResultSuccess;
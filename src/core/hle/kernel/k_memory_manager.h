@@ -13,6 +13,10 @@
 #include "core/hle/kernel/k_page_heap.h"
 #include "core/hle/result.h"
 
+namespace Core {
+class DeviceMemory;
+}
+
 namespace Kernel {
 
 class KPageLinkedList;
@@ -43,7 +47,7 @@ public:
         Mask = (0xF << Shift),
     };
 
-    KMemoryManager() = default;
+    explicit KMemoryManager(Core::DeviceMemory& device_memory_);
 
     constexpr std::size_t GetSize(Pool pool) const {
         return managers[static_cast<std::size_t>(pool)].GetSize();
@@ -130,6 +134,7 @@ private:
     };
 
 private:
+    Core::DeviceMemory& device_memory;
     std::array<std::mutex, static_cast<std::size_t>(Pool::Count)> pool_locks;
     std::array<Impl, MaxManagerCount> managers;
 };
@@ -7,6 +7,7 @@
 #include "common/literals.h"
 #include "common/scope_exit.h"
 #include "core/core.h"
+#include "core/device_memory.h"
 #include "core/hle/kernel/k_address_space_info.h"
 #include "core/hle/kernel/k_memory_block.h"
 #include "core/hle/kernel/k_memory_block_manager.h"
@@ -886,6 +887,13 @@ ResultVal<VAddr> KPageTable::AllocateAndMapMemory(std::size_t needed_num_pages,
         KPageLinkedList page_group;
         CASCADE_CODE(
             system.Kernel().MemoryManager().Allocate(page_group, needed_num_pages, memory_pool));
+        if (state == KMemoryState::Stack) {
+            // Stacks are mostly untouched, clearing them releases any host pages left behind by
+            // previous users instead of committing the whole stack up front
+            for (const auto& node : page_group.Nodes()) {
+                system.DeviceMemory().ClearRange(node.GetAddress(), node.GetNumPages() * PageSize);
+            }
+        }
         CASCADE_CODE(Operate(addr, needed_num_pages, page_group, OperationType::MapGroup));
     }
 
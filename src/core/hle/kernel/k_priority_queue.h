@@ -164,6 +164,7 @@ public:
 
             if (this->queues[priority].PushBack(core, member)) {
                 this->available_priorities[core].SetBit(priority);
+                this->available_cores |= u64(1) << core;
             }
         }
 
@@ -177,6 +178,7 @@ public:
 
             if (this->queues[priority].PushFront(core, member)) {
                 this->available_priorities[core].SetBit(priority);
+                this->available_cores |= u64(1) << core;
             }
         }
 
@@ -190,9 +192,16 @@ public:
 
             if (this->queues[priority].Remove(core, member)) {
                 this->available_priorities[core].ClearBit(priority);
+                if (this->available_priorities[core].CountLeadingZero() > LowestPriority) {
+                    this->available_cores &= ~(u64(1) << core);
+                }
             }
         }
 
+        constexpr u64 GetAvailableCores() const {
+            return this->available_cores;
+        }
+
         constexpr Member* GetFront(s32 core) const {
             ASSERT(IsValidCore(core));
 
@@ -256,6 +265,7 @@ public:
     private:
         std::array<KPerCoreQueue, NumPriority> queues{};
         std::array<Common::BitSet64<NumPriority>, NumCores> available_priorities{};
+        u64 available_cores{};
     };
 
 private:
@@ -342,6 +352,11 @@ public:
         return this->suggested_queue.GetFront(priority, core);
     }
 
+    // Mask of the cores that have at least one thread suggested for them.
+    constexpr u64 GetSuggestedCores() const {
+        return this->suggested_queue.GetAvailableCores();
+    }
+
     constexpr Member* GetScheduledNext(s32 core, const Member* member) const {
         return this->scheduled_queue.GetNext(core, member);
     }
@@ -445,7 +445,7 @@ VAddr KProcess::CreateTLSRegion() {
 
     ASSERT(tls_page_addr);
 
-    std::memset(tls_page_ptr, 0, PageSize);
+    kernel.System().DeviceMemory().ClearRange(tls_map_addr, PageSize);
     tls_pages.emplace_back(tls_page_addr);
 
     const auto reserve_result{tls_pages.back().ReserveSlot()};
@@ -127,6 +127,9 @@ u64 KScheduler::UpdateHighestPriorityThreadsImpl(KernelCore& kernel) {
     }
 
     // Idle cores are bad. We're going to try to migrate threads to each idle core in turn.
+    // Migrations only add suggestions for cores that have a scheduled thread, so idle cores
+    // without suggested threads can be skipped up front.
+    idle_cores &= priority_queue.GetSuggestedCores();
     while (idle_cores != 0) {
         const auto core_id = static_cast<u32>(std::countr_zero(idle_cores));
         if (KThread* suggested = priority_queue.GetSuggestedFront(core_id); suggested != nullptr) {
@@ -116,7 +116,9 @@ ResultCode KServerSession::HandleDomainSyncRequest(Kernel::HLERequestContext& co
 
 ResultCode KServerSession::QueueSyncRequest(KThread* thread, Core::Memory::Memory& memory) {
     u32* cmd_buf{reinterpret_cast<u32*>(memory.GetPointer(thread->GetTLSAddress()))};
-    auto context = std::make_shared<HLERequestContext>(kernel, memory, this, thread);
+    const auto service_thread = manager->GetServiceThread().lock();
+    auto context = service_thread ? service_thread->AcquireContext(memory, this, thread)
+                                  : std::make_unique<HLERequestContext>(kernel, memory, this, thread);
 
     context->PopulateFromIncomingCommandBuffer(kernel.CurrentProcess()->GetHandleTable(), cmd_buf);
 
@@ -129,13 +131,13 @@ ResultCode KServerSession::QueueSyncRequest(KThread* thread, Core::Memory::Memor
 
     // Ensure we have a session request handler
     if (manager->HasSessionRequestHandler(*context)) {
-        if (auto strong_ptr = manager->GetServiceThread().lock()) {
-            strong_ptr->QueueSyncRequest(*parent, std::move(context));
+        if (service_thread) {
+            service_thread->QueueSyncRequest(*parent, std::move(context));
 
             // We succeeded.
             error_guard.Cancel();
         } else {
-            ASSERT_MSG(false, "strong_ptr is nullptr!");
+            ASSERT_MSG(false, "service_thread is nullptr!");
         }
     } else {
         ASSERT_MSG(false, "handler is invalid!");
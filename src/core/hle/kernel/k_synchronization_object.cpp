@@ -21,12 +21,13 @@ void KSynchronizationObject::Finalize() {
 ResultCode KSynchronizationObject::Wait(KernelCore& kernel_ctx, s32* out_index,
                                         KSynchronizationObject** objects, const s32 num_objects,
                                         s64 timeout) {
-    // Allocate space on stack for thread nodes.
-    std::vector<ThreadListNode> thread_nodes(num_objects);
-
     // Prepare for wait.
     KThread* thread = kernel_ctx.CurrentScheduler()->GetCurrentThread();
 
+    // Use the thread nodes owned by the thread, waits never allocate.
+    auto& thread_nodes = thread->GetSynchronizationNodes();
+    ASSERT(num_objects <= static_cast<s32>(thread_nodes.size()));
+
     {
         // Setup the scheduling lock and sleep.
         KScopedSchedulerLockAndSleep slp{kernel_ctx, thread, timeout};
@@ -64,16 +65,9 @@ ResultCode KSynchronizationObject::Wait(KernelCore& kernel_ctx, s32* out_index,
         // Add the waiters.
         for (auto i = 0; i < num_objects; ++i) {
             thread_nodes[i].thread = thread;
-            thread_nodes[i].next = nullptr;
-
-            if (objects[i]->thread_list_tail == nullptr) {
-                objects[i]->thread_list_head = std::addressof(thread_nodes[i]);
-            } else {
-                objects[i]->thread_list_tail->next = std::addressof(thread_nodes[i]);
-            }
-
-            objects[i]->thread_list_tail = std::addressof(thread_nodes[i]);
+            objects[i]->LinkNode(std::addressof(thread_nodes[i]));
         }
+        thread->SetNumSynchronizationNodes(num_objects);
 
         // For debugging only
         thread->SetWaitObjectsForDebugging({objects, static_cast<std::size_t>(num_objects)});
@@ -105,29 +99,14 @@ ResultCode KSynchronizationObject::Wait(KernelCore& kernel_ctx, s32* out_index,
         wait_result = thread->GetWaitResult(std::addressof(synced_obj));
 
         for (auto i = 0; i < num_objects; ++i) {
-            // Unlink the object from the list.
-            ThreadListNode* prev_ptr =
-                reinterpret_cast<ThreadListNode*>(std::addressof(objects[i]->thread_list_head));
-            ThreadListNode* prev_val = nullptr;
-            ThreadListNode *prev, *tail_prev;
-
-            do {
-                prev = prev_ptr;
-                prev_ptr = prev_ptr->next;
-                tail_prev = prev_val;
-                prev_val = prev_ptr;
-            } while (prev_ptr != std::addressof(thread_nodes[i]));
-
-            if (objects[i]->thread_list_tail == std::addressof(thread_nodes[i])) {
-                objects[i]->thread_list_tail = tail_prev;
-            }
-
-            prev->next = thread_nodes[i].next;
-
             if (objects[i] == synced_obj) {
                 sync_index = i;
+                break;
             }
         }
+
+        // A signal already unlinked the nodes, timeouts and cancellations leave them linked.
+        UnlinkWaiter(thread);
     }
 
     // Set output.
@@ -149,13 +128,62 @@ void KSynchronizationObject::NotifyAvailable(ResultCode result) {
     }
 
     // Iterate over each thread.
-    for (auto* cur_node = thread_list_head; cur_node != nullptr; cur_node = cur_node->next) {
+    for (auto* cur_node = thread_list_head; cur_node != nullptr;) {
         KThread* thread = cur_node->thread;
+
+        // The nodes of a wait are linked together, skip the ones of this thread before they are
+        // unlinked below.
+        auto* next_node = cur_node->next;
+        while (next_node != nullptr && next_node->thread == thread) {
+            next_node = next_node->next;
+        }
+
         if (thread->GetState() == ThreadState::Waiting) {
             thread->SetSyncedObject(this, result);
             thread->SetState(ThreadState::Runnable);
+
+            // The thread is satisfied, remove it from every list so later signals skip it.
+            UnlinkWaiter(thread);
+        }
+        cur_node = next_node;
+    }
+}
+
+void KSynchronizationObject::LinkNode(ThreadListNode* thread_node) {
+    thread_node->object = this;
+    thread_node->prev = thread_list_tail;
+    thread_node->next = nullptr;
+
+    if (thread_list_tail == nullptr) {
+        thread_list_head = thread_node;
+    } else {
+        thread_list_tail->next = thread_node;
+    }
+    thread_list_tail = thread_node;
+}
+
+void KSynchronizationObject::UnlinkNode(ThreadListNode* thread_node) {
+    if (thread_node->prev == nullptr) {
+        thread_list_head = thread_node->next;
+    } else {
+        thread_node->prev->next = thread_node->next;
+    }
+    if (thread_node->next == nullptr) {
+        thread_list_tail = thread_node->prev;
+    } else {
+        thread_node->next->prev = thread_node->prev;
+    }
+    thread_node->object = nullptr;
+}
+
+void KSynchronizationObject::UnlinkWaiter(KThread* thread) {
+    auto& thread_nodes = thread->GetSynchronizationNodes();
+    for (s32 i = 0; i < thread->GetNumSynchronizationNodes(); ++i) {
+        if (KSynchronizationObject* object = thread_nodes[i].object; object != nullptr) {
+            object->UnlinkNode(std::addressof(thread_nodes[i]));
         }
     }
+    thread->SetNumSynchronizationNodes(0);
 }
 
 std::vector<KThread*> KSynchronizationObject::GetWaitingThreadsForDebugging() const {
@@ -21,8 +21,10 @@ class KSynchronizationObject : public KAutoObjectWithList {
 
 public:
     struct ThreadListNode {
+        ThreadListNode* prev{};
         ThreadListNode* next{};
         KThread* thread{};
+        KSynchronizationObject* object{}; ///< Object the node is linked into, null when unlinked
     };
 
     [[nodiscard]] static ResultCode Wait(KernelCore& kernel, s32* out_index,
@@ -47,6 +49,12 @@ protected:
     }
 
 private:
+    void LinkNode(ThreadListNode* thread_node);
+    void UnlinkNode(ThreadListNode* thread_node);
+
+    /// Removes the nodes of a waiting thread from every object it waits on
+    static void UnlinkWaiter(KThread* thread);
+
     ThreadListNode* thread_list_head{};
     ThreadListNode* thread_list_tail{};
 };
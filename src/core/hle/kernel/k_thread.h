@@ -207,6 +207,21 @@ public:
         return wait_result;
     }
 
+    using SynchronizationNodes =
+        std::array<KSynchronizationObject::ThreadListNode, Svc::ArgumentHandleCountMax>;
+
+    [[nodiscard]] SynchronizationNodes& GetSynchronizationNodes() {
+        return synchronization_nodes;
+    }
+
+    [[nodiscard]] s32 GetNumSynchronizationNodes() const {
+        return num_synchronization_nodes;
+    }
+
+    void SetNumSynchronizationNodes(s32 num_nodes) {
+        num_synchronization_nodes = num_nodes;
+    }
+
     /*
      * Returns the Thread Local Storage address of the current thread
      * @returns VAddr of the thread's TLS
@@ -668,6 +683,8 @@ private:
     u64 thread_id{};
     std::atomic<s64> cpu_time{};
     KSynchronizationObject* synced_object{};
+    SynchronizationNodes synchronization_nodes{};
+    s32 num_synchronization_nodes{};
     VAddr address_key{};
     KProcess* parent{};
     VAddr kernel_stack_top{};
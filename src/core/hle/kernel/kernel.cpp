@@ -570,7 +570,7 @@ struct KernelCore::Impl {
         const auto application_pool = memory_layout.GetKernelApplicationPoolRegionPhysicalExtents();
 
         // Initialize memory managers
-        memory_manager = std::make_unique<KMemoryManager>();
+        memory_manager = std::make_unique<KMemoryManager>(system.DeviceMemory());
         memory_manager->InitializeManager(KMemoryManager::Pool::Application,
                                           application_pool.GetAddress(),
                                           application_pool.GetEndAddress());
@@ -685,6 +685,8 @@ struct KernelCore::Impl {
     u32 single_core_thread_id{};
 
     std::array<u64, Core::Hardware::NUM_CPU_CORES> svc_ticks{};
+    std::array<std::atomic<u64>, Core::NUM_SVC_NUMBERS> svc_calls{};
+    std::array<std::atomic<u64>, Core::NUM_SVC_NUMBERS> svc_time_ns{};
 
     // System context
     Core::System& system;
@@ -976,6 +978,27 @@ void KernelCore::ExitSVCProfile() {
     MicroProfileLeave(MICROPROFILE_TOKEN(Kernel_SVC), impl->svc_ticks[core]);
 }
 
+void KernelCore::RecordSvcCall(u32 svc_number, std::chrono::nanoseconds time) {
+    if (svc_number >= Core::NUM_SVC_NUMBERS) {
+        return;
+    }
+    impl->svc_calls[svc_number].fetch_add(1, std::memory_order_relaxed);
+    impl->svc_time_ns[svc_number].fetch_add(static_cast<u64>(time.count()),
+                                            std::memory_order_relaxed);
+}
+
+Core::SvcStatsTable KernelCore::GetAndResetSvcStats() {
+    Core::SvcStatsTable stats{};
+    for (std::size_t i = 0; i < stats.size(); ++i) {
+        stats[i] = {
+            .calls = impl->svc_calls[i].exchange(0, std::memory_order_relaxed),
+            .time = std::chrono::nanoseconds{
+                static_cast<s64>(impl->svc_time_ns[i].exchange(0, std::memory_order_relaxed))},
+        };
+    }
+    return stats;
+}
+
 std::weak_ptr<Kernel::ServiceThread> KernelCore::CreateServiceThread(const std::string& name) {
     auto service_thread = std::make_shared<Kernel::ServiceThread>(*this, 1, name);
     impl->service_threads.emplace(service_thread);
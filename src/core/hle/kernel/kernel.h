@@ -11,6 +11,7 @@
 #include <vector>
 #include "core/arm/cpu_interrupt_handler.h"
 #include "core/hardware_properties.h"
+#include "core/perf_stats.h"
 #include "core/hle/kernel/k_auto_object.h"
 #include "core/hle/kernel/k_slab_heap.h"
 #include "core/hle/kernel/memory_types.h"
@@ -248,6 +249,12 @@ public:
 
     void ExitSVCProfile();
 
+    /// Accounts a supervisor call and the host time its handler took, threadsafe.
+    void RecordSvcCall(u32 svc_number, std::chrono::nanoseconds time);
+
+    /// Returns the supervisor calls made since the last call and resets them, threadsafe.
+    Core::SvcStatsTable GetAndResetSvcStats();
+
     /**
      * Creates an HLE service thread, which are used to execute service routines asynchronously.
      * While these are allocated per ServerSession, these need to be owned and managed outside
@@ -16,7 +16,8 @@ namespace Kernel {
 PhysicalCore::PhysicalCore(std::size_t core_index_, Core::System& system_, KScheduler& scheduler_,
                            Core::CPUInterrupts& interrupts_)
     : core_index{core_index_}, system{system_}, scheduler{scheduler_},
-      interrupts{interrupts_}, guard{std::make_unique<Common::SpinLock>()} {}
+      interrupts{interrupts_}, guard{std::make_unique<Common::SpinLock>()},
+      idle_time_ns{std::make_unique<std::atomic<u64>>()} {}
 
 PhysicalCore::~PhysicalCore() = default;
 
@@ -40,7 +41,21 @@ void PhysicalCore::Run() {
 }
 
 void PhysicalCore::Idle() {
+    const auto idle_start = std::chrono::steady_clock::now();
     interrupts[core_index].AwaitInterrupt();
+    const auto idle_time = std::chrono::steady_clock::now() - idle_start;
+    idle_time_ns->fetch_add(
+        static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(idle_time).count()),
+        std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds PhysicalCore::GetAndResetIdleTime() {
+    return std::chrono::nanoseconds{
+        static_cast<s64>(idle_time_ns->exchange(0, std::memory_order_relaxed))};
+}
+
+Core::CPUInterruptHandler::WakeStats PhysicalCore::GetAndResetWakeStats() {
+    return interrupts[core_index].GetAndResetWakeStats();
 }
 
 bool PhysicalCore::IsInterrupted() const {
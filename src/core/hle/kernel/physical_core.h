@@ -5,10 +5,13 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <memory>
 
 #include "core/arm/arm_interface.h"
+#include "core/arm/cpu_interrupt_handler.h"
 
 namespace Common {
 class SpinLock;
@@ -19,7 +22,6 @@ class KScheduler;
 } // namespace Kernel
 
 namespace Core {
-class CPUInterruptHandler;
 class ExclusiveMonitor;
 class System;
 } // namespace Core
@@ -44,8 +46,15 @@ public:
     /// Execute current jit state
     void Run();
 
+    /// Parks the calling host thread until this core is interrupted.
     void Idle();
 
+    /// Returns the host time spent parked in Idle since the last call, and resets it.
+    std::chrono::nanoseconds GetAndResetIdleTime();
+
+    /// Returns how long this core took to resume from Idle once interrupted, and resets it.
+    Core::CPUInterruptHandler::WakeStats GetAndResetWakeStats();
+
     /// Interrupt this physical core.
     void Interrupt();
 
@@ -93,6 +102,7 @@ private:
     Kernel::KScheduler& scheduler;
     Core::CPUInterrupts& interrupts;
     std::unique_ptr<Common::SpinLock> guard;
+    std::unique_ptr<std::atomic<u64>> idle_time_ns;
     std::unique_ptr<Core::ARM_Interface> arm_interface;
 };
 
@@ -2,17 +2,25 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
-#include <functional>
 #include <mutex>
 #include <thread>
 #include <vector>
 #include <queue>
+#include <string_view>
 
 #include "common/assert.h"
+#include "common/logging/log.h"
 #include "common/scope_exit.h"
+#include "common/settings.h"
 #include "common/thread.h"
+#include "common/thread_placement.h"
 #include "core/core.h"
+#include "core/hle/kernel/hle_ipc.h"
+#include "core/hle/kernel/k_server_session.h"
 #include "core/hle/kernel/k_session.h"
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/service_thread.h"
@@ -21,27 +29,97 @@
 
 namespace Kernel {
 
+namespace {
+
+struct ServiceThreadConfig {
+    u64 affinity;
+    Common::ThreadPriority priority;
+};
+
+ServiceThreadConfig MakeConfig(u32 affinity, u8 priority) {
+    if (affinity == 0) {
+        affinity = Settings::values.service_thread_affinity.GetValue();
+    }
+    const u8 clamped_priority =
+        std::min(priority, static_cast<u8>(Common::ThreadPriority::VeryHigh));
+    return {affinity, static_cast<Common::ThreadPriority>(clamped_priority)};
+}
+
+/// Returns the host scheduling parameters for the threads serving the named service.
+/// Filesystem, graphics and audio services, including the interfaces they hand out, run with
+/// their own settings so they can be kept away from the cores running guest code.
+ServiceThreadConfig GetServiceThreadConfig(std::string_view name) {
+    const auto& values = Settings::values;
+    if (name.starts_with("fsp-") || name == "IFileSystem" || name == "IFile" ||
+        name == "IDirectory" || name == "IStorage") {
+        return MakeConfig(values.fs_service_thread_affinity.GetValue(),
+                          values.fs_service_thread_priority.GetValue());
+    }
+    if (name.starts_with("nvdrv")) {
+        return MakeConfig(values.nvdrv_service_thread_affinity.GetValue(),
+                          values.nvdrv_service_thread_priority.GetValue());
+    }
+    if (name.starts_with("audren") || name == "IAudioRenderer") {
+        return MakeConfig(values.audio_service_thread_affinity.GetValue(),
+                          values.audio_service_thread_priority.GetValue());
+    }
+    return MakeConfig(0, values.service_thread_priority.GetValue());
+}
+
+} // Anonymous namespace
+
 class ServiceThread::Impl final {
 public:
     explicit Impl(KernelCore& kernel, std::size_t num_threads, const std::string& name);
     ~Impl();
 
-    void QueueSyncRequest(KSession& session, std::shared_ptr<HLERequestContext>&& context);
+    std::unique_ptr<HLERequestContext> AcquireContext(Core::Memory::Memory& memory,
+                                                      KServerSession* session, KThread* thread);
+
+    void QueueSyncRequest(KSession& session, std::unique_ptr<HLERequestContext>&& context);
 
 private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Request {
+        KServerSession* server_session;
+        std::unique_ptr<HLERequestContext> context;
+        Clock::time_point queue_time;
+    };
+
+    /// Maximum number of released contexts kept around for reuse
+    static constexpr std::size_t MaxFreeContexts = 64;
+
+    void Complete(Request& request);
+
+    KernelCore& kernel;
     std::vector<std::thread> threads;
-    std::queue<std::function<void()>> requests;
+    std::queue<Request> requests;
     std::mutex queue_mutex;
     std::condition_variable condition;
+    std::vector<std::unique_ptr<HLERequestContext>> free_contexts;
+    std::mutex free_contexts_mutex;
     const std::string service_name;
     bool stop{};
+
+    /// Dispatch statistics, logged when the service thread is destroyed
+    std::atomic<u64> num_requests{};
+    std::atomic<u64> queued_ns{};
+    std::atomic<u64> handler_ns{};
 };
 
-ServiceThread::Impl::Impl(KernelCore& kernel, std::size_t num_threads, const std::string& name)
-    : service_name{name} {
+ServiceThread::Impl::Impl(KernelCore& kernel_, std::size_t num_threads, const std::string& name)
+    : kernel{kernel_}, service_name{name} {
+    const ServiceThreadConfig config = GetServiceThreadConfig(service_name);
     for (std::size_t i = 0; i < num_threads; ++i)
-        threads.emplace_back([this, &kernel] {
+        threads.emplace_back([this, config] {
             Common::SetCurrentThreadName(std::string{"yuzu:HleService:" + service_name}.c_str());
+            if (config.affinity != 0) {
+                Common::SetCurrentThreadAffinity(config.affinity);
+            } else {
+                Common::PlaceCurrentThread(Common::PlacedThread::Service);
+            }
+            Common::SetCurrentThreadPriority(config.priority);
 
             // Wait for first request before trying to acquire a render context
             {
@@ -52,7 +130,7 @@ ServiceThread::Impl::Impl(KernelCore& kernel, std::size_t num_threads, const std
             kernel.RegisterHostThread();
 
             while (true) {
-                std::function<void()> task;
+                Request request;
 
                 {
                     std::unique_lock lock{queue_mutex};
@@ -60,17 +138,61 @@ ServiceThread::Impl::Impl(KernelCore& kernel, std::size_t num_threads, const std
                     if (stop || requests.empty()) {
                         return;
                     }
-                    task = std::move(requests.front());
+                    request = std::move(requests.front());
                     requests.pop();
                 }
 
-                task();
+                Complete(request);
             }
         });
 }
 
+std::unique_ptr<HLERequestContext> ServiceThread::Impl::AcquireContext(
+    Core::Memory::Memory& memory, KServerSession* session, KThread* thread) {
+    {
+        std::scoped_lock lock{free_contexts_mutex};
+        if (!free_contexts.empty()) {
+            auto context = std::move(free_contexts.back());
+            free_contexts.pop_back();
+            context->Reset(session, thread);
+            return context;
+        }
+    }
+    return std::make_unique<HLERequestContext>(kernel, memory, session, thread);
+}
+
+void ServiceThread::Impl::Complete(Request& request) {
+    const Clock::time_point start_time = Clock::now();
+    {
+        // Close the reference.
+        SCOPE_EXIT({ request.server_session->Close(); });
+
+        // Complete the service request.
+        request.server_session->CompleteSyncRequest(*request.context);
+    }
+    const Clock::time_point end_time = Clock::now();
+
+    // Time spent waiting for a host thread to pick the request up is tracked apart from the time
+    // spent in the handler, the first one is pure dispatch overhead.
+    const auto to_ns = [](Clock::duration duration) {
+        return static_cast<u64>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    };
+    num_requests.fetch_add(1, std::memory_order_relaxed);
+    queued_ns.fetch_add(to_ns(start_time - request.queue_time), std::memory_order_relaxed);
+    handler_ns.fetch_add(to_ns(end_time - start_time), std::memory_order_relaxed);
+
+    // Drop the references held by the request before keeping the context for reuse.
+    request.context->Reset(nullptr, nullptr);
+
+    std::scoped_lock lock{free_contexts_mutex};
+    if (free_contexts.size() < MaxFreeContexts) {
+        free_contexts.push_back(std::move(request.context));
+    }
+}
+
 void ServiceThread::Impl::QueueSyncRequest(KSession& session,
-                                           std::shared_ptr<HLERequestContext>&& context) {
+                                           std::unique_ptr<HLERequestContext>&& context) {
     {
         std::unique_lock lock{queue_mutex};
 
@@ -80,13 +202,7 @@ void ServiceThread::Impl::QueueSyncRequest(KSession& session,
         // completes asynchronously.
         server_session->Open();
 
-        requests.emplace([server_session, context{std::move(context)}]() {
-            // Close the reference.
-            SCOPE_EXIT({ server_session->Close(); });
-
-            // Complete the service request.
-            server_session->CompleteSyncRequest(*context);
-        });
+        requests.push({server_session, std::move(context), Clock::now()});
     }
     condition.notify_one();
 }
@@ -100,6 +216,13 @@ ServiceThread::Impl::~Impl() {
     for (std::thread& thread : threads) {
         thread.join();
     }
+
+    const u64 count = num_requests.load(std::memory_order_relaxed);
+    if (count != 0) {
+        LOG_DEBUG(Service, "{}: {} requests, {} ns queued and {} ns handling on average",
+                  service_name, count, queued_ns.load(std::memory_order_relaxed) / count,
+                  handler_ns.load(std::memory_order_relaxed) / count);
+    }
 }
 
 ServiceThread::ServiceThread(KernelCore& kernel, std::size_t num_threads, const std::string& name)
@@ -107,8 +230,14 @@ ServiceThread::ServiceThread(KernelCore& kernel, std::size_t num_threads, const
 
 ServiceThread::~ServiceThread() = default;
 
+std::unique_ptr<HLERequestContext> ServiceThread::AcquireContext(Core::Memory::Memory& memory,
+                                                                 KServerSession* session,
+                                                                 KThread* thread) {
+    return impl->AcquireContext(memory, session, thread);
+}
+
 void ServiceThread::QueueSyncRequest(KSession& session,
-                                     std::shared_ptr<HLERequestContext>&& context) {
+                                     std::unique_ptr<HLERequestContext>&& context) {
     impl->QueueSyncRequest(session, std::move(context));
 }
 
@@ -7,18 +7,29 @@
 #include <memory>
 #include <string>
 
+namespace Core::Memory {
+class Memory;
+}
+
 namespace Kernel {
 
 class HLERequestContext;
 class KernelCore;
+class KServerSession;
 class KSession;
+class KThread;
 
 class ServiceThread final {
 public:
     explicit ServiceThread(KernelCore& kernel, std::size_t num_threads, const std::string& name);
     ~ServiceThread();
 
-    void QueueSyncRequest(KSession& session, std::shared_ptr<HLERequestContext>&& context);
+    /// Returns a request context for a session served by this thread, reusing released ones.
+    [[nodiscard]] std::unique_ptr<HLERequestContext> AcquireContext(Core::Memory::Memory& memory,
+                                                                    KServerSession* session,
+                                                                    KThread* thread);
+
+    void QueueSyncRequest(KSession& session, std::unique_ptr<HLERequestContext>&& context);
 
 private:
     class Impl;
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <chrono>
 #include <cinttypes>
 #include <iterator>
 #include <mutex>
@@ -414,7 +415,7 @@ static ResultCode WaitSynchronization(Core::System& system, s32* index, VAddr ha
     R_UNLESS(0 <= num_handles && num_handles <= ArgumentHandleCountMax, ResultOutOfRange);
 
     auto& kernel = system.Kernel();
-    std::vector<KSynchronizationObject*> objs(num_handles);
+    std::array<KSynchronizationObject*, ArgumentHandleCountMax> objs{};
     const auto& handle_table = kernel.CurrentProcess()->GetHandleTable();
     Handle* handles = system.Memory().GetPointer<Handle>(handles_address);
 
@@ -433,7 +434,7 @@ static ResultCode WaitSynchronization(Core::System& system, s32* index, VAddr ha
         }
     });
 
-    return KSynchronizationObject::Wait(kernel, index, objs.data(), static_cast<s32>(objs.size()),
+    return KSynchronizationObject::Wait(kernel, index, objs.data(), static_cast<s32>(num_handles),
                                         nano_seconds);
 }
 
@@ -2676,6 +2677,7 @@ void Call(Core::System& system, u32 immediate) {
     system.ExitDynarmicProfile();
     auto& kernel = system.Kernel();
     kernel.EnterSVCProfile();
+    const auto svc_start = std::chrono::steady_clock::now();
 
     auto* thread = kernel.CurrentScheduler()->GetCurrentThread();
     thread->SetIsCallingSvc();
@@ -2692,6 +2694,7 @@ void Call(Core::System& system, u32 immediate) {
         LOG_CRITICAL(Kernel_SVC, "Unknown SVC function 0x{:X}", immediate);
     }
 
+    kernel.RecordSvcCall(immediate, std::chrono::steady_clock::now() - svc_start);
     kernel.ExitSVCProfile();
 
     if (!thread->IsCallingSvc()) {
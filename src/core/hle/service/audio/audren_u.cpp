@@ -97,7 +97,7 @@ private:
         LOG_DEBUG(Service_Audio, "(STUBBED) called");
 
         std::vector<u8> output_params(ctx.GetWriteBufferSize(), 0);
-        auto result = renderer->UpdateAudioRenderer(ctx.ReadBuffer(), output_params);
+        auto result = renderer->UpdateAudioRenderer(ctx.ReadBufferSpan(), output_params);
 
         if (result.IsSuccess()) {
             ctx.WriteBuffer(output_params);
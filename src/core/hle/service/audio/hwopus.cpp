@@ -3,8 +3,10 @@
 // Refer to the license.txt file included.
 
 #include <chrono>
+#include <cstdint>
 #include <cstring>
 #include <memory>
+#include <span>
 #include <vector>
 
 #include <opus.h>
@@ -70,13 +72,26 @@ private:
                                  ExtraBehavior extra_behavior) {
         u32 consumed = 0;
         u32 sample_count = 0;
-        std::vector<opus_int16> samples(ctx.GetWriteBufferSize() / sizeof(opus_int16));
+
+        // Decode straight into guest memory when it can be addressed as samples, otherwise into
+        // a staging buffer kept across requests
+        std::span<opus_int16> samples;
+        const std::span<u8> output = ctx.WriteBufferSpan();
+        const auto address = reinterpret_cast<std::uintptr_t>(output.data());
+        const bool is_direct = !output.empty() && address % alignof(opus_int16) == 0;
+        if (is_direct) {
+            samples = std::span(reinterpret_cast<opus_int16*>(output.data()),
+                                output.size() / sizeof(opus_int16));
+        } else {
+            staging_samples.resize(ctx.GetWriteBufferSize() / sizeof(opus_int16));
+            samples = staging_samples;
+        }
 
         if (extra_behavior == ExtraBehavior::ResetContext) {
             ResetDecoderContext();
         }
 
-        if (!DecodeOpusData(consumed, sample_count, ctx.ReadBuffer(), samples, performance)) {
+        if (!DecodeOpusData(consumed, sample_count, ctx.ReadBufferSpan(), samples, performance)) {
             LOG_ERROR(Audio, "Failed to decode opus data");
             IPC::ResponseBuilder rb{ctx, 2};
             // TODO(ogniK): Use correct error code
@@ -92,11 +107,14 @@ private:
         if (performance) {
             rb.Push<u64>(*performance);
         }
-        ctx.WriteBuffer(samples);
+        const std::size_t num_samples = static_cast<std::size_t>(sample_count) * channel_count;
+        if (!is_direct && num_samples != 0) {
+            ctx.WriteBuffer(samples.data(), num_samples * sizeof(opus_int16));
+        }
     }
 
-    bool DecodeOpusData(u32& consumed, u32& sample_count, const std::vector<u8>& input,
-                        std::vector<opus_int16>& output, u64* out_performance_time) const {
+    bool DecodeOpusData(u32& consumed, u32& sample_count, std::span<const u8> input,
+                        std::span<opus_int16> output, u64* out_performance_time) const {
         const auto start_time = std::chrono::high_resolution_clock::now();
         const std::size_t raw_output_sz = output.size() * sizeof(opus_int16);
         if (sizeof(OpusPacketHeader) > input.size()) {
@@ -156,6 +174,8 @@ private:
     OpusDecoderPtr decoder;
     u32 sample_rate;
     u32 channel_count;
+    /// Samples decoded for guest buffers that can't be written in place, reused across requests
+    std::vector<opus_int16> staging_samples;
 };
 
 class IHardwareOpusDecoderManager final : public ServiceFramework<IHardwareOpusDecoderManager> {
@@ -21,6 +21,7 @@
 #include "core/file_sys/sdmc_factory.h"
 #include "core/file_sys/vfs.h"
 #include "core/file_sys/vfs_offset.h"
+#include "core/file_sys/vfs_write_back.h"
 #include "core/hle/kernel/k_process.h"
 #include "core/hle/service/filesystem/filesystem.h"
 #include "core/hle/service/filesystem/fsp_ldr.h"
@@ -251,7 +252,8 @@ ResultVal<FileSys::EntryType> VfsDirectoryServiceWrapper::GetEntryType(
     return FileSys::ERROR_PATH_NOT_FOUND;
 }
 
-FileSystemController::FileSystemController(Core::System& system_) : system{system_} {}
+FileSystemController::FileSystemController(Core::System& system_)
+    : save_data_write_back_cache{std::make_unique<FileSys::WriteBackCache>()}, system{system_} {}
 
 FileSystemController::~FileSystemController() = default;
 
@@ -735,6 +737,10 @@ void FileSystemController::SetAutoSaveDataCreation(bool enable) {
     save_data_factory->SetAutoCreate(enable);
 }
 
+FileSys::WriteBackCache& FileSystemController::GetSaveDataWriteBackCache() const {
+    return *save_data_write_back_cache;
+}
+
 void FileSystemController::CreateFactories(FileSys::VfsFilesystem& vfs, bool overwrite) {
     if (overwrite) {
         bis_factory = nullptr;
@@ -22,6 +22,7 @@ class PlaceholderCache;
 class RomFSFactory;
 class SaveDataFactory;
 class SDMCFactory;
+class WriteBackCache;
 class XCI;
 
 enum class BisPartitionId : u32;
@@ -123,6 +124,9 @@ public:
 
     void SetAutoSaveDataCreation(bool enable);
 
+    /// Returns the cache buffering the writes of every file open from save data
+    FileSys::WriteBackCache& GetSaveDataWriteBackCache() const;
+
     // Creates the SaveData, SDMC, and BIS Factories. Should be called once and before any function
     // above is called.
     void CreateFactories(FileSys::VfsFilesystem& vfs, bool overwrite = true);
@@ -137,6 +141,8 @@ private:
     std::unique_ptr<FileSys::RegisteredCache> gamecard_registered;
     std::unique_ptr<FileSys::PlaceholderCache> gamecard_placeholder;
 
+    std::unique_ptr<FileSys::WriteBackCache> save_data_write_back_cache;
+
     Core::System& system;
 };
 
@@ -5,6 +5,7 @@
 #include <cinttypes>
 #include <cstring>
 #include <iterator>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -25,6 +26,7 @@
 #include "core/file_sys/savedata_factory.h"
 #include "core/file_sys/system_archive/system_archive.h"
 #include "core/file_sys/vfs.h"
+#include "core/file_sys/vfs_write_back.h"
 #include "core/hle/ipc_helpers.h"
 #include "core/hle/kernel/k_process.h"
 #include "core/hle/service/filesystem/filesystem.h"
@@ -56,6 +58,20 @@ enum class FileSystemType : u8 {
     ApplicationPackage = 7,
 };
 
+/// Reads from the backend into the output buffer of the request. The data is read directly into
+/// guest memory when the buffer is backed by contiguous host memory, avoiding a temporary copy.
+/// Returns the number of bytes read.
+static std::size_t ReadToBuffer(Kernel::HLERequestContext& ctx, const FileSys::VfsFile& backend,
+                                std::size_t length, std::size_t offset) {
+    const std::span<u8> buffer = ctx.WriteBufferSpan();
+    if (!buffer.empty() && length <= buffer.size()) {
+        return backend.Read(buffer.data(), length, offset);
+    }
+    const std::vector<u8> output = backend.ReadBytes(length, offset);
+    ctx.WriteBuffer(output);
+    return output.size();
+}
+
 class IStorage final : public ServiceFramework<IStorage> {
 public:
     explicit IStorage(Core::System& system_, FileSys::VirtualFile backend_)
@@ -95,10 +111,9 @@ private:
             return;
         }
 
-        // Read the data from the Storage backend
-        std::vector<u8> output = backend->ReadBytes(length, offset);
-        // Write the data to memory
-        ctx.WriteBuffer(output);
+        // Read the data from the Storage backend into memory
+        ReadToBuffer(ctx, *backend, static_cast<std::size_t>(length),
+                     static_cast<std::size_t>(offset));
 
         IPC::ResponseBuilder rb{ctx, 2};
         rb.Push(ResultSuccess);
@@ -156,15 +171,13 @@ private:
             return;
         }
 
-        // Read the data from the Storage backend
-        std::vector<u8> output = backend->ReadBytes(length, offset);
-
-        // Write the data to memory
-        ctx.WriteBuffer(output);
+        // Read the data from the Storage backend into memory
+        const std::size_t read_size = ReadToBuffer(ctx, *backend, static_cast<std::size_t>(length),
+                                                   static_cast<std::size_t>(offset));
 
         IPC::ResponseBuilder rb{ctx, 4};
         rb.Push(ResultSuccess);
-        rb.Push(static_cast<u64>(output.size()));
+        rb.Push(static_cast<u64>(read_size));
     }
 
     void Write(Kernel::HLERequestContext& ctx) {
@@ -190,7 +203,7 @@ private:
             return;
         }
 
-        const std::vector<u8> data = ctx.ReadBuffer();
+        const std::span<const u8> data = ctx.ReadBufferSpan();
 
         ASSERT_MSG(
             static_cast<s64>(data.size()) <= length,
@@ -198,8 +211,7 @@ private:
             length, data.size());
 
         // Write the data to the Storage backend
-        const auto write_size =
-            static_cast<std::size_t>(std::distance(data.begin(), data.begin() + length));
+        const auto write_size = static_cast<std::size_t>(length);
         const std::size_t written = backend->Write(data.data(), write_size, offset);
 
         ASSERT_MSG(static_cast<s64>(written) == length,
@@ -213,10 +225,12 @@ private:
     void Flush(Kernel::HLERequestContext& ctx) {
         LOG_DEBUG(Service_FS, "called");
 
-        // Exists for SDK compatibiltity -- No need to flush file.
+        // Only files of save data buffer their writes, other files need no flushing.
+        const auto write_back = std::dynamic_pointer_cast<FileSys::WriteBackVfsFile>(backend);
+        const bool success = write_back == nullptr || write_back->Flush();
 
         IPC::ResponseBuilder rb{ctx, 2};
-        rb.Push(ResultSuccess);
+        rb.Push(success ? ResultSuccess : ResultUnknown);
     }
 
     void SetSize(Kernel::HLERequestContext& ctx) {
@@ -308,9 +322,10 @@ private:
 
 class IFileSystem final : public ServiceFramework<IFileSystem> {
 public:
-    explicit IFileSystem(Core::System& system_, FileSys::VirtualDir backend_, SizeGetter size_)
-        : ServiceFramework{system_, "IFileSystem"}, backend{std::move(backend_)}, size{std::move(
-                                                                                      size_)} {
+    explicit IFileSystem(Core::System& system_, FileSys::VirtualDir backend_, SizeGetter size_,
+                         FileSys::WriteBackCache* write_back_cache_ = nullptr)
+        : ServiceFramework{system_, "IFileSystem"}, backend{std::move(backend_)},
+          size{std::move(size_)}, write_back_cache{write_back_cache_} {
         static const FunctionInfo functions[] = {
             {0, &IFileSystem::CreateFile, "CreateFile"},
             {1, &IFileSystem::DeleteFile, "DeleteFile"},
@@ -354,6 +369,7 @@ public:
 
         LOG_DEBUG(Service_FS, "called. file={}", name);
 
+        FlushWriteBackFiles();
         IPC::ResponseBuilder rb{ctx, 2};
         rb.Push(backend.DeleteFile(name));
     }
@@ -384,6 +400,7 @@ public:
 
         LOG_DEBUG(Service_FS, "called. directory={}", name);
 
+        FlushWriteBackFiles();
         IPC::ResponseBuilder rb{ctx, 2};
         rb.Push(backend.DeleteDirectoryRecursively(name));
     }
@@ -394,6 +411,7 @@ public:
 
         LOG_DEBUG(Service_FS, "called. Directory: {}", name);
 
+        FlushWriteBackFiles();
         IPC::ResponseBuilder rb{ctx, 2};
         rb.Push(backend.CleanDirectoryRecursively(name));
     }
@@ -407,6 +425,7 @@ public:
 
         LOG_DEBUG(Service_FS, "called. file '{}' to file '{}'", src_name, dst_name);
 
+        FlushWriteBackFiles();
         IPC::ResponseBuilder rb{ctx, 2};
         rb.Push(backend.RenameFile(src_name, dst_name));
     }
@@ -428,7 +447,14 @@ public:
             return;
         }
 
-        auto file = std::make_shared<IFile>(system, result.Unwrap());
+        FileSys::VirtualFile backend_file = result.Unwrap();
+        if (write_back_cache != nullptr) {
+            // Save data writes are buffered and written back on Commit, Flush, close or after a
+            // while. Read-only handles go through the same buffer to see the buffered writes.
+            backend_file = write_back_cache->Open(std::move(backend_file));
+        }
+
+        auto file = std::make_shared<IFile>(system, std::move(backend_file));
 
         IPC::ResponseBuilder rb{ctx, 2, 0, 1};
         rb.Push(ResultSuccess);
@@ -479,10 +505,11 @@ public:
     }
 
     void Commit(Kernel::HLERequestContext& ctx) {
-        LOG_WARNING(Service_FS, "(STUBBED) called");
+        LOG_DEBUG(Service_FS, "called");
 
+        const bool success = FlushWriteBackFiles();
         IPC::ResponseBuilder rb{ctx, 2};
-        rb.Push(ResultSuccess);
+        rb.Push(success ? ResultSuccess : ResultUnknown);
     }
 
     void GetFreeSpaceSize(Kernel::HLERequestContext& ctx) {
@@ -502,8 +529,14 @@ public:
     }
 
 private:
+    /// Writes back the buffered writes of every save data file, returns false if any failed
+    bool FlushWriteBackFiles() {
+        return write_back_cache == nullptr || write_back_cache->FlushAll();
+    }
+
     VfsDirectoryServiceWrapper backend;
     SizeGetter size;
+    FileSys::WriteBackCache* write_back_cache{};
 };
 
 class ISaveDataInfoReader final : public ServiceFramework<ISaveDataInfoReader> {
@@ -881,7 +914,8 @@ void FSP_SRV::OpenSaveDataFileSystem(Kernel::HLERequestContext& ctx) {
     }
 
     auto filesystem = std::make_shared<IFileSystem>(system, std::move(dir.Unwrap()),
-                                                    SizeGetter::FromStorageId(fsc, id));
+                                                    SizeGetter::FromStorageId(fsc, id),
+                                                    &fsc.GetSaveDataWriteBackCache());
 
     IPC::ResponseBuilder rb{ctx, 2, 0, 1};
     rb.Push(ResultSuccess);
@@ -246,6 +246,7 @@ void Controller_NPad::InitNewlyAddedController(std::size_t controller_idx) {
     controller.battery_level_dual = BATTERY_FULL;
     controller.battery_level_left = BATTERY_FULL;
     controller.battery_level_right = BATTERY_FULL;
+    is_shared_memory_dirty = true;
 
     SignalStyleSetChangedEvent(IndexToNPad(controller_idx));
 }
@@ -443,6 +444,13 @@ void Controller_NPad::RequestPadStateUpdate(u32 npad_id) {
     }
 }
 
+template <typename T>
+void Controller_NPad::CopyToSharedMemory(u8* data, const T& value) const {
+    const auto* const entries = reinterpret_cast<const u8*>(shared_memory_entries.data());
+    const auto offset = static_cast<std::size_t>(reinterpret_cast<const u8*>(&value) - entries);
+    std::memcpy(data + NPAD_OFFSET + offset, &value, sizeof(T));
+}
+
 void Controller_NPad::OnUpdate(const Core::Timing::CoreTiming& core_timing, u8* data,
                                std::size_t data_len) {
     if (!IsControllerActivated()) {
@@ -613,8 +621,27 @@ void Controller_NPad::OnUpdate(const Core::Timing::CoreTiming& core_timing, u8*
 
         press_state |= static_cast<u32>(pad_state.pad_states.raw);
     }
-    std::memcpy(data + NPAD_OFFSET, shared_memory_entries.data(),
-                shared_memory_entries.size() * sizeof(NPadEntry));
+
+    if (is_shared_memory_dirty) {
+        std::memcpy(data + NPAD_OFFSET, shared_memory_entries.data(),
+                    shared_memory_entries.size() * sizeof(NPadEntry));
+        is_shared_memory_dirty = false;
+        return;
+    }
+    // Only the LIFO headers and their newest entries have changed, copy those instead of the
+    // whole 0x5000 bytes of each entry
+    for (const auto& npad : shared_memory_entries) {
+        const std::array<const NPadGeneric*, 7> controller_npads{
+            &npad.fullkey_states,   &npad.handheld_states,  &npad.joy_dual_states,
+            &npad.joy_left_states,  &npad.joy_right_states, &npad.palma_states,
+            &npad.system_ext_states};
+        for (const auto* main_controller : controller_npads) {
+            const auto& common = main_controller->common;
+            CopyToSharedMemory(data, common);
+            CopyToSharedMemory(data, main_controller->npad[common.last_entry_index]);
+        }
+        CopyToSharedMemory(data, npad.gc_trigger_states);
+    }
 }
 
 void Controller_NPad::OnMotionUpdate(const Core::Timing::CoreTiming& core_timing, u8* data,
@@ -751,8 +778,30 @@ void Controller_NPad::OnMotionUpdate(const Core::Timing::CoreTiming& core_timing
             break;
         }
     }
-    std::memcpy(data + NPAD_OFFSET, shared_memory_entries.data(),
-                shared_memory_entries.size() * sizeof(NPadEntry));
+
+    if (is_shared_memory_dirty) {
+        std::memcpy(data + NPAD_OFFSET, shared_memory_entries.data(),
+                    shared_memory_entries.size() * sizeof(NPadEntry));
+        is_shared_memory_dirty = false;
+        return;
+    }
+    // Only the six axis LIFOs of connected controllers have changed
+    for (std::size_t i = 0; i < shared_memory_entries.size(); ++i) {
+        if (connected_controllers[i].type == NPadControllerType::None ||
+            !connected_controllers[i].is_connected) {
+            continue;
+        }
+        const auto& npad = shared_memory_entries[i];
+        const std::array<const SixAxisGeneric*, 6> controller_sixaxes{
+            &npad.sixaxis_fullkey,    &npad.sixaxis_handheld, &npad.sixaxis_dual_left,
+            &npad.sixaxis_dual_right, &npad.sixaxis_left,     &npad.sixaxis_right,
+        };
+        for (const auto* sixaxis_sensor : controller_sixaxes) {
+            const auto& common = sixaxis_sensor->common;
+            CopyToSharedMemory(data, common);
+            CopyToSharedMemory(data, sixaxis_sensor->sixaxis[common.last_entry_index]);
+        }
+    }
 }
 
 void Controller_NPad::SetSupportedStyleSet(NpadStyleSet style_set) {
@@ -808,6 +857,7 @@ void Controller_NPad::SetNpadMode(u32 npad_id, NpadAssignments assignment_mode)
     ASSERT(npad_index < shared_memory_entries.size());
     if (shared_memory_entries[npad_index].assignment_mode != assignment_mode) {
         shared_memory_entries[npad_index].assignment_mode = assignment_mode;
+        is_shared_memory_dirty = true;
     }
 }
 
@@ -1029,6 +1079,7 @@ void Controller_NPad::DisconnectNpadAtIndex(std::size_t npad_index) {
     controller.joycon_color = {};
     controller.assignment_mode = NpadAssignments::Dual;
     controller.footer_type = AppletFooterUiType::None;
+    is_shared_memory_dirty = true;
 
     SignalStyleSetChangedEvent(IndexToNPad(npad_index));
 }
@@ -549,10 +549,16 @@ private:
     bool IsControllerSupported(NPadControllerType controller) const;
     void RequestPadStateUpdate(u32 npad_id);
 
+    /// Copies a member of shared_memory_entries to its location in the shared memory
+    template <typename T>
+    void CopyToSharedMemory(u8* data, const T& value) const;
+
     std::atomic<u32> press_state{};
 
     NpadStyleSet style{};
     std::array<NPadEntry, 10> shared_memory_entries{};
+    // Set when shared_memory_entries has changes besides the LIFOs written on each pad update
+    bool is_shared_memory_dirty{true};
     using ButtonArray = std::array<
         std::array<std::unique_ptr<Input::ButtonDevice>, Settings::NativeButton::NUM_BUTTONS_HID>,
         10>;
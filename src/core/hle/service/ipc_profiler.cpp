@@ -0,0 +1,88 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <fmt/format.h>
+#include "core/hle/service/ipc_profiler.h"
+
+namespace Service {
+namespace {
+double ToMicroseconds(std::chrono::nanoseconds duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+template <typename Range>
+std::string JoinValues(const Range& values) {
+    std::string joined;
+    for (const auto& value : values) {
+        joined += fmt::format("{}{}", joined.empty() ? "" : ", ", value);
+    }
+    return joined;
+}
+} // Anonymous namespace
+
+void IPCProfiler::Record(std::string_view service, u32 command, const char* name,
+                         std::chrono::nanoseconds time) {
+    const auto time_us = std::chrono::duration_cast<std::chrono::microseconds>(time).count();
+    const auto bucket_it = std::ranges::find_if(
+        IPC_LATENCY_BOUNDS_US, [time_us](u32 bound) { return time_us <= bound; });
+    const auto bucket = static_cast<std::size_t>(bucket_it - IPC_LATENCY_BOUNDS_US.begin());
+
+    std::scoped_lock lock{mutex};
+    auto service_it = services.find(service);
+    if (service_it == services.end()) {
+        service_it = services.try_emplace(std::string(service)).first;
+    }
+    auto [command_it, is_new] = service_it->second.try_emplace(command);
+    IPCCommandStats& stats = command_it->second;
+    if (is_new) {
+        stats.service = service_it->first;
+        stats.command = command;
+        stats.name = name ? name : "";
+    }
+    ++stats.calls;
+    stats.total_time += time;
+    stats.max_time = std::max(stats.max_time, time);
+    ++stats.latency[bucket];
+}
+
+void IPCProfiler::Reset() {
+    std::scoped_lock lock{mutex};
+    services.clear();
+}
+
+std::vector<IPCCommandStats> IPCProfiler::Commands() const {
+    std::vector<IPCCommandStats> commands;
+    {
+        std::scoped_lock lock{mutex};
+        for (const auto& [service, service_commands] : services) {
+            for (const auto& [command, stats] : service_commands) {
+                commands.push_back(stats);
+            }
+        }
+    }
+    std::ranges::sort(commands, [](const IPCCommandStats& lhs, const IPCCommandStats& rhs) {
+        return lhs.total_time > rhs.total_time;
+    });
+    return commands;
+}
+
+std::string IPCProfiler::ToJson() const {
+    const std::vector<IPCCommandStats> commands = Commands();
+    std::string json = fmt::format("{{\n  \"latency_bounds_us\": [{}],\n  \"commands\": [",
+                                   JoinValues(IPC_LATENCY_BOUNDS_US));
+    for (std::size_t i = 0; i < commands.size(); ++i) {
+        const IPCCommandStats& stats = commands[i];
+        json += fmt::format("{}\n    {{\"service\": \"{}\", \"command\": {}, \"name\": \"{}\", "
+                            "\"calls\": {}, \"total_us\": {:.3f}, \"max_us\": {:.3f}, "
+                            "\"latency\": [{}]}}",
+                            i == 0 ? "" : ",", stats.service, stats.command, stats.name,
+                            stats.calls, ToMicroseconds(stats.total_time),
+                            ToMicroseconds(stats.max_time), JoinValues(stats.latency));
+    }
+    json += "\n  ]\n}\n";
+    return json;
+}
+
+} // namespace Service
@@ -0,0 +1,79 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "common/common_types.h"
+
+namespace Service {
+
+/// Upper bounds, in microseconds, of the command latency histogram buckets. A final bucket counts
+/// every command slower than the last bound.
+constexpr std::array<u32, 7> IPC_LATENCY_BOUNDS_US{1, 4, 16, 64, 256, 1000, 4000};
+
+using IPCLatencyHistogram = std::array<u64, IPC_LATENCY_BOUNDS_US.size() + 1>;
+
+/// Counters of one command of a service
+struct IPCCommandStats {
+    /// Name of the service the command belongs to
+    std::string service;
+    /// Command id
+    u32 command;
+    /// Name of the handler, empty when it is unknown
+    std::string name;
+    /// Number of requests handled
+    u64 calls;
+    /// Host time spent in the handler over every request
+    std::chrono::nanoseconds total_time;
+    /// Host time spent in the slowest request
+    std::chrono::nanoseconds max_time;
+    /// Number of requests in each latency bucket
+    IPCLatencyHistogram latency;
+};
+
+/**
+ * Counts the requests handled by each command of the HLE services and how long their handlers
+ * took. Recording is off by default and costs a relaxed load per request while it is off. All
+ * public functions of this class are thread-safe.
+ */
+class IPCProfiler {
+public:
+    /// Starts or stops recording requests, recorded counters are kept
+    void SetEnabled(bool enabled_) {
+        enabled.store(enabled_, std::memory_order_relaxed);
+    }
+
+    /// Returns true when requests are being recorded
+    [[nodiscard]] bool IsEnabled() const {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Records a request handled by a command
+    void Record(std::string_view service, u32 command, const char* name,
+                std::chrono::nanoseconds time);
+
+    /// Discards every recorded counter
+    void Reset();
+
+    /// Returns the counters of every command called, slowest in total first
+    [[nodiscard]] std::vector<IPCCommandStats> Commands() const;
+
+    /// Returns the counters as a JSON document
+    [[nodiscard]] std::string ToJson() const;
+
+private:
+    mutable std::mutex mutex;
+    std::atomic_bool enabled{false};
+    std::map<std::string, std::map<u32, IPCCommandStats>, std::less<>> services;
+};
+
+} // namespace Service
@@ -19,8 +19,8 @@ nvmap::nvmap(Core::System& system_) : nvdevice{system_} {
 
 nvmap::~nvmap() = default;
 
-NvResult nvmap::Ioctl1(DeviceFD fd, Ioctl command, const std::vector<u8>& input,
-                       std::vector<u8>& output) {
+NvResult nvmap::Ioctl1(DeviceFD fd, Ioctl command, std::span<const u8> input,
+                       std::span<u8> output) {
     switch (command.group) {
     case 0x1:
         switch (command.cmd) {
@@ -48,14 +48,14 @@ NvResult nvmap::Ioctl1(DeviceFD fd, Ioctl command, const std::vector<u8>& input,
     return NvResult::NotImplemented;
 }
 
-NvResult nvmap::Ioctl2(DeviceFD fd, Ioctl command, const std::vector<u8>& input,
-                       const std::vector<u8>& inline_input, std::vector<u8>& output) {
+NvResult nvmap::Ioctl2(DeviceFD fd, Ioctl command, std::span<const u8> input,
+                       std::span<const u8> inline_input, std::span<u8> output) {
     UNIMPLEMENTED_MSG("Unimplemented ioctl={:08X}", command.raw);
     return NvResult::NotImplemented;
 }
 
-NvResult nvmap::Ioctl3(DeviceFD fd, Ioctl command, const std::vector<u8>& input,
-                       std::vector<u8>& output, std::vector<u8>& inline_output) {
+NvResult nvmap::Ioctl3(DeviceFD fd, Ioctl command, std::span<const u8> input,
+                       std::span<u8> output, std::span<u8> inline_output) {
     UNIMPLEMENTED_MSG("Unimplemented ioctl={:08X}", command.raw);
     return NvResult::NotImplemented;
 }
@@ -85,7 +85,7 @@ u32 nvmap::CreateObject(u32 size) {
     return handle;
 }
 
-NvResult nvmap::IocCreate(const std::vector<u8>& input, std::vector<u8>& output) {
+NvResult nvmap::IocCreate(std::span<const u8> input, std::span<u8> output) {
     IocCreateParams params;
     std::memcpy(&params, input.data(), sizeof(params));
     LOG_DEBUG(Service_NVDRV, "size=0x{:08X}", params.size);
@@ -97,11 +97,11 @@ NvResult nvmap::IocCreate(const std::vector<u8>& input, std::vector<u8>& output)
 
     params.handle = CreateObject(params.size);
 
-    std::memcpy(output.data(), &params, sizeof(params));
+    std::memcpy(output.data(), &params, std::min(output.size(), sizeof(params)));
     return NvResult::Success;
 }
 
-NvResult nvmap::IocAlloc(const std::vector<u8>& input, std::vector<u8>& output) {
+NvResult nvmap::IocAlloc(std::span<const u8> input, std::span<u8> output) {
     IocAllocParams params;
     std::memcpy(&params, input.data(), sizeof(params));
     LOG_DEBUG(Service_NVDRV, "called, addr={:X}", params.addr);
@@ -138,11 +138,11 @@ NvResult nvmap::IocAlloc(const std::vector<u8>& input, std::vector<u8>& output)
     object->addr = params.addr;
     object->status = Object::Status::Allocated;
 
-    std::memcpy(output.data(), &params, sizeof(params));
+    std::memcpy(output.data(), &params, std::min(output.size(), sizeof(params)));
     return NvResult::Success;
 }
 
-NvResult nvmap::IocGetId(const std::vector<u8>& input, std::vector<u8>& output) {
+NvResult nvmap::IocGetId(std::span<const u8> input, std::span<u8> output) {
     IocGetIdParams params;
     std::memcpy(&params, input.data(), sizeof(params));
 
@@ -161,11 +161,11 @@ NvResult nvmap::IocGetId(const std::vector<u8>& input, std::vector<u8>& output)
 
     params.id = object->id;
 
-    std::memcpy(output.data(), &params, sizeof(params));
+    std::memcpy(output.data(), &params, std::min(output.size(), sizeof(params)));
     return NvResult::Success;
 }
 
-NvResult nvmap::IocFromId(const std::vector<u8>& input, std::vector<u8>& output) {
+NvResult nvmap::IocFromId(std::span<const u8> input, std::span<u8> output) {
     IocFromIdParams params;
     std::memcpy(&params, input.data(), sizeof(params));
 
@@ -189,11 +189,11 @@ NvResult nvmap::IocFromId(const std::vector<u8>& input, std::vector<u8>& output)
     // Return the existing handle instead of creating a new one.
     params.handle = itr->first;
 
-    std::memcpy(output.data(), &params, sizeof(params));
+    std::memcpy(output.data(), &params, std::min(output.size(), sizeof(params)));
     return NvResult::Success;
 }
 
-NvResult nvmap::IocParam(const std::vector<u8>& input, std::vector<u8>& output) {
+NvResult nvmap::IocParam(std::span<const u8> input, std::span<u8> output) {
     enum class ParamTypes { Size = 1, Alignment = 2, Base = 3, Heap = 4, Kind = 5, Compr = 6 };
 
     IocParamParams params;
@@ -230,11 +230,11 @@ NvResult nvmap::IocParam(const std::vector<u8>& input, std::vector<u8>& output)
         UNIMPLEMENTED();
     }
 
-    std::memcpy(output.data(), &params, sizeof(params));
+    std::memcpy(output.data(), &params, std::min(output.size(), sizeof(params)));
     return NvResult::Success;
 }
 
-NvResult nvmap::IocFree(const std::vector<u8>& input, std::vector<u8>& output) {
+NvResult nvmap::IocFree(std::span<const u8> input, std::span<u8> output) {
     // TODO(Subv): These flags are unconfirmed.
     enum FreeFlags {
         Freed = 0,
@@ -275,7 +275,7 @@ NvResult nvmap::IocFree(const std::vector<u8>& input, std::vector<u8>& output) {
 
     handles.erase(params.handle);
 
-    std::memcpy(output.data(), &params, sizeof(params));
+    std::memcpy(output.data(), &params, std::min(output.size(), sizeof(params)));
     return NvResult::Success;
 }
 
@@ -3,6 +3,8 @@
 // Refer to the license.txt file included.
 
 #include <cinttypes>
+#include <span>
+#include <vector>
 #include "common/logging/log.h"
 #include "core/core.h"
 #include "core/hle/ipc_helpers.h"
@@ -16,6 +18,46 @@
 
 namespace Service::Nvidia {
 
+namespace {
+
+/// Output buffer of an ioctl. Devices write their results straight into guest memory when the
+/// buffer is backed by contiguous host memory, otherwise the results are staged on the host and
+/// copied back once the ioctl completes. Results of ioctls without outputs are discarded.
+class IoctlOutputBuffer {
+public:
+    explicit IoctlOutputBuffer(Kernel::HLERequestContext& ctx_, std::size_t buffer_index_,
+                               bool is_out)
+        : ctx{ctx_}, buffer_index{buffer_index_} {
+        if (is_out) {
+            view = ctx.WriteBufferSpan(buffer_index);
+        }
+        if (view.empty()) {
+            staging.resize(ctx.GetWriteBufferSize(buffer_index));
+            view = staging;
+            write_back = is_out;
+        }
+    }
+
+    std::span<u8> View() const {
+        return view;
+    }
+
+    void WriteBack() const {
+        if (write_back) {
+            ctx.WriteBuffer(staging, buffer_index);
+        }
+    }
+
+private:
+    Kernel::HLERequestContext& ctx;
+    std::size_t buffer_index;
+    std::span<u8> view;
+    std::vector<u8> staging;
+    bool write_back{};
+};
+
+} // Anonymous namespace
+
 void NVDRV::SignalGPUInterruptSyncpt(const u32 syncpoint_id, const u32 value) {
     nvdrv->SignalSyncpt(syncpoint_id, value);
 }
@@ -68,14 +110,11 @@ void NVDRV::Ioctl1(Kernel::HLERequestContext& ctx) {
         return;
     }
 
-    // Check device
-    std::vector<u8> output_buffer(ctx.GetWriteBufferSize(0));
-    const auto input_buffer = ctx.ReadBuffer(0);
+    const std::span<const u8> input_buffer = ctx.ReadBufferSpan(0);
+    const IoctlOutputBuffer output_buffer{ctx, 0, command.is_out != 0};
 
-    const auto nv_result = nvdrv->Ioctl1(fd, command, input_buffer, output_buffer);
-    if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer);
-    }
+    const auto nv_result = nvdrv->Ioctl1(fd, command, input_buffer, output_buffer.View());
+    output_buffer.WriteBack();
 
     IPC::ResponseBuilder rb{ctx, 3};
     rb.Push(ResultSuccess);
@@ -94,15 +133,13 @@ void NVDRV::Ioctl2(Kernel::HLERequestContext& ctx) {
         return;
     }
 
-    const auto input_buffer = ctx.ReadBuffer(0);
-    const auto input_inlined_buffer = ctx.ReadBuffer(1);
-    std::vector<u8> output_buffer(ctx.GetWriteBufferSize(0));
+    const std::span<const u8> input_buffer = ctx.ReadBufferSpan(0);
+    const std::span<const u8> input_inlined_buffer = ctx.ReadBufferSpan(1);
+    const IoctlOutputBuffer output_buffer{ctx, 0, command.is_out != 0};
 
-    const auto nv_result =
-        nvdrv->Ioctl2(fd, command, input_buffer, input_inlined_buffer, output_buffer);
-    if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer);
-    }
+    const auto nv_result = nvdrv->Ioctl2(fd, command, input_buffer, input_inlined_buffer,
+                                         output_buffer.View());
+    output_buffer.WriteBack();
 
     IPC::ResponseBuilder rb{ctx, 3};
     rb.Push(ResultSuccess);
@@ -121,16 +158,14 @@ void NVDRV::Ioctl3(Kernel::HLERequestContext& ctx) {
         return;
     }
 
-    const auto input_buffer = ctx.ReadBuffer(0);
-    std::vector<u8> output_buffer(ctx.GetWriteBufferSize(0));
-    std::vector<u8> output_buffer_inline(ctx.GetWriteBufferSize(1));
+    const std::span<const u8> input_buffer = ctx.ReadBufferSpan(0);
+    const IoctlOutputBuffer output_buffer{ctx, 0, command.is_out != 0};
+    const IoctlOutputBuffer output_buffer_inline{ctx, 1, command.is_out != 0};
 
-    const auto nv_result =
-        nvdrv->Ioctl3(fd, command, input_buffer, output_buffer, output_buffer_inline);
-    if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer, 0);
-        ctx.WriteBuffer(output_buffer_inline, 1);
-    }
+    const auto nv_result = nvdrv->Ioctl3(fd, command, input_buffer, output_buffer.View(),
+                                         output_buffer_inline.View());
+    output_buffer.WriteBack();
+    output_buffer_inline.WriteBack();
 
     IPC::ResponseBuilder rb{ctx, 3};
     rb.Push(ResultSuccess);
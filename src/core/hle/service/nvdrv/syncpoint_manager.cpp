@@ -29,11 +29,7 @@ u32 SyncpointManager::AllocateSyncpoint() {
 }
 
 u32 SyncpointManager::IncreaseSyncpoint(u32 syncpoint_id, u32 value) {
-    for (u32 index = 0; index < value; ++index) {
-        syncpoints[syncpoint_id].max.fetch_add(1, std::memory_order_relaxed);
-    }
-
-    return GetSyncpointMax(syncpoint_id);
+    return syncpoints[syncpoint_id].max.fetch_add(value, std::memory_order_relaxed) + value;
 }
 
 } // namespace Service::Nvidia
@@ -142,6 +142,20 @@ std::optional<std::reference_wrapper<const BufferQueue::Buffer>> BufferQueue::Ac
     return {{buffers[buffer_slot]}};
 }
 
+std::optional<std::reference_wrapper<const BufferQueue::Buffer>> BufferQueue::PeekQueuedBuffer() {
+    std::unique_lock lock{queue_sequence_mutex};
+    // Drop the stale entries AcquireBuffer would skip over as well
+    while (!queue_sequence.empty()) {
+        const auto slot = static_cast<std::size_t>(queue_sequence.front());
+        ASSERT(slot < buffers.size());
+        if (buffers[slot].status == Buffer::Status::Queued) {
+            return {{buffers[slot]}};
+        }
+        queue_sequence.pop_front();
+    }
+    return std::nullopt;
+}
+
 void BufferQueue::ReleaseBuffer(u32 slot) {
     ASSERT(slot < buffers.size());
     ASSERT(buffers[slot].status == Buffer::Status::Acquired);
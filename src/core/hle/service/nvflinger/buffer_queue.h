@@ -103,6 +103,8 @@ public:
                      Service::Nvidia::MultiFence& multi_fence);
     void CancelBuffer(u32 slot, const Service::Nvidia::MultiFence& multi_fence);
     std::optional<std::reference_wrapper<const Buffer>> AcquireBuffer();
+    /// Returns the buffer the next AcquireBuffer call would acquire, without acquiring it
+    std::optional<std::reference_wrapper<const Buffer>> PeekQueuedBuffer();
     void ReleaseBuffer(u32 slot);
     void Connect();
     void Disconnect();
@@ -11,6 +11,7 @@
 #include "common/scope_exit.h"
 #include "common/settings.h"
 #include "common/thread.h"
+#include "common/trace_recorder.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/core_timing_util.h"
@@ -29,6 +30,30 @@
 namespace Service::NVFlinger {
 
 constexpr auto frame_ns = std::chrono::nanoseconds{1000000000 / 60};
+/// Interval at which buffers are polled between vsyncs while the frame limit is disabled
+constexpr auto present_poll_ns = std::chrono::nanoseconds{1000000};
+
+namespace {
+/// Acquires the next queued buffer of the queue if the GPU has finished rendering to it.
+std::optional<std::reference_wrapper<const BufferQueue::Buffer>> AcquireReadyBuffer(
+    Tegra::GPU& gpu, BufferQueue& buffer_queue) {
+    const auto queued_buffer = buffer_queue.PeekQueuedBuffer();
+    if (!queued_buffer) {
+        return std::nullopt;
+    }
+
+    // Waiting here would delay the vsync signal, so a buffer that isn't ready is presented on a
+    // later composition.
+    const auto& multi_fence = queued_buffer->get().multi_fence;
+    for (u32 fence_id = 0; fence_id < multi_fence.num_fences; fence_id++) {
+        const auto& fence = multi_fence.fences[fence_id];
+        if (!gpu.IsFenceSignaled(fence.id, fence.value)) {
+            return std::nullopt;
+        }
+    }
+    return buffer_queue.AcquireBuffer();
+}
+} // Anonymous namespace
 
 void NVFlinger::VSyncThread(NVFlinger& nv_flinger) {
     nv_flinger.SplitVSync();
@@ -54,8 +79,20 @@ void NVFlinger::SplitVSync() {
         const s64 time_passed = time_end - time_start;
         const s64 next_time = std::max<s64>(0, ticks - time_passed - delay);
         guard->unlock();
-        if (next_time > 0) {
-            wait_event->WaitFor(std::chrono::nanoseconds{next_time});
+
+        // The guest keeps seeing vsync at its nominal rate while the frame limit is disabled,
+        // only frames finished between two vsyncs are presented without waiting for the next one
+        s64 time_left = next_time;
+        while (time_left > 0 && is_running) {
+            const s64 wait_time = Settings::values.disable_fps_limit.GetValue()
+                                      ? std::min<s64>(time_left, present_poll_ns.count())
+                                      : time_left;
+            wait_event->WaitFor(std::chrono::nanoseconds{wait_time});
+            time_left = next_time - (system.CoreTiming().GetGlobalTimeNs().count() - time_end);
+            if (time_left > 0 && Settings::values.disable_fps_limit.GetValue()) {
+                const auto lock_guard = Lock();
+                PresentReadyBuffers();
+            }
         }
         delay = (system.CoreTiming().GetGlobalTimeNs().count() - time_end) - next_time;
     }
@@ -263,53 +300,65 @@ void NVFlinger::Compose() {
         if (!display.HasLayers())
             continue;
 
-        // TODO(Subv): Support more than 1 layer.
-        VI::Layer& layer = display.GetLayer(0);
-        auto& buffer_queue = layer.GetBufferQueue();
-
-        // Search for a queued buffer and acquire it
-        auto buffer = buffer_queue.AcquireBuffer();
-
-        if (!buffer) {
-            continue;
+        if (!system.IsPoweredOn()) {
+            return; // We are likely shutting down
         }
 
-        const auto& igbp_buffer = buffer->get().igbp_buffer;
+        ComposeDisplay(display);
+    }
+}
 
-        if (!system.IsPoweredOn()) {
-            return; // We are likely shutting down
+void NVFlinger::PresentReadyBuffers() {
+    if (!system.IsPoweredOn()) {
+        return;
+    }
+    for (auto& display : displays) {
+        if (display.HasLayers()) {
+            ComposeDisplay(display);
         }
+    }
+}
 
-        auto& gpu = system.GPU();
-        const auto& multi_fence = buffer->get().multi_fence;
-        guard->unlock();
-        for (u32 fence_id = 0; fence_id < multi_fence.num_fences; fence_id++) {
-            const auto& fence = multi_fence.fences[fence_id];
-            gpu.WaitFence(fence.id, fence.value);
+void NVFlinger::ComposeDisplay(VI::Display& display) {
+    // TODO(Subv): Compose more than 1 layer, the renderers present a single framebuffer.
+    // Buffers of the other layers are consumed without being shown, otherwise the guest
+    // would block once every slot of their queues has been queued.
+    for (std::size_t index = 1; index < display.GetNumLayers(); ++index) {
+        auto& overlay_queue = display.GetLayer(index).GetBufferQueue();
+        while (const auto buffer = AcquireReadyBuffer(system.GPU(), overlay_queue)) {
+            overlay_queue.ReleaseBuffer(buffer->get().slot);
         }
-        guard->lock();
+    }
+
+    VI::Layer& layer = display.GetLayer(0);
+    auto& buffer_queue = layer.GetBufferQueue();
 
-        MicroProfileFlip();
+    // Search for a queued buffer and acquire it
+    const auto buffer = AcquireReadyBuffer(system.GPU(), buffer_queue);
+    if (!buffer) {
+        return;
+    }
 
-        // Now send the buffer to the GPU for drawing.
-        // TODO(Subv): Support more than just disp0. The display device selection is probably based
-        // on which display we're drawing (Default, Internal, External, etc)
-        auto nvdisp = nvdrv->GetDevice<Nvidia::Devices::nvdisp_disp0>("/dev/nvdisp_disp0");
-        ASSERT(nvdisp);
+    const auto& igbp_buffer = buffer->get().igbp_buffer;
 
-        nvdisp->flip(igbp_buffer.gpu_buffer_id, igbp_buffer.offset, igbp_buffer.format,
-                     igbp_buffer.width, igbp_buffer.height, igbp_buffer.stride,
-                     buffer->get().transform, buffer->get().crop_rect);
+    MicroProfileFlip();
+    Common::TraceRecorder::OnFrame();
 
-        swap_interval = buffer->get().swap_interval;
-        buffer_queue.ReleaseBuffer(buffer->get().slot);
-    }
+    // Now send the buffer to the GPU for drawing.
+    // TODO(Subv): Support more than just disp0. The display device selection is probably based
+    // on which display we're drawing (Default, Internal, External, etc)
+    auto nvdisp = nvdrv->GetDevice<Nvidia::Devices::nvdisp_disp0>("/dev/nvdisp_disp0");
+    ASSERT(nvdisp);
+
+    nvdisp->flip(igbp_buffer.gpu_buffer_id, igbp_buffer.offset, igbp_buffer.format,
+                 igbp_buffer.width, igbp_buffer.height, igbp_buffer.stride,
+                 buffer->get().transform, buffer->get().crop_rect);
+
+    swap_interval = buffer->get().swap_interval;
+    buffer_queue.ReleaseBuffer(buffer->get().slot);
 }
 
 s64 NVFlinger::GetNextTicks() const {
-    if (Settings::values.disable_fps_limit.GetValue()) {
-        return 0;
-    }
     constexpr s64 max_hertz = 120LL;
     return (1000000000 * (1LL << swap_interval)) / max_hertz;
 }
@@ -108,6 +108,12 @@ private:
     /// Creates a layer with the specified layer ID in the desired display.
     void CreateLayerAtId(VI::Display& display, u64 layer_id);
 
+    /// Presents the ready buffers of every display without triggering the vsync events.
+    void PresentReadyBuffers();
+
+    /// Presents the next ready buffer of the first layer of a display.
+    void ComposeDisplay(VI::Display& display);
+
     static void VSyncThread(NVFlinger& nv_flinger);
 
     void SplitVSync();
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <chrono>
 #include <fmt/format.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
@@ -36,6 +37,7 @@
 #include "core/hle/service/glue/glue.h"
 #include "core/hle/service/grc/grc.h"
 #include "core/hle/service/hid/hid.h"
+#include "core/hle/service/ipc_profiler.h"
 #include "core/hle/service/lbl/lbl.h"
 #include "core/hle/service/ldn/ldn.h"
 #include "core/hle/service/ldr/ldr.h"
@@ -131,6 +133,7 @@ void ServiceFrameworkBase::RegisterHandlersBase(const FunctionInfoBase* function
         // Usually this array is sorted by id already, so hint to insert at the end
         handlers.emplace_hint(handlers.cend(), functions[i].expected_header, functions[i]);
     }
+    BuildDirectTable(handlers, direct_handlers);
 }
 
 void ServiceFrameworkBase::RegisterHandlersBaseTipc(const FunctionInfoBase* functions,
@@ -141,6 +144,36 @@ void ServiceFrameworkBase::RegisterHandlersBaseTipc(const FunctionInfoBase* func
         handlers_tipc.emplace_hint(handlers_tipc.cend(), functions[i].expected_header,
                                    functions[i]);
     }
+    BuildDirectTable(handlers_tipc, direct_handlers_tipc);
+}
+
+void ServiceFrameworkBase::BuildDirectTable(const HandlerMap& map, DirectHandlerTable& table) {
+    // Past this many entries or this sparse, the table would mostly hold nulls
+    static constexpr u32 MAX_DIRECT_COMMANDS = 0x400;
+    static constexpr std::size_t MAX_EMPTY_ENTRIES_PER_HANDLER = 4;
+
+    table.clear();
+    if (map.empty()) {
+        return;
+    }
+    const u32 max_command = map.rbegin()->first;
+    if (max_command >= MAX_DIRECT_COMMANDS ||
+        max_command >= map.size() * MAX_EMPTY_ENTRIES_PER_HANDLER + 16) {
+        return;
+    }
+    table.resize(max_command + 1);
+    for (const auto& [command, info] : map) {
+        table[command] = &info;
+    }
+}
+
+auto ServiceFrameworkBase::FindHandler(const HandlerMap& map, const DirectHandlerTable& table,
+                                       u32 command) -> const FunctionInfoBase* {
+    if (!table.empty()) {
+        return command < table.size() ? table[command] : nullptr;
+    }
+    const auto it = map.find(command);
+    return it == map.end() ? nullptr : &it->second;
 }
 
 void ServiceFrameworkBase::ReportUnimplementedFunction(Kernel::HLERequestContext& ctx,
@@ -167,28 +200,33 @@ void ServiceFrameworkBase::ReportUnimplementedFunction(Kernel::HLERequestContext
 }
 
 void ServiceFrameworkBase::InvokeRequest(Kernel::HLERequestContext& ctx) {
-    auto itr = handlers.find(ctx.GetCommand());
-    const FunctionInfoBase* info = itr == handlers.end() ? nullptr : &itr->second;
-    if (info == nullptr || info->handler_callback == nullptr) {
-        return ReportUnimplementedFunction(ctx, info);
-    }
-
-    LOG_TRACE(Service, "{}", MakeFunctionString(info->name, GetServiceName(), ctx.CommandBuffer()));
-    handler_invoker(this, info->handler_callback, ctx);
+    InvokeHandler(ctx, FindHandler(handlers, direct_handlers, ctx.GetCommand()), false);
 }
 
 void ServiceFrameworkBase::InvokeRequestTipc(Kernel::HLERequestContext& ctx) {
-    boost::container::flat_map<u32, FunctionInfoBase>::iterator itr;
-
-    itr = handlers_tipc.find(ctx.GetCommand());
+    InvokeHandler(ctx, FindHandler(handlers_tipc, direct_handlers_tipc, ctx.GetCommand()), true);
+}
 
-    const FunctionInfoBase* info = itr == handlers_tipc.end() ? nullptr : &itr->second;
+void ServiceFrameworkBase::InvokeHandler(Kernel::HLERequestContext& ctx,
+                                         const FunctionInfoBase* info, bool is_tipc) {
     if (info == nullptr || info->handler_callback == nullptr) {
         return ReportUnimplementedFunction(ctx, info);
     }
 
     LOG_TRACE(Service, "{}", MakeFunctionString(info->name, GetServiceName(), ctx.CommandBuffer()));
+    IPCProfiler& profiler = system.GetIPCProfiler();
+    if (!profiler.IsEnabled()) {
+        handler_invoker(this, info->handler_callback, ctx);
+        return;
+    }
+    const auto begin = std::chrono::steady_clock::now();
     handler_invoker(this, info->handler_callback, ctx);
+    const auto time = std::chrono::steady_clock::now() - begin;
+    if (is_tipc) {
+        profiler.Record(service_name + " (tipc)", ctx.GetCommand(), info->name, time);
+    } else {
+        profiler.Record(service_name, ctx.GetCommand(), info->name, time);
+    }
 }
 
 ResultCode ServiceFrameworkBase::HandleSyncRequest(Kernel::KServerSession& session,
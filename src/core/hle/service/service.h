@@ -7,6 +7,7 @@
 #include <cstddef>
 #include <mutex>
 #include <string>
+#include <vector>
 #include <boost/container/flat_map.hpp>
 #include "common/common_types.h"
 #include "common/spin_lock.h"
@@ -113,10 +114,23 @@ private:
                                   u32 max_sessions_, InvokerFn* handler_invoker_);
     ~ServiceFrameworkBase() override;
 
+    using HandlerMap = boost::container::flat_map<u32, FunctionInfoBase>;
+    using DirectHandlerTable = std::vector<const FunctionInfoBase*>;
+
     void RegisterHandlersBase(const FunctionInfoBase* functions, std::size_t n);
     void RegisterHandlersBaseTipc(const FunctionInfoBase* functions, std::size_t n);
     void ReportUnimplementedFunction(Kernel::HLERequestContext& ctx, const FunctionInfoBase* info);
 
+    /// Calls a handler, recording its latency when the IPC profiler is enabled.
+    void InvokeHandler(Kernel::HLERequestContext& ctx, const FunctionInfoBase* info, bool is_tipc);
+
+    /// Indexes the handlers by command id when the ids are dense enough, clears it otherwise.
+    static void BuildDirectTable(const HandlerMap& map, DirectHandlerTable& table);
+
+    /// Returns the handler of a command id, null when it is not registered.
+    static const FunctionInfoBase* FindHandler(const HandlerMap& map,
+                                               const DirectHandlerTable& table, u32 command);
+
     /// Identifier string used to connect to the service.
     std::string service_name;
     /// Maximum number of concurrent sessions that this service can handle.
@@ -128,8 +142,11 @@ private:
 
     /// Function used to safely up-cast pointers to the derived class before invoking a handler.
     InvokerFn* handler_invoker;
-    boost::container::flat_map<u32, FunctionInfoBase> handlers;
-    boost::container::flat_map<u32, FunctionInfoBase> handlers_tipc;
+    HandlerMap handlers;
+    HandlerMap handlers_tipc;
+    /// Handlers indexed by command id, empty when the ids are too sparse
+    DirectHandlerTable direct_handlers;
+    DirectHandlerTable direct_handlers_tipc;
 
     /// Used to gain exclusive access to the service members, e.g. from CoreTiming thread.
     Common::SpinLock lock_service;
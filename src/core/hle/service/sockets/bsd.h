@@ -12,15 +12,12 @@
 #include "core/hle/kernel/hle_ipc.h"
 #include "core/hle/service/service.h"
 #include "core/hle/service/sockets/sockets.h"
+#include "core/network/network.h"
 
 namespace Core {
 class System;
 }
 
-namespace Network {
-class Socket;
-}
-
 namespace Service::Sockets {
 
 class BSD final : public ServiceFramework<BSD> {
@@ -167,6 +164,9 @@ private:
     void BuildErrnoResponse(Kernel::HLERequestContext& ctx, Errno bsd_errno) const noexcept;
 
     std::array<std::optional<FileDescriptor>, MAX_FD> file_descriptors;
+
+    /// Host poll entries reused by every Poll request, games poll on every frame
+    std::vector<Network::PollFD> host_pollfds;
 };
 
 class BSDCFG final : public ServiceFramework<BSDCFG> {
@@ -52,6 +52,11 @@ public:
         return !layers.empty();
     }
 
+    /// Gets the number of layers added to this display.
+    std::size_t GetNumLayers() const {
+        return layers.size();
+    }
+
     /// Gets a layer for this display based off an index.
     Layer& GetLayer(std::size_t index);
 
@@ -2,8 +2,12 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <array>
 #include <cinttypes>
 #include <cstring>
+#include <future>
+#include <span>
 #include <vector>
 
 #include "common/common_funcs.h"
@@ -12,6 +16,7 @@
 #include "common/lz4_compression.h"
 #include "common/settings.h"
 #include "common/swap.h"
+#include "core/arm/guest_hooks.h"
 #include "core/core.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/hle/kernel/code_set.h"
@@ -34,15 +39,12 @@ struct MODHeader {
 };
 static_assert(sizeof(MODHeader) == 0x1c, "MODHeader has incorrect size.");
 
-std::vector<u8> DecompressSegment(const std::vector<u8>& compressed_data,
-                                  const NSOSegmentHeader& header) {
-    std::vector<u8> uncompressed_data =
-        Common::Compression::DecompressDataLZ4(compressed_data, header.size);
+/// Decompresses a segment straight into its location in the program image
+void DecompressSegment(std::span<const u8> compressed_data, std::span<u8> output) {
+    const int uncompressed_size = Common::Compression::DecompressDataLZ4(compressed_data, output);
 
-    ASSERT_MSG(uncompressed_data.size() == header.size, "{} != {}", header.size,
-               uncompressed_data.size());
-
-    return uncompressed_data;
+    ASSERT_MSG(uncompressed_size == static_cast<int>(output.size()), "{} != {}", output.size(),
+               uncompressed_size);
 }
 
 constexpr u32 PageAlignSize(u32 size) {
@@ -87,22 +89,56 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::
         return std::nullopt;
     }
 
-    // Build program image
+    // Build program image. The file is read on this thread, as reads of the underlying storage
+    // may not be thread safe, then compressed segments are decompressed concurrently.
     Kernel::CodeSet codeset;
     Kernel::PhysicalMemory program_image;
+    std::array<std::vector<u8>, 3> segment_data;
+    std::array<std::size_t, 3> segment_sizes{};
+    std::size_t image_end = 0;
     for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
-        std::vector<u8> data = nso_file.ReadBytes(nso_header.segments_compressed_size[i],
-                                                  nso_header.segments[i].offset);
-        if (nso_header.IsSegmentCompressed(i)) {
-            data = DecompressSegment(data, nso_header.segments[i]);
-        }
-        program_image.resize(nso_header.segments[i].location + static_cast<u32>(data.size()));
-        std::memcpy(program_image.data() + nso_header.segments[i].location, data.data(),
-                    data.size());
+        segment_sizes[i] = nso_header.IsSegmentCompressed(i)
+                               ? nso_header.segments[i].size
+                               : nso_header.segments_compressed_size[i];
+        image_end =
+            std::max<std::size_t>(image_end, nso_header.segments[i].location + segment_sizes[i]);
         codeset.segments[i].addr = nso_header.segments[i].location;
         codeset.segments[i].offset = nso_header.segments[i].location;
         codeset.segments[i].size = nso_header.segments[i].size;
     }
+    program_image.resize(image_end);
+
+    // Uncompressed segments are read straight into the program image
+    std::array<FileSys::VfsReadRequest, 3> image_reads;
+    std::size_t num_image_reads = 0;
+    for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
+        if (nso_header.IsSegmentCompressed(i)) {
+            segment_data[i] = nso_file.ReadBytes(nso_header.segments_compressed_size[i],
+                                                 nso_header.segments[i].offset);
+        } else {
+            image_reads[num_image_reads++] = {
+                .output = {program_image.data() + nso_header.segments[i].location,
+                           segment_sizes[i]},
+                .offset = nso_header.segments[i].offset,
+            };
+        }
+    }
+    nso_file.ReadScatter({image_reads.data(), num_image_reads});
+
+    std::array<std::future<void>, 3> decompressions;
+    for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
+        if (nso_header.IsSegmentCompressed(i)) {
+            const std::span<u8> output{program_image.data() + nso_header.segments[i].location,
+                                       segment_sizes[i]};
+            decompressions[i] = std::async(std::launch::async, DecompressSegment,
+                                           std::span<const u8>{segment_data[i]}, output);
+        }
+    }
+    for (auto& decompression : decompressions) {
+        if (decompression.valid()) {
+            decompression.get();
+        }
+    }
 
     if (should_pass_arguments && !Settings::values.program_args.GetValue().empty()) {
         const auto arg_data{Settings::values.program_args.GetValue()};
@@ -145,6 +181,13 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::
         return load_base + image_size;
     }
 
+    if (process.Is64BitProcess() && Settings::IsHleMemoryFunctionsEnabled()) {
+        const std::size_t code_end = nso_header.segments[0].location + nso_header.segments[0].size;
+        const std::size_t num_patched = Core::GuestHooks::PatchModule(program_image, code_end);
+        LOG_DEBUG(Loader, "Replaced {} functions of {} with host implementations", num_patched,
+                  nso_file.GetName());
+    }
+
     // Apply cheats if they exist and the program has a valid title ID
     if (pm) {
         system.SetCurrentProcessBuildID(nso_header.build_id);
@@ -40,6 +40,10 @@ struct Memory::Impl {
         system.ArmInterface(core_id).PageTableChanged(*current_page_table, address_space_width);
     }
 
+    void SetCurrentPageTable(Common::PageTable& page_table) {
+        current_page_table = &page_table;
+    }
+
     void MapMemoryRegion(Common::PageTable& page_table, VAddr base, u64 size, PAddr target) {
         ASSERT_MSG((size & PAGE_MASK) == 0, "non-page aligned size: {:016X}", size);
         ASSERT_MSG((base & PAGE_MASK) == 0, "non-page aligned base: {:016X}", base);
@@ -94,6 +98,27 @@ struct Memory::Impl {
         return nullptr;
     }
 
+    u8* GetContiguousPointer(const VAddr vaddr, const std::size_t size) const {
+        const auto& pointers = current_page_table->pointers;
+        const std::size_t first_page = vaddr >> PAGE_BITS;
+        const std::size_t last_page = (vaddr + std::max<std::size_t>(size, 1) - 1) >> PAGE_BITS;
+        if (last_page >= pointers.size() || last_page < first_page) {
+            return nullptr;
+        }
+        // Pages store their host pointer minus their guest address, so pages that are contiguous
+        // in host memory store the same value
+        u8* const base = Common::PageTable::PageInfo::ExtractPointer(pointers[first_page].Raw());
+        if (!base) {
+            return nullptr;
+        }
+        for (std::size_t page = first_page + 1; page <= last_page; ++page) {
+            if (Common::PageTable::PageInfo::ExtractPointer(pointers[page].Raw()) != base) {
+                return nullptr;
+            }
+        }
+        return base + vaddr;
+    }
+
     u8 Read8(const VAddr addr) {
         return Read<u8>(addr);
     }
@@ -559,13 +584,25 @@ struct Memory::Impl {
 
         // During boot, current_page_table might not be set yet, in which case we need not flush
         if (system.IsPoweredOn()) {
+            // Flush contiguous runs of cached pages at once instead of page by page
             auto& gpu = system.GPU();
+            u64 run_begin = 0;
+            u64 run_size = 0;
             for (u64 i = 0; i < size; i++) {
                 const auto page = base + i;
                 if (page_table.pointers[page].Type() == Common::PageType::RasterizerCachedMemory) {
-                    gpu.FlushAndInvalidateRegion(page << PAGE_BITS, PAGE_SIZE);
+                    if (run_size == 0) {
+                        run_begin = page;
+                    }
+                    ++run_size;
+                } else if (run_size != 0) {
+                    gpu.FlushAndInvalidateRegion(run_begin << PAGE_BITS, run_size << PAGE_BITS);
+                    run_size = 0;
                 }
             }
+            if (run_size != 0) {
+                gpu.FlushAndInvalidateRegion(run_begin << PAGE_BITS, run_size << PAGE_BITS);
+            }
         }
 
         const VAddr end = base + size;
@@ -775,18 +812,29 @@ Memory::~Memory() = default;
 
 void Memory::Reset() {
     impl = std::make_unique<Impl>(system);
+    mapping_generation.fetch_add(1, std::memory_order_release);
 }
 
 void Memory::SetCurrentPageTable(Kernel::KProcess& process, u32 core_id) {
     impl->SetCurrentPageTable(process, core_id);
 }
 
+void Memory::SetCurrentPageTable(Common::PageTable& page_table) {
+    impl->SetCurrentPageTable(page_table);
+}
+
 void Memory::MapMemoryRegion(Common::PageTable& page_table, VAddr base, u64 size, PAddr target) {
     impl->MapMemoryRegion(page_table, base, size, target);
+    mapping_generation.fetch_add(1, std::memory_order_release);
 }
 
 void Memory::UnmapRegion(Common::PageTable& page_table, VAddr base, u64 size) {
     impl->UnmapRegion(page_table, base, size);
+    mapping_generation.fetch_add(1, std::memory_order_release);
+}
+
+u64 Memory::GetMappingGeneration() const {
+    return mapping_generation.load(std::memory_order_acquire);
 }
 
 bool Memory::IsValidVirtualAddress(const Kernel::KProcess& process, const VAddr vaddr) const {
@@ -805,6 +853,14 @@ const u8* Memory::GetPointer(VAddr vaddr) const {
     return impl->GetPointer(vaddr);
 }
 
+u8* Memory::GetContiguousPointer(VAddr vaddr, std::size_t size) {
+    return impl->GetContiguousPointer(vaddr, size);
+}
+
+const u8* Memory::GetContiguousPointer(VAddr vaddr, std::size_t size) const {
+    return impl->GetContiguousPointer(vaddr, size);
+}
+
 u8 Memory::Read8(const VAddr addr) {
     return impl->Read8(addr);
 }
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <memory>
 #include <string>
@@ -70,6 +71,14 @@ public:
      */
     void SetCurrentPageTable(Kernel::KProcess& process, u32 core_id);
 
+    /**
+     * Changes the currently active page table to one that is not owned by a process, so guest code
+     * can run without a kernel. Notifying the CPU cores of the change is left to the caller.
+     *
+     * @param page_table The page table to use.
+     */
+    void SetCurrentPageTable(Common::PageTable& page_table);
+
     /**
      * Maps an allocated buffer onto a region of the emulated process address space.
      *
@@ -90,6 +99,14 @@ public:
      */
     void UnmapRegion(Common::PageTable& page_table, VAddr base, u64 size);
 
+    /**
+     * Gets the generation of the emulated address space mappings. It changes whenever a region
+     * is mapped or unmapped, so host pointers obtained under another generation may be stale.
+     *
+     * @returns The current mapping generation.
+     */
+    u64 GetMappingGeneration() const;
+
     /**
      * Checks whether or not the supplied address is a valid virtual
      * address for the given process.
@@ -141,6 +158,21 @@ public:
         return reinterpret_cast<T*>(GetPointer(vaddr));
     }
 
+    /**
+     * Gets a pointer to the given address range when it's backed by contiguous host memory.
+     *
+     * @param vaddr Virtual address to retrieve a pointer to.
+     * @param size  Size of the address range in bytes.
+     *
+     * @returns The pointer to the given address range, or nullptr when part of the range is
+     *          unmapped, rasterizer cached or not contiguous in host memory. In that case the
+     *          range has to be read with ReadBlock.
+     */
+    u8* GetContiguousPointer(VAddr vaddr, std::size_t size);
+
+    /// Returns a read-only pointer to the given address range, see the non-const overload.
+    const u8* GetContiguousPointer(VAddr vaddr, std::size_t size) const;
+
     /**
      * Reads an 8-bit unsigned value from the current process' address space
      * at the given virtual address.
@@ -533,6 +565,9 @@ private:
 
     struct Impl;
     std::unique_ptr<Impl> impl;
+
+    /// Kept outside of Impl so resetting the memory system doesn't reuse generations
+    std::atomic<u64> mapping_generation{};
 };
 
 /// Determines if the given VAddr is a kernel address
@@ -284,6 +284,9 @@ public:
 
         virtual void DebugLog(u8 id, u64 value) = 0;
         virtual void CommandLog(std::string_view data) = 0;
+
+        /// Returns true when CommandLog messages are consumed, they're not formatted otherwise
+        virtual bool IsCommandLogEnabled() const = 0;
     };
 
     static constexpr std::size_t MaximumProgramOpcodeCount = 0x400;
@@ -311,12 +314,15 @@ private:
     std::size_t condition_depth = 0;
     bool decode_success = false;
     std::array<u32, MaximumProgramOpcodeCount> program{};
+    // Program decoded once when it's loaded, instruction_ptr indexes it while executing
+    std::vector<CheatVmOpcode> decoded_program;
     std::array<u64, NumRegisters> registers{};
     std::array<u64, NumRegisters> saved_values{};
     std::array<u64, NumStaticRegisters> static_registers{};
     std::array<std::size_t, NumRegisters> loop_tops{};
 
     bool DecodeNextOpcode(CheatVmOpcode& out);
+    bool FetchNextOpcode(CheatVmOpcode& out);
     void SkipConditionalBlock();
     void ResetState();
 
@@ -379,7 +379,9 @@ std::pair<IPv4Address, Errno> GetHostIPv4Address() {
 std::pair<s32, Errno> Poll(std::vector<PollFD>& pollfds, s32 timeout) {
     const size_t num = pollfds.size();
 
-    std::vector<WSAPOLLFD> host_pollfds(pollfds.size());
+    // Polling is done every frame by most online games, keep the buffer around
+    thread_local std::vector<WSAPOLLFD> host_pollfds;
+    host_pollfds.resize(num);
     std::transform(pollfds.begin(), pollfds.end(), host_pollfds.begin(), [](PollFD fd) {
         WSAPOLLFD result;
         result.fd = fd.socket->fd;
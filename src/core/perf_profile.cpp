@@ -0,0 +1,220 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <sstream>
+#include <fmt/format.h>
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "core/perf_profile.h"
+
+namespace Core {
+namespace {
+/// Keys of the settings in the string representation of a combination, in order
+constexpr std::array<char, 5> SETTING_KEYS{'a', 'g', 's', 'f', 'c'};
+
+const PerfProfileSample* FindSample(const std::vector<PerfProfileSample>& samples,
+                                    const TunedSettings& settings) {
+    const auto it = std::ranges::find(samples, settings, &PerfProfileSample::settings);
+    return it != samples.end() ? &*it : nullptr;
+}
+} // Anonymous namespace
+
+TunedSettings TunedSettings::FromCurrent() {
+    return TunedSettings{
+        .use_asynchronous_gpu_emulation =
+            Settings::values.use_asynchronous_gpu_emulation.GetValue(),
+        .gpu_accuracy = Settings::values.gpu_accuracy.GetValue(),
+        .use_asynchronous_shaders = Settings::values.use_asynchronous_shaders.GetValue(),
+        .use_fast_gpu_time = Settings::values.use_fast_gpu_time.GetValue(),
+        .cpu_accuracy = Settings::values.cpu_accuracy.GetValue(),
+    };
+}
+
+std::optional<TunedSettings> TunedSettings::FromString(std::string_view string) {
+    if (string.size() != SETTING_KEYS.size() * 2) {
+        return std::nullopt;
+    }
+    std::array<u32, SETTING_KEYS.size()> values{};
+    for (std::size_t i = 0; i < SETTING_KEYS.size(); ++i) {
+        const char digit = string[i * 2 + 1];
+        if (string[i * 2] != SETTING_KEYS[i] || digit < '0' || digit > '9') {
+            return std::nullopt;
+        }
+        values[i] = static_cast<u32>(digit - '0');
+    }
+    if (values[0] > 1 || values[1] > 2 || values[2] > 1 || values[3] > 1 || values[4] > 2) {
+        return std::nullopt;
+    }
+    return TunedSettings{
+        .use_asynchronous_gpu_emulation = values[0] != 0,
+        .gpu_accuracy = static_cast<Settings::GPUAccuracy>(values[1]),
+        .use_asynchronous_shaders = values[2] != 0,
+        .use_fast_gpu_time = values[3] != 0,
+        .cpu_accuracy = static_cast<Settings::CPUAccuracy>(values[4]),
+    };
+}
+
+void TunedSettings::Apply() const {
+    Settings::values.use_asynchronous_gpu_emulation.SetValue(use_asynchronous_gpu_emulation);
+    Settings::values.gpu_accuracy.SetValue(gpu_accuracy);
+    Settings::values.use_asynchronous_shaders.SetValue(use_asynchronous_shaders);
+    Settings::values.use_fast_gpu_time.SetValue(use_fast_gpu_time);
+    Settings::values.cpu_accuracy.SetValue(cpu_accuracy);
+}
+
+std::string TunedSettings::ToString() const {
+    return fmt::format("{}{}{}{}{}{}{}{}{}{}", SETTING_KEYS[0],
+                       static_cast<u32>(use_asynchronous_gpu_emulation), SETTING_KEYS[1],
+                       static_cast<u32>(gpu_accuracy), SETTING_KEYS[2],
+                       static_cast<u32>(use_asynchronous_shaders), SETTING_KEYS[3],
+                       static_cast<u32>(use_fast_gpu_time), SETTING_KEYS[4],
+                       static_cast<u32>(cpu_accuracy));
+}
+
+void PerfProfile::Begin(u64 title_id_) {
+    is_active = false;
+    samples.clear();
+    const Settings::PerfTuning mode = Settings::values.perf_tuning.GetValue();
+    if (mode == Settings::PerfTuning::Disabled || title_id_ == 0) {
+        return;
+    }
+    is_active = true;
+    title_id = title_id_;
+    path = Common::FS::GetYuzuPath(Common::FS::YuzuPath::ConfigDir) / "custom" /
+           fmt::format("{:016X}.perf", title_id);
+    Load();
+
+    configured_settings = TunedSettings::FromCurrent();
+    session_settings =
+        mode == Settings::PerfTuning::AutoTune ? PickSettings() : configured_settings;
+    if (session_settings != configured_settings) {
+        LOG_INFO(Core, "Running {:016X} with tuned settings {} instead of {}", title_id,
+                 session_settings.ToString(), configured_settings.ToString());
+        session_settings.Apply();
+    }
+    // Counted up front, sessions that never end leave the combination marked as unstable
+    ++FindOrInsertSample(session_settings).sessions;
+    Save();
+}
+
+void PerfProfile::End(double mean_frametime_ms, u64 frames) {
+    if (!is_active) {
+        return;
+    }
+    is_active = false;
+    if (session_settings != configured_settings) {
+        configured_settings.Apply();
+    }
+    PerfProfileSample& sample = FindOrInsertSample(session_settings);
+    ++sample.completed_sessions;
+    sample.frames += frames;
+    sample.total_frametime_ms += mean_frametime_ms * static_cast<double>(frames);
+    Save();
+
+    const std::optional<TunedSettings> fastest = Fastest();
+    if (fastest && *fastest != configured_settings) {
+        LOG_INFO(Core, "Fastest stable settings measured for {:016X}: {} ({:.2f} ms per frame)",
+                 title_id, fastest->ToString(), FindSample(samples, *fastest)->MeanFrametime());
+    }
+}
+
+std::optional<TunedSettings> PerfProfile::Fastest() const {
+    const PerfProfileSample* fastest = nullptr;
+    for (const PerfProfileSample& sample : samples) {
+        if (!sample.IsStable() || sample.frames < MIN_MEASURED_FRAMES) {
+            continue;
+        }
+        if (!fastest || sample.MeanFrametime() < fastest->MeanFrametime()) {
+            fastest = &sample;
+        }
+    }
+    if (!fastest) {
+        return std::nullopt;
+    }
+    return fastest->settings;
+}
+
+TunedSettings PerfProfile::PickSettings() const {
+    std::vector<TunedSettings> candidates{configured_settings};
+    TunedSettings candidate = configured_settings;
+    candidate.use_asynchronous_gpu_emulation = !candidate.use_asynchronous_gpu_emulation;
+    candidates.push_back(candidate);
+    candidate = configured_settings;
+    candidate.gpu_accuracy = Settings::GPUAccuracy::Normal;
+    candidates.push_back(candidate);
+    candidate = configured_settings;
+    candidate.use_asynchronous_shaders = true;
+    candidates.push_back(candidate);
+    candidate = configured_settings;
+    candidate.use_fast_gpu_time = true;
+    candidates.push_back(candidate);
+    candidate = configured_settings;
+    candidate.cpu_accuracy = Settings::CPUAccuracy::Unsafe;
+    candidates.push_back(candidate);
+
+    for (const TunedSettings& settings : candidates) {
+        const PerfProfileSample* const sample = FindSample(samples, settings);
+        if (!sample || (sample->IsStable() && sample->frames < MIN_MEASURED_FRAMES)) {
+            return settings;
+        }
+    }
+    return Fastest().value_or(configured_settings);
+}
+
+PerfProfileSample& PerfProfile::FindOrInsertSample(const TunedSettings& settings) {
+    const auto it = std::ranges::find(samples, settings, &PerfProfileSample::settings);
+    if (it != samples.end()) {
+        return *it;
+    }
+    return samples.emplace_back(PerfProfileSample{
+        .settings = settings,
+        .sessions = 0,
+        .completed_sessions = 0,
+        .frames = 0,
+        .total_frametime_ms = 0.0,
+    });
+}
+
+void PerfProfile::Load() {
+    if (!Common::FS::Exists(path)) {
+        return;
+    }
+    std::istringstream stream{
+        Common::FS::ReadStringFromFile(path, Common::FS::FileType::TextFile)};
+    std::string line;
+    while (std::getline(stream, line)) {
+        std::istringstream line_stream{line};
+        std::string settings_string;
+        PerfProfileSample sample{};
+        line_stream >> settings_string >> sample.sessions >> sample.completed_sessions >>
+            sample.frames >> sample.total_frametime_ms;
+        const std::optional<TunedSettings> settings = TunedSettings::FromString(settings_string);
+        if (!line_stream || !settings || FindSample(samples, *settings)) {
+            LOG_WARNING(Core, "Ignoring invalid performance profile line \"{}\"", line);
+            continue;
+        }
+        sample.settings = *settings;
+        samples.push_back(sample);
+    }
+}
+
+void PerfProfile::Save() const {
+    std::string contents;
+    for (const PerfProfileSample& sample : samples) {
+        contents += fmt::format("{} {} {} {} {:.3f}\n", sample.settings.ToString(), sample.sessions,
+                                sample.completed_sessions, sample.frames,
+                                sample.total_frametime_ms);
+    }
+    if (!Common::FS::CreateParentDirs(path) ||
+        Common::FS::WriteStringToFile(path, Common::FS::FileType::TextFile, contents) !=
+            contents.size()) {
+        LOG_ERROR(Core, "Failed to write the performance profile of {:016X}", title_id);
+    }
+}
+
+} // namespace Core
@@ -0,0 +1,108 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <compare>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "common/common_types.h"
+#include "common/settings.h"
+
+namespace Core {
+
+/// Combination of the settings tuned per title
+struct TunedSettings {
+    bool use_asynchronous_gpu_emulation;
+    Settings::GPUAccuracy gpu_accuracy;
+    bool use_asynchronous_shaders;
+    bool use_fast_gpu_time;
+    Settings::CPUAccuracy cpu_accuracy;
+
+    /// Returns the values currently in effect
+    [[nodiscard]] static TunedSettings FromCurrent();
+
+    /// Parses a combination written by ToString
+    [[nodiscard]] static std::optional<TunedSettings> FromString(std::string_view string);
+
+    /// Makes these values the ones in effect
+    void Apply() const;
+
+    /// Returns a compact representation of the combination, without spaces
+    [[nodiscard]] std::string ToString() const;
+
+    auto operator<=>(const TunedSettings&) const = default;
+};
+
+/// Frame times measured with one combination of settings over every session of a title
+struct PerfProfileSample {
+    TunedSettings settings;
+    /// Sessions started with the combination
+    u32 sessions;
+    /// Sessions shut down normally, the others crashed or hung
+    u32 completed_sessions;
+    /// System frames measured
+    u64 frames;
+    /// Sum of the walltime of the frames measured, excluding waits, in milliseconds
+    double total_frametime_ms;
+
+    /// Returns true when no session with the combination ended abnormally
+    [[nodiscard]] bool IsStable() const {
+        return completed_sessions == sessions;
+    }
+
+    /// Returns the mean walltime per system frame, in milliseconds
+    [[nodiscard]] double MeanFrametime() const {
+        return frames != 0 ? total_frametime_ms / static_cast<double>(frames) : 0.0;
+    }
+};
+
+/**
+ * Records the frame times a title runs at with each combination of the tuned settings, in a file
+ * next to its per-game configuration. When auto tuning, each session runs with a combination that
+ * still lacks measurements, one setting away from the configured one, until all were measured.
+ * Sessions then run with the fastest combination that never crashed. The configured values are
+ * restored when the session ends, so they are never saved with the tuned ones.
+ */
+class PerfProfile {
+public:
+    /// Frames a combination needs before its frame times are trusted
+    static constexpr u64 MIN_MEASURED_FRAMES = 60 * 60 * 3;
+
+    /// Loads the profile of a title and picks the settings of the session about to start
+    void Begin(u64 title_id);
+
+    /// Records the frame times of the session and restores the configured settings
+    void End(double mean_frametime_ms, u64 frames);
+
+    /// Returns the fastest stable combination measured, if any
+    [[nodiscard]] std::optional<TunedSettings> Fastest() const;
+
+    /// Returns the samples of the loaded title
+    [[nodiscard]] const std::vector<PerfProfileSample>& Samples() const {
+        return samples;
+    }
+
+private:
+    /// Returns the combination the current session should run with
+    [[nodiscard]] TunedSettings PickSettings() const;
+
+    /// Returns the sample of a combination, creating it when it doesn't exist
+    PerfProfileSample& FindOrInsertSample(const TunedSettings& settings);
+
+    void Load();
+    void Save() const;
+
+    bool is_active = false;
+    u64 title_id = 0;
+    std::filesystem::path path;
+    TunedSettings configured_settings{};
+    TunedSettings session_settings{};
+    std::vector<PerfProfileSample> samples;
+};
+
+} // namespace Core
@@ -8,18 +8,21 @@
 #include <mutex>
 #include <numeric>
 #include <sstream>
+#include <string>
 #include <thread>
 #include <fmt/chrono.h>
 #include <fmt/format.h>
 #include "common/fs/file.h"
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
+#include "common/logging/log.h"
 #include "common/math_util.h"
 #include "common/settings.h"
 #include "core/perf_stats.h"
 
 using namespace std::chrono_literals;
 using DoubleSecs = std::chrono::duration<double, std::chrono::seconds::period>;
+using DoubleMicros = std::chrono::duration<double, std::chrono::microseconds::period>;
 using std::chrono::duration_cast;
 using std::chrono::microseconds;
 
@@ -28,6 +31,37 @@ using std::chrono::microseconds;
 constexpr std::size_t IgnoreFrames = 5;
 
 namespace Core {
+namespace {
+/// A frame is a stutter when it is this many times longer than the recent average...
+constexpr double STUTTER_FACTOR = 2.0;
+/// ...and at least this many milliseconds longer, so fast frames don't count as stutters
+constexpr double STUTTER_MIN_EXCESS_MS = 8.0;
+/// Frames kept for the percentiles when the stats aren't reset, about a minute at 60 FPS
+constexpr std::size_t MAX_FRAME_LENGTHS = 4096;
+/// Weight of a new frame in the moving average of frame lengths
+constexpr double AVERAGE_WEIGHT = 1.0 / 16.0;
+
+constexpr std::array<const char*, NUM_STALL_CAUSES> STALL_CAUSE_NAMES{
+    "shader_compile",
+    "texture_decode",
+    "gpu_flush",
+};
+
+double ToMilliseconds(PerfStats::Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+/// Returns the percentile of the values, reordering them
+double Percentile(std::vector<double>& values, double percentile) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    const auto rank = static_cast<std::size_t>(percentile * static_cast<double>(values.size() - 1));
+    const auto nth = values.begin() + static_cast<std::ptrdiff_t>(rank);
+    std::nth_element(values.begin(), nth, values.end());
+    return *nth;
+}
+} // Anonymous namespace
 
 PerfStats::PerfStats(u64 title_id_) : title_id(title_id_) {}
 
@@ -51,6 +85,29 @@ PerfStats::~PerfStats() {
                                 Common::FS::FileType::TextFile);
         void(file.WriteString(stream.str()));
     }
+
+    std::string frames = "frame,length_ms,guest_ms,present_ms";
+    for (const char* name : STALL_CAUSE_NAMES) {
+        frames += fmt::format(",{}_ms", name);
+    }
+    frames += ",stutter,stutter_cause\n";
+    for (std::size_t i = IgnoreFrames; i < frame_history.size(); ++i) {
+        const FrameRecord& record = frame_history[i];
+        frames += fmt::format("{},{:.3f},{:.3f},{:.3f}", i, record.length_ms, record.guest_ms,
+                              record.present_ms);
+        for (const double stall_ms : record.stall_ms) {
+            frames += fmt::format(",{:.3f}", stall_ms);
+        }
+        const auto& cause = record.stutter_cause;
+        const char* const cause_name =
+            cause ? STALL_CAUSE_NAMES[static_cast<std::size_t>(*cause)] : "";
+        frames += fmt::format(",{},{}\n", record.stutter ? 1 : 0, cause_name);
+    }
+    const auto frames_path =
+        path / fmt::format("{:%F-%H-%M}_{:016X}_frames.csv", *std::localtime(&t), title_id);
+    Common::FS::IOFile frames_file(frames_path, Common::FS::FileAccessMode::Write,
+                                   Common::FS::FileType::TextFile);
+    void(frames_file.WriteString(frames));
 }
 
 void PerfStats::BeginSystemFrame() {
@@ -71,14 +128,79 @@ void PerfStats::EndSystemFrame() {
     accumulated_frametime += frame_time;
     system_frames += 1;
 
+    FrameRecord record{
+        .length_ms = ToMilliseconds(frame_end - previous_frame_end),
+        .guest_ms = ToMilliseconds(frame_time),
+        .present_ms = ToMilliseconds(frame_begin - previous_frame_end),
+        .stall_ms = {},
+        .stutter = false,
+        .stutter_cause = std::nullopt,
+    };
+    for (std::size_t cause = 0; cause < NUM_STALL_CAUSES; ++cause) {
+        const s64 nanoseconds = stall_ns[cause].exchange(0, std::memory_order_relaxed);
+        record.stall_ms[cause] = static_cast<double>(nanoseconds) / 1'000'000.0;
+    }
+    DetectStutter(record);
+    if (frame_lengths_ms.size() < MAX_FRAME_LENGTHS) {
+        frame_lengths_ms.push_back(record.length_ms);
+    }
+    if (Settings::values.record_frame_times && frame_history.size() < perf_history.size()) {
+        frame_history.push_back(record);
+    }
+
     previous_frame_length = frame_end - previous_frame_end;
     previous_frame_end = frame_end;
 }
 
+void PerfStats::DetectStutter(FrameRecord& record) {
+    const bool warmed_up = current_index > IgnoreFrames;
+    const double excess_ms = record.length_ms - average_frame_length_ms;
+    if (warmed_up && record.length_ms > average_frame_length_ms * STUTTER_FACTOR &&
+        excess_ms > STUTTER_MIN_EXCESS_MS) {
+        record.stutter = true;
+        ++stutters;
+
+        // Blame the longest stall, as long as it covers most of the extra time
+        const auto longest = std::max_element(record.stall_ms.begin(), record.stall_ms.end());
+        const auto cause = static_cast<std::size_t>(longest - record.stall_ms.begin());
+        if (*longest >= excess_ms / 2.0) {
+            record.stutter_cause = static_cast<StallCause>(cause);
+            ++stutter_causes[cause];
+        }
+        LOG_DEBUG(Core, "Stutter: frame took {:.2f} ms against an average of {:.2f} ms, cause {}",
+                  record.length_ms, average_frame_length_ms,
+                  record.stutter_cause ? STALL_CAUSE_NAMES[cause] : "unknown");
+    }
+    if (average_frame_length_ms == 0.0) {
+        average_frame_length_ms = record.length_ms;
+    } else {
+        average_frame_length_ms += (record.length_ms - average_frame_length_ms) * AVERAGE_WEIGHT;
+    }
+}
+
 void PerfStats::EndGameFrame() {
     game_frames.fetch_add(1, std::memory_order_relaxed);
 }
 
+void PerfStats::AddStall(StallCause cause, Clock::duration duration) {
+    const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration);
+    stall_ns[static_cast<std::size_t>(cause)].fetch_add(nanoseconds.count(),
+                                                        std::memory_order_relaxed);
+}
+
+void PerfStats::AddBufferJoin(u64 copied_bytes) {
+    buffer_joins.fetch_add(1, std::memory_order_relaxed);
+    buffer_join_bytes.fetch_add(copied_bytes, std::memory_order_relaxed);
+}
+
+void PerfStats::SetStartupTime(std::chrono::nanoseconds startup_time) {
+    startup_time_ms.store(ToMilliseconds(startup_time), std::memory_order_relaxed);
+}
+
+void PerfStats::AddGpuIdle(std::chrono::nanoseconds idle_time) {
+    gpu_idle_ns.fetch_add(idle_time.count(), std::memory_order_relaxed);
+}
+
 double PerfStats::GetMeanFrametime() const {
     std::lock_guard lock{object_mutex};
 
@@ -91,7 +213,14 @@ double PerfStats::GetMeanFrametime() const {
     return sum / static_cast<double>(current_index - IgnoreFrames);
 }
 
-PerfStatsResults PerfStats::GetAndResetStats(microseconds current_system_time_us) {
+std::size_t PerfStats::GetFrametimeCount() const {
+    std::lock_guard lock{object_mutex};
+    return current_index > IgnoreFrames ? current_index - IgnoreFrames : 0;
+}
+
+PerfStatsResults PerfStats::GetAndResetStats(
+    microseconds current_system_time_us,
+    const std::array<CoreActivity, Hardware::NUM_CPU_CORES>& core_activity) {
     std::lock_guard lock{object_mutex};
 
     const auto now = Clock::now();
@@ -101,13 +230,45 @@ PerfStatsResults PerfStats::GetAndResetStats(microseconds current_system_time_us
     const auto system_us_per_second = (current_system_time_us - reset_point_system_us) / interval;
     const auto current_frames = static_cast<double>(game_frames.load(std::memory_order_relaxed));
     const auto current_fps = current_frames / interval;
-    const PerfStatsResults results{
+    PerfStatsResults results{
         .system_fps = static_cast<double>(system_frames) / interval,
         .average_game_fps = (current_fps + previous_fps) / 2.0,
         .frametime = duration_cast<DoubleSecs>(accumulated_frametime).count() /
                      static_cast<double>(system_frames),
         .emulation_speed = system_us_per_second.count() / 1'000'000.0,
+        .event_lateness = {},
+        .cores = {},
+        .svcs = {},
+        .audio_underruns = 0,
+        .audio_queue_depth_ms = 0,
+        .audio_dropped_samples = 0,
+        .committed_memory = 0,
+        .frametime_p50 = Percentile(frame_lengths_ms, 0.50) / 1000.0,
+        .frametime_p95 = Percentile(frame_lengths_ms, 0.95) / 1000.0,
+        .frametime_p99 = Percentile(frame_lengths_ms, 0.99) / 1000.0,
+        .stutters = stutters,
+        .stutter_causes = stutter_causes,
+        .buffer_joins = buffer_joins.exchange(0, std::memory_order_relaxed),
+        .buffer_join_bytes = buffer_join_bytes.exchange(0, std::memory_order_relaxed),
+        .startup_time_ms = startup_time_ms.load(std::memory_order_relaxed),
+        .gpu_idle = static_cast<double>(gpu_idle_ns.exchange(0, std::memory_order_relaxed)) /
+                    1'000'000'000.0 / interval,
     };
+    for (std::size_t core = 0; core < core_activity.size(); ++core) {
+        const CoreActivity& activity = core_activity[core];
+        results.cores[core] = {
+            .busy = duration_cast<DoubleSecs>(activity.busy_time).count() / interval,
+            .idle = duration_cast<DoubleSecs>(activity.idle_time).count() / interval,
+            .svc_exits = activity.svc_exits,
+            .halt_exits = activity.halt_exits,
+            .wakes = activity.wakes,
+            .average_wake_latency_us =
+                activity.wakes != 0 ? duration_cast<DoubleMicros>(activity.wake_latency).count() /
+                                          static_cast<double>(activity.wakes)
+                                    : 0.0,
+            .max_wake_latency_us = duration_cast<DoubleMicros>(activity.max_wake_latency).count(),
+        };
+    }
 
     // Reset counters
     reset_point = now;
@@ -116,6 +277,9 @@ PerfStatsResults PerfStats::GetAndResetStats(microseconds current_system_time_us
     system_frames = 0;
     game_frames.store(0, std::memory_order_relaxed);
     previous_fps = current_fps;
+    frame_lengths_ms.clear();
+    stutters = 0;
+    stutter_causes = {};
 
     return results;
 }
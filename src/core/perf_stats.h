@@ -9,10 +9,93 @@
 #include <chrono>
 #include <cstddef>
 #include <mutex>
+#include <optional>
+#include <vector>
 #include "common/common_types.h"
+#include "core/hardware_properties.h"
 
 namespace Core {
 
+/// Upper bounds, in microseconds, of the core timing event lateness histogram buckets. A final
+/// bucket counts every event later than the last bound.
+constexpr std::array<u32, 5> EVENT_LATENESS_BOUNDS_US{10, 50, 200, 1000, 5000};
+
+using EventLatenessHistogram = std::array<u32, EVENT_LATENESS_BOUNDS_US.size() + 1>;
+
+/// Number of supervisor call numbers tracked by the SVC statistics
+constexpr std::size_t NUM_SVC_NUMBERS = 0x80;
+
+/// Raw guest CPU counters of one emulated core, accumulated since the last stats reset
+struct CoreActivity {
+    /// Host time spent running guest code in the JIT
+    std::chrono::nanoseconds busy_time;
+    /// Host time spent parked waiting for an interrupt
+    std::chrono::nanoseconds idle_time;
+    /// Number of times the JIT returned to dispatch a supervisor call
+    u64 svc_exits;
+    /// Number of times the JIT was halted for an interrupt or a reschedule
+    u64 halt_exits;
+    /// Number of times the core was woken up from waiting for an interrupt
+    u64 wakes;
+    /// Host time between the interrupts and the core resuming, added over all wakes
+    std::chrono::nanoseconds wake_latency;
+    /// Longest host time between an interrupt and the core resuming
+    std::chrono::nanoseconds max_wake_latency;
+};
+
+struct CoreStatsResults {
+    /// Ratio of walltime the core spent running guest code
+    double busy;
+    /// Ratio of walltime the core spent parked waiting for an interrupt
+    double idle;
+    /// Number of times the JIT returned to dispatch a supervisor call
+    u64 svc_exits;
+    /// Number of times the JIT was halted for an interrupt or a reschedule
+    u64 halt_exits;
+    /// Number of times the core was woken up from waiting for an interrupt
+    u64 wakes;
+    /// Average host time between an interrupt and the core resuming, in microseconds
+    double average_wake_latency_us;
+    /// Longest host time between an interrupt and the core resuming, in microseconds
+    double max_wake_latency_us;
+};
+
+struct SvcStatsResults {
+    /// Number of times the supervisor call was made
+    u64 calls;
+    /// Host time spent in its handler, including time the calling thread was blocked
+    std::chrono::nanoseconds time;
+};
+
+using SvcStatsTable = std::array<SvcStatsResults, NUM_SVC_NUMBERS>;
+
+/// Host work that blocks emulation or presentation, used to attribute stutters
+enum class StallCause : u32 {
+    ShaderCompile, ///< Waiting for a shader or pipeline to be built
+    TextureDecode, ///< Decoding a texture format the host doesn't support on the CPU
+    GpuFlush,      ///< Waiting for the GPU thread to write back guest memory
+};
+
+constexpr std::size_t NUM_STALL_CAUSES = 3;
+
+using StallCauseCounts = std::array<u32, NUM_STALL_CAUSES>;
+
+/// Timing of one system frame, split by phase
+struct FrameRecord {
+    /// Walltime since the previous system frame ended, in milliseconds
+    double length_ms;
+    /// Time spent by the guest producing the frame, in milliseconds
+    double guest_ms;
+    /// Time spent presenting the previous frame, including frame limiting, in milliseconds
+    double present_ms;
+    /// Time spent stalled on each cause during the frame, in milliseconds
+    std::array<double, NUM_STALL_CAUSES> stall_ms;
+    /// True when the frame took much longer than the recent average
+    bool stutter;
+    /// Stall the stutter is attributed to, empty when no stall explains it
+    std::optional<StallCause> stutter_cause;
+};
+
 struct PerfStatsResults {
     /// System FPS (LCD VBlanks) in Hz
     double system_fps;
@@ -22,6 +105,57 @@ struct PerfStatsResults {
     double frametime;
     /// Ratio of walltime / emulated time elapsed
     double emulation_speed;
+    /// Number of core timing events fired in each lateness bucket
+    EventLatenessHistogram event_lateness;
+    /// Guest CPU activity of each emulated core
+    std::array<CoreStatsResults, Hardware::NUM_CPU_CORES> cores;
+    /// Supervisor calls made since the last reset, indexed by SVC number
+    SvcStatsTable svcs;
+    /// Number of audio device callbacks that ran out of samples while playing
+    u64 audio_underruns;
+    /// Deepest audio output queue seen by the device, in milliseconds
+    u32 audio_queue_depth_ms;
+    /// Number of audio samples dropped to keep the output queue short
+    u64 audio_dropped_samples;
+    /// Guest physical memory currently allocated by the kernel, in bytes
+    u64 committed_memory;
+    /// Median walltime between system frames, in seconds
+    double frametime_p50;
+    /// 95th percentile walltime between system frames, in seconds
+    double frametime_p95;
+    /// 99th percentile walltime between system frames, in seconds
+    double frametime_p99;
+    /// Number of system frames that took much longer than the recent average
+    u32 stutters;
+    /// Number of stutters attributed to each stall cause
+    StallCauseCounts stutter_causes;
+    /// Number of buffers merged into larger ones by the GPU buffer cache
+    u32 buffer_joins;
+    /// Bytes copied on the host GPU to merge buffers
+    u64 buffer_join_bytes;
+    /// Walltime from the beginning of the boot to the first game frame, in milliseconds. Zero
+    /// until the first frame is rendered.
+    double startup_time_ms;
+    /// Ratio of walltime the host GPU was seen idle, waiting for commands to be submitted
+    double gpu_idle;
+};
+
+/// Host memory held by each subsystem, in bytes
+struct MemoryUsage {
+    /// Guest physical memory currently allocated by the kernel
+    u64 guest_memory;
+    /// Host images held by the GPU texture cache
+    u64 texture_cache;
+    /// Host buffers held by the GPU buffer cache
+    u64 buffer_cache;
+    /// Host buffers used to upload and download GPU resources
+    u64 staging_buffers;
+    /// Decrypted game file blocks held by the file caches
+    u64 file_cache;
+
+    [[nodiscard]] u64 Total() const {
+        return guest_memory + texture_cache + buffer_cache + staging_buffers + file_cache;
+    }
 };
 
 /**
@@ -39,13 +173,30 @@ public:
     void EndSystemFrame();
     void EndGameFrame();
 
-    PerfStatsResults GetAndResetStats(std::chrono::microseconds current_system_time_us);
+    /// Adds host time spent stalled on a cause to the current system frame
+    void AddStall(StallCause cause, Clock::duration duration);
+
+    /// Counts a buffer merged into a larger one, with the bytes copied to do so
+    void AddBufferJoin(u64 copied_bytes);
+
+    /// Sets the walltime taken to boot from the beginning of System::Load to the first frame
+    void SetStartupTime(std::chrono::nanoseconds startup_time);
+
+    /// Adds host time the host GPU spent idle waiting for the renderer to submit commands
+    void AddGpuIdle(std::chrono::nanoseconds idle_time);
+
+    PerfStatsResults GetAndResetStats(
+        std::chrono::microseconds current_system_time_us,
+        const std::array<CoreActivity, Hardware::NUM_CPU_CORES>& core_activity = {});
 
     /**
      * Returns the arithmetic mean of all frametime values stored in the performance history.
      */
     double GetMeanFrametime() const;
 
+    /// Returns the number of frametime values the mean frametime is computed from
+    std::size_t GetFrametimeCount() const;
+
     /**
      * Gets the ratio between walltime and the emulated time of the previous system frame. This is
      * useful for scaling inputs or outputs moving between the two time domains.
@@ -53,6 +204,9 @@ public:
     double GetLastFrameTimeScale() const;
 
 private:
+    /// Flags the frame as a stutter when it is much longer than the recent average
+    void DetectStutter(FrameRecord& record);
+
     mutable std::mutex object_mutex;
 
     /// Title ID for the game that is running. 0 if there is no game running yet
@@ -83,6 +237,46 @@ private:
     Clock::duration previous_frame_length = Clock::duration::zero();
     /// Previously computed fps
     double previous_fps = 0;
+
+    /// Time stalled on each cause during the current system frame, in nanoseconds
+    std::array<std::atomic<s64>, NUM_STALL_CAUSES> stall_ns{};
+    /// Buffers joined since the last reset
+    std::atomic<u32> buffer_joins = 0;
+    /// Bytes copied by buffer joins since the last reset
+    std::atomic<u64> buffer_join_bytes = 0;
+    /// Walltime taken to boot to the first frame, in milliseconds
+    std::atomic<double> startup_time_ms = 0.0;
+    /// Host GPU idle time since the last reset, in nanoseconds
+    std::atomic<s64> gpu_idle_ns = 0;
+    /// Walltime between system frames since the last reset, in milliseconds
+    std::vector<double> frame_lengths_ms;
+    /// Moving average of the walltime between system frames, in milliseconds
+    double average_frame_length_ms = 0;
+    /// Number of stutters since the last reset
+    u32 stutters = 0;
+    /// Number of stutters since the last reset attributed to each stall cause
+    StallCauseCounts stutter_causes{};
+    /// Phases of every frame, only filled when frame times are recorded
+    std::vector<FrameRecord> frame_history;
+};
+
+/// Attributes the host time spent in its scope to a stall cause of the current system frame
+class ScopedStall {
+public:
+    explicit ScopedStall(PerfStats& perf_stats_, StallCause cause_)
+        : perf_stats{perf_stats_}, cause{cause_}, begin{PerfStats::Clock::now()} {}
+
+    ~ScopedStall() {
+        perf_stats.AddStall(cause, PerfStats::Clock::now() - begin);
+    }
+
+    ScopedStall(const ScopedStall&) = delete;
+    ScopedStall& operator=(const ScopedStall&) = delete;
+
+private:
+    PerfStats& perf_stats;
+    StallCause cause;
+    PerfStats::Clock::time_point begin;
 };
 
 class FrameLimiter {
@@ -0,0 +1,109 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <fmt/format.h>
+#include "common/logging/log.h"
+#include "core/startup_timeline.h"
+
+namespace Core {
+namespace {
+double ToMilliseconds(std::chrono::nanoseconds duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+} // Anonymous namespace
+
+void StartupTimeline::Reset() {
+    std::scoped_lock lock{mutex};
+    is_complete.store(false, std::memory_order_relaxed);
+    boot_begin = Clock::now();
+    total_time = {};
+    phases.clear();
+    open_phases.clear();
+}
+
+void StartupTimeline::BeginPhase(std::string name) {
+    std::scoped_lock lock{mutex};
+    if (is_complete.load(std::memory_order_relaxed)) {
+        return;
+    }
+    open_phases.push_back(phases.size());
+    phases.push_back({
+        .name = std::move(name),
+        .depth = static_cast<u32>(open_phases.size() - 1),
+        .begin = Clock::now() - boot_begin,
+        .duration = {},
+    });
+}
+
+void StartupTimeline::EndPhase() {
+    std::scoped_lock lock{mutex};
+    if (open_phases.empty()) {
+        return;
+    }
+    StartupPhase& phase = phases[open_phases.back()];
+    phase.duration = Clock::now() - boot_begin - phase.begin;
+    open_phases.pop_back();
+}
+
+void StartupTimeline::MarkFirstFrame() {
+    if (is_complete.load(std::memory_order_relaxed)) {
+        return;
+    }
+    std::scoped_lock lock{mutex};
+    if (is_complete.exchange(true, std::memory_order_relaxed)) {
+        return;
+    }
+    total_time = Clock::now() - boot_begin;
+
+    // The time after the last phase ended is what the guest took to present its first frame
+    std::chrono::nanoseconds last_end{};
+    for (const StartupPhase& phase : phases) {
+        if (phase.depth == 0) {
+            last_end = std::max(last_end, phase.begin + phase.duration);
+        }
+    }
+    phases.push_back({
+        .name = "first_frame",
+        .depth = 0,
+        .begin = last_end,
+        .duration = total_time - last_end,
+    });
+    LogReport();
+}
+
+std::chrono::nanoseconds StartupTimeline::TotalTime() const {
+    std::scoped_lock lock{mutex};
+    return total_time;
+}
+
+std::vector<StartupPhase> StartupTimeline::Phases() const {
+    std::scoped_lock lock{mutex};
+    return phases;
+}
+
+std::string StartupTimeline::ToJson() const {
+    std::scoped_lock lock{mutex};
+    std::string json = fmt::format("{{\n  \"total_ms\": {:.3f},\n  \"phases\": [",
+                                   ToMilliseconds(total_time));
+    for (std::size_t i = 0; i < phases.size(); ++i) {
+        const StartupPhase& phase = phases[i];
+        json += fmt::format("{}\n    {{\"name\": \"{}\", \"depth\": {}, \"begin_ms\": {:.3f}, "
+                            "\"duration_ms\": {:.3f}}}",
+                            i == 0 ? "" : ",", phase.name, phase.depth,
+                            ToMilliseconds(phase.begin), ToMilliseconds(phase.duration));
+    }
+    json += "\n  ]\n}\n";
+    return json;
+}
+
+void StartupTimeline::LogReport() const {
+    LOG_INFO(Core, "Boot to first frame took {:.2f} ms", ToMilliseconds(total_time));
+    for (const StartupPhase& phase : phases) {
+        LOG_INFO(Core, "{:>{}}{}: {:.2f} ms", "", phase.depth * 2 + 2, phase.name,
+                 ToMilliseconds(phase.duration));
+    }
+}
+
+} // namespace Core
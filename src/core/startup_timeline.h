@@ -0,0 +1,96 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common/common_types.h"
+
+namespace Core {
+
+/// Timing of one step of the boot sequence
+struct StartupPhase {
+    /// Name of the phase, unique among its siblings
+    std::string name;
+    /// Number of phases this one is nested in
+    u32 depth;
+    /// Walltime since the boot began when the phase began
+    std::chrono::nanoseconds begin;
+    /// Walltime spent in the phase, including its nested phases
+    std::chrono::nanoseconds duration;
+};
+
+/**
+ * Records the walltime spent in each phase of the boot sequence, from the beginning of
+ * System::Load to the first frame rendered by the guest. All public functions of this class are
+ * thread-safe.
+ */
+class StartupTimeline {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Discards the phases of the previous boot and starts timing a new one
+    void Reset();
+
+    /// Begins a phase nested in the phase currently open, if any
+    void BeginPhase(std::string name);
+
+    /// Ends the innermost phase currently open
+    void EndPhase();
+
+    /// Ends the boot with the first guest frame, logging the report. Only the first call is kept.
+    void MarkFirstFrame();
+
+    /// Returns true when the first frame of this boot has been rendered
+    [[nodiscard]] bool IsComplete() const {
+        return is_complete.load(std::memory_order_relaxed);
+    }
+
+    /// Returns the walltime from the beginning of the boot to the first frame
+    [[nodiscard]] std::chrono::nanoseconds TotalTime() const;
+
+    /// Returns the phases recorded so far, in the order they began
+    [[nodiscard]] std::vector<StartupPhase> Phases() const;
+
+    /// Returns the report as a JSON document for tracking boot times across builds
+    [[nodiscard]] std::string ToJson() const;
+
+private:
+    /// Logs every phase, indented by depth
+    void LogReport() const;
+
+    mutable std::mutex mutex;
+    std::atomic_bool is_complete{false};
+    Clock::time_point boot_begin = Clock::now();
+    std::chrono::nanoseconds total_time{};
+    std::vector<StartupPhase> phases;
+    /// Indices of the phases currently open, innermost last
+    std::vector<std::size_t> open_phases;
+};
+
+/// Times its scope as a phase of the boot sequence
+class ScopedStartupPhase {
+public:
+    explicit ScopedStartupPhase(StartupTimeline& timeline_, std::string name)
+        : timeline{timeline_} {
+        timeline.BeginPhase(std::move(name));
+    }
+
+    ~ScopedStartupPhase() {
+        timeline.EndPhase();
+    }
+
+    ScopedStartupPhase(const ScopedStartupPhase&) = delete;
+    ScopedStartupPhase& operator=(const ScopedStartupPhase&) = delete;
+
+private:
+    StartupTimeline& timeline;
+};
+
+} // namespace Core
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <chrono>
+#include <cstring>
 #include <thread>
 
 #include <libusb.h>
@@ -13,6 +14,10 @@
 #include "input_common/gcadapter/gc_adapter.h"
 
 namespace GCAdapter {
+namespace {
+/// Timeout of the transfers, a report that doesn't arrive in time counts as an input error
+constexpr unsigned int TRANSFER_TIMEOUT_MS = 16;
+} // Anonymous namespace
 
 Adapter::Adapter() {
     if (usb_adapter_handle != nullptr) {
@@ -34,22 +39,28 @@ Adapter::~Adapter() {
 
 void Adapter::AdapterInputThread() {
     LOG_DEBUG(Input, "GC Adapter input thread started");
-    s32 payload_size{};
-    AdapterPayload adapter_payload{};
 
     if (adapter_scan_thread.joinable()) {
         adapter_scan_thread.join();
     }
 
+    if (!SubmitTransfers()) {
+        adapter_input_thread_running = false;
+        restart_scan_thread = true;
+    }
+    // Completions run on this thread, as soon as the adapter sends a report. The timeout only
+    // bounds how long a stop request goes unnoticed.
     while (adapter_input_thread_running) {
-        libusb_interrupt_transfer(usb_adapter_handle, input_endpoint, adapter_payload.data(),
-                                  static_cast<s32>(adapter_payload.size()), &payload_size, 16);
-        if (IsPayloadCorrect(adapter_payload, payload_size)) {
-            UpdateControllers(adapter_payload);
-            UpdateVibrations();
+        timeval timeout{.tv_sec = 0, .tv_usec = 100'000};
+        const int error = libusb_handle_events_timeout_completed(libusb_ctx, &timeout, nullptr);
+        if (error != LIBUSB_SUCCESS && error != LIBUSB_ERROR_INTERRUPTED) {
+            LOG_ERROR(Input, "libusb_handle_events failed with error = {}",
+                      libusb_error_name(error));
+            adapter_input_thread_running = false;
+            restart_scan_thread = true;
         }
-        std::this_thread::yield();
     }
+    CancelTransfers();
 
     if (restart_scan_thread) {
         adapter_scan_thread = std::thread(&Adapter::AdapterScanThread, this);
@@ -57,6 +68,121 @@ void Adapter::AdapterInputThread() {
     }
 }
 
+bool Adapter::SubmitTransfers() {
+    pending_transfers = 0;
+    output_transfer_pending = false;
+    for (std::size_t i = 0; i < NUM_INPUT_TRANSFERS; ++i) {
+        libusb_transfer* const transfer = libusb_alloc_transfer(0);
+        input_transfers[i] = transfer;
+        if (transfer == nullptr) {
+            LOG_ERROR(Input, "libusb_alloc_transfer failed");
+            continue;
+        }
+        libusb_fill_interrupt_transfer(transfer, usb_adapter_handle, input_endpoint,
+                                       input_payloads[i].data(),
+                                       static_cast<int>(input_payloads[i].size()),
+                                       &Adapter::InputTransferCallback, this, TRANSFER_TIMEOUT_MS);
+        const int error = libusb_submit_transfer(transfer);
+        if (error != LIBUSB_SUCCESS) {
+            LOG_ERROR(Input, "libusb_submit_transfer failed with error = {}",
+                      libusb_error_name(error));
+            continue;
+        }
+        ++pending_transfers;
+    }
+    output_transfer = libusb_alloc_transfer(0);
+    return pending_transfers != 0;
+}
+
+void Adapter::CancelTransfers() {
+    for (libusb_transfer* const transfer : input_transfers) {
+        if (transfer != nullptr) {
+            libusb_cancel_transfer(transfer);
+        }
+    }
+    if (output_transfer_pending) {
+        libusb_cancel_transfer(output_transfer);
+    }
+    // Cancelled transfers still complete through their callback, only then can they be freed
+    while (pending_transfers != 0) {
+        timeval timeout{.tv_sec = 0, .tv_usec = 100'000};
+        const int error = libusb_handle_events_timeout_completed(libusb_ctx, &timeout, nullptr);
+        if (error != LIBUSB_SUCCESS && error != LIBUSB_ERROR_INTERRUPTED) {
+            LOG_ERROR(Input, "Failed to wait for cancelled transfers, error = {}",
+                      libusb_error_name(error));
+            break;
+        }
+    }
+    for (libusb_transfer*& transfer : input_transfers) {
+        libusb_free_transfer(transfer);
+        transfer = nullptr;
+    }
+    libusb_free_transfer(output_transfer);
+    output_transfer = nullptr;
+}
+
+void Adapter::InputTransferCallback(libusb_transfer* transfer) {
+    static_cast<Adapter*>(transfer->user_data)->OnInputTransfer(transfer);
+}
+
+void Adapter::OutputTransferCallback(libusb_transfer* transfer) {
+    static_cast<Adapter*>(transfer->user_data)->OnOutputTransfer(transfer);
+}
+
+void Adapter::OnInputTransfer(libusb_transfer* transfer) {
+    --pending_transfers;
+    if (!adapter_input_thread_running || transfer->status == LIBUSB_TRANSFER_CANCELLED) {
+        return;
+    }
+    if (transfer->status == LIBUSB_TRANSFER_NO_DEVICE) {
+        LOG_ERROR(Input, "GC adapter was disconnected");
+        adapter_input_thread_running = false;
+        restart_scan_thread = true;
+        return;
+    }
+
+    AdapterPayload adapter_payload{};
+    const s32 payload_size =
+        transfer->status == LIBUSB_TRANSFER_COMPLETED ? transfer->actual_length : 0;
+    std::memcpy(adapter_payload.data(), transfer->buffer,
+                std::min<std::size_t>(adapter_payload.size(), payload_size));
+    if (IsPayloadCorrect(adapter_payload, payload_size)) {
+        UpdateControllers(adapter_payload);
+        UpdateVibrations();
+    }
+    if (!adapter_input_thread_running) {
+        return;
+    }
+    const int error = libusb_submit_transfer(transfer);
+    if (error != LIBUSB_SUCCESS) {
+        LOG_ERROR(Input, "libusb_submit_transfer failed with error = {}", libusb_error_name(error));
+        adapter_input_thread_running = false;
+        restart_scan_thread = true;
+        return;
+    }
+    ++pending_transfers;
+}
+
+void Adapter::OnOutputTransfer(libusb_transfer* transfer) {
+    --pending_transfers;
+    output_transfer_pending = false;
+    if (transfer->status == LIBUSB_TRANSFER_CANCELLED) {
+        return;
+    }
+    if (transfer->status != LIBUSB_TRANSFER_COMPLETED) {
+        LOG_DEBUG(Input, "Adapter libusb write failed with status {}",
+                  static_cast<int>(transfer->status));
+        if (output_error_counter++ > 5) {
+            LOG_ERROR(Input, "GC adapter output timeout, Rumble disabled");
+            rumble_enabled = false;
+        }
+        // Sent again with the next report
+        vibration_changed = true;
+        return;
+    }
+    output_error_counter = 0;
+}
+
 bool Adapter::IsPayloadCorrect(const AdapterPayload& adapter_payload, s32 payload_size) {
     if (payload_size != static_cast<s32>(adapter_payload.size()) ||
         adapter_payload[0] != LIBUSB_DT_HID) {
@@ -79,7 +205,7 @@ void Adapter::UpdateControllers(const AdapterPayload& adapter_payload) {
         const std::size_t offset = 1 + (9 * port);
         const auto type = static_cast<ControllerTypes>(adapter_payload[offset] >> 4);
         UpdatePadType(port, type);
-        if (DeviceConnected(port)) {
+        if (pads[port].type != ControllerTypes::None) {
             const u8 b1 = adapter_payload[offset + 1];
             const u8 b2 = adapter_payload[offset + 2];
             UpdateStateButtons(port, b1, b2);
@@ -88,7 +214,19 @@ void Adapter::UpdateControllers(const AdapterPayload& adapter_payload) {
                 UpdateYuzuSettings(port);
             }
         }
+        PublishPad(port);
+    }
+}
+
+void Adapter::PublishPad(std::size_t port) {
+    const GCController& pad = pads[port];
+    PublishedPad& published = published_pads[port];
+    published.buttons.store(pad.buttons, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < pad.axis_values.size(); ++i) {
+        published.axis_values[i].store(pad.axis_values[i], std::memory_order_relaxed);
     }
+    // Readers check the type first, the values of a newly connected controller come with it
+    published.type.store(pad.type, std::memory_order_release);
 }
 
 void Adapter::UpdatePadType(std::size_t port, ControllerTypes pad_type) {
@@ -194,8 +332,11 @@ void Adapter::UpdateVibrations() {
 
     vibration_counter = (vibration_counter + 1) % vibration_states;
 
-    for (GCController& pad : pads) {
-        const bool vibrate = pad.rumble_amplitude > vibration_counter;
+    for (std::size_t port = 0; port < pads.size(); ++port) {
+        GCController& pad = pads[port];
+        const u8 amplitude =
+            published_pads[port].rumble_amplitude.load(std::memory_order_relaxed);
+        const bool vibrate = amplitude > vibration_counter;
         vibration_changed |= vibrate != pad.enable_vibration;
         pad.enable_vibration = vibrate;
     }
@@ -203,18 +344,20 @@ void Adapter::UpdateVibrations() {
 }
 
 void Adapter::SendVibrations() {
-    if (!rumble_enabled || !vibration_changed) {
+    if (!rumble_enabled || !vibration_changed || output_transfer_pending ||
+        output_transfer == nullptr) {
         return;
     }
-    s32 size{};
     constexpr u8 rumble_command = 0x11;
     const u8 p1 = pads[0].enable_vibration;
     const u8 p2 = pads[1].enable_vibration;
     const u8 p3 = pads[2].enable_vibration;
     const u8 p4 = pads[3].enable_vibration;
-    std::array<u8, 5> payload = {rumble_command, p1, p2, p3, p4};
-    const int err = libusb_interrupt_transfer(usb_adapter_handle, output_endpoint, payload.data(),
-                                              static_cast<s32>(payload.size()), &size, 16);
+    output_payload = {rumble_command, p1, p2, p3, p4};
+    libusb_fill_interrupt_transfer(output_transfer, usb_adapter_handle, output_endpoint,
+                                   output_payload.data(), static_cast<int>(output_payload.size()),
+                                   &Adapter::OutputTransferCallback, this, TRANSFER_TIMEOUT_MS);
+    const int err = libusb_submit_transfer(output_transfer);
     if (err) {
         LOG_DEBUG(Input, "Adapter libusb write failed: {}", libusb_error_name(err));
         if (output_error_counter++ > 5) {
@@ -223,12 +366,13 @@ void Adapter::SendVibrations() {
         }
         return;
     }
-    output_error_counter = 0;
+    ++pending_transfers;
+    output_transfer_pending = true;
     vibration_changed = false;
 }
 
 bool Adapter::RumblePlay(std::size_t port, u8 amplitude) {
-    pads[port].rumble_amplitude = amplitude;
+    published_pads[port].rumble_amplitude.store(amplitude, std::memory_order_relaxed);
 
     return rumble_enabled;
 }
@@ -368,11 +512,12 @@ void Adapter::ResetDevices() {
 void Adapter::ResetDevice(std::size_t port) {
     pads[port].type = ControllerTypes::None;
     pads[port].enable_vibration = false;
-    pads[port].rumble_amplitude = 0;
     pads[port].buttons = 0;
     pads[port].last_button = PadButton::Undefined;
     pads[port].axis_values.fill(0);
     pads[port].reset_origin_counter = 0;
+    published_pads[port].rumble_amplitude.store(0, std::memory_order_relaxed);
+    PublishPad(port);
 }
 
 void Adapter::Reset() {
@@ -474,7 +619,7 @@ InputCommon::AnalogMapping Adapter::GetAnalogMappingForDevice(
 }
 
 bool Adapter::DeviceConnected(std::size_t port) const {
-    return pads[port].type != ControllerTypes::None;
+    return published_pads[port].type.load(std::memory_order_acquire) != ControllerTypes::None;
 }
 
 void Adapter::BeginConfiguration() {
@@ -495,12 +640,16 @@ const Common::SPSCQueue<GCPadStatus>& Adapter::GetPadQueue() const {
     return pad_queue;
 }
 
-GCController& Adapter::GetPadState(std::size_t port) {
-    return pads.at(port);
-}
-
-const GCController& Adapter::GetPadState(std::size_t port) const {
-    return pads.at(port);
+GCPadSnapshot Adapter::GetPadState(std::size_t port) const {
+    const PublishedPad& published = published_pads.at(port);
+    GCPadSnapshot snapshot{
+        .type = published.type.load(std::memory_order_acquire),
+        .buttons = published.buttons.load(std::memory_order_relaxed),
+    };
+    for (std::size_t i = 0; i < snapshot.axis_values.size(); ++i) {
+        snapshot.axis_values[i] = published.axis_values[i].load(std::memory_order_relaxed);
+    }
+    return snapshot;
 }
 
 } // namespace GCAdapter
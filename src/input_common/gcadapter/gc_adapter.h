@@ -4,6 +4,8 @@
 
 #pragma once
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <functional>
 #include <mutex>
 #include <thread>
@@ -15,6 +17,7 @@
 struct libusb_context;
 struct libusb_device;
 struct libusb_device_handle;
+struct libusb_transfer;
 
 namespace GCAdapter {
 
@@ -62,10 +65,10 @@ struct GCPadStatus {
     u8 axis_threshold{50};
 };
 
+/// State of a controller, only accessed by the input thread
 struct GCController {
     ControllerTypes type{};
     bool enable_vibration{};
-    u8 rumble_amplitude{};
     u16 buttons{};
     PadButton last_button{};
     std::array<s16, 6> axis_values{};
@@ -73,6 +76,13 @@ struct GCController {
     u8 reset_origin_counter{};
 };
 
+/// Values of a controller published by the input thread, for other threads to read
+struct GCPadSnapshot {
+    ControllerTypes type{};
+    u16 buttons{};
+    std::array<s16, 6> axis_values{};
+};
+
 class Adapter {
 public:
     Adapter();
@@ -88,8 +98,8 @@ public:
     Common::SPSCQueue<GCPadStatus>& GetPadQueue();
     const Common::SPSCQueue<GCPadStatus>& GetPadQueue() const;
 
-    GCController& GetPadState(std::size_t port);
-    const GCController& GetPadState(std::size_t port) const;
+    /// Returns the latest values of a controller, can be called from any thread
+    GCPadSnapshot GetPadState(std::size_t port) const;
 
     /// Returns true if there is a device connected to port
     bool DeviceConnected(std::size_t port) const;
@@ -102,6 +112,21 @@ public:
 private:
     using AdapterPayload = std::array<u8, 37>;
 
+    /// Input transfers kept submitted, so the next report is received while one is processed
+    static constexpr std::size_t NUM_INPUT_TRANSFERS = 2;
+
+    /// Values of GCPadSnapshot, each published atomically without locks
+    struct PublishedPad {
+        std::atomic<ControllerTypes> type{};
+        std::atomic<u16> buttons{};
+        std::array<std::atomic<s16>, 6> axis_values{};
+        /// Written by RumblePlay, read by the input thread
+        std::atomic<u8> rumble_amplitude{};
+    };
+
+    /// Copies the state of a controller to the values read by other threads
+    void PublishPad(std::size_t port);
+
     void UpdatePadType(std::size_t port, ControllerTypes pad_type);
     void UpdateControllers(const AdapterPayload& adapter_payload);
     void UpdateYuzuSettings(std::size_t port);
@@ -109,13 +134,27 @@ private:
     void UpdateStateAxes(std::size_t port, const AdapterPayload& adapter_payload);
     void UpdateVibrations();
 
+    /// Submits the input transfers and handles their completions until the input stops
     void AdapterInputThread();
 
+    /// Allocates and submits the transfers, returns false if no input transfer was submitted
+    bool SubmitTransfers();
+
+    /// Cancels the transfers in flight, waits for their completion and frees them
+    void CancelTransfers();
+
+    static void InputTransferCallback(libusb_transfer* transfer);
+    static void OutputTransferCallback(libusb_transfer* transfer);
+
+    /// Processes a received report and submits the transfer again
+    void OnInputTransfer(libusb_transfer* transfer);
+    void OnOutputTransfer(libusb_transfer* transfer);
+
     void AdapterScanThread();
 
     bool IsPayloadCorrect(const AdapterPayload& adapter_payload, s32 payload_size);
 
-    // Updates vibration state of all controllers
+    // Updates vibration state of all controllers, unless an update is still being sent
     void SendVibrations();
 
     /// For use in initialization, querying devices to find the adapter
@@ -145,8 +184,17 @@ private:
 
     libusb_device_handle* usb_adapter_handle = nullptr;
     std::array<GCController, 4> pads;
+    std::array<PublishedPad, 4> published_pads;
     Common::SPSCQueue<GCPadStatus> pad_queue;
 
+    std::array<libusb_transfer*, NUM_INPUT_TRANSFERS> input_transfers{};
+    std::array<AdapterPayload, NUM_INPUT_TRANSFERS> input_payloads{};
+    libusb_transfer* output_transfer = nullptr;
+    std::array<u8, 5> output_payload{};
+    /// Transfers submitted whose callback didn't run yet
+    std::size_t pending_transfers = 0;
+    bool output_transfer_pending = false;
+
     std::thread adapter_input_thread;
     std::thread adapter_scan_thread;
     bool adapter_input_thread_running;
@@ -161,7 +209,7 @@ private:
     u8 output_error_counter{0};
     int vibration_counter{0};
 
-    bool configuring{false};
+    std::atomic<bool> configuring{false};
     bool rumble_enabled{true};
     bool vibration_changed{true};
 };
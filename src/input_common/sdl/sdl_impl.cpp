@@ -78,13 +78,14 @@ public:
     }
 
     void SetButton(int button, bool value) {
-        std::lock_guard lock{mutex};
-        state.buttons.insert_or_assign(button, value);
+        if (IsValidIndex(button)) {
+            state.buttons[button].store(value, std::memory_order_relaxed);
+        }
     }
 
     void SetMotion(SDL_ControllerSensorEvent event) {
         constexpr float gravity_constant = 9.80665f;
-        std::lock_guard lock{mutex};
+        std::lock_guard lock{motion_mutex};
         u64 time_difference = event.timestamp - last_motion_update;
         last_motion_update = event.timestamp;
         switch (event.sensor) {
@@ -111,18 +112,21 @@ public:
     }
 
     bool GetButton(int button) const {
-        std::lock_guard lock{mutex};
-        return state.buttons.at(button);
+        return IsValidIndex(button) && state.buttons[button].load(std::memory_order_relaxed);
     }
 
     void SetAxis(int axis, Sint16 value) {
-        std::lock_guard lock{mutex};
-        state.axes.insert_or_assign(axis, value);
+        if (IsValidIndex(axis)) {
+            state.axes[axis].store(value, std::memory_order_relaxed);
+        }
     }
 
     float GetAxis(int axis, float range) const {
-        std::lock_guard lock{mutex};
-        return static_cast<float>(state.axes.at(axis)) / (32767.0f * range);
+        if (!IsValidIndex(axis)) {
+            return 0.0f;
+        }
+        const Sint16 value = state.axes[axis].load(std::memory_order_relaxed);
+        return static_cast<float>(value) / (32767.0f * range);
     }
 
     bool RumblePlay(u16 amp_low, u16 amp_high) {
@@ -169,13 +173,16 @@ public:
     }
 
     void SetHat(int hat, Uint8 direction) {
-        std::lock_guard lock{mutex};
-        state.hats.insert_or_assign(hat, direction);
+        if (IsValidIndex(hat)) {
+            state.hats[hat].store(direction, std::memory_order_relaxed);
+        }
     }
 
     bool GetHatDirection(int hat, Uint8 direction) const {
-        std::lock_guard lock{mutex};
-        return (state.hats.at(hat) & direction) != 0;
+        if (!IsValidIndex(hat)) {
+            return false;
+        }
+        return (state.hats[hat].load(std::memory_order_relaxed) & direction) != 0;
     }
     /**
      * The guid of the joystick
@@ -239,16 +246,24 @@ public:
     }
 
 private:
+    /// SDL events index buttons, axes and hats with 8 bits
+    static constexpr std::size_t MAX_INDEX = 256;
+
+    static bool IsValidIndex(int index) {
+        return index >= 0 && static_cast<std::size_t>(index) < MAX_INDEX;
+    }
+
+    // Written by the SDL event watcher and read by the input devices without taking a lock
     struct State {
-        std::unordered_map<int, bool> buttons;
-        std::unordered_map<int, Sint16> axes;
-        std::unordered_map<int, Uint8> hats;
+        std::array<std::atomic<bool>, MAX_INDEX> buttons{};
+        std::array<std::atomic<Sint16>, MAX_INDEX> axes{};
+        std::array<std::atomic<Uint8>, MAX_INDEX> hats{};
     } state;
     std::string guid;
     int port;
     std::unique_ptr<SDL_Joystick, decltype(&SDL_JoystickClose)> sdl_joystick;
     std::unique_ptr<SDL_GameController, decltype(&SDL_GameControllerClose)> sdl_controller;
-    mutable std::mutex mutex;
+    std::mutex motion_mutex;
 
     // Motion is initialized with the PID values
     MotionInput motion{0.3f, 0.005f, 0.0f};
@@ -289,6 +289,7 @@ void Client::OnPadData(Response::PadData data, std::size_t client) {
     {
         std::lock_guard guard(pads[pad_index].status.update_mutex);
         pads[pad_index].status.motion_status = pads[pad_index].motion.GetMotion();
+        pads[pad_index].status.motion_timestamp = now;
 
         for (std::size_t id = 0; id < data.touch.size(); ++id) {
             UpdateTouchInput(data.touch[id], client, id);
@@ -426,6 +427,26 @@ const DeviceStatus& Client::GetPadState(const std::string& host, u16 port, std::
     return pads[(client_number * PADS_PER_CLIENT) + pad].status;
 }
 
+Input::MotionStatus Client::GetMotionStatus(const std::string& host, u16 port,
+                                            std::size_t pad) const {
+    // Matches the longest period MotionInput integrates
+    constexpr f32 max_extrapolation_seconds = 0.1f;
+
+    const DeviceStatus& status = GetPadState(host, port, pad);
+    std::lock_guard guard(status.update_mutex);
+    Input::MotionStatus motion_status = status.motion_status;
+
+    // Servers send packets at their own rate, which beats against the HID sampling rate. Project
+    // the rotation to the sampling instant so it advances evenly between packets.
+    const auto elapsed = std::chrono::steady_clock::now() - status.motion_timestamp;
+    const f32 elapsed_seconds = std::chrono::duration<f32>(elapsed).count();
+    if (elapsed_seconds < max_extrapolation_seconds) {
+        const Common::Vec3f& gyroscope = std::get<1>(motion_status);
+        std::get<2>(motion_status) += gyroscope * elapsed_seconds;
+    }
+    return motion_status;
+}
+
 Input::TouchStatus& Client::GetTouchState() {
     return touch_status;
 }
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -56,8 +57,10 @@ struct UDPPadStatus {
 };
 
 struct DeviceStatus {
-    std::mutex update_mutex;
+    mutable std::mutex update_mutex;
     Input::MotionStatus motion_status;
+    // Time at which motion_status was received
+    std::chrono::steady_clock::time_point motion_timestamp;
     std::tuple<float, float, bool> touch_status;
 
     // calibration data for scaling the device's touch area to 3ds
@@ -93,6 +96,9 @@ public:
     DeviceStatus& GetPadState(const std::string& host, u16 port, std::size_t pad);
     const DeviceStatus& GetPadState(const std::string& host, u16 port, std::size_t pad) const;
 
+    /// Returns the motion status of a pad with its rotation extrapolated to the current time
+    Input::MotionStatus GetMotionStatus(const std::string& host, u16 port, std::size_t pad) const;
+
     Input::TouchStatus& GetTouchState();
     const Input::TouchStatus& GetTouchState() const;
 
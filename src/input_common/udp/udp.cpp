@@ -17,7 +17,7 @@ public:
         : ip(std::move(ip_)), port(port_), pad(pad_), client(client_) {}
 
     Input::MotionStatus GetStatus() const override {
-        return client->GetPadState(ip, port, pad).motion_status;
+        return client->GetMotionStatus(ip, port, pad);
     }
 
 private:
@@ -0,0 +1,69 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "audio_core/algorithm/mix.h"
+#include "common/common_types.h"
+
+namespace {
+s32 Scale(s32 sample, s32 gain) {
+    return static_cast<s32>((static_cast<s64>(sample) * gain + 0x4000) >> 15);
+}
+
+std::vector<s32> RandomSamples(std::mt19937& rng, std::size_t size) {
+    std::uniform_int_distribution<s32> distribution(std::numeric_limits<s32>::min(),
+                                                    std::numeric_limits<s32>::max());
+    std::vector<s32> samples(size);
+    for (s32& sample : samples) {
+        sample = distribution(rng);
+    }
+    return samples;
+}
+} // Anonymous namespace
+
+TEST_CASE("Mix: MixScaled matches scalar rounding", "[audio_core]") {
+    std::mt19937 rng(0x1234);
+    for (const std::size_t size : {0, 1, 3, 4, 7, 8, 15, 160, 240, 241}) {
+        const std::vector<s32> input = RandomSamples(rng, size);
+        std::vector<s32> output = RandomSamples(rng, size);
+        std::vector<s32> expected = output;
+        for (const s32 gain : {0, 1, 0x4000, 0x8000, -0x8000, 0x12345, -0x7654321}) {
+            for (std::size_t i = 0; i < size; ++i) {
+                expected[i] = static_cast<s32>(static_cast<u32>(expected[i]) +
+                                               static_cast<u32>(Scale(input[i], gain)));
+            }
+            AudioCore::MixScaled(output, input, gain, size);
+            REQUIRE(output == expected);
+        }
+    }
+}
+
+TEST_CASE("Mix: ApplyScaledGain matches scalar rounding", "[audio_core]") {
+    std::mt19937 rng(0x5678);
+    for (const std::size_t size : {0, 1, 3, 4, 7, 8, 15, 160, 240, 241}) {
+        const std::vector<s32> input = RandomSamples(rng, size);
+        for (const s32 delta : {0, 1, -7, 205}) {
+            std::vector<s32> expected(size);
+            s32 gain = 0x6000;
+            for (std::size_t i = 0; i < size; ++i) {
+                expected[i] = Scale(input[i], gain);
+                gain += delta;
+            }
+            std::vector<s32> output(size);
+            AudioCore::ApplyScaledGain(output, input, 0x6000, delta, size);
+            REQUIRE(output == expected);
+
+            // Volume ramps are applied in place
+            output = input;
+            AudioCore::ApplyScaledGain(output, output, 0x6000, delta, size);
+            REQUIRE(output == expected);
+        }
+    }
+}
@@ -0,0 +1,74 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "audio_core/renderer_capture.h"
+#include "common/common_types.h"
+
+namespace AudioCore::Capture {
+
+TEST_CASE("RendererCapture[RoundTrip]", "[audio_core]") {
+    AudioCommon::AudioRendererParameter params{};
+    params.sample_rate = 48000;
+    params.sample_count = 240;
+    params.voice_count = 24;
+
+    const std::array<u8, 5> update{1, 2, 3, 4, 5};
+    const std::array<u8, 3> wave{0xAA, 0xBB, 0xCC};
+    const std::array<s16, 4> samples{-1, 0, 1, 2};
+
+    std::vector<u8> data;
+    EncodeHeader(data, params);
+    EncodeRecord(data, RecordType::Update, 0, update);
+    EncodeRecord(data, RecordType::Memory, 0x1000, wave);
+    EncodeFrame(data, samples);
+
+    Reader reader(data);
+    REQUIRE(reader.IsValid());
+    REQUIRE(reader.Params().sample_rate == 48000);
+    REQUIRE(reader.Params().sample_count == 240);
+    REQUIRE(reader.Params().voice_count == 24);
+
+    const auto update_record = reader.Next();
+    REQUIRE(update_record);
+    REQUIRE(update_record->type == RecordType::Update);
+    REQUIRE(std::equal(update.begin(), update.end(), update_record->payload.begin(),
+                       update_record->payload.end()));
+
+    const auto memory_record = reader.Next();
+    REQUIRE(memory_record);
+    REQUIRE(memory_record->type == RecordType::Memory);
+    REQUIRE(memory_record->address == 0x1000);
+    REQUIRE(std::equal(wave.begin(), wave.end(), memory_record->payload.begin(),
+                       memory_record->payload.end()));
+
+    const auto frame_record = reader.Next();
+    REQUIRE(frame_record);
+    REQUIRE(frame_record->type == RecordType::Frame);
+    REQUIRE(frame_record->payload.size() == sizeof(FrameRecord));
+
+    REQUIRE(!reader.Next());
+}
+
+TEST_CASE("RendererCapture[Truncated]", "[audio_core]") {
+    std::vector<u8> data;
+    EncodeHeader(data, {});
+    const std::array<u8, 8> update{};
+    EncodeRecord(data, RecordType::Update, 0, update);
+    data.pop_back();
+
+    Reader reader(data);
+    REQUIRE(reader.IsValid());
+    REQUIRE(!reader.Next());
+
+    data.resize(4);
+    REQUIRE(!Reader(data).IsValid());
+}
+
+} // namespace AudioCore::Capture
@@ -0,0 +1,57 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "common/bounded_threadsafe_queue.h"
+
+namespace Common {
+
+TEST_CASE("BoundedSPSCQueue: Basic Tests", "[common]") {
+    BoundedSPSCQueue<std::vector<int>, 4> queue;
+    REQUIRE(queue.Empty());
+
+    for (int i = 0; i < 4; ++i) {
+        queue.Push(std::vector<int>{i, i + 1});
+    }
+    REQUIRE(queue.Size() == 4U);
+    REQUIRE(!queue.TryPush(std::vector<int>{4}));
+    REQUIRE(queue.Front() == std::vector<int>{0, 1});
+
+    std::vector<int> element;
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(queue.Pop(element));
+        REQUIRE(element == std::vector<int>{i, i + 1});
+    }
+    REQUIRE(queue.Empty());
+    REQUIRE(!queue.Pop(element));
+
+    REQUIRE(queue.TryPush(std::vector<int>{4}));
+    REQUIRE(queue.Size() == 1U);
+}
+
+TEST_CASE("BoundedSPSCQueue: Threaded Test", "[common]") {
+    // A small capacity makes the writer wait on a full queue as well
+    BoundedSPSCQueue<std::size_t, 8> queue;
+    constexpr std::size_t count = 100000;
+
+    std::thread producer{[&queue] {
+        for (std::size_t i = 0; i < count; ++i) {
+            queue.Push(i);
+        }
+    }};
+
+    bool in_order = true;
+    for (std::size_t i = 0; i < count; ++i) {
+        in_order &= queue.PopWait() == i;
+    }
+    producer.join();
+
+    REQUIRE(in_order);
+    REQUIRE(queue.Empty());
+}
+
+} // namespace Common
@@ -0,0 +1,99 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <initializer_list>
+#include <catch2/catch.hpp>
+#include "common/thread_placement.h"
+
+namespace Common {
+namespace {
+/// Describes a group of physical cores, each running num_threads logical processors
+struct CoreGroup {
+    u32 num_cores;
+    u32 num_threads;
+    u32 cache_group;
+    u32 efficiency_class;
+};
+
+/// Builds a topology numbering the SMT siblings next to each other, as Windows does
+CPUTopology MakeTopology(std::initializer_list<CoreGroup> groups) {
+    CPUTopology topology{};
+    u32 cache_groups = 0;
+    for (const CoreGroup& group : groups) {
+        for (u32 core = 0; core < group.num_cores; ++core) {
+            for (u32 thread = 0; thread < group.num_threads; ++thread) {
+                topology.processors.push_back(LogicalProcessor{
+                    .id = static_cast<u32>(topology.processors.size()),
+                    .physical_core = topology.num_physical_cores,
+                    .cache_group = group.cache_group,
+                    .efficiency_class = group.efficiency_class,
+                });
+            }
+            ++topology.num_physical_cores;
+        }
+        cache_groups = std::max(cache_groups, group.cache_group + 1);
+    }
+    topology.num_cache_groups = cache_groups;
+    return topology;
+}
+
+/// Returns the mask of num_processors processors starting at first
+constexpr u64 Processors(u32 first, u32 num_processors) {
+    return ((u64{1} << num_processors) - 1) << first;
+}
+} // Anonymous namespace
+
+TEST_CASE("ThreadPlacement: Critical threads get a physical core each", "[common]") {
+    const CPUTopology topology = MakeTopology({{8, 2, 0, 0}});
+    const ThreadPlacement placement = MakeThreadPlacement(topology, NUM_PLACED_CPU_CORES);
+    for (u32 core = 0; core < NUM_PLACED_CPU_CORES; ++core) {
+        REQUIRE(placement.GetMask(CpuCoreThread(core)) == Processors(core * 2, 2));
+    }
+    REQUIRE(placement.GetMask(PlacedThread::Gpu) == Processors(8, 2));
+    REQUIRE(placement.GetMask(PlacedThread::GpuSubmission) == Processors(10, 2));
+    REQUIRE(placement.GetMask(PlacedThread::CoreTiming) == Processors(12, 4));
+    REQUIRE(placement.GetMask(PlacedThread::Service) == Processors(12, 4));
+    REQUIRE(placement.GetMask(PlacedThread::ShaderCompile) == Processors(12, 4));
+}
+
+TEST_CASE("ThreadPlacement: Hybrid hosts", "[common]") {
+    // Efficiency cores listed first, the critical threads must still land on performance cores
+    const CPUTopology topology = MakeTopology({{8, 1, 0, 0}, {8, 2, 0, 1}});
+    const ThreadPlacement placement = MakeThreadPlacement(topology, NUM_PLACED_CPU_CORES);
+    for (u32 core = 0; core < NUM_PLACED_CPU_CORES; ++core) {
+        REQUIRE(placement.GetMask(CpuCoreThread(core)) == Processors(8 + core * 2, 2));
+    }
+    REQUIRE(placement.GetMask(PlacedThread::Gpu) == Processors(16, 2));
+    REQUIRE(placement.GetMask(PlacedThread::GpuSubmission) == Processors(18, 2));
+    REQUIRE(placement.GetMask(PlacedThread::Service) == (Processors(0, 8) | Processors(20, 4)));
+    REQUIRE(placement.GetMask(PlacedThread::ShaderCompile) == Processors(0, 8));
+}
+
+TEST_CASE("ThreadPlacement: Critical threads share a cache group", "[common]") {
+    const CPUTopology topology = MakeTopology({{4, 1, 0, 0}, {6, 1, 1, 0}});
+    const ThreadPlacement placement = MakeThreadPlacement(topology, NUM_PLACED_CPU_CORES);
+    for (u32 core = 0; core < NUM_PLACED_CPU_CORES; ++core) {
+        REQUIRE(placement.GetMask(CpuCoreThread(core)) == Processors(4 + core, 1));
+    }
+    REQUIRE(placement.GetMask(PlacedThread::Gpu) == Processors(8, 1));
+    REQUIRE(placement.GetMask(PlacedThread::GpuSubmission) == Processors(9, 1));
+    REQUIRE(placement.GetMask(PlacedThread::Service) == Processors(0, 4));
+}
+
+TEST_CASE("ThreadPlacement: Small hosts", "[common]") {
+    const CPUTopology topology = MakeTopology({{4, 2, 0, 0}});
+    const ThreadPlacement multicore = MakeThreadPlacement(topology, NUM_PLACED_CPU_CORES);
+    for (const u64 mask : multicore.masks) {
+        REQUIRE(mask == 0);
+    }
+    const ThreadPlacement single_core = MakeThreadPlacement(topology, 1);
+    REQUIRE(single_core.GetMask(PlacedThread::CpuCore0) == Processors(0, 2));
+    REQUIRE(single_core.GetMask(PlacedThread::CpuCore1) == 0);
+    REQUIRE(single_core.GetMask(PlacedThread::Gpu) == Processors(2, 2));
+    REQUIRE(single_core.GetMask(PlacedThread::GpuSubmission) == Processors(4, 2));
+    REQUIRE(single_core.GetMask(PlacedThread::Service) == Processors(6, 2));
+}
+
+} // namespace Common
@@ -0,0 +1,70 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <cstddef>
+#include <stop_token>
+#include <catch2/catch.hpp>
+#include "common/thread_pool.h"
+
+namespace Common {
+
+TEST_CASE("ThreadPool: Runs every task", "[common]") {
+    ThreadPool pool(4, 1);
+    std::atomic_size_t count{0};
+    TaskGroup group;
+    constexpr std::size_t num_tasks = 1000;
+    for (std::size_t i = 0; i < num_tasks; ++i) {
+        const auto priority =
+            i % 2 == 0 ? TaskPriority::LatencyCritical : TaskPriority::BackgroundCompile;
+        pool.Submit(
+            priority, [&count](std::stop_token) { ++count; }, {}, &group);
+    }
+    for (std::size_t i = 0; i < 10; ++i) {
+        pool.Submit(
+            TaskPriority::IO, [&count](std::stop_token) { ++count; }, {}, &group);
+    }
+    group.Wait();
+    REQUIRE(count == num_tasks + 10);
+}
+
+TEST_CASE("ThreadPool: Tasks queued from workers", "[common]") {
+    ThreadPool pool(2, 1);
+    std::atomic_size_t count{0};
+    TaskGroup group;
+    for (std::size_t i = 0; i < 16; ++i) {
+        pool.Submit(
+            TaskPriority::BackgroundCompile,
+            [&](std::stop_token) {
+                for (std::size_t j = 0; j < 16; ++j) {
+                    pool.Submit(
+                        TaskPriority::LatencyCritical, [&count](std::stop_token) { ++count; }, {},
+                        &group);
+                }
+            },
+            {}, &group);
+    }
+    group.Wait();
+    REQUIRE(count == 16 * 16);
+}
+
+TEST_CASE("ThreadPool: Cancelled tasks are dropped", "[common]") {
+    ThreadPool pool(1, 1);
+    std::atomic_size_t count{0};
+    std::stop_source stop_source;
+    stop_source.request_stop();
+    TaskGroup group;
+    pool.Submit(
+        TaskPriority::BackgroundCompile, [&count](std::stop_token) { ++count; },
+        stop_source.get_token(), &group);
+    pool.Submit(
+        TaskPriority::IO, [&count](std::stop_token) { ++count; }, stop_source.get_token(),
+        &group);
+    pool.Submit(
+        TaskPriority::LatencyCritical, [&count](std::stop_token) { ++count; }, {}, &group);
+    group.Wait();
+    REQUIRE(count == 1);
+}
+
+} // namespace Common
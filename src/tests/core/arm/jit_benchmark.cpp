@@ -0,0 +1,273 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/host_memory.h"
+#include "common/page_table.h"
+#include "common/settings.h"
+#include "core/arm/cpu_interrupt_handler.h"
+#include "core/arm/dynarmic/arm_dynarmic_32.h"
+#include "core/arm/dynarmic/arm_dynarmic_64.h"
+#include "core/arm/exclusive_monitor.h"
+#include "core/core.h"
+#include "core/hardware_properties.h"
+#include "core/memory.h"
+
+namespace {
+constexpr VAddr CODE_ADDRESS = 0x10000000;
+constexpr VAddr DATA_ADDRESS = CODE_ADDRESS + 0x10000;
+constexpr VAddr PAGE_CROSSING_ADDRESS = DATA_ADDRESS + 0x3000;
+constexpr std::size_t REGION_SIZE = 0x20000;
+constexpr std::size_t PAGE_BITS = 12;
+constexpr auto RUN_TIME = std::chrono::milliseconds{250};
+
+/// Endless loop counting its iterations in register 0. Register 1 holds a data address, register
+/// 2 a second data address, and register 6 an offset into them.
+struct Workload {
+    std::string_view name;
+    std::vector<u32> code;
+    VAddr data_address;
+};
+
+const std::array WORKLOADS_64{
+    Workload{
+        .name = "memcpy",
+        .code =
+            {
+                0x3ce66820, // ldr q0, [x1, x6]
+                0x3ca66840, // str q0, [x2, x6]
+                0x910040c6, // add x6, x6, #16
+                0x92402cc6, // and x6, x6, #0xfff
+                0x91000400, // add x0, x0, #1
+                0x17fffffb, // b loop
+            },
+        .data_address = DATA_ADDRESS,
+    },
+    Workload{
+        .name = "float math",
+        .code =
+            {
+                0x1f420020, // fmadd d0, d1, d2, d0
+                0x1e640863, // fmul d3, d3, d4
+                0x1e6128a5, // fadd d5, d5, d1
+                0x1e61c046, // fsqrt d6, d2
+                0x91000400, // add x0, x0, #1
+                0x17fffffb, // b loop
+            },
+        .data_address = DATA_ADDRESS,
+    },
+    Workload{
+        .name = "exclusive",
+        .code =
+            {
+                0xc85ffc24, // ldaxr x4, [x1]
+                0x91000484, // add x4, x4, #1
+                0xc805fc24, // stlxr w5, x4, [x1]
+                0x91000400, // add x0, x0, #1
+                0x17fffffc, // b loop
+            },
+        .data_address = DATA_ADDRESS,
+    },
+    Workload{
+        .name = "page crossing",
+        .code =
+            {
+                0xf9400024, // ldr x4, [x1]
+                0xf9000024, // str x4, [x1]
+                0x91000400, // add x0, x0, #1
+                0x17fffffd, // b loop
+            },
+        .data_address = PAGE_CROSSING_ADDRESS - 4,
+    },
+};
+
+const std::array WORKLOADS_32{
+    Workload{
+        .name = "memcpy",
+        .code =
+            {
+                0xe18140d6, // ldrd r4, r5, [r1, r6]
+                0xe18240f6, // strd r4, r5, [r2, r6]
+                0xe2866008, // add r6, r6, #8
+                0xe7eb6056, // ubfx r6, r6, #0, #12
+                0xe2800001, // add r0, r0, #1
+                0xeafffff9, // b loop
+            },
+        .data_address = DATA_ADDRESS,
+    },
+    Workload{
+        .name = "float math",
+        .code =
+            {
+                0xee010b02, // vmla.f64 d0, d1, d2
+                0xee233b04, // vmul.f64 d3, d3, d4
+                0xee355b01, // vadd.f64 d5, d5, d1
+                0xeeb16bc2, // vsqrt.f64 d6, d2
+                0xe2800001, // add r0, r0, #1
+                0xeafffff9, // b loop
+            },
+        .data_address = DATA_ADDRESS,
+    },
+    Workload{
+        .name = "exclusive",
+        .code =
+            {
+                0xe1914f9f, // ldrex r4, [r1]
+                0xe2844001, // add r4, r4, #1
+                0xe1815f94, // strex r5, r4, [r1]
+                0xe2800001, // add r0, r0, #1
+                0xeafffffa, // b loop
+            },
+        .data_address = DATA_ADDRESS,
+    },
+    Workload{
+        .name = "page crossing",
+        .code =
+            {
+                0xe5914000, // ldr r4, [r1]
+                0xe5814000, // str r4, [r1]
+                0xe2800001, // add r0, r0, #1
+                0xeafffffb, // b loop
+            },
+        .data_address = PAGE_CROSSING_ADDRESS - 2,
+    },
+};
+
+/// Guest memory backed by host memory, mapped directly into a page table without a process
+class GuestMemory {
+public:
+    explicit GuestMemory(std::size_t address_space_bits, bool fastmem)
+        : host_memory(REGION_SIZE, std::size_t{1} << address_space_bits) {
+        host_memory.Map(CODE_ADDRESS, 0, REGION_SIZE);
+
+        page_table.Resize(address_space_bits, PAGE_BITS);
+        page_table.fastmem_arena = fastmem ? host_memory.VirtualBasePointer() : nullptr;
+        u8* const pointer = host_memory.BackingBasePointer() - CODE_ADDRESS;
+        for (VAddr page = CODE_ADDRESS >> PAGE_BITS;
+             page < (CODE_ADDRESS + REGION_SIZE) >> PAGE_BITS; ++page) {
+            page_table.pointers[page].Store(pointer, Common::PageType::Memory);
+        }
+    }
+
+    void Load(const Workload& workload) {
+        std::memset(host_memory.BackingBasePointer(), 0, REGION_SIZE);
+        std::memcpy(host_memory.BackingBasePointer(), workload.code.data(),
+                    workload.code.size() * sizeof(u32));
+    }
+
+    Common::PageTable& PageTable() {
+        return page_table;
+    }
+
+private:
+    Common::HostMemory host_memory;
+    Common::PageTable page_table;
+};
+
+/// Runs a workload for RUN_TIME and returns the guest instructions executed per second
+double Measure(Core::ARM_Interface& cpu, Core::CPUInterruptHandler& interrupt,
+               const Workload& workload) {
+    cpu.SetPC(CODE_ADDRESS);
+    cpu.SetReg(0, 0);
+    cpu.SetReg(1, workload.data_address);
+    cpu.SetReg(2, DATA_ADDRESS + 0x1000);
+    cpu.SetReg(6, 0);
+
+    std::thread timer([&interrupt] {
+        std::this_thread::sleep_for(RUN_TIME);
+        interrupt.SetInterrupt(true);
+    });
+    const auto start = std::chrono::steady_clock::now();
+    while (!interrupt.IsInterrupted()) {
+        cpu.Run();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    timer.join();
+    interrupt.SetInterrupt(false);
+
+    const u64 iterations = cpu.GetReg(0);
+    return static_cast<double>(iterations * workload.code.size()) / elapsed.count();
+}
+
+struct Configuration {
+    std::string_view name;
+    bool fastmem;
+    /// Optimization disabled in this configuration, if any
+    Settings::BasicSetting<bool>* disabled_optimization;
+};
+
+void RunConfiguration(const Configuration& configuration) {
+    auto& values = Settings::values;
+    values.cpu_debug_mode = configuration.disabled_optimization != nullptr;
+    if (configuration.disabled_optimization) {
+        *configuration.disabled_optimization = false;
+    }
+
+    Core::System& system = Core::System::GetInstance();
+    Core::CPUInterrupts interrupts;
+    const auto exclusive_monitor =
+        Core::MakeExclusiveMonitor(system.Memory(), Core::Hardware::NUM_CPU_CORES);
+
+    const auto run_workloads = [&](Core::ARM_Interface& cpu, std::size_t address_space_bits,
+                                 std::span<const Workload> workloads, std::string_view isa) {
+        GuestMemory memory(address_space_bits, configuration.fastmem);
+        system.Memory().SetCurrentPageTable(memory.PageTable());
+        cpu.PageTableChanged(memory.PageTable(), address_space_bits);
+        for (const Workload& workload : workloads) {
+            memory.Load(workload);
+            cpu.ClearInstructionCache();
+            const double ips = Measure(cpu, interrupts[0], workload);
+            fmt::print("{:<8} {:<28} {:<14} {:>10.1f} MIPS\n", isa, configuration.name,
+                       workload.name, ips / 1'000'000.0);
+        }
+    };
+    {
+        Core::ARM_Dynarmic_64 cpu(system, interrupts, true, *exclusive_monitor, 0);
+        run_workloads(cpu, 39, WORKLOADS_64, "AArch64");
+    }
+    {
+        Core::ARM_Dynarmic_32 cpu(system, interrupts, true, *exclusive_monitor, 0);
+        cpu.SetPSTATE(0x10);
+        run_workloads(cpu, 32, WORKLOADS_32, "AArch32");
+    }
+
+    values.cpu_debug_mode = false;
+    if (configuration.disabled_optimization) {
+        *configuration.disabled_optimization = true;
+    }
+}
+} // Anonymous namespace
+
+// Hidden from the default test run, select it with the [benchmark] tag
+TEST_CASE("ARM_Dynarmic[Benchmark]", "[.][benchmark]") {
+    auto& values = Settings::values;
+    const std::array configurations{
+        Configuration{"default", true, nullptr},
+        Configuration{"default, no fastmem", false, nullptr},
+        Configuration{"no page tables", false, &values.cpuopt_page_tables},
+        Configuration{"no block linking", true, &values.cpuopt_block_linking},
+        Configuration{"no return stack buffer", true, &values.cpuopt_return_stack_buffer},
+        Configuration{"no fast dispatcher", true, &values.cpuopt_fast_dispatcher},
+        Configuration{"no context elimination", true, &values.cpuopt_context_elimination},
+        Configuration{"no const prop", true, &values.cpuopt_const_prop},
+        Configuration{"no misc IR", true, &values.cpuopt_misc_ir},
+        Configuration{"no reduced misalign checks", true, &values.cpuopt_reduce_misalign_checks},
+        Configuration{"no fastmem option", true, &values.cpuopt_fastmem},
+    };
+    for (const Configuration& configuration : configurations) {
+        RunConfiguration(configuration);
+    }
+}
@@ -0,0 +1,464 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/fs/fs.h"
+#include "common/fs/fs_util.h"
+#include "common/settings.h"
+#include "core/crypto/aes_util.h"
+#include "core/crypto/ctr_encryption_layer.h"
+#include "core/crypto/key_manager.h"
+#include "core/crypto/xts_encryption_layer.h"
+#include "core/file_sys/mode.h"
+#include "core/file_sys/nca_patch.h"
+#include "core/file_sys/romfs.h"
+#include "core/file_sys/vfs_concat.h"
+#include "core/file_sys/vfs_offset.h"
+#include "core/file_sys/vfs_real.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace {
+using Core::Crypto::AESCipher;
+using Core::Crypto::Key128;
+using Core::Crypto::Key256;
+using FileSys::VirtualDir;
+using FileSys::VirtualFile;
+
+constexpr auto RUN_TIME = std::chrono::milliseconds{250};
+/// Offset of the section within the synthetic NCA, the space before stands in for the header
+constexpr std::size_t SECTION_OFFSET = 0x4000;
+constexpr std::size_t XTS_SECTOR_SIZE = 0x4000;
+/// Size of the BKTR subsections, each is encrypted with its own counter
+constexpr std::size_t SUBSECTION_SIZE = 0x8000;
+constexpr std::array<std::size_t, 5> READ_SIZES{0x20, 0x200, 0x4000, 0x40000, 0x400000};
+
+constexpr Key128 CTR_KEY{0x10, 0x21, 0x32, 0x43, 0x54, 0x65, 0x76, 0x87,
+                         0x98, 0xa9, 0xba, 0xcb, 0xdc, 0xed, 0xfe, 0x0f};
+constexpr Key256 XTS_KEY{0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa,
+                         0xbb, 0xcc, 0xdd, 0xee, 0xff, 0xf0, 0xe1, 0xd2, 0xc3, 0xb4, 0xa5,
+                         0x96, 0x87, 0x78, 0x69, 0x5a, 0x4b, 0x3c, 0x2d, 0x1e, 0x0f};
+
+std::vector<u8> RandomBytes(std::size_t size, u32 seed) {
+    std::mt19937 generator{seed};
+    std::uniform_int_distribution<u32> distribution{0, 0xff};
+    std::vector<u8> bytes(size);
+    for (u8& byte : bytes) {
+        byte = static_cast<u8>(distribution(generator));
+    }
+    return bytes;
+}
+
+/// Counter of a CTR block, the block index in the low half as NCA sections lay it out
+std::array<u8, 0x10> MakeCounter(u64 offset, u32 ctr) {
+    std::array<u8, 0x10> iv{};
+    u64 block = offset >> 4;
+    for (std::size_t i = 0; i < sizeof(u64); ++i) {
+        iv[0xF - i] = static_cast<u8>(block & 0xFF);
+        block >>= 8;
+    }
+    for (std::size_t i = 0; i < sizeof(u32); ++i) {
+        iv[0x7 - i] = static_cast<u8>(ctr & 0xFF);
+        ctr >>= 8;
+    }
+    return iv;
+}
+
+std::vector<u8> EncryptCtr(std::span<const u8> plain, u64 offset, u32 ctr = 0) {
+    AESCipher<Key128> cipher{CTR_KEY, Core::Crypto::Mode::CTR};
+    cipher.SetIV(MakeCounter(offset, ctr));
+    std::vector<u8> encrypted(plain.size());
+    cipher.Transcode(plain.data(), plain.size(), encrypted.data(), Core::Crypto::Op::Encrypt);
+    return encrypted;
+}
+
+std::vector<u8> EncryptXts(std::span<const u8> plain) {
+    AESCipher<Key256> cipher{XTS_KEY, Core::Crypto::Mode::XTS};
+    std::vector<u8> encrypted(plain.size());
+    cipher.XTSTranscode(plain.data(), plain.size(), encrypted.data(), 0, XTS_SECTOR_SIZE,
+                        Core::Crypto::Op::Encrypt);
+    return encrypted;
+}
+
+/// Files written to the temporary directory and opened through the real filesystem
+class TemporaryFiles {
+public:
+    explicit TemporaryFiles(std::shared_ptr<FileSys::RealVfsFilesystem> filesystem_)
+        : filesystem{std::move(filesystem_)}, prefix{fmt::format("yuzu-tests-vfs-{:08x}",
+                                                                 std::random_device{}())} {}
+
+    ~TemporaryFiles() {
+        for (const std::filesystem::path& path : paths) {
+            Common::FS::RemoveFile(path);
+        }
+    }
+
+    /// Writes a file and reopens it read-only, images with an .nca extension are memory mapped
+    VirtualFile Write(std::string_view extension, std::span<const u8> contents) {
+        const std::filesystem::path& path = paths.emplace_back(
+            std::filesystem::temp_directory_path() /
+            fmt::format("{}-{}.{}", prefix, paths.size(), extension));
+        const std::string path_string = Common::FS::PathToUTF8String(path);
+        {
+            const VirtualFile file =
+                filesystem->CreateFile(path_string, FileSys::Mode::ReadWrite);
+            REQUIRE(file != nullptr);
+            REQUIRE(file->Write(contents.data(), contents.size(), 0) == contents.size());
+        }
+        VirtualFile file = filesystem->OpenFile(path_string, FileSys::Mode::Read);
+        REQUIRE(file != nullptr);
+        return file;
+    }
+
+private:
+    std::shared_ptr<FileSys::RealVfsFilesystem> filesystem;
+    std::string prefix;
+    std::vector<std::filesystem::path> paths;
+};
+
+/// Builds a CTR layer the way NCA sections are opened, romfs_cache_size decides if it caches
+VirtualFile MakeCtrSection(const VirtualFile& image, std::size_t size, u32 cache_size_mib) {
+    const u32 previous_cache_size = Settings::values.romfs_cache_size.GetValue();
+    Settings::values.romfs_cache_size.SetValue(cache_size_mib);
+    auto section = std::make_shared<FileSys::OffsetVfsFile>(image, size, SECTION_OFFSET);
+    auto layer = std::make_shared<Core::Crypto::CTREncryptionLayer>(std::move(section), CTR_KEY,
+                                                                    SECTION_OFFSET);
+    Settings::values.romfs_cache_size.SetValue(previous_cache_size);
+    return layer;
+}
+
+/// Prepends a header to encrypted section contents, like an NCA with a single section
+std::vector<u8> MakeCtrImage(std::span<const u8> plain, u32 seed) {
+    std::vector<u8> image = RandomBytes(SECTION_OFFSET, seed);
+    const std::vector<u8> encrypted = EncryptCtr(plain, SECTION_OFFSET);
+    image.insert(image.end(), encrypted.begin(), encrypted.end());
+    return image;
+}
+
+struct BktrPatch {
+    VirtualFile file;
+    std::vector<u8> expected;
+};
+
+/**
+ * Builds an encrypted BKTR patch over base. Chunks of random size alternate at random between
+ * relocations into the base and new data in the patch, some are split in two entries that
+ * continue the same range.
+ */
+BktrPatch MakeBktrPatch(TemporaryFiles& files, const VirtualFile& base,
+                        std::span<const u8> base_data, std::size_t size, u32 seed) {
+    std::mt19937 generator{seed};
+    std::uniform_int_distribution<std::size_t> chunk_sizes{0x100, 0x20000};
+    std::bernoulli_distribution coin;
+
+    std::vector<FileSys::RelocationEntry> relocations;
+    std::vector<u8> expected;
+    std::vector<u8> patch_plain;
+    expected.reserve(size);
+    while (expected.size() < size) {
+        const std::size_t chunk_size = std::min(chunk_sizes(generator), size - expected.size());
+        const u64 address_patch = expected.size();
+        const bool from_patch = coin(generator);
+        u64 address_source;
+        if (from_patch) {
+            address_source = patch_plain.size();
+            const std::vector<u8> data =
+                RandomBytes(chunk_size, static_cast<u32>(generator()));
+            patch_plain.insert(patch_plain.end(), data.begin(), data.end());
+            expected.insert(expected.end(), data.begin(), data.end());
+        } else {
+            address_source = std::uniform_int_distribution<std::size_t>{
+                0, base_data.size() - chunk_size}(generator);
+            expected.insert(expected.end(), base_data.begin() + address_source,
+                            base_data.begin() + address_source + chunk_size);
+        }
+        relocations.push_back({address_patch, address_source, from_patch ? 1U : 0U});
+        if (coin(generator) && chunk_size > 1) {
+            const u64 split = chunk_size / 2;
+            relocations.push_back(
+                {address_patch + split, address_source + split, from_patch ? 1U : 0U});
+        }
+    }
+
+    std::vector<FileSys::SubsectionEntry> subsections;
+    std::vector<u8> patch_encrypted;
+    patch_encrypted.reserve(patch_plain.size());
+    for (std::size_t offset = 0; offset < patch_plain.size(); offset += SUBSECTION_SIZE) {
+        const u32 ctr = static_cast<u32>(subsections.size() + 1);
+        const std::size_t length = std::min(SUBSECTION_SIZE, patch_plain.size() - offset);
+        const std::vector<u8> encrypted =
+            EncryptCtr(std::span(patch_plain).subspan(offset, length), offset, ctr);
+        patch_encrypted.insert(patch_encrypted.end(), encrypted.begin(), encrypted.end());
+
+        FileSys::SubsectionEntry& entry = subsections.emplace_back();
+        entry.address_patch = offset;
+        entry.ctr = ctr;
+    }
+    // Marks the end of the table
+    subsections.emplace_back().address_patch = patch_plain.size();
+
+    auto relocation = std::make_unique<FileSys::RelocationBlock>();
+    relocation->number_buckets = 1;
+    relocation->size = size;
+    auto subsection = std::make_unique<FileSys::SubsectionBlock>();
+    subsection->number_buckets = 1;
+    subsection->size = patch_plain.size();
+
+    const u32 num_relocations = static_cast<u32>(relocations.size());
+    const u32 num_subsections = static_cast<u32>(subsections.size());
+    std::vector<FileSys::RelocationBucket> relocation_buckets{
+        {num_relocations, size, std::move(relocations)}};
+    std::vector<FileSys::SubsectionBucket> subsection_buckets{
+        {num_subsections, patch_plain.size(), std::move(subsections)}};
+    return BktrPatch{
+        .file = std::make_shared<FileSys::BKTR>(
+            base, files.Write("nca", patch_encrypted), *relocation, std::move(relocation_buckets),
+            *subsection, std::move(subsection_buckets), true, CTR_KEY, 0, 0,
+            std::array<u8, 8>{}),
+        .expected = std::move(expected),
+    };
+}
+
+/// Splits a file in parts of random size and concatenates them back
+VirtualFile MakeConcatenatedFile(const VirtualFile& file, u32 seed) {
+    std::mt19937 generator{seed};
+    std::uniform_int_distribution<std::size_t> part_sizes{0x100, 0x100000};
+    std::vector<VirtualFile> parts;
+    for (std::size_t offset = 0; offset < file->GetSize();) {
+        const std::size_t size = std::min(part_sizes(generator), file->GetSize() - offset);
+        parts.push_back(std::make_shared<FileSys::OffsetVfsFile>(file, size, offset));
+        offset += size;
+    }
+    return FileSys::ConcatenatedVfsFile::MakeConcatenatedFile(std::move(parts), "concatenated");
+}
+
+struct RomFSFile {
+    std::string path;
+    std::vector<u8> data;
+};
+
+/// Builds a RomFS of files of random size spread over a few directories
+std::vector<u8> MakeRomFS(std::vector<RomFSFile>& files, std::size_t num_files, u32 seed) {
+    std::mt19937 generator{seed};
+    std::uniform_int_distribution<std::size_t> file_sizes{0, 0x40000};
+    std::array<std::shared_ptr<FileSys::VectorVfsDirectory>, 4> directories;
+    std::vector<VirtualDir> subdirectories;
+    for (std::size_t i = 0; i < directories.size(); ++i) {
+        directories[i] = std::make_shared<FileSys::VectorVfsDirectory>(
+            std::vector<VirtualFile>{}, std::vector<VirtualDir>{}, fmt::format("dir{}", i));
+        subdirectories.push_back(directories[i]);
+    }
+    for (std::size_t i = 0; i < num_files; ++i) {
+        const std::size_t directory = i % directories.size();
+        const std::string name = fmt::format("file{}.bin", i);
+        std::vector<u8> data = RandomBytes(file_sizes(generator), static_cast<u32>(generator()));
+        directories[directory]->AddFile(std::make_shared<FileSys::VectorVfsFile>(data, name));
+        files.push_back(RomFSFile{
+            .path = fmt::format("dir{}/{}", directory, name),
+            .data = std::move(data),
+        });
+    }
+    const auto root = std::make_shared<FileSys::VectorVfsDirectory>(
+        std::vector<VirtualFile>{}, std::move(subdirectories), "romfs");
+    const VirtualFile romfs = FileSys::CreateRomFS(root);
+    REQUIRE(romfs != nullptr);
+    return romfs->ReadAllBytes();
+}
+
+/// Every layer of the synthetic NCA stacks, over the same plain contents
+struct LayerStacks {
+    explicit LayerStacks(std::size_t size, u32 seed)
+        : files{std::make_shared<FileSys::RealVfsFilesystem>()}, plain{RandomBytes(size, seed)} {
+        mapped = files.Write("nca", plain);
+        streamed = files.Write("bin", plain);
+        const VirtualFile ctr_image = files.Write("nca", MakeCtrImage(plain, seed + 1));
+        offset = std::make_shared<FileSys::OffsetVfsFile>(
+            files.Write("nca", MakeCtrImage(plain, seed + 2)), size, SECTION_OFFSET);
+        ctr = MakeCtrSection(ctr_image, size, 0);
+        ctr_cached = MakeCtrSection(ctr_image, size, 4);
+        xts = std::make_shared<Core::Crypto::XTSEncryptionLayer>(
+            files.Write("nca", EncryptXts(plain)), XTS_KEY);
+        concatenated = MakeConcatenatedFile(mapped, seed + 3);
+        bktr = MakeBktrPatch(files, ctr_cached, plain, size, seed + 4);
+    }
+
+    TemporaryFiles files;
+    std::vector<u8> plain;
+    VirtualFile mapped;
+    VirtualFile streamed;
+    /// Encrypted contents of the section, not decrypted
+    VirtualFile offset;
+    VirtualFile ctr;
+    VirtualFile ctr_cached;
+    VirtualFile xts;
+    VirtualFile concatenated;
+    BktrPatch bktr;
+};
+
+/// Checks random reads of the file, including ones crossing its end
+void CheckRandomReads(const VirtualFile& file, std::span<const u8> expected, u32 seed) {
+    REQUIRE(file->GetSize() == expected.size());
+    std::mt19937 generator{seed};
+    std::uniform_int_distribution<std::size_t> offsets{0, expected.size() - 1};
+    std::uniform_int_distribution<std::size_t> lengths{1, 0x50000};
+    std::vector<u8> buffer;
+    for (u32 i = 0; i < 300; ++i) {
+        const std::size_t offset = offsets(generator);
+        buffer.resize(lengths(generator));
+        const std::size_t expected_read = std::min(buffer.size(), expected.size() - offset);
+        REQUIRE(file->Read(buffer.data(), buffer.size(), offset) == expected_read);
+        REQUIRE(std::equal(buffer.begin(), buffer.begin() + expected_read,
+                           expected.begin() + offset));
+    }
+    REQUIRE(file->ReadAllBytes() == std::vector<u8>(expected.begin(), expected.end()));
+}
+
+enum class AccessPattern {
+    Sequential,
+    Random,
+};
+
+struct ReadRate {
+    double megabytes_per_second;
+    double reads_per_second;
+};
+
+/// Reads the file until RUN_TIME elapses, sequentially wrapping at its end or at random offsets
+ReadRate MeasureReads(const VirtualFile& file, std::size_t read_size, AccessPattern pattern) {
+    const std::size_t size = file->GetSize();
+    std::vector<std::size_t> offsets;
+    if (pattern == AccessPattern::Sequential) {
+        for (std::size_t offset = 0; offset + read_size <= size; offset += read_size) {
+            offsets.push_back(offset);
+        }
+    } else {
+        std::mt19937 generator{static_cast<u32>(read_size)};
+        std::uniform_int_distribution<std::size_t> distribution{0, size - read_size};
+        offsets.resize(4096);
+        for (std::size_t& offset : offsets) {
+            offset = distribution(generator);
+        }
+    }
+    std::vector<u8> buffer(read_size);
+    u64 reads = 0;
+    const auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed{};
+    do {
+        // Checking the time after each small read would be measured along with it
+        for (u32 i = 0; i < 16; ++i) {
+            file->Read(buffer.data(), read_size, offsets[reads % offsets.size()]);
+            ++reads;
+        }
+        elapsed = std::chrono::steady_clock::now() - start;
+    } while (elapsed < RUN_TIME);
+    const double reads_per_second = static_cast<double>(reads) / elapsed.count();
+    return ReadRate{
+        .megabytes_per_second =
+            reads_per_second * static_cast<double>(read_size) / 1'000'000.0,
+        .reads_per_second = reads_per_second,
+    };
+}
+} // Anonymous namespace
+
+TEST_CASE("VfsLayers[ReadsMatchContents]", "[core][file_sys]") {
+    const LayerStacks stacks{0x400000, 1};
+    SECTION("Real") {
+        CheckRandomReads(stacks.mapped, stacks.plain, 2);
+        CheckRandomReads(stacks.streamed, stacks.plain, 3);
+    }
+    SECTION("Offset") {
+        CheckRandomReads(stacks.offset, EncryptCtr(stacks.plain, SECTION_OFFSET), 4);
+    }
+    SECTION("CTREncryptionLayer") {
+        CheckRandomReads(stacks.ctr, stacks.plain, 5);
+        CheckRandomReads(stacks.ctr_cached, stacks.plain, 6);
+    }
+    SECTION("XTSEncryptionLayer") {
+        CheckRandomReads(stacks.xts, stacks.plain, 7);
+    }
+    SECTION("ConcatenatedVfsFile") {
+        CheckRandomReads(stacks.concatenated, stacks.plain, 8);
+    }
+    SECTION("BKTR") {
+        CheckRandomReads(stacks.bktr.file, stacks.bktr.expected, 9);
+    }
+}
+
+TEST_CASE("VfsLayers[RomFS]", "[core][file_sys]") {
+    TemporaryFiles files{std::make_shared<FileSys::RealVfsFilesystem>()};
+    std::vector<RomFSFile> romfs_files;
+    const std::vector<u8> romfs = MakeRomFS(romfs_files, 64, 10);
+    const VirtualFile image = files.Write("nca", MakeCtrImage(romfs, 11));
+    const VirtualDir root = FileSys::ExtractRomFS(MakeCtrSection(image, romfs.size(), 4));
+    REQUIRE(root != nullptr);
+    for (const RomFSFile& file : romfs_files) {
+        const VirtualFile extracted = root->GetFileRelative(file.path);
+        REQUIRE(extracted != nullptr);
+        REQUIRE(extracted->ReadAllBytes() == file.data);
+    }
+}
+
+TEST_CASE("VfsLayers[Benchmark]", "[.][benchmark]") {
+    const LayerStacks stacks{0x2000000, 12};
+    struct Stack {
+        std::string_view name;
+        VirtualFile file;
+    };
+    const std::array benchmarked_stacks{
+        Stack{"RealVfsFile mapped", stacks.mapped},
+        Stack{"RealVfsFile streamed", stacks.streamed},
+        Stack{"OffsetVfsFile", stacks.offset},
+        Stack{"CTR uncached", stacks.ctr},
+        Stack{"CTR cached", stacks.ctr_cached},
+        Stack{"XTS", stacks.xts},
+        Stack{"ConcatenatedVfsFile", stacks.concatenated},
+        Stack{"BKTR", stacks.bktr.file},
+    };
+    for (const Stack& stack : benchmarked_stacks) {
+        for (const std::size_t read_size : READ_SIZES) {
+            for (const AccessPattern pattern : {AccessPattern::Sequential, AccessPattern::Random}) {
+                const ReadRate rate = MeasureReads(stack.file, read_size, pattern);
+                fmt::print("{:<24} {:>7} B {:<10}: {:>9.1f} MB/s, {:>11.0f} reads/s\n",
+                           stack.name, read_size,
+                           pattern == AccessPattern::Sequential ? "sequential" : "random",
+                           rate.megabytes_per_second, rate.reads_per_second);
+            }
+        }
+    }
+
+    TemporaryFiles files{std::make_shared<FileSys::RealVfsFilesystem>()};
+    std::vector<RomFSFile> romfs_files;
+    const std::vector<u8> romfs = MakeRomFS(romfs_files, 256, 13);
+    const VirtualFile image = files.Write("nca", MakeCtrImage(romfs, 14));
+    const VirtualDir root = FileSys::ExtractRomFS(MakeCtrSection(image, romfs.size(), 4));
+    REQUIRE(root != nullptr);
+    u64 bytes = 0;
+    u64 opened = 0;
+    std::vector<u8> buffer;
+    const auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed{};
+    do {
+        const RomFSFile& romfs_file = romfs_files[opened % romfs_files.size()];
+        const VirtualFile file = root->GetFileRelative(romfs_file.path);
+        buffer.resize(file->GetSize());
+        bytes += file->Read(buffer.data(), buffer.size(), 0);
+        ++opened;
+        elapsed = std::chrono::steady_clock::now() - start;
+    } while (elapsed < RUN_TIME);
+    fmt::print("{:<24} whole files : {:>9.1f} MB/s, {:>11.0f} files/s\n", "RomFS over CTR",
+               static_cast<double>(bytes) / elapsed.count() / 1'000'000.0,
+               static_cast<double>(opened) / elapsed.count());
+}
@@ -547,3 +547,40 @@ TEST_CASE("BufferBase: Cached write downloads") {
     buffer.MarkRegionAsCpuModified(c, WORD);
     REQUIRE(rasterizer.Count() == 0);
 }
+
+TEST_CASE("BufferBase: Sparse modifications in large buffers") {
+    RasterizerInterface rasterizer;
+    BufferBase buffer(rasterizer, c, WORD * 256);
+    buffer.UnmarkRegionAsCpuModified(c, WORD * 256);
+    REQUIRE(!buffer.IsRegionCpuModified(c, WORD * 256));
+    buffer.MarkRegionAsCpuModified(c + WORD * 37 + PAGE * 3, PAGE);
+    buffer.MarkRegionAsCpuModified(c + WORD * 200, PAGE * 2);
+    REQUIRE(!buffer.IsRegionCpuModified(c, WORD * 37 + PAGE * 3));
+    REQUIRE(buffer.IsRegionCpuModified(c, WORD * 38));
+    REQUIRE(buffer.ModifiedCpuRegion(c, WORD * 256) ==
+            Range{WORD * 37 + PAGE * 3, WORD * 200 + PAGE * 2});
+    int num = 0;
+    buffer.ForEachUploadRange(c + WORD * 100, WORD * 156, [&](u64 offset, u64 size) {
+        REQUIRE(offset == WORD * 200);
+        REQUIRE(size == PAGE * 2);
+        ++num;
+    });
+    REQUIRE(num == 1);
+    REQUIRE(!buffer.IsRegionCpuModified(c + WORD * 100, WORD * 156));
+    REQUIRE(buffer.IsRegionCpuModified(c, WORD * 100));
+}
+
+TEST_CASE("BufferBase: Large GPU modified regions") {
+    RasterizerInterface rasterizer;
+    BufferBase buffer(rasterizer, c, WORD * 256);
+    buffer.UnmarkRegionAsCpuModified(c, WORD * 256);
+    buffer.MarkRegionAsGpuModified(c + PAGE * 5, WORD * 100);
+    REQUIRE(!buffer.IsRegionGpuModified(c, PAGE * 5));
+    REQUIRE(buffer.IsRegionGpuModified(c + WORD * 100 + PAGE * 4, PAGE));
+    REQUIRE(!buffer.IsRegionGpuModified(c + WORD * 100 + PAGE * 5, WORD * 10));
+    REQUIRE(buffer.ModifiedGpuRegion(c, WORD * 256) == Range{PAGE * 5, WORD * 100 + PAGE * 5});
+    buffer.UnmarkRegionAsGpuModified(c + WORD * 10, WORD * 80);
+    REQUIRE(!buffer.IsRegionGpuModified(c + WORD * 10, WORD * 80 - PAGE));
+    REQUIRE(buffer.IsRegionGpuModified(c + WORD * 9, WORD));
+    REQUIRE(buffer.IsRegionGpuModified(c + WORD * 90, WORD));
+}
@@ -0,0 +1,431 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "common/alignment.h"
+#include "common/common_types.h"
+#include "common/div_ceil.h"
+#include "common/settings.h"
+#include "video_core/surface.h"
+#include "video_core/texture_cache/decode_bc4.h"
+#include "video_core/texture_cache/encode_bc3.h"
+#include "video_core/texture_cache/image_info.h"
+#include "video_core/texture_cache/types.h"
+#include "video_core/texture_cache/util.h"
+#include "video_core/textures/astc.h"
+#include "video_core/textures/decoders.h"
+
+namespace {
+using VideoCommon::BufferImageCopy;
+using VideoCommon::Extent3D;
+using VideoCommon::ImageInfo;
+using VideoCore::Surface::PixelFormat;
+
+constexpr auto RUN_TIME = std::chrono::milliseconds{250};
+constexpr std::array<u32, 5> BYTES_PER_PIXEL{1, 2, 4, 8, 16};
+constexpr u32 MAX_BLOCK_HEIGHT = 5;
+
+struct AstcBlockSize {
+    u32 width;
+    u32 height;
+};
+
+constexpr std::array ASTC_BLOCK_SIZES{
+    AstcBlockSize{4, 4},   AstcBlockSize{5, 4},   AstcBlockSize{5, 5},  AstcBlockSize{6, 5},
+    AstcBlockSize{6, 6},   AstcBlockSize{8, 5},   AstcBlockSize{8, 6},  AstcBlockSize{8, 8},
+    AstcBlockSize{10, 5},  AstcBlockSize{10, 6},  AstcBlockSize{10, 8}, AstcBlockSize{10, 10},
+    AstcBlockSize{12, 10}, AstcBlockSize{12, 12},
+};
+
+std::vector<u8> RandomBytes(std::size_t size, u32 seed) {
+    std::mt19937 generator{seed};
+    std::uniform_int_distribution<u32> distribution{0, 0xff};
+    std::vector<u8> bytes(size);
+    for (u8& byte : bytes) {
+        byte = static_cast<u8>(distribution(generator));
+    }
+    return bytes;
+}
+
+/// Offset of a byte within a GOB, computed from the bit layout instead of the swizzle table
+u32 ReferenceGobOffset(u32 x, u32 y) {
+    return ((x % 64) / 32) * 256 + ((y % 8) / 2) * 64 + ((x % 32) / 16) * 32 + (y % 2) * 16 +
+           (x % 16);
+}
+
+/// Offset of a byte of a block linear texture, x is in bytes
+u32 ReferenceSwizzledOffset(u32 x, u32 y, u32 z, u32 bytes_per_pixel, u32 width, u32 height,
+                            u32 block_height, u32 block_depth) {
+    // Rows are aligned to two pixels, the default stride alignment of the swizzler
+    const u32 gobs_in_x = Common::DivCeil(Common::AlignUp(width, 2) * bytes_per_pixel, 64U);
+    const u32 gob_size = 512;
+    const u32 block_size = gobs_in_x * (gob_size << (block_height + block_depth));
+    const u32 slice_size = Common::DivCeil(height, 8U << block_height) * block_size;
+    const u32 gob_y = y / 8;
+    return (z >> block_depth) * slice_size +
+           (z & ((1U << block_depth) - 1)) * (gob_size << block_height) +
+           (gob_y >> block_height) * block_size + (gob_y & ((1U << block_height) - 1)) * gob_size +
+           (x / 64) * (gob_size << (block_height + block_depth)) + ReferenceGobOffset(x, y);
+}
+
+struct SwizzleCase {
+    u32 bytes_per_pixel;
+    u32 width;
+    u32 height;
+    u32 depth;
+    u32 block_height;
+    u32 block_depth;
+
+    [[nodiscard]] std::size_t SwizzledSize() const {
+        return Tegra::Texture::CalculateSize(true, bytes_per_pixel, width, height, depth,
+                                             block_height, block_depth);
+    }
+
+    [[nodiscard]] std::size_t LinearSize() const {
+        return static_cast<std::size_t>(width) * height * depth * bytes_per_pixel;
+    }
+};
+
+/// Checks that every byte of the linear texture matches its byte in the swizzled texture
+void CheckSwizzled(const SwizzleCase& test, std::span<const u8> linear,
+                   std::span<const u8> swizzled) {
+    const u32 pitch = test.width * test.bytes_per_pixel;
+    for (u32 z = 0; z < test.depth; ++z) {
+        for (u32 y = 0; y < test.height; ++y) {
+            for (u32 x = 0; x < pitch; ++x) {
+                const u32 offset =
+                    ReferenceSwizzledOffset(x, y, z, test.bytes_per_pixel, test.width, test.height,
+                                            test.block_height, test.block_depth);
+                const std::size_t linear_offset = (z * test.height + y) * pitch + x;
+                if (linear[linear_offset] != swizzled[offset]) {
+                    FAIL(fmt::format("Mismatch at byte {} of row {} of slice {}", x, y, z));
+                }
+            }
+        }
+    }
+}
+
+std::vector<SwizzleCase> SwizzleCases() {
+    std::vector<SwizzleCase> cases;
+    for (const u32 bytes_per_pixel : BYTES_PER_PIXEL) {
+        for (u32 block_height = 0; block_height <= MAX_BLOCK_HEIGHT; ++block_height) {
+            cases.push_back({bytes_per_pixel, 200, 100, 1, block_height, 0});
+        }
+        cases.push_back({bytes_per_pixel, 42, 30, 5, 1, 1});
+    }
+    return cases;
+}
+
+/// Returns a void extent block, filling its pixels with the given color
+std::array<u8, 16> MakeVoidExtentBlock(u8 red, u8 green, u8 blue, u8 alpha) {
+    // Void extent LDR block mode with the reserved bits and every extent coordinate set
+    const u64 low = 0xFFFFFFFFFFFFFDFCULL;
+    const auto channel = [](u8 value) { return static_cast<u64>(value) * 0x101; };
+    const u64 high = channel(red) | channel(green) << 16 | channel(blue) << 32 | channel(alpha)
+                                                                                     << 48;
+    std::array<u8, 16> block;
+    std::memcpy(block.data(), &low, sizeof(low));
+    std::memcpy(block.data() + sizeof(low), &high, sizeof(high));
+    return block;
+}
+
+/**
+ * Returns blocks with a single partition of direct RGBA endpoints and a 4x4 grid of 2 bit weights.
+ * The endpoints and the weights are random, every such block is valid.
+ */
+std::vector<u8> MakeRandomAstcBlocks(std::size_t num_blocks, u32 seed) {
+    // Block mode 0x42, one partition, color endpoint mode 12
+    static constexpr u32 HEADER = 0x42 | (12 << 13);
+    static constexpr u32 HEADER_BITS = 17;
+    std::vector<u8> blocks = RandomBytes(num_blocks * 16, seed);
+    for (std::size_t block = 0; block < num_blocks; ++block) {
+        u8* const data = blocks.data() + block * 16;
+        u32 word;
+        std::memcpy(&word, data, sizeof(word));
+        word = (word & ~((1U << HEADER_BITS) - 1)) | HEADER;
+        std::memcpy(data, &word, sizeof(word));
+    }
+    return blocks;
+}
+
+/// Decodes a BC4 block pixel following the specification
+u8 ReferenceBC4Pixel(u64 bits, u32 index) {
+    const u32 red0 = bits & 0xff;
+    const u32 red1 = (bits >> 8) & 0xff;
+    const u32 code = (bits >> (16 + 3 * index)) & 7;
+    if (code < 2) {
+        return static_cast<u8>(code == 0 ? red0 : red1);
+    }
+    if (red0 > red1) {
+        return static_cast<u8>(((8 - code) * red0 + (code - 1) * red1) / 7);
+    }
+    if (code >= 6) {
+        return code == 6 ? 0 : 0xff;
+    }
+    return static_cast<u8>(((6 - code) * red0 + (code - 1) * red1) / 5);
+}
+
+ImageInfo MakeImageInfo(PixelFormat format, u32 width, u32 height) {
+    ImageInfo info;
+    info.format = format;
+    info.type = VideoCommon::ImageType::e2D;
+    info.size = {width, height, 1};
+    return info;
+}
+
+BufferImageCopy MakeFullCopy(const ImageInfo& info, u32 tile_width, u32 tile_height,
+                             std::size_t size) {
+    return BufferImageCopy{
+        .buffer_offset = 0,
+        .buffer_size = size,
+        .buffer_row_length = Common::AlignUp(info.size.width, tile_width),
+        .buffer_image_height = Common::AlignUp(info.size.height, tile_height),
+        .image_subresource = {},
+        .image_offset = {},
+        .image_extent = info.size,
+    };
+}
+
+/// Runs the function repeatedly for RUN_TIME and returns the megabytes it processed per second
+template <typename Func>
+double MeasureThroughput(std::size_t bytes_per_run, Func&& func) {
+    u64 runs = 0;
+    const auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed{};
+    do {
+        func();
+        ++runs;
+        elapsed = std::chrono::steady_clock::now() - start;
+    } while (elapsed < RUN_TIME);
+    return static_cast<double>(bytes_per_run * runs) / elapsed.count() / 1'000'000.0;
+}
+} // Anonymous namespace
+
+TEST_CASE("Texture[UnswizzleMatchesReference]", "[video_core]") {
+    for (const SwizzleCase& test : SwizzleCases()) {
+        const std::vector<u8> swizzled = RandomBytes(test.SwizzledSize(), test.bytes_per_pixel);
+        std::vector<u8> linear(test.LinearSize());
+        Tegra::Texture::UnswizzleTexture(linear, swizzled, test.bytes_per_pixel, test.width,
+                                         test.height, test.depth, test.block_height,
+                                         test.block_depth);
+        CheckSwizzled(test, linear, swizzled);
+    }
+}
+
+TEST_CASE("Texture[SwizzleMatchesReference]", "[video_core]") {
+    for (const SwizzleCase& test : SwizzleCases()) {
+        const std::vector<u8> linear = RandomBytes(test.LinearSize(), test.bytes_per_pixel);
+        std::vector<u8> swizzled(test.SwizzledSize());
+        Tegra::Texture::SwizzleTexture(swizzled, linear, test.bytes_per_pixel, test.width,
+                                       test.height, test.depth, test.block_height,
+                                       test.block_depth);
+        CheckSwizzled(test, linear, swizzled);
+    }
+}
+
+TEST_CASE("ASTC[VoidExtent]", "[video_core]") {
+    for (const AstcBlockSize& block_size : ASTC_BLOCK_SIZES) {
+        // Partial blocks on the right and bottom edges
+        const u32 blocks_x = 5;
+        const u32 blocks_y = 3;
+        const u32 width = blocks_x * block_size.width - 1;
+        const u32 height = blocks_y * block_size.height - 2;
+        const auto block_color = [](u32 block) {
+            const auto value = static_cast<u8>(block * 16);
+            return std::array<u8, 4>{value, static_cast<u8>(~value), static_cast<u8>(value ^ 0x5a),
+                                     static_cast<u8>(0xff - block)};
+        };
+        std::vector<u8> data;
+        for (u32 block = 0; block < blocks_x * blocks_y; ++block) {
+            const auto [red, green, blue, alpha] = block_color(block);
+            const auto bytes = MakeVoidExtentBlock(red, green, blue, alpha);
+            data.insert(data.end(), bytes.begin(), bytes.end());
+        }
+        std::vector<u8> output(width * height * 4);
+        Tegra::Texture::ASTC::Decompress(data, width, height, 1, block_size.width,
+                                         block_size.height, output);
+        for (u32 y = 0; y < height; ++y) {
+            for (u32 x = 0; x < width; ++x) {
+                const u32 block = (y / block_size.height) * blocks_x + x / block_size.width;
+                const std::array<u8, 4> expected = block_color(block);
+                REQUIRE(std::memcmp(&output[(y * width + x) * 4], expected.data(), 4) == 0);
+            }
+        }
+    }
+}
+
+TEST_CASE("ASTC[LargeImagesMatchBlockDecodes]", "[video_core]") {
+    for (const AstcBlockSize& block_size : ASTC_BLOCK_SIZES) {
+        // Large enough to be decoded in parallel, with partial blocks on the edges
+        const u32 blocks_x = 80;
+        const u32 blocks_y = 64;
+        const u32 width = blocks_x * block_size.width - 1;
+        const u32 height = blocks_y * block_size.height - 1;
+        const std::vector<u8> data = MakeRandomAstcBlocks(blocks_x * blocks_y, block_size.width);
+        std::vector<u8> output(width * height * 4);
+        Tegra::Texture::ASTC::Decompress(data, width, height, 1, block_size.width,
+                                         block_size.height, output);
+
+        std::vector<u8> block_output(block_size.width * block_size.height * 4);
+        for (u32 block_y = 0; block_y < blocks_y; ++block_y) {
+            for (u32 block_x = 0; block_x < blocks_x; ++block_x) {
+                const std::size_t block = block_y * blocks_x + block_x;
+                Tegra::Texture::ASTC::Decompress(std::span(data).subspan(block * 16, 16),
+                                                 block_size.width, block_size.height, 1,
+                                                 block_size.width, block_size.height,
+                                                 block_output);
+                const u32 x = block_x * block_size.width;
+                const u32 y = block_y * block_size.height;
+                const u32 row_size = std::min(block_size.width, width - x) * 4;
+                for (u32 row = 0; row < std::min(block_size.height, height - y); ++row) {
+                    REQUIRE(std::memcmp(&output[((y + row) * width + x) * 4],
+                                        &block_output[row * block_size.width * 4], row_size) == 0);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("BC4[MatchesReference]", "[video_core]") {
+    const Extent3D extent{64, 32, 2};
+    const std::size_t num_blocks = (extent.width / 4) * (extent.height / 4) * extent.depth;
+    // Random endpoints cover both interpolation modes
+    const std::vector<u8> data = RandomBytes(num_blocks * 8, 4);
+    std::vector<u8> output(extent.width * extent.height * extent.depth * 4);
+    VideoCommon::DecompressBC4(data, extent, output);
+
+    for (u32 z = 0; z < extent.depth; ++z) {
+        for (u32 y = 0; y < extent.height; ++y) {
+            for (u32 x = 0; x < extent.width; ++x) {
+                const std::size_t block =
+                    (z * (extent.height / 4) + y / 4) * (extent.width / 4) + x / 4;
+                u64 bits;
+                std::memcpy(&bits, &data[block * 8], sizeof(bits));
+                const std::array<u8, 4> expected{ReferenceBC4Pixel(bits, (y % 4) * 4 + x % 4), 0,
+                                                 0, 0xff};
+                const std::size_t offset = ((z * extent.height + y) * extent.width + x) * 4;
+                REQUIRE(std::memcmp(&output[offset], expected.data(), 4) == 0);
+            }
+        }
+    }
+}
+
+TEST_CASE("ConvertImage[MatchesDecoders]", "[video_core]") {
+    Settings::values.use_astc_disk_cache.SetValue(false);
+    {
+        const ImageInfo info = MakeImageInfo(PixelFormat::ASTC_2D_8X8_UNORM, 126, 90);
+        const std::vector<u8> data = MakeRandomAstcBlocks(16 * 12, 8);
+        std::vector<u8> expected(info.size.width * info.size.height * 4);
+        Tegra::Texture::ASTC::Decompress(data, info.size.width, info.size.height, 1, 8, 8,
+                                         expected);
+
+        std::vector<u8> output(expected.size());
+        std::array copies{MakeFullCopy(info, 8, 8, data.size())};
+        VideoCommon::ConvertImage(data, info, output, copies);
+        REQUIRE(output == expected);
+        REQUIRE(copies[0].buffer_row_length == info.size.width);
+        REQUIRE(copies[0].buffer_image_height == info.size.height);
+
+        std::vector<u8> transcoded(VideoCommon::CalculateBC3SizeBytes(info.size));
+        copies = {MakeFullCopy(info, 8, 8, data.size())};
+        VideoCommon::ConvertImage(data, info, transcoded, copies, true);
+        REQUIRE(copies[0].buffer_size == transcoded.size());
+    }
+    {
+        const ImageInfo info = MakeImageInfo(PixelFormat::BC4_UNORM, 64, 32);
+        const std::vector<u8> data = RandomBytes(16 * 8 * 8, 5);
+        std::vector<u8> expected(info.size.width * info.size.height * 4);
+        VideoCommon::DecompressBC4(data, info.size, expected);
+
+        std::vector<u8> output(expected.size());
+        std::array copies{MakeFullCopy(info, 4, 4, data.size())};
+        VideoCommon::ConvertImage(data, info, output, copies);
+        REQUIRE(output == expected);
+    }
+}
+
+// Hidden from the default test run, select it with the [benchmark] tag
+TEST_CASE("Texture[Benchmark]", "[.][benchmark]") {
+    Settings::values.use_astc_disk_cache.SetValue(false);
+    static constexpr u32 SIZE = 1024;
+
+    for (const u32 bytes_per_pixel : BYTES_PER_PIXEL) {
+        for (u32 block_height = 0; block_height <= MAX_BLOCK_HEIGHT; ++block_height) {
+            const SwizzleCase test{bytes_per_pixel, SIZE, SIZE, 1, block_height, 0};
+            std::vector<u8> swizzled = RandomBytes(test.SwizzledSize(), 1);
+            std::vector<u8> linear(test.LinearSize());
+            const double unswizzle = MeasureThroughput(linear.size(), [&] {
+                Tegra::Texture::UnswizzleTexture(linear, swizzled, bytes_per_pixel, SIZE, SIZE, 1,
+                                                 block_height, 0);
+            });
+            const double swizzle = MeasureThroughput(linear.size(), [&] {
+                Tegra::Texture::SwizzleTexture(swizzled, linear, bytes_per_pixel, SIZE, SIZE, 1,
+                                               block_height, 0);
+            });
+            fmt::print("{:<24} {:>2} bpp, block height {:>2}: {:>8.1f} MB/s unswizzle, {:>8.1f} "
+                       "MB/s swizzle\n",
+                       "Swizzle", bytes_per_pixel, 1U << block_height, unswizzle, swizzle);
+        }
+    }
+
+    for (const AstcBlockSize& block_size : ASTC_BLOCK_SIZES) {
+        const u32 blocks = Common::DivCeil(SIZE, block_size.width) *
+                           Common::DivCeil(SIZE, block_size.height);
+        const std::vector<u8> data = MakeRandomAstcBlocks(blocks, 1);
+        std::vector<u8> output(SIZE * SIZE * 4);
+        const double throughput = MeasureThroughput(output.size(), [&] {
+            Tegra::Texture::ASTC::Decompress(data, SIZE, SIZE, 1, block_size.width,
+                                             block_size.height, output);
+        });
+        fmt::print("{:<24} {:>2}x{:<2}: {:>8.1f} MB/s decoded\n", "ASTC::Decompress",
+                   block_size.width, block_size.height, throughput);
+    }
+
+    {
+        const Extent3D extent{SIZE, SIZE, 1};
+        const std::vector<u8> data = RandomBytes(SIZE * SIZE / 2, 1);
+        std::vector<u8> output(SIZE * SIZE * 4);
+        const double throughput = MeasureThroughput(
+            output.size(), [&] { VideoCommon::DecompressBC4(data, extent, output); });
+        fmt::print("{:<24}: {:>8.1f} MB/s decoded\n", "DecompressBC4", throughput);
+    }
+
+    struct ConvertCase {
+        std::string_view name;
+        PixelFormat format;
+        u32 tile_size;
+        bool transcode;
+    };
+    const std::array convert_cases{
+        ConvertCase{"ASTC 4x4", PixelFormat::ASTC_2D_4X4_UNORM, 4, false},
+        ConvertCase{"ASTC 4x4 to BC3", PixelFormat::ASTC_2D_4X4_UNORM, 4, true},
+        ConvertCase{"ASTC 8x8", PixelFormat::ASTC_2D_8X8_UNORM, 8, false},
+        ConvertCase{"ASTC 8x8 to BC3", PixelFormat::ASTC_2D_8X8_UNORM, 8, true},
+        ConvertCase{"BC4", PixelFormat::BC4_UNORM, 4, false},
+    };
+    for (const ConvertCase& test : convert_cases) {
+        const ImageInfo info = MakeImageInfo(test.format, SIZE, SIZE);
+        const u32 blocks = (SIZE / test.tile_size) * (SIZE / test.tile_size);
+        const std::vector<u8> data = test.format == PixelFormat::BC4_UNORM
+                                         ? RandomBytes(blocks * 8, 1)
+                                         : MakeRandomAstcBlocks(blocks, 1);
+        std::vector<u8> output(SIZE * SIZE * 4);
+        const double throughput = MeasureThroughput(output.size(), [&] {
+            std::array copies{MakeFullCopy(info, test.tile_size, test.tile_size, data.size())};
+            VideoCommon::ConvertImage(data, info, output, copies, test.transcode);
+        });
+        fmt::print("{:<24} {:<16}: {:>8.1f} MB/s decoded\n", "ConvertImage", test.name,
+                   throughput);
+    }
+}
@@ -9,6 +9,12 @@
 #include <limits>
 #include <utility>
 
+#ifdef ARCHITECTURE_x86_64
+#include <emmintrin.h>
+#elif defined(ARCHITECTURE_ARM64)
+#include <arm_neon.h>
+#endif
+
 #include "common/alignment.h"
 #include "common/common_funcs.h"
 #include "common/common_types.h"
@@ -215,7 +221,8 @@ public:
         const u64* const cached_words = Array<Type::CachedCPU>();
         u64* const untracked_words = Array<Type::Untracked>();
         u64* const cpu_words = Array<Type::CPU>();
-        for (u64 word_index = 0; word_index < num_words; ++word_index) {
+        for (u64 word_index = SkipCleanWords(cached_words, 0, num_words); word_index < num_words;
+             word_index = SkipCleanWords(cached_words, word_index + 1, num_words)) {
             const u64 cached_bits = cached_words[word_index];
             NotifyRasterizer<false>(word_index, untracked_words[word_index], cached_bits);
             untracked_words[word_index] |= cached_bits;
@@ -358,6 +365,16 @@ private:
         u64 page_index = begin_page_index % PAGES_PER_WORD;
         u64 word_index = begin_word_index;
         while (word_index < end_word_index) {
+            if constexpr (type == Type::GPU) {
+                // There is nothing to notify, so fully covered words can be filled in bulk
+                const u64 full_word_end = end_page_index / PAGES_PER_WORD;
+                if (page_index == 0 && word_index < full_word_end) {
+                    std::fill(state_words + word_index, state_words + full_word_end,
+                              enable ? ~u64{0} : u64{0});
+                    word_index = full_word_end;
+                    continue;
+                }
+            }
             const u64 next_word_first_page = (word_index + 1) * PAGES_PER_WORD;
             const u64 left_offset =
                 std::min(next_word_first_page - end_page_index, PAGES_PER_WORD) % PAGES_PER_WORD;
@@ -432,11 +449,12 @@ private:
         u64* const untracked_words = Array<Type::Untracked>();
         u64* const state_words = Array<type>();
         const u64 query_end = query_begin + std::min(static_cast<u64>(size), SizeBytes());
-        u64* const words_begin = state_words + query_begin / BYTES_PER_WORD;
-        u64* const words_end = state_words + Common::DivCeil(query_end, BYTES_PER_WORD);
+        const u64 query_word_end = Common::DivCeil(query_end, BYTES_PER_WORD);
+        u64* const words_end = state_words + query_word_end;
 
         const auto modified = [](u64 word) { return word != 0; };
-        const auto first_modified_word = std::find_if(words_begin, words_end, modified);
+        u64* const first_modified_word =
+            state_words + SkipCleanWords(state_words, query_begin / BYTES_PER_WORD, query_word_end);
         if (first_modified_word == words_end) {
             // Exit early when the buffer is not modified
             return;
@@ -538,6 +556,10 @@ private:
         const u64 page_limit = Common::DivCeil(offset + size, BYTES_PER_PAGE);
         u64 page_index = (offset / BYTES_PER_PAGE) % PAGES_PER_WORD;
         for (u64 word_index = word_begin; word_index < word_end; ++word_index, page_index = 0) {
+            if (state_words[word_index] == 0) {
+                word_index = SkipCleanWords(state_words, word_index + 1, word_end) - 1;
+                continue;
+            }
             const u64 off_word = type == Type::GPU ? untracked_words[word_index] : 0;
             const u64 word = state_words[word_index] & ~off_word;
             if (word == 0) {
@@ -573,6 +595,10 @@ private:
         u64 begin = std::numeric_limits<u64>::max();
         u64 end = 0;
         for (u64 word_index = word_begin; word_index < word_end; ++word_index) {
+            if (state_words[word_index] == 0) {
+                word_index = SkipCleanWords(state_words, word_index + 1, word_end) - 1;
+                continue;
+            }
             const u64 off_word = type == Type::GPU ? untracked_words[word_index] : 0;
             const u64 word = state_words[word_index] & ~off_word;
             if (word == 0) {
@@ -590,6 +616,53 @@ private:
         return begin < end ? std::make_pair(begin * BYTES_PER_PAGE, end * BYTES_PER_PAGE) : EMPTY;
     }
 
+    /**
+     * Returns the index of the first word with any bit set in a range of words
+     *
+     * @param state_words Words to search
+     * @param word_index  First word to search
+     * @param word_end    Word where the search ends, returned when all words are clear
+     */
+    [[nodiscard]] static u64 SkipCleanWords(const u64* state_words, u64 word_index,
+                                            u64 word_end) noexcept {
+        // Large buffers are mostly clean, test eight words per iteration to skip them quickly
+        static constexpr u64 WORDS_PER_STEP = 8;
+        for (; word_index + WORDS_PER_STEP <= word_end; word_index += WORDS_PER_STEP) {
+            const u64* const step_words = state_words + word_index;
+#ifdef ARCHITECTURE_x86_64
+            const auto load = [step_words](size_t index) {
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(step_words + index * 2));
+            };
+            const __m128i bits = _mm_or_si128(_mm_or_si128(load(0), load(1)),
+                                              _mm_or_si128(load(2), load(3)));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(bits, _mm_setzero_si128())) != 0xffff) {
+                break;
+            }
+#elif defined(ARCHITECTURE_ARM64)
+            const auto load = [step_words](size_t index) {
+                return vld1q_u64(step_words + index * 2);
+            };
+            const uint64x2_t bits =
+                vorrq_u64(vorrq_u64(load(0), load(1)), vorrq_u64(load(2), load(3)));
+            if ((vgetq_lane_u64(bits, 0) | vgetq_lane_u64(bits, 1)) != 0) {
+                break;
+            }
+#else
+            u64 bits = 0;
+            for (u64 index = 0; index < WORDS_PER_STEP; ++index) {
+                bits |= step_words[index];
+            }
+            if (bits != 0) {
+                break;
+            }
+#endif
+        }
+        while (word_index < word_end && state_words[word_index] == 0) {
+            ++word_index;
+        }
+        return word_index;
+    }
+
     /// Returns the number of words of the buffer
     [[nodiscard]] size_t NumWords() const noexcept {
         return words.NumWords();
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -23,7 +24,9 @@
 #include "common/microprofile.h"
 #include "common/scope_exit.h"
 #include "common/settings.h"
+#include "core/core.h"
 #include "core/memory.h"
+#include "core/perf_stats.h"
 #include "video_core/buffer_cache/buffer_base.h"
 #include "video_core/delayed_destruction_ring.h"
 #include "video_core/dirty_flags.h"
@@ -67,6 +70,9 @@ class BufferCache {
     static constexpr bool NEEDS_BIND_UNIFORM_INDEX = P::NEEDS_BIND_UNIFORM_INDEX;
     static constexpr bool NEEDS_BIND_STORAGE_INDEX = P::NEEDS_BIND_STORAGE_INDEX;
     static constexpr bool USE_MEMORY_MAPS = P::USE_MEMORY_MAPS;
+    static constexpr bool IMPLEMENTS_ASYNC_DOWNLOADS = P::IMPLEMENTS_ASYNC_DOWNLOADS;
+    static constexpr bool HAS_STREAMED_UPLOADS = P::HAS_STREAMED_UPLOADS;
+    static constexpr bool HAS_STREAMED_BINDINGS = P::HAS_STREAMED_BINDINGS;
 
     static constexpr BufferId NULL_BUFFER_ID{0};
 
@@ -77,6 +83,7 @@ class BufferCache {
 
     using Runtime = typename P::Runtime;
     using Buffer = typename P::Buffer;
+    using AsyncBuffer = typename P::AsyncBuffer;
 
     using IntervalSet = boost::icl::interval_set<VAddr>;
     using IntervalType = typename IntervalSet::interval_type;
@@ -96,6 +103,19 @@ class BufferCache {
         BufferId buffer_id;
     };
 
+    /// Range of guest memory waiting to be written from a staging buffer
+    struct AsyncDownload {
+        VAddr cpu_addr;
+        u64 staging_offset;
+        u64 size;
+    };
+
+    /// Downloads recorded when a fence was signaled, written back once the fence is reached
+    struct PendingDownloads {
+        AsyncBuffer staging{};
+        std::vector<AsyncDownload> downloads;
+    };
+
     static constexpr Binding NULL_BINDING{
         .cpu_addr = 0,
         .size = 0,
@@ -113,6 +133,11 @@ public:
 
     void TickFrame();
 
+    /// Return the host memory held by the cached buffers, can be called from any thread
+    [[nodiscard]] u64 GetUsedMemory() const noexcept {
+        return total_used_memory.load(std::memory_order_relaxed);
+    }
+
     void WriteMemory(VAddr cpu_addr, u64 size);
 
     void CachedWriteMemory(VAddr cpu_addr, u64 size);
@@ -129,6 +154,12 @@ public:
 
     void BindHostGeometryBuffers(bool is_indexed);
 
+    /**
+     * Synchronizes the indices of the current draw in the bound index buffer without rebinding it.
+     * @returns false when the indices don't fit in the bound buffer
+     */
+    [[nodiscard]] bool ExtendIndexBuffer();
+
     void BindHostStageBuffers(size_t stage);
 
     void BindHostComputeBuffers();
@@ -239,6 +270,9 @@ private:
 
     void RunGarbageCollector();
 
+    /// Returns true when a binding is better streamed to the GPU than uploaded to its buffer
+    [[nodiscard]] bool ShouldStreamBinding(const Binding& binding);
+
     void BindHostIndexBuffer();
 
     void BindHostVertexBuffers();
@@ -312,6 +346,12 @@ private:
 
     void DownloadBufferMemory(Buffer& buffer_id, VAddr cpu_addr, u64 size);
 
+    /// Writes pending asynchronous downloads back to guest memory and releases their staging
+    void WriteBackPendingDownloads(PendingDownloads& pending);
+
+    /// Waits for and writes back asynchronous downloads overlapping the given region
+    void WaitPendingDownloads(VAddr cpu_addr, u64 size);
+
     void DeleteBuffer(BufferId buffer_id);
 
     void NotifyBufferDeletion();
@@ -354,6 +394,7 @@ private:
     u32 written_compute_storage_buffers = 0;
 
     std::array<u32, NUM_STAGES> fast_bound_uniform_buffers{};
+    u32 streamed_vertex_buffers = 0;
 
     std::array<u32, 16> uniform_cache_hits{};
     std::array<u32, 16> uniform_cache_shots{};
@@ -370,13 +411,15 @@ private:
     IntervalSet uncommitted_ranges;
     IntervalSet common_ranges;
     std::deque<IntervalSet> committed_ranges;
+    std::deque<PendingDownloads> pending_downloads;
+    bool use_async_downloads = false;
 
     size_t immediate_buffer_capacity = 0;
     std::unique_ptr<u8[]> immediate_buffer_alloc;
 
     typename SlotVector<Buffer>::Iterator deletion_iterator;
     u64 frame_tick = 0;
-    u64 total_used_memory = 0;
+    std::atomic<u64> total_used_memory{0};
 
     std::array<BufferId, ((1ULL << 39) >> PAGE_BITS)> page_table;
 };
@@ -393,6 +436,9 @@ BufferCache<P>::BufferCache(VideoCore::RasterizerInterface& rasterizer_,
     void(slot_buffers.insert(runtime, NullBufferParams{}));
     deletion_iterator = slot_buffers.end();
     common_ranges.clear();
+    if constexpr (IMPLEMENTS_ASYNC_DOWNLOADS) {
+        use_async_downloads = Settings::values.use_asynchronous_downloads.GetValue();
+    }
 }
 
 template <class P>
@@ -457,6 +503,7 @@ void BufferCache<P>::CachedWriteMemory(VAddr cpu_addr, u64 size) {
 
 template <class P>
 void BufferCache<P>::DownloadMemory(VAddr cpu_addr, u64 size) {
+    WaitPendingDownloads(cpu_addr, size);
     ForEachBufferInRange(cpu_addr, size, [&](BufferId, Buffer& buffer) {
         DownloadBufferMemory(buffer, cpu_addr, size);
     });
@@ -474,6 +521,8 @@ bool BufferCache<P>::DMACopy(GPUVAddr src_address, GPUVAddr dest_address, u64 am
     if (!source_dirty && !dest_dirty) {
         return false;
     }
+    // The guest copy below reads the source from guest memory
+    WaitPendingDownloads(*cpu_src_address, amount);
 
     const IntervalType subtract_interval{*cpu_dest_address, *cpu_dest_address + amount};
     uncommitted_ranges.subtract(subtract_interval);
@@ -574,6 +623,27 @@ void BufferCache<P>::BindHostGeometryBuffers(bool is_indexed) {
     BindHostTransformFeedbackBuffers();
 }
 
+template <class P>
+bool BufferCache<P>::ExtendIndexBuffer() {
+    if (index_buffer.buffer_id == NULL_BUFFER_ID) {
+        return false;
+    }
+    const auto& index_array = maxwell3d.regs.index_array;
+    const GPUVAddr gpu_addr_begin = index_array.StartAddress();
+    const GPUVAddr gpu_addr_end = index_array.EndAddress();
+    const u32 address_size = static_cast<u32>(gpu_addr_end - gpu_addr_begin);
+    const u32 draw_size = (index_array.count + index_array.first) * index_array.FormatSizeInBytes();
+    const u32 size = std::min(address_size, draw_size);
+    Buffer& buffer = slot_buffers[index_buffer.buffer_id];
+    if (!buffer.IsInBounds(index_buffer.cpu_addr, size)) {
+        return false;
+    }
+    SynchronizeBuffer(buffer, index_buffer.cpu_addr, size);
+    index_buffer.size = std::max(index_buffer.size, size);
+    last_index_count = index_array.count;
+    return true;
+}
+
 template <class P>
 void BufferCache<P>::BindHostStageBuffers(size_t stage) {
     MICROPROFILE_SCOPE(GPU_BindUploadBuffers);
@@ -667,7 +737,7 @@ void BufferCache<P>::AccumulateFlushes() {
 
 template <class P>
 bool BufferCache<P>::ShouldWaitAsyncFlushes() const noexcept {
-    return false;
+    return !pending_downloads.empty() && !pending_downloads.front().downloads.empty();
 }
 
 template <class P>
@@ -722,13 +792,28 @@ void BufferCache<P>::CommitAsyncFlushesHigh() {
         return;
     }
     if constexpr (USE_MEMORY_MAPS) {
-        auto download_staging = runtime.DownloadStagingBuffer(total_size_bytes);
+        auto download_staging =
+            runtime.DownloadStagingBuffer(total_size_bytes, use_async_downloads);
         for (auto& [copy, buffer_id] : downloads) {
             // Have in mind the staging buffer offset for the copy
             copy.dst_offset += download_staging.offset;
             const std::array copies{copy};
             runtime.CopyBuffer(download_staging.buffer, slot_buffers[buffer_id], copies);
         }
+        if (use_async_downloads) {
+            // Defer the write back until the fence signaled after these copies is reached
+            PendingDownloads& pending = pending_downloads.emplace_back();
+            pending.staging = download_staging;
+            pending.downloads.reserve(downloads.size());
+            for (const auto& [copy, buffer_id] : downloads) {
+                pending.downloads.push_back({
+                    .cpu_addr = slot_buffers[buffer_id].CpuAddr() + copy.src_offset,
+                    .staging_offset = copy.dst_offset - download_staging.offset,
+                    .size = copy.size,
+                });
+            }
+            return;
+        }
         runtime.Finish();
         for (const auto& [copy, buffer_id] : downloads) {
             const Buffer& buffer = slot_buffers[buffer_id];
@@ -751,16 +836,67 @@ void BufferCache<P>::CommitAsyncFlushesHigh() {
 
 template <class P>
 void BufferCache<P>::CommitAsyncFlushes() {
+    const size_t num_pending = pending_downloads.size();
     if (Settings::values.gpu_accuracy.GetValue() == Settings::GPUAccuracy::High) {
         CommitAsyncFlushesHigh();
     } else {
         uncommitted_ranges.clear();
         committed_ranges.clear();
     }
+    if (use_async_downloads && pending_downloads.size() == num_pending) {
+        // Keep one entry per fence, so pops match their commits
+        pending_downloads.emplace_back();
+    }
+}
+
+template <class P>
+void BufferCache<P>::PopAsyncFlushes() {
+    if (pending_downloads.empty()) {
+        return;
+    }
+    WriteBackPendingDownloads(pending_downloads.front());
+    pending_downloads.pop_front();
 }
 
 template <class P>
-void BufferCache<P>::PopAsyncFlushes() {}
+void BufferCache<P>::WriteBackPendingDownloads(PendingDownloads& pending) {
+    if constexpr (IMPLEMENTS_ASYNC_DOWNLOADS) {
+        if (pending.downloads.empty()) {
+            return;
+        }
+        const std::span<const u8> mapped_span = pending.staging.mapped_span;
+        for (const AsyncDownload& download : pending.downloads) {
+            cpu_memory.WriteBlockUnsafe(download.cpu_addr,
+                                        mapped_span.data() + download.staging_offset,
+                                        download.size);
+        }
+        runtime.FreeDeferredStagingBuffer(pending.staging);
+        pending.downloads.clear();
+    }
+}
+
+template <class P>
+void BufferCache<P>::WaitPendingDownloads(VAddr cpu_addr, u64 size) {
+    if constexpr (IMPLEMENTS_ASYNC_DOWNLOADS) {
+        const VAddr cpu_addr_end = cpu_addr + size;
+        const auto overlaps = [cpu_addr, cpu_addr_end](const PendingDownloads& pending) {
+            return std::ranges::any_of(pending.downloads, [&](const AsyncDownload& download) {
+                return download.cpu_addr < cpu_addr_end &&
+                       cpu_addr < download.cpu_addr + download.size;
+            });
+        };
+        const auto last =
+            std::find_if(pending_downloads.rbegin(), pending_downloads.rend(), overlaps);
+        if (last == pending_downloads.rend()) {
+            return;
+        }
+        // Older downloads have to be written first so newer data is not overwritten
+        runtime.Finish();
+        for (auto it = pending_downloads.begin(); it != last.base(); ++it) {
+            WriteBackPendingDownloads(*it);
+        }
+    }
+}
 
 template <class P>
 bool BufferCache<P>::IsRegionGpuModified(VAddr addr, size_t size) {
@@ -800,12 +936,38 @@ bool BufferCache<P>::IsRegionCpuModified(VAddr addr, size_t size) {
     return false;
 }
 
+template <class P>
+bool BufferCache<P>::ShouldStreamBinding(const Binding& binding) {
+    if (binding.buffer_id == NULL_BUFFER_ID || binding.size == 0 ||
+        !runtime.CanStreamBinding(binding.size)) {
+        return false;
+    }
+    // Only data that would have to be uploaded is streamed, data written by the GPU lives in the
+    // buffer and clean data is already there
+    const Buffer& buffer = slot_buffers[binding.buffer_id];
+    return buffer.IsRegionCpuModified(binding.cpu_addr, binding.size) &&
+           !buffer.IsRegionGpuModified(binding.cpu_addr, binding.size);
+}
+
 template <class P>
 void BufferCache<P>::BindHostIndexBuffer() {
     Buffer& buffer = slot_buffers[index_buffer.buffer_id];
     TouchBuffer(buffer);
-    const u32 offset = buffer.Offset(index_buffer.cpu_addr);
     const u32 size = index_buffer.size;
+    if constexpr (HAS_STREAMED_BINDINGS) {
+        if (ShouldStreamBinding(index_buffer)) {
+            // Write the indices straight to device local memory, skipping the copy to the buffer
+            const auto staging = runtime.UploadStagingBuffer(size);
+            cpu_memory.ReadBlockUnsafe(index_buffer.cpu_addr, staging.mapped_span.data(), size);
+            runtime.BindIndexBuffer(maxwell3d.regs.draw.topology,
+                                    maxwell3d.regs.index_array.format,
+                                    maxwell3d.regs.index_array.first,
+                                    maxwell3d.regs.index_array.count, staging.buffer,
+                                    static_cast<u32>(staging.offset), size);
+            return;
+        }
+    }
+    const u32 offset = buffer.Offset(index_buffer.cpu_addr);
     SynchronizeBuffer(buffer, index_buffer.cpu_addr, size);
     if constexpr (HAS_FULL_INDEX_AND_PRIMITIVE_SUPPORT) {
         const u32 new_offset = offset + maxwell3d.regs.index_array.first *
@@ -825,13 +987,27 @@ void BufferCache<P>::BindHostVertexBuffers() {
         const Binding& binding = vertex_buffers[index];
         Buffer& buffer = slot_buffers[binding.buffer_id];
         TouchBuffer(buffer);
+        const u32 stride = maxwell3d.regs.vertex_array[index].stride;
+        if constexpr (HAS_STREAMED_BINDINGS) {
+            if (ShouldStreamBinding(binding)) {
+                const auto staging = runtime.UploadStagingBuffer(binding.size);
+                cpu_memory.ReadBlockUnsafe(binding.cpu_addr, staging.mapped_span.data(),
+                                           binding.size);
+                runtime.BindVertexBuffer(index, staging.buffer, static_cast<u32>(staging.offset),
+                                         binding.size, stride);
+                flags[Dirty::VertexBuffer0 + index] = false;
+                streamed_vertex_buffers |= 1U << index;
+                continue;
+            }
+        }
         SynchronizeBuffer(buffer, binding.cpu_addr, binding.size);
-        if (!flags[Dirty::VertexBuffer0 + index]) {
+        const bool was_streamed = ((streamed_vertex_buffers >> index) & 1) != 0;
+        if (!flags[Dirty::VertexBuffer0 + index] && !was_streamed) {
             continue;
         }
         flags[Dirty::VertexBuffer0 + index] = false;
+        streamed_vertex_buffers &= ~(1U << index);
 
-        const u32 stride = maxwell3d.regs.vertex_array[index].stride;
         const u32 offset = buffer.Offset(binding.cpu_addr);
         runtime.BindVertexBuffer(index, buffer, offset, binding.size, stride);
     }
@@ -1204,6 +1380,8 @@ template <class P>
 typename BufferCache<P>::OverlapResult BufferCache<P>::ResolveOverlaps(VAddr cpu_addr,
                                                                        u32 wanted_size) {
     static constexpr int STREAM_LEAP_THRESHOLD = 16;
+    static constexpr u64 MIN_STREAM_LEAP = PAGE_SIZE * 256;
+    static constexpr u64 MAX_STREAM_LEAP = 16_MiB;
     std::vector<BufferId> overlap_ids;
     VAddr begin = cpu_addr;
     VAddr end = cpu_addr + wanted_size;
@@ -1230,8 +1408,9 @@ typename BufferCache<P>::OverlapResult BufferCache<P>::ResolveOverlaps(VAddr cpu
         if (stream_score > STREAM_LEAP_THRESHOLD && !has_stream_leap) {
             // When this memory region has been joined a bunch of times, we assume it's being used
             // as a stream buffer. Increase the size to skip constantly recreating buffers.
+            // Growing by the current size makes joins of a steadily growing stream logarithmic.
             has_stream_leap = true;
-            end += PAGE_SIZE * 256;
+            end += std::clamp<u64>(end - begin, MIN_STREAM_LEAP, MAX_STREAM_LEAP);
         }
     }
     return OverlapResult{
@@ -1251,6 +1430,7 @@ void BufferCache<P>::JoinOverlap(BufferId new_buffer_id, BufferId overlap_id,
         new_buffer.IncreaseStreamScore(overlap.StreamScore() + 1);
     }
     std::vector<BufferCopy> copies;
+    u64 total_size_bytes = 0;
     const size_t dst_base_offset = overlap.CpuAddr() - new_buffer.CpuAddr();
     overlap.ForEachDownloadRange([&](u64 begin, u64 range_size) {
         copies.push_back(BufferCopy{
@@ -1258,12 +1438,14 @@ void BufferCache<P>::JoinOverlap(BufferId new_buffer_id, BufferId overlap_id,
             .dst_offset = dst_base_offset + begin,
             .size = range_size,
         });
+        total_size_bytes += range_size;
         new_buffer.UnmarkRegionAsCpuModified(begin, range_size);
         new_buffer.MarkRegionAsGpuModified(begin, range_size);
     });
     if (!copies.empty()) {
         runtime.CopyBuffer(slot_buffers[new_buffer_id], overlap, copies);
     }
+    maxwell3d.System().GetPerfStats().AddBufferJoin(total_size_bytes);
     DeleteBuffer(overlap_id);
 }
 
@@ -1353,9 +1535,15 @@ void BufferCache<P>::UploadMemory(Buffer& buffer, u64 total_size_bytes, u64 larg
                                   std::span<BufferCopy> copies) {
     if constexpr (USE_MEMORY_MAPS) {
         MappedUploadMemory(buffer, total_size_bytes, copies);
-    } else {
-        ImmediateUploadMemory(buffer, largest_copy, copies);
+        return;
+    }
+    if constexpr (HAS_STREAMED_UPLOADS) {
+        if (runtime.CanStreamUpload(total_size_bytes)) {
+            MappedUploadMemory(buffer, total_size_bytes, copies);
+            return;
+        }
     }
+    ImmediateUploadMemory(buffer, largest_copy, copies);
 }
 
 template <class P>
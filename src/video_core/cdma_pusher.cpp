@@ -33,9 +33,13 @@ CDmaPusher::CDmaPusher(GPU& gpu_)
     : gpu{gpu_}, nvdec_processor(std::make_shared<Nvdec>(gpu)),
       vic_processor(std::make_unique<Vic>(gpu, nvdec_processor)),
       host1x_processor(std::make_unique<Host1x>(gpu)),
-      sync_manager(std::make_unique<SyncptIncrManager>(gpu)) {}
+      sync_manager(std::make_unique<SyncptIncrManager>(gpu)), vic_thread(1, "yuzu:VicProcess") {}
 
-CDmaPusher::~CDmaPusher() = default;
+CDmaPusher::~CDmaPusher() {
+    // Queued VIC work and pending decodes signal syncpoints through sync_manager
+    vic_thread.WaitForRequests();
+    nvdec_processor->WaitForDecodes();
+}
 
 void CDmaPusher::ProcessEntries(ChCommandHeaderList&& entries) {
     for (const auto& value : entries) {
@@ -95,8 +99,11 @@ void CDmaPusher::ExecuteCommand(u32 state_offset, u32 data) {
             if (cond == 0) {
                 sync_manager->Increment(syncpoint_id);
             } else {
-                sync_manager->SignalDone(
-                    sync_manager->IncrementWhenDone(static_cast<u32>(current_class), syncpoint_id));
+                // Decoding is asynchronous, only signal once the submitted frames are done
+                const u32 handle =
+                    sync_manager->IncrementWhenDone(static_cast<u32>(current_class), syncpoint_id);
+                nvdec_processor->OnDecodesDone(
+                    [this, handle] { sync_manager->SignalDone(handle); });
             }
             break;
         }
@@ -119,15 +126,20 @@ void CDmaPusher::ExecuteCommand(u32 state_offset, u32 data) {
             if (cond == 0) {
                 sync_manager->Increment(syncpoint_id);
             } else {
-                sync_manager->SignalDone(
-                    sync_manager->IncrementWhenDone(static_cast<u32>(current_class), syncpoint_id));
+                // Signal once the VIC methods queued before this one have been processed
+                const u32 handle =
+                    sync_manager->IncrementWhenDone(static_cast<u32>(current_class), syncpoint_id);
+                vic_thread.QueueWork([this, handle] { sync_manager->SignalDone(handle); });
             }
             break;
         }
         case ThiMethod::SetMethod1:
             LOG_DEBUG(Service_NVDRV, "VIC method 0x{:X}, Args=({})",
                       static_cast<u32>(vic_thi_state.method_0), data);
-            vic_processor->ProcessMethod(static_cast<Vic::Method>(vic_thi_state.method_0), data);
+            vic_thread.QueueWork(
+                [this, method = static_cast<Vic::Method>(vic_thi_state.method_0), data] {
+                    vic_processor->ProcessMethod(method, data);
+                });
             break;
         default:
             break;
@@ -9,6 +9,7 @@
 
 #include "common/bit_field.h"
 #include "common/common_types.h"
+#include "common/thread_worker.h"
 #include "video_core/command_classes/sync_manager.h"
 
 namespace Tegra {
@@ -114,6 +115,10 @@ private:
     u32 offset{};
     u32 mask{};
     bool incrementing{};
+
+    /// Processes VIC methods in submission order off the channel thread. Must be the last
+    /// member, so it stops before the processors it uses are destroyed.
+    Common::ThreadWorker vic_thread;
 };
 
 } // namespace Tegra
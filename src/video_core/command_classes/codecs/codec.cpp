@@ -2,10 +2,13 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <array>
 #include <cstring>
 #include <fstream>
+#include <future>
 #include <vector>
 #include "common/assert.h"
+#include "common/settings.h"
 #include "video_core/command_classes/codecs/codec.h"
 #include "video_core/command_classes/codecs/h264.h"
 #include "video_core/command_classes/codecs/vp9.h"
@@ -13,21 +16,87 @@
 #include "video_core/memory_manager.h"
 
 extern "C" {
+#include <libavutil/buffer.h>
+#include <libavutil/hwcontext.h>
+#include <libavutil/imgutils.h>
 #include <libavutil/opt.h>
 }
 
 namespace Tegra {
+namespace {
+// Decodes that may be queued before the submitting thread waits for the decode thread
+constexpr std::size_t MAX_PENDING_DECODES = 4;
 
-void AVFrameDeleter(AVFrame* ptr) {
+// Frames kept by the frame pool, enough for the frame queue plus the ones in flight
+constexpr std::size_t MAX_POOLED_FRAMES = 16;
+
+// Plane alignment of downloaded frames
+constexpr int DOWNLOAD_ALIGNMENT = 32;
+
+// Host decoders in order of preference, the first one that can be created is used
+constexpr std::array PreferredGpuDecoders{
+#ifdef _WIN32
+    AV_HWDEVICE_TYPE_CUDA,
+    AV_HWDEVICE_TYPE_D3D11VA,
+    AV_HWDEVICE_TYPE_DXVA2,
+#elif defined(__APPLE__)
+    AV_HWDEVICE_TYPE_VIDEOTOOLBOX,
+#elif defined(__linux__)
+    AV_HWDEVICE_TYPE_CUDA,
+    AV_HWDEVICE_TYPE_VAAPI,
+    AV_HWDEVICE_TYPE_VDPAU,
+#endif
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(60, 31, 100)
+    // Vulkan video decoding was added in FFmpeg 6.1
+    AV_HWDEVICE_TYPE_VULKAN,
+#endif
+};
+} // Anonymous namespace
+
+void AVFrameRecycler::operator()(AVFrame* ptr) const {
     av_frame_unref(ptr);
-    av_free(ptr);
+    if (pool != nullptr) {
+        pool->Release(ptr);
+    } else {
+        av_frame_free(&ptr);
+    }
+}
+
+AVFramePool::~AVFramePool() {
+    for (AVFrame* frame : free_frames) {
+        av_frame_free(&frame);
+    }
+}
+
+AVFramePtr AVFramePool::Acquire() {
+    {
+        std::scoped_lock lock{mutex};
+        if (!free_frames.empty()) {
+            AVFrame* const frame = free_frames.back();
+            free_frames.pop_back();
+            return AVFramePtr{frame, AVFrameRecycler{this}};
+        }
+    }
+    return AVFramePtr{av_frame_alloc(), AVFrameRecycler{this}};
+}
+
+void AVFramePool::Release(AVFrame* frame) {
+    {
+        std::scoped_lock lock{mutex};
+        if (free_frames.size() < MAX_POOLED_FRAMES) {
+            free_frames.push_back(frame);
+            return;
+        }
+    }
+    av_frame_free(&frame);
 }
 
 Codec::Codec(GPU& gpu_, const NvdecCommon::NvdecRegisters& regs)
     : gpu(gpu_), state{regs}, h264_decoder(std::make_unique<Decoder::H264>(gpu)),
-      vp9_decoder(std::make_unique<Decoder::VP9>(gpu)) {}
+      vp9_decoder(std::make_unique<Decoder::VP9>(gpu)), decode_thread(1, "yuzu:NvdecDecode") {}
 
 Codec::~Codec() {
+    decode_thread.WaitForRequests();
     if (!initialized) {
         return;
     }
@@ -41,6 +110,68 @@ Codec::~Codec() {
     av_frame_unref(av_frame);
     av_free(av_frame);
     avcodec_close(av_codec_ctx);
+    av_buffer_unref(&av_gpu_decoder);
+    av_buffer_pool_uninit(&download_pool);
+}
+
+bool Codec::InitializeGpuDecoder() {
+    for (const AVHWDeviceType type : PreferredGpuDecoders) {
+        AVPixelFormat pixel_format = AV_PIX_FMT_NONE;
+        for (int i = 0;; ++i) {
+            const AVCodecHWConfig* config = avcodec_get_hw_config(av_codec, i);
+            if (config == nullptr) {
+                break;
+            }
+            if ((config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) != 0 &&
+                config->device_type == type) {
+                pixel_format = config->pix_fmt;
+                break;
+            }
+        }
+        if (pixel_format == AV_PIX_FMT_NONE) {
+            continue;
+        }
+        if (av_hwdevice_ctx_create(&av_gpu_decoder, type, nullptr, nullptr, 0) < 0) {
+            LOG_DEBUG(Service_NVDRV, "{} GPU decoder is not available",
+                      av_hwdevice_get_type_name(type));
+            continue;
+        }
+        gpu_pixel_format = pixel_format;
+        LOG_INFO(Service_NVDRV, "Using {} GPU decoder for {}", av_hwdevice_get_type_name(type),
+                 GetCurrentCodecName());
+        return true;
+    }
+    LOG_INFO(Service_NVDRV, "No GPU decoder available for {}, decoding on the CPU",
+             GetCurrentCodecName());
+    return false;
+}
+
+bool Codec::OpenContext() {
+    av_codec_ctx = avcodec_alloc_context3(av_codec);
+    av_opt_set(av_codec_ctx->priv_data, "tune", "zerolatency", 0);
+    if (av_gpu_decoder != nullptr) {
+        av_codec_ctx->opaque = this;
+        av_codec_ctx->hw_device_ctx = av_buffer_ref(av_gpu_decoder);
+        av_codec_ctx->get_format = GetGpuFormat;
+    }
+    if (avcodec_open2(av_codec_ctx, av_codec, nullptr) < 0) {
+        avcodec_free_context(&av_codec_ctx);
+        return false;
+    }
+    return true;
+}
+
+AVPixelFormat Codec::GetGpuFormat(AVCodecContext* av_codec_ctx, const AVPixelFormat* pix_fmts) {
+    const auto* codec = static_cast<const Codec*>(av_codec_ctx->opaque);
+    for (const AVPixelFormat* pix_fmt = pix_fmts; *pix_fmt != AV_PIX_FMT_NONE; ++pix_fmt) {
+        if (*pix_fmt == codec->gpu_pixel_format) {
+            return *pix_fmt;
+        }
+    }
+    // The stream can't be decoded on the GPU (e.g. an unsupported profile), use the CPU instead
+    LOG_INFO(Service_NVDRV, "GPU decoder does not support this stream, decoding on the CPU");
+    av_buffer_unref(&av_codec_ctx->hw_device_ctx);
+    return avcodec_default_get_format(av_codec_ctx, pix_fmts);
 }
 
 void Codec::Initialize() {
@@ -56,19 +187,22 @@ void Codec::Initialize() {
         return;
     }
     av_codec = avcodec_find_decoder(codec);
-    av_codec_ctx = avcodec_alloc_context3(av_codec);
-    av_opt_set(av_codec_ctx->priv_data, "tune", "zerolatency", 0);
 
-    // TODO(ameerj): libavcodec gpu hw acceleration
+    if (Settings::values.use_nvdec_hwaccel.GetValue() && InitializeGpuDecoder()) {
+        if (OpenContext()) {
+            initialized = true;
+            return;
+        }
+        LOG_WARNING(Service_NVDRV, "Failed to open the GPU decoder, decoding on the CPU");
+        av_buffer_unref(&av_gpu_decoder);
+        gpu_pixel_format = AV_PIX_FMT_NONE;
+    }
 
-    const auto av_error = avcodec_open2(av_codec_ctx, av_codec, nullptr);
-    if (av_error < 0) {
+    if (!OpenContext()) {
         LOG_ERROR(Service_NVDRV, "avcodec_open2() Failed.");
-        avcodec_close(av_codec_ctx);
         return;
     }
     initialized = true;
-    return;
 }
 
 void Codec::SetTargetCodec(NvdecCommon::VideoCodec codec) {
@@ -84,9 +218,13 @@ void Codec::Decode() {
         Initialize();
     }
 
+    if (!initialized) {
+        return;
+    }
+
+    // Headers are composed from guest memory and the register state here, on the submitting
+    // thread, only the ffmpeg decode runs on the decode thread
     bool vp9_hidden_frame = false;
-    AVPacket packet{};
-    av_init_packet(&packet);
     std::vector<u8> frame_data;
 
     if (current_codec == NvdecCommon::VideoCodec::H264) {
@@ -96,14 +234,27 @@ void Codec::Decode() {
         vp9_hidden_frame = vp9_decoder->WasFrameHidden();
     }
 
+    if (pending_decodes.fetch_add(1, std::memory_order_relaxed) >= MAX_PENDING_DECODES) {
+        decode_thread.WaitForRequests();
+    }
+    decode_thread.QueueWork(
+        [this, frame_data = std::move(frame_data), vp9_hidden_frame]() mutable {
+            DecodePacket(std::move(frame_data), vp9_hidden_frame);
+            pending_decodes.fetch_sub(1, std::memory_order_relaxed);
+        });
+}
+
+void Codec::DecodePacket(std::vector<u8> frame_data, bool is_hidden_frame) {
+    AVPacket packet{};
+    av_init_packet(&packet);
     packet.data = frame_data.data();
     packet.size = static_cast<s32>(frame_data.size());
 
     avcodec_send_packet(av_codec_ctx, &packet);
 
-    if (!vp9_hidden_frame) {
+    if (!is_hidden_frame) {
         // Only receive/store visible frames
-        AVFramePtr frame = AVFramePtr{av_frame_alloc(), AVFrameDeleter};
+        AVFramePtr frame = frame_pool.Acquire();
         avcodec_receive_frame(av_codec_ctx, frame.get());
         av_frames.push(std::move(frame));
         // Limit queue to 10 frames. Workaround for ZLA decode and queue spam
@@ -113,16 +264,75 @@ void Codec::Decode() {
     }
 }
 
+void Codec::OnDecodesDone(Common::UniqueFunction<void> func) {
+    decode_thread.QueueWork(std::move(func));
+}
+
+void Codec::WaitForDecodes() {
+    decode_thread.WaitForRequests();
+}
+
 AVFramePtr Codec::GetCurrentFrame() {
+    // The frame queue and the codec context are only touched on the decode thread. Popping the
+    // frame there also orders it after every decode queued before this call.
+    std::promise<AVFramePtr> promise;
+    std::future<AVFramePtr> future = promise.get_future();
+    decode_thread.QueueWork([this, &promise] { promise.set_value(PopFrame()); });
+    return future.get();
+}
+
+AVFramePtr Codec::PopFrame() {
     // Sometimes VIC will request more frames than have been decoded.
     // in this case, return a nullptr and don't overwrite previous frame data
     if (av_frames.empty()) {
-        return AVFramePtr{nullptr, AVFrameDeleter};
+        return AVFramePtr{};
     }
 
     AVFramePtr frame = std::move(av_frames.front());
     av_frames.pop();
-    return frame;
+    if (gpu_pixel_format == AV_PIX_FMT_NONE || frame->format != gpu_pixel_format) {
+        return frame;
+    }
+
+    // Frames decoded on the GPU are only downloaded once VIC presents them
+    return DownloadFrame(*frame);
+}
+
+AVFramePtr Codec::DownloadFrame(const AVFrame& frame) {
+    const auto* const frames_ctx =
+        reinterpret_cast<const AVHWFramesContext*>(frame.hw_frames_ctx->data);
+    const AVPixelFormat format = frames_ctx->sw_format;
+
+    const int buffer_size =
+        av_image_get_buffer_size(format, frame.width, frame.height, DOWNLOAD_ALIGNMENT);
+    if (buffer_size < 0) {
+        LOG_ERROR(Service_NVDRV, "Unsupported GPU decoder frame format {}",
+                  static_cast<int>(format));
+        return AVFramePtr{};
+    }
+    if (download_pool == nullptr || buffer_size != download_buffer_size) {
+        // Buffers still in use keep the old pool alive until they are released
+        av_buffer_pool_uninit(&download_pool);
+        download_pool = av_buffer_pool_init(static_cast<std::size_t>(buffer_size), nullptr);
+        download_buffer_size = buffer_size;
+    }
+
+    AVFramePtr cpu_frame = frame_pool.Acquire();
+    cpu_frame->format = format;
+    cpu_frame->width = frame.width;
+    cpu_frame->height = frame.height;
+    cpu_frame->buf[0] = av_buffer_pool_get(download_pool);
+    if (cpu_frame->buf[0] == nullptr) {
+        return AVFramePtr{};
+    }
+    av_image_fill_arrays(cpu_frame->data, cpu_frame->linesize, cpu_frame->buf[0]->data, format,
+                         frame.width, frame.height, DOWNLOAD_ALIGNMENT);
+
+    if (av_hwframe_transfer_data(cpu_frame.get(), &frame, 0) < 0) {
+        LOG_ERROR(Service_NVDRV, "Failed to download a frame from the GPU decoder");
+        return AVFramePtr{};
+    }
+    return cpu_frame;
 }
 
 NvdecCommon::VideoCodec Codec::GetCurrentCodec() const {
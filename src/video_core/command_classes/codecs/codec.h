@@ -4,9 +4,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <queue>
+#include <vector>
 #include "common/common_types.h"
+#include "common/thread_worker.h"
+#include "common/unique_function.h"
 #include "video_core/command_classes/nvdec_common.h"
 
 extern "C" {
@@ -24,8 +29,35 @@ namespace Tegra {
 class GPU;
 struct VicRegisters;
 
-void AVFrameDeleter(AVFrame* ptr);
-using AVFramePtr = std::unique_ptr<AVFrame, decltype(&AVFrameDeleter)>;
+class AVFramePool;
+
+/// Releases the buffers of a frame and hands the frame back to its pool
+struct AVFrameRecycler {
+    AVFramePool* pool{};
+
+    void operator()(AVFrame* ptr) const;
+};
+using AVFramePtr = std::unique_ptr<AVFrame, AVFrameRecycler>;
+
+/// Recycles AVFrame structures, so steady state decoding doesn't allocate them
+class AVFramePool {
+public:
+    AVFramePool() = default;
+    ~AVFramePool();
+
+    AVFramePool(const AVFramePool&) = delete;
+    AVFramePool& operator=(const AVFramePool&) = delete;
+
+    /// Returns an empty frame, allocating one only when none are free
+    [[nodiscard]] AVFramePtr Acquire();
+
+    /// Returns an unreferenced frame to the pool
+    void Release(AVFrame* frame);
+
+private:
+    std::mutex mutex;
+    std::vector<AVFrame*> free_frames;
+};
 
 namespace Decoder {
 class H264;
@@ -43,10 +75,17 @@ public:
     /// Sets NVDEC video stream codec
     void SetTargetCodec(NvdecCommon::VideoCodec codec);
 
-    /// Call decoders to construct headers, decode AVFrame with ffmpeg
+    /// Call decoders to construct headers, then queues the AVFrame decode with ffmpeg on the
+    /// decode thread
     void Decode();
 
-    /// Returns next decoded frame
+    /// Runs func on the decode thread once every decode queued before it has completed
+    void OnDecodesDone(Common::UniqueFunction<void> func);
+
+    /// Blocks until every queued decode has completed
+    void WaitForDecodes();
+
+    /// Returns next decoded frame, waiting for queued decodes to complete
     [[nodiscard]] AVFramePtr GetCurrentFrame();
 
     /// Returns the value of current_codec
@@ -55,18 +94,52 @@ public:
     [[nodiscard]] std::string_view GetCurrentCodecName() const;
 
 private:
+    /// Decodes a composed frame with ffmpeg, runs on the decode thread
+    void DecodePacket(std::vector<u8> frame_data, bool is_hidden_frame);
+
+    /// Takes the oldest decoded frame off the queue, must run on the decode thread
+    [[nodiscard]] AVFramePtr PopFrame();
+
+    /// Copies a frame decoded on the GPU into a buffer of the download pool
+    [[nodiscard]] AVFramePtr DownloadFrame(const AVFrame& frame);
+
+    /// Creates a device context for the first GPU decoder supported by the host and the codec
+    bool InitializeGpuDecoder();
+
+    /// Allocates and opens the codec context, using the GPU decoder if one was created
+    bool OpenContext();
+
+    /// Picks the GPU decoder's pixel format during avcodec_open2 when the stream supports it
+    static AVPixelFormat GetGpuFormat(AVCodecContext* av_codec_ctx, const AVPixelFormat* pix_fmts);
+
     bool initialized{};
     NvdecCommon::VideoCodec current_codec{NvdecCommon::VideoCodec::None};
 
     AVCodec* av_codec{nullptr};
     AVCodecContext* av_codec_ctx{nullptr};
+    AVBufferRef* av_gpu_decoder{nullptr};
+    AVPixelFormat gpu_pixel_format{AV_PIX_FMT_NONE};
 
     GPU& gpu;
     const NvdecCommon::NvdecRegisters& state;
     std::unique_ptr<Decoder::H264> h264_decoder;
     std::unique_ptr<Decoder::VP9> vp9_decoder;
 
+    /// Declared before anything holding frames, so it outlives them
+    AVFramePool frame_pool;
+
+    /// Buffers for frames downloaded from the GPU decoder, recreated when the frame size changes
+    AVBufferPool* download_pool{nullptr};
+    int download_buffer_size{};
+
+    /// Only accessed on the decode thread
     std::queue<AVFramePtr> av_frames{};
+
+    /// Number of decodes queued and not yet completed
+    std::atomic<std::size_t> pending_decodes{};
+
+    /// Must be the last member, so the decode thread stops before anything it uses is destroyed
+    Common::ThreadWorker decode_thread;
 };
 
 } // namespace Tegra
@@ -32,6 +32,14 @@ AVFramePtr Nvdec::GetFrame() {
     return codec->GetCurrentFrame();
 }
 
+void Nvdec::OnDecodesDone(Common::UniqueFunction<void> func) {
+    codec->OnDecodesDone(std::move(func));
+}
+
+void Nvdec::WaitForDecodes() {
+    codec->WaitForDecodes();
+}
+
 void Nvdec::Execute() {
     switch (codec->GetCurrentCodec()) {
     case NvdecCommon::VideoCodec::H264:
@@ -23,6 +23,12 @@ public:
     /// Return most recently decoded frame
     [[nodiscard]] AVFramePtr GetFrame();
 
+    /// Runs func once every frame submitted so far has been decoded
+    void OnDecodesDone(Common::UniqueFunction<void> func);
+
+    /// Blocks until every frame submitted so far has been decoded
+    void WaitForDecodes();
+
 private:
     /// Invoke codec to decode a frame
     void Execute();
@@ -54,6 +54,9 @@ public:
     void IncrementAllDone();
 
 private:
+    /// Increment all sequential pending increments that are already done, with the lock held.
+    void IncrementAllDoneLocked();
+
     std::vector<SyncptIncr> increments;
     std::mutex increment_lock;
     u32 current_id{};
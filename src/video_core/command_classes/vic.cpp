@@ -2,13 +2,22 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <array>
+#include <cstring>
+
+#ifdef ARCHITECTURE_x86_64
+#include <emmintrin.h>
+#elif defined(ARCHITECTURE_ARM64)
+#include <arm_neon.h>
+#endif
 
 extern "C" {
 #if defined(__GNUC__) || defined(__clang__)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
 #endif
+#include <libavutil/pixdesc.h>
 #include <libswscale/swscale.h>
 #if defined(__GNUC__) || defined(__clang__)
 #pragma GCC diagnostic pop
@@ -26,12 +35,41 @@ extern "C" {
 #include "video_core/textures/decoders.h"
 
 namespace Tegra {
+namespace {
+/// Rows converted at a time when writing block linear frames, small enough to stay in cache
+constexpr int CONVERSION_BAND_HEIGHT = 64;
+
+/// Interleaves a row of the U and V planes into a row of an NV12 chroma plane
+void InterleaveChromaRow(u8* dst, const u8* chroma_b, const u8* chroma_r, std::size_t width) {
+    std::size_t x = 0;
+#ifdef ARCHITECTURE_x86_64
+    for (; x + 16 <= width; x += 16) {
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chroma_b + x));
+        const __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chroma_r + x));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 2), _mm_unpacklo_epi8(b, r));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 2 + 16), _mm_unpackhi_epi8(b, r));
+    }
+#elif defined(ARCHITECTURE_ARM64)
+    for (; x + 16 <= width; x += 16) {
+        vst2q_u8(dst + x * 2, uint8x16x2_t{vld1q_u8(chroma_b + x), vld1q_u8(chroma_r + x)});
+    }
+#endif
+    for (; x < width; ++x) {
+        dst[x * 2] = chroma_b[x];
+        dst[x * 2 + 1] = chroma_r[x];
+    }
+}
+} // Anonymous namespace
 
 Vic::Vic(GPU& gpu_, std::shared_ptr<Nvdec> nvdec_processor_)
     : gpu(gpu_),
       nvdec_processor(std::move(nvdec_processor_)), converted_frame_buffer{nullptr, av_free} {}
 
-Vic::~Vic() = default;
+Vic::~Vic() {
+    sws_freeContext(scaler_ctx);
+    sws_freeContext(band_scaler_ctx);
+    sws_freeContext(tail_scaler_ctx);
+}
 
 void Vic::ProcessMethod(Method method, u32 argument) {
     LOG_DEBUG(HW_GPU, "Vic method 0x{:X}", static_cast<u32>(method));
@@ -75,53 +113,82 @@ void Vic::Execute() {
     case VideoPixelFormat::RGBA8: {
         LOG_TRACE(Service_NVDRV, "Writing RGB Frame");
 
-        if (scaler_ctx == nullptr || frame->width != scaler_width ||
-            frame->height != scaler_height) {
-            const AVPixelFormat target_format =
-                (pixel_format == VideoPixelFormat::RGBA8) ? AV_PIX_FMT_RGBA : AV_PIX_FMT_BGRA;
+        const AVPixelFormat target_format =
+            (pixel_format == VideoPixelFormat::RGBA8) ? AV_PIX_FMT_RGBA : AV_PIX_FMT_BGRA;
+        // CPU decoded frames are in YUV420, frames downloaded from a GPU decoder are usually in
+        // NV12. Convert either into the expected format
+        const auto source_format = static_cast<AVPixelFormat>(frame->format);
+        const int converted_stride{frame->width * 4};
 
-            sws_freeContext(scaler_ctx);
-            scaler_ctx = nullptr;
+        const u32 blk_kind = static_cast<u32>(config.block_linear_kind);
+        if (blk_kind != 0) {
+            // Convert and swizzle the frame a band of rows at a time, so the converted rows are
+            // still in the host cache when they are swizzled instead of going through a full
+            // linear copy of the frame
+            const u32 block_height = static_cast<u32>(config.block_linear_height_log2);
+            const auto size = Tegra::Texture::CalculateSize(true, 4, frame->width, frame->height, 1,
+                                                            block_height, 0);
+            luma_buffer.resize(size);
+
+            const int band_height = std::min(frame->height, CONVERSION_BAND_HEIGHT);
+            band_buffer.resize(static_cast<std::size_t>(converted_stride) * band_height);
+            const AVPixFmtDescriptor* const descriptor = av_pix_fmt_desc_get(source_format);
+
+            for (int y = 0; y < frame->height; y += band_height) {
+                const int rows = std::min(band_height, frame->height - y);
+                SwsContext*& band_ctx = rows == band_height ? band_scaler_ctx : tail_scaler_ctx;
+                band_ctx = sws_getCachedContext(band_ctx, frame->width, rows, source_format,
+                                                frame->width, rows, target_format, 0, nullptr,
+                                                nullptr, nullptr);
+
+                std::array<const u8*, AV_NUM_DATA_POINTERS> band_planes{};
+                for (std::size_t plane = 0; plane < band_planes.size(); ++plane) {
+                    if (frame->data[plane] == nullptr) {
+                        break;
+                    }
+                    const int plane_y = plane == 0 ? y : y >> descriptor->log2_chroma_h;
+                    band_planes[plane] = frame->data[plane] + plane_y * frame->linesize[plane];
+                }
+                u8* const band_addr{band_buffer.data()};
+                sws_scale(band_ctx, band_planes.data(), frame->linesize, 0, rows, &band_addr,
+                          &converted_stride);
+
+                Tegra::Texture::SwizzleSubrect(frame->width, rows, converted_stride, frame->width,
+                                               4, luma_buffer.data(), band_addr, block_height, 0,
+                                               static_cast<u32>(y));
+            }
+
+            gpu.MemoryManager().WriteBlock(output_surface_luma_address, luma_buffer.data(), size);
+            break;
+        }
 
-            // FFmpeg returns all frames in YUV420, convert it into expected format
+        if (scaler_ctx == nullptr || frame->width != scaler_width ||
+            frame->height != scaler_height || frame->format != scaler_format) {
+            sws_freeContext(scaler_ctx);
             scaler_ctx =
-                sws_getContext(frame->width, frame->height, AV_PIX_FMT_YUV420P, frame->width,
+                sws_getContext(frame->width, frame->height, source_format, frame->width,
                                frame->height, target_format, 0, nullptr, nullptr, nullptr);
 
             scaler_width = frame->width;
             scaler_height = frame->height;
+            scaler_format = frame->format;
         }
         // Get Converted frame
         const std::size_t linear_size = frame->width * frame->height * 4;
 
-        // Only allocate frame_buffer once per stream, as the size is not expected to change
-        if (!converted_frame_buffer) {
+        // Only reallocate frame_buffer when the stream grows
+        if (!converted_frame_buffer || linear_size > converted_frame_buffer_size) {
             converted_frame_buffer = AVMallocPtr{static_cast<u8*>(av_malloc(linear_size)), av_free};
+            converted_frame_buffer_size = linear_size;
         }
 
-        const int converted_stride{frame->width * 4};
         u8* const converted_frame_buf_addr{converted_frame_buffer.get()};
-
         sws_scale(scaler_ctx, frame->data, frame->linesize, 0, frame->height,
                   &converted_frame_buf_addr, &converted_stride);
 
-        const u32 blk_kind = static_cast<u32>(config.block_linear_kind);
-        if (blk_kind != 0) {
-            // swizzle pitch linear to block linear
-            const u32 block_height = static_cast<u32>(config.block_linear_height_log2);
-            const auto size = Tegra::Texture::CalculateSize(true, 4, frame->width, frame->height, 1,
-                                                            block_height, 0);
-            luma_buffer.resize(size);
-            Tegra::Texture::SwizzleSubrect(frame->width, frame->height, frame->width * 4,
-                                           frame->width, 4, luma_buffer.data(),
-                                           converted_frame_buffer.get(), block_height, 0, 0);
-
-            gpu.MemoryManager().WriteBlock(output_surface_luma_address, luma_buffer.data(), size);
-        } else {
-            // send pitch linear frame
-            gpu.MemoryManager().WriteBlock(output_surface_luma_address, converted_frame_buf_addr,
-                                           linear_size);
-        }
+        // send pitch linear frame
+        gpu.MemoryManager().WriteBlock(output_surface_luma_address, converted_frame_buf_addr,
+                                       linear_size);
         break;
     }
     case VideoPixelFormat::Yuv420: {
@@ -140,29 +207,32 @@ void Vic::Execute() {
         const auto* chroma_r_ptr = frame->data[2];
         const auto stride = static_cast<size_t>(frame->linesize[0]);
         const auto half_stride = static_cast<size_t>(frame->linesize[1]);
+        const auto chroma_r_stride = static_cast<size_t>(frame->linesize[2]);
 
         luma_buffer.resize(aligned_width * surface_height);
         chroma_buffer.resize(aligned_width * surface_height / 2);
 
         // Populate luma buffer
         for (std::size_t y = 0; y < frame_height; ++y) {
-            const std::size_t src = y * stride;
-            const std::size_t dst = y * aligned_width;
-            for (std::size_t x = 0; x < frame_width; ++x) {
-                luma_buffer[dst + x] = luma_ptr[src + x];
-            }
+            std::memcpy(luma_buffer.data() + y * aligned_width, luma_ptr + y * stride,
+                        frame_width);
         }
         gpu.MemoryManager().WriteBlock(output_surface_luma_address, luma_buffer.data(),
                                        luma_buffer.size());
 
-        // Populate chroma buffer from both channels with interleaving.
-        for (std::size_t y = 0; y < half_height; ++y) {
-            const std::size_t src = y * half_stride;
-            const std::size_t dst = y * aligned_width;
-
-            for (std::size_t x = 0; x < half_width; ++x) {
-                chroma_buffer[dst + x * 2] = chroma_b_ptr[src + x];
-                chroma_buffer[dst + x * 2 + 1] = chroma_r_ptr[src + x];
+        if (frame->format == AV_PIX_FMT_NV12) {
+            // The chroma channels are already interleaved
+            for (std::size_t y = 0; y < half_height; ++y) {
+                const std::size_t src = y * half_stride;
+                const std::size_t dst = y * aligned_width;
+                std::memcpy(chroma_buffer.data() + dst, chroma_b_ptr + src, half_width * 2);
+            }
+        } else {
+            // Populate chroma buffer from both channels with interleaving.
+            for (std::size_t y = 0; y < half_height; ++y) {
+                InterleaveChromaRow(chroma_buffer.data() + y * aligned_width,
+                                    chroma_b_ptr + y * half_stride,
+                                    chroma_r_ptr + y * chroma_r_stride, half_width);
             }
         }
         gpu.MemoryManager().WriteBlock(output_surface_chroma_u_address, chroma_buffer.data(),
@@ -59,8 +59,10 @@ private:
     /// size does not change during a stream
     using AVMallocPtr = std::unique_ptr<u8, decltype(&av_free)>;
     AVMallocPtr converted_frame_buffer;
+    std::size_t converted_frame_buffer_size{};
     std::vector<u8> luma_buffer;
     std::vector<u8> chroma_buffer;
+    std::vector<u8> band_buffer;
 
     GPUVAddr config_struct_address{};
     GPUVAddr output_surface_luma_address{};
@@ -70,6 +72,11 @@ private:
     SwsContext* scaler_ctx{};
     s32 scaler_width{};
     s32 scaler_height{};
+    s32 scaler_format{};
+
+    /// Converters for full and partial bands of block linear frames
+    SwsContext* band_scaler_ctx{};
+    SwsContext* tail_scaler_ctx{};
 };
 
 } // namespace Tegra
@@ -10,6 +10,7 @@
 #include "video_core/dma_pusher.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/gpu.h"
+#include "video_core/gpu_capture.h"
 #include "video_core/memory_manager.h"
 
 namespace Tegra {
@@ -48,27 +49,35 @@ bool DmaPusher::Step() {
     CommandList& command_list{dma_pushbuffer.front()};
 
     ASSERT_OR_EXECUTE(
-        command_list.command_lists.size() || command_list.prefetch_command_list.size(), {
+        command_list.command_lists.size() || command_list.prefetch_command_list.size() ||
+            command_list.postfetch_command_list.size(),
+        {
             // Somehow the command_list is empty, in order to avoid a crash
             // We ignore it and assume its size is 0.
-            dma_pushbuffer.pop();
-            dma_pushbuffer_subindex = 0;
+            PopCommandList();
             return true;
         });
 
     if (command_list.prefetch_command_list.size()) {
         // Prefetched command list from nvdrv, used for things like synchronization
-        command_headers = std::move(command_list.prefetch_command_list);
-        dma_pushbuffer.pop();
+        command_headers.swap(command_list.prefetch_command_list);
+        command_list.prefetch_command_list.clear();
+        if (command_list.command_lists.empty() && command_list.postfetch_command_list.empty()) {
+            PopCommandList();
+        }
+    } else if (dma_pushbuffer_subindex >= command_list.command_lists.size()) {
+        // Commands nvdrv batched after the entries, such as syncpoint increments
+        command_headers.swap(command_list.postfetch_command_list);
+        PopCommandList();
     } else {
         const CommandListHeader command_list_header{
             command_list.command_lists[dma_pushbuffer_subindex++]};
         const GPUVAddr dma_get = command_list_header.addr;
 
-        if (dma_pushbuffer_subindex >= command_list.command_lists.size()) {
+        if (dma_pushbuffer_subindex >= command_list.command_lists.size() &&
+            command_list.postfetch_command_list.empty()) {
             // We've gone through the current list, remove it from the queue
-            dma_pushbuffer.pop();
-            dma_pushbuffer_subindex = 0;
+            PopCommandList();
         }
 
         if (command_list_header.size == 0) {
@@ -76,29 +85,79 @@ bool DmaPusher::Step() {
         }
 
         // Push buffer non-empty, read a word
-        command_headers.resize(command_list_header.size);
+        const std::size_t num_headers = command_list_header.size;
+        const std::size_t size_bytes = num_headers * sizeof(u32);
+        MemoryManager& memory_manager = gpu.MemoryManager();
         if (Settings::IsGPULevelHigh()) {
-            gpu.MemoryManager().ReadBlock(dma_get, command_headers.data(),
-                                          command_list_header.size * sizeof(u32));
+            command_headers.resize(num_headers);
+            memory_manager.ReadBlock(dma_get, command_headers.data(), size_bytes);
         } else {
-            gpu.MemoryManager().ReadBlockUnsafe(dma_get, command_headers.data(),
-                                                command_list_header.size * sizeof(u32));
+            // Lists that don't cross a page are processed in place, skipping the copy
+            if (memory_manager.IsGranularRange(dma_get, size_bytes)) {
+                const u8* const pointer = memory_manager.GetPointer(dma_get);
+                if (pointer) {
+                    ProcessCommands(std::span(reinterpret_cast<const CommandHeader*>(pointer),
+                                              num_headers));
+                    return true;
+                }
+            }
+            command_headers.resize(num_headers);
+            memory_manager.ReadBlockUnsafe(dma_get, command_headers.data(), size_bytes);
+        }
+    }
+    ProcessCommands(command_headers);
+    return true;
+}
+
+CommandList DmaPusher::AcquireCommandList() {
+    std::scoped_lock lock{free_command_lists_mutex};
+    if (free_command_lists.empty()) {
+        return {};
+    }
+    CommandList command_list{std::move(free_command_lists.back())};
+    free_command_lists.pop_back();
+    return command_list;
+}
+
+void DmaPusher::PopCommandList() {
+    CommandList& command_list{dma_pushbuffer.front()};
+    command_list.Clear();
+    {
+        std::scoped_lock lock{free_command_lists_mutex};
+        if (free_command_lists.size() < max_free_command_lists) {
+            free_command_lists.push_back(std::move(command_list));
         }
     }
-    for (std::size_t index = 0; index < command_headers.size();) {
-        const CommandHeader& command_header = command_headers[index];
+    dma_pushbuffer.pop();
+    dma_pushbuffer_subindex = 0;
+}
+
+void DmaPusher::ProcessCommands(std::span<const CommandHeader> commands) {
+    if (capture) {
+        capture->RecordCommands(commands);
+    }
+    for (std::size_t index = 0; index < commands.size();) {
+        const CommandHeader& command_header = commands[index];
 
         if (dma_state.method_count) {
             // Data word of methods command
             if (dma_state.non_incrementing) {
                 const u32 max_write = static_cast<u32>(
-                    std::min<std::size_t>(index + dma_state.method_count, command_headers.size()) -
-                    index);
+                    std::min<std::size_t>(index + dma_state.method_count, commands.size()) - index);
                 CallMultiMethod(&command_header.argument, max_write);
                 dma_state.method_count -= max_write;
                 dma_state.is_last_call = true;
                 index += max_write;
                 continue;
+            } else if (!dma_increment_once && dma_state.method >= non_puller_methods) {
+                const u32 max_write = static_cast<u32>(
+                    std::min<std::size_t>(index + dma_state.method_count, commands.size()) - index);
+                CallIncrementingMethods(&command_header.argument, max_write);
+                dma_state.method += max_write;
+                dma_state.method_count -= max_write;
+                dma_state.is_last_call = true;
+                index += max_write;
+                continue;
             } else {
                 dma_state.is_last_call = dma_state.method_count <= 1;
                 CallMethod(command_header.argument);
@@ -144,8 +203,6 @@ bool DmaPusher::Step() {
         }
         index++;
     }
-
-    return true;
 }
 
 void DmaPusher::SetState(const CommandHeader& command_header) {
@@ -155,6 +212,9 @@ void DmaPusher::SetState(const CommandHeader& command_header) {
 }
 
 void DmaPusher::CallMethod(u32 argument) const {
+    if (capture) {
+        capture->CountMethods(dma_state.subchannel, dma_state.method, 1);
+    }
     if (dma_state.method < non_puller_methods) {
         gpu.CallMethod(GPU::MethodCall{
             dma_state.method,
@@ -168,7 +228,18 @@ void DmaPusher::CallMethod(u32 argument) const {
     }
 }
 
+void DmaPusher::CallIncrementingMethods(const u32* base_start, u32 num_methods) const {
+    if (capture) {
+        capture->CountMethods(dma_state.subchannel, dma_state.method, num_methods);
+    }
+    subchannels[dma_state.subchannel]->CallIncrementingMethods(dma_state.method, base_start,
+                                                               num_methods, dma_state.method_count);
+}
+
 void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
+    if (capture) {
+        capture->CountMethods(dma_state.subchannel, dma_state.method, num_methods);
+    }
     if (dma_state.method < non_puller_methods) {
         gpu.CallMultiMethod(dma_state.method, dma_state.subchannel, base_start, num_methods,
                             dma_state.method_count);
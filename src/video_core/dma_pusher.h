@@ -5,6 +5,8 @@
 #pragma once
 
 #include <array>
+#include <mutex>
+#include <span>
 #include <vector>
 #include <queue>
 
@@ -19,6 +21,7 @@ class System;
 namespace Tegra {
 
 class GPU;
+class GPUCapture;
 
 enum class SubmissionMode : u32 {
     IncreasingOld = 0,
@@ -90,8 +93,18 @@ struct CommandList final {
     explicit CommandList(std::vector<CommandHeader>&& prefetch_command_list_)
         : prefetch_command_list{std::move(prefetch_command_list_)} {}
 
+    /// Empties the command list while keeping the storage of its vectors
+    void Clear() {
+        command_lists.clear();
+        prefetch_command_list.clear();
+        postfetch_command_list.clear();
+    }
+
     std::vector<CommandListHeader> command_lists;
+    /// Commands processed before command_lists, used by nvdrv to wait on fences
     std::vector<CommandHeader> prefetch_command_list;
+    /// Commands processed after command_lists, used by nvdrv to increment syncpoints
+    std::vector<CommandHeader> postfetch_command_list;
 };
 
 /**
@@ -110,25 +123,45 @@ public:
         dma_pushbuffer.push(std::move(entries));
     }
 
+    /// Returns an empty command list, reusing the storage of a list that was already processed
+    /// when there is one. Can be called from any thread.
+    [[nodiscard]] CommandList AcquireCommandList();
+
     void DispatchCalls();
 
     void BindSubchannel(Engines::EngineInterface* engine, u32 subchannel_id) {
         subchannels[subchannel_id] = engine;
     }
 
+    /// Records executed commands and method counts into the given capture
+    void BindCapture(GPUCapture* capture_) {
+        capture = capture_;
+    }
+
 private:
     static constexpr u32 non_puller_methods = 0x40;
     static constexpr u32 max_subchannels = 8;
+    /// Maximum number of processed command lists kept around for reuse
+    static constexpr std::size_t max_free_command_lists = 16;
+
     bool Step();
 
+    /// Removes the command list at the front of the queue, keeping its storage for reuse
+    void PopCommandList();
+
+    void ProcessCommands(std::span<const CommandHeader> commands);
+
     void SetState(const CommandHeader& command_header);
 
     void CallMethod(u32 argument) const;
     void CallMultiMethod(const u32* base_start, u32 num_methods) const;
+    void CallIncrementingMethods(const u32* base_start, u32 num_methods) const;
 
     std::vector<CommandHeader> command_headers; ///< Buffer for list of commands fetched at once
 
     std::queue<CommandList> dma_pushbuffer; ///< Queue of command lists to be processed
+    std::vector<CommandList> free_command_lists; ///< Processed lists whose storage can be reused
+    std::mutex free_command_lists_mutex;
     std::size_t dma_pushbuffer_subindex{};  ///< Index within a command list within the pushbuffer
 
     struct DmaState {
@@ -146,6 +179,7 @@ private:
     bool ib_enable{true}; ///< IB mode enabled
 
     std::array<Engines::EngineInterface*, max_subchannels> subchannels{};
+    GPUCapture* capture = nullptr;
 
     GPU& gpu;
     Core::System& system;
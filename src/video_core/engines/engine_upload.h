@@ -59,6 +59,8 @@ public:
 
     void ProcessExec(bool is_linear_);
     void ProcessData(u32 data, bool is_last_call);
+    /// Processes a batch of consecutive data words, as sent by a single multi method call.
+    void ProcessData(const u32* data, std::size_t num_data, bool is_last_call);
 
 private:
     u32 write_offset = 0;
@@ -2,9 +2,12 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <array>
 #include <cstring>
 #include <optional>
 #include "common/assert.h"
+#include "common/microprofile.h"
+#include "common/settings.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "video_core/engines/maxwell_3d.h"
@@ -21,6 +24,51 @@ using VideoCore::QueryType;
 /// First register id that is actually a Macro call.
 constexpr u32 MacroRegistersStart = 0xE00;
 
+/// Registers ProcessMethodCall does more than store, this has to be kept in sync with its switch.
+constexpr std::array<bool, Maxwell3D::Regs::NUM_REGS> METHOD_SIDE_EFFECTS = [] {
+    std::array<bool, Maxwell3D::Regs::NUM_REGS> table{};
+    for (const std::size_t method : {
+             MAXWELL3D_REG_INDEX(wait_for_idle),
+             MAXWELL3D_REG_INDEX(shadow_ram_control),
+             MAXWELL3D_REG_INDEX(macros.data),
+             MAXWELL3D_REG_INDEX(macros.bind),
+             MAXWELL3D_REG_INDEX(firmware[4]),
+             MAXWELL3D_REG_INDEX(cb_bind[0]),
+             MAXWELL3D_REG_INDEX(cb_bind[1]),
+             MAXWELL3D_REG_INDEX(cb_bind[2]),
+             MAXWELL3D_REG_INDEX(cb_bind[3]),
+             MAXWELL3D_REG_INDEX(cb_bind[4]),
+             MAXWELL3D_REG_INDEX(shader_config[0].offset),
+             MAXWELL3D_REG_INDEX(shader_config[1].offset),
+             MAXWELL3D_REG_INDEX(shader_config[2].offset),
+             MAXWELL3D_REG_INDEX(shader_config[3].offset),
+             MAXWELL3D_REG_INDEX(shader_config[4].offset),
+             MAXWELL3D_REG_INDEX(shader_config[5].offset),
+             MAXWELL3D_REG_INDEX(draw.vertex_end_gl),
+             MAXWELL3D_REG_INDEX(clear_buffers),
+             MAXWELL3D_REG_INDEX(query.query_get),
+             MAXWELL3D_REG_INDEX(condition.mode),
+             MAXWELL3D_REG_INDEX(counter_reset),
+             MAXWELL3D_REG_INDEX(sync_info),
+             MAXWELL3D_REG_INDEX(exec_upload),
+             MAXWELL3D_REG_INDEX(data_upload),
+             MAXWELL3D_REG_INDEX(fragment_barrier),
+             MAXWELL3D_REG_INDEX(tiled_cache_barrier),
+         }) {
+        table[method] = true;
+    }
+    for (u32 index = 0; index < 16; ++index) {
+        table[MAXWELL3D_REG_INDEX(const_buffer.cb_data) + index] = true;
+    }
+    return table;
+}();
+
+/// Returns true when the method is one of the CB_DATA registers.
+constexpr bool IsCBDataMethod(u32 method) {
+    constexpr u32 first_cb_data = MAXWELL3D_REG_INDEX(const_buffer.cb_data);
+    return method >= first_cb_data && method < first_cb_data + 16;
+}
+
 Maxwell3D::Maxwell3D(Core::System& system_, MemoryManager& memory_manager_)
     : system{system_}, memory_manager{memory_manager_}, macro_engine{GetMacroEngine(*this)},
       upload_state{memory_manager, regs.upload} {
@@ -156,15 +204,50 @@ u32 Maxwell3D::ProcessShadowRam(u32 method, u32 argument) {
 
 void Maxwell3D::ProcessDirtyRegisters(u32 method, u32 argument) {
     if (regs.reg_array[method] == argument) {
+        ++dirty.elided_writes;
         return;
     }
     regs.reg_array[method] = argument;
+    ++dirty.applied_writes;
 
     for (const auto& table : dirty.tables) {
         dirty.flags[table[method]] = true;
     }
 }
 
+void Maxwell3D::ProcessRegisterRun(u32 method, const u32* base_start, u32 amount) {
+    const auto control = shadow_state.shadow_ram_control;
+    if (control == Regs::ShadowRamControl::Track ||
+        control == Regs::ShadowRamControl::TrackWithFilter) {
+        std::memcpy(&shadow_state.reg_array[method], base_start, amount * sizeof(u32));
+    } else if (control == Regs::ShadowRamControl::Replay) {
+        base_start = &shadow_state.reg_array[method];
+    }
+    u32* const dest = &regs.reg_array[method];
+    if (std::memcmp(dest, base_start, amount * sizeof(u32)) == 0) {
+        dirty.elided_writes += amount;
+        return;
+    }
+    for (u32 i = 0; i < amount; ++i) {
+        if (dest[i] == base_start[i]) {
+            ++dirty.elided_writes;
+            continue;
+        }
+        ++dirty.applied_writes;
+        for (const auto& table : dirty.tables) {
+            dirty.flags[table[method + i]] = true;
+        }
+    }
+    std::memcpy(dest, base_start, amount * sizeof(u32));
+}
+
+void Maxwell3D::ReportDirtyWrites() {
+    MICROPROFILE_META_CPU("Elided register writes", static_cast<int>(dirty.elided_writes));
+    MICROPROFILE_META_CPU("Applied register writes", static_cast<int>(dirty.applied_writes));
+    dirty.elided_writes = 0;
+    dirty.applied_writes = 0;
+}
+
 void Maxwell3D::ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument,
                                   bool is_last_call) {
     switch (method) {
@@ -206,6 +289,18 @@ void Maxwell3D::ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argume
         return ProcessCBBind(3);
     case MAXWELL3D_REG_INDEX(cb_bind[4]):
         return ProcessCBBind(4);
+    case MAXWELL3D_REG_INDEX(shader_config[0].offset):
+        return ProcessShaderOffset(0);
+    case MAXWELL3D_REG_INDEX(shader_config[1].offset):
+        return ProcessShaderOffset(1);
+    case MAXWELL3D_REG_INDEX(shader_config[2].offset):
+        return ProcessShaderOffset(2);
+    case MAXWELL3D_REG_INDEX(shader_config[3].offset):
+        return ProcessShaderOffset(3);
+    case MAXWELL3D_REG_INDEX(shader_config[4].offset):
+        return ProcessShaderOffset(4);
+    case MAXWELL3D_REG_INDEX(shader_config[5].offset):
+        return ProcessShaderOffset(5);
     case MAXWELL3D_REG_INDEX(draw.vertex_end_gl):
         return DrawArrays();
     case MAXWELL3D_REG_INDEX(clear_buffers):
@@ -304,6 +399,13 @@ void Maxwell3D::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
     case MAXWELL3D_REG_INDEX(const_buffer.cb_data) + 15:
         ProcessCBMultiData(method, base_start, amount);
         break;
+    case MAXWELL3D_REG_INDEX(data_upload):
+        if (cb_data_state.current != null_cb_data) {
+            FinishCBData();
+        }
+        regs.reg_array[method] = base_start[amount - 1];
+        upload_state.ProcessData(base_start, amount, amount == methods_pending);
+        break;
     default:
         for (std::size_t i = 0; i < amount; i++) {
             CallMethod(method, base_start[i], methods_pending - static_cast<u32>(i) <= 1);
@@ -312,6 +414,48 @@ void Maxwell3D::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
     }
 }
 
+void Maxwell3D::CallIncrementingMethods(u32 method, const u32* base_start, u32 amount,
+                                        u32 methods_pending) {
+    u32 index = 0;
+    while (index < amount) {
+        const u32 first = method + index;
+        if (first >= MacroRegistersStart || executing_macro != 0) {
+            // Macro parameters and macro calls keep going through the regular path
+            const u32 remaining = amount - index;
+            EngineInterface::CallIncrementingMethods(first, base_start + index, remaining,
+                                                     methods_pending - index);
+            return;
+        }
+        // Find how many of the following registers belong to the same kind of run
+        const bool is_cb_data = IsCBDataMethod(first);
+        u32 end = index + 1;
+        if (is_cb_data) {
+            while (end < amount && IsCBDataMethod(method + end)) {
+                ++end;
+            }
+        } else if (METHOD_SIDE_EFFECTS[first]) {
+            CallMethod(first, base_start[index], methods_pending - index <= 1);
+            ++index;
+            continue;
+        } else {
+            while (end < amount && method + end < MacroRegistersStart &&
+                   !METHOD_SIDE_EFFECTS[method + end]) {
+                ++end;
+            }
+        }
+        const u32 run_size = end - index;
+        if (cb_data_state.current != null_cb_data && cb_data_state.current != first) {
+            FinishCBData();
+        }
+        ProcessRegisterRun(first, base_start + index, run_size);
+        if (is_cb_data) {
+            // Consecutive CB_DATA registers upload consecutive words of the same range
+            ProcessCBMultiData(first, &regs.reg_array[first], run_size);
+        }
+        index = end;
+    }
+}
+
 void Maxwell3D::StepInstance(const MMEDrawMode expected_mode, const u32 count) {
     if (mme_draw.current_mode == MMEDrawMode::Undefined) {
         if (mme_draw.gl_begin_consume) {
@@ -374,6 +518,7 @@ void Maxwell3D::FlushMMEInlineDraw() {
     if (ShouldExecute()) {
         rasterizer->Draw(is_indexed, true);
     }
+    ReportDirtyWrites();
 
     // TODO(bunnei): Below, we reset vertex count so that we can use these registers to determine if
     // the game is trying to draw indexed or direct mode. This needs to be verified on HW still -
@@ -463,6 +608,24 @@ void Maxwell3D::ProcessQueryGet() {
 
 void Maxwell3D::ProcessQueryCondition() {
     const GPUVAddr condition_address{regs.condition.Address()};
+    rasterizer->DisableConditionalRendering();
+    if (regs.condition.mode == Regs::ConditionMode::Equal ||
+        regs.condition.mode == Regs::ConditionMode::NotEqual) {
+        const bool equal = regs.condition.mode == Regs::ConditionMode::Equal;
+        if (rasterizer->AccelerateConditionalRendering(condition_address, equal)) {
+            // The host GPU evaluates the condition, submit draws as if they were always executed.
+            execute_on = true;
+            return;
+        }
+    }
+    if (regs.condition.mode != Regs::ConditionMode::Always &&
+        regs.condition.mode != Regs::ConditionMode::Never && !Settings::IsGPULevelExtreme() &&
+        rasterizer->IsQueryPending(condition_address, sizeof(Regs::QueryCompare))) {
+        // Reading the condition would stall until the host GPU resolves the query. Conditional
+        // rendering only skips work, so drawing unconditionally is always a safe approximation.
+        execute_on = true;
+        return;
+    }
     switch (regs.condition.mode) {
     case Regs::ConditionMode::Always: {
         execute_on = true;
@@ -541,6 +704,7 @@ void Maxwell3D::DrawArrays() {
     if (ShouldExecute()) {
         rasterizer->Draw(is_indexed, false);
     }
+    ReportDirtyWrites();
 
     // TODO(bunnei): Below, we reset vertex count so that we can use these registers to determine if
     // the game is trying to draw indexed or direct mode. This needs to be verified on HW still -
@@ -587,6 +751,13 @@ void Maxwell3D::ProcessCBBind(size_t stage_index) {
     rasterizer->BindGraphicsUniformBuffer(stage_index, bind_data.index, gpu_addr, size);
 }
 
+void Maxwell3D::ProcessShaderOffset(size_t program_index) {
+    // Disabled stages are often left pointing at stale code
+    if (regs.IsShaderConfigEnabled(program_index)) {
+        rasterizer->PrepareGraphicsShader(program_index);
+    }
+}
+
 void Maxwell3D::ProcessCBData(u32 value) {
     const u32 id = cb_data_state.id;
     cb_data_state.buffer[id][cb_data_state.counter] = value;
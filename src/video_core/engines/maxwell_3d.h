@@ -1419,6 +1419,10 @@ public:
     void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                          u32 methods_pending) override;
 
+    /// Write multiple values to consecutive registers, starting at the one identified by method.
+    void CallIncrementingMethods(u32 method, const u32* base_start, u32 amount,
+                                 u32 methods_pending) override;
+
     /// Write the value to the register identified by method.
     void CallMethodFromMME(u32 method, u32 method_argument);
 
@@ -1453,6 +1457,10 @@ public:
         return *rasterizer;
     }
 
+    Core::System& System() {
+        return system;
+    }
+
     enum class MMEDrawMode : u32 {
         Undefined,
         Array,
@@ -1475,6 +1483,11 @@ public:
 
         Flags flags;
         Tables tables{};
+
+        /// Register writes dropped because they matched the current value, since the last draw
+        u32 elided_writes{};
+        /// Register writes that changed a value and flagged its state dirty, since the last draw
+        u32 applied_writes{};
     } dirty;
 
 private:
@@ -1486,6 +1499,12 @@ private:
 
     void ProcessDirtyRegisters(u32 method, u32 argument);
 
+    /// Writes values to consecutive registers whose writes have no side effects.
+    void ProcessRegisterRun(u32 method, const u32* base_start, u32 amount);
+
+    /// Reports the register writes counted since the last draw to the profiler and resets them.
+    void ReportDirtyWrites();
+
     void ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument, bool is_last_call);
 
     /// Retrieves information about a specific TIC entry from the TIC buffer.
@@ -1538,6 +1557,9 @@ private:
     /// Handles a write to the CB_BIND register.
     void ProcessCBBind(size_t stage_index);
 
+    /// Handles a write to the SHADER_CONFIG[i].OFFSET register.
+    void ProcessShaderOffset(size_t program_index);
+
     /// Handles a write to the VERTEX_END_GL register, triggering a draw.
     void DrawArrays();
 
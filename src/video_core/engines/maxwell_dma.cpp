@@ -145,7 +145,11 @@ void MaxwellDMA::CopyBlockLinearToPitch() {
     }
 
     memory_manager.ReadBlock(regs.offset_in, read_buffer.data(), src_size);
-    memory_manager.ReadBlock(regs.offset_out, write_buffer.data(), dst_size);
+    // The destination only has to be read back when the lines do not cover the whole pitch, as
+    // reading it flushes any GPU modified data in that range.
+    if (regs.pitch_out != regs.line_length_in * bytes_per_pixel) {
+        memory_manager.ReadBlock(regs.offset_out, write_buffer.data(), dst_size);
+    }
 
     UnswizzleSubrect(regs.line_length_in, regs.line_count, regs.pitch_out, width, bytes_per_pixel,
                      block_height, src_params.origin.x, src_params.origin.y, write_buffer.data(),
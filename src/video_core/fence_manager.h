@@ -6,6 +6,8 @@
 
 #include <algorithm>
 #include <queue>
+#include <utility>
+#include <vector>
 
 #include "common/common_types.h"
 #include "common/settings.h"
@@ -93,14 +95,10 @@ public:
                 WaitFence(current_fence);
             }
             PopAsyncFlushes();
-            if (current_fence->IsSemaphore()) {
-                gpu_memory.template Write<u32>(current_fence->GetAddress(),
-                                               current_fence->GetPayload());
-            } else {
-                gpu.IncrementSyncPoint(current_fence->GetPayload());
-            }
+            AccumulateRelease(current_fence);
             PopFence();
         }
+        ReleaseAccumulatedFences();
     }
 
 protected:
@@ -136,17 +134,51 @@ private:
         while (!fences.empty()) {
             TFence& current_fence = fences.front();
             if (ShouldWait() && !IsFenceSignaled(current_fence)) {
-                return;
+                break;
             }
             PopAsyncFlushes();
-            if (current_fence->IsSemaphore()) {
-                gpu_memory.template Write<u32>(current_fence->GetAddress(),
-                                               current_fence->GetPayload());
+            AccumulateRelease(current_fence);
+            PopFence();
+        }
+        ReleaseAccumulatedFences();
+    }
+
+    /// Records the guest visible effect of a signalled fence, applied by ReleaseAccumulatedFences
+    void AccumulateRelease(const TFence& fence) {
+        if (fence->IsSemaphore()) {
+            // Only the last value written to an address of the batch can be observed
+            const GPUVAddr address = fence->GetAddress();
+            const auto it = std::ranges::find(pending_semaphores, address,
+                                              &std::pair<GPUVAddr, u32>::first);
+            if (it != pending_semaphores.end()) {
+                it->second = fence->GetPayload();
             } else {
-                gpu.IncrementSyncPoint(current_fence->GetPayload());
+                pending_semaphores.emplace_back(address, fence->GetPayload());
             }
-            PopFence();
+            return;
         }
+        const u32 syncpoint_id = fence->GetPayload();
+        const auto it = std::ranges::find(pending_syncpoints, syncpoint_id,
+                                          &std::pair<u32, u32>::first);
+        if (it != pending_syncpoints.end()) {
+            ++it->second;
+        } else {
+            pending_syncpoints.emplace_back(syncpoint_id, 1);
+        }
+    }
+
+    /// Writes the accumulated semaphores and increments each accumulated syncpoint once, waking
+    /// its waiters a single time. Semaphores go first, so a guest woken by a syncpoint sees the
+    /// writes of the fences released with it.
+    void ReleaseAccumulatedFences() {
+        for (const auto& [address, payload] : pending_semaphores) {
+            gpu_memory.template Write<u32>(address, payload);
+        }
+        for (const auto& [syncpoint_id, count] : pending_syncpoints) {
+            gpu.IncrementSyncPoint(syncpoint_id, count);
+        }
+        pending_semaphores.clear();
+        pending_syncpoints.clear();
     }
 
     bool ShouldWait() const {
@@ -182,6 +214,11 @@ private:
 
     std::queue<TFence> fences;
 
+    /// Semaphore writes of the fences being released, by address
+    std::vector<std::pair<GPUVAddr, u32>> pending_semaphores;
+    /// Increments of the fences being released, by syncpoint
+    std::vector<std::pair<u32, u32>> pending_syncpoints;
+
     DelayedDestructionRing<TFence, 6> delayed_destruction_ring;
 };
 
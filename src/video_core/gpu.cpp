@@ -5,6 +5,7 @@
 #include <chrono>
 
 #include "common/assert.h"
+#include "common/fs/path_util.h"
 #include "common/microprofile.h"
 #include "common/settings.h"
 #include "core/core.h"
@@ -14,12 +15,14 @@
 #include "core/hardware_interrupt_manager.h"
 #include "core/memory.h"
 #include "core/perf_stats.h"
+#include "core/startup_timeline.h"
 #include "video_core/engines/fermi_2d.h"
 #include "video_core/engines/kepler_compute.h"
 #include "video_core/engines/kepler_memory.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/engines/maxwell_dma.h"
 #include "video_core/gpu.h"
+#include "video_core/gpu_capture.h"
 #include "video_core/memory_manager.h"
 #include "video_core/renderer_base.h"
 #include "video_core/shader_notify.h"
@@ -38,7 +41,16 @@ GPU::GPU(Core::System& system_, bool is_async_, bool use_nvdec_)
       maxwell_dma{std::make_unique<Engines::MaxwellDMA>(system, *memory_manager)},
       kepler_memory{std::make_unique<Engines::KeplerMemory>(system, *memory_manager)},
       shader_notify{std::make_unique<VideoCore::ShaderNotify>()}, is_async{is_async_},
-      gpu_thread{system_, is_async_} {}
+      gpu_thread{system_, is_async_} {
+    if (const u32 capture_frames = Settings::values.gpu_capture_frames.GetValue()) {
+        capture = std::make_unique<GPUCapture>(
+            Common::FS::GetYuzuPath(Common::FS::YuzuPath::DumpDir) / "gpu_capture" /
+                "capture.ygpc",
+            capture_frames);
+        dma_pusher->BindCapture(capture.get());
+        memory_manager->BindCapture(capture.get());
+    }
+}
 
 GPU::~GPU() = default;
 
@@ -104,22 +116,40 @@ void GPU::WaitFence(u32 syncpoint_id, u32 value) {
         return;
     }
     MICROPROFILE_SCOPE(GPU_wait);
-    std::unique_lock lock{sync_mutex};
-    sync_cv.wait(lock, [=, this] {
+    auto& waiters = syncpoint_waiters.at(syncpoint_id);
+    std::unique_lock lock{waiters.mutex};
+    waiters.num_waiters.fetch_add(1);
+    waiters.cv.wait(lock, [=, this] {
         if (shutting_down.load(std::memory_order_relaxed)) {
             // We're shutting down, ensure no threads continue to wait for the next syncpoint
             return true;
         }
         return syncpoints.at(syncpoint_id).load() >= value;
     });
+    waiters.num_waiters.fetch_sub(1);
 }
 
-void GPU::IncrementSyncPoint(const u32 syncpoint_id) {
+bool GPU::IsFenceSignaled(u32 syncpoint_id, u32 value) const {
+    if (!is_async || syncpoint_id == UINT32_MAX) {
+        return true;
+    }
+    if (shutting_down.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    return syncpoints.at(syncpoint_id).load() >= value;
+}
+
+void GPU::IncrementSyncPoint(const u32 syncpoint_id, const u32 count) {
     auto& syncpoint = syncpoints.at(syncpoint_id);
-    syncpoint++;
-    std::lock_guard lock{sync_mutex};
-    sync_cv.notify_all();
-    auto& interrupt = syncpt_interrupts.at(syncpoint_id);
+    syncpoint.fetch_add(count);
+    auto& waiters = syncpoint_waiters[syncpoint_id];
+    if (waiters.num_waiters.load() == 0) {
+        // Waiters are counted before they check the syncpoint value, none can miss this increment
+        return;
+    }
+    std::lock_guard lock{waiters.mutex};
+    waiters.cv.notify_all();
+    auto& interrupt = waiters.interrupts;
     if (!interrupt.empty()) {
         u32 value = syncpoint.load();
         auto it = interrupt.begin();
@@ -127,6 +157,7 @@ void GPU::IncrementSyncPoint(const u32 syncpoint_id) {
             if (value >= *it) {
                 TriggerCpuInterrupt(syncpoint_id, *it);
                 it = interrupt.erase(it);
+                waiters.num_waiters.fetch_sub(1);
                 continue;
             }
             it++;
@@ -139,18 +170,29 @@ u32 GPU::GetSyncpointValue(const u32 syncpoint_id) const {
 }
 
 void GPU::RegisterSyncptInterrupt(const u32 syncpoint_id, const u32 value) {
-    auto& interrupt = syncpt_interrupts.at(syncpoint_id);
+    auto& waiters = syncpoint_waiters.at(syncpoint_id);
+    auto& interrupt = waiters.interrupts;
     bool contains = std::any_of(interrupt.begin(), interrupt.end(),
                                 [value](u32 in_value) { return in_value == value; });
     if (contains) {
         return;
     }
     interrupt.emplace_back(value);
+    waiters.num_waiters.fetch_add(1);
+
+    // An increment done before the interrupt was counted skipped the wait list, make sure the
+    // threshold wasn't reached by it
+    if (syncpoints[syncpoint_id].load() >= value) {
+        TriggerCpuInterrupt(syncpoint_id, value);
+        interrupt.pop_back();
+        waiters.num_waiters.fetch_sub(1);
+    }
 }
 
 bool GPU::CancelSyncptInterrupt(const u32 syncpoint_id, const u32 value) {
-    std::lock_guard lock{sync_mutex};
-    auto& interrupt = syncpt_interrupts.at(syncpoint_id);
+    auto& waiters = syncpoint_waiters.at(syncpoint_id);
+    std::lock_guard lock{waiters.mutex};
+    auto& interrupt = waiters.interrupts;
     const auto iter =
         std::find_if(interrupt.begin(), interrupt.end(),
                      [value](u32 interrupt_value) { return value == interrupt_value; });
@@ -159,6 +201,7 @@ bool GPU::CancelSyncptInterrupt(const u32 syncpoint_id, const u32 value) {
         return false;
     }
     interrupt.erase(iter);
+    waiters.num_waiters.fetch_sub(1);
     return true;
 }
 
@@ -200,7 +243,16 @@ u64 GPU::GetTicks() const {
 }
 
 void GPU::RendererFrameEndNotify() {
-    system.GetPerfStats().EndGameFrame();
+    auto& perf_stats = system.GetPerfStats();
+    perf_stats.EndGameFrame();
+    auto& startup_timeline = system.GetStartupTimeline();
+    if (!startup_timeline.IsComplete()) {
+        startup_timeline.MarkFirstFrame();
+        perf_stats.SetStartupTime(startup_timeline.TotalTime());
+    }
+    if (capture) {
+        capture->EndFrame();
+    }
 }
 
 void GPU::FlushCommands() {
@@ -372,6 +424,9 @@ void GPU::ProcessBindMethod(const MethodCall& method_call) {
               method_call.argument);
     const auto engine_id = static_cast<EngineID>(method_call.argument);
     bound_engines[method_call.subchannel] = static_cast<EngineID>(engine_id);
+    if (capture) {
+        capture->BindEngine(method_call.subchannel, engine_id);
+    }
     switch (engine_id) {
     case EngineID::FERMI_TWOD_A:
         dma_pusher->BindSubchannel(fermi_2d.get(), method_call.subchannel);
@@ -534,7 +589,10 @@ void GPU::TriggerCpuInterrupt(const u32 syncpoint_id, const u32 value) const {
 void GPU::ShutDown() {
     // Signal that threads should no longer block on syncpoint fences
     shutting_down.store(true, std::memory_order_relaxed);
-    sync_cv.notify_all();
+    for (auto& waiters : syncpoint_waiters) {
+        std::lock_guard lock{waiters.mutex};
+        waiters.cv.notify_all();
+    }
 
     gpu_thread.ShutDown();
 }
@@ -102,6 +102,7 @@ enum class DepthFormat : u32 {
 
 struct CommandListHeader;
 class DebugContext;
+class GPUCapture;
 
 namespace Engines {
 class Fermi2D;
@@ -225,7 +226,11 @@ public:
     /// Allows the CPU/NvFlinger to wait on the GPU before presenting a frame.
     void WaitFence(u32 syncpoint_id, u32 value);
 
-    void IncrementSyncPoint(u32 syncpoint_id);
+    /// Returns true if WaitFence would return without blocking
+    [[nodiscard]] bool IsFenceSignaled(u32 syncpoint_id, u32 value) const;
+
+    /// Increments a syncpoint by count, waking its waiters once for the whole increment
+    void IncrementSyncPoint(u32 syncpoint_id, u32 count = 1);
 
     [[nodiscard]] u32 GetSyncpointValue(u32 syncpoint_id) const;
 
@@ -235,8 +240,9 @@ public:
 
     [[nodiscard]] u64 GetTicks() const;
 
-    [[nodiscard]] std::unique_lock<std::mutex> LockSync() {
-        return std::unique_lock{sync_mutex};
+    /// Locks the wait lists of a syncpoint, RegisterSyncptInterrupt expects this lock to be held
+    [[nodiscard]] std::unique_lock<std::mutex> LockSync(u32 syncpoint_id) {
+        return std::unique_lock{syncpoint_waiters.at(syncpoint_id).mutex};
     }
 
     [[nodiscard]] bool IsAsync() const {
@@ -371,6 +377,7 @@ protected:
     std::unique_ptr<Tegra::DmaPusher> dma_pusher;
     std::unique_ptr<Tegra::CDmaPusher> cdma_pusher;
     std::unique_ptr<VideoCore::RendererBase> renderer;
+    std::unique_ptr<GPUCapture> capture;
     VideoCore::RasterizerInterface* rasterizer = nullptr;
     const bool use_nvdec;
 
@@ -394,13 +401,22 @@ private:
 
     std::array<std::atomic<u32>, Service::Nvidia::MaxSyncPoints> syncpoints{};
 
-    std::array<std::list<u32>, Service::Nvidia::MaxSyncPoints> syncpt_interrupts;
+    /// Threads and guest events waiting on a syncpoint. Each syncpoint has its own lock, so
+    /// waiting on or incrementing one syncpoint does not contend with the others.
+    struct SyncpointWaiters {
+        std::mutex mutex;
+        std::condition_variable cv;
+        /// Thresholds registered by nvdrv, the CPU is interrupted once each one is reached
+        std::list<u32> interrupts;
+        /// Host threads blocked in WaitFence plus registered interrupts. Increments of a
+        /// syncpoint without waiters don't take its lock.
+        std::atomic<u32> num_waiters{};
+    };
+
+    std::array<SyncpointWaiters, Service::Nvidia::MaxSyncPoints> syncpoint_waiters;
 
-    std::mutex sync_mutex;
     std::mutex device_mutex;
 
-    std::condition_variable sync_cv;
-
     struct FlushRequest {
         explicit FlushRequest(u64 fence_, VAddr addr_, std::size_t size_)
             : fence{fence_}, addr{addr_}, size{size_} {}
@@ -0,0 +1,185 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "video_core/dma_pusher.h"
+#include "video_core/gpu.h"
+#include "video_core/gpu_capture.h"
+
+namespace Tegra {
+namespace {
+/// Buffered capture data written to the file at once
+constexpr std::size_t FLUSH_THRESHOLD = 4ULL << 20;
+
+constexpr std::array<const char*, GPUCapture::NUM_ENGINES> ENGINE_NAMES{
+    "Puller", "Fermi2D", "Maxwell3D", "KeplerCompute", "KeplerMemory", "MaxwellDMA", "Unbound",
+};
+
+template <typename T>
+std::span<const u8> AsBytes(const T& value) {
+    return std::span(reinterpret_cast<const u8*>(&value), sizeof(T));
+}
+} // Anonymous namespace
+
+GPUCapture::GPUCapture(const std::filesystem::path& path, u32 num_frames_)
+    : num_frames{num_frames_}, last_frame_end{std::chrono::steady_clock::now()} {
+    bound.fill(Engine::Unbound);
+    if (!Common::FS::CreateParentDirs(path)) {
+        LOG_ERROR(HW_GPU, "Failed to create the directory of GPU capture path={}",
+                  Common::FS::PathToUTF8String(path));
+        return;
+    }
+    file = std::make_unique<Common::FS::IOFile>(path, Common::FS::FileAccessMode::Write,
+                                                Common::FS::FileType::BinaryFile);
+    if (!file->IsOpen()) {
+        LOG_ERROR(HW_GPU, "Failed to open GPU capture path={}",
+                  Common::FS::PathToUTF8String(path));
+        return;
+    }
+    LOG_INFO(HW_GPU, "Capturing {} GPU frames to path={}", num_frames,
+             Common::FS::PathToUTF8String(path));
+    const FileHeader header{
+        .magic = MAGIC,
+        .version = VERSION,
+        .frame_count = num_frames,
+        .reserved = 0,
+    };
+    const auto header_bytes = AsBytes(header);
+    pending.assign(header_bytes.begin(), header_bytes.end());
+    is_capturing = true;
+}
+
+GPUCapture::~GPUCapture() {
+    Finish();
+}
+
+void GPUCapture::RecordMap(GPUVAddr gpu_addr, VAddr cpu_addr, u64 size) {
+    if (!IsCapturing()) {
+        return;
+    }
+    WriteRecord(RecordType::Map, AsBytes(MapRecord{
+                                     .gpu_addr = gpu_addr,
+                                     .cpu_addr = cpu_addr,
+                                     .size = size,
+                                 }));
+}
+
+void GPUCapture::RecordUnmap(GPUVAddr gpu_addr, u64 size) {
+    if (!IsCapturing()) {
+        return;
+    }
+    WriteRecord(RecordType::Unmap, AsBytes(UnmapRecord{
+                                       .gpu_addr = gpu_addr,
+                                       .size = size,
+                                   }));
+}
+
+void GPUCapture::RecordCommands(std::span<const CommandHeader> commands) {
+    if (!IsCapturing()) {
+        return;
+    }
+    WriteRecord(RecordType::Commands,
+                std::span(reinterpret_cast<const u8*>(commands.data()), commands.size_bytes()));
+}
+
+void GPUCapture::BindEngine(u32 subchannel, EngineID engine_id) {
+    const Engine engine = [engine_id] {
+        switch (engine_id) {
+        case EngineID::FERMI_TWOD_A:
+            return Engine::Fermi2D;
+        case EngineID::MAXWELL_B:
+            return Engine::Maxwell3D;
+        case EngineID::KEPLER_COMPUTE_B:
+            return Engine::KeplerCompute;
+        case EngineID::KEPLER_INLINE_TO_MEMORY_B:
+            return Engine::KeplerMemory;
+        case EngineID::MAXWELL_DMA_COPY_A:
+            return Engine::MaxwellDMA;
+        }
+        return Engine::Unbound;
+    }();
+    bound[subchannel & 7] = engine;
+}
+
+void GPUCapture::EndFrame() {
+    if (!IsCapturing()) {
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    const auto frame_time =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_frame_end).count();
+    last_frame_end = now;
+
+    const FrameRecord record{
+        .frame = frame,
+        .frame_time_ns = static_cast<u64>(frame_time),
+        .method_counts = method_counts,
+    };
+    WriteRecord(RecordType::Frame, AsBytes(record));
+    for (std::size_t i = 0; i < NUM_ENGINES; ++i) {
+        total_method_counts[i] += method_counts[i];
+    }
+    method_counts.fill(0);
+    total_frame_time_ns += record.frame_time_ns;
+
+    if (++frame >= num_frames) {
+        Finish();
+    }
+}
+
+void GPUCapture::WriteRecord(RecordType type, std::span<const u8> payload) {
+    const RecordHeader header{
+        .type = type,
+        .reserved = 0,
+        .size = payload.size(),
+    };
+    std::scoped_lock lock{mutex};
+    if (!file) {
+        return;
+    }
+    const auto header_bytes = AsBytes(header);
+    pending.insert(pending.end(), header_bytes.begin(), header_bytes.end());
+    pending.insert(pending.end(), payload.begin(), payload.end());
+    if (pending.size() < FLUSH_THRESHOLD) {
+        return;
+    }
+    if (file->WriteSpan(std::span<const u8>(pending)) != pending.size()) {
+        LOG_ERROR(HW_GPU, "Failed to write GPU capture, stopping capture");
+        file.reset();
+        is_capturing = false;
+    }
+    pending.clear();
+}
+
+void GPUCapture::Finish() {
+    std::scoped_lock lock{mutex};
+    if (!file) {
+        return;
+    }
+    is_capturing = false;
+    if (!pending.empty()) {
+        static_cast<void>(file->WriteSpan(std::span<const u8>(pending)));
+        pending.clear();
+    }
+    file.reset();
+
+    if (frame == 0) {
+        return;
+    }
+    LOG_INFO(HW_GPU, "GPU capture finished, {} frames, {:.3f} ms per frame", frame,
+             static_cast<double>(total_frame_time_ns) / frame / 1'000'000.0);
+    for (std::size_t i = 0; i < NUM_ENGINES; ++i) {
+        if (total_method_counts[i] != 0) {
+            LOG_INFO(HW_GPU, "  {}: {} methods per frame", ENGINE_NAMES[i],
+                     total_method_counts[i] / frame);
+        }
+    }
+}
+
+} // namespace Tegra
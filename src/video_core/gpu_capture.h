@@ -0,0 +1,138 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+
+namespace Common::FS {
+class IOFile;
+}
+
+namespace Tegra {
+
+enum class EngineID;
+union CommandHeader;
+
+/**
+ * Records the GPU command stream of a number of frames, so renderer changes can be measured on
+ * the same workload. A capture is a FileHeader followed by records, each one a RecordHeader
+ * followed by its payload. Command records hold the command words as the DMA pusher executed
+ * them, so they don't depend on the pushbuffers still being in guest memory.
+ */
+class GPUCapture {
+public:
+    static constexpr u32 MAGIC = Common::MakeMagic('Y', 'G', 'P', 'C');
+    static constexpr u32 VERSION = 1;
+
+    enum class RecordType : u32 {
+        Map = 0,
+        Unmap = 1,
+        Commands = 2,
+        Frame = 3,
+    };
+
+    /// Engines tracked by the per frame method counters
+    enum class Engine : u32 {
+        Puller,
+        Fermi2D,
+        Maxwell3D,
+        KeplerCompute,
+        KeplerMemory,
+        MaxwellDMA,
+        Unbound,
+        Count,
+    };
+    static constexpr std::size_t NUM_ENGINES = static_cast<std::size_t>(Engine::Count);
+
+    struct FileHeader {
+        u32 magic;
+        u32 version;
+        u32 frame_count;
+        u32 reserved;
+    };
+
+    struct RecordHeader {
+        RecordType type;
+        u32 reserved;
+        u64 size;
+    };
+    static_assert(sizeof(RecordHeader) == 0x10, "RecordHeader is an invalid size");
+
+    struct MapRecord {
+        GPUVAddr gpu_addr;
+        VAddr cpu_addr;
+        u64 size;
+    };
+
+    struct UnmapRecord {
+        GPUVAddr gpu_addr;
+        u64 size;
+    };
+
+    struct FrameRecord {
+        u64 frame;
+        /// Host time between the end of the previous frame and the end of this one
+        u64 frame_time_ns;
+        std::array<u64, NUM_ENGINES> method_counts;
+    };
+
+    explicit GPUCapture(const std::filesystem::path& path, u32 num_frames_);
+    ~GPUCapture();
+
+    GPUCapture(const GPUCapture&) = delete;
+    GPUCapture& operator=(const GPUCapture&) = delete;
+
+    /// Returns true while frames are being recorded
+    [[nodiscard]] bool IsCapturing() const noexcept {
+        return is_capturing.load(std::memory_order_relaxed);
+    }
+
+    void RecordMap(GPUVAddr gpu_addr, VAddr cpu_addr, u64 size);
+    void RecordUnmap(GPUVAddr gpu_addr, u64 size);
+    void RecordCommands(std::span<const CommandHeader> commands);
+
+    /// Tracks which engine a subchannel's methods are counted against
+    void BindEngine(u32 subchannel, EngineID engine_id);
+
+    /// Counts methods executed on a subchannel in the current frame
+    void CountMethods(u32 subchannel, u32 method, u32 count) noexcept {
+        const Engine engine = method < NUM_PULLER_METHODS ? Engine::Puller : bound[subchannel & 7];
+        method_counts[static_cast<std::size_t>(engine)] += count;
+    }
+
+    /// Ends the current frame, stopping the capture once enough frames were recorded
+    void EndFrame();
+
+private:
+    static constexpr u32 NUM_PULLER_METHODS = 0x40;
+
+    void WriteRecord(RecordType type, std::span<const u8> payload);
+    void Finish();
+
+    std::unique_ptr<Common::FS::IOFile> file;
+    std::mutex mutex;
+    std::vector<u8> pending;
+    std::atomic_bool is_capturing{};
+
+    const u32 num_frames;
+    u32 frame = 0;
+    std::chrono::steady_clock::time_point last_frame_end;
+    std::array<Engine, 8> bound{};
+    std::array<u64, NUM_ENGINES> method_counts{};
+    std::array<u64, NUM_ENGINES> total_method_counts{};
+    u64 total_frame_time_ns = 0;
+};
+
+} // namespace Tegra
@@ -7,8 +7,10 @@
 #include "common/scope_exit.h"
 #include "common/settings.h"
 #include "common/thread.h"
+#include "common/thread_placement.h"
 #include "core/core.h"
 #include "core/frontend/emu_window.h"
+#include "core/perf_stats.h"
 #include "video_core/dma_pusher.h"
 #include "video_core/gpu.h"
 #include "video_core/gpu_thread.h"
@@ -16,6 +18,18 @@
 
 namespace VideoCommon::GPUThread {
 
+/// Replaces the current command with the next one in the queue when the current command does not
+/// block its caller and the next one holds a command of the given type.
+/// Used to merge bursts of commands into a single operation on the GPU thread.
+template <typename Command>
+static bool PopNextIf(SynchState& state, CommandDataContainer& next) {
+    if (next.block || state.queue.Empty() ||
+        !std::holds_alternative<Command>(state.queue.Front().data)) {
+        return false;
+    }
+    return state.queue.Pop(next);
+}
+
 /// Runs the GPU thread
 static void RunThread(Core::System& system, VideoCore::RendererBase& renderer,
                       Core::Frontend::GraphicsContext& context, Tegra::DmaPusher& dma_pusher,
@@ -26,6 +40,7 @@ static void RunThread(Core::System& system, VideoCore::RendererBase& renderer,
 
     Common::SetCurrentThreadName(name.c_str());
     Common::SetCurrentThreadPriority(Common::ThreadPriority::High);
+    Common::PlaceCurrentThread(Common::PlacedThread::Gpu);
     system.RegisterHostThread();
 
     // Wait for first GPU command before acquiring the window context
@@ -42,12 +57,21 @@ static void RunThread(Core::System& system, VideoCore::RendererBase& renderer,
     CommandDataContainer next;
     while (state.is_running) {
         next = state.queue.PopWait();
+        MICROPROFILE_META_CPU("GPU queue depth", static_cast<int>(state.queue.Size()));
         if (auto* submit_list = std::get_if<SubmitListCommand>(&next.data)) {
             dma_pusher.Push(std::move(submit_list->entries));
+            // Dispatch command lists queued behind this one together, so the cache flushes and
+            // fence releases done at the end of a dispatch happen once per burst
+            while (PopNextIf<SubmitListCommand>(state, next)) {
+                dma_pusher.Push(std::move(std::get<SubmitListCommand>(next.data).entries));
+            }
             dma_pusher.DispatchCalls();
         } else if (const auto* data = std::get_if<SwapBuffersCommand>(&next.data)) {
             renderer.SwapBuffers(data->framebuffer ? &*data->framebuffer : nullptr);
         } else if (std::holds_alternative<OnCommandListEndCommand>(next.data)) {
+            // A single release handles every fence signaled so far
+            while (PopNextIf<OnCommandListEndCommand>(state, next)) {
+            }
             rasterizer->ReleaseFences();
         } else if (std::holds_alternative<GPUTickCommand>(next.data)) {
             system.GPU().TickWork();
@@ -68,6 +92,12 @@ static void RunThread(Core::System& system, VideoCore::RendererBase& renderer,
             state.cv.notify_all();
         }
     }
+
+    // Discard the commands left behind until the shutdown command, so writers waiting on a full
+    // queue are not left stuck
+    while (!std::holds_alternative<EndProcessingCommand>(next.data)) {
+        next = state.queue.PopWait();
+    }
 }
 
 ThreadManager::ThreadManager(Core::System& system_, bool is_async_)
@@ -94,6 +124,7 @@ void ThreadManager::SwapBuffers(const Tegra::FramebufferConfig* framebuffer) {
 }
 
 void ThreadManager::FlushRegion(VAddr addr, u64 size) {
+    const Core::ScopedStall stall{system.GetPerfStats(), Core::StallCause::GpuFlush};
     if (!is_async) {
         // Always flush with synchronous GPU mode
         PushCommand(FlushRegionCommand(addr, size));
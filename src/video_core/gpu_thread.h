@@ -11,7 +11,7 @@
 #include <thread>
 #include <variant>
 
-#include "common/threadsafe_queue.h"
+#include "common/bounded_threadsafe_queue.h"
 #include "video_core/framebuffer_config.h"
 
 namespace Tegra {
@@ -102,7 +102,10 @@ struct CommandDataContainer {
 struct SynchState final {
     std::atomic_bool is_running{true};
 
-    using CommandQueue = Common::SPSCQueue<CommandDataContainer>;
+    /// Maximum number of commands in flight, pushing to a full queue waits for the GPU thread
+    static constexpr std::size_t QUEUE_CAPACITY = 1024;
+
+    using CommandQueue = Common::BoundedSPSCQueue<CommandDataContainer, QUEUE_CAPACITY>;
     std::mutex write_lock;
     CommandQueue queue;
     u64 last_fence{};
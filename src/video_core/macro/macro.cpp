@@ -2,23 +2,39 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <optional>
+#include <string>
+#include <utility>
 #include <boost/container_hash/hash.hpp>
 #include "common/assert.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
 #include "common/logging/log.h"
 #include "common/settings.h"
+#include "core/core.h"
+#include "core/hle/kernel/k_process.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/macro/macro.h"
 #include "video_core/macro/macro_hle.h"
 #include "video_core/macro/macro_interpreter.h"
+#include "video_core/macro/macro_jit_arm64.h"
 #include "video_core/macro/macro_jit_x64.h"
 
 namespace Tegra {
 
 MacroEngine::MacroEngine(Engines::Maxwell3D& maxwell3d)
-    : hle_macros{std::make_unique<Tegra::HLEMacro>(maxwell3d)} {}
+    : hle_macros{std::make_unique<Tegra::HLEMacro>(maxwell3d)},
+      is_profiling{Settings::values.dump_macro_profile.GetValue()} {}
 
-MacroEngine::~MacroEngine() = default;
+MacroEngine::~MacroEngine() {
+    if (is_profiling) {
+        WriteProfile();
+    }
+}
 
 void MacroEngine::AddCode(u32 method, u32 data) {
     uploaded_macro_code[method].push_back(data);
@@ -26,55 +42,137 @@ void MacroEngine::AddCode(u32 method, u32 data) {
 
 void MacroEngine::Execute(Engines::Maxwell3D& maxwell3d, u32 method,
                           const std::vector<u32>& parameters) {
-    auto compiled_macro = macro_cache.find(method);
-    if (compiled_macro != macro_cache.end()) {
-        const auto& cache_info = compiled_macro->second;
-        if (cache_info.has_hle_program) {
-            cache_info.hle_program->Execute(parameters, method);
-        } else {
-            cache_info.lle_program->Execute(parameters, method);
-        }
+    CacheInfo* const cache_info = GetCacheInfo(method);
+    if (!cache_info) {
+        return;
+    }
+    if (is_profiling) {
+        ExecuteProfiled(maxwell3d, method, parameters, *cache_info);
+        return;
+    }
+    if (cache_info->has_hle_program) {
+        cache_info->hle_program->Execute(parameters, method);
     } else {
-        // Macro not compiled, check if it's uploaded and if so, compile it
-        std::optional<u32> mid_method;
-        const auto macro_code = uploaded_macro_code.find(method);
-        if (macro_code == uploaded_macro_code.end()) {
-            for (const auto& [method_base, code] : uploaded_macro_code) {
-                if (method >= method_base && (method - method_base) < code.size()) {
-                    mid_method = method_base;
-                    break;
-                }
-            }
-            if (!mid_method.has_value()) {
-                UNREACHABLE_MSG("Macro 0x{0:x} was not uploaded", method);
-                return;
+        cache_info->lle_program->Execute(parameters, method);
+    }
+}
+
+MacroEngine::CacheInfo* MacroEngine::GetCacheInfo(u32 method) {
+    const auto compiled_macro = macro_cache.find(method);
+    if (compiled_macro != macro_cache.end()) {
+        return &compiled_macro->second;
+    }
+    // Macro not compiled, check if it's uploaded and if so, compile it
+    std::optional<u32> mid_method;
+    const auto macro_code = uploaded_macro_code.find(method);
+    if (macro_code == uploaded_macro_code.end()) {
+        for (const auto& [method_base, code] : uploaded_macro_code) {
+            if (method >= method_base && (method - method_base) < code.size()) {
+                mid_method = method_base;
+                break;
             }
         }
-        auto& cache_info = macro_cache[method];
-
         if (!mid_method.has_value()) {
-            cache_info.lle_program = Compile(macro_code->second);
-            cache_info.hash = boost::hash_value(macro_code->second);
-        } else {
-            const auto& macro_cached = uploaded_macro_code[mid_method.value()];
-            const auto rebased_method = method - mid_method.value();
-            auto& code = uploaded_macro_code[method];
-            code.resize(macro_cached.size() - rebased_method);
-            std::memcpy(code.data(), macro_cached.data() + rebased_method,
-                        code.size() * sizeof(u32));
-            cache_info.hash = boost::hash_value(code);
-            cache_info.lle_program = Compile(code);
+            UNREACHABLE_MSG("Macro 0x{0:x} was not uploaded", method);
+            return nullptr;
         }
+    }
+    auto& cache_info = macro_cache[method];
+
+    if (!mid_method.has_value()) {
+        cache_info.hash = boost::hash_value(macro_code->second);
+        cache_info.lle_program = GetProgram(cache_info.hash, macro_code->second);
+    } else {
+        const auto& macro_cached = uploaded_macro_code[mid_method.value()];
+        const auto rebased_method = method - mid_method.value();
+        auto& code = uploaded_macro_code[method];
+        code.resize(macro_cached.size() - rebased_method);
+        std::memcpy(code.data(), macro_cached.data() + rebased_method,
+                    code.size() * sizeof(u32));
+        cache_info.hash = boost::hash_value(code);
+        cache_info.lle_program = GetProgram(cache_info.hash, code);
+    }
+
+    auto hle_program = hle_macros->GetHLEProgram(cache_info.hash);
+    if (hle_program.has_value()) {
+        cache_info.has_hle_program = true;
+        cache_info.hle_program = std::move(hle_program.value());
+    }
+    return &cache_info;
+}
+
+std::shared_ptr<CachedMacro> MacroEngine::GetProgram(u64 hash, const std::vector<u32>& code) {
+    // Games upload the same macros to several methods, reuse the program compiled for any of them
+    auto& entry = compiled_programs[hash];
+    if (entry.program && *entry.code == code) {
+        return entry.program;
+    }
+    entry.program = Compile(code);
+    entry.code = &code;
+    return entry.program;
+}
+
+void MacroEngine::ExecuteProfiled(Engines::Maxwell3D& maxwell3d, u32 method,
+                                  const std::vector<u32>& parameters, CacheInfo& cache_info) {
+    if (!profile_title_id) {
+        profile_title_id = maxwell3d.System().CurrentProcess()->GetTitleID();
+    }
+    const auto start = std::chrono::steady_clock::now();
+    if (cache_info.has_hle_program) {
+        cache_info.hle_program->Execute(parameters, method);
+    } else {
+        cache_info.lle_program->Execute(parameters, method);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
 
-        auto hle_program = hle_macros->GetHLEProgram(cache_info.hash);
-        if (hle_program.has_value()) {
-            cache_info.has_hle_program = true;
-            cache_info.hle_program = std::move(hle_program.value());
-            cache_info.hle_program->Execute(parameters, method);
-        } else {
-            cache_info.lle_program->Execute(parameters, method);
+    auto& info = profile[cache_info.hash];
+    if (info.executions == 0) {
+        info.has_hle_program = cache_info.has_hle_program;
+        info.code = uploaded_macro_code[method];
+    }
+    ++info.executions;
+    info.total_ns += static_cast<u64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+void MacroEngine::WriteProfile() const {
+    if (!profile_title_id || profile.empty()) {
+        return;
+    }
+    std::vector<std::pair<u64, const ProfileInfo*>> entries;
+    entries.reserve(profile.size());
+    for (const auto& [hash, info] : profile) {
+        entries.emplace_back(hash, &info);
+    }
+    std::ranges::sort(entries, [](const auto& lhs, const auto& rhs) {
+        return lhs.second->total_ns > rhs.second->total_ns;
+    });
+
+    std::string report = "hash,executions,total_us,average_ns,hle,code\n";
+    for (const auto& [hash, info] : entries) {
+        std::string code;
+        for (const u32 word : info->code) {
+            code += fmt::format("{:08X}", word);
         }
+        report += fmt::format("{:016X},{},{},{},{},{}\n", hash, info->executions,
+                              info->total_ns / 1000, info->total_ns / info->executions,
+                              info->has_hle_program ? 1 : 0, code);
+    }
+
+    const auto dir = Common::FS::GetYuzuPath(Common::FS::YuzuPath::DumpDir) / "macro_profile";
+    if (!Common::FS::CreateDirs(dir)) {
+        LOG_ERROR(HW_GPU, "Failed to create directory={}", Common::FS::PathToUTF8String(dir));
+        return;
+    }
+    const auto path = dir / fmt::format("{:016X}.csv", *profile_title_id);
+    if (Common::FS::WriteStringToFile(path, Common::FS::FileType::TextFile, report) !=
+        report.size()) {
+        LOG_ERROR(HW_GPU, "Failed to write macro profile to {}",
+                  Common::FS::PathToUTF8String(path));
+        return;
     }
+    LOG_INFO(HW_GPU, "Wrote profile of {} macros to {}", entries.size(),
+             Common::FS::PathToUTF8String(path));
 }
 
 std::unique_ptr<MacroEngine> GetMacroEngine(Engines::Maxwell3D& maxwell3d) {
@@ -83,6 +181,8 @@ std::unique_ptr<MacroEngine> GetMacroEngine(Engines::Maxwell3D& maxwell3d) {
     }
 #ifdef ARCHITECTURE_x86_64
     return std::make_unique<MacroJITx64>(maxwell3d);
+#elif defined(ARCHITECTURE_ARM64)
+    return std::make_unique<MacroJITArm64>(maxwell3d);
 #else
     return std::make_unique<MacroInterpreter>(maxwell3d);
 #endif
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 #include "common/bit_field.h"
@@ -126,15 +127,46 @@ protected:
 
 private:
     struct CacheInfo {
-        std::unique_ptr<CachedMacro> lle_program{};
+        std::shared_ptr<CachedMacro> lle_program{};
         std::unique_ptr<CachedMacro> hle_program{};
         u64 hash{};
         bool has_hle_program{};
     };
 
+    /// Execution statistics of all the macros sharing a hash
+    struct ProfileInfo {
+        u64 executions{};
+        u64 total_ns{};
+        bool has_hle_program{};
+        std::vector<u32> code;
+    };
+
+    /// Compiled program shared by all the methods with the same code
+    struct CompiledProgram {
+        std::shared_ptr<CachedMacro> program;
+        const std::vector<u32>* code{};
+    };
+
+    /// Returns the compiled macro for a method, compiling it on first use.
+    CacheInfo* GetCacheInfo(u32 method);
+
+    /// Returns the program for the given code, compiling it if no method has used it yet.
+    std::shared_ptr<CachedMacro> GetProgram(u64 hash, const std::vector<u32>& code);
+
+    void ExecuteProfiled(Engines::Maxwell3D& maxwell3d, u32 method,
+                         const std::vector<u32>& parameters, CacheInfo& cache_info);
+
+    /// Writes the macros sorted by total execution time to the dump directory.
+    void WriteProfile() const;
+
     std::unordered_map<u32, CacheInfo> macro_cache;
+    std::unordered_map<u64, CompiledProgram> compiled_programs;
     std::unordered_map<u32, std::vector<u32>> uploaded_macro_code;
     std::unique_ptr<HLEMacro> hle_macros;
+
+    bool is_profiling{};
+    std::optional<u64> profile_title_id;
+    std::unordered_map<u64, ProfileInfo> profile;
 };
 
 std::unique_ptr<MacroEngine> GetMacroEngine(Engines::Maxwell3D& maxwell3d);
@@ -0,0 +1,784 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "common/assert.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/macro/macro_jit_arm64.h"
+
+MICROPROFILE_DEFINE(MacroJitArm64Compile, "GPU", "Compile macro JIT", MP_RGB(173, 255, 47));
+MICROPROFILE_DEFINE(MacroJitArm64Execute, "GPU", "Execute macro JIT", MP_RGB(255, 255, 0));
+
+namespace Tegra {
+namespace {
+
+// Registers are referred to by their number, the width is given by the instruction emitted.
+constexpr u32 W0 = 0;
+constexpr u32 W1 = 1;
+constexpr u32 W2 = 2;
+constexpr u32 W3 = 3;
+constexpr u32 X0 = 0;
+constexpr u32 X1 = 1;
+constexpr u32 X16 = 16;
+constexpr u32 FP = 29;
+constexpr u32 LR = 30;
+constexpr u32 ZR = 31;
+constexpr u32 SP = 31;
+
+// Callee saved registers that live through the whole program
+constexpr u32 STATE = 19;
+constexpr u32 RESULT = 20;
+constexpr u32 PARAMETERS = 21;
+constexpr u32 METHOD_ADDRESS = 22;
+constexpr u32 REG_ARRAY = 23;
+
+/// Bytes pushed to the stack by the prologue, the stack pointer must stay 16 bytes aligned
+constexpr s32 FRAME_SIZE = 64;
+
+/// Condition code for "carry clear", inverted to test for "carry set" with CSINC
+constexpr u32 COND_CC = 3;
+
+/// Read-only executable copy of a compiled program.
+class ExecutableMemory {
+public:
+    explicit ExecutableMemory(std::span<const u32> program) : size{program.size_bytes()} {
+#ifdef _WIN32
+        base = VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+        ASSERT(base != nullptr);
+        std::memcpy(base, program.data(), size);
+        DWORD old_protect{};
+        ASSERT(VirtualProtect(base, size, PAGE_EXECUTE_READ, &old_protect));
+        FlushInstructionCache(GetCurrentProcess(), base, size);
+#else
+        base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE, -1, 0);
+        ASSERT(base != MAP_FAILED);
+        std::memcpy(base, program.data(), size);
+        ASSERT(mprotect(base, size, PROT_READ | PROT_EXEC) == 0);
+        char* const begin = static_cast<char*>(base);
+        __builtin___clear_cache(begin, begin + size);
+#endif
+    }
+
+    ~ExecutableMemory() {
+#ifdef _WIN32
+        VirtualFree(base, 0, MEM_RELEASE);
+#else
+        munmap(base, size);
+#endif
+    }
+
+    ExecutableMemory(const ExecutableMemory&) = delete;
+    ExecutableMemory& operator=(const ExecutableMemory&) = delete;
+
+    [[nodiscard]] const void* Pointer() const noexcept {
+        return base;
+    }
+
+private:
+    void* base{};
+    std::size_t size{};
+};
+
+class MacroJITArm64Impl final : public CachedMacro {
+public:
+    explicit MacroJITArm64Impl(Engines::Maxwell3D& maxwell3d_, const std::vector<u32>& code_);
+
+    void Execute(const std::vector<u32>& parameters, u32 method) override;
+
+private:
+    using Label = std::size_t;
+
+    struct JITState {
+        Engines::Maxwell3D* maxwell3d{};
+        std::array<u32, Macro::NUM_MACRO_REGISTERS> registers{};
+        u32 carry_flag{};
+    };
+    static_assert(offsetof(JITState, maxwell3d) == 0, "Maxwell3D is not at 0x0");
+    using ProgramType = void (*)(JITState*, const u32*);
+
+    struct Fixup {
+        std::size_t position;
+        Label label;
+        bool is_imm26;
+    };
+
+    void Optimizer_ScanFlags();
+
+    void Compile();
+    void Compile_NextInstruction();
+    void Compile_Instruction(Macro::Opcode opcode);
+    void Compile_DelaySlot();
+
+    void Compile_ALU(Macro::Opcode opcode);
+    void Compile_AddImmediate(Macro::Opcode opcode);
+    void Compile_ExtractInsert(Macro::Opcode opcode);
+    void Compile_ExtractShiftLeftImmediate(Macro::Opcode opcode);
+    void Compile_ExtractShiftLeftRegister(Macro::Opcode opcode);
+    void Compile_Read(Macro::Opcode opcode);
+    void Compile_Branch(Macro::Opcode opcode);
+
+    void Compile_FetchParameter(u32 dst);
+    /// Returns the host register holding a macro register, loading it into dst when needed.
+    u32 Compile_GetRegister(u32 index, u32 dst);
+    void Compile_SetRegister(u32 index, u32 src);
+    void Compile_RegisterPlusImmediate(u32 index, s32 immediate);
+    void Compile_LoadCarry();
+    void Compile_StoreCarry();
+    void Compile_ProcessResult(Macro::ResultOperation operation, u32 reg);
+    void Compile_Send(u32 value);
+
+    Macro::Opcode GetOpCode() const;
+
+    // AArch64 emitter
+    Label NewLabel();
+    void Bind(Label label);
+    void ResolveFixups();
+    void Emit(u32 instruction);
+
+    void B(Label label);
+    void CBZ(u32 rt, Label label);
+    void CBNZ(u32 rt, Label label);
+    void BLR(u32 rn);
+    void RET();
+
+    void MOV(u32 rd, u32 rm);
+    void MOV64(u32 rd, u32 rm);
+    void MOVImm(u32 rd, u32 value);
+    void MOVImm64(u32 rd, u64 value);
+    void ALU(u32 base, u32 rd, u32 rn, u32 rm);
+    void AddImmediate(u32 rd, u32 rn, s32 immediate);
+    void UBFX(u32 rd, u32 rn, u32 lsb, u32 width);
+    void UBFIZ(u32 rd, u32 rn, u32 lsb, u32 width);
+    void BFI(u32 rd, u32 rn, u32 lsb, u32 width);
+
+    void LDR(u32 rt, u32 rn, u32 offset);
+    void LDR64(u32 rt, u32 rn, u32 offset);
+    void STR(u32 rt, u32 rn, u32 offset);
+    void STR64(u32 rt, u32 rn, u32 offset);
+
+    struct OptimizerState {
+        bool can_skip_carry{};
+        bool skip_dummy_addimmediate{};
+    };
+    OptimizerState optimizer{};
+
+    std::vector<u32> buffer;
+    std::vector<std::optional<std::size_t>> label_positions;
+    std::vector<Fixup> fixups;
+    std::vector<Label> labels;
+    Label end_of_code{};
+
+    bool is_delay_slot{};
+    u32 pc{};
+
+    std::optional<ExecutableMemory> memory;
+    ProgramType program{nullptr};
+
+    const std::vector<u32>& code;
+    Engines::Maxwell3D& maxwell3d;
+};
+
+// Instruction encodings used by the emitter
+constexpr u32 ADD_W = 0x0B000000;
+constexpr u32 ADDS_W = 0x2B000000;
+constexpr u32 ADCS_W = 0x3A000000;
+constexpr u32 SUB_W = 0x4B000000;
+constexpr u32 SUBS_W = 0x6B000000;
+constexpr u32 SBCS_W = 0x7A000000;
+constexpr u32 AND_W = 0x0A000000;
+constexpr u32 BIC_W = 0x0A200000;
+constexpr u32 ORR_W = 0x2A000000;
+constexpr u32 ORN_W = 0x2A200000;
+constexpr u32 EOR_W = 0x4A000000;
+constexpr u32 LSLV_W = 0x1AC02000;
+constexpr u32 LSRV_W = 0x1AC02400;
+
+void Send(Engines::Maxwell3D* maxwell3d, Macro::MethodAddress method_address, u32 value) {
+    maxwell3d->CallMethodFromMME(method_address.address, value);
+}
+
+MacroJITArm64Impl::MacroJITArm64Impl(Engines::Maxwell3D& maxwell3d_,
+                                     const std::vector<u32>& code_)
+    : code{code_}, maxwell3d{maxwell3d_} {
+    Compile();
+}
+
+void MacroJITArm64Impl::Execute(const std::vector<u32>& parameters, u32 method) {
+    MICROPROFILE_SCOPE(MacroJitArm64Execute);
+    ASSERT_OR_EXECUTE(program != nullptr, { return; });
+    JITState state{};
+    state.maxwell3d = &maxwell3d;
+    program(&state, parameters.data());
+}
+
+void MacroJITArm64Impl::Compile_ALU(Macro::Opcode opcode) {
+    const u32 src_a = Compile_GetRegister(opcode.src_a, W0);
+    const u32 src_b = Compile_GetRegister(opcode.src_b, W1);
+
+    switch (opcode.alu_operation) {
+    case Macro::ALUOperation::Add:
+        if (optimizer.can_skip_carry) {
+            ALU(ADD_W, RESULT, src_a, src_b);
+        } else {
+            ALU(ADDS_W, RESULT, src_a, src_b);
+            Compile_StoreCarry();
+        }
+        break;
+    case Macro::ALUOperation::AddWithCarry:
+        Compile_LoadCarry();
+        ALU(ADCS_W, RESULT, src_a, src_b);
+        Compile_StoreCarry();
+        break;
+    case Macro::ALUOperation::Subtract:
+        // The macro carry flag is set when there is no borrow, like the AArch64 carry flag
+        if (optimizer.can_skip_carry) {
+            ALU(SUB_W, RESULT, src_a, src_b);
+        } else {
+            ALU(SUBS_W, RESULT, src_a, src_b);
+            Compile_StoreCarry();
+        }
+        break;
+    case Macro::ALUOperation::SubtractWithBorrow:
+        Compile_LoadCarry();
+        ALU(SBCS_W, RESULT, src_a, src_b);
+        Compile_StoreCarry();
+        break;
+    case Macro::ALUOperation::Xor:
+        ALU(EOR_W, RESULT, src_a, src_b);
+        break;
+    case Macro::ALUOperation::Or:
+        ALU(ORR_W, RESULT, src_a, src_b);
+        break;
+    case Macro::ALUOperation::And:
+        ALU(AND_W, RESULT, src_a, src_b);
+        break;
+    case Macro::ALUOperation::AndNot:
+        ALU(BIC_W, RESULT, src_a, src_b);
+        break;
+    case Macro::ALUOperation::Nand:
+        ALU(AND_W, RESULT, src_a, src_b);
+        ALU(ORN_W, RESULT, ZR, RESULT);
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Unimplemented ALU operation {}", opcode.alu_operation.Value());
+        break;
+    }
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_AddImmediate(Macro::Opcode opcode) {
+    if (optimizer.skip_dummy_addimmediate) {
+        // Games tend to use this as an exit instruction placeholder. It's to encode an instruction
+        // without doing anything. In our case we can just not emit anything.
+        if (opcode.result_operation == Macro::ResultOperation::Move && opcode.dst == 0) {
+            return;
+        }
+    }
+    Compile_RegisterPlusImmediate(opcode.src_a, opcode.immediate);
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_ExtractInsert(Macro::Opcode opcode) {
+    const u32 dst = Compile_GetRegister(opcode.src_a, RESULT);
+    if (dst != RESULT) {
+        MOV(RESULT, dst);
+    }
+    // A zero sized field leaves the destination untouched
+    const u32 size = opcode.bf_size;
+    if (size != 0) {
+        const u32 src = Compile_GetRegister(opcode.src_b, W1);
+        const u32 src_bit = opcode.bf_src_bit;
+        const u32 dst_bit = opcode.bf_dst_bit;
+        UBFX(W1, src, src_bit, std::min(size, 32 - src_bit));
+        BFI(RESULT, W1, dst_bit, std::min(size, 32 - dst_bit));
+    }
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_ExtractShiftLeftImmediate(Macro::Opcode opcode) {
+    const u32 shift = Compile_GetRegister(opcode.src_a, W0);
+    const u32 src = Compile_GetRegister(opcode.src_b, W1);
+
+    const u32 size = opcode.bf_size;
+    if (size == 0) {
+        MOV(RESULT, ZR);
+    } else {
+        const u32 dst_bit = opcode.bf_dst_bit;
+        ALU(LSRV_W, W1, src, shift);
+        UBFIZ(RESULT, W1, dst_bit, std::min(size, 32 - dst_bit));
+    }
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_ExtractShiftLeftRegister(Macro::Opcode opcode) {
+    const u32 shift = Compile_GetRegister(opcode.src_a, W0);
+    const u32 src = Compile_GetRegister(opcode.src_b, W1);
+
+    const u32 size = opcode.bf_size;
+    if (size == 0) {
+        MOV(RESULT, ZR);
+    } else {
+        const u32 src_bit = opcode.bf_src_bit;
+        UBFX(W1, src, src_bit, std::min(size, 32 - src_bit));
+        ALU(LSLV_W, RESULT, W1, shift);
+    }
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_Read(Macro::Opcode opcode) {
+    Compile_RegisterPlusImmediate(opcode.src_a, opcode.immediate);
+
+    // Equivalent to Engines::Maxwell3D::GetRegisterValue:
+    // LDR RESULT, [REG_ARRAY, RESULT, UXTW #2]
+    Emit(0xB8605800 | (RESULT << 16) | (REG_ARRAY << 5) | RESULT);
+
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITArm64Impl::Compile_Send(u32 value) {
+    MOV(W2, value);
+    MOV(W1, METHOD_ADDRESS);
+    LDR64(X0, STATE, static_cast<u32>(offsetof(JITState, maxwell3d)));
+    MOVImm64(X16, reinterpret_cast<u64>(&Send));
+    BLR(X16);
+
+    // Increment the method address by the method increment, preserving the increment
+    UBFX(W1, METHOD_ADDRESS, 12, 6);
+    ALU(ADD_W, W0, METHOD_ADDRESS, W1);
+    BFI(METHOD_ADDRESS, W0, 0, 12);
+}
+
+void MacroJITArm64Impl::Compile_Branch(Macro::Opcode opcode) {
+    ASSERT_MSG(!is_delay_slot, "Executing a branch in a delay slot is not valid");
+    if (is_delay_slot) {
+        return;
+    }
+    const s64 jump_address = static_cast<s64>(pc) + opcode.immediate;
+    const bool is_valid_target =
+        jump_address >= 0 && jump_address <= static_cast<s64>(code.size());
+    ASSERT_MSG(is_valid_target, "Macro branch target {} is out of bounds", jump_address);
+    const Label target =
+        is_valid_target ? labels[static_cast<std::size_t>(jump_address)] : end_of_code;
+
+    const u32 value = Compile_GetRegister(opcode.src_a, W0);
+    const Label not_taken = NewLabel();
+    switch (opcode.branch_condition) {
+    case Macro::BranchCondition::Zero:
+        CBNZ(value, not_taken);
+        break;
+    case Macro::BranchCondition::NotZero:
+        CBZ(value, not_taken);
+        break;
+    }
+    // Taken branches ignore the exit flag, and without the annul bit they execute the next
+    // instruction before jumping.
+    if (!opcode.branch_annul) {
+        Compile_DelaySlot();
+    }
+    B(target);
+    Bind(not_taken);
+}
+
+void MacroJITArm64Impl::Optimizer_ScanFlags() {
+    optimizer.can_skip_carry = true;
+    for (const u32 raw_op : code) {
+        Macro::Opcode op{};
+        op.raw = raw_op;
+
+        // Scan for any ALU operations which actually use the carry flag, if they don't exist in
+        // our current code we can skip emitting the carry flag handling operations
+        if (op.operation == Macro::Operation::ALU &&
+            (op.alu_operation == Macro::ALUOperation::AddWithCarry ||
+             op.alu_operation == Macro::ALUOperation::SubtractWithBorrow)) {
+            optimizer.can_skip_carry = false;
+        }
+    }
+}
+
+void MacroJITArm64Impl::Compile() {
+    MICROPROFILE_SCOPE(MacroJitArm64Compile);
+
+    // AddImmediate tends to be used as a NOP instruction, if we detect this we can
+    // completely skip the entire code path and no emit anything
+    optimizer.skip_dummy_addimmediate = true;
+
+    // Check to see if we can skip emitting certain instructions
+    Optimizer_ScanFlags();
+
+    // One label per instruction, plus one for the end of the code
+    const u32 op_count = static_cast<u32>(code.size());
+    labels.reserve(op_count + 1);
+    for (u32 i = 0; i <= op_count; ++i) {
+        labels.push_back(NewLabel());
+    }
+    end_of_code = labels.back();
+
+    // STP FP, LR, [SP, #-FRAME_SIZE]!
+    Emit(0xA9800000 | ((static_cast<u32>(-FRAME_SIZE / 8) & 0x7f) << 15) | (LR << 10) |
+         (SP << 5) | FP);
+    // MOV FP, SP
+    Emit(0x91000000 | (SP << 5) | FP);
+    // STP X19, X20, [SP, #16]; STP X21, X22, [SP, #32]; STR X23, [SP, #48]
+    Emit(0xA9000000 | (2 << 15) | (RESULT << 10) | (SP << 5) | STATE);
+    Emit(0xA9000000 | (4 << 15) | (METHOD_ADDRESS << 10) | (SP << 5) | PARAMETERS);
+    STR64(REG_ARRAY, SP, 48);
+
+    // JIT state
+    MOV64(STATE, X0);
+    MOV64(PARAMETERS, X1);
+    MOV(RESULT, ZR);
+    MOV(METHOD_ADDRESS, ZR);
+    MOVImm64(REG_ARRAY, reinterpret_cast<u64>(maxwell3d.regs.reg_array.data()));
+
+    Compile_FetchParameter(W0);
+    Compile_SetRegister(1, W0);
+
+    for (pc = 0; pc < op_count; ++pc) {
+        Bind(labels[pc]);
+        Compile_NextInstruction();
+    }
+
+    Bind(end_of_code);
+
+    // LDR X23, [SP, #48]; LDP X21, X22, [SP, #32]; LDP X19, X20, [SP, #16]
+    LDR64(REG_ARRAY, SP, 48);
+    Emit(0xA9400000 | (4 << 15) | (METHOD_ADDRESS << 10) | (SP << 5) | PARAMETERS);
+    Emit(0xA9400000 | (2 << 15) | (RESULT << 10) | (SP << 5) | STATE);
+    // LDP FP, LR, [SP], #FRAME_SIZE
+    Emit(0xA8C00000 | ((FRAME_SIZE / 8) << 15) | (LR << 10) | (SP << 5) | FP);
+    RET();
+
+    ResolveFixups();
+    memory.emplace(buffer);
+    program = reinterpret_cast<ProgramType>(memory->Pointer());
+
+    buffer = {};
+    fixups = {};
+}
+
+void MacroJITArm64Impl::Compile_NextInstruction() {
+    const auto opcode = GetOpCode();
+    Compile_Instruction(opcode);
+
+    // Exit has a delay slot, the next instruction runs before leaving. A taken branch has
+    // already jumped away, so only its fallthrough path reaches this.
+    if (opcode.is_exit) {
+        Compile_DelaySlot();
+        B(end_of_code);
+    }
+}
+
+void MacroJITArm64Impl::Compile_Instruction(Macro::Opcode opcode) {
+    switch (opcode.operation) {
+    case Macro::Operation::ALU:
+        Compile_ALU(opcode);
+        break;
+    case Macro::Operation::AddImmediate:
+        Compile_AddImmediate(opcode);
+        break;
+    case Macro::Operation::ExtractInsert:
+        Compile_ExtractInsert(opcode);
+        break;
+    case Macro::Operation::ExtractShiftLeftImmediate:
+        Compile_ExtractShiftLeftImmediate(opcode);
+        break;
+    case Macro::Operation::ExtractShiftLeftRegister:
+        Compile_ExtractShiftLeftRegister(opcode);
+        break;
+    case Macro::Operation::Read:
+        Compile_Read(opcode);
+        break;
+    case Macro::Operation::Branch:
+        Compile_Branch(opcode);
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Unimplemented opcode {}", opcode.operation.Value());
+        break;
+    }
+}
+
+void MacroJITArm64Impl::Compile_DelaySlot() {
+    // Delay slots are compiled inline in the path that executes them. An instruction with the
+    // exit flag does not exit when it runs inside a delay slot.
+    if (pc + 1 >= code.size()) {
+        return;
+    }
+    const u32 saved_pc = pc;
+    ++pc;
+    is_delay_slot = true;
+    Compile_Instruction(GetOpCode());
+    is_delay_slot = false;
+    pc = saved_pc;
+}
+
+void MacroJITArm64Impl::Compile_FetchParameter(u32 dst) {
+    // LDR dst, [PARAMETERS], #4
+    Emit(0xB8400400 | (sizeof(u32) << 12) | (PARAMETERS << 5) | dst);
+}
+
+u32 MacroJITArm64Impl::Compile_GetRegister(u32 index, u32 dst) {
+    if (index == 0) {
+        // Register 0 is always zero
+        return ZR;
+    }
+    LDR(dst, STATE, static_cast<u32>(offsetof(JITState, registers) + index * sizeof(u32)));
+    return dst;
+}
+
+void MacroJITArm64Impl::Compile_SetRegister(u32 index, u32 src) {
+    // Register 0 is supposed to always return 0. NOP is implemented as a store to the zero
+    // register.
+    if (index == 0) {
+        return;
+    }
+    STR(src, STATE, static_cast<u32>(offsetof(JITState, registers) + index * sizeof(u32)));
+}
+
+void MacroJITArm64Impl::Compile_RegisterPlusImmediate(u32 index, s32 immediate) {
+    if (index == 0) {
+        MOVImm(RESULT, static_cast<u32>(immediate));
+        return;
+    }
+    AddImmediate(RESULT, Compile_GetRegister(index, RESULT), immediate);
+}
+
+void MacroJITArm64Impl::Compile_LoadCarry() {
+    LDR(W2, STATE, static_cast<u32>(offsetof(JITState, carry_flag)));
+    // CMP W2, #1 sets the host carry flag when the stored flag is set
+    Emit(0x71000000 | (1 << 10) | (W2 << 5) | ZR);
+}
+
+void MacroJITArm64Impl::Compile_StoreCarry() {
+    // CSET W2, CS
+    Emit(0x1A800400 | (ZR << 16) | (COND_CC << 12) | (ZR << 5) | W2);
+    STR(W2, STATE, static_cast<u32>(offsetof(JITState, carry_flag)));
+}
+
+void MacroJITArm64Impl::Compile_ProcessResult(Macro::ResultOperation operation, u32 reg) {
+    const auto SetMethodAddress = [this] { MOV(METHOD_ADDRESS, RESULT); };
+
+    switch (operation) {
+    case Macro::ResultOperation::IgnoreAndFetch:
+        Compile_FetchParameter(W0);
+        Compile_SetRegister(reg, W0);
+        break;
+    case Macro::ResultOperation::Move:
+        Compile_SetRegister(reg, RESULT);
+        break;
+    case Macro::ResultOperation::MoveAndSetMethod:
+        Compile_SetRegister(reg, RESULT);
+        SetMethodAddress();
+        break;
+    case Macro::ResultOperation::FetchAndSend:
+        // Fetch parameter and send result.
+        Compile_FetchParameter(W0);
+        Compile_SetRegister(reg, W0);
+        Compile_Send(RESULT);
+        break;
+    case Macro::ResultOperation::MoveAndSend:
+        // Move and send result.
+        Compile_SetRegister(reg, RESULT);
+        Compile_Send(RESULT);
+        break;
+    case Macro::ResultOperation::FetchAndSetMethod:
+        // Fetch parameter and use result as Method Address.
+        Compile_FetchParameter(W0);
+        Compile_SetRegister(reg, W0);
+        SetMethodAddress();
+        break;
+    case Macro::ResultOperation::MoveAndSetMethodFetchAndSend:
+        // Move result and use as Method Address, then fetch and send parameter.
+        Compile_SetRegister(reg, RESULT);
+        SetMethodAddress();
+        Compile_FetchParameter(W0);
+        Compile_Send(W0);
+        break;
+    case Macro::ResultOperation::MoveAndSetMethodSend:
+        // Move result and use as Method Address, then send bits 12:17 of result.
+        Compile_SetRegister(reg, RESULT);
+        SetMethodAddress();
+        UBFX(W0, RESULT, 12, 6);
+        Compile_Send(W0);
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Unimplemented macro operation {}", operation);
+    }
+}
+
+Macro::Opcode MacroJITArm64Impl::GetOpCode() const {
+    ASSERT(pc < code.size());
+    return {code[pc]};
+}
+
+MacroJITArm64Impl::Label MacroJITArm64Impl::NewLabel() {
+    label_positions.emplace_back();
+    return label_positions.size() - 1;
+}
+
+void MacroJITArm64Impl::Bind(Label label) {
+    label_positions[label] = buffer.size();
+}
+
+void MacroJITArm64Impl::ResolveFixups() {
+    for (const Fixup& fixup : fixups) {
+        const std::optional<std::size_t> position = label_positions[fixup.label];
+        ASSERT(position.has_value());
+        const s64 offset = static_cast<s64>(*position) - static_cast<s64>(fixup.position);
+        if (fixup.is_imm26) {
+            buffer[fixup.position] |= static_cast<u32>(offset) & 0x3ffffff;
+        } else {
+            ASSERT(offset >= -(1 << 18) && offset < (1 << 18));
+            buffer[fixup.position] |= (static_cast<u32>(offset) & 0x7ffff) << 5;
+        }
+    }
+}
+
+void MacroJITArm64Impl::Emit(u32 instruction) {
+    buffer.push_back(instruction);
+}
+
+void MacroJITArm64Impl::B(Label label) {
+    fixups.push_back({buffer.size(), label, true});
+    Emit(0x14000000);
+}
+
+void MacroJITArm64Impl::CBZ(u32 rt, Label label) {
+    fixups.push_back({buffer.size(), label, false});
+    Emit(0x34000000 | rt);
+}
+
+void MacroJITArm64Impl::CBNZ(u32 rt, Label label) {
+    fixups.push_back({buffer.size(), label, false});
+    Emit(0x35000000 | rt);
+}
+
+void MacroJITArm64Impl::BLR(u32 rn) {
+    Emit(0xD63F0000 | (rn << 5));
+}
+
+void MacroJITArm64Impl::RET() {
+    Emit(0xD65F03C0);
+}
+
+void MacroJITArm64Impl::MOV(u32 rd, u32 rm) {
+    if (rd != rm) {
+        ALU(ORR_W, rd, ZR, rm);
+    }
+}
+
+void MacroJITArm64Impl::MOV64(u32 rd, u32 rm) {
+    // ORR Xd, XZR, Xm
+    Emit(0xAA000000 | (rm << 16) | (ZR << 5) | rd);
+}
+
+void MacroJITArm64Impl::MOVImm(u32 rd, u32 value) {
+    if ((~value >> 16) == 0) {
+        // MOVN Wd, #imm16
+        Emit(0x12800000 | ((~value & 0xffff) << 5) | rd);
+        return;
+    }
+    // MOVZ Wd, #imm16
+    Emit(0x52800000 | ((value & 0xffff) << 5) | rd);
+    if ((value >> 16) != 0) {
+        // MOVK Wd, #imm16, LSL #16
+        Emit(0x72800000 | (1 << 21) | ((value >> 16) << 5) | rd);
+    }
+}
+
+void MacroJITArm64Impl::MOVImm64(u32 rd, u64 value) {
+    // MOVZ Xd, #imm16
+    Emit(0xD2800000 | (static_cast<u32>(value & 0xffff) << 5) | rd);
+    for (u32 shift = 1; shift < 4; ++shift) {
+        const u32 part = static_cast<u32>(value >> (shift * 16)) & 0xffff;
+        if (part != 0) {
+            // MOVK Xd, #imm16, LSL #(shift * 16)
+            Emit(0xF2800000 | (shift << 21) | (part << 5) | rd);
+        }
+    }
+}
+
+void MacroJITArm64Impl::ALU(u32 base, u32 rd, u32 rn, u32 rm) {
+    Emit(base | (rm << 16) | (rn << 5) | rd);
+}
+
+void MacroJITArm64Impl::AddImmediate(u32 rd, u32 rn, s32 immediate) {
+    // rn must not be the zero register, register 31 is the stack pointer in these encodings
+    ASSERT(rn != ZR);
+    const u32 magnitude = static_cast<u32>(immediate < 0 ? -immediate : immediate);
+    if (magnitude == 0) {
+        MOV(rd, rn);
+    } else if (magnitude < (1U << 12)) {
+        // ADD Wd, Wn, #imm12 or SUB Wd, Wn, #imm12
+        const u32 base = immediate < 0 ? 0x51000000 : 0x11000000;
+        Emit(base | (magnitude << 10) | (rn << 5) | rd);
+    } else {
+        MOVImm(W3, static_cast<u32>(immediate));
+        ALU(ADD_W, rd, rn, W3);
+    }
+}
+
+void MacroJITArm64Impl::UBFX(u32 rd, u32 rn, u32 lsb, u32 width) {
+    // UBFM Wd, Wn, #lsb, #(lsb + width - 1)
+    Emit(0x53000000 | (lsb << 16) | ((lsb + width - 1) << 10) | (rn << 5) | rd);
+}
+
+void MacroJITArm64Impl::UBFIZ(u32 rd, u32 rn, u32 lsb, u32 width) {
+    // UBFM Wd, Wn, #((32 - lsb) % 32), #(width - 1)
+    Emit(0x53000000 | (((32 - lsb) % 32) << 16) | ((width - 1) << 10) | (rn << 5) | rd);
+}
+
+void MacroJITArm64Impl::BFI(u32 rd, u32 rn, u32 lsb, u32 width) {
+    // BFM Wd, Wn, #((32 - lsb) % 32), #(width - 1)
+    Emit(0x33000000 | (((32 - lsb) % 32) << 16) | ((width - 1) << 10) | (rn << 5) | rd);
+}
+
+void MacroJITArm64Impl::LDR(u32 rt, u32 rn, u32 offset) {
+    // LDR Wt, [Xn, #offset]
+    ASSERT(offset % sizeof(u32) == 0);
+    Emit(0xB9400000 | ((offset / 4) << 10) | (rn << 5) | rt);
+}
+
+void MacroJITArm64Impl::LDR64(u32 rt, u32 rn, u32 offset) {
+    // LDR Xt, [Xn, #offset]
+    ASSERT(offset % sizeof(u64) == 0);
+    Emit(0xF9400000 | ((offset / 8) << 10) | (rn << 5) | rt);
+}
+
+void MacroJITArm64Impl::STR(u32 rt, u32 rn, u32 offset) {
+    // STR Wt, [Xn, #offset]
+    ASSERT(offset % sizeof(u32) == 0);
+    Emit(0xB9000000 | ((offset / 4) << 10) | (rn << 5) | rt);
+}
+
+void MacroJITArm64Impl::STR64(u32 rt, u32 rn, u32 offset) {
+    // STR Xt, [Xn, #offset]
+    ASSERT(offset % sizeof(u64) == 0);
+    Emit(0xF9000000 | ((offset / 8) << 10) | (rn << 5) | rt);
+}
+
+} // Anonymous namespace
+
+MacroJITArm64::MacroJITArm64(Engines::Maxwell3D& maxwell3d_)
+    : MacroEngine{maxwell3d_}, maxwell3d{maxwell3d_} {}
+
+std::unique_ptr<CachedMacro> MacroJITArm64::Compile(const std::vector<u32>& code) {
+    return std::make_unique<MacroJITArm64Impl>(maxwell3d, code);
+}
+
+} // namespace Tegra
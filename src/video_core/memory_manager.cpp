@@ -2,6 +2,10 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <array>
+#include <iterator>
+
 #include "common/alignment.h"
 #include "common/assert.h"
 #include "common/logging/log.h"
@@ -10,14 +14,33 @@
 #include "core/hle/kernel/k_process.h"
 #include "core/memory.h"
 #include "video_core/gpu.h"
+#include "video_core/gpu_capture.h"
 #include "video_core/memory_manager.h"
 #include "video_core/rasterizer_interface.h"
 #include "video_core/renderer_base.h"
 
 namespace Tegra {
 
+namespace {
+constexpr std::size_t TRANSLATION_CACHE_SIZE = 256;
+
+// Each thread caches its own translations, so lookups never race with other readers.
+// Entries are tagged with their owner and the page table generations they were made in.
+thread_local std::array<MemoryManager::Translation, TRANSLATION_CACHE_SIZE> translation_cache{};
+
+// Page table generations are unique across all memory managers, so a manager created at the
+// address of a destroyed one never matches the entries the destroyed one left behind.
+std::atomic<u64> next_translation_generation{1};
+
+u64 NextTranslationGeneration() {
+    return next_translation_generation.fetch_add(1, std::memory_order_relaxed);
+}
+} // Anonymous namespace
+
 MemoryManager::MemoryManager(Core::System& system_)
-    : system{system_}, page_table(page_table_size) {}
+    : system{system_}, translation_generation{NextTranslationGeneration()} {
+    free_ranges.emplace(address_space_start_low, address_space_size);
+}
 
 MemoryManager::~MemoryManager() = default;
 
@@ -26,6 +49,14 @@ void MemoryManager::BindRasterizer(VideoCore::RasterizerInterface* rasterizer_)
 }
 
 GPUVAddr MemoryManager::UpdateRange(GPUVAddr gpu_addr, PageEntry page_entry, std::size_t size) {
+    const GPUVAddr range_begin = Common::AlignDown(gpu_addr, page_size);
+    const GPUVAddr range_end = range_begin + Common::AlignUp(size, page_size);
+    if (page_entry.IsUnmapped()) {
+        ReleaseFreeRange(range_begin, range_end);
+    } else {
+        ReserveFreeRange(range_begin, range_end);
+    }
+
     u64 remaining_size{size};
     for (u64 offset{}; offset < size; offset += page_size) {
         if (remaining_size < page_size) {
@@ -35,6 +66,7 @@ GPUVAddr MemoryManager::UpdateRange(GPUVAddr gpu_addr, PageEntry page_entry, std
         }
         remaining_size -= page_size;
     }
+    translation_generation.store(NextTranslationGeneration(), std::memory_order_release);
     return gpu_addr;
 }
 
@@ -45,6 +77,9 @@ GPUVAddr MemoryManager::Map(VAddr cpu_addr, GPUVAddr gpu_addr, std::size_t size)
     } else {
         map_ranges.insert(it, MapRange{gpu_addr, size});
     }
+    if (capture) {
+        capture->RecordMap(gpu_addr, cpu_addr, size);
+    }
     return UpdateRange(gpu_addr, cpu_addr, size);
 }
 
@@ -62,6 +97,9 @@ void MemoryManager::Unmap(GPUVAddr gpu_addr, std::size_t size) {
     if (size == 0) {
         return;
     }
+    if (capture) {
+        capture->RecordUnmap(gpu_addr, size);
+    }
     const auto it = std::ranges::lower_bound(map_ranges, gpu_addr, {}, &MapRange::first);
     if (it != map_ranges.end()) {
         ASSERT(it->first == gpu_addr);
@@ -120,7 +158,13 @@ void MemoryManager::TryUnlockPage(PageEntry page_entry, std::size_t size) {
 }
 
 PageEntry MemoryManager::GetPageEntry(GPUVAddr gpu_addr) const {
-    return page_table[PageEntryIndex(gpu_addr)];
+    const std::size_t index = PageEntryIndex(gpu_addr);
+    const PageLeaf* const leaf =
+        page_directory[index >> page_leaf_bits].load(std::memory_order_acquire);
+    if (!leaf) {
+        return PageEntry::State::Unmapped;
+    }
+    return (*leaf)[index & page_leaf_mask];
 }
 
 void MemoryManager::SetPageEntry(GPUVAddr gpu_addr, PageEntry page_entry, std::size_t size) {
@@ -132,7 +176,17 @@ void MemoryManager::SetPageEntry(GPUVAddr gpu_addr, PageEntry page_entry, std::s
 
     //// Lock the new page
     // TryLockPage(page_entry, size);
-    auto& current_page = page_table[PageEntryIndex(gpu_addr)];
+    const std::size_t index = PageEntryIndex(gpu_addr);
+    std::atomic<PageLeaf*>& directory_entry = page_directory[index >> page_leaf_bits];
+    PageLeaf* leaf = directory_entry.load(std::memory_order_relaxed);
+    if (!leaf) {
+        if (page_entry.IsUnmapped()) {
+            return;
+        }
+        leaf = page_leaves.emplace_back(std::make_unique<PageLeaf>()).get();
+        directory_entry.store(leaf, std::memory_order_release);
+    }
+    auto& current_page = (*leaf)[index & page_leaf_mask];
 
     if ((!current_page.IsValid() && page_entry.IsValid()) ||
         current_page.ToAddress() != page_entry.ToAddress()) {
@@ -150,39 +204,103 @@ std::optional<GPUVAddr> MemoryManager::FindFreeRange(std::size_t size, std::size
         align = Common::AlignUp(align, page_size);
     }
 
-    u64 available_size{};
-    GPUVAddr gpu_addr{start_32bit_address ? address_space_start_low : address_space_start};
-    while (gpu_addr + available_size < address_space_size) {
-        if (GetPageEntry(gpu_addr + available_size).IsUnmapped()) {
-            available_size += page_size;
-
-            if (available_size >= size) {
-                return gpu_addr;
-            }
-        } else {
-            gpu_addr += available_size + page_size;
-            available_size = 0;
+    // First fit on the free ranges, skipping the ones that end before the search begins
+    const GPUVAddr search_begin{start_32bit_address ? address_space_start_low
+                                                    : address_space_start};
+    const u64 aligned_size = Common::AlignUp(std::max<std::size_t>(size, 1), page_size);
+    auto it = free_ranges.upper_bound(search_begin);
+    if (it != free_ranges.begin()) {
+        --it;
+    }
+    for (; it != free_ranges.end(); ++it) {
+        const auto [begin, end] = *it;
+        const GPUVAddr gpu_addr = Common::AlignUp(std::max(begin, search_begin), align);
+        if (gpu_addr < end && end - gpu_addr >= aligned_size) {
+            return gpu_addr;
+        }
+    }
+    return std::nullopt;
+}
 
-            const auto remainder{gpu_addr % align};
-            if (remainder) {
-                gpu_addr = (gpu_addr - remainder) + align;
-            }
+void MemoryManager::ReserveFreeRange(GPUVAddr begin, GPUVAddr end) {
+    auto it = free_ranges.upper_bound(begin);
+    if (it != free_ranges.begin()) {
+        --it;
+    }
+    while (it != free_ranges.end() && it->first < end) {
+        const auto [free_begin, free_end] = *it;
+        if (free_end <= begin) {
+            ++it;
+            continue;
+        }
+        it = free_ranges.erase(it);
+        if (free_begin < begin) {
+            free_ranges.emplace(free_begin, begin);
+        }
+        if (free_end > end) {
+            free_ranges.emplace(end, free_end);
+            break;
         }
     }
+}
 
-    return std::nullopt;
+void MemoryManager::ReleaseFreeRange(GPUVAddr begin, GPUVAddr end) {
+    begin = std::max(begin, address_space_start_low);
+    end = std::min(end, address_space_size);
+    if (begin >= end) {
+        return;
+    }
+    // Absorb every range that overlaps or touches the released one
+    auto it = free_ranges.upper_bound(begin);
+    if (it != free_ranges.begin() && std::prev(it)->second >= begin) {
+        --it;
+    }
+    while (it != free_ranges.end() && it->first <= end) {
+        begin = std::min(begin, it->first);
+        end = std::max(end, it->second);
+        it = free_ranges.erase(it);
+    }
+    free_ranges.emplace(begin, end);
+}
+
+const MemoryManager::Translation* MemoryManager::Translate(GPUVAddr gpu_addr) const {
+    const GPUVAddr tag = gpu_addr >> Core::Memory::PAGE_BITS;
+    Translation& entry = translation_cache[tag % TRANSLATION_CACHE_SIZE];
+    const u64 generation = translation_generation.load(std::memory_order_acquire);
+    // Host pointers go stale when the CPU side of the mapping changes
+    const u64 cpu_generation = system.Memory().GetMappingGeneration();
+    if (entry.tag == tag && entry.owner == this && entry.generation == generation &&
+        entry.cpu_generation == cpu_generation) {
+        return &entry;
+    }
+    const auto page_entry{GetPageEntry(gpu_addr)};
+    if (!page_entry.IsValid()) {
+        return nullptr;
+    }
+    // GPU pages map to CPU page aligned addresses, so a CPU page sized block of GPU memory
+    // always lands in a single CPU page
+    const VAddr cpu_page =
+        page_entry.ToAddress() + (gpu_addr & page_mask & ~Core::Memory::PAGE_MASK);
+    entry = Translation{
+        .owner = this,
+        .generation = generation,
+        .cpu_generation = cpu_generation,
+        .tag = tag,
+        .cpu_page = cpu_page,
+        .host_page = system.Memory().GetPointer(cpu_page),
+    };
+    return &entry;
 }
 
 std::optional<VAddr> MemoryManager::GpuToCpuAddress(GPUVAddr gpu_addr) const {
     if (gpu_addr == 0) {
         return std::nullopt;
     }
-    const auto page_entry{GetPageEntry(gpu_addr)};
-    if (!page_entry.IsValid()) {
+    const Translation* const translation = Translate(gpu_addr);
+    if (!translation) {
         return std::nullopt;
     }
-
-    return page_entry.ToAddress() + (gpu_addr & page_mask);
+    return translation->cpu_page + (gpu_addr & Core::Memory::PAGE_MASK);
 }
 
 std::optional<VAddr> MemoryManager::GpuToCpuAddress(GPUVAddr addr, std::size_t size) const {
@@ -233,29 +351,25 @@ template void MemoryManager::Write<u32>(GPUVAddr addr, u32 data);
 template void MemoryManager::Write<u64>(GPUVAddr addr, u64 data);
 
 u8* MemoryManager::GetPointer(GPUVAddr gpu_addr) {
-    if (!GetPageEntry(gpu_addr).IsValid()) {
+    if (gpu_addr == 0) {
         return {};
     }
-
-    const auto address{GpuToCpuAddress(gpu_addr)};
-    if (!address) {
+    const Translation* const translation = Translate(gpu_addr);
+    if (!translation || !translation->host_page) {
         return {};
     }
-
-    return system.Memory().GetPointer(*address);
+    return translation->host_page + (gpu_addr & Core::Memory::PAGE_MASK);
 }
 
 const u8* MemoryManager::GetPointer(GPUVAddr gpu_addr) const {
-    if (!GetPageEntry(gpu_addr).IsValid()) {
+    if (gpu_addr == 0) {
         return {};
     }
-
-    const auto address{GpuToCpuAddress(gpu_addr)};
-    if (!address) {
+    const Translation* const translation = Translate(gpu_addr);
+    if (!translation || !translation->host_page) {
         return {};
     }
-
-    return system.Memory().GetPointer(*address);
+    return translation->host_page + (gpu_addr & Core::Memory::PAGE_MASK);
 }
 
 size_t MemoryManager::BytesToMapEnd(GPUVAddr gpu_addr) const noexcept {
@@ -418,7 +532,8 @@ bool MemoryManager::IsFullyMappedRange(GPUVAddr gpu_addr, std::size_t size) cons
     size_t page_index{gpu_addr >> page_bits};
     const size_t page_last{(gpu_addr + size + page_size - 1) >> page_bits};
     while (page_index < page_last) {
-        if (!page_table[page_index].IsValid() || page_table[page_index].ToAddress() == 0) {
+        const PageEntry page_entry = GetPageEntry(page_index << page_bits);
+        if (!page_entry.IsValid() || page_entry.ToAddress() == 0) {
             return false;
         }
         ++page_index;
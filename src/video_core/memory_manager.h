@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <map>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -20,6 +23,8 @@ class System;
 
 namespace Tegra {
 
+class GPUCapture;
+
 class PageEntry final {
 public:
     enum class State : u32 {
@@ -74,6 +79,11 @@ public:
     /// Binds a renderer to the memory manager.
     void BindRasterizer(VideoCore::RasterizerInterface* rasterizer);
 
+    /// Records map and unmap operations into the given capture.
+    void BindCapture(GPUCapture* capture_) {
+        capture = capture_;
+    }
+
     [[nodiscard]] std::optional<VAddr> GpuToCpuAddress(GPUVAddr addr) const;
 
     [[nodiscard]] std::optional<VAddr> GpuToCpuAddress(GPUVAddr addr, std::size_t size) const;
@@ -143,13 +153,32 @@ public:
     [[nodiscard]] GPUVAddr Allocate(std::size_t size, std::size_t align);
     void Unmap(GPUVAddr gpu_addr, std::size_t size);
 
+    /// Translation of a CPU page sized block of GPU memory, cached by the translation cache
+    struct Translation {
+        const MemoryManager* owner;
+        u64 generation;
+        u64 cpu_generation;
+        GPUVAddr tag;
+        VAddr cpu_page;
+        u8* host_page;
+    };
+
 private:
+    /// Returns the translation of the block holding a GPU address, or null when it's unmapped.
+    [[nodiscard]] const Translation* Translate(GPUVAddr gpu_addr) const;
+
     [[nodiscard]] PageEntry GetPageEntry(GPUVAddr gpu_addr) const;
     void SetPageEntry(GPUVAddr gpu_addr, PageEntry page_entry, std::size_t size = page_size);
     GPUVAddr UpdateRange(GPUVAddr gpu_addr, PageEntry page_entry, std::size_t size);
     [[nodiscard]] std::optional<GPUVAddr> FindFreeRange(std::size_t size, std::size_t align,
                                                         bool start_32bit_address = false) const;
 
+    /// Removes the pages in [begin, end) from the free ranges.
+    void ReserveFreeRange(GPUVAddr begin, GPUVAddr end);
+
+    /// Adds the pages in [begin, end) to the free ranges, merging them with their neighbours.
+    void ReleaseFreeRange(GPUVAddr begin, GPUVAddr end);
+
     void TryLockPage(PageEntry page_entry, std::size_t size);
     void TryUnlockPage(PageEntry page_entry, std::size_t size);
 
@@ -168,12 +197,31 @@ private:
     static constexpr u64 page_table_bits{24};
     static constexpr u64 page_table_size{1 << page_table_bits};
     static constexpr u64 page_table_mask{page_table_size - 1};
+    static constexpr u64 page_directory_bits{12};
+    static constexpr u64 page_directory_size{1 << page_directory_bits};
+    static constexpr u64 page_leaf_bits{page_table_bits - page_directory_bits};
+    static constexpr u64 page_leaf_size{1 << page_leaf_bits};
+    static constexpr u64 page_leaf_mask{page_leaf_size - 1};
+
+    /// Entries of a contiguous range of pages, only allocated once one of them is set
+    using PageLeaf = std::array<PageEntry, page_leaf_size>;
 
     Core::System& system;
 
     VideoCore::RasterizerInterface* rasterizer = nullptr;
+    GPUCapture* capture = nullptr;
+
+    /// First level of the page table, a null leaf means all of its pages are unmapped.
+    /// Leaves are published atomically and never freed, so readers don't need a lock.
+    std::array<std::atomic<PageLeaf*>, page_directory_size> page_directory{};
+    std::vector<std::unique_ptr<PageLeaf>> page_leaves;
+
+    /// Unmapped ranges of the address space indexed by their beginning, with their end
+    std::map<GPUVAddr, GPUVAddr> free_ranges;
 
-    std::vector<PageEntry> page_table;
+    /// Replaced by a process-unique value whenever the page table changes, invalidating all
+    /// cached translations
+    std::atomic<u64> translation_generation;
 
     using MapRange = std::pair<GPUVAddr, size_t>;
     std::vector<MapRange> map_ranges;
@@ -136,6 +136,57 @@ public:
         }
     }
 
+    /// Returns true when reading the specified region would wait for a host query result.
+    bool IsRegionPending(GPUVAddr gpu_addr, std::size_t size) {
+        std::unique_lock lock{mutex};
+        const std::optional<VAddr> cpu_addr = gpu_memory.GpuToCpuAddress(gpu_addr);
+        if (!cpu_addr) {
+            return false;
+        }
+        const u64 addr_begin = *cpu_addr;
+        const u64 addr_end = addr_begin + size;
+        const u64 page_end = addr_end >> PAGE_BITS;
+        for (u64 page = addr_begin >> PAGE_BITS; page <= page_end; ++page) {
+            const auto it = cached_queries.find(page);
+            if (it == std::end(cached_queries)) {
+                continue;
+            }
+            for (const CachedQuery& query : it->second) {
+                const u64 cache_begin = query.GetCpuAddr();
+                const u64 cache_end = cache_begin + query.SizeInBytes();
+                if (cache_begin < addr_end && addr_begin < cache_end && query.IsPending()) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Returns the host counter whose value is the difference between two cached queries, or
+     * nullptr when there's no such counter. Used to evaluate query compare conditions on the host.
+     * @param initial_addr GPU address of the query sampled first.
+     * @param current_addr GPU address of the query sampled last.
+     */
+    std::shared_ptr<HostCounter> DifferenceCounter(GPUVAddr initial_addr, GPUVAddr current_addr) {
+        std::unique_lock lock{mutex};
+        const std::optional<VAddr> initial_cpu_addr = gpu_memory.GpuToCpuAddress(initial_addr);
+        const std::optional<VAddr> current_cpu_addr = gpu_memory.GpuToCpuAddress(current_addr);
+        if (!initial_cpu_addr || !current_cpu_addr) {
+            return nullptr;
+        }
+        const CachedQuery* const initial = TryGet(*initial_cpu_addr);
+        const CachedQuery* const current = TryGet(*current_cpu_addr);
+        if (!initial || !current) {
+            return nullptr;
+        }
+        const std::shared_ptr<HostCounter>& counter = current->Counter();
+        if (!counter || !counter->DependsOnlyOn(initial->Counter().get())) {
+            return nullptr;
+        }
+        return counter;
+    }
+
     /// Updates counters from GPU state. Expected to be called once per draw, clear or dispatch.
     void UpdateCounters() {
         std::unique_lock lock{mutex};
@@ -315,6 +366,22 @@ public:
         return result.has_value();
     }
 
+    /// Returns true when the value of this counter is its own host query added to the passed one.
+    bool DependsOnlyOn(const HostCounter* counter) const noexcept {
+        return !result && base_result == 0 && dependency.get() == counter;
+    }
+
+    /// Returns true when the value of the query can be read without waiting for the host GPU.
+    bool IsReady() const {
+        if (result) {
+            return true;
+        }
+        if (dependency && !dependency->IsReady()) {
+            return false;
+        }
+        return IsHostReady();
+    }
+
     u64 Depth() const noexcept {
         return depth;
     }
@@ -323,6 +390,9 @@ protected:
     /// Returns the value of query from the backend API blocking as needed.
     virtual u64 BlockingQuery() const = 0;
 
+    /// Returns true when the backend API has the value of the query available.
+    virtual bool IsHostReady() const = 0;
+
 private:
     std::shared_ptr<HostCounter> dependency; ///< Counter to add to this value.
     std::optional<u64> result;               ///< Filled with the already returned value.
@@ -378,6 +448,16 @@ public:
         return with_timestamp ? LARGE_QUERY_SIZE : SMALL_QUERY_SIZE;
     }
 
+    /// Returns the host counter bound to this query, nullptr when it has been reset.
+    const std::shared_ptr<HostCounter>& Counter() const noexcept {
+        return counter;
+    }
+
+    /// Returns true when flushing the query has to wait for the host GPU.
+    bool IsPending() const {
+        return counter && !counter->IsReady();
+    }
+
 protected:
     /// Returns true when querying the counter may potentially block.
     bool WaitPending() const noexcept {
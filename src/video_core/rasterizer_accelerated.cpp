@@ -37,11 +37,13 @@ void RasterizerAccelerated::UpdatePagesCachedCount(VAddr addr, u64 size, int del
             ASSERT_MSG(false, "Delta must be non-zero!");
         }
 
-        // Adds or subtracts 1, as count is a unsigned 8-bit value
-        count.fetch_add(static_cast<u16>(delta), std::memory_order_release);
+        // Adds or subtracts 1, as count is a unsigned 16-bit value. The result of the addition is
+        // used directly so concurrent updates on the same page are not observed mid-way.
+        const u16 new_count = static_cast<u16>(
+            count.fetch_add(static_cast<u16>(delta), std::memory_order_release) + delta);
 
         // Assume delta is either -1 or 1
-        if (count.load(std::memory_order::relaxed) == 0) {
+        if (new_count == 0) {
             if (uncache_bytes == 0) {
                 uncache_begin = page;
             }
@@ -50,7 +52,7 @@ void RasterizerAccelerated::UpdatePagesCachedCount(VAddr addr, u64 size, int del
             cpu_memory.RasterizerMarkRegionCached(uncache_begin << PAGE_BITS, uncache_bytes, false);
             uncache_bytes = 0;
         }
-        if (count.load(std::memory_order::relaxed) == 1 && delta > 0) {
+        if (new_count == 1 && delta > 0) {
             if (cache_bytes == 0) {
                 cache_begin = page;
             }
@@ -34,6 +34,16 @@ enum class LoadCallbackStage {
 };
 using DiskResourceLoadCallback = std::function<void(LoadCallbackStage, std::size_t, std::size_t)>;
 
+/// Host memory held by the caches of a rasterizer, in bytes
+struct RasterizerMemoryUsage {
+    /// Host images of the texture cache, including their rescaled copies
+    u64 texture_cache;
+    /// Host buffers of the buffer cache
+    u64 buffer_cache;
+    /// Buffers used to stage uploads to and downloads from the host GPU
+    u64 staging_buffers;
+};
+
 class RasterizerInterface {
 public:
     virtual ~RasterizerInterface() = default;
@@ -53,6 +63,17 @@ public:
     /// Records a GPU query and caches it
     virtual void Query(GPUVAddr gpu_addr, QueryType type, std::optional<u64> timestamp) = 0;
 
+    /// Check if reading the specified memory area would wait for a pending query result
+    virtual bool IsQueryPending(GPUVAddr gpu_addr, u64 size) = 0;
+
+    /// Attempt to evaluate a query compare condition on the host GPU, returns true on success
+    [[nodiscard]] virtual bool AccelerateConditionalRendering(GPUVAddr compare_addr, bool equal) {
+        return false;
+    }
+
+    /// Stop evaluating a query compare condition on the host GPU
+    virtual void DisableConditionalRendering() {}
+
     /// Signal an uniform buffer binding
     virtual void BindGraphicsUniformBuffer(size_t stage, u32 index, GPUVAddr gpu_addr,
                                            u32 size) = 0;
@@ -60,6 +81,9 @@ public:
     /// Signal disabling of a uniform buffer
     virtual void DisableGraphicsUniformBuffer(size_t stage, u32 index) = 0;
 
+    /// Signal that a graphics shader program has been bound, so it can be prepared before drawing
+    virtual void PrepareGraphicsShader(size_t program) {}
+
     /// Signal a GPU based semaphore as a fence
     virtual void SignalSemaphore(GPUVAddr addr, u32 value) = 0;
 
@@ -133,6 +157,11 @@ public:
     /// Increase/decrease the number of object in pages touching the specified region
     virtual void UpdatePagesCachedCount(VAddr addr, u64 size, int delta) {}
 
+    /// Returns the host memory held by the caches, can be called from any thread
+    [[nodiscard]] virtual RasterizerMemoryUsage GetMemoryUsage() const {
+        return {};
+    }
+
     /// Initialize disk cached resources for the game being emulated
     virtual void LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                                    const DiskResourceLoadCallback& callback) {}
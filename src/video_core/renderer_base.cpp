@@ -25,7 +25,7 @@ void RendererBase::RefreshBaseSettings() {
 }
 
 void RendererBase::UpdateCurrentFramebufferLayout() {
-    const Layout::FramebufferLayout& layout = render_window.GetFramebufferLayout();
+    const Layout::FramebufferLayout layout = render_window.GetFramebufferLayout();
 
     render_window.UpdateCurrentFramebufferLayout(layout.width, layout.height);
 }
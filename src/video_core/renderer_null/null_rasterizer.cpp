@@ -0,0 +1,110 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "common/swap.h"
+#include "video_core/gpu.h"
+#include "video_core/memory_manager.h"
+#include "video_core/renderer_null/null_rasterizer.h"
+
+namespace Null {
+
+bool AccelerateDMA::BufferCopy(GPUVAddr src_address, GPUVAddr dest_address, u64 amount) {
+    // Let the DMA engine copy guest memory itself
+    return false;
+}
+
+RasterizerNull::RasterizerNull(Tegra::GPU& gpu_) : gpu{gpu_}, gpu_memory{gpu.MemoryManager()} {}
+
+RasterizerNull::~RasterizerNull() = default;
+
+void RasterizerNull::Draw(bool is_indexed, bool is_instanced) {}
+
+void RasterizerNull::Clear() {}
+
+void RasterizerNull::DispatchCompute(GPUVAddr code_addr) {}
+
+void RasterizerNull::ResetCounter(VideoCore::QueryType type) {}
+
+void RasterizerNull::Query(GPUVAddr gpu_addr, VideoCore::QueryType type,
+                           std::optional<u64> timestamp) {
+    // Nothing is rendered, so no samples ever pass
+    if (!timestamp) {
+        gpu_memory.Write<u32>(gpu_addr, 0);
+        return;
+    }
+    struct LongQueryResult {
+        u64_le value;
+        u64_le timestamp;
+    };
+    static_assert(sizeof(LongQueryResult) == 16, "LongQueryResult has wrong size");
+    const LongQueryResult result{
+        .value = 0,
+        .timestamp = *timestamp,
+    };
+    gpu_memory.WriteBlock(gpu_addr, &result, sizeof(result));
+}
+
+bool RasterizerNull::IsQueryPending(GPUVAddr gpu_addr, u64 size) {
+    return false;
+}
+
+void RasterizerNull::BindGraphicsUniformBuffer(size_t stage, u32 index, GPUVAddr gpu_addr,
+                                               u32 size) {}
+
+void RasterizerNull::DisableGraphicsUniformBuffer(size_t stage, u32 index) {}
+
+void RasterizerNull::SignalSemaphore(GPUVAddr addr, u32 value) {
+    gpu_memory.Write<u32>(addr, value);
+}
+
+void RasterizerNull::SignalSyncPoint(u32 value) {
+    gpu.IncrementSyncPoint(value);
+}
+
+void RasterizerNull::SignalReference() {}
+
+void RasterizerNull::ReleaseFences() {}
+
+void RasterizerNull::FlushAll() {}
+
+void RasterizerNull::FlushRegion(VAddr addr, u64 size) {}
+
+bool RasterizerNull::MustFlushRegion(VAddr addr, u64 size) {
+    return false;
+}
+
+void RasterizerNull::InvalidateRegion(VAddr addr, u64 size) {}
+
+void RasterizerNull::OnCPUWrite(VAddr addr, u64 size) {}
+
+void RasterizerNull::SyncGuestHost() {}
+
+void RasterizerNull::UnmapMemory(VAddr addr, u64 size) {}
+
+void RasterizerNull::ModifyGPUMemory(GPUVAddr addr, u64 size) {}
+
+void RasterizerNull::FlushAndInvalidateRegion(VAddr addr, u64 size) {}
+
+void RasterizerNull::WaitForIdle() {}
+
+void RasterizerNull::FragmentBarrier() {}
+
+void RasterizerNull::TiledCacheBarrier() {}
+
+void RasterizerNull::FlushCommands() {}
+
+void RasterizerNull::TickFrame() {}
+
+bool RasterizerNull::AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Surface& src,
+                                           const Tegra::Engines::Fermi2D::Surface& dst,
+                                           const Tegra::Engines::Fermi2D::Config& copy_config) {
+    // Surfaces only live on the host, there is nothing to copy
+    return true;
+}
+
+Tegra::Engines::AccelerateDMAInterface& RasterizerNull::AccessAccelerateDMA() {
+    return accelerate_dma;
+}
+
+} // namespace Null
@@ -46,9 +46,18 @@ private:
     GLenum current_residency_access = GL_NONE;
 };
 
+struct StagingBufferRef {
+    GLuint buffer;
+    size_t offset;
+    std::span<u8> mapped_span;
+};
+
 class BufferCacheRuntime {
     friend Buffer;
 
+    /// Largest upload written through the stream buffer, bigger uploads are sent immediately.
+    static constexpr u64 MAX_STREAMED_UPLOAD_SIZE = 1_MiB;
+
 public:
     static constexpr u8 INVALID_BINDING = std::numeric_limits<u8>::max();
 
@@ -57,6 +66,22 @@ public:
     void CopyBuffer(Buffer& dst_buffer, Buffer& src_buffer,
                     std::span<const VideoCommon::BufferCopy> copies);
 
+    void CopyBuffer(Buffer& dst_buffer, GLuint src_buffer,
+                    std::span<const VideoCommon::BufferCopy> copies);
+
+    [[nodiscard]] bool CanStreamUpload(u64 size) const noexcept {
+        return stream_buffer.has_value() && size <= MAX_STREAMED_UPLOAD_SIZE;
+    }
+
+    [[nodiscard]] StagingBufferRef UploadStagingBuffer(size_t size) noexcept {
+        const auto [mapped_span, offset] = stream_buffer->Request(size);
+        return StagingBufferRef{
+            .buffer = stream_buffer->Handle(),
+            .offset = offset,
+            .mapped_span = mapped_span,
+        };
+    }
+
     void BindIndexBuffer(Buffer& buffer, u32 offset, u32 size);
 
     void BindVertexBuffer(u32 index, Buffer& buffer, u32 offset, u32 size, u32 stride);
@@ -147,6 +172,7 @@ private:
 struct BufferCacheParams {
     using Runtime = OpenGL::BufferCacheRuntime;
     using Buffer = OpenGL::Buffer;
+    using AsyncBuffer = u32;
 
     static constexpr bool IS_OPENGL = true;
     static constexpr bool HAS_PERSISTENT_UNIFORM_BUFFER_BINDINGS = true;
@@ -154,6 +180,9 @@ struct BufferCacheParams {
     static constexpr bool NEEDS_BIND_UNIFORM_INDEX = true;
     static constexpr bool NEEDS_BIND_STORAGE_INDEX = true;
     static constexpr bool USE_MEMORY_MAPS = false;
+    static constexpr bool IMPLEMENTS_ASYNC_DOWNLOADS = false;
+    static constexpr bool HAS_STREAMED_UPLOADS = true;
+    static constexpr bool HAS_STREAMED_BINDINGS = false;
 };
 
 using BufferCache = VideoCommon::BufferCache<BufferCacheParams>;
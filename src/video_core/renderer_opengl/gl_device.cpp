@@ -98,7 +98,8 @@ std::array<u32, Tegra::Engines::MaxShaderTypes> BuildMaxUniformBuffers() noexcep
     return max;
 }
 
-std::array<Device::BaseBindings, Tegra::Engines::MaxShaderTypes> BuildBaseBindings() noexcept {
+std::array<Device::BaseBindings, Tegra::Engines::MaxShaderTypes> BuildBaseBindings(
+    bool use_bindless_textures) noexcept {
     std::array<Device::BaseBindings, Tegra::Engines::MaxShaderTypes> bindings;
 
     static constexpr std::array<std::size_t, 5> stage_swizzle{0, 1, 2, 3, 4};
@@ -107,6 +108,10 @@ std::array<Device::BaseBindings, Tegra::Engines::MaxShaderTypes> BuildBaseBindin
     const u32 total_samplers = GetInteger<u32>(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS);
 
     u32 num_ubos = total_ubos - ReservedUniformBlocks;
+    if (use_bindless_textures) {
+        // Bindless handles of each stage, including compute, live at the end of the bindings
+        num_ubos -= static_cast<u32>(Tegra::Engines::MaxShaderTypes);
+    }
     u32 num_ssbos = total_ssbos;
     u32 num_samplers = total_samplers;
 
@@ -151,6 +156,12 @@ std::array<Device::BaseBindings, Tegra::Engines::MaxShaderTypes> BuildBaseBindin
     // Compute doesn't care about any of this.
     bindings[5] = {0, 0, 0, 0};
 
+    if (use_bindless_textures) {
+        for (std::size_t stage = 0; stage < Tegra::Engines::MaxShaderTypes; ++stage) {
+            bindings[stage].bindless_handles = total_ubos - 1 - static_cast<u32>(stage);
+        }
+    }
+
     return bindings;
 }
 
@@ -225,7 +236,6 @@ Device::Device() {
     }
 
     max_uniform_buffers = BuildMaxUniformBuffers();
-    base_bindings = BuildBaseBindings();
     uniform_buffer_alignment = GetInteger<size_t>(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT);
     shader_storage_alignment = GetInteger<size_t>(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT);
     max_vertex_attributes = GetInteger<u32>(GL_MAX_VERTEX_ATTRIBS);
@@ -255,10 +265,31 @@ Device::Device() {
                            GLAD_GL_NV_gpu_program5 && GLAD_GL_NV_compute_program5 &&
                            GLAD_GL_NV_transform_feedback && GLAD_GL_NV_transform_feedback2;
 
+    // The driver compiles GLSL on its own threads, shared contexts are only needed without it
+    use_parallel_shader_compile =
+        Settings::values.use_asynchronous_shaders.GetValue() && !use_assembly_shaders &&
+        (GLAD_GL_KHR_parallel_shader_compile || GLAD_GL_ARB_parallel_shader_compile);
+
     // Blocks AMD and Intel OpenGL drivers on Windows from using asynchronous shader compilation.
     use_asynchronous_shaders = Settings::values.use_asynchronous_shaders.GetValue() &&
-                               !(is_amd || (is_intel && !is_linux));
+                               !use_parallel_shader_compile && !(is_amd || (is_intel && !is_linux));
+    // Variants are built asynchronously while the generic shader is drawn with
+    use_shader_specialization = Settings::values.use_shader_specialization.GetValue() &&
+                                (use_asynchronous_shaders || use_parallel_shader_compile);
+    // Other vendors expose the extension with too many issues to be worth it
+    use_bindless_textures = Settings::values.use_bindless_textures.GetValue() &&
+                            GLAD_GL_ARB_bindless_texture && (is_nvidia || is_amd) &&
+                            !use_assembly_shaders;
+    base_bindings = BuildBaseBindings(use_bindless_textures);
+    use_draw_batching = Settings::values.use_draw_batching.GetValue();
     use_driver_cache = is_nvidia;
+    use_astc_transcoding = Settings::values.transcode_astc.GetValue() && !has_astc;
+
+    if (GLAD_GL_NVX_gpu_memory_info) {
+        // The reported size is in kilobytes
+        device_access_memory =
+            static_cast<u64>(GetInteger<u32>(GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX)) * 1024;
+    }
 
     LOG_INFO(Render_OpenGL, "Renderer_VariableAOFFI: {}", has_variable_aoffi);
     LOG_INFO(Render_OpenGL, "Renderer_ComponentIndexingBug: {}", has_component_indexing_bug);
@@ -270,7 +301,8 @@ Device::Device() {
         LOG_ERROR(Render_OpenGL, "Assembly shaders enabled but not supported");
     }
 
-    if (Settings::values.use_asynchronous_shaders.GetValue() && !use_asynchronous_shaders) {
+    if (Settings::values.use_asynchronous_shaders.GetValue() && !use_asynchronous_shaders &&
+        !use_parallel_shader_compile) {
         LOG_WARNING(Render_OpenGL, "Asynchronous shader compilation enabled but not supported");
     }
 }
@@ -17,6 +17,7 @@ public:
         u32 shader_storage_buffer{};
         u32 sampler{};
         u32 image{};
+        u32 bindless_handles{};
     };
 
     explicit Device();
@@ -120,10 +121,35 @@ public:
         return use_asynchronous_shaders;
     }
 
+    bool UseParallelShaderCompile() const {
+        return use_parallel_shader_compile;
+    }
+
+    bool UseShaderSpecialization() const {
+        return use_shader_specialization;
+    }
+
+    bool UseBindlessTextures() const {
+        return use_bindless_textures;
+    }
+
+    bool UseDrawBatching() const {
+        return use_draw_batching;
+    }
+
     bool UseDriverCache() const {
         return use_driver_cache;
     }
 
+    bool UseAstcTranscoding() const {
+        return use_astc_transcoding;
+    }
+
+    /// Returns the size of dedicated video memory in bytes, or zero when it can't be queried.
+    u64 GetDeviceLocalMemory() const {
+        return device_access_memory;
+    }
+
     bool HasDepthBufferFloat() const {
         return has_depth_buffer_float;
     }
@@ -140,6 +166,7 @@ private:
     u32 max_vertex_attributes{};
     u32 max_varyings{};
     u32 max_compute_shared_memory_size{};
+    u64 device_access_memory{};
     bool has_warp_intrinsics{};
     bool has_shader_ballot{};
     bool has_vertex_viewport_layer{};
@@ -156,7 +183,12 @@ private:
     bool has_debugging_tool_attached{};
     bool use_assembly_shaders{};
     bool use_asynchronous_shaders{};
+    bool use_parallel_shader_compile{};
+    bool use_shader_specialization{};
+    bool use_bindless_textures{};
+    bool use_draw_batching{};
     bool use_driver_cache{};
+    bool use_astc_transcoding{};
     bool has_depth_buffer_float{};
 };
 
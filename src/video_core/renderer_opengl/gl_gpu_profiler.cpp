@@ -0,0 +1,122 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <utility>
+
+#include <glad/glad.h>
+
+#include "common/assert.h"
+#include "common/trace_recorder.h"
+#include "video_core/renderer_opengl/gl_gpu_profiler.h"
+
+namespace OpenGL {
+
+GPUProfiler::GPUProfiler() = default;
+
+GPUProfiler::~GPUProfiler() = default;
+
+bool GPUProfiler::IsEnabled() const noexcept {
+    return Common::TraceRecorder::IsRecording();
+}
+
+void GPUProfiler::BindFramebuffer(GLuint framebuffer, const std::string& label) {
+    if (renderpass_scope != 0 && renderpass_framebuffer == framebuffer) {
+        return;
+    }
+    EndRenderPass();
+    if (!IsEnabled()) {
+        return;
+    }
+    renderpass_framebuffer = framebuffer;
+    renderpass_scope = Begin(label, RENDER_PASS_TRACK);
+}
+
+void GPUProfiler::EndRenderPass() {
+    if (renderpass_scope == 0) {
+        return;
+    }
+    End(renderpass_scope);
+    renderpass_framebuffer = 0;
+    renderpass_scope = 0;
+}
+
+void GPUProfiler::BeginScope(std::string_view label) {
+    open_scopes.push_back(IsEnabled() ? Begin(std::string(label), PASS_TRACK) : 0);
+}
+
+void GPUProfiler::EndScope() {
+    ASSERT(!open_scopes.empty());
+    const u64 id = open_scopes.back();
+    open_scopes.pop_back();
+    if (id != 0) {
+        End(id);
+    }
+}
+
+void GPUProfiler::Resolve() {
+    if (scopes.empty()) {
+        return;
+    }
+    // Sample both clocks together, the GPU one is read once prior commands reach the GL server
+    GLint64 gpu_now = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpu_now);
+    const s64 clock_offset =
+        static_cast<s64>(Common::TraceRecorder::Detail::Now()) - static_cast<s64>(gpu_now);
+    while (!scopes.empty()) {
+        PendingScope& scope = scopes.front();
+        if (scope.end_query == 0) {
+            // Scopes nest, the ones after an open scope are resolved with it
+            break;
+        }
+        GLint is_available = GL_FALSE;
+        glGetQueryObjectiv(scope.end_query, GL_QUERY_RESULT_AVAILABLE, &is_available);
+        if (is_available == GL_FALSE) {
+            break;
+        }
+        GLint64 begin_ns = 0;
+        GLint64 end_ns = 0;
+        glGetQueryObjecti64v(scope.begin_query, GL_QUERY_RESULT, &begin_ns);
+        glGetQueryObjecti64v(scope.end_query, GL_QUERY_RESULT, &end_ns);
+        Common::TraceRecorder::RecordGpuScope(
+            scope.track, std::move(scope.label), static_cast<u64>(begin_ns + clock_offset),
+            static_cast<u64>(std::max(begin_ns, end_ns) + clock_offset));
+        free_queries.push_back(scope.begin_query);
+        free_queries.push_back(scope.end_query);
+        scopes.pop_front();
+        ++first_scope_id;
+    }
+}
+
+u64 GPUProfiler::Begin(std::string label, std::string_view track) {
+    const GLuint begin_query = AcquireQuery();
+    glQueryCounter(begin_query, GL_TIMESTAMP);
+    scopes.push_back(PendingScope{
+        .label = std::move(label),
+        .track = track,
+        .begin_query = begin_query,
+        .end_query = 0,
+    });
+    return first_scope_id + scopes.size() - 1;
+}
+
+void GPUProfiler::End(u64 id) {
+    ASSERT(id >= first_scope_id && id - first_scope_id < scopes.size());
+    const GLuint end_query = AcquireQuery();
+    glQueryCounter(end_query, GL_TIMESTAMP);
+    scopes[id - first_scope_id].end_query = end_query;
+}
+
+GLuint GPUProfiler::AcquireQuery() {
+    if (!free_queries.empty()) {
+        const GLuint query = free_queries.back();
+        free_queries.pop_back();
+        return query;
+    }
+    OGLQuery& query = queries.emplace_back();
+    query.Create(GL_TIMESTAMP);
+    return query.handle;
+}
+
+} // namespace OpenGL
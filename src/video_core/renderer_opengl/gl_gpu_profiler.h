@@ -0,0 +1,82 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "common/common_types.h"
+#include "video_core/renderer_opengl/gl_resource_manager.h"
+
+namespace OpenGL {
+
+/**
+ * Measures the GPU time of passes with timestamp queries while a trace is recorded, and stores
+ * them in the trace once their results are available. The GPU clock is placed on the host clock
+ * by sampling both when the results are read.
+ */
+class GPUProfiler {
+public:
+    /// Track of the trace holding render passes
+    static constexpr std::string_view RENDER_PASS_TRACK = "GPU render passes";
+    /// Track of the trace holding the other passes
+    static constexpr std::string_view PASS_TRACK = "GPU passes";
+
+    GPUProfiler();
+    ~GPUProfiler();
+
+    /// Returns true when passes issued now are measured
+    [[nodiscard]] bool IsEnabled() const noexcept;
+
+    /// Begins a render pass when the given framebuffer isn't the one of the current render pass
+    void BindFramebuffer(GLuint framebuffer, const std::string& label);
+
+    /// Ends the current render pass, if any
+    void EndRenderPass();
+
+    /// Measures the commands issued until the matching EndScope
+    void BeginScope(std::string_view label);
+
+    /// Ends the innermost scope begun with BeginScope
+    void EndScope();
+
+    /// Stores the scopes the GPU has finished in the trace
+    void Resolve();
+
+private:
+    struct PendingScope {
+        std::string label;
+        std::string_view track;
+        GLuint begin_query;
+        GLuint end_query;
+    };
+
+    /// Begins a scope on a track, returns its id
+    u64 Begin(std::string label, std::string_view track);
+
+    /// Ends the scope with the given id
+    void End(u64 id);
+
+    /// Returns a timestamp query that isn't pending
+    GLuint AcquireQuery();
+
+    std::vector<OGLQuery> queries;
+    std::vector<GLuint> free_queries;
+
+    std::deque<PendingScope> scopes;
+    u64 first_scope_id = 1;
+
+    /// Open scopes begun with BeginScope, an id of zero when they aren't measured
+    std::vector<u64> open_scopes;
+
+    GLuint renderpass_framebuffer = 0;
+    u64 renderpass_scope = 0;
+};
+
+} // namespace OpenGL
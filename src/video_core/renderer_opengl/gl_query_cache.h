@@ -52,9 +52,15 @@ public:
 
     void EndQuery();
 
+    GLuint Handle() const noexcept {
+        return query.handle;
+    }
+
 private:
     u64 BlockingQuery() const override;
 
+    bool IsHostReady() const override;
+
     QueryCache& cache;
     const VideoCore::QueryType type;
     OGLQuery query;
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <array>
 #include <bitset>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -166,17 +167,32 @@ RasterizerOpenGL::RasterizerOpenGL(Core::Frontend::EmuWindow& emu_window_, Tegra
     : RasterizerAccelerated(cpu_memory_), gpu(gpu_), maxwell3d(gpu.Maxwell3D()),
       kepler_compute(gpu.KeplerCompute()), gpu_memory(gpu.MemoryManager()), device(device_),
       screen_info(screen_info_), program_manager(program_manager_), state_tracker(state_tracker_),
-      texture_cache_runtime(device, program_manager, state_tracker),
+      texture_cache_runtime(device, program_manager, state_tracker, gpu_profiler),
       texture_cache(texture_cache_runtime, *this, maxwell3d, kepler_compute, gpu_memory),
       buffer_cache_runtime(device),
       buffer_cache(*this, maxwell3d, kepler_compute, gpu_memory, cpu_memory_, buffer_cache_runtime),
       shader_cache(*this, emu_window_, gpu, maxwell3d, kepler_compute, gpu_memory, device),
-      query_cache(*this, maxwell3d, gpu_memory), accelerate_dma(buffer_cache),
+      query_cache(*this, maxwell3d, gpu_memory), accelerate_dma(*this, buffer_cache),
       fence_manager(*this, gpu, texture_cache, buffer_cache, query_cache),
       async_shaders(emu_window_) {
     if (device.UseAsynchronousShaders()) {
         async_shaders.AllocateWorkers();
     }
+    if (device.UseBindlessTextures()) {
+        for (OGLBuffer& buffer : bindless_buffers) {
+            buffer.Create();
+            glNamedBufferStorage(buffer.handle, sizeof(BindlessHandles), nullptr,
+                                 GL_DYNAMIC_STORAGE_BIT);
+        }
+    }
+    if (device.UseDrawBatching()) {
+        draw_batch.arrays.reserve(MAX_BATCHED_DRAWS);
+        draw_batch.elements.reserve(MAX_BATCHED_DRAWS);
+        draw_indirect_buffer.Create();
+        glNamedBufferStorage(draw_indirect_buffer.handle,
+                             MAX_BATCHED_DRAWS * sizeof(DrawElementsIndirectCommand), nullptr,
+                             GL_DYNAMIC_STORAGE_BIT);
+    }
 }
 
 RasterizerOpenGL::~RasterizerOpenGL() = default;
@@ -244,12 +260,14 @@ void RasterizerOpenGL::SyncVertexInstances() {
     }
 }
 
-void RasterizerOpenGL::SetupShaders(bool is_indexed) {
+bool RasterizerOpenGL::SetupShaders(bool is_indexed) {
     u32 clip_distances = 0;
 
     std::array<Shader*, Maxwell::MaxShaderStage> shaders{};
     image_view_indices.clear();
+    native_image_view_indices.clear();
     sampler_handles.clear();
+    uses_frag_coord = false;
 
     texture_cache.SynchronizeGraphicsDescriptors();
 
@@ -279,7 +297,11 @@ void RasterizerOpenGL::SetupShaders(bool is_indexed) {
         }
 
         Shader* const shader = shader_cache.GetStageProgram(program, async_shaders);
-        const GLuint program_handle = shader->IsBuilt() ? shader->GetHandle() : 0;
+        const GLuint program_handle = shader_cache.GetStageHandle(*shader, program, async_shaders);
+        if (program_handle == 0) {
+            // Skip the draw until the program has been built
+            return false;
+        }
         switch (program) {
         case Maxwell::ShaderProgram::VertexA:
         case Maxwell::ShaderProgram::VertexB:
@@ -290,6 +312,7 @@ void RasterizerOpenGL::SetupShaders(bool is_indexed) {
             break;
         case Maxwell::ShaderProgram::Fragment:
             program_manager.UseFragmentShader(program_handle);
+            uses_frag_coord = shader->GetEntries().uses_frag_coord;
             break;
         default:
             UNIMPLEMENTED_MSG("Unimplemented shader index={}, enable={}, offset=0x{:08X}", index,
@@ -331,6 +354,8 @@ void RasterizerOpenGL::SetupShaders(bool is_indexed) {
 
     buffer_cache.UpdateGraphicsBuffers(is_indexed);
 
+    texture_cache.RequireNativeGraphicsImages(
+        std::span(native_image_view_indices.data(), native_image_view_indices.size()));
     const std::span indices_span(image_view_indices.data(), image_view_indices.size());
     texture_cache.FillGraphicsImageViews(indices_span, image_view_ids);
 
@@ -346,9 +371,10 @@ void RasterizerOpenGL::SetupShaders(bool is_indexed) {
         }
         buffer_cache.BindHostStageBuffers(stage);
         const auto& base = device.GetBaseBindings(stage);
-        BindTextures(shader->GetEntries(), base.sampler, base.image, image_view_index,
+        BindTextures(shader->GetEntries(), stage, base.sampler, base.image, image_view_index,
                      texture_index, image_index);
     }
+    return true;
 }
 
 void RasterizerOpenGL::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
@@ -358,6 +384,7 @@ void RasterizerOpenGL::LoadDiskResources(u64 title_id, std::stop_token stop_load
 
 void RasterizerOpenGL::Clear() {
     MICROPROFILE_SCOPE(OpenGL_Clears);
+    FlushDrawBatch();
     if (!maxwell3d.ShouldExecute()) {
         return;
     }
@@ -397,6 +424,11 @@ void RasterizerOpenGL::Clear() {
         return;
     }
 
+    std::scoped_lock lock{texture_cache.mutex};
+    texture_cache.UpdateRenderTargets(true);
+    BindFramebuffer(texture_cache.GetFramebuffer());
+    SyncRenderScale();
+
     SyncRasterizeEnable();
     SyncStencilTestState();
 
@@ -408,10 +440,7 @@ void RasterizerOpenGL::Clear() {
     }
     UNIMPLEMENTED_IF(regs.clear_flags.viewport);
 
-    std::scoped_lock lock{texture_cache.mutex};
-    texture_cache.UpdateRenderTargets(true);
-    state_tracker.BindFramebuffer(texture_cache.GetFramebuffer()->Handle());
-
+    BeginConditionalRender();
     if (use_color) {
         glClearBufferfv(GL_COLOR, regs.clear_buffers.RT, regs.clear_color);
     }
@@ -422,26 +451,43 @@ void RasterizerOpenGL::Clear() {
     } else if (use_stencil) {
         glClearBufferiv(GL_STENCIL, 0, &regs.clear_stencil);
     }
+    EndConditionalRender();
     ++num_queued_commands;
 }
 
 void RasterizerOpenGL::Draw(bool is_indexed, bool is_instanced) {
     MICROPROFILE_SCOPE(OpenGL_Drawing);
 
+    if (AppendToDrawBatch(is_indexed, is_instanced)) {
+        gpu.TickWork();
+        return;
+    }
+    FlushDrawBatch();
+
     query_cache.UpdateCounters();
 
     SyncState();
 
     // Setup shaders and their used resources.
     std::scoped_lock lock{buffer_cache.mutex, texture_cache.mutex};
-    SetupShaders(is_indexed);
+    if (!SetupShaders(is_indexed)) {
+        return;
+    }
 
-    texture_cache.UpdateRenderTargets(false);
-    state_tracker.BindFramebuffer(texture_cache.GetFramebuffer()->Handle());
+    texture_cache.UpdateRenderTargets(false, uses_frag_coord);
+    BindFramebuffer(texture_cache.GetFramebuffer());
+    SyncRenderScale();
     program_manager.BindGraphicsPipeline();
 
     const GLenum primitive_mode = MaxwellToGL::PrimitiveTopology(maxwell3d.regs.draw.topology);
+    if (StartDrawBatch(is_indexed, is_instanced, primitive_mode)) {
+        // Issued once the batch is flushed, along with the compatible draws that follow it
+        ++num_queued_commands;
+        gpu.TickWork();
+        return;
+    }
     BeginTransformFeedback(primitive_mode);
+    BeginConditionalRender();
 
     const GLuint base_instance = static_cast<GLuint>(maxwell3d.regs.vb_base_instance);
     const GLsizei num_instances =
@@ -481,6 +527,7 @@ void RasterizerOpenGL::Draw(bool is_indexed, bool is_instanced) {
         }
     }
 
+    EndConditionalRender();
     EndTransformFeedback();
 
     ++num_queued_commands;
@@ -488,7 +535,131 @@ void RasterizerOpenGL::Draw(bool is_indexed, bool is_instanced) {
     gpu.TickWork();
 }
 
+void RasterizerOpenGL::FlushDrawBatch() {
+    DrawBatch& batch = draw_batch;
+    const size_t num_draws = batch.NumDraws();
+    if (num_draws == 0) {
+        return;
+    }
+    const GLenum mode = batch.primitive_mode;
+    if (batch.is_indexed) {
+        if (num_draws == 1) {
+            const DrawElementsIndirectCommand& draw = batch.elements.front();
+            const auto offset = static_cast<uintptr_t>(draw.first_index) * batch.index_size;
+            glDrawElementsInstancedBaseVertexBaseInstance(
+                mode, static_cast<GLsizei>(draw.count), batch.index_format,
+                reinterpret_cast<const GLvoid*>(offset), static_cast<GLsizei>(draw.instance_count),
+                draw.base_vertex, draw.base_instance);
+        } else {
+            const size_t size = num_draws * sizeof(DrawElementsIndirectCommand);
+            glNamedBufferSubData(draw_indirect_buffer.handle, 0, static_cast<GLsizeiptr>(size),
+                                 batch.elements.data());
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, draw_indirect_buffer.handle);
+            glMultiDrawElementsIndirect(mode, batch.index_format, nullptr,
+                                        static_cast<GLsizei>(num_draws), 0);
+        }
+        batch.elements.clear();
+    } else {
+        if (num_draws == 1) {
+            const DrawArraysIndirectCommand& draw = batch.arrays.front();
+            glDrawArraysInstancedBaseInstance(mode, static_cast<GLint>(draw.first),
+                                              static_cast<GLsizei>(draw.count),
+                                              static_cast<GLsizei>(draw.instance_count),
+                                              draw.base_instance);
+        } else {
+            const size_t size = num_draws * sizeof(DrawArraysIndirectCommand);
+            glNamedBufferSubData(draw_indirect_buffer.handle, 0, static_cast<GLsizeiptr>(size),
+                                 batch.arrays.data());
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, draw_indirect_buffer.handle);
+            glMultiDrawArraysIndirect(mode, nullptr, static_cast<GLsizei>(num_draws), 0);
+        }
+        batch.arrays.clear();
+    }
+}
+
+bool RasterizerOpenGL::StartDrawBatch(bool is_indexed, bool is_instanced, GLenum primitive_mode) {
+    const auto& regs = maxwell3d.regs;
+    if (!device.UseDrawBatching() || regs.tfb_enabled != 0 || conditional_counter) {
+        return false;
+    }
+    DrawBatch& batch = draw_batch;
+    if (is_indexed) {
+        // Unified memory binds an address range that starts at the first index of the draw
+        if (device.HasVertexBufferUnifiedMemory()) {
+            return false;
+        }
+        const u32 index_size = regs.index_array.FormatSizeInBytes();
+        const auto offset = reinterpret_cast<uintptr_t>(buffer_cache_runtime.IndexOffset());
+        if (offset % index_size != 0) {
+            return false;
+        }
+        batch.index_format = MaxwellToGL::IndexFormat(regs.index_array.format);
+        batch.index_size = index_size;
+        batch.base_index = static_cast<GLuint>(offset / index_size) - regs.index_array.first;
+    }
+    batch.regs = regs;
+    batch.primitive_mode = primitive_mode;
+    batch.is_indexed = is_indexed;
+    AddBatchedDraw(is_instanced);
+    return true;
+}
+
+bool RasterizerOpenGL::AppendToDrawBatch(bool is_indexed, bool is_instanced) {
+    DrawBatch& batch = draw_batch;
+    const size_t num_draws = batch.NumDraws();
+    if (num_draws == 0 || num_draws == MAX_BATCHED_DRAWS || batch.is_indexed != is_indexed) {
+        return false;
+    }
+    const auto& regs = maxwell3d.regs;
+    if (regs.draw.topology != batch.regs.draw.topology) {
+        return false;
+    }
+    // Ranges are the only registers allowed to differ between the draws of a batch
+    Maxwell& batch_regs = batch.regs;
+    batch_regs.draw = regs.draw;
+    batch_regs.vertex_buffer.first = regs.vertex_buffer.first;
+    batch_regs.vertex_buffer.count = regs.vertex_buffer.count;
+    batch_regs.index_array.first = regs.index_array.first;
+    batch_regs.index_array.count = regs.index_array.count;
+    batch_regs.vb_element_base = regs.vb_element_base;
+    batch_regs.vb_base_instance = regs.vb_base_instance;
+    if (std::memcmp(&batch_regs, &regs, sizeof(Maxwell)) != 0) {
+        return false;
+    }
+    if (is_indexed) {
+        std::scoped_lock lock{buffer_cache.mutex};
+        if (!buffer_cache.ExtendIndexBuffer()) {
+            return false;
+        }
+    }
+    AddBatchedDraw(is_instanced);
+    return true;
+}
+
+void RasterizerOpenGL::AddBatchedDraw(bool is_instanced) {
+    const auto& regs = maxwell3d.regs;
+    const GLuint num_instances = is_instanced ? maxwell3d.mme_draw.instance_count : 1;
+    const auto base_instance = static_cast<GLuint>(regs.vb_base_instance);
+    if (draw_batch.is_indexed) {
+        draw_batch.elements.push_back({
+            .count = regs.index_array.count,
+            .instance_count = num_instances,
+            .first_index = draw_batch.base_index + regs.index_array.first,
+            .base_vertex = static_cast<GLint>(regs.vb_element_base),
+            .base_instance = base_instance,
+        });
+    } else {
+        draw_batch.arrays.push_back({
+            .count = regs.vertex_buffer.count,
+            .instance_count = num_instances,
+            .first = regs.vertex_buffer.first,
+            .base_instance = base_instance,
+        });
+    }
+}
+
 void RasterizerOpenGL::DispatchCompute(GPUVAddr code_addr) {
+    FlushDrawBatch();
     Shader* const kernel = shader_cache.GetComputeKernel(code_addr);
 
     std::scoped_lock lock{buffer_cache.mutex, texture_cache.mutex};
@@ -507,33 +678,70 @@ void RasterizerOpenGL::DispatchCompute(GPUVAddr code_addr) {
     buffer_cache.BindHostComputeBuffers();
 
     const auto& launch_desc = kepler_compute.launch_description;
+    gpu_profiler.EndRenderPass();
+    if (gpu_profiler.IsEnabled()) {
+        gpu_profiler.BeginScope(fmt::format("Dispatch 0x{:x}", code_addr));
+    } else {
+        gpu_profiler.BeginScope({});
+    }
     glDispatchCompute(launch_desc.grid_dim_x, launch_desc.grid_dim_y, launch_desc.grid_dim_z);
+    gpu_profiler.EndScope();
     ++num_queued_commands;
 }
 
 void RasterizerOpenGL::ResetCounter(VideoCore::QueryType type) {
+    FlushDrawBatch();
     query_cache.ResetCounter(type);
 }
 
 void RasterizerOpenGL::Query(GPUVAddr gpu_addr, VideoCore::QueryType type,
                              std::optional<u64> timestamp) {
+    FlushDrawBatch();
     query_cache.Query(gpu_addr, type, timestamp);
 }
 
+bool RasterizerOpenGL::IsQueryPending(GPUVAddr gpu_addr, u64 size) {
+    return query_cache.IsRegionPending(gpu_addr, size);
+}
+
+bool RasterizerOpenGL::AccelerateConditionalRendering(GPUVAddr compare_addr, bool equal) {
+    FlushDrawBatch();
+    // Query compare conditions test the query at the compare address against the one 16 bytes
+    // after it. When the latter only accumulates a host query on top of the former, they are
+    // equal exactly when that host query didn't pass any samples.
+    constexpr GPUVAddr CURRENT_QUERY_OFFSET = 16;
+    conditional_counter =
+        query_cache.DifferenceCounter(compare_addr, compare_addr + CURRENT_QUERY_OFFSET);
+    conditional_inverted = equal;
+    return conditional_counter != nullptr;
+}
+
+void RasterizerOpenGL::DisableConditionalRendering() {
+    FlushDrawBatch();
+    conditional_counter = nullptr;
+}
+
 void RasterizerOpenGL::BindGraphicsUniformBuffer(size_t stage, u32 index, GPUVAddr gpu_addr,
                                                  u32 size) {
+    FlushDrawBatch();
     std::scoped_lock lock{buffer_cache.mutex};
     buffer_cache.BindGraphicsUniformBuffer(stage, index, gpu_addr, size);
 }
 
 void RasterizerOpenGL::DisableGraphicsUniformBuffer(size_t stage, u32 index) {
+    FlushDrawBatch();
     buffer_cache.DisableGraphicsUniformBuffer(stage, index);
 }
 
+void RasterizerOpenGL::PrepareGraphicsShader(size_t program) {
+    shader_cache.PrepareStageProgram(static_cast<Maxwell::ShaderProgram>(program));
+}
+
 void RasterizerOpenGL::FlushAll() {}
 
 void RasterizerOpenGL::FlushRegion(VAddr addr, u64 size) {
     MICROPROFILE_SCOPE(OpenGL_CacheManagement);
+    FlushDrawBatch();
     if (addr == 0 || size == 0) {
         return;
     }
@@ -559,6 +767,7 @@ bool RasterizerOpenGL::MustFlushRegion(VAddr addr, u64 size) {
 
 void RasterizerOpenGL::InvalidateRegion(VAddr addr, u64 size) {
     MICROPROFILE_SCOPE(OpenGL_CacheManagement);
+    FlushDrawBatch();
     if (addr == 0 || size == 0) {
         return;
     }
@@ -592,6 +801,7 @@ void RasterizerOpenGL::OnCPUWrite(VAddr addr, u64 size) {
 
 void RasterizerOpenGL::SyncGuestHost() {
     MICROPROFILE_SCOPE(OpenGL_CacheManagement);
+    FlushDrawBatch();
     shader_cache.SyncGuestHost();
     {
         std::scoped_lock lock{buffer_cache.mutex};
@@ -619,6 +829,7 @@ void RasterizerOpenGL::ModifyGPUMemory(GPUVAddr addr, u64 size) {
 }
 
 void RasterizerOpenGL::SignalSemaphore(GPUVAddr addr, u32 value) {
+    FlushDrawBatch();
     if (!gpu.IsAsync()) {
         gpu_memory.Write<u32>(addr, value);
         return;
@@ -627,6 +838,7 @@ void RasterizerOpenGL::SignalSemaphore(GPUVAddr addr, u32 value) {
 }
 
 void RasterizerOpenGL::SignalSyncPoint(u32 value) {
+    FlushDrawBatch();
     if (!gpu.IsAsync()) {
         gpu.IncrementSyncPoint(value);
         return;
@@ -635,6 +847,7 @@ void RasterizerOpenGL::SignalSyncPoint(u32 value) {
 }
 
 void RasterizerOpenGL::SignalReference() {
+    FlushDrawBatch();
     if (!gpu.IsAsync()) {
         return;
     }
@@ -642,6 +855,7 @@ void RasterizerOpenGL::SignalReference() {
 }
 
 void RasterizerOpenGL::ReleaseFences() {
+    FlushDrawBatch();
     if (!gpu.IsAsync()) {
         return;
     }
@@ -656,19 +870,23 @@ void RasterizerOpenGL::FlushAndInvalidateRegion(VAddr addr, u64 size) {
 }
 
 void RasterizerOpenGL::WaitForIdle() {
+    FlushDrawBatch();
     glMemoryBarrier(GL_ALL_BARRIER_BITS);
     SignalReference();
 }
 
 void RasterizerOpenGL::FragmentBarrier() {
+    FlushDrawBatch();
     glMemoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT);
 }
 
 void RasterizerOpenGL::TiledCacheBarrier() {
+    FlushDrawBatch();
     glTextureBarrier();
 }
 
 void RasterizerOpenGL::FlushCommands() {
+    FlushDrawBatch();
     // Only flush when we have commands queued to OpenGL.
     if (num_queued_commands == 0) {
         return;
@@ -678,9 +896,13 @@ void RasterizerOpenGL::FlushCommands() {
 }
 
 void RasterizerOpenGL::TickFrame() {
+    FlushDrawBatch();
     // Ticking a frame means that buffers will be swapped, calling glFlush implicitly.
     num_queued_commands = 0;
 
+    gpu_profiler.EndRenderPass();
+    gpu_profiler.Resolve();
+
     fence_manager.TickFrame();
     {
         std::scoped_lock lock{texture_cache.mutex};
@@ -692,10 +914,19 @@ void RasterizerOpenGL::TickFrame() {
     }
 }
 
+VideoCore::RasterizerMemoryUsage RasterizerOpenGL::GetMemoryUsage() const {
+    return VideoCore::RasterizerMemoryUsage{
+        .texture_cache = texture_cache.GetUsedMemory(),
+        .buffer_cache = buffer_cache.GetUsedMemory(),
+        .staging_buffers = texture_cache_runtime.GetStagingMemory(),
+    };
+}
+
 bool RasterizerOpenGL::AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Surface& src,
                                              const Tegra::Engines::Fermi2D::Surface& dst,
                                              const Tegra::Engines::Fermi2D::Config& copy_config) {
     MICROPROFILE_SCOPE(OpenGL_Blits);
+    FlushDrawBatch();
     std::scoped_lock lock{texture_cache.mutex};
     texture_cache.BlitImage(dst, src, copy_config);
     return true;
@@ -707,6 +938,7 @@ Tegra::Engines::AccelerateDMAInterface& RasterizerOpenGL::AccessAccelerateDMA()
 
 bool RasterizerOpenGL::AccelerateDisplay(const Tegra::FramebufferConfig& config,
                                          VAddr framebuffer_addr, u32 pixel_stride) {
+    FlushDrawBatch();
     if (framebuffer_addr == 0) {
         return false;
     }
@@ -728,6 +960,7 @@ bool RasterizerOpenGL::AccelerateDisplay(const Tegra::FramebufferConfig& config,
 
 void RasterizerOpenGL::BindComputeTextures(Shader* kernel) {
     image_view_indices.clear();
+    native_image_view_indices.clear();
     sampler_handles.clear();
 
     texture_cache.SynchronizeComputeDescriptors();
@@ -735,6 +968,8 @@ void RasterizerOpenGL::BindComputeTextures(Shader* kernel) {
     SetupComputeTextures(kernel);
     SetupComputeImages(kernel);
 
+    texture_cache.RequireNativeComputeImages(
+        std::span(native_image_view_indices.data(), native_image_view_indices.size()));
     const std::span indices_span(image_view_indices.data(), image_view_indices.size());
     texture_cache.FillComputeImageViews(indices_span, image_view_ids);
 
@@ -742,23 +977,33 @@ void RasterizerOpenGL::BindComputeTextures(Shader* kernel) {
     size_t image_view_index = 0;
     size_t texture_index = 0;
     size_t image_index = 0;
-    BindTextures(kernel->GetEntries(), 0, 0, image_view_index, texture_index, image_index);
+    BindTextures(kernel->GetEntries(), static_cast<size_t>(ShaderType::Compute), 0, 0,
+                 image_view_index, texture_index, image_index);
 }
 
-void RasterizerOpenGL::BindTextures(const ShaderEntries& entries, GLuint base_texture,
-                                    GLuint base_image, size_t& image_view_index,
-                                    size_t& texture_index, size_t& image_index) {
+void RasterizerOpenGL::BindTextures(const ShaderEntries& entries, size_t stage,
+                                    GLuint base_texture, GLuint base_image,
+                                    size_t& image_view_index, size_t& texture_index,
+                                    size_t& image_index) {
     const GLuint* const samplers = sampler_handles.data() + texture_index;
     const GLuint* const textures = texture_handles.data() + texture_index;
     const GLuint* const images = image_handles.data() + image_index;
 
+    const bool use_bindless = device.UseBindlessTextures();
+    BindlessHandles handles;
+    size_t num_handles = 0;
+
     const size_t num_samplers = entries.samplers.size();
     for (const auto& sampler : entries.samplers) {
         for (size_t i = 0; i < sampler.size; ++i) {
             const ImageViewId image_view_id = image_view_ids[image_view_index++];
             const ImageView& image_view = texture_cache.GetImageView(image_view_id);
-            const GLuint handle = image_view.Handle(ImageViewTypeFromEntry(sampler));
-            texture_handles[texture_index++] = handle;
+            const ImageViewType type = ImageViewTypeFromEntry(sampler);
+            if (use_bindless) {
+                const GLuint64 handle = image_view.BindlessHandle(type, samplers[num_handles]);
+                handles[num_handles++] = {handle, 0};
+            }
+            texture_handles[texture_index++] = image_view.Handle(type);
         }
     }
     const size_t num_images = entries.images.size();
@@ -770,7 +1015,11 @@ void RasterizerOpenGL::BindTextures(const ShaderEntries& entries, GLuint base_te
         image_handles[image_index] = handle;
         ++image_index;
     }
-    if (num_samplers > 0) {
+    if (use_bindless) {
+        if (num_handles > 0) {
+            UpdateBindlessHandles(stage, std::span(handles.data(), num_handles));
+        }
+    } else if (num_samplers > 0) {
         glBindSamplers(base_texture, static_cast<GLsizei>(num_samplers), samplers);
         glBindTextures(base_texture, static_cast<GLsizei>(num_samplers), textures);
     }
@@ -779,6 +1028,22 @@ void RasterizerOpenGL::BindTextures(const ShaderEntries& entries, GLuint base_te
     }
 }
 
+void RasterizerOpenGL::UpdateBindlessHandles(size_t stage,
+                                             std::span<const std::array<GLuint64, 2>> handles) {
+    const GLuint buffer = bindless_buffers[stage].handle;
+    const size_t size = handles.size_bytes();
+    size_t& num_bound = num_bound_bindless_handles[stage];
+    BindlessHandles& bound = bound_bindless_handles[stage];
+    // Most draws sample the same textures as the previous one on the stage, skip the upload then
+    if (num_bound != handles.size() || !std::equal(handles.begin(), handles.end(), bound.begin())) {
+        glNamedBufferSubData(buffer, 0, static_cast<GLsizeiptr>(size), handles.data());
+        std::ranges::copy(handles, bound.begin());
+        num_bound = handles.size();
+    }
+    const GLuint binding = device.GetBaseBindings(stage).bindless_handles;
+    glBindBufferRange(GL_UNIFORM_BUFFER, binding, buffer, 0, static_cast<GLsizeiptr>(size));
+}
+
 void RasterizerOpenGL::SetupDrawTextures(const Shader* shader, size_t stage_index) {
     const bool via_header_index =
         maxwell3d.regs.sampler_index == Maxwell::SamplerIndex::ViaHeaderIndex;
@@ -787,9 +1052,13 @@ void RasterizerOpenGL::SetupDrawTextures(const Shader* shader, size_t stage_inde
         for (size_t index = 0; index < entry.size; ++index) {
             const auto handle =
                 GetTextureInfo(maxwell3d, via_header_index, entry, shader_type, index);
-            const Sampler* const sampler = texture_cache.GetGraphicsSampler(handle.sampler);
+            const Sampler* const sampler =
+                texture_cache.GetGraphicsSampler(handle.sampler, handle.image);
             sampler_handles.push_back(sampler->Handle());
             image_view_indices.push_back(handle.image);
+            if (entry.is_fetched) {
+                native_image_view_indices.push_back(handle.image);
+            }
         }
     }
 }
@@ -800,9 +1069,13 @@ void RasterizerOpenGL::SetupComputeTextures(const Shader* kernel) {
         for (size_t i = 0; i < entry.size; ++i) {
             const auto handle =
                 GetTextureInfo(kepler_compute, via_header_index, entry, ShaderType::Compute, i);
-            const Sampler* const sampler = texture_cache.GetComputeSampler(handle.sampler);
+            const Sampler* const sampler =
+                texture_cache.GetComputeSampler(handle.sampler, handle.image);
             sampler_handles.push_back(sampler->Handle());
             image_view_indices.push_back(handle.image);
+            if (entry.is_fetched) {
+                native_image_view_indices.push_back(handle.image);
+            }
         }
     }
 }
@@ -814,6 +1087,7 @@ void RasterizerOpenGL::SetupDrawImages(const Shader* shader, size_t stage_index)
         const auto shader_type = static_cast<ShaderType>(stage_index);
         const auto handle = GetTextureInfo(maxwell3d, via_header_index, entry, shader_type);
         image_view_indices.push_back(handle.image);
+        native_image_view_indices.push_back(handle.image);
     }
 }
 
@@ -823,6 +1097,7 @@ void RasterizerOpenGL::SetupComputeImages(const Shader* shader) {
         const auto handle =
             GetTextureInfo(kepler_compute, via_header_index, entry, ShaderType::Compute);
         image_view_indices.push_back(handle.image);
+        native_image_view_indices.push_back(handle.image);
     }
 }
 
@@ -906,8 +1181,9 @@ void RasterizerOpenGL::SyncViewport() {
 
             const auto& src = regs.viewport_transform[i];
             const Common::Rectangle<f32> rect{src.GetRect()};
-            glViewportIndexedf(static_cast<GLuint>(i), rect.left, rect.bottom, rect.GetWidth(),
-                               rect.GetHeight());
+            glViewportIndexedf(static_cast<GLuint>(i), rect.left * render_scale,
+                               rect.bottom * render_scale, rect.GetWidth() * render_scale,
+                               rect.GetHeight() * render_scale);
 
             const GLdouble reduce_z = regs.depth_mode == Maxwell::DepthMode::MinusOneToOne;
             const GLdouble near_depth = src.translate_z - src.scale_z * reduce_z;
@@ -1238,15 +1514,37 @@ void RasterizerOpenGL::SyncScissorTest() {
 
         const auto& src = regs.scissor_test[index];
         if (src.enable) {
+            const auto scale = [this](u32 value) {
+                return static_cast<GLint>(static_cast<float>(value) * render_scale);
+            };
             glEnablei(GL_SCISSOR_TEST, static_cast<GLuint>(index));
-            glScissorIndexed(static_cast<GLuint>(index), src.min_x, src.min_y,
-                             src.max_x - src.min_x, src.max_y - src.min_y);
+            glScissorIndexed(static_cast<GLuint>(index), scale(src.min_x), scale(src.min_y),
+                             scale(src.max_x - src.min_x), scale(src.max_y - src.min_y));
         } else {
             glDisablei(GL_SCISSOR_TEST, static_cast<GLuint>(index));
         }
     }
 }
 
+void RasterizerOpenGL::BindFramebuffer(const Framebuffer* framebuffer) {
+    state_tracker.BindFramebuffer(framebuffer->Handle());
+    if (gpu_profiler.IsEnabled()) {
+        gpu_profiler.BindFramebuffer(framebuffer->Handle(), framebuffer->ProfileLabel());
+    }
+}
+
+void RasterizerOpenGL::SyncRenderScale() {
+    const float scale = texture_cache.RenderTargetScale();
+    if (scale == render_scale) {
+        return;
+    }
+    render_scale = scale;
+    state_tracker.NotifyViewports();
+    state_tracker.NotifyScissors();
+    SyncViewport();
+    SyncScissorTest();
+}
+
 void RasterizerOpenGL::SyncPointState() {
     auto& flags = maxwell3d.dirty.flags;
     if (!flags[Dirty::PointSize]) {
@@ -1400,9 +1698,27 @@ void RasterizerOpenGL::EndTransformFeedback() {
     glEndTransformFeedback();
 }
 
-AccelerateDMA::AccelerateDMA(BufferCache& buffer_cache_) : buffer_cache{buffer_cache_} {}
+void RasterizerOpenGL::BeginConditionalRender() {
+    if (!conditional_counter) {
+        return;
+    }
+    // Waiting here only stalls the host GPU, the CPU keeps submitting commands.
+    glBeginConditionalRender(conditional_counter->Handle(),
+                             conditional_inverted ? GL_QUERY_WAIT_INVERTED : GL_QUERY_WAIT);
+}
+
+void RasterizerOpenGL::EndConditionalRender() {
+    if (!conditional_counter) {
+        return;
+    }
+    glEndConditionalRender();
+}
+
+AccelerateDMA::AccelerateDMA(RasterizerOpenGL& rasterizer_, BufferCache& buffer_cache_)
+    : rasterizer{rasterizer_}, buffer_cache{buffer_cache_} {}
 
 bool AccelerateDMA::BufferCopy(GPUVAddr src_address, GPUVAddr dest_address, u64 amount) {
+    rasterizer.FlushDrawBatch();
     std::scoped_lock lock{buffer_cache.mutex};
     return buffer_cache.DMACopy(src_address, dest_address, amount);
 }
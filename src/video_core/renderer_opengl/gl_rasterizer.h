@@ -9,8 +9,10 @@
 #include <cstddef>
 #include <memory>
 #include <optional>
+#include <span>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include <boost/container/static_vector.hpp>
 
@@ -25,6 +27,7 @@
 #include "video_core/renderer_opengl/gl_buffer_cache.h"
 #include "video_core/renderer_opengl/gl_device.h"
 #include "video_core/renderer_opengl/gl_fence_manager.h"
+#include "video_core/renderer_opengl/gl_gpu_profiler.h"
 #include "video_core/renderer_opengl/gl_query_cache.h"
 #include "video_core/renderer_opengl/gl_resource_manager.h"
 #include "video_core/renderer_opengl/gl_shader_cache.h"
@@ -59,13 +62,16 @@ struct BindlessSSBO {
 };
 static_assert(sizeof(BindlessSSBO) * CHAR_BIT == 128);
 
+class RasterizerOpenGL;
+
 class AccelerateDMA : public Tegra::Engines::AccelerateDMAInterface {
 public:
-    explicit AccelerateDMA(BufferCache& buffer_cache);
+    explicit AccelerateDMA(RasterizerOpenGL& rasterizer, BufferCache& buffer_cache);
 
     bool BufferCopy(GPUVAddr src_address, GPUVAddr dest_address, u64 amount) override;
 
 private:
+    RasterizerOpenGL& rasterizer;
     BufferCache& buffer_cache;
 };
 
@@ -82,8 +88,12 @@ public:
     void DispatchCompute(GPUVAddr code_addr) override;
     void ResetCounter(VideoCore::QueryType type) override;
     void Query(GPUVAddr gpu_addr, VideoCore::QueryType type, std::optional<u64> timestamp) override;
+    bool IsQueryPending(GPUVAddr gpu_addr, u64 size) override;
+    bool AccelerateConditionalRendering(GPUVAddr compare_addr, bool equal) override;
+    void DisableConditionalRendering() override;
     void BindGraphicsUniformBuffer(size_t stage, u32 index, GPUVAddr gpu_addr, u32 size) override;
     void DisableGraphicsUniformBuffer(size_t stage, u32 index) override;
+    void PrepareGraphicsShader(size_t program) override;
     void FlushAll() override;
     void FlushRegion(VAddr addr, u64 size) override;
     bool MustFlushRegion(VAddr addr, u64 size) override;
@@ -102,6 +112,7 @@ public:
     void TiledCacheBarrier() override;
     void FlushCommands() override;
     void TickFrame() override;
+    VideoCore::RasterizerMemoryUsage GetMemoryUsage() const override;
     bool AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Surface& src,
                                const Tegra::Engines::Fermi2D::Surface& dst,
                                const Tegra::Engines::Fermi2D::Config& copy_config) override;
@@ -111,6 +122,9 @@ public:
     void LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                            const VideoCore::DiskResourceLoadCallback& callback) override;
 
+    /// Issues the draws merged so far, anything else sent to the OpenGL server must come after it.
+    void FlushDrawBatch();
+
     /// Returns true when there are commands queued to the OpenGL server.
     bool AnyCommandQueued() const {
         return num_queued_commands > 0;
@@ -124,15 +138,69 @@ public:
         return async_shaders;
     }
 
+    GPUProfiler& GetGPUProfiler() {
+        return gpu_profiler;
+    }
+
 private:
     static constexpr size_t MAX_TEXTURES = 192;
     static constexpr size_t MAX_IMAGES = 48;
     static constexpr size_t MAX_IMAGE_VIEWS = MAX_TEXTURES + MAX_IMAGES;
 
+    /// Handles padded to the 16 bytes stride of the std140 array that contains them
+    using BindlessHandles = std::array<std::array<GLuint64, 2>, MAX_TEXTURES>;
+
+    /// Maximum number of draws merged into a single indirect draw
+    static constexpr size_t MAX_BATCHED_DRAWS = 512;
+
+    struct DrawArraysIndirectCommand {
+        GLuint count;
+        GLuint instance_count;
+        GLuint first;
+        GLuint base_instance;
+    };
+
+    struct DrawElementsIndirectCommand {
+        GLuint count;
+        GLuint instance_count;
+        GLuint first_index;
+        GLint base_vertex;
+        GLuint base_instance;
+    };
+
+    /// Run of draws that share all their state except for their vertex, index and instance ranges
+    struct DrawBatch {
+        size_t NumDraws() const noexcept {
+            return is_indexed ? elements.size() : arrays.size();
+        }
+
+        Maxwell regs{};
+        GLenum primitive_mode{};
+        GLenum index_format{};
+        u32 index_size{};
+        GLuint base_index{}; ///< Index in the bound index buffer where the guest index array starts
+        bool is_indexed{};
+        std::vector<DrawArraysIndirectCommand> arrays;
+        std::vector<DrawElementsIndirectCommand> elements;
+    };
+
     void BindComputeTextures(Shader* kernel);
 
-    void BindTextures(const ShaderEntries& entries, GLuint base_texture, GLuint base_image,
-                      size_t& image_view_index, size_t& texture_index, size_t& image_index);
+    void BindTextures(const ShaderEntries& entries, size_t stage, GLuint base_texture,
+                      GLuint base_image, size_t& image_view_index, size_t& texture_index,
+                      size_t& image_index);
+
+    /// Starts a batch with the current draw, returns false when it has to be issued directly
+    bool StartDrawBatch(bool is_indexed, bool is_instanced, GLenum primitive_mode);
+
+    /// Merges the current draw into the pending batch, returns false when they are not compatible
+    bool AppendToDrawBatch(bool is_indexed, bool is_instanced);
+
+    /// Records the ranges of the current draw in the pending batch
+    void AddBatchedDraw(bool is_instanced);
+
+    /// Uploads the bindless texture handles of a stage when they differ from the bound ones
+    void UpdateBindlessHandles(size_t stage, std::span<const std::array<GLuint64, 2>> handles);
 
     /// Configures the current textures to use for the draw command.
     void SetupDrawTextures(const Shader* shader, size_t stage_index);
@@ -188,6 +256,12 @@ private:
     /// Syncs the scissor test state to match the guest state
     void SyncScissorTest();
 
+    /// Binds the framebuffer of the render targets, beginning a render pass in GPU profiles
+    void BindFramebuffer(const Framebuffer* framebuffer);
+
+    /// Resyncs viewports and scissors when the scale of the bound render targets has changed
+    void SyncRenderScale();
+
     /// Syncs the point state to match the guest state
     void SyncPointState();
 
@@ -228,7 +302,14 @@ private:
     /// End a transform feedback
     void EndTransformFeedback();
 
-    void SetupShaders(bool is_indexed);
+    /// Begin conditional rendering when the guest condition is evaluated on the host
+    void BeginConditionalRender();
+
+    /// End conditional rendering when the guest condition is evaluated on the host
+    void EndConditionalRender();
+
+    /// Binds the shaders of the draw, returns false when one of them hasn't been built yet
+    bool SetupShaders(bool is_indexed);
 
     Tegra::GPU& gpu;
     Tegra::Engines::Maxwell3D& maxwell3d;
@@ -240,27 +321,41 @@ private:
     ProgramManager& program_manager;
     StateTracker& state_tracker;
 
+    GPUProfiler gpu_profiler;
     TextureCacheRuntime texture_cache_runtime;
     TextureCache texture_cache;
     BufferCacheRuntime buffer_cache_runtime;
     BufferCache buffer_cache;
     ShaderCacheOpenGL shader_cache;
     QueryCache query_cache;
+    std::shared_ptr<HostCounter> conditional_counter;
+    bool conditional_inverted = false;
     AccelerateDMA accelerate_dma;
     FenceManagerOpenGL fence_manager;
 
     VideoCommon::Shader::AsyncShaders async_shaders;
 
     boost::container::static_vector<u32, MAX_IMAGE_VIEWS> image_view_indices;
+    boost::container::static_vector<u32, MAX_IMAGE_VIEWS> native_image_view_indices;
     std::array<ImageViewId, MAX_IMAGE_VIEWS> image_view_ids;
     boost::container::static_vector<GLuint, MAX_TEXTURES> sampler_handles;
     std::array<GLuint, MAX_TEXTURES> texture_handles{};
     std::array<GLuint, MAX_IMAGES> image_handles{};
 
+    std::array<OGLBuffer, Tegra::Engines::MaxShaderTypes> bindless_buffers;
+    std::array<BindlessHandles, Tegra::Engines::MaxShaderTypes> bound_bindless_handles{};
+    std::array<size_t, Tegra::Engines::MaxShaderTypes> num_bound_bindless_handles{};
+
+    DrawBatch draw_batch;
+    OGLBuffer draw_indirect_buffer;
+
     /// Number of commands queued to the OpenGL driver. Resetted on flush.
     std::size_t num_queued_commands = 0;
 
     u32 last_clip_distance_mask = 0;
+
+    float render_scale = 1.0f;
+    bool uses_frag_coord = false;
 };
 
 } // namespace OpenGL
@@ -2,12 +2,12 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <atomic>
 #include <functional>
-#include <mutex>
+#include <limits>
 #include <optional>
 #include <string>
-#include <thread>
 #include <unordered_set>
 
 #include "common/alignment.h"
@@ -16,6 +16,7 @@
 #include "common/scope_exit.h"
 #include "core/core.h"
 #include "core/frontend/emu_window.h"
+#include "core/perf_stats.h"
 #include "video_core/engines/kepler_compute.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/engines/shader_type.h"
@@ -26,8 +27,10 @@
 #include "video_core/renderer_opengl/gl_shader_cache.h"
 #include "video_core/renderer_opengl/gl_shader_decompiler.h"
 #include "video_core/renderer_opengl/gl_shader_disk_cache.h"
+#include "video_core/renderer_opengl/gl_shader_util.h"
 #include "video_core/renderer_opengl/gl_state_tracker.h"
 #include "video_core/shader/memory_util.h"
+#include "video_core/shader/prewarm_scheduler.h"
 #include "video_core/shader/registry.h"
 #include "video_core/shader/shader_ir.h"
 #include "video_core/shader_cache.h"
@@ -43,12 +46,20 @@ using VideoCommon::Shader::KERNEL_MAIN_OFFSET;
 using VideoCommon::Shader::ProgramCode;
 using VideoCommon::Shader::Registry;
 using VideoCommon::Shader::ShaderIR;
+using VideoCommon::Shader::SpecializationKeys;
+using VideoCommon::Shader::SpecializationValues;
 using VideoCommon::Shader::STAGE_MAIN_OFFSET;
 
 namespace {
 
 constexpr VideoCommon::Shader::CompilerSettings COMPILER_SETTINGS{};
 
+/// Draws with the same const buffer values before a variant specialized on them is queued
+constexpr u32 SPECIALIZATION_THRESHOLD = 64;
+
+/// Distinct values a shader is specialized on, more than this are drawn with the generic program
+constexpr std::size_t MAX_SHADER_VARIANTS = 8;
+
 /// Gets the shader type from a Maxwell program type
 constexpr GLenum GetGLShaderType(ShaderType shader_type) {
     switch (shader_type) {
@@ -123,24 +134,24 @@ std::string MakeShaderID(u64 unique_identifier, ShaderType shader_type) {
 }
 
 std::shared_ptr<Registry> MakeRegistry(const ShaderDiskCacheEntry& entry) {
-    const VideoCore::GuestDriverProfile guest_profile{entry.texture_handler_size};
-    const VideoCommon::Shader::SerializedRegistryInfo info{guest_profile, entry.bound_buffer,
-                                                           entry.graphics_info, entry.compute_info};
-    auto registry = std::make_shared<Registry>(entry.type, info);
-    for (const auto& [address, value] : entry.keys) {
-        const auto [buffer, offset] = address;
-        registry->InsertKey(buffer, offset, value);
-    }
-    for (const auto& [offset, sampler] : entry.bound_samplers) {
-        registry->InsertBoundSampler(offset, sampler);
-    }
-    for (const auto& [key, sampler] : entry.bindless_samplers) {
-        const auto [buffer, offset] = key;
-        registry->InsertBindlessSampler(buffer, offset, sampler);
-    }
+    auto registry = std::make_shared<Registry>(entry.type, entry.GetRegistryInfo());
+    entry.FillRegistry(*registry);
     return registry;
 }
 
+SpecializationKeys MakeSpecializationKeys(const Device& device, const ShaderIR& ir,
+                                          ShaderType shader_type) {
+    if (!device.UseShaderSpecialization() || shader_type == ShaderType::Compute) {
+        return {};
+    }
+    return ir.FindSpecializationKeys();
+}
+
+GLuint GetProgramHandle(const ProgramHandle& program) {
+    const GLuint assembly_handle = program.assembly_program.handle;
+    return assembly_handle != 0 ? assembly_handle : program.source_program.handle;
+}
+
 std::unordered_set<GLenum> GetSupportedFormats() {
     GLint num_formats;
     glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
@@ -158,7 +169,8 @@ std::unordered_set<GLenum> GetSupportedFormats() {
 } // Anonymous namespace
 
 ProgramSharedPtr BuildShader(const Device& device, ShaderType shader_type, u64 unique_identifier,
-                             const ShaderIR& ir, const Registry& registry, bool hint_retrievable) {
+                             const ShaderIR& ir, const Registry& registry, bool hint_retrievable,
+                             bool parallel_compile) {
     if (device.UseDriverCache()) {
         // Ignore hint retrievable if we are using the driver cache
         hint_retrievable = false;
@@ -192,6 +204,11 @@ ProgramSharedPtr BuildShader(const Device& device, ShaderType shader_type, u64 u
         }
     } else {
         const std::string glsl = DecompileShader(device, ir, registry, shader_type, shader_id);
+        if (parallel_compile) {
+            program->source_program.handle = GLShader::LoadProgramParallel(
+                glsl, GetGLShaderType(shader_type), hint_retrievable);
+            return program;
+        }
         OGLShader shader;
         shader.Create(glsl.c_str(), GetGLShaderType(shader_type));
 
@@ -202,13 +219,10 @@ ProgramSharedPtr BuildShader(const Device& device, ShaderType shader_type, u64 u
 }
 
 Shader::Shader(std::shared_ptr<Registry> registry_, ShaderEntries entries_,
-               ProgramSharedPtr program_, bool is_built_)
+               ProgramSharedPtr program_, bool is_built_, SpecializationKeys specialization_keys_)
     : registry{std::move(registry_)}, entries{std::move(entries_)}, program{std::move(program_)},
-      is_built{is_built_} {
-    handle = program->assembly_program.handle;
-    if (handle == 0) {
-        handle = program->source_program.handle;
-    }
+      specialization_keys{std::move(specialization_keys_)}, is_built{is_built_} {
+    handle = GetProgramHandle(*program);
     if (is_built) {
         ASSERT(handle != 0);
     }
@@ -221,7 +235,11 @@ GLuint Shader::GetHandle() const {
     return handle;
 }
 
-bool Shader::IsBuilt() const {
+bool Shader::IsBuilt() {
+    if (is_linking && GLShader::IsProgramLinked(handle)) {
+        is_linking = false;
+        is_built = true;
+    }
     return is_built;
 }
 
@@ -239,51 +257,57 @@ void Shader::AsyncGLASMBuilt(OGLAssemblyProgram new_program) {
 
 std::unique_ptr<Shader> Shader::CreateStageFromMemory(
     const ShaderParameters& params, Maxwell::ShaderProgram program_type, ProgramCode code,
-    ProgramCode code_b, VideoCommon::Shader::AsyncShaders& async_shaders, VAddr cpu_addr) {
+    ProgramCode code_b, VideoCommon::Shader::AsyncShaders& async_shaders,
+    VideoCommon::Shader::ShaderPredecoder& predecoder, VAddr cpu_addr) {
     const auto shader_type = GetShaderType(program_type);
 
     auto& gpu = params.gpu;
     gpu.ShaderNotify().MarkSharderBuilding();
 
     auto registry = std::make_shared<Registry>(shader_type, gpu.Maxwell3D());
+    const auto predecoded = predecoder.Take(params.unique_identifier, *registry);
+    std::optional<ShaderIR> decoded_ir;
+    const ShaderIR& ir = predecoded ? predecoded->ir
+                                    : decoded_ir.emplace(code, STAGE_MAIN_OFFSET,
+                                                         COMPILER_SETTINGS, *registry);
     if (!async_shaders.IsShaderAsync(gpu) || !params.device.UseAsynchronousShaders()) {
-        const ShaderIR ir(code, STAGE_MAIN_OFFSET, COMPILER_SETTINGS, *registry);
         // TODO(Rodrigo): Handle VertexA shaders
         // std::optional<ShaderIR> ir_b;
         // if (!code_b.empty()) {
         //     ir_b.emplace(code_b, STAGE_MAIN_OFFSET);
         // }
-        auto program =
-            BuildShader(params.device, shader_type, params.unique_identifier, ir, *registry);
+        // Draws are skipped until the driver has linked it, like with asynchronous workers
+        const bool parallel_compile =
+            params.device.UseParallelShaderCompile() && async_shaders.IsShaderAsync(gpu);
+        auto program = BuildShader(params.device, shader_type, params.unique_identifier, ir,
+                                   *registry, false, parallel_compile);
         ShaderDiskCacheEntry entry;
         entry.type = shader_type;
         entry.code = std::move(code);
         entry.code_b = std::move(code_b);
         entry.unique_identifier = params.unique_identifier;
-        entry.bound_buffer = registry->GetBoundBuffer();
-        entry.graphics_info = registry->GetGraphicsInfo();
-        entry.keys = registry->GetKeys();
-        entry.bound_samplers = registry->GetBoundSamplers();
-        entry.bindless_samplers = registry->GetBindlessSamplers();
+        entry.CopyRegistry(*registry);
         params.disk_cache.SaveEntry(std::move(entry));
 
         gpu.ShaderNotify().MarkShaderComplete();
 
-        return std::unique_ptr<Shader>(new Shader(std::move(registry),
-                                                  MakeEntries(params.device, ir, shader_type),
-                                                  std::move(program), true));
+        auto shader = std::unique_ptr<Shader>(new Shader(
+            std::move(registry), MakeEntries(params.device, ir, shader_type), std::move(program),
+            !parallel_compile, MakeSpecializationKeys(params.device, ir, shader_type)));
+        shader->is_linking = parallel_compile;
+        return shader;
     } else {
-        // Required for entries
-        const ShaderIR ir(code, STAGE_MAIN_OFFSET, COMPILER_SETTINGS, *registry);
         auto entries = MakeEntries(params.device, ir, shader_type);
+        auto specialization_keys = MakeSpecializationKeys(params.device, ir, shader_type);
 
         async_shaders.QueueOpenGLShader(params.device, shader_type, params.unique_identifier,
                                         std::move(code), std::move(code_b), STAGE_MAIN_OFFSET,
                                         COMPILER_SETTINGS, *registry, cpu_addr);
 
         auto program = std::make_shared<ProgramHandle>();
-        return std::unique_ptr<Shader>(
-            new Shader(std::move(registry), std::move(entries), std::move(program), false));
+        return std::unique_ptr<Shader>(new Shader(std::move(registry), std::move(entries),
+                                                  std::move(program), false,
+                                                  std::move(specialization_keys)));
     }
 }
 
@@ -301,11 +325,7 @@ std::unique_ptr<Shader> Shader::CreateKernelFromMemory(const ShaderParameters& p
     entry.type = ShaderType::Compute;
     entry.code = std::move(code);
     entry.unique_identifier = uid;
-    entry.bound_buffer = registry->GetBoundBuffer();
-    entry.compute_info = registry->GetComputeInfo();
-    entry.keys = registry->GetKeys();
-    entry.bound_samplers = registry->GetBoundSamplers();
-    entry.bindless_samplers = registry->GetBindlessSamplers();
+    entry.CopyRegistry(*registry);
     params.disk_cache.SaveEntry(std::move(entry));
 
     gpu.ShaderNotify().MarkShaderComplete();
@@ -317,8 +337,10 @@ std::unique_ptr<Shader> Shader::CreateKernelFromMemory(const ShaderParameters& p
 
 std::unique_ptr<Shader> Shader::CreateFromCache(const ShaderParameters& params,
                                                 const PrecompiledShader& precompiled_shader) {
-    return std::unique_ptr<Shader>(new Shader(
-        precompiled_shader.registry, precompiled_shader.entries, precompiled_shader.program));
+    return std::unique_ptr<Shader>(new Shader(precompiled_shader.registry,
+                                              precompiled_shader.entries,
+                                              precompiled_shader.program, true,
+                                              precompiled_shader.specialization_keys));
 }
 
 ShaderCacheOpenGL::ShaderCacheOpenGL(RasterizerOpenGL& rasterizer_,
@@ -327,7 +349,16 @@ ShaderCacheOpenGL::ShaderCacheOpenGL(RasterizerOpenGL& rasterizer_,
                                      Tegra::Engines::KeplerCompute& kepler_compute_,
                                      Tegra::MemoryManager& gpu_memory_, const Device& device_)
     : ShaderCache{rasterizer_}, emu_window{emu_window_}, gpu{gpu_}, gpu_memory{gpu_memory_},
-      maxwell3d{maxwell3d_}, kepler_compute{kepler_compute_}, device{device_} {}
+      maxwell3d{maxwell3d_}, kepler_compute{kepler_compute_}, device{device_} {
+    if (device.UseParallelShaderCompile()) {
+        // Let the driver decide how many threads it compiles with
+        if (GLAD_GL_KHR_parallel_shader_compile) {
+            glMaxShaderCompilerThreadsKHR(std::numeric_limits<GLuint>::max());
+        } else {
+            glMaxShaderCompilerThreadsARB(std::numeric_limits<GLuint>::max());
+        }
+    }
+}
 
 ShaderCacheOpenGL::~ShaderCacheOpenGL() = default;
 
@@ -344,8 +375,10 @@ void ShaderCacheOpenGL::LoadDiskCache(u64 title_id, std::stop_token stop_loading
     }
 
     std::vector<ShaderDiskCachePrecompiled> gl_cache;
-    if (!device.UseAssemblyShaders() && !device.UseDriverCache()) {
-        // Only load precompiled cache when we are not using assembly shaders
+    if (!device.UseAssemblyShaders() && !device.UseDriverCache() &&
+        !device.UseBindlessTextures()) {
+        // Only load precompiled cache when we are not using assembly shaders, binaries built with
+        // bindless textures would be shared with the ones built without them
         gl_cache = disk_cache.LoadPrecompiled();
     }
     const auto supported_formats = GetSupportedFormats();
@@ -359,7 +392,6 @@ void ShaderCacheOpenGL::LoadDiskCache(u64 title_id, std::stop_token stop_loading
         callback(VideoCore::LoadCallbackStage::Build, 0, transferable->size());
     }
 
-    std::mutex mutex;
     std::size_t built_shaders = 0; // It doesn't have be atomic since it's used behind a mutex
     std::atomic_bool gl_cache_failed = false;
 
@@ -367,67 +399,54 @@ void ShaderCacheOpenGL::LoadDiskCache(u64 title_id, std::stop_token stop_loading
         return std::ranges::find(gl_cache, id, &ShaderDiskCachePrecompiled::unique_identifier);
     };
 
-    const auto worker = [&](Core::Frontend::GraphicsContext* context, std::size_t begin,
-                            std::size_t end) {
-        const auto scope = context->Acquire();
+    VideoCommon::Shader::PrewarmScheduler scheduler;
 
-        for (std::size_t i = begin; i < end; ++i) {
-            if (stop_loading.stop_requested()) {
-                return;
-            }
-            const auto& entry = (*transferable)[i];
-            const u64 uid = entry.unique_identifier;
-            const auto it = find_precompiled(uid);
-            const auto precompiled_entry = it != gl_cache.end() ? &*it : nullptr;
-
-            const bool is_compute = entry.type == ShaderType::Compute;
-            const u32 main_offset = is_compute ? KERNEL_MAIN_OFFSET : STAGE_MAIN_OFFSET;
-            auto registry = MakeRegistry(entry);
-            const ShaderIR ir(entry.code, main_offset, COMPILER_SETTINGS, *registry);
-
-            ProgramSharedPtr program;
-            if (precompiled_entry) {
-                // If the shader is precompiled, attempt to load it with
-                program = GeneratePrecompiledProgram(entry, *precompiled_entry, supported_formats);
-                if (!program) {
-                    gl_cache_failed = true;
-                }
-            }
-            if (!program) {
-                // Otherwise compile it from GLSL
-                program = BuildShader(device, entry.type, uid, ir, *registry, true);
-            }
+    // On some platforms the shared context has to be created from the GUI thread
+    std::vector<std::unique_ptr<Core::Frontend::GraphicsContext>> contexts(
+        scheduler.NumWorkers());
+    for (auto& context : contexts) {
+        context = emu_window.CreateSharedContext();
+    }
+    const auto make_state = [&contexts](std::size_t worker) { return contexts[worker]->Acquire(); };
+
+    std::vector<PrecompiledShader> shaders(transferable->size());
+    const auto build = [&](std::size_t index) {
+        const auto& entry = (*transferable)[index];
+        const u64 uid = entry.unique_identifier;
+        const auto it = find_precompiled(uid);
+        const auto precompiled_entry = it != gl_cache.end() ? &*it : nullptr;
 
-            PrecompiledShader shader;
-            shader.program = std::move(program);
-            shader.registry = std::move(registry);
-            shader.entries = MakeEntries(device, ir, entry.type);
+        const bool is_compute = entry.type == ShaderType::Compute;
+        const u32 main_offset = is_compute ? KERNEL_MAIN_OFFSET : STAGE_MAIN_OFFSET;
+        auto registry = MakeRegistry(entry);
+        const ShaderIR ir(entry.code, main_offset, COMPILER_SETTINGS, *registry);
 
-            std::scoped_lock lock{mutex};
-            if (callback) {
-                callback(VideoCore::LoadCallbackStage::Build, ++built_shaders,
-                         transferable->size());
+        ProgramSharedPtr program;
+        if (precompiled_entry) {
+            // If the shader is precompiled, attempt to load it with
+            program = GeneratePrecompiledProgram(entry, *precompiled_entry, supported_formats);
+            if (!program) {
+                gl_cache_failed = true;
             }
-            runtime_cache.emplace(entry.unique_identifier, std::move(shader));
         }
-    };
-
-    const std::size_t num_workers{std::max(1U, std::thread::hardware_concurrency())};
-    const std::size_t bucket_size{transferable->size() / num_workers};
-    std::vector<std::unique_ptr<Core::Frontend::GraphicsContext>> contexts(num_workers);
-    std::vector<std::thread> threads(num_workers);
-    for (std::size_t i = 0; i < num_workers; ++i) {
-        const bool is_last_worker = i + 1 == num_workers;
-        const std::size_t start{bucket_size * i};
-        const std::size_t end{is_last_worker ? transferable->size() : start + bucket_size};
+        if (!program) {
+            // Otherwise compile it from GLSL
+            program = BuildShader(device, entry.type, uid, ir, *registry, true);
+        }
 
-        // On some platforms the shared context has to be created from the GUI thread
-        contexts[i] = emu_window.CreateSharedContext();
-        threads[i] = std::thread(worker, contexts[i].get(), start, end);
-    }
-    for (auto& thread : threads) {
-        thread.join();
-    }
+        PrecompiledShader& shader = shaders[index];
+        shader.program = std::move(program);
+        shader.registry = std::move(registry);
+        shader.entries = MakeEntries(device, ir, entry.type);
+        shader.specialization_keys = MakeSpecializationKeys(device, ir, entry.type);
+    };
+    const auto on_built = [&](std::size_t index) {
+        if (callback) {
+            callback(VideoCore::LoadCallbackStage::Build, ++built_shaders, transferable->size());
+        }
+        runtime_cache.emplace((*transferable)[index].unique_identifier, std::move(shaders[index]));
+    };
+    scheduler.Run(transferable->size(), {}, stop_loading, make_state, build, on_built);
 
     if (gl_cache_failed) {
         // Invalidate the precompiled cache if a shader dumped shader was rejected
@@ -439,8 +458,9 @@ void ShaderCacheOpenGL::LoadDiskCache(u64 title_id, std::stop_token stop_loading
         return;
     }
 
-    if (device.UseAssemblyShaders() || device.UseDriverCache()) {
-        // Don't store precompiled binaries for assembly shaders or when using the driver cache
+    if (device.UseAssemblyShaders() || device.UseDriverCache() || device.UseBindlessTextures()) {
+        // Don't store precompiled binaries for assembly shaders, when using the driver cache or
+        // with bindless textures
         return;
     }
 
@@ -487,6 +507,27 @@ ProgramSharedPtr ShaderCacheOpenGL::GeneratePrecompiledProgram(
     return program;
 }
 
+void ShaderCacheOpenGL::PrepareStageProgram(Maxwell::ShaderProgram program) {
+    // VertexA programs are identified together with their VertexB pair, leave them to the draw
+    if (program == Maxwell::ShaderProgram::VertexA) {
+        return;
+    }
+    const GPUVAddr address{GetShaderAddress(maxwell3d, program)};
+    const std::optional<VAddr> cpu_addr{gpu_memory.GpuToCpuAddress(address)};
+    if (!cpu_addr || TryGet(*cpu_addr)) {
+        return;
+    }
+    const u8* const host_ptr{gpu_memory.GetPointer(address)};
+    ProgramCode code{GetShaderCode(gpu_memory, address, host_ptr, false)};
+    const ShaderType shader_type = GetShaderType(program);
+    const u64 unique_identifier = GetUniqueIdentifier(shader_type, false, code);
+    if (runtime_cache.contains(unique_identifier)) {
+        return;
+    }
+    predecoder.Queue(shader_type, unique_identifier, std::move(code), STAGE_MAIN_OFFSET,
+                     COMPILER_SETTINGS, maxwell3d);
+}
+
 Shader* ShaderCacheOpenGL::GetStageProgram(Maxwell::ShaderProgram program,
                                            VideoCommon::Shader::AsyncShaders& async_shaders) {
     if (!maxwell3d.dirty.flags[Dirty::Shaders]) {
@@ -499,34 +540,7 @@ Shader* ShaderCacheOpenGL::GetStageProgram(Maxwell::ShaderProgram program,
     const GPUVAddr address{GetShaderAddress(maxwell3d, program)};
 
     if (device.UseAsynchronousShaders() && async_shaders.HasCompletedWork()) {
-        auto completed_work = async_shaders.GetCompletedWork();
-        for (auto& work : completed_work) {
-            Shader* shader = TryGet(work.cpu_address);
-            gpu.ShaderNotify().MarkShaderComplete();
-            if (shader == nullptr) {
-                continue;
-            }
-            using namespace VideoCommon::Shader;
-            if (work.backend == AsyncShaders::Backend::OpenGL) {
-                shader->AsyncOpenGLBuilt(std::move(work.program.opengl));
-            } else if (work.backend == AsyncShaders::Backend::GLASM) {
-                shader->AsyncGLASMBuilt(std::move(work.program.glasm));
-            }
-
-            auto& registry = shader->GetRegistry();
-
-            ShaderDiskCacheEntry entry;
-            entry.type = work.shader_type;
-            entry.code = std::move(work.code);
-            entry.code_b = std::move(work.code_b);
-            entry.unique_identifier = work.uid;
-            entry.bound_buffer = registry.GetBoundBuffer();
-            entry.graphics_info = registry.GetGraphicsInfo();
-            entry.keys = registry.GetKeys();
-            entry.bound_samplers = registry.GetBoundSamplers();
-            entry.bindless_samplers = registry.GetBindlessSamplers();
-            disk_cache.SaveEntry(std::move(entry));
-        }
+        ProcessCompletedShaders(async_shaders);
     }
 
     // Look up shader in the cache based on address
@@ -549,6 +563,7 @@ Shader* ShaderCacheOpenGL::GetStageProgram(Maxwell::ShaderProgram program,
 
     const u64 unique_identifier = GetUniqueIdentifier(
         GetShaderType(program), program == Maxwell::ShaderProgram::VertexA, code, code_b);
+    disk_cache.MarkUsed(unique_identifier);
 
     const ShaderParameters params{gpu,       maxwell3d, disk_cache,       device,
                                   *cpu_addr, host_ptr,  unique_identifier};
@@ -556,8 +571,10 @@ Shader* ShaderCacheOpenGL::GetStageProgram(Maxwell::ShaderProgram program,
     std::unique_ptr<Shader> shader;
     const auto found = runtime_cache.find(unique_identifier);
     if (found == runtime_cache.end()) {
+        const Core::ScopedStall stall{maxwell3d.System().GetPerfStats(),
+                                      Core::StallCause::ShaderCompile};
         shader = Shader::CreateStageFromMemory(params, program, std::move(code), std::move(code_b),
-                                               async_shaders, cpu_addr.value_or(0));
+                                               async_shaders, predecoder, cpu_addr.value_or(0));
     } else {
         shader = Shader::CreateFromCache(params, found->second);
     }
@@ -572,6 +589,123 @@ Shader* ShaderCacheOpenGL::GetStageProgram(Maxwell::ShaderProgram program,
     return last_shaders[static_cast<std::size_t>(program)] = result;
 }
 
+GLuint ShaderCacheOpenGL::GetStageHandle(Shader& shader, Maxwell::ShaderProgram program,
+                                         VideoCommon::Shader::AsyncShaders& async_shaders) {
+    if (!shader.IsBuilt()) {
+        return 0;
+    }
+    const SpecializationKeys& keys = shader.GetSpecializationKeys();
+    if (keys.empty()) {
+        return shader.GetHandle();
+    }
+    const ShaderType shader_type = GetShaderType(program);
+    SpecializationValues values{};
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        values[i] = maxwell3d.AccessConstBuffer32(shader_type, keys[i].first, keys[i].second);
+    }
+    std::vector<ShaderVariant>& variants = shader.GetVariants();
+    auto it = std::ranges::find(variants, values, &ShaderVariant::values);
+    if (it == variants.end()) {
+        if (variants.size() >= MAX_SHADER_VARIANTS) {
+            // The values change too often for variants to pay off
+            return shader.GetHandle();
+        }
+        it = variants.insert(variants.end(), ShaderVariant{.values = values});
+    }
+    if (it->is_linking && GLShader::IsProgramLinked(it->program->source_program.handle)) {
+        it->is_linking = false;
+    }
+    if (it->program && !it->is_linking) {
+        return GetProgramHandle(*it->program);
+    }
+    if (!it->is_queued && ++it->num_uses >= SPECIALIZATION_THRESHOLD) {
+        QueueVariant(shader, *it, program, async_shaders);
+    } else if (it->is_queued && async_shaders.HasCompletedWork()) {
+        // Shaders are usually not dirty while the same program is drawn, pick up variants here
+        ProcessCompletedShaders(async_shaders);
+        if (it->program && !it->is_linking) {
+            return GetProgramHandle(*it->program);
+        }
+    }
+    return shader.GetHandle();
+}
+
+void ShaderCacheOpenGL::QueueVariant(Shader& shader, ShaderVariant& variant,
+                                     Maxwell::ShaderProgram program,
+                                     VideoCommon::Shader::AsyncShaders& async_shaders) {
+    variant.is_queued = true;
+
+    const GPUVAddr address{GetShaderAddress(maxwell3d, program)};
+    const std::optional<VAddr> cpu_addr{gpu_memory.GpuToCpuAddress(address)};
+    if (!cpu_addr) {
+        return;
+    }
+    // The shader is still registered, so its code hasn't been modified since it was built
+    const u8* const host_ptr{gpu_memory.GetPointer(address)};
+    ProgramCode code{GetShaderCode(gpu_memory, address, host_ptr, false)};
+    const ShaderType shader_type = GetShaderType(program);
+    const u64 unique_identifier = GetUniqueIdentifier(shader_type, false, code);
+
+    Registry registry = shader.GetRegistry();
+    const SpecializationKeys& keys = shader.GetSpecializationKeys();
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        registry.InsertSpecializedKey(keys[i].first, keys[i].second, variant.values[i]);
+    }
+    variant.unique_identifier = unique_identifier;
+    if (device.UseParallelShaderCompile()) {
+        const ShaderIR ir(code, STAGE_MAIN_OFFSET, COMPILER_SETTINGS, registry);
+        variant.program =
+            BuildShader(device, shader_type, unique_identifier, ir, registry, false, true);
+        variant.is_linking = true;
+        return;
+    }
+    gpu.ShaderNotify().MarkSharderBuilding();
+    async_shaders.QueueOpenGLShader(device, shader_type, unique_identifier, std::move(code), {},
+                                    STAGE_MAIN_OFFSET, COMPILER_SETTINGS, registry, *cpu_addr,
+                                    variant.values);
+}
+
+void ShaderCacheOpenGL::ProcessCompletedShaders(VideoCommon::Shader::AsyncShaders& async_shaders) {
+    auto completed_work = async_shaders.GetCompletedWork();
+    for (auto& work : completed_work) {
+        Shader* shader = TryGet(work.cpu_address);
+        gpu.ShaderNotify().MarkShaderComplete();
+        if (shader == nullptr) {
+            continue;
+        }
+        using namespace VideoCommon::Shader;
+        if (work.specialization) {
+            // Variants are not stored in the disk cache, they are rebuilt from the generic shader
+            std::vector<ShaderVariant>& variants = shader->GetVariants();
+            const auto it = std::ranges::find(variants, *work.specialization,
+                                              &ShaderVariant::values);
+            if (it == variants.end() || it->unique_identifier != work.uid) {
+                continue;
+            }
+            auto program = std::make_shared<ProgramHandle>();
+            program->source_program = std::move(work.program.opengl);
+            program->assembly_program = std::move(work.program.glasm);
+            it->program = std::move(program);
+            continue;
+        }
+        if (work.backend == AsyncShaders::Backend::OpenGL) {
+            shader->AsyncOpenGLBuilt(std::move(work.program.opengl));
+        } else if (work.backend == AsyncShaders::Backend::GLASM) {
+            shader->AsyncGLASMBuilt(std::move(work.program.glasm));
+        }
+
+        auto& registry = shader->GetRegistry();
+
+        ShaderDiskCacheEntry entry;
+        entry.type = work.shader_type;
+        entry.code = std::move(work.code);
+        entry.code_b = std::move(work.code_b);
+        entry.unique_identifier = work.uid;
+        entry.CopyRegistry(registry);
+        disk_cache.SaveEntry(std::move(entry));
+    }
+}
+
 Shader* ShaderCacheOpenGL::GetComputeKernel(GPUVAddr code_addr) {
     const std::optional<VAddr> cpu_addr{gpu_memory.GpuToCpuAddress(code_addr)};
 
@@ -584,6 +718,7 @@ Shader* ShaderCacheOpenGL::GetComputeKernel(GPUVAddr code_addr) {
     ProgramCode code{GetShaderCode(gpu_memory, code_addr, host_ptr, true)};
     const std::size_t code_size{code.size() * sizeof(u64)};
     const u64 unique_identifier{GetUniqueIdentifier(ShaderType::Compute, false, code)};
+    disk_cache.MarkUsed(unique_identifier);
 
     const ShaderParameters params{gpu,       kepler_compute, disk_cache,       device,
                                   *cpu_addr, host_ptr,       unique_identifier};
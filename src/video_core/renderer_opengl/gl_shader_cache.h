@@ -21,6 +21,7 @@
 #include "video_core/renderer_opengl/gl_resource_manager.h"
 #include "video_core/renderer_opengl/gl_shader_decompiler.h"
 #include "video_core/renderer_opengl/gl_shader_disk_cache.h"
+#include "video_core/shader/predecoder.h"
 #include "video_core/shader/registry.h"
 #include "video_core/shader/shader_ir.h"
 #include "video_core/shader_cache.h"
@@ -54,6 +55,17 @@ struct PrecompiledShader {
     ProgramSharedPtr program;
     std::shared_ptr<VideoCommon::Shader::Registry> registry;
     ShaderEntries entries;
+    VideoCommon::Shader::SpecializationKeys specialization_keys;
+};
+
+/// Program built with the values of the const buffer words a shader branches on folded in
+struct ShaderVariant {
+    VideoCommon::Shader::SpecializationValues values{};
+    ProgramSharedPtr program; ///< Null until the variant has been built
+    u64 unique_identifier = 0;
+    u32 num_uses = 0;
+    bool is_queued = false;
+    bool is_linking = false; ///< The driver is still compiling the program in parallel
 };
 
 struct ShaderParameters {
@@ -66,10 +78,12 @@ struct ShaderParameters {
     u64 unique_identifier;
 };
 
+/// Builds a program for a shader. With parallel_compile, the GLSL program is still being linked
+/// when this returns and GLShader::IsProgramLinked has to be polled before using it.
 ProgramSharedPtr BuildShader(const Device& device, Tegra::Engines::ShaderType shader_type,
                              u64 unique_identifier, const VideoCommon::Shader::ShaderIR& ir,
                              const VideoCommon::Shader::Registry& registry,
-                             bool hint_retrievable = false);
+                             bool hint_retrievable = false, bool parallel_compile = false);
 
 class Shader final {
 public:
@@ -78,7 +92,8 @@ public:
     /// Gets the GL program handle for the shader
     GLuint GetHandle() const;
 
-    bool IsBuilt() const;
+    /// Returns true when the shader can be drawn with, polling the driver while it's linked
+    bool IsBuilt();
 
     /// Gets the shader entries for the shader
     const ShaderEntries& GetEntries() const {
@@ -89,6 +104,16 @@ public:
         return *registry;
     }
 
+    /// Gets the const buffer words the shader can be specialized on
+    const VideoCommon::Shader::SpecializationKeys& GetSpecializationKeys() const {
+        return specialization_keys;
+    }
+
+    /// Gets the variants of the shader specialized on the values of those words
+    std::vector<ShaderVariant>& GetVariants() {
+        return variants;
+    }
+
     /// Mark a OpenGL shader as built
     void AsyncOpenGLBuilt(OGLProgram new_program);
 
@@ -98,7 +123,8 @@ public:
     static std::unique_ptr<Shader> CreateStageFromMemory(
         const ShaderParameters& params, Maxwell::ShaderProgram program_type,
         ProgramCode program_code, ProgramCode program_code_b,
-        VideoCommon::Shader::AsyncShaders& async_shaders, VAddr cpu_addr);
+        VideoCommon::Shader::AsyncShaders& async_shaders,
+        VideoCommon::Shader::ShaderPredecoder& predecoder, VAddr cpu_addr);
 
     static std::unique_ptr<Shader> CreateKernelFromMemory(const ShaderParameters& params,
                                                           ProgramCode code);
@@ -108,13 +134,17 @@ public:
 
 private:
     explicit Shader(std::shared_ptr<VideoCommon::Shader::Registry> registry, ShaderEntries entries,
-                    ProgramSharedPtr program, bool is_built_ = true);
+                    ProgramSharedPtr program, bool is_built_ = true,
+                    VideoCommon::Shader::SpecializationKeys specialization_keys = {});
 
     std::shared_ptr<VideoCommon::Shader::Registry> registry;
     ShaderEntries entries;
     ProgramSharedPtr program;
+    VideoCommon::Shader::SpecializationKeys specialization_keys;
+    std::vector<ShaderVariant> variants;
     GLuint handle = 0;
     bool is_built{};
+    bool is_linking{};
 };
 
 class ShaderCacheOpenGL final : public VideoCommon::ShaderCache<Shader> {
@@ -130,14 +160,29 @@ public:
     void LoadDiskCache(u64 title_id, std::stop_token stop_loading,
                        const VideoCore::DiskResourceLoadCallback& callback);
 
+    /// Starts decoding a newly bound stage program in the background
+    void PrepareStageProgram(Maxwell::ShaderProgram program);
+
     /// Gets the current specified shader stage program
     Shader* GetStageProgram(Maxwell::ShaderProgram program,
                             VideoCommon::Shader::AsyncShaders& async_shaders);
 
+    /// Gets the handle to draw a stage with, a variant specialized on the current const buffer
+    /// values when one has been built, or zero when the shader is still being built
+    GLuint GetStageHandle(Shader& shader, Maxwell::ShaderProgram program,
+                          VideoCommon::Shader::AsyncShaders& async_shaders);
+
     /// Gets a compute kernel in the passed address
     Shader* GetComputeKernel(GPUVAddr code_addr);
 
 private:
+    /// Installs the programs built by the asynchronous shader workers
+    void ProcessCompletedShaders(VideoCommon::Shader::AsyncShaders& async_shaders);
+
+    /// Queues a variant of the bound shader specialized on its current values
+    void QueueVariant(Shader& shader, ShaderVariant& variant, Maxwell::ShaderProgram program,
+                      VideoCommon::Shader::AsyncShaders& async_shaders);
+
     ProgramSharedPtr GeneratePrecompiledProgram(
         const ShaderDiskCacheEntry& entry, const ShaderDiskCachePrecompiled& precompiled_entry,
         const std::unordered_set<GLenum>& supported_formats);
@@ -151,6 +196,7 @@ private:
 
     ShaderDiskCacheOpenGL disk_cache;
     std::unordered_map<u64, PrecompiledShader> runtime_cache;
+    VideoCommon::Shader::ShaderPredecoder predecoder;
 
     std::unique_ptr<Shader> null_shader;
     std::unique_ptr<Shader> null_kernel;
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <array>
+#include <iterator>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -81,6 +82,10 @@ const float fswzadd_modifiers_b[] = float[4](-1.0f, -1.0f,  1.0f, -1.0f );
 
 class ShaderWriter final {
 public:
+    ShaderWriter() {
+        shader_source.reserve(INITIAL_CAPACITY);
+    }
+
     void AddExpression(std::string_view text) {
         DEBUG_ASSERT(scope >= 0);
         if (!text.empty()) {
@@ -96,7 +101,16 @@ public:
     // etc).
     template <typename... Args>
     void AddLine(std::string_view text, Args&&... args) {
-        AddExpression(fmt::format(fmt::runtime(text), std::forward<Args>(args)...));
+        DEBUG_ASSERT(scope >= 0);
+        // Lines are formatted in place, the indentation is dropped again when they are empty
+        const std::size_t line_start = shader_source.size();
+        AppendIndentation();
+        const std::size_t text_start = shader_source.size();
+        fmt::format_to(std::back_inserter(shader_source), fmt::runtime(text),
+                       std::forward<Args>(args)...);
+        if (shader_source.size() == text_start) {
+            shader_source.resize(line_start);
+        }
         AddNewLine();
     }
 
@@ -116,6 +130,9 @@ public:
     s32 scope = 0;
 
 private:
+    /// Most shaders fit in this size, reserving it avoids growing the source many times
+    static constexpr std::size_t INITIAL_CAPACITY = 64 * 1024;
+
     void AppendIndentation() {
         shader_source.append(static_cast<std::size_t>(scope) * 4, ' ');
     }
@@ -135,10 +152,14 @@ public:
         return type;
     }
 
-    std::string GetCode() const {
+    const std::string& GetCode() const& {
         return code;
     }
 
+    std::string GetCode() && {
+        return std::move(code);
+    }
+
     void CheckVoid() const {
         ASSERT(type == Type::Void);
     }
@@ -519,6 +540,9 @@ private:
         if (device.HasTextureShadowLod()) {
             code.AddLine("#extension GL_EXT_texture_shadow_lod : require");
         }
+        if (device.UseBindlessTextures()) {
+            code.AddLine("#extension GL_ARB_bindless_texture : require");
+        }
         if (device.HasWarpIntrinsics()) {
             code.AddLine("#extension GL_NV_gpu_shader5 : require");
             code.AddLine("#extension GL_NV_shader_thread_group : require");
@@ -887,37 +911,17 @@ private:
     }
 
     void DeclareSamplers() {
+        if (device.UseBindlessTextures()) {
+            DeclareBindlessSamplers();
+            return;
+        }
         u32 binding = device.GetBaseBindings(stage).sampler;
         for (const auto& sampler : ir.GetSamplers()) {
             const std::string name = GetSampler(sampler);
             const std::string description = fmt::format("layout (binding = {}) uniform", binding);
             binding += sampler.is_indexed ? sampler.size : 1;
 
-            std::string sampler_type = [&]() {
-                if (sampler.is_buffer) {
-                    return "samplerBuffer";
-                }
-                switch (sampler.type) {
-                case TextureType::Texture1D:
-                    return "sampler1D";
-                case TextureType::Texture2D:
-                    return "sampler2D";
-                case TextureType::Texture3D:
-                    return "sampler3D";
-                case TextureType::TextureCube:
-                    return "samplerCube";
-                default:
-                    UNREACHABLE();
-                    return "sampler2D";
-                }
-            }();
-            if (sampler.is_array) {
-                sampler_type += "Array";
-            }
-            if (sampler.is_shadow) {
-                sampler_type += "Shadow";
-            }
-
+            const std::string sampler_type = GetSamplerType(sampler);
             if (!sampler.is_indexed) {
                 code.AddLine("{} {} {};", description, sampler_type, name);
             } else {
@@ -929,6 +933,24 @@ private:
         }
     }
 
+    /// Samplers are constructed from the handles of a uniform block the rasterizer updates
+    void DeclareBindlessSamplers() {
+        u32 num_handles = 0;
+        for (const auto& sampler : ir.GetSamplers()) {
+            bindless_samplers.emplace(sampler.index,
+                                      BindlessSampler{GetSamplerType(sampler), num_handles});
+            num_handles += sampler.size;
+        }
+        if (num_handles == 0) {
+            return;
+        }
+        const u32 binding = device.GetBaseBindings(stage).bindless_handles;
+        code.AddLine("layout (std140, binding = {}) uniform BindlessHandles {{", binding);
+        code.AddLine("    uvec4 bindless_handles[{}];", num_handles);
+        code.AddLine("}};");
+        code.AddNewLine();
+    }
+
     void DeclarePhysicalAttributeReader() {
         if (!ir.HasPhysicalAttributes()) {
             return;
@@ -1378,7 +1400,7 @@ private:
         if (!meta->sampler.is_indexed) {
             expr += '(' + GetSampler(meta->sampler) + ", ";
         } else {
-            expr += '(' + GetSampler(meta->sampler) + '[' + Visit(meta->index).AsUint() + "], ";
+            expr += '(' + GetIndexedSampler(meta->sampler, Visit(meta->index).AsUint()) + ", ";
         }
         expr += coord_constructors.at(count + (has_array ? 1 : 0) +
                                       (has_shadow && !separate_dc ? 1 : 0) - 1);
@@ -2719,9 +2741,50 @@ private:
     }
 
     std::string GetSampler(const SamplerEntry& sampler) const {
+        if (device.UseBindlessTextures()) {
+            const BindlessSampler& bindless = bindless_samplers.at(sampler.index);
+            return fmt::format("{}(bindless_handles[{}].xy)", bindless.type, bindless.slot);
+        }
         return AppendSuffix(sampler.index, "sampler");
     }
 
+    std::string GetIndexedSampler(const SamplerEntry& sampler, std::string_view index) const {
+        if (device.UseBindlessTextures()) {
+            const BindlessSampler& bindless = bindless_samplers.at(sampler.index);
+            return fmt::format("{}(bindless_handles[{} + {}].xy)", bindless.type, bindless.slot,
+                               index);
+        }
+        return fmt::format("{}[{}]", GetSampler(sampler), index);
+    }
+
+    static std::string GetSamplerType(const SamplerEntry& sampler) {
+        std::string sampler_type = [&]() {
+            if (sampler.is_buffer) {
+                return "samplerBuffer";
+            }
+            switch (sampler.type) {
+            case TextureType::Texture1D:
+                return "sampler1D";
+            case TextureType::Texture2D:
+                return "sampler2D";
+            case TextureType::Texture3D:
+                return "sampler3D";
+            case TextureType::TextureCube:
+                return "samplerCube";
+            default:
+                UNREACHABLE();
+                return "sampler2D";
+            }
+        }();
+        if (sampler.is_array) {
+            sampler_type += "Array";
+        }
+        if (sampler.is_shadow) {
+            sampler_type += "Shadow";
+        }
+        return sampler_type;
+    }
+
     std::string GetImage(const ImageEntry& image) const {
         return AppendSuffix(image.index, "image");
     }
@@ -2755,6 +2818,12 @@ private:
     const Header header;
     std::unordered_map<u8, VaryingTFB> transform_feedback;
 
+    struct BindlessSampler {
+        std::string type;
+        u32 slot;
+    };
+    std::unordered_map<u32, BindlessSampler> bindless_samplers;
+
     ShaderWriter code;
 
     std::optional<u32> max_input_vertices;
@@ -2972,6 +3041,8 @@ ShaderEntries MakeEntries(const Device& device, const ShaderIR& ir, ShaderType s
         entries.enabled_uniform_buffers |= 1U << buffer.GetIndex();
     }
     entries.shader_length = ir.GetLength();
+    entries.uses_frag_coord = ir.GetInputAttributes().contains(Attribute::Index::Position) ||
+                              ir.HasPhysicalAttributes();
     return entries;
 }
 
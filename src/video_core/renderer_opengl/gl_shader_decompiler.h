@@ -56,6 +56,7 @@ struct ShaderEntries {
     std::size_t shader_length{};
     u32 clip_distances{};
     u32 enabled_uniform_buffers{};
+    bool uses_frag_coord{};
 };
 
 ShaderEntries MakeEntries(const Device& device, const VideoCommon::Shader::ShaderIR& ir,
@@ -2,7 +2,10 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cstring>
+#include <functional>
+#include <limits>
 
 #include <fmt/format.h>
 
@@ -23,41 +26,15 @@
 
 namespace OpenGL {
 
-using Tegra::Engines::ShaderType;
-using VideoCommon::Shader::BindlessSamplerMap;
-using VideoCommon::Shader::BoundSamplerMap;
-using VideoCommon::Shader::KeyMap;
-using VideoCommon::Shader::SeparateSamplerKey;
 using ShaderCacheVersionHash = std::array<u8, 64>;
 
-struct ConstBufferKey {
-    u32 cbuf = 0;
-    u32 offset = 0;
-    u32 value = 0;
-};
-
-struct BoundSamplerEntry {
-    u32 offset = 0;
-    Tegra::Engines::SamplerDescriptor sampler;
-};
-
-struct SeparateSamplerEntry {
-    u32 cbuf1 = 0;
-    u32 cbuf2 = 0;
-    u32 offset1 = 0;
-    u32 offset2 = 0;
-    Tegra::Engines::SamplerDescriptor sampler;
-};
-
-struct BindlessSamplerEntry {
-    u32 cbuf = 0;
-    u32 offset = 0;
-    Tegra::Engines::SamplerDescriptor sampler;
-};
-
 namespace {
 
 constexpr u32 NativeVersion = 21;
+constexpr u32 UsageVersion = 1;
+
+/// Number of sessions an entry can go unused before it's dropped from the transferable cache
+constexpr u32 MaxUnusedSessions = 32;
 
 ShaderCacheVersionHash GetShaderCacheVersionHash() {
     ShaderCacheVersionHash hash{};
@@ -68,136 +45,11 @@ ShaderCacheVersionHash GetShaderCacheVersionHash() {
 
 } // Anonymous namespace
 
-ShaderDiskCacheEntry::ShaderDiskCacheEntry() = default;
-
-ShaderDiskCacheEntry::~ShaderDiskCacheEntry() = default;
-
-bool ShaderDiskCacheEntry::Load(Common::FS::IOFile& file) {
-    if (!file.ReadObject(type)) {
-        return false;
-    }
-    u32 code_size;
-    u32 code_size_b;
-    if (!file.ReadObject(code_size) || !file.ReadObject(code_size_b)) {
-        return false;
-    }
-    code.resize(code_size);
-    code_b.resize(code_size_b);
-    if (file.Read(code) != code_size) {
-        return false;
-    }
-    if (HasProgramA() && file.Read(code_b) != code_size_b) {
-        return false;
-    }
-
-    u8 is_texture_handler_size_known;
-    u32 texture_handler_size_value;
-    u32 num_keys;
-    u32 num_bound_samplers;
-    u32 num_separate_samplers;
-    u32 num_bindless_samplers;
-    if (!file.ReadObject(unique_identifier) || !file.ReadObject(bound_buffer) ||
-        !file.ReadObject(is_texture_handler_size_known) ||
-        !file.ReadObject(texture_handler_size_value) || !file.ReadObject(graphics_info) ||
-        !file.ReadObject(compute_info) || !file.ReadObject(num_keys) ||
-        !file.ReadObject(num_bound_samplers) || !file.ReadObject(num_separate_samplers) ||
-        !file.ReadObject(num_bindless_samplers)) {
-        return false;
-    }
-    if (is_texture_handler_size_known) {
-        texture_handler_size = texture_handler_size_value;
-    }
-
-    std::vector<ConstBufferKey> flat_keys(num_keys);
-    std::vector<BoundSamplerEntry> flat_bound_samplers(num_bound_samplers);
-    std::vector<SeparateSamplerEntry> flat_separate_samplers(num_separate_samplers);
-    std::vector<BindlessSamplerEntry> flat_bindless_samplers(num_bindless_samplers);
-    if (file.Read(flat_keys) != flat_keys.size() ||
-        file.Read(flat_bound_samplers) != flat_bound_samplers.size() ||
-        file.Read(flat_separate_samplers) != flat_separate_samplers.size() ||
-        file.Read(flat_bindless_samplers) != flat_bindless_samplers.size()) {
-        return false;
-    }
-    for (const auto& entry : flat_keys) {
-        keys.insert({{entry.cbuf, entry.offset}, entry.value});
-    }
-    for (const auto& entry : flat_bound_samplers) {
-        bound_samplers.emplace(entry.offset, entry.sampler);
-    }
-    for (const auto& entry : flat_separate_samplers) {
-        SeparateSamplerKey key;
-        key.buffers = {entry.cbuf1, entry.cbuf2};
-        key.offsets = {entry.offset1, entry.offset2};
-        separate_samplers.emplace(key, entry.sampler);
-    }
-    for (const auto& entry : flat_bindless_samplers) {
-        bindless_samplers.insert({{entry.cbuf, entry.offset}, entry.sampler});
-    }
-
-    return true;
-}
-
-bool ShaderDiskCacheEntry::Save(Common::FS::IOFile& file) const {
-    if (!file.WriteObject(static_cast<u32>(type)) ||
-        !file.WriteObject(static_cast<u32>(code.size())) ||
-        !file.WriteObject(static_cast<u32>(code_b.size()))) {
-        return false;
-    }
-    if (file.Write(code) != code.size()) {
-        return false;
-    }
-    if (HasProgramA() && file.Write(code_b) != code_b.size()) {
-        return false;
-    }
-
-    if (!file.WriteObject(unique_identifier) || !file.WriteObject(bound_buffer) ||
-        !file.WriteObject(static_cast<u8>(texture_handler_size.has_value())) ||
-        !file.WriteObject(texture_handler_size.value_or(0)) || !file.WriteObject(graphics_info) ||
-        !file.WriteObject(compute_info) || !file.WriteObject(static_cast<u32>(keys.size())) ||
-        !file.WriteObject(static_cast<u32>(bound_samplers.size())) ||
-        !file.WriteObject(static_cast<u32>(separate_samplers.size())) ||
-        !file.WriteObject(static_cast<u32>(bindless_samplers.size()))) {
-        return false;
-    }
-
-    std::vector<ConstBufferKey> flat_keys;
-    flat_keys.reserve(keys.size());
-    for (const auto& [address, value] : keys) {
-        flat_keys.push_back(ConstBufferKey{address.first, address.second, value});
-    }
-
-    std::vector<BoundSamplerEntry> flat_bound_samplers;
-    flat_bound_samplers.reserve(bound_samplers.size());
-    for (const auto& [address, sampler] : bound_samplers) {
-        flat_bound_samplers.push_back(BoundSamplerEntry{address, sampler});
-    }
-
-    std::vector<SeparateSamplerEntry> flat_separate_samplers;
-    flat_separate_samplers.reserve(separate_samplers.size());
-    for (const auto& [key, sampler] : separate_samplers) {
-        SeparateSamplerEntry entry;
-        std::tie(entry.cbuf1, entry.cbuf2) = key.buffers;
-        std::tie(entry.offset1, entry.offset2) = key.offsets;
-        entry.sampler = sampler;
-        flat_separate_samplers.push_back(entry);
-    }
-
-    std::vector<BindlessSamplerEntry> flat_bindless_samplers;
-    flat_bindless_samplers.reserve(bindless_samplers.size());
-    for (const auto& [address, sampler] : bindless_samplers) {
-        flat_bindless_samplers.push_back(
-            BindlessSamplerEntry{address.first, address.second, sampler});
-    }
-
-    return file.Write(flat_keys) == flat_keys.size() &&
-           file.Write(flat_bound_samplers) == flat_bound_samplers.size() &&
-           file.Write(flat_separate_samplers) == flat_separate_samplers.size() &&
-           file.Write(flat_bindless_samplers) == flat_bindless_samplers.size();
-}
-
 ShaderDiskCacheOpenGL::ShaderDiskCacheOpenGL() = default;
 
-ShaderDiskCacheOpenGL::~ShaderDiskCacheOpenGL() = default;
+ShaderDiskCacheOpenGL::~ShaderDiskCacheOpenGL() {
+    SaveUsage();
+}
 
 void ShaderDiskCacheOpenGL::BindTitleID(u64 title_id_) {
     title_id = title_id_;
@@ -210,6 +62,8 @@ std::optional<std::vector<ShaderDiskCacheEntry>> ShaderDiskCacheOpenGL::LoadTran
         return std::nullopt;
     }
 
+    LoadUsage();
+
     Common::FS::IOFile file{GetTransferablePath(), Common::FS::FileAccessMode::Read,
                             Common::FS::FileType::BinaryFile};
     if (!file.IsOpen()) {
@@ -246,8 +100,10 @@ std::optional<std::vector<ShaderDiskCacheEntry>> ShaderDiskCacheOpenGL::LoadTran
             return std::nullopt;
         }
     }
+    file.Close();
 
     is_usable = true;
+    CompactTransferable(entries);
     return {std::move(entries)};
 }
 
@@ -322,6 +178,9 @@ void ShaderDiskCacheOpenGL::InvalidateTransferable() {
 }
 
 void ShaderDiskCacheOpenGL::InvalidatePrecompiled() {
+    if (precompiled_writer.joinable()) {
+        precompiled_writer.join();
+    }
     // Clear virtaul precompiled cache file
     precompiled_cache_virtual_file.Resize(0);
 
@@ -356,6 +215,46 @@ void ShaderDiskCacheOpenGL::SaveEntry(const ShaderDiskCacheEntry& entry) {
     stored_transferable.insert(id);
 }
 
+void ShaderDiskCacheOpenGL::MarkUsed(u64 unique_identifier) {
+    if (!is_usable) {
+        return;
+    }
+    ShaderDiskCacheUsage& entry = usage[unique_identifier];
+    entry.unique_identifier = unique_identifier;
+    if (entry.hits != std::numeric_limits<u32>::max()) {
+        ++entry.hits;
+    }
+    entry.last_session = session;
+}
+
+void ShaderDiskCacheOpenGL::SaveUsage() const {
+    if (!is_usable || !EnsureDirectories()) {
+        return;
+    }
+    // Only store counters of shaders that are in the transferable file
+    std::vector<ShaderDiskCacheUsage> entries;
+    entries.reserve(usage.size());
+    for (const auto& [unique_identifier, entry] : usage) {
+        if (stored_transferable.contains(unique_identifier)) {
+            entries.push_back(entry);
+        }
+    }
+
+    const auto usage_path = GetUsagePath();
+    Common::FS::IOFile file{usage_path, Common::FS::FileAccessMode::Write,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        LOG_ERROR(Render_OpenGL, "Failed to open shader usage file in path={}",
+                  Common::FS::PathToUTF8String(usage_path));
+        return;
+    }
+    if (!file.WriteObject(UsageVersion) || !file.WriteObject(session) ||
+        file.Write(entries) != entries.size()) {
+        LOG_ERROR(Render_OpenGL, "Failed to write shader usage file in path={}",
+                  Common::FS::PathToUTF8String(usage_path));
+    }
+}
+
 void ShaderDiskCacheOpenGL::SavePrecompiled(u64 unique_identifier, GLuint program) {
     if (!is_usable) {
         return;
@@ -410,6 +309,93 @@ Common::FS::IOFile ShaderDiskCacheOpenGL::AppendTransferableFile() const {
     return file;
 }
 
+void ShaderDiskCacheOpenGL::LoadUsage() {
+    usage.clear();
+    session = 1;
+
+    Common::FS::IOFile file{GetUsagePath(), Common::FS::FileAccessMode::Read,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        return;
+    }
+    u32 version{};
+    u32 last_session{};
+    if (!file.ReadObject(version) || version != UsageVersion || !file.ReadObject(last_session)) {
+        LOG_INFO(Render_OpenGL, "Shader usage file is invalid or from another version, ignoring");
+        return;
+    }
+    const u64 remaining_size = file.GetSize() - static_cast<u64>(file.Tell());
+    std::vector<ShaderDiskCacheUsage> entries(remaining_size / sizeof(ShaderDiskCacheUsage));
+    if (file.Read(entries) != entries.size()) {
+        LOG_ERROR(Render_OpenGL, "Failed to load shader usage entries, ignoring");
+        return;
+    }
+    session = last_session + 1;
+    for (const ShaderDiskCacheUsage& entry : entries) {
+        usage.insert_or_assign(entry.unique_identifier, entry);
+    }
+}
+
+void ShaderDiskCacheOpenGL::CompactTransferable(std::vector<ShaderDiskCacheEntry>& entries) {
+    const std::size_t num_entries = entries.size();
+    const auto get_usage = [this](const ShaderDiskCacheEntry& entry) -> ShaderDiskCacheUsage& {
+        // Entries without counters, like the ones written by older builds, start counting now
+        const auto [it, is_new] = usage.try_emplace(entry.unique_identifier);
+        if (is_new) {
+            it->second.unique_identifier = entry.unique_identifier;
+            it->second.last_session = session;
+        }
+        return it->second;
+    };
+
+    std::unordered_set<u64> kept_entries;
+    std::erase_if(entries, [&](const ShaderDiskCacheEntry& entry) {
+        if (kept_entries.contains(entry.unique_identifier)) {
+            // Duplicated entry
+            return true;
+        }
+        if (session - get_usage(entry).last_session > MaxUnusedSessions) {
+            return true;
+        }
+        kept_entries.insert(entry.unique_identifier);
+        return false;
+    });
+    const auto get_hits = [this](const ShaderDiskCacheEntry& entry) {
+        return usage.at(entry.unique_identifier).hits;
+    };
+    const bool is_sorted = std::ranges::is_sorted(entries, std::greater{}, get_hits);
+    stored_transferable = std::move(kept_entries);
+    std::erase_if(usage,
+                  [this](const auto& pair) { return !stored_transferable.contains(pair.first); });
+
+    if (is_sorted && entries.size() == num_entries) {
+        return;
+    }
+    std::ranges::stable_sort(entries, std::greater{}, get_hits);
+
+    LOG_INFO(Render_OpenGL, "Compacting transferable shader cache, kept {} of {} entries",
+             entries.size(), num_entries);
+    if (!RewriteTransferable(entries)) {
+        LOG_ERROR(Render_OpenGL, "Failed to rewrite transferable cache, removing");
+        InvalidateTransferable();
+        stored_transferable.clear();
+        usage.clear();
+    }
+}
+
+bool ShaderDiskCacheOpenGL::RewriteTransferable(const std::vector<ShaderDiskCacheEntry>& entries) {
+    if (!EnsureDirectories()) {
+        return false;
+    }
+    Common::FS::IOFile file{GetTransferablePath(), Common::FS::FileAccessMode::Write,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen() || !file.WriteObject(NativeVersion)) {
+        return false;
+    }
+    return std::ranges::all_of(
+        entries, [&file](const ShaderDiskCacheEntry& entry) { return entry.Save(file); });
+}
+
 void ShaderDiskCacheOpenGL::SavePrecompiledHeaderToVirtualPrecompiledCache() {
     const auto hash{GetShaderCacheVersionHash()};
     if (!SaveArrayToPrecompiled(hash.data(), hash.size())) {
@@ -420,24 +406,30 @@ void ShaderDiskCacheOpenGL::SavePrecompiledHeaderToVirtualPrecompiledCache() {
 }
 
 void ShaderDiskCacheOpenGL::SaveVirtualPrecompiledFile() {
+    if (precompiled_writer.joinable()) {
+        precompiled_writer.join();
+    }
     precompiled_cache_virtual_file_offset = 0;
-    const std::vector<u8> uncompressed = precompiled_cache_virtual_file.ReadAllBytes();
-    const std::vector<u8> compressed =
-        Common::Compression::CompressDataZSTDDefault(uncompressed.data(), uncompressed.size());
-
-    const auto precompiled_path = GetPrecompiledPath();
-    Common::FS::IOFile file{precompiled_path, Common::FS::FileAccessMode::Write,
-                            Common::FS::FileType::BinaryFile};
 
-    if (!file.IsOpen()) {
-        LOG_ERROR(Render_OpenGL, "Failed to open precompiled cache in path={}",
-                  Common::FS::PathToUTF8String(precompiled_path));
-        return;
-    }
-    if (file.Write(compressed) != compressed.size()) {
-        LOG_ERROR(Render_OpenGL, "Failed to write precompiled cache version in path={}",
-                  Common::FS::PathToUTF8String(precompiled_path));
-    }
+    // Program binaries have already been read on the GL thread, compressing them as a single
+    // stream doesn't need the context and would otherwise hold off the first frames
+    precompiled_writer = std::jthread([uncompressed = precompiled_cache_virtual_file.ReadAllBytes(),
+                                       precompiled_path = GetPrecompiledPath()] {
+        const std::vector<u8> compressed =
+            Common::Compression::CompressDataZSTDDefault(uncompressed.data(), uncompressed.size());
+
+        Common::FS::IOFile file{precompiled_path, Common::FS::FileAccessMode::Write,
+                                Common::FS::FileType::BinaryFile};
+        if (!file.IsOpen()) {
+            LOG_ERROR(Render_OpenGL, "Failed to open precompiled cache in path={}",
+                      Common::FS::PathToUTF8String(precompiled_path));
+            return;
+        }
+        if (file.Write(compressed) != compressed.size()) {
+            LOG_ERROR(Render_OpenGL, "Failed to write precompiled cache version in path={}",
+                      Common::FS::PathToUTF8String(precompiled_path));
+        }
+    });
 }
 
 bool ShaderDiskCacheOpenGL::EnsureDirectories() const {
@@ -452,7 +444,7 @@ bool ShaderDiskCacheOpenGL::EnsureDirectories() const {
 
     return CreateDir(Common::FS::GetYuzuPath(Common::FS::YuzuPath::ShaderDir)) &&
            CreateDir(GetBaseDir()) && CreateDir(GetTransferableDir()) &&
-           CreateDir(GetPrecompiledDir());
+           CreateDir(GetPrecompiledDir()) && CreateDir(GetUsageDir());
 }
 
 std::filesystem::path ShaderDiskCacheOpenGL::GetTransferablePath() const {
@@ -463,6 +455,10 @@ std::filesystem::path ShaderDiskCacheOpenGL::GetPrecompiledPath() const {
     return GetPrecompiledDir() / fmt::format("{}.bin", GetTitleID());
 }
 
+std::filesystem::path ShaderDiskCacheOpenGL::GetUsagePath() const {
+    return GetUsageDir() / fmt::format("{}.bin", GetTitleID());
+}
+
 std::filesystem::path ShaderDiskCacheOpenGL::GetTransferableDir() const {
     return GetBaseDir() / "transferable";
 }
@@ -471,6 +467,10 @@ std::filesystem::path ShaderDiskCacheOpenGL::GetPrecompiledDir() const {
     return GetBaseDir() / "precompiled";
 }
 
+std::filesystem::path ShaderDiskCacheOpenGL::GetUsageDir() const {
+    return GetBaseDir() / "usage";
+}
+
 std::filesystem::path ShaderDiskCacheOpenGL::GetBaseDir() const {
     return Common::FS::GetYuzuPath(Common::FS::YuzuPath::ShaderDir) / "opengl";
 }
@@ -7,6 +7,7 @@
 #include <filesystem>
 #include <optional>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <unordered_map>
@@ -20,7 +21,7 @@
 #include "common/common_types.h"
 #include "core/file_sys/vfs_vector.h"
 #include "video_core/engines/shader_type.h"
-#include "video_core/shader/registry.h"
+#include "video_core/shader/disk_cache_entry.h"
 
 namespace Common::FS {
 class IOFile;
@@ -29,34 +30,7 @@ class IOFile;
 namespace OpenGL {
 
 using ProgramCode = std::vector<u64>;
-
-/// Describes a shader and how it's used by the guest GPU
-struct ShaderDiskCacheEntry {
-    ShaderDiskCacheEntry();
-    ~ShaderDiskCacheEntry();
-
-    bool Load(Common::FS::IOFile& file);
-
-    bool Save(Common::FS::IOFile& file) const;
-
-    bool HasProgramA() const {
-        return !code.empty() && !code_b.empty();
-    }
-
-    Tegra::Engines::ShaderType type{};
-    ProgramCode code;
-    ProgramCode code_b;
-
-    u64 unique_identifier = 0;
-    std::optional<u32> texture_handler_size;
-    u32 bound_buffer = 0;
-    VideoCommon::Shader::GraphicsInfo graphics_info;
-    VideoCommon::Shader::ComputeInfo compute_info;
-    VideoCommon::Shader::KeyMap keys;
-    VideoCommon::Shader::BoundSamplerMap bound_samplers;
-    VideoCommon::Shader::SeparateSamplerMap separate_samplers;
-    VideoCommon::Shader::BindlessSamplerMap bindless_samplers;
-};
+using VideoCommon::Shader::ShaderDiskCacheEntry;
 
 /// Contains an OpenGL dumped binary program
 struct ShaderDiskCachePrecompiled {
@@ -65,6 +39,14 @@ struct ShaderDiskCachePrecompiled {
     std::vector<u8> binary;
 };
 
+/// Tracks how often a transferable shader has been used across sessions
+struct ShaderDiskCacheUsage {
+    u64 unique_identifier = 0;
+    u32 hits = 0;
+    u32 last_session = 0;
+};
+static_assert(std::has_unique_object_representations_v<ShaderDiskCacheUsage>);
+
 class ShaderDiskCacheOpenGL {
 public:
     explicit ShaderDiskCacheOpenGL();
@@ -74,6 +56,7 @@ public:
     void BindTitleID(u64 title_id);
 
     /// Loads transferable cache. If file has a old version or on failure, it deletes the file.
+    /// Entries are returned hottest first after dropping the ones unused for too many sessions.
     std::optional<std::vector<ShaderDiskCacheEntry>> LoadTransferable();
 
     /// Loads current game's precompiled cache. Invalidates on failure.
@@ -88,10 +71,16 @@ public:
     /// Saves a raw dump to the transferable file. Checks for collisions.
     void SaveEntry(const ShaderDiskCacheEntry& entry);
 
+    /// Records a use of a shader in the current session.
+    void MarkUsed(u64 unique_identifier);
+
+    /// Serializes the usage counters of the current session.
+    void SaveUsage() const;
+
     /// Saves a dump entry to the precompiled file. Does not check for collisions.
     void SavePrecompiled(u64 unique_identifier, GLuint program);
 
-    /// Serializes virtual precompiled shader cache file to real file
+    /// Compresses virtual precompiled shader cache file into the real file on a background thread
     void SaveVirtualPrecompiledFile();
 
 private:
@@ -102,6 +91,15 @@ private:
     /// Opens current game's transferable file and write it's header if it doesn't exist
     Common::FS::IOFile AppendTransferableFile() const;
 
+    /// Loads the usage counters of previous sessions and starts a new one.
+    void LoadUsage();
+
+    /// Drops stale entries and sorts the rest hottest first, rewriting the file when it changes.
+    void CompactTransferable(std::vector<ShaderDiskCacheEntry>& entries);
+
+    /// Replaces current game's transferable file with the given entries. Returns true on success.
+    bool RewriteTransferable(const std::vector<ShaderDiskCacheEntry>& entries);
+
     /// Save precompiled header to precompiled_cache_in_memory
     void SavePrecompiledHeaderToVirtualPrecompiledCache();
 
@@ -117,9 +115,15 @@ private:
     /// Get user's transferable directory path
     std::filesystem::path GetTransferableDir() const;
 
+    /// Gets current game's usage file path
+    std::filesystem::path GetUsagePath() const;
+
     /// Get user's precompiled directory path
     std::filesystem::path GetPrecompiledDir() const;
 
+    /// Get user's usage directory path
+    std::filesystem::path GetUsageDir() const;
+
     /// Get user's shader directory path
     std::filesystem::path GetBaseDir() const;
 
@@ -166,11 +170,20 @@ private:
     // Stored transferable shaders
     std::unordered_set<u64> stored_transferable;
 
+    // Usage counters of transferable shaders, indexed by unique identifier
+    std::unordered_map<u64, ShaderDiskCacheUsage> usage;
+
+    /// Index of the current session, incremented each time the cache is loaded
+    u32 session = 0;
+
     /// Title ID to operate on
     u64 title_id = 0;
 
     // The cache has been loaded at boot
     bool is_usable = false;
+
+    // Compresses and writes the precompiled cache file, joined before the file is touched again
+    std::jthread precompiled_writer;
 };
 
 } // namespace OpenGL
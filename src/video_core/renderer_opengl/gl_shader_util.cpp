@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <string>
 #include <string_view>
 #include <vector>
 #include <glad/glad.h>
@@ -58,4 +59,61 @@ GLuint LoadShader(std::string_view source, GLenum type) {
     return shader_id;
 }
 
+GLuint LoadProgramParallel(std::string_view source, GLenum type, bool hint_retrievable) {
+    const GLuint shader_id = glCreateShader(type);
+    const GLchar* source_string = source.data();
+    const GLint source_length = static_cast<GLint>(source.size());
+    glShaderSource(shader_id, 1, &source_string, &source_length);
+    LOG_DEBUG(Render_OpenGL, "Compiling {} shader in parallel...", StageDebugName(type));
+    glCompileShader(shader_id);
+
+    const GLuint program_id = glCreateProgram();
+    glAttachShader(program_id, shader_id);
+    glProgramParameteri(program_id, GL_PROGRAM_SEPARABLE, GL_TRUE);
+    if (hint_retrievable) {
+        glProgramParameteri(program_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glLinkProgram(program_id);
+
+    // Querying the status of either object would wait for the driver. The shader is kept alive
+    // until it's detached from the program.
+    glDeleteShader(shader_id);
+    return program_id;
+}
+
+bool IsProgramLinked(GLuint program_id) {
+    GLint is_complete = GL_FALSE;
+    glGetProgramiv(program_id, GL_COMPLETION_STATUS_KHR, &is_complete);
+    if (is_complete == GL_FALSE) {
+        return false;
+    }
+    GLint result = GL_FALSE;
+    GLint info_log_length;
+    glGetProgramiv(program_id, GL_LINK_STATUS, &result);
+    glGetProgramiv(program_id, GL_INFO_LOG_LENGTH, &info_log_length);
+
+    if (info_log_length > 1) {
+        std::string program_error(info_log_length, ' ');
+        glGetProgramInfoLog(program_id, info_log_length, nullptr, &program_error[0]);
+        if (result == GL_TRUE) {
+            LOG_DEBUG(Render_OpenGL, "{}", program_error);
+        } else {
+            LOG_ERROR(Render_OpenGL, "Error linking shader:\n{}", program_error);
+        }
+    }
+
+    GLuint shader_id = 0;
+    glGetAttachedShaders(program_id, 1, nullptr, &shader_id);
+    if (result == GL_FALSE) {
+        // There was a problem linking the shader, print the source for debugging purposes.
+        LogShaderSource(shader_id);
+    }
+    ASSERT_MSG(result == GL_TRUE, "Shader not linked");
+
+    if (shader_id != 0) {
+        glDetachShader(program_id, shader_id);
+    }
+    return true;
+}
+
 } // namespace OpenGL::GLShader
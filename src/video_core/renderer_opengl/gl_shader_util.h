@@ -40,6 +40,19 @@ void LogShaderSource(T... shaders) {
  */
 GLuint LoadShader(std::string_view source, GLenum type);
 
+/**
+ * Starts compiling and linking a separable program from a GLSL shader without waiting for the
+ * driver. GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile must be supported.
+ * @returns Handle of the program, it can't be used until IsProgramLinked returns true
+ */
+GLuint LoadProgramParallel(std::string_view source, GLenum type, bool hint_retrievable);
+
+/**
+ * Polls a program created with LoadProgramParallel, logging its errors once it has been linked.
+ * @returns true when the driver has finished compiling and linking the program
+ */
+bool IsProgramLinked(GLuint program_id);
+
 /**
  * Utility function to create and compile an OpenGL GLSL shader program (vertex + fragment shader)
  * @param separable_program whether to create a separable program
@@ -147,6 +147,18 @@ public:
         flags[OpenGL::Dirty::Viewport0] = true;
     }
 
+    void NotifyViewports() {
+        flags[OpenGL::Dirty::Viewports] = true;
+        flags[OpenGL::Dirty::ViewportTransform] = true;
+    }
+
+    void NotifyScissors() {
+        flags[OpenGL::Dirty::Scissors] = true;
+        for (size_t index = 0; index < Tegra::Engines::Maxwell3D::Regs::NumViewports; ++index) {
+            flags[OpenGL::Dirty::Scissor0 + index] = true;
+        }
+    }
+
     void NotifyScissor0() {
         flags[OpenGL::Dirty::Scissors] = true;
         flags[OpenGL::Dirty::Scissor0] = true;
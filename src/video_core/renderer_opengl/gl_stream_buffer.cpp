@@ -10,6 +10,7 @@
 
 #include "common/alignment.h"
 #include "common/assert.h"
+#include "common/microprofile.h"
 #include "video_core/renderer_opengl/gl_stream_buffer.h"
 
 namespace OpenGL {
@@ -28,6 +29,7 @@ StreamBuffer::StreamBuffer() {
 
 std::pair<std::span<u8>, size_t> StreamBuffer::Request(size_t size) noexcept {
     ASSERT(size < REGION_SIZE);
+    MICROPROFILE_META_CPU("Stream buffer bytes", static_cast<int>(size));
     for (size_t region = Region(used_iterator), region_end = Region(iterator); region < region_end;
          ++region) {
         fences[region].Create();
@@ -280,6 +280,11 @@ GLenum AttachmentType(PixelFormat format) {
     return false;
 }
 
+[[nodiscard]] GLenum TranscodedFormat(PixelFormat format) {
+    return IsPixelFormatSRGB(format) ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+                                     : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+}
+
 [[nodiscard]] constexpr SwizzleSource ConvertGreenRed(SwizzleSource value) {
     switch (value) {
     case SwizzleSource::G:
@@ -448,8 +453,8 @@ ImageBufferMap::~ImageBufferMap() {
 }
 
 TextureCacheRuntime::TextureCacheRuntime(const Device& device_, ProgramManager& program_manager,
-                                         StateTracker& state_tracker_)
-    : device{device_}, state_tracker{state_tracker_}, util_shaders(program_manager) {
+                                         StateTracker& state_tracker_, GPUProfiler& gpu_profiler)
+    : device{device_}, state_tracker{state_tracker_}, util_shaders(program_manager, gpu_profiler) {
     static constexpr std::array TARGETS{GL_TEXTURE_1D_ARRAY, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_3D};
     for (size_t i = 0; i < TARGETS.size(); ++i) {
         const GLenum target = TARGETS[i];
@@ -519,6 +524,9 @@ TextureCacheRuntime::TextureCacheRuntime(const Device& device_, ProgramManager&
     set_view(ImageViewType::e2DArray, null_image_view_2d_array.handle);
     set_view(ImageViewType::CubeArray, null_image_cube_array.handle);
     set_view(ImageViewType::Rect, null_image_rect.handle);
+
+    rescale_read_framebuffer.Create();
+    rescale_draw_framebuffer.Create();
 }
 
 TextureCacheRuntime::~TextureCacheRuntime() = default;
@@ -615,6 +623,37 @@ void TextureCacheRuntime::AccelerateImageUpload(Image& image, const ImageBufferM
     }
 }
 
+void TextureCacheRuntime::BlitTexture(GLuint dst, const VideoCommon::Extent2D& dst_size,
+                                      GLuint src, const VideoCommon::Extent2D& src_size,
+                                      PixelFormat format, GLenum filter) {
+    state_tracker.NotifyScissor0();
+    state_tracker.NotifyRasterizeEnable();
+    state_tracker.NotifyFramebufferSRGB();
+
+    glEnable(GL_FRAMEBUFFER_SRGB);
+    glDisable(GL_RASTERIZER_DISCARD);
+    glDisablei(GL_SCISSOR_TEST, 0);
+
+    const SurfaceType type = GetFormatType(format);
+    GLenum attachment = GL_COLOR_ATTACHMENT0;
+    GLbitfield buffer_bits = GL_COLOR_BUFFER_BIT;
+    if (type != SurfaceType::ColorTexture) {
+        attachment = AttachmentType(format);
+        buffer_bits = type == SurfaceType::DepthStencil
+                          ? GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT
+                          : GL_DEPTH_BUFFER_BIT;
+    }
+    const GLuint read_handle = rescale_read_framebuffer.handle;
+    const GLuint draw_handle = rescale_draw_framebuffer.handle;
+    glNamedFramebufferTextureLayer(read_handle, attachment, src, 0, 0);
+    glNamedFramebufferTextureLayer(draw_handle, attachment, dst, 0, 0);
+    glBlitNamedFramebuffer(read_handle, draw_handle, 0, 0, src_size.width, src_size.height, 0, 0,
+                           dst_size.width, dst_size.height, buffer_bits, filter);
+    // Detach the textures, they might be deleted or bound to a different attachment next time
+    glNamedFramebufferTextureLayer(read_handle, attachment, 0, 0, 0);
+    glNamedFramebufferTextureLayer(draw_handle, attachment, 0, 0, 0);
+}
+
 void TextureCacheRuntime::InsertUploadMemoryBarrier() {
     glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
 }
@@ -638,6 +677,10 @@ bool TextureCacheRuntime::HasNativeASTC() const noexcept {
     return device.HasASTC();
 }
 
+u64 TextureCacheRuntime::GetDeviceLocalMemory() const {
+    return device.GetDeviceLocalMemory();
+}
+
 TextureCacheRuntime::StagingBuffers::StagingBuffers(GLenum storage_flags_, GLenum map_flags_)
     : storage_flags{storage_flags_}, map_flags{map_flags_} {}
 
@@ -668,6 +711,7 @@ size_t TextureCacheRuntime::StagingBuffers::RequestBuffer(size_t requested_size)
 
     syncs.emplace_back();
     sizes.push_back(requested_size);
+    total_size += requested_size;
 
     ASSERT(syncs.size() == buffers.size() && buffers.size() == maps.size() &&
            maps.size() == sizes.size());
@@ -698,13 +742,22 @@ std::optional<size_t> TextureCacheRuntime::StagingBuffers::FindBuffer(size_t req
     return found;
 }
 
-Image::Image(TextureCacheRuntime& runtime, const VideoCommon::ImageInfo& info_, GPUVAddr gpu_addr_,
+Image::Image(TextureCacheRuntime& runtime_, const VideoCommon::ImageInfo& info_, GPUVAddr gpu_addr_,
              VAddr cpu_addr_)
-    : VideoCommon::ImageBase(info_, gpu_addr_, cpu_addr_) {
-    if (CanBeAccelerated(runtime, info)) {
+    : VideoCommon::ImageBase(info_, gpu_addr_, cpu_addr_), runtime{&runtime_} {
+    const bool is_converted = IsConverted(runtime->device, info.format, info.type);
+    const bool is_transcoded =
+        is_converted && runtime->device.UseAstcTranscoding() && IsPixelFormatASTC(info.format);
+    if (!is_transcoded && CanBeAccelerated(*runtime, info)) {
         flags |= ImageFlagBits::AcceleratedUpload;
     }
-    if (IsConverted(runtime.device, info.format, info.type)) {
+    if (is_transcoded) {
+        // Compressed formats don't have a pixel format or type
+        flags |= ImageFlagBits::Converted | ImageFlagBits::Transcoded;
+        gl_internal_format = TranscodedFormat(info.format);
+        gl_format = GL_NONE;
+        gl_type = GL_NONE;
+    } else if (is_converted) {
         flags |= ImageFlagBits::Converted;
         gl_internal_format = IsPixelFormatSRGB(info.format) ? GL_SRGB8_ALPHA8 : GL_RGBA8;
         gl_format = GL_RGBA;
@@ -757,7 +810,7 @@ Image::Image(TextureCacheRuntime& runtime, const VideoCommon::ImageInfo& info_,
         UNREACHABLE_MSG("Invalid target=0x{:x}", target);
         break;
     }
-    if (runtime.device.HasDebuggingToolAttached()) {
+    if (runtime->device.HasDebuggingToolAttached()) {
         const std::string name = VideoCommon::Name(*this);
         glObjectLabel(target == GL_TEXTURE_BUFFER ? GL_BUFFER : GL_TEXTURE, handle,
                       static_cast<GLsizei>(name.size()), name.data());
@@ -851,6 +904,38 @@ GLuint Image::StorageHandle() noexcept {
     }
 }
 
+bool Image::ScaleUp(u32 up, u32 shift) {
+    const VideoCommon::Extent2D native_size{info.size.width, info.size.height};
+    if (!scaled_texture.handle) {
+        scaled_size = VideoCommon::Extent2D{
+            .width = VideoCommon::ScaleDimension(info.size.width, up, shift),
+            .height = VideoCommon::ScaleDimension(info.size.height, up, shift),
+        };
+        scaled_texture.Create(ImageTarget(info));
+        glTextureStorage3D(scaled_texture.handle, 1, gl_internal_format, scaled_size.width,
+                           scaled_size.height, 1);
+    }
+    runtime->BlitTexture(scaled_texture.handle, scaled_size, texture.handle, native_size,
+                         info.format, RescaleFilter());
+    is_rescaled = true;
+    return true;
+}
+
+void Image::ScaleDown() {
+    const VideoCommon::Extent2D native_size{info.size.width, info.size.height};
+    runtime->BlitTexture(texture.handle, native_size, scaled_texture.handle, scaled_size,
+                         info.format, RescaleFilter());
+    is_rescaled = false;
+}
+
+GLenum Image::RescaleFilter() const noexcept {
+    // Depth, stencil and integer contents can't be interpolated
+    const bool is_integer = gl_format == GL_RED_INTEGER || gl_format == GL_RG_INTEGER ||
+                            gl_format == GL_RGB_INTEGER || gl_format == GL_RGBA_INTEGER;
+    const bool is_color = GetFormatType(info.format) == SurfaceType::ColorTexture;
+    return is_color && !is_integer ? GL_LINEAR : GL_NEAREST;
+}
+
 void Image::CopyBufferToImage(const VideoCommon::BufferImageCopy& copy, size_t buffer_offset) {
     // Compressed formats don't have a pixel format or type
     const bool is_compressed = gl_format == GL_NONE;
@@ -953,9 +1038,12 @@ void Image::CopyImageToBuffer(const VideoCommon::BufferImageCopy& copy, size_t b
 
 ImageView::ImageView(TextureCacheRuntime& runtime, const VideoCommon::ImageViewInfo& info,
                      ImageId image_id_, Image& image)
-    : VideoCommon::ImageViewBase{info, image.info, image_id_}, views{runtime.null_image_views} {
+    : VideoCommon::ImageViewBase{info, image.info, image_id_}, views{runtime.null_image_views},
+      image_gpu_addr{image.gpu_addr} {
     const Device& device = runtime.device;
-    if (True(image.flags & ImageFlagBits::Converted)) {
+    if (True(image.flags & ImageFlagBits::Transcoded)) {
+        internal_format = TranscodedFormat(info.format);
+    } else if (True(image.flags & ImageFlagBits::Converted)) {
         internal_format = IsPixelFormatSRGB(info.format) ? GL_SRGB8_ALPHA8 : GL_RGBA8;
     } else {
         internal_format = GetFormatTuple(format).internal_format;
@@ -1019,6 +1107,25 @@ ImageView::ImageView(TextureCacheRuntime& runtime, const VideoCommon::ImageViewI
 ImageView::ImageView(TextureCacheRuntime& runtime, const VideoCommon::NullImageParams& params)
     : VideoCommon::ImageViewBase{params}, views{runtime.null_image_views} {}
 
+GLuint64 ImageView::BindlessHandle(ImageViewType query_type, GLuint sampler) const {
+    const u64 key = (static_cast<u64>(query_type) << 32) | sampler;
+    const auto [it, is_new] = bindless_handles.try_emplace(key);
+    if (is_new) {
+        const GLuint texture = Handle(query_type);
+        if (query_type == ImageViewType::Buffer) {
+            // Buffer textures can't be sampled through a sampler object
+            it->second = glGetTextureHandleARB(texture);
+        } else {
+            it->second = glGetTextureSamplerHandleARB(texture, sampler);
+        }
+        // Null views share their textures, so the handle might already be resident
+        if (!glIsTextureHandleResidentARB(it->second)) {
+            glMakeTextureHandleResidentARB(it->second);
+        }
+    }
+    return it->second;
+}
+
 void ImageView::SetupView(const Device& device, Image& image, ImageViewType view_type,
                           GLuint handle, const VideoCommon::ImageViewInfo& info,
                           VideoCommon::SubresourceRange view_range) {
@@ -1027,7 +1134,7 @@ void ImageView::SetupView(const Device& device, Image& image, ImageViewType view
         glTextureBufferRange(handle, internal_format, image.buffer.handle, 0,
                              image.guest_size_bytes);
     } else {
-        const GLuint parent = image.texture.handle;
+        const GLuint parent = image.Handle();
         const GLenum target = ImageTarget(view_type, image.info.num_samples);
         glTextureView(handle, target, parent, internal_format, view_range.base.level,
                       view_range.extent.levels, view_range.base.layer, view_range.extent.layers);
@@ -1143,6 +1250,18 @@ Framebuffer::Framebuffer(TextureCacheRuntime& runtime, std::span<ImageView*, NUM
         glObjectLabel(GL_FRAMEBUFFER, handle, static_cast<GLsizei>(name.size()), name.data());
     }
     framebuffer.handle = handle;
+
+    profile_label = fmt::format("Render pass {}x{}", key.size.width, key.size.height);
+    for (size_t index = 0; index < color_buffers.size(); ++index) {
+        if (const ImageView* const image_view = color_buffers[index]) {
+            profile_label += fmt::format(" RT{} 0x{:x} {}", index, image_view->ImageGpuAddr(),
+                                         image_view->format);
+        }
+    }
+    if (depth_buffer) {
+        profile_label +=
+            fmt::format(" Z 0x{:x} {}", depth_buffer->ImageGpuAddr(), depth_buffer->format);
+    }
 }
 
 } // namespace OpenGL
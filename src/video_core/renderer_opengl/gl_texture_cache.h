@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <span>
+#include <string>
+#include <unordered_map>
 
 #include <glad/glad.h>
 
@@ -16,6 +19,7 @@
 namespace OpenGL {
 
 class Device;
+class GPUProfiler;
 class ProgramManager;
 class StateTracker;
 
@@ -30,6 +34,7 @@ using VideoCommon::ImageViewType;
 using VideoCommon::NUM_RT;
 using VideoCommon::Region2D;
 using VideoCommon::RenderTargets;
+using VideoCore::Surface::PixelFormat;
 
 struct ImageBufferMap {
     ~ImageBufferMap();
@@ -54,7 +59,7 @@ class TextureCacheRuntime {
 
 public:
     explicit TextureCacheRuntime(const Device& device, ProgramManager& program_manager,
-                                 StateTracker& state_tracker);
+                                 StateTracker& state_tracker, GPUProfiler& gpu_profiler);
     ~TextureCacheRuntime();
 
     void Finish();
@@ -63,6 +68,12 @@ public:
 
     ImageBufferMap DownloadStagingBuffer(size_t size);
 
+    /// Returns the host memory held by the staging buffers, can be called from any thread
+    [[nodiscard]] u64 GetStagingMemory() const noexcept {
+        return upload_buffers.total_size.load(std::memory_order_relaxed) +
+               download_buffers.total_size.load(std::memory_order_relaxed);
+    }
+
     void CopyImage(Image& dst, Image& src, std::span<const VideoCommon::ImageCopy> copies);
 
     void ConvertImage(Framebuffer* dst, ImageView& dst_view, ImageView& src_view) {
@@ -80,6 +91,10 @@ public:
     void AccelerateImageUpload(Image& image, const ImageBufferMap& map,
                                std::span<const VideoCommon::SwizzleParameters> swizzles);
 
+    /// Blits the whole first layer and level of a texture into another one of a different size
+    void BlitTexture(GLuint dst, const VideoCommon::Extent2D& dst_size, GLuint src,
+                     const VideoCommon::Extent2D& src_size, PixelFormat format, GLenum filter);
+
     void InsertUploadMemoryBarrier();
 
     FormatProperties FormatInfo(VideoCommon::ImageType type, GLenum internal_format) const;
@@ -89,12 +104,19 @@ public:
         return false;
     }
 
+    bool HasNativeBcn() const noexcept {
+        // BC1 to BC5 are part of core OpenGL and uploaded as they are
+        return true;
+    }
+
     bool HasBrokenTextureViewFormats() const noexcept {
         return has_broken_texture_view_formats;
     }
 
     bool HasNativeASTC() const noexcept;
 
+    u64 GetDeviceLocalMemory() const;
+
 private:
     struct StagingBuffers {
         explicit StagingBuffers(GLenum storage_flags_, GLenum map_flags_);
@@ -112,6 +134,7 @@ private:
         std::vector<size_t> sizes;
         GLenum storage_flags;
         GLenum map_flags;
+        std::atomic<u64> total_size{0};
     };
 
     const Device& device;
@@ -124,6 +147,9 @@ private:
     StagingBuffers upload_buffers{GL_MAP_WRITE_BIT, GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT};
     StagingBuffers download_buffers{GL_MAP_READ_BIT, GL_MAP_READ_BIT};
 
+    OGLFramebuffer rescale_read_framebuffer;
+    OGLFramebuffer rescale_draw_framebuffer;
+
     OGLTexture null_image_1d_array;
     OGLTexture null_image_cube_array;
     OGLTexture null_image_3d;
@@ -160,8 +186,14 @@ public:
 
     GLuint StorageHandle() noexcept;
 
+    /// Copies the contents into a texture with the dimensions scaled by up / (1 << shift)
+    bool ScaleUp(u32 up, u32 shift);
+
+    /// Copies the rescaled contents back to the native texture
+    void ScaleDown();
+
     GLuint Handle() const noexcept {
-        return texture.handle;
+        return is_rescaled ? scaled_texture.handle : texture.handle;
     }
 
 private:
@@ -169,12 +201,19 @@ private:
 
     void CopyImageToBuffer(const VideoCommon::BufferImageCopy& copy, size_t buffer_offset);
 
+    /// Filter used to resample the contents between resolutions
+    GLenum RescaleFilter() const noexcept;
+
+    TextureCacheRuntime* runtime{};
     OGLTexture texture;
+    OGLTexture scaled_texture;
     OGLBuffer buffer;
     OGLTextureView store_view;
     GLenum gl_internal_format = GL_NONE;
     GLenum gl_format = GL_NONE;
     GLenum gl_type = GL_NONE;
+    VideoCommon::Extent2D scaled_size{};
+    bool is_rescaled = false;
 };
 
 class ImageView : public VideoCommon::ImageViewBase {
@@ -188,6 +227,9 @@ public:
         return views[static_cast<size_t>(query_type)];
     }
 
+    /// Returns a resident bindless handle of the view sampled with the given sampler object
+    [[nodiscard]] GLuint64 BindlessHandle(ImageViewType query_type, GLuint sampler) const;
+
     [[nodiscard]] GLuint DefaultHandle() const noexcept {
         return default_handle;
     }
@@ -196,6 +238,10 @@ public:
         return internal_format;
     }
 
+    [[nodiscard]] GPUVAddr ImageGpuAddr() const noexcept {
+        return image_gpu_addr;
+    }
+
 private:
     void SetupView(const Device& device, Image& image, ImageViewType view_type, GLuint handle,
                    const VideoCommon::ImageViewInfo& info,
@@ -203,8 +249,11 @@ private:
 
     std::array<GLuint, VideoCommon::NUM_IMAGE_VIEW_TYPES> views{};
     std::vector<OGLTextureView> stored_views;
+    /// Resident handles keyed by view type and sampler, released when their view is deleted
+    mutable std::unordered_map<u64, GLuint64> bindless_handles;
     GLuint default_handle = 0;
     GLenum internal_format = GL_NONE;
+    GPUVAddr image_gpu_addr = 0;
 };
 
 class ImageAlloc : public VideoCommon::ImageAllocBase {};
@@ -234,16 +283,24 @@ public:
         return buffer_bits;
     }
 
+    /// Returns the label of render passes on this framebuffer in GPU profiles
+    [[nodiscard]] const std::string& ProfileLabel() const noexcept {
+        return profile_label;
+    }
+
 private:
     OGLFramebuffer framebuffer;
     GLbitfield buffer_bits = GL_NONE;
+    std::string profile_label;
 };
 
 struct TextureCacheParams {
     static constexpr bool ENABLE_VALIDATION = true;
     static constexpr bool FRAMEBUFFER_BLITS = true;
     static constexpr bool HAS_EMULATED_COPIES = true;
-    static constexpr bool HAS_DEVICE_MEMORY_INFO = false;
+    static constexpr bool HAS_DEVICE_MEMORY_INFO = true;
+    static constexpr bool IMPLEMENTS_ASYNC_DOWNLOADS = false;
+    static constexpr bool HAS_MEMORY_DEFRAGMENTATION = false;
 
     using Runtime = OpenGL::TextureCacheRuntime;
     using Image = OpenGL::Image;
@@ -251,6 +308,7 @@ struct TextureCacheParams {
     using ImageView = OpenGL::ImageView;
     using Sampler = OpenGL::Sampler;
     using Framebuffer = OpenGL::Framebuffer;
+    using AsyncBuffer = u32;
 };
 
 using TextureCache = VideoCommon::TextureCache<TextureCacheParams>;
@@ -151,7 +151,11 @@ void RendererOpenGL::SwapBuffers(const Tegra::FramebufferConfig* framebuffer) {
     RenderScreenshot();
 
     state_tracker.BindFramebuffer(0);
+    GPUProfiler& gpu_profiler = rasterizer.GetGPUProfiler();
+    gpu_profiler.EndRenderPass();
+    gpu_profiler.BeginScope("Present");
     DrawScreen(emu_window.GetFramebufferLayout());
+    gpu_profiler.EndScope();
 
     ++m_current_frame;
 
@@ -460,6 +464,11 @@ void RendererOpenGL::RenderScreenshot() {
     if (!renderer_settings.screenshot_requested) {
         return;
     }
+    if (screenshot_fence.handle != 0) {
+        // A readback is in flight, the next screenshot can't be requested until it's delivered
+        FinishScreenshot();
+        return;
+    }
 
     GLint old_read_fb;
     GLint old_draw_fb;
@@ -481,10 +490,20 @@ void RendererOpenGL::RenderScreenshot() {
 
     DrawScreen(layout);
 
-    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    // Read back into a buffer instead of client memory, so the frame doesn't wait for the GPU
+    const std::size_t size = static_cast<std::size_t>(layout.width) * layout.height * 4;
+    if (screenshot_buffer_size != size) {
+        screenshot_buffer.Release();
+        screenshot_buffer.Create();
+        glNamedBufferStorage(screenshot_buffer.handle, static_cast<GLsizeiptr>(size), nullptr,
+                             GL_MAP_READ_BIT | GL_CLIENT_STORAGE_BIT);
+        screenshot_buffer_size = size;
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, screenshot_buffer.handle);
     glPixelStorei(GL_PACK_ROW_LENGTH, 0);
-    glReadPixels(0, 0, layout.width, layout.height, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV,
-                 renderer_settings.screenshot_bits);
+    glReadPixels(0, 0, layout.width, layout.height, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    screenshot_fence.Create();
 
     screenshot_framebuffer.Release();
     glDeleteRenderbuffers(1, &renderbuffer);
@@ -492,6 +511,24 @@ void RendererOpenGL::RenderScreenshot() {
     glBindFramebuffer(GL_READ_FRAMEBUFFER, old_read_fb);
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, old_draw_fb);
 
+    // Make sure the readback is submitted, so it's usually done by the next frame
+    glFlush();
+}
+
+void RendererOpenGL::FinishScreenshot() {
+    GLint status;
+    glGetSynciv(screenshot_fence.handle, GL_SYNC_STATUS, sizeof(GLint), nullptr, &status);
+    if (status != GL_SIGNALED) {
+        return;
+    }
+    screenshot_fence.Release();
+
+    const void* const pixels = glMapNamedBufferRange(
+        screenshot_buffer.handle, 0, static_cast<GLsizeiptr>(screenshot_buffer_size),
+        GL_MAP_READ_BIT);
+    std::memcpy(renderer_settings.screenshot_bits, pixels, screenshot_buffer_size);
+    glUnmapNamedBuffer(screenshot_buffer.handle);
+
     renderer_settings.screenshot_complete_callback();
     renderer_settings.screenshot_requested = false;
 }
@@ -86,8 +86,12 @@ private:
     /// Draws the emulated screens to the emulator window.
     void DrawScreen(const Layout::FramebufferLayout& layout);
 
+    /// Draws a requested screenshot and starts reading it back, completing any readback done.
     void RenderScreenshot();
 
+    /// Copies the screenshot to its destination once its readback has finished on the GPU.
+    void FinishScreenshot();
+
     /// Loads framebuffer from emulated memory into the active OpenGL texture.
     void LoadFBToScreenInfo(const Tegra::FramebufferConfig& framebuffer);
 
@@ -115,6 +119,9 @@ private:
     OGLProgram fragment_program;
     OGLPipeline pipeline;
     OGLFramebuffer screenshot_framebuffer;
+    OGLBuffer screenshot_buffer; ///< Pixel pack buffer the screenshot is read back into
+    OGLSync screenshot_fence;    ///< Signaled when the screenshot readback has finished
+    std::size_t screenshot_buffer_size = 0;
 
     // GPU address of the vertex buffer
     GLuint64EXT vertex_buffer_address = 0;
@@ -16,6 +16,7 @@
 #include "video_core/host_shaders/opengl_copy_bc4_comp.h"
 #include "video_core/host_shaders/opengl_copy_bgra_comp.h"
 #include "video_core/host_shaders/pitch_unswizzle_comp.h"
+#include "video_core/renderer_opengl/gl_gpu_profiler.h"
 #include "video_core/renderer_opengl/gl_resource_manager.h"
 #include "video_core/renderer_opengl/gl_shader_manager.h"
 #include "video_core/renderer_opengl/gl_texture_cache.h"
@@ -58,8 +59,9 @@ size_t NumPixelsInCopy(const VideoCommon::ImageCopy& copy) {
 
 } // Anonymous namespace
 
-UtilShaders::UtilShaders(ProgramManager& program_manager_)
-    : program_manager{program_manager_}, astc_decoder_program(MakeProgram(ASTC_DECODER_COMP)),
+UtilShaders::UtilShaders(ProgramManager& program_manager_, GPUProfiler& gpu_profiler_)
+    : program_manager{program_manager_}, gpu_profiler{gpu_profiler_},
+      astc_decoder_program(MakeProgram(ASTC_DECODER_COMP)),
       block_linear_unswizzle_2d_program(MakeProgram(BLOCK_LINEAR_UNSWIZZLE_2D_COMP)),
       block_linear_unswizzle_3d_program(MakeProgram(BLOCK_LINEAR_UNSWIZZLE_3D_COMP)),
       pitch_unswizzle_program(MakeProgram(PITCH_UNSWIZZLE_COMP)),
@@ -87,6 +89,7 @@ void UtilShaders::ASTCDecode(Image& image, const ImageBufferMap& map,
         .height = VideoCore::Surface::DefaultBlockHeight(image.info.format),
     };
     program_manager.BindHostCompute(astc_decoder_program.handle);
+    gpu_profiler.BeginScope("UtilShaders::ASTCDecode");
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BINDING_SWIZZLE_BUFFER, swizzle_table_buffer.handle);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BINDING_ENC_BUFFER, astc_buffer.handle);
 
@@ -124,6 +127,7 @@ void UtilShaders::ASTCDecode(Image& image, const ImageBufferMap& map,
     glMemoryBarrier(GL_UNIFORM_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_PIXEL_BUFFER_BARRIER_BIT |
                     GL_TEXTURE_UPDATE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT |
                     GL_SHADER_STORAGE_BARRIER_BIT | GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT);
+    gpu_profiler.EndScope();
     program_manager.RestoreGuestCompute();
 }
 
@@ -135,6 +139,7 @@ void UtilShaders::BlockLinearUpload2D(Image& image, const ImageBufferMap& map,
     static constexpr GLuint BINDING_OUTPUT_IMAGE = 0;
 
     program_manager.BindHostCompute(block_linear_unswizzle_2d_program.handle);
+    gpu_profiler.BeginScope("UtilShaders::BlockLinearUpload2D");
     glFlushMappedNamedBufferRange(map.buffer, map.offset, image.guest_size_bytes);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BINDING_SWIZZLE_BUFFER, swizzle_table_buffer.handle);
 
@@ -161,6 +166,7 @@ void UtilShaders::BlockLinearUpload2D(Image& image, const ImageBufferMap& map,
                            GL_WRITE_ONLY, store_format);
         glDispatchCompute(num_dispatches_x, num_dispatches_y, image.info.resources.layers);
     }
+    gpu_profiler.EndScope();
     program_manager.RestoreGuestCompute();
 }
 
@@ -174,6 +180,7 @@ void UtilShaders::BlockLinearUpload3D(Image& image, const ImageBufferMap& map,
 
     glFlushMappedNamedBufferRange(map.buffer, map.offset, image.guest_size_bytes);
     program_manager.BindHostCompute(block_linear_unswizzle_3d_program.handle);
+    gpu_profiler.BeginScope("UtilShaders::BlockLinearUpload3D");
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BINDING_SWIZZLE_BUFFER, swizzle_table_buffer.handle);
 
     const GLenum store_format = StoreFormat(BytesPerBlock(image.info.format));
@@ -202,6 +209,7 @@ void UtilShaders::BlockLinearUpload3D(Image& image, const ImageBufferMap& map,
                            GL_WRITE_ONLY, store_format);
         glDispatchCompute(num_dispatches_x, num_dispatches_y, num_dispatches_z);
     }
+    gpu_profiler.EndScope();
     program_manager.RestoreGuestCompute();
 }
 
@@ -223,6 +231,7 @@ void UtilShaders::PitchUpload(Image& image, const ImageBufferMap& map,
                          "Non-power of two images are not implemented");
 
     program_manager.BindHostCompute(pitch_unswizzle_program.handle);
+    gpu_profiler.BeginScope("UtilShaders::PitchUpload");
     glFlushMappedNamedBufferRange(map.buffer, map.offset, image.guest_size_bytes);
     glUniform2ui(LOC_ORIGIN, 0, 0);
     glUniform2i(LOC_DESTINATION, 0, 0);
@@ -241,6 +250,7 @@ void UtilShaders::PitchUpload(Image& image, const ImageBufferMap& map,
                           image.guest_size_bytes - swizzle.buffer_offset);
         glDispatchCompute(num_dispatches_x, num_dispatches_y, 1);
     }
+    gpu_profiler.EndScope();
     program_manager.RestoreGuestCompute();
 }
 
@@ -251,6 +261,7 @@ void UtilShaders::CopyBC4(Image& dst_image, Image& src_image, std::span<const Im
     static constexpr GLuint LOC_DST_OFFSET = 1;
 
     program_manager.BindHostCompute(copy_bc4_program.handle);
+    gpu_profiler.BeginScope("UtilShaders::CopyBC4");
 
     for (const ImageCopy& copy : copies) {
         ASSERT(copy.src_subresource.base_layer == 0);
@@ -266,6 +277,7 @@ void UtilShaders::CopyBC4(Image& dst_image, Image& src_image, std::span<const Im
                            copy.dst_subresource.base_level, GL_TRUE, 0, GL_WRITE_ONLY, GL_RGBA8UI);
         glDispatchCompute(copy.extent.width, copy.extent.height, copy.extent.depth);
     }
+    gpu_profiler.EndScope();
     program_manager.RestoreGuestCompute();
 }
 
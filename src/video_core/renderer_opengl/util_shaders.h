@@ -14,6 +14,7 @@
 
 namespace OpenGL {
 
+class GPUProfiler;
 class Image;
 class ProgramManager;
 
@@ -37,7 +38,7 @@ private:
 
 class UtilShaders {
 public:
-    explicit UtilShaders(ProgramManager& program_manager);
+    explicit UtilShaders(ProgramManager& program_manager, GPUProfiler& gpu_profiler);
     ~UtilShaders();
 
     void ASTCDecode(Image& image, const ImageBufferMap& map,
@@ -60,6 +61,7 @@ public:
 
 private:
     ProgramManager& program_manager;
+    GPUProfiler& gpu_profiler;
 
     OGLBuffer swizzle_table_buffer;
     OGLBuffer astc_buffer;
@@ -231,16 +231,31 @@ FormatInfo SurfaceFormat(const Device& device, FormatType format_type, bool with
         return FormatInfo{VK_FORMAT_A8B8G8R8_UNORM_PACK32, true, true};
     }
 
-    // Use A8B8G8R8_UNORM on hardware that doesn't support ASTC natively
+    // Use A8B8G8R8_UNORM or BC3 on hardware that doesn't support ASTC natively
     if (!device.IsOptimalAstcSupported() && VideoCore::Surface::IsPixelFormatASTC(pixel_format)) {
         const bool is_srgb = with_srgb && VideoCore::Surface::IsPixelFormatSRGB(pixel_format);
-        if (is_srgb) {
+        if (device.UseAstcTranscoding()) {
+            tuple.format = is_srgb ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+        } else if (is_srgb) {
             tuple.format = VK_FORMAT_A8B8G8R8_SRGB_PACK32;
         } else {
             tuple.format = VK_FORMAT_A8B8G8R8_UNORM_PACK32;
             tuple.usage |= Storage;
         }
     }
+    // BC1 to BC5 are decoded into A8B8G8R8 on hardware that doesn't support them natively
+    if (!device.IsOptimalBcnSupported() && VideoCore::Surface::IsPixelFormatBC1To5(pixel_format)) {
+        if (with_srgb && VideoCore::Surface::IsPixelFormatSRGB(pixel_format)) {
+            tuple.format = VK_FORMAT_A8B8G8R8_SRGB_PACK32;
+        } else if (pixel_format == PixelFormat::BC4_SNORM ||
+                   pixel_format == PixelFormat::BC5_SNORM) {
+            tuple.format = VK_FORMAT_A8B8G8R8_SNORM_PACK32;
+            tuple.usage |= Storage;
+        } else {
+            tuple.format = VK_FORMAT_A8B8G8R8_UNORM_PACK32;
+            tuple.usage |= Storage;
+        }
+    }
     const bool attachable = (tuple.usage & Attachable) != 0;
     const bool storage = (tuple.usage & Storage) != 0;
 
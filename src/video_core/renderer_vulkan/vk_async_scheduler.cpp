@@ -0,0 +1,87 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <memory>
+
+#include "video_core/renderer_vulkan/vk_command_pool.h"
+#include "video_core/renderer_vulkan/vk_master_semaphore.h"
+#include "video_core/renderer_vulkan/vk_async_scheduler.h"
+#include "video_core/vulkan_common/vulkan_device.h"
+#include "video_core/vulkan_common/vulkan_wrapper.h"
+
+namespace Vulkan {
+
+AsyncScheduler::AsyncScheduler(const Device& device_, vk::Queue queue_, u32 queue_family_)
+    : device{device_}, queue{queue_}, queue_family{queue_family_},
+      master_semaphore{std::make_unique<MasterSemaphore>(device)},
+      command_pool{std::make_unique<CommandPool>(*master_semaphore, device, queue_family)} {}
+
+AsyncScheduler::~AsyncScheduler() = default;
+
+u64 AsyncScheduler::Submit() {
+    if (!has_work) {
+        return 0;
+    }
+    has_work = false;
+    current_cmdbuf.End();
+
+    const u64 signal_value = master_semaphore->CurrentTick();
+    master_semaphore->NextTick();
+
+    const VkSemaphore timeline_semaphore = master_semaphore->Handle();
+    const VkTimelineSemaphoreSubmitInfoKHR timeline_si{
+        .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR,
+        .pNext = nullptr,
+        .waitSemaphoreValueCount = 0,
+        .pWaitSemaphoreValues = nullptr,
+        .signalSemaphoreValueCount = 1,
+        .pSignalSemaphoreValues = &signal_value,
+    };
+    const VkSubmitInfo submit_info{
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .pNext = &timeline_si,
+        .waitSemaphoreCount = 0,
+        .pWaitSemaphores = nullptr,
+        .pWaitDstStageMask = nullptr,
+        .commandBufferCount = 1,
+        .pCommandBuffers = current_cmdbuf.address(),
+        .signalSemaphoreCount = 1,
+        .pSignalSemaphores = &timeline_semaphore,
+    };
+    switch (const VkResult result = queue.Submit(submit_info)) {
+    case VK_SUCCESS:
+        break;
+    case VK_ERROR_DEVICE_LOST:
+        device.ReportLoss();
+        [[fallthrough]];
+    default:
+        vk::Check(result);
+    }
+    return signal_value;
+}
+
+VkSemaphore AsyncScheduler::Semaphore() const noexcept {
+    return master_semaphore->Handle();
+}
+
+u32 AsyncScheduler::GraphicsFamily() const noexcept {
+    return device.GetGraphicsFamily();
+}
+
+void AsyncScheduler::TickFrame() noexcept {
+    command_pool->TickFrame();
+}
+
+void AsyncScheduler::BeginCommandBuffer() {
+    has_work = true;
+    current_cmdbuf = vk::CommandBuffer(command_pool->Commit(), device.GetDispatchLoader());
+    current_cmdbuf.Begin({
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .pNext = nullptr,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+        .pInheritanceInfo = nullptr,
+    });
+}
+
+} // namespace Vulkan
@@ -0,0 +1,71 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+
+#include "common/common_types.h"
+#include "video_core/vulkan_common/vulkan_wrapper.h"
+
+namespace Vulkan {
+
+class CommandPool;
+class Device;
+class MasterSemaphore;
+
+/**
+ * Records work on one of the device's dedicated transfer or compute queues, so it runs in
+ * parallel with the graphics queue instead of being serialized with rendering.
+ * Commands are recorded immediately on the caller thread. They are submitted right before the
+ * graphics command buffer that uses them, and that submission waits for them on the timeline.
+ */
+class AsyncScheduler {
+public:
+    explicit AsyncScheduler(const Device& device, vk::Queue queue, u32 queue_family);
+    ~AsyncScheduler();
+
+    /// Records commands in the pending command buffer.
+    template <typename Func>
+    void Record(Func&& func) {
+        if (!has_work) {
+            BeginCommandBuffer();
+        }
+        func(current_cmdbuf);
+    }
+
+    /**
+     * Submits the pending command buffer.
+     * @returns The timeline value that is signaled when the commands finish, or zero when there
+     *          was nothing to submit.
+     */
+    [[nodiscard]] u64 Submit();
+
+    /// Returns the timeline semaphore handle of the queue.
+    [[nodiscard]] VkSemaphore Semaphore() const noexcept;
+
+    /// Returns the queue family commands are recorded for.
+    [[nodiscard]] u32 QueueFamily() const noexcept {
+        return queue_family;
+    }
+
+    /// Returns the queue family resources written by the queue are released to.
+    [[nodiscard]] u32 GraphicsFamily() const noexcept;
+
+    /// Signals a frame boundary, command buffers of the next frame come from another pool.
+    void TickFrame() noexcept;
+
+private:
+    void BeginCommandBuffer();
+
+    const Device& device;
+    vk::Queue queue;
+    u32 queue_family;
+    std::unique_ptr<MasterSemaphore> master_semaphore;
+    std::unique_ptr<CommandPool> command_pool;
+    vk::CommandBuffer current_cmdbuf;
+    bool has_work = false;
+};
+
+} // namespace Vulkan
@@ -140,6 +140,7 @@ VkSemaphore VKBlitScreen::Draw(const Tegra::FramebufferConfig& framebuffer, bool
 
     scheduler.Wait(resource_ticks[image_index]);
     resource_ticks[image_index] = scheduler.CurrentTick();
+    scheduler.BeginProfileScope("Present");
 
     UpdateDescriptorSet(image_index,
                         use_accelerated ? screen_info.image_view : *raw_image_views[image_index]);
@@ -266,6 +267,7 @@ VkSemaphore VKBlitScreen::Draw(const Tegra::FramebufferConfig& framebuffer, bool
         cmdbuf.Draw(4, 1, 0, 0);
         cmdbuf.EndRenderPass();
     });
+    scheduler.EndProfileScope();
     return *semaphores[image_index];
 }
 
@@ -758,7 +760,7 @@ void VKBlitScreen::UpdateDescriptorSet(std::size_t image_index, VkImageView imag
 
 void VKBlitScreen::SetUniformData(BufferData& data,
                                   const Tegra::FramebufferConfig& framebuffer) const {
-    const auto& layout = render_window.GetFramebufferLayout();
+    const auto layout = render_window.GetFramebufferLayout();
     data.uniform.modelview_matrix =
         MakeOrthographicMatrix(static_cast<f32>(layout.width), static_cast<f32>(layout.height));
 }
@@ -802,7 +804,7 @@ void VKBlitScreen::SetVertexData(BufferData& data,
                   static_cast<f32>(screen_info.height);
     }
 
-    const auto& screen = render_window.GetFramebufferLayout().screen;
+    const auto screen = render_window.GetFramebufferLayout().screen;
     const auto x = static_cast<f32>(screen.left);
     const auto y = static_cast<f32>(screen.top);
     const auto w = static_cast<f32>(screen.GetWidth());
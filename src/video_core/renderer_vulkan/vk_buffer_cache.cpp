@@ -20,6 +20,10 @@
 
 namespace Vulkan {
 namespace {
+// Largest index or vertex binding streamed to the GPU, these are read from guest memory on every
+// draw until their buffer is uploaded
+constexpr u32 MAX_STREAMED_BINDING_SIZE = 16 * 1024;
+
 VkBufferCopy MakeBufferCopy(const VideoCommon::BufferCopy& copy) {
     return VkBufferCopy{
         .srcOffset = copy.src_offset,
@@ -101,8 +105,16 @@ StagingBufferRef BufferCacheRuntime::UploadStagingBuffer(size_t size) {
     return staging_pool.Request(size, MemoryUsage::Upload);
 }
 
-StagingBufferRef BufferCacheRuntime::DownloadStagingBuffer(size_t size) {
-    return staging_pool.Request(size, MemoryUsage::Download);
+bool BufferCacheRuntime::CanStreamBinding(u32 size) const noexcept {
+    return size <= MAX_STREAMED_BINDING_SIZE && staging_pool.IsStreamBufferDeviceLocal();
+}
+
+StagingBufferRef BufferCacheRuntime::DownloadStagingBuffer(size_t size, bool deferred) {
+    return staging_pool.Request(size, MemoryUsage::Download, deferred);
+}
+
+void BufferCacheRuntime::FreeDeferredStagingBuffer(const StagingBufferRef& ref) {
+    staging_pool.FreeDeferred(ref);
 }
 
 void BufferCacheRuntime::Finish() {
@@ -123,6 +135,7 @@ void BufferCacheRuntime::CopyBuffer(VkBuffer dst_buffer, VkBuffer src_buffer,
         .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
         .dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT,
     };
+    InvalidateIndexConversions(dst_buffer);
     // Measuring a popular game, this number never exceeds the specified size once data is warmed up
     boost::container::small_vector<VkBufferCopy, 3> vk_copies(copies.size());
     std::ranges::transform(copies, vk_copies.begin(), MakeBufferCopy);
@@ -145,10 +158,15 @@ void BufferCacheRuntime::BindIndexBuffer(PrimitiveTopology topology, IndexFormat
     if (topology == PrimitiveTopology::Quads) {
         vk_index_type = VK_INDEX_TYPE_UINT32;
         std::tie(vk_buffer, vk_offset) =
-            quad_index_pass.Assemble(index_format, num_indices, base_vertex, buffer, offset);
+            ConvertIndexBuffer(true, index_format, num_indices, base_vertex, buffer, offset, [&] {
+                return quad_index_pass.Assemble(index_format, num_indices, base_vertex, buffer,
+                                                offset);
+            });
     } else if (vk_index_type == VK_INDEX_TYPE_UINT8_EXT && !device.IsExtIndexTypeUint8Supported()) {
         vk_index_type = VK_INDEX_TYPE_UINT16;
-        std::tie(vk_buffer, vk_offset) = uint8_pass.Assemble(num_indices, buffer, offset);
+        std::tie(vk_buffer, vk_offset) =
+            ConvertIndexBuffer(false, index_format, num_indices, 0, buffer, offset,
+                               [&] { return uint8_pass.Assemble(num_indices, buffer, offset); });
     }
     if (vk_buffer == VK_NULL_HANDLE) {
         // Vulkan doesn't support null index buffers. Replace it with our own null buffer.
@@ -195,6 +213,7 @@ void BufferCacheRuntime::BindTransformFeedbackBuffer(u32 index, VkBuffer buffer,
         // Already logged in the rasterizer
         return;
     }
+    InvalidateIndexConversions(buffer);
     scheduler.Record([index, buffer, offset, size](vk::CommandBuffer cmdbuf) {
         const VkDeviceSize vk_offset = offset;
         const VkDeviceSize vk_size = size;
@@ -202,6 +221,46 @@ void BufferCacheRuntime::BindTransformFeedbackBuffer(u32 index, VkBuffer buffer,
     });
 }
 
+template <typename Func>
+std::pair<VkBuffer, VkDeviceSize> BufferCacheRuntime::ConvertIndexBuffer(
+    bool is_quad, IndexFormat index_format, u32 num_indices, u32 base_vertex, VkBuffer src_buffer,
+    u32 src_offset, Func&& convert) {
+    // Converted indices live in staging memory that is only kept reserved for the current tick
+    const u64 current_tick = scheduler.CurrentTick();
+    if (index_conversions_tick != current_tick) {
+        index_conversions_tick = current_tick;
+        index_conversions.clear();
+    }
+    const auto it = std::ranges::find_if(index_conversions, [&](const IndexConversion& entry) {
+        return entry.src_buffer == src_buffer && entry.src_offset == src_offset &&
+               entry.num_indices == num_indices && entry.base_vertex == base_vertex &&
+               entry.index_format == index_format && entry.is_quad == is_quad;
+    });
+    if (it != index_conversions.end()) {
+        return {it->buffer, it->offset};
+    }
+    const auto [buffer, offset] = convert();
+    if (index_conversions.size() >= MAX_INDEX_CONVERSIONS) {
+        index_conversions.erase(index_conversions.begin());
+    }
+    index_conversions.push_back(IndexConversion{
+        .src_buffer = src_buffer,
+        .src_offset = src_offset,
+        .num_indices = num_indices,
+        .base_vertex = base_vertex,
+        .index_format = index_format,
+        .is_quad = is_quad,
+        .buffer = buffer,
+        .offset = offset,
+    });
+    return {buffer, offset};
+}
+
+void BufferCacheRuntime::InvalidateIndexConversions(VkBuffer buffer) {
+    std::erase_if(index_conversions,
+                  [buffer](const IndexConversion& entry) { return entry.src_buffer == buffer; });
+}
+
 void BufferCacheRuntime::ReserveQuadArrayLUT(u32 num_indices, bool wait_for_idle) {
     if (num_indices <= current_num_indices) {
         return;
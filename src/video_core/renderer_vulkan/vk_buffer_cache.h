@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <utility>
+#include <vector>
+
 #include "video_core/buffer_cache/buffer_cache.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/renderer_vulkan/vk_compute_pass.h"
@@ -55,7 +58,13 @@ public:
 
     [[nodiscard]] StagingBufferRef UploadStagingBuffer(size_t size);
 
-    [[nodiscard]] StagingBufferRef DownloadStagingBuffer(size_t size);
+    /// Returns true when an index or vertex binding of the given size can be written straight to
+    /// device local memory instead of being copied to its buffer
+    [[nodiscard]] bool CanStreamBinding(u32 size) const noexcept;
+
+    [[nodiscard]] StagingBufferRef DownloadStagingBuffer(size_t size, bool deferred = false);
+
+    void FreeDeferredStagingBuffer(const StagingBufferRef& ref);
 
     void CopyBuffer(VkBuffer src_buffer, VkBuffer dst_buffer,
                     std::span<const VideoCommon::BufferCopy> copies);
@@ -80,12 +89,29 @@ public:
         BindBuffer(buffer, offset, size);
     }
 
-    void BindStorageBuffer(VkBuffer buffer, u32 offset, u32 size,
-                           [[maybe_unused]] bool is_written) {
+    void BindStorageBuffer(VkBuffer buffer, u32 offset, u32 size, bool is_written) {
+        if (is_written) {
+            InvalidateIndexConversions(buffer);
+        }
         BindBuffer(buffer, offset, size);
     }
 
 private:
+    /// Index buffer converted by a compute pass, valid until its source is written
+    struct IndexConversion {
+        VkBuffer src_buffer;
+        u32 src_offset;
+        u32 num_indices;
+        u32 base_vertex;
+        IndexFormat index_format;
+        bool is_quad;
+        VkBuffer buffer;
+        VkDeviceSize offset;
+    };
+
+    /// Maximum number of conversions remembered within a scheduler tick
+    static constexpr size_t MAX_INDEX_CONVERSIONS = 64;
+
     void BindBuffer(VkBuffer buffer, u32 offset, u32 size) {
         update_descriptor_queue.AddBuffer(buffer, offset, size);
     }
@@ -94,6 +120,16 @@ private:
 
     void ReserveNullIndexBuffer();
 
+    /// Returns a conversion made in this tick or converts the index buffer with the given pass
+    template <typename Func>
+    std::pair<VkBuffer, VkDeviceSize> ConvertIndexBuffer(bool is_quad, IndexFormat index_format,
+                                                         u32 num_indices, u32 base_vertex,
+                                                         VkBuffer src_buffer, u32 src_offset,
+                                                         Func&& convert);
+
+    /// Forgets conversions reading from the given buffer
+    void InvalidateIndexConversions(VkBuffer buffer);
+
     const Device& device;
     MemoryAllocator& memory_allocator;
     VKScheduler& scheduler;
@@ -110,11 +146,15 @@ private:
 
     Uint8Pass uint8_pass;
     QuadIndexedPass quad_index_pass;
+
+    std::vector<IndexConversion> index_conversions;
+    u64 index_conversions_tick = 0;
 };
 
 struct BufferCacheParams {
     using Runtime = Vulkan::BufferCacheRuntime;
     using Buffer = Vulkan::Buffer;
+    using AsyncBuffer = Vulkan::StagingBufferRef;
 
     static constexpr bool IS_OPENGL = false;
     static constexpr bool HAS_PERSISTENT_UNIFORM_BUFFER_BINDINGS = false;
@@ -122,6 +162,9 @@ struct BufferCacheParams {
     static constexpr bool NEEDS_BIND_UNIFORM_INDEX = false;
     static constexpr bool NEEDS_BIND_STORAGE_INDEX = false;
     static constexpr bool USE_MEMORY_MAPS = true;
+    static constexpr bool IMPLEMENTS_ASYNC_DOWNLOADS = true;
+    static constexpr bool HAS_STREAMED_UPLOADS = false;
+    static constexpr bool HAS_STREAMED_BINDINGS = true;
 };
 
 using BufferCache = VideoCommon::BufferCache<BufferCacheParams>;
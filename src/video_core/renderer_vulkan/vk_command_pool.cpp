@@ -5,42 +5,73 @@
 #include <cstddef>
 
 #include "video_core/renderer_vulkan/vk_command_pool.h"
+#include "video_core/renderer_vulkan/vk_master_semaphore.h"
 #include "video_core/vulkan_common/vulkan_device.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
 
 namespace Vulkan {
 
-constexpr size_t COMMAND_BUFFER_POOL_SIZE = 4;
+/// Number of pools created up front, enough for the frames in flight plus the one being recorded
+constexpr size_t NUM_FRAME_POOLS = 3;
+
+/// Number of command buffers preallocated in each pool, a frame using them up moves to a new pool
+constexpr size_t COMMAND_BUFFERS_PER_POOL = 32;
 
 struct CommandPool::Pool {
     vk::CommandPool handle;
     vk::CommandBuffers cmdbufs;
+    size_t next_cmdbuf = 0; ///< Index of the next command buffer to commit.
+    u64 tick = 0;           ///< Tick the last command buffer committed from the pool is done at.
 };
 
-CommandPool::CommandPool(MasterSemaphore& master_semaphore_, const Device& device_)
-    : ResourcePool(master_semaphore_, COMMAND_BUFFER_POOL_SIZE), device{device_} {}
+CommandPool::CommandPool(MasterSemaphore& master_semaphore_, const Device& device_,
+                         u32 queue_family_)
+    : master_semaphore{master_semaphore_}, device{device_}, queue_family{queue_family_} {
+    pools.reserve(NUM_FRAME_POOLS);
+    for (size_t index = 0; index < NUM_FRAME_POOLS; ++index) {
+        pools.push_back(CreatePool());
+    }
+}
 
 CommandPool::~CommandPool() = default;
 
-void CommandPool::Allocate(size_t begin, size_t end) {
-    // Command buffers are going to be commited, recorded, executed every single usage cycle.
-    // They are also going to be reseted when commited.
-    Pool& pool = pools.emplace_back();
+VkCommandBuffer CommandPool::Commit() {
+    Pool* pool = &pools[current_pool];
+    const bool frame_ended = frame_ticked.exchange(false, std::memory_order_relaxed);
+    if ((frame_ended && pool->next_cmdbuf != 0) || pool->next_cmdbuf == COMMAND_BUFFERS_PER_POOL) {
+        pool = &NextPool();
+    }
+    // The command buffer is submitted on the current tick at the earliest, waiting for it is
+    // conservative when it's submitted later
+    pool->tick = master_semaphore.CurrentTick();
+    return pool->cmdbufs[pool->next_cmdbuf++];
+}
+
+CommandPool::Pool CommandPool::CreatePool() const {
+    // Command buffers are recorded once and submitted, then reset all together with their pool.
+    Pool pool;
     pool.handle = device.GetLogical().CreateCommandPool({
         .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
         .pNext = nullptr,
-        .flags =
-            VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
-        .queueFamilyIndex = device.GetGraphicsFamily(),
+        .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+        .queueFamilyIndex = queue_family,
     });
-    pool.cmdbufs = pool.handle.Allocate(COMMAND_BUFFER_POOL_SIZE);
+    pool.cmdbufs = pool.handle.Allocate(COMMAND_BUFFERS_PER_POOL);
+    return pool;
 }
 
-VkCommandBuffer CommandPool::Commit() {
-    const size_t index = CommitResource();
-    const auto pool_index = index / COMMAND_BUFFER_POOL_SIZE;
-    const auto sub_index = index % COMMAND_BUFFER_POOL_SIZE;
-    return pools[pool_index].cmdbufs[sub_index];
+CommandPool::Pool& CommandPool::NextPool() {
+    const size_t next_pool = (current_pool + 1) % pools.size();
+    current_pool = next_pool;
+    if (!master_semaphore.IsFree(pools[next_pool].tick)) {
+        // The GPU is still executing the oldest pool, grow the ring instead of stalling on it.
+        // The new pool is inserted as the newest one, leaving the oldest as the next in line.
+        return *pools.insert(pools.begin() + next_pool, CreatePool());
+    }
+    Pool& pool = pools[next_pool];
+    pool.handle.Reset();
+    pool.next_cmdbuf = 0;
+    return pool;
 }
 
 } // namespace Vulkan
@@ -4,10 +4,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <vector>
 
-#include "video_core/renderer_vulkan/vk_resource_pool.h"
+#include "common/common_types.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
 
 namespace Vulkan {
@@ -15,20 +16,40 @@ namespace Vulkan {
 class Device;
 class MasterSemaphore;
 
-class CommandPool final : public ResourcePool {
+/**
+ * Hands out preallocated command buffers from a ring of pools, one per frame in flight.
+ * Command buffers are never reset on their own. Their whole pool is reset when it's reused, after
+ * the GPU is done with every command buffer committed from it.
+ */
+class CommandPool final {
 public:
-    explicit CommandPool(MasterSemaphore& master_semaphore_, const Device& device_);
-    ~CommandPool() override;
-
-    void Allocate(size_t begin, size_t end) override;
+    explicit CommandPool(MasterSemaphore& master_semaphore_, const Device& device_,
+                         u32 queue_family_);
+    ~CommandPool();
 
+    /// Returns a command buffer in the initial state, to be submitted on the current tick or later.
     VkCommandBuffer Commit();
 
+    /// Signals a frame boundary, the next commit moves on to the pool of the next frame.
+    void TickFrame() noexcept {
+        frame_ticked.store(true, std::memory_order_relaxed);
+    }
+
 private:
     struct Pool;
 
+    /// Creates a pool with all of its command buffers allocated.
+    Pool CreatePool() const;
+
+    /// Moves on to the oldest pool and resets it, or to a new pool when the GPU still uses it.
+    Pool& NextPool();
+
+    MasterSemaphore& master_semaphore;
     const Device& device;
+    u32 queue_family;
     std::vector<Pool> pools;
+    size_t current_pool = 0;
+    std::atomic_bool frame_ticked{false};
 };
 
 } // namespace Vulkan
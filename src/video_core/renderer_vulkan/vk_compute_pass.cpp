@@ -12,8 +12,10 @@
 #include "common/common_types.h"
 #include "common/div_ceil.h"
 #include "video_core/host_shaders/astc_decoder_comp_spv.h"
+#include "video_core/host_shaders/vulkan_bcn_decoder_comp_spv.h"
 #include "video_core/host_shaders/vulkan_quad_indexed_comp_spv.h"
 #include "video_core/host_shaders/vulkan_uint8_comp_spv.h"
+#include "video_core/renderer_vulkan/vk_async_scheduler.h"
 #include "video_core/renderer_vulkan/vk_compute_pass.h"
 #include "video_core/renderer_vulkan/vk_descriptor_pool.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
@@ -41,6 +43,18 @@ constexpr u32 ASTC_BINDING_SWIZZLE_BUFFER = 2;
 constexpr u32 ASTC_BINDING_OUTPUT_IMAGE = 3;
 constexpr size_t ASTC_NUM_BINDINGS = 4;
 
+constexpr u32 BCN_BINDING_INPUT_BUFFER = 0;
+constexpr u32 BCN_BINDING_OUTPUT_IMAGE = 1;
+constexpr size_t BCN_NUM_BINDINGS = 2;
+
+// Keep in sync with vulkan_bcn_decoder.comp
+constexpr u32 BCN_FORMAT_BC1 = 0;
+constexpr u32 BCN_FORMAT_BC2 = 1;
+constexpr u32 BCN_FORMAT_BC3 = 2;
+constexpr u32 BCN_FORMAT_BC4 = 3;
+constexpr u32 BCN_FORMAT_BC5 = 4;
+constexpr u32 BCN_FORMAT_SIGNED_BIT = 8;
+
 VkPushConstantRange BuildComputePushConstantRange(std::size_t size) {
     return {
         .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
@@ -160,6 +174,83 @@ struct AstcPushConstants {
     u32 block_height_mask;
 };
 
+std::array<VkDescriptorSetLayoutBinding, BCN_NUM_BINDINGS> BuildBCnDescriptorSetBindings() {
+    return {{
+        {
+            .binding = BCN_BINDING_INPUT_BUFFER,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .descriptorCount = 1,
+            .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+            .pImmutableSamplers = nullptr,
+        },
+        {
+            .binding = BCN_BINDING_OUTPUT_IMAGE,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+            .descriptorCount = 1,
+            .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+            .pImmutableSamplers = nullptr,
+        },
+    }};
+}
+
+std::array<VkDescriptorUpdateTemplateEntryKHR, BCN_NUM_BINDINGS>
+BuildBCnPassDescriptorUpdateTemplateEntry() {
+    return {{
+        {
+            .dstBinding = BCN_BINDING_INPUT_BUFFER,
+            .dstArrayElement = 0,
+            .descriptorCount = 1,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .offset = BCN_BINDING_INPUT_BUFFER * sizeof(DescriptorUpdateEntry),
+            .stride = sizeof(DescriptorUpdateEntry),
+        },
+        {
+            .dstBinding = BCN_BINDING_OUTPUT_IMAGE,
+            .dstArrayElement = 0,
+            .descriptorCount = 1,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+            .offset = BCN_BINDING_OUTPUT_IMAGE * sizeof(DescriptorUpdateEntry),
+            .stride = sizeof(DescriptorUpdateEntry),
+        },
+    }};
+}
+
+struct BCnPushConstants {
+    u32 bcn_format;
+    u32 bytes_per_block_log2;
+    u32 layer_stride;
+    u32 block_size;
+    u32 x_shift;
+    u32 block_height;
+    u32 block_height_mask;
+};
+
+u32 BCnShaderFormat(VideoCore::Surface::PixelFormat format) {
+    using VideoCore::Surface::PixelFormat;
+    switch (format) {
+    case PixelFormat::BC1_RGBA_UNORM:
+    case PixelFormat::BC1_RGBA_SRGB:
+        return BCN_FORMAT_BC1;
+    case PixelFormat::BC2_UNORM:
+    case PixelFormat::BC2_SRGB:
+        return BCN_FORMAT_BC2;
+    case PixelFormat::BC3_UNORM:
+    case PixelFormat::BC3_SRGB:
+        return BCN_FORMAT_BC3;
+    case PixelFormat::BC4_UNORM:
+        return BCN_FORMAT_BC4;
+    case PixelFormat::BC4_SNORM:
+        return BCN_FORMAT_BC4 | BCN_FORMAT_SIGNED_BIT;
+    case PixelFormat::BC5_UNORM:
+        return BCN_FORMAT_BC5;
+    case PixelFormat::BC5_SNORM:
+        return BCN_FORMAT_BC5 | BCN_FORMAT_SIGNED_BIT;
+    default:
+        UNREACHABLE_MSG("Invalid BCn format={}", format);
+        return BCN_FORMAT_BC1;
+    }
+}
+
 } // Anonymous namespace
 
 VKComputePass::VKComputePass(const Device& device, VKDescriptorPool& descriptor_pool,
@@ -238,6 +329,16 @@ VkDescriptorSet VKComputePass::CommitDescriptorSet(
     return set;
 }
 
+VkDescriptorSet VKComputePass::CommitImmediateDescriptorSet(
+    VKUpdateDescriptorQueue& update_descriptor_queue) {
+    if (!descriptor_template) {
+        return nullptr;
+    }
+    const VkDescriptorSet set = descriptor_allocator->Commit();
+    update_descriptor_queue.UpdateNow(*descriptor_template, set);
+    return set;
+}
+
 Uint8Pass::Uint8Pass(const Device& device, VKScheduler& scheduler_,
                      VKDescriptorPool& descriptor_pool, StagingBufferPool& staging_buffer_pool_,
                      VKUpdateDescriptorQueue& update_descriptor_queue_)
@@ -353,15 +454,18 @@ ASTCDecoderPass::~ASTCDecoderPass() = default;
 
 void ASTCDecoderPass::MakeDataBuffer() {
     constexpr size_t TOTAL_BUFFER_SIZE = sizeof(ASTC_ENCODINGS_VALUES) + sizeof(SWIZZLE_TABLE);
+    // Read by decodes on both the graphics and the compute queue
+    const std::span<const u32> sharing_families = device.GetStagingSharingFamilies();
     data_buffer = device.GetLogical().CreateBuffer(VkBufferCreateInfo{
         .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
         .pNext = nullptr,
         .flags = 0,
         .size = TOTAL_BUFFER_SIZE,
         .usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
-        .queueFamilyIndexCount = 0,
-        .pQueueFamilyIndices = nullptr,
+        .sharingMode =
+            sharing_families.empty() ? VK_SHARING_MODE_EXCLUSIVE : VK_SHARING_MODE_CONCURRENT,
+        .queueFamilyIndexCount = static_cast<u32>(sharing_families.size()),
+        .pQueueFamilyIndices = sharing_families.data(),
     });
     data_buffer_commit = memory_allocator.Commit(data_buffer, MemoryUsage::Upload);
 
@@ -372,8 +476,8 @@ void ASTCDecoderPass::MakeDataBuffer() {
     std::memcpy(staging_ref.mapped_span.data() + sizeof(ASTC_ENCODINGS_VALUES), &SWIZZLE_TABLE,
                 sizeof(SWIZZLE_TABLE));
 
-    scheduler.Record([src = staging_ref.buffer, offset = staging_ref.offset, dst = *data_buffer,
-                      TOTAL_BUFFER_SIZE](vk::CommandBuffer cmdbuf) {
+    auto upload = [src = staging_ref.buffer, offset = staging_ref.offset, dst = *data_buffer,
+                   TOTAL_BUFFER_SIZE](vk::CommandBuffer cmdbuf) {
         cmdbuf.CopyBuffer(src, dst,
                           VkBufferCopy{
                               .srcOffset = offset,
@@ -385,10 +489,17 @@ void ASTCDecoderPass::MakeDataBuffer() {
             VkMemoryBarrier{
                 .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
                 .pNext = nullptr,
-                .srcAccessMask = 0,
-                .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+                .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT |
+                                 VK_ACCESS_SHADER_READ_BIT,
             });
-    });
+    };
+    if (AsyncScheduler* const compute_scheduler = scheduler.GetComputeScheduler()) {
+        // The next graphics submission waits for the compute queue, so both see the upload
+        compute_scheduler->Record(upload);
+    } else {
+        scheduler.Record(std::move(upload));
+    }
 }
 
 void ASTCDecoderPass::Assemble(Image& image, const StagingBufferRef& map,
@@ -406,6 +517,13 @@ void ASTCDecoderPass::Assemble(Image& image, const StagingBufferRef& map,
     const VkImageAspectFlags aspect_mask = image.AspectMask();
     const VkImage vk_image = image.Handle();
     const bool is_initialized = image.ExchangeInitialization();
+    AsyncScheduler* const compute_scheduler = scheduler.GetComputeScheduler();
+    if (compute_scheduler && !is_initialized && image.modification_tick == 0) {
+        // Images the GPU hasn't used yet can't be referenced by pending graphics work
+        AssembleAsync(*compute_scheduler, image, map, swizzles);
+        return;
+    }
+    scheduler.BeginProfileScope("ASTCDecoderPass");
     scheduler.Record(
         [vk_pipeline, vk_image, aspect_mask, is_initialized](vk::CommandBuffer cmdbuf) {
             const VkImageMemoryBarrier image_barrier{
@@ -489,7 +607,204 @@ void ASTCDecoderPass::Assemble(Image& image, const StagingBufferRef& map,
         cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
                                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, image_barrier);
     });
+    scheduler.EndProfileScope();
     scheduler.Finish();
 }
 
+void ASTCDecoderPass::AssembleAsync(AsyncScheduler& compute_scheduler, Image& image,
+                                    const StagingBufferRef& map,
+                                    std::span<const VideoCommon::SwizzleParameters> swizzles) {
+    const std::array<u32, 2> block_dims{
+        VideoCore::Surface::DefaultBlockWidth(image.info.format),
+        VideoCore::Surface::DefaultBlockHeight(image.info.format),
+    };
+    const VkImageSubresourceRange subresource_range{
+        .aspectMask = image.AspectMask(),
+        .baseMipLevel = 0,
+        .levelCount = VK_REMAINING_MIP_LEVELS,
+        .baseArrayLayer = 0,
+        .layerCount = VK_REMAINING_ARRAY_LAYERS,
+    };
+    const VkImageMemoryBarrier write_barrier{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .pNext = nullptr,
+        .srcAccessMask = 0,
+        .dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+        .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .image = image.Handle(),
+        .subresourceRange = subresource_range,
+    };
+    // The image is released to the graphics queue, which acquires it with the same barrier
+    const VkImageMemoryBarrier release_barrier{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .pNext = nullptr,
+        .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+        .dstAccessMask = 0,
+        .oldLayout = VK_IMAGE_LAYOUT_GENERAL,
+        .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+        .srcQueueFamilyIndex = compute_scheduler.QueueFamily(),
+        .dstQueueFamilyIndex = compute_scheduler.GraphicsFamily(),
+        .image = image.Handle(),
+        .subresourceRange = subresource_range,
+    };
+    VkImageMemoryBarrier acquire_barrier = release_barrier;
+    acquire_barrier.srcAccessMask = 0;
+    acquire_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+    compute_scheduler.Record([&](vk::CommandBuffer cmdbuf) {
+        cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                               VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, write_barrier);
+        cmdbuf.BindPipeline(VK_PIPELINE_BIND_POINT_COMPUTE, *pipeline);
+    });
+    for (const VideoCommon::SwizzleParameters& swizzle : swizzles) {
+        const size_t input_offset = swizzle.buffer_offset + map.offset;
+        const u32 num_dispatches_x = Common::DivCeil(swizzle.num_tiles.width, 32U);
+        const u32 num_dispatches_y = Common::DivCeil(swizzle.num_tiles.height, 32U);
+        const u32 num_dispatches_z = image.info.resources.layers;
+
+        update_descriptor_queue.Acquire();
+        update_descriptor_queue.AddBuffer(map.buffer, input_offset,
+                                          image.guest_size_bytes - swizzle.buffer_offset);
+        update_descriptor_queue.AddBuffer(*data_buffer, 0, sizeof(ASTC_ENCODINGS_VALUES));
+        update_descriptor_queue.AddBuffer(*data_buffer, sizeof(ASTC_ENCODINGS_VALUES),
+                                          sizeof(SWIZZLE_TABLE));
+        update_descriptor_queue.AddImage(image.StorageImageView(swizzle.level));
+
+        // The compute queue records immediately, the set can't wait for the scheduler worker
+        const VkDescriptorSet set = CommitImmediateDescriptorSet(update_descriptor_queue);
+        const auto params = MakeBlockLinearSwizzle2DParams(swizzle, image.info);
+        ASSERT(params.origin == (std::array<u32, 3>{0, 0, 0}));
+        ASSERT(params.destination == (std::array<s32, 3>{0, 0, 0}));
+        const AstcPushConstants uniforms{
+            .blocks_dims = block_dims,
+            .bytes_per_block_log2 = params.bytes_per_block_log2,
+            .layer_stride = params.layer_stride,
+            .block_size = params.block_size,
+            .x_shift = params.x_shift,
+            .block_height = params.block_height,
+            .block_height_mask = params.block_height_mask,
+        };
+        compute_scheduler.Record([&](vk::CommandBuffer cmdbuf) {
+            cmdbuf.BindDescriptorSets(VK_PIPELINE_BIND_POINT_COMPUTE, *layout, 0, set, {});
+            cmdbuf.PushConstants(*layout, VK_SHADER_STAGE_COMPUTE_BIT, uniforms);
+            cmdbuf.Dispatch(num_dispatches_x, num_dispatches_y, num_dispatches_z);
+        });
+    }
+    compute_scheduler.Record([&](vk::CommandBuffer cmdbuf) {
+        cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                               VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, release_barrier);
+    });
+    scheduler.Record([acquire_barrier](vk::CommandBuffer cmdbuf) {
+        cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                               VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, acquire_barrier);
+    });
+}
+
+BCnDecoderPass::BCnDecoderPass(const Device& device_, VKScheduler& scheduler_,
+                               VKDescriptorPool& descriptor_pool_,
+                               VKUpdateDescriptorQueue& update_descriptor_queue_)
+    : VKComputePass(device_, descriptor_pool_, BuildBCnDescriptorSetBindings(),
+                    BuildBCnPassDescriptorUpdateTemplateEntry(),
+                    BuildComputePushConstantRange(sizeof(BCnPushConstants)),
+                    VULKAN_BCN_DECODER_COMP_SPV),
+      scheduler{scheduler_}, update_descriptor_queue{update_descriptor_queue_} {}
+
+BCnDecoderPass::~BCnDecoderPass() = default;
+
+void BCnDecoderPass::Assemble(Image& image, const StagingBufferRef& map,
+                              std::span<const VideoCommon::SwizzleParameters> swizzles) {
+    using namespace VideoCommon::Accelerated;
+    const u32 bcn_format = BCnShaderFormat(image.info.format);
+    scheduler.RequestOutsideRenderPassOperationContext();
+
+    const VkPipeline vk_pipeline = *pipeline;
+    const VkImageAspectFlags aspect_mask = image.AspectMask();
+    const VkImage vk_image = image.Handle();
+    const bool is_initialized = image.ExchangeInitialization();
+    scheduler.BeginProfileScope("BCnDecoderPass");
+    scheduler.Record(
+        [vk_pipeline, vk_image, aspect_mask, is_initialized](vk::CommandBuffer cmdbuf) {
+            const VkImageMemoryBarrier image_barrier{
+                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                .pNext = nullptr,
+                .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+                .dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+                .oldLayout = is_initialized ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_UNDEFINED,
+                .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .image = vk_image,
+                .subresourceRange{
+                    .aspectMask = aspect_mask,
+                    .baseMipLevel = 0,
+                    .levelCount = VK_REMAINING_MIP_LEVELS,
+                    .baseArrayLayer = 0,
+                    .layerCount = VK_REMAINING_ARRAY_LAYERS,
+                },
+            };
+            cmdbuf.PipelineBarrier(is_initialized ? VK_PIPELINE_STAGE_ALL_COMMANDS_BIT : 0,
+                                   VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, image_barrier);
+            cmdbuf.BindPipeline(VK_PIPELINE_BIND_POINT_COMPUTE, vk_pipeline);
+        });
+    for (const VideoCommon::SwizzleParameters& swizzle : swizzles) {
+        const size_t input_offset = swizzle.buffer_offset + map.offset;
+        const u32 num_dispatches_x = Common::DivCeil(swizzle.num_tiles.width, 32U);
+        const u32 num_dispatches_y = Common::DivCeil(swizzle.num_tiles.height, 32U);
+        const u32 num_dispatches_z = image.info.resources.layers;
+
+        update_descriptor_queue.Acquire();
+        update_descriptor_queue.AddBuffer(map.buffer, input_offset,
+                                          image.guest_size_bytes - swizzle.buffer_offset);
+        update_descriptor_queue.AddImage(image.StorageImageView(swizzle.level));
+
+        const VkDescriptorSet set = CommitDescriptorSet(update_descriptor_queue);
+        const VkPipelineLayout vk_layout = *layout;
+
+        const auto params = MakeBlockLinearSwizzle2DParams(swizzle, image.info);
+        ASSERT(params.origin == (std::array<u32, 3>{0, 0, 0}));
+        ASSERT(params.destination == (std::array<s32, 3>{0, 0, 0}));
+        scheduler.Record([vk_layout, num_dispatches_x, num_dispatches_y, num_dispatches_z,
+                          bcn_format, params, set](vk::CommandBuffer cmdbuf) {
+            const BCnPushConstants uniforms{
+                .bcn_format = bcn_format,
+                .bytes_per_block_log2 = params.bytes_per_block_log2,
+                .layer_stride = params.layer_stride,
+                .block_size = params.block_size,
+                .x_shift = params.x_shift,
+                .block_height = params.block_height,
+                .block_height_mask = params.block_height_mask,
+            };
+            cmdbuf.BindDescriptorSets(VK_PIPELINE_BIND_POINT_COMPUTE, vk_layout, 0, set, {});
+            cmdbuf.PushConstants(vk_layout, VK_SHADER_STAGE_COMPUTE_BIT, uniforms);
+            cmdbuf.Dispatch(num_dispatches_x, num_dispatches_y, num_dispatches_z);
+        });
+    }
+    scheduler.Record([vk_image, aspect_mask](vk::CommandBuffer cmdbuf) {
+        const VkImageMemoryBarrier image_barrier{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .pNext = nullptr,
+            .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+            .oldLayout = VK_IMAGE_LAYOUT_GENERAL,
+            .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = vk_image,
+            .subresourceRange{
+                .aspectMask = aspect_mask,
+                .baseMipLevel = 0,
+                .levelCount = VK_REMAINING_MIP_LEVELS,
+                .baseArrayLayer = 0,
+                .layerCount = VK_REMAINING_ARRAY_LAYERS,
+            },
+        };
+        cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                               VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, image_barrier);
+    });
+    scheduler.EndProfileScope();
+}
+
 } // namespace Vulkan
@@ -20,6 +20,7 @@ struct SwizzleParameters;
 
 namespace Vulkan {
 
+class AsyncScheduler;
 class Device;
 class StagingBufferPool;
 class VKScheduler;
@@ -38,6 +39,9 @@ public:
 protected:
     VkDescriptorSet CommitDescriptorSet(VKUpdateDescriptorQueue& update_descriptor_queue);
 
+    /// Commits a descriptor set that is updated immediately, for passes recorded on async queues
+    VkDescriptorSet CommitImmediateDescriptorSet(VKUpdateDescriptorQueue& update_descriptor_queue);
+
     vk::DescriptorUpdateTemplateKHR descriptor_template;
     vk::PipelineLayout layout;
     vk::Pipeline pipeline;
@@ -99,6 +103,11 @@ public:
 private:
     void MakeDataBuffer();
 
+    /// Decodes an image the GPU hasn't used yet on the compute queue, without stalling
+    void AssembleAsync(AsyncScheduler& compute_scheduler, Image& image,
+                       const StagingBufferRef& map,
+                       std::span<const VideoCommon::SwizzleParameters> swizzles);
+
     const Device& device;
     VKScheduler& scheduler;
     StagingBufferPool& staging_buffer_pool;
@@ -109,4 +118,20 @@ private:
     MemoryCommit data_buffer_commit;
 };
 
+/// Decodes BC1 to BC5 images into A8B8G8R8 on hosts without native support for them
+class BCnDecoderPass final : public VKComputePass {
+public:
+    explicit BCnDecoderPass(const Device& device_, VKScheduler& scheduler_,
+                            VKDescriptorPool& descriptor_pool_,
+                            VKUpdateDescriptorQueue& update_descriptor_queue_);
+    ~BCnDecoderPass();
+
+    void Assemble(Image& image, const StagingBufferRef& map,
+                  std::span<const VideoCommon::SwizzleParameters> swizzles);
+
+private:
+    VKScheduler& scheduler;
+    VKUpdateDescriptorQueue& update_descriptor_queue;
+};
+
 } // namespace Vulkan
@@ -7,6 +7,7 @@
 #include "common/common_types.h"
 #include "video_core/renderer_vulkan/vk_descriptor_pool.h"
 #include "video_core/renderer_vulkan/vk_shader_decompiler.h"
+#include "video_core/renderer_vulkan/vk_update_descriptor.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
 
 namespace Vulkan {
@@ -20,7 +21,7 @@ public:
     explicit VKComputePipeline(const Device& device_, VKScheduler& scheduler_,
                                VKDescriptorPool& descriptor_pool_,
                                VKUpdateDescriptorQueue& update_descriptor_queue_,
-                               const SPIRVShader& shader_);
+                               const SPIRVShader& shader_, VkPipelineCache pipeline_cache);
     ~VKComputePipeline();
 
     VkDescriptorSet CommitDescriptorSet();
@@ -46,7 +47,7 @@ private:
 
     vk::ShaderModule CreateShaderModule(const std::vector<u32>& code) const;
 
-    vk::Pipeline CreatePipeline() const;
+    vk::Pipeline CreatePipeline(VkPipelineCache pipeline_cache) const;
 
     const Device& device;
     VKScheduler& scheduler;
@@ -54,6 +55,7 @@ private:
 
     vk::DescriptorSetLayout descriptor_set_layout;
     DescriptorAllocator descriptor_allocator;
+    DescriptorSetCache descriptor_set_cache;
     VKUpdateDescriptorQueue& update_descriptor_queue;
     vk::PipelineLayout layout;
     vk::DescriptorUpdateTemplateKHR descriptor_template;
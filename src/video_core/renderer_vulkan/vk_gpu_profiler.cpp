@@ -0,0 +1,134 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+
+#include "common/assert.h"
+#include "common/trace_recorder.h"
+#include "video_core/renderer_vulkan/vk_gpu_profiler.h"
+#include "video_core/renderer_vulkan/vk_master_semaphore.h"
+#include "video_core/vulkan_common/vulkan_device.h"
+#include "video_core/vulkan_common/vulkan_wrapper.h"
+
+namespace Vulkan {
+
+GPUProfiler::GPUProfiler(const Device& device_, MasterSemaphore& master_semaphore_)
+    : device{device_}, master_semaphore{master_semaphore_},
+      is_supported{device.IsTimestampQuerySupported()} {}
+
+GPUProfiler::~GPUProfiler() = default;
+
+bool GPUProfiler::IsEnabled() const noexcept {
+    return is_supported && Common::TraceRecorder::IsRecording();
+}
+
+GPUProfiler::Scope GPUProfiler::BeginScope(std::string label, std::string_view track, u64 tick) {
+    const std::size_t pool_index = AcquirePool();
+    const u32 query = next_query;
+    next_query += 2;
+    ++pools[pool_index].num_pending;
+    scopes.push_back(PendingScope{
+        .label = std::move(label),
+        .track = track,
+        .pool_index = pool_index,
+        .query = query,
+        .begin_tick = tick,
+        .end_tick = 0,
+    });
+    return Scope{
+        .id = first_scope_id + scopes.size() - 1,
+        .pool = *pools[pool_index].handle,
+        .query = query,
+    };
+}
+
+void GPUProfiler::EndScope(u64 id, u64 tick) {
+    ASSERT(id >= first_scope_id && id - first_scope_id < scopes.size());
+    scopes[id - first_scope_id].end_tick = tick;
+}
+
+void GPUProfiler::OnSubmit(u64 tick) {
+    if (scopes.empty() || scopes.back().begin_tick != tick) {
+        // No scope begins in this submission
+        return;
+    }
+    submit_times.emplace_back(tick, Common::TraceRecorder::Detail::Now());
+}
+
+void GPUProfiler::Resolve() {
+    const vk::Device& logical = device.GetLogical();
+    while (!scopes.empty()) {
+        PendingScope& scope = scopes.front();
+        if (scope.end_tick == 0 || !master_semaphore.IsFree(scope.end_tick)) {
+            // Scopes nest, the ones after an unfinished scope are resolved with it
+            break;
+        }
+        std::array<u64, 2> timestamps{};
+        const VkResult result =
+            logical.GetQueryResults(*pools[scope.pool_index].handle, scope.query, 2,
+                                    sizeof(timestamps), timestamps.data(), sizeof(u64),
+                                    VK_QUERY_RESULT_64_BIT);
+        if (result == VK_SUCCESS) {
+            Publish(scope, timestamps[0], timestamps[1]);
+        }
+        --pools[scope.pool_index].num_pending;
+        scopes.pop_front();
+        ++first_scope_id;
+    }
+    const u64 oldest_tick = scopes.empty() ? master_semaphore.CurrentTick()
+                                           : scopes.front().begin_tick;
+    while (!submit_times.empty() && submit_times.front().first < oldest_tick) {
+        submit_times.pop_front();
+    }
+}
+
+std::size_t GPUProfiler::AcquirePool() {
+    if (next_query + 2 <= QUERIES_PER_POOL) {
+        return current_pool;
+    }
+    const auto it = std::ranges::find_if(pools, [this](const Pool& pool) {
+        return pool.num_pending == 0 && &pool != &pools[current_pool];
+    });
+    if (it != pools.end()) {
+        current_pool = static_cast<std::size_t>(std::distance(pools.begin(), it));
+    } else {
+        current_pool = pools.size();
+        pools.push_back(Pool{
+            .handle = device.GetLogical().CreateQueryPool({
+                .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+                .pNext = nullptr,
+                .flags = 0,
+                .queryType = VK_QUERY_TYPE_TIMESTAMP,
+                .queryCount = QUERIES_PER_POOL,
+                .pipelineStatistics = 0,
+            }),
+        });
+    }
+    // Every query of the pool has been read back, or was never used
+    device.GetLogical().ResetQueryPoolEXT(*pools[current_pool].handle, 0, QUERIES_PER_POOL);
+    next_query = 0;
+    return current_pool;
+}
+
+void GPUProfiler::Publish(PendingScope& scope, u64 begin_timestamp, u64 end_timestamp) {
+    const double period = static_cast<double>(device.GetTimestampPeriod());
+    const s64 begin_ns = static_cast<s64>(static_cast<double>(begin_timestamp) * period);
+    const s64 end_ns = static_cast<s64>(static_cast<double>(end_timestamp) * period);
+    const auto submit_it = std::ranges::find(submit_times, scope.begin_tick,
+                                             &std::pair<u64, u64>::first);
+    if (submit_it != submit_times.end()) {
+        const s64 offset = static_cast<s64>(submit_it->second) - begin_ns;
+        clock_offset = std::max(clock_offset.value_or(offset), offset);
+    }
+    if (!clock_offset) {
+        return;
+    }
+    Common::TraceRecorder::RecordGpuScope(scope.track, std::move(scope.label),
+                                          static_cast<u64>(begin_ns + *clock_offset),
+                                          static_cast<u64>(std::max(end_ns, begin_ns) +
+                                                           *clock_offset));
+}
+
+} // namespace Vulkan
@@ -0,0 +1,97 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/vulkan_common/vulkan_wrapper.h"
+
+namespace Vulkan {
+
+class Device;
+class MasterSemaphore;
+
+/**
+ * Measures the GPU time of passes with timestamp queries while a trace is recorded, and stores
+ * them in the trace once the GPU has executed them. The GPU clock is placed on the host clock at
+ * the earliest time consistent with every submission seen so far, as no pass can begin before
+ * the submission holding it.
+ */
+class GPUProfiler {
+public:
+    /// Track of the trace holding render passes
+    static constexpr std::string_view RENDER_PASS_TRACK = "GPU render passes";
+    /// Track of the trace holding the other passes
+    static constexpr std::string_view PASS_TRACK = "GPU passes";
+
+    /// Queries of a scope, the timestamps are written at query and query + 1
+    struct Scope {
+        u64 id;
+        VkQueryPool pool;
+        u32 query;
+    };
+
+    explicit GPUProfiler(const Device& device, MasterSemaphore& master_semaphore);
+    ~GPUProfiler();
+
+    /// Returns true when passes recorded now are measured
+    [[nodiscard]] bool IsEnabled() const noexcept;
+
+    /// Allocates the queries of a scope that begins in the given tick
+    [[nodiscard]] Scope BeginScope(std::string label, std::string_view track, u64 tick);
+
+    /// Marks the end of a scope as recorded in the given tick
+    void EndScope(u64 id, u64 tick);
+
+    /// Stores the submission time of a tick, bounding the placement of its passes
+    void OnSubmit(u64 tick);
+
+    /// Stores the scopes the GPU has finished in the trace
+    void Resolve();
+
+private:
+    static constexpr u32 QUERIES_PER_POOL = 512;
+
+    struct Pool {
+        vk::QueryPool handle;
+        u32 num_pending = 0;
+    };
+
+    struct PendingScope {
+        std::string label;
+        std::string_view track;
+        std::size_t pool_index;
+        u32 query;
+        u64 begin_tick;
+        u64 end_tick;
+    };
+
+    /// Returns a pool with room for two more queries
+    std::size_t AcquirePool();
+
+    void Publish(PendingScope& scope, u64 begin_timestamp, u64 end_timestamp);
+
+    const Device& device;
+    MasterSemaphore& master_semaphore;
+    const bool is_supported;
+
+    std::vector<Pool> pools;
+    std::size_t current_pool = 0;
+    u32 next_query = QUERIES_PER_POOL;
+
+    std::deque<PendingScope> scopes;
+    u64 first_scope_id = 1;
+
+    std::deque<std::pair<u64, u64>> submit_times;
+    std::optional<s64> clock_offset;
+};
+
+} // namespace Vulkan
@@ -15,6 +15,7 @@
 #include "video_core/renderer_vulkan/vk_graphics_pipeline.h"
 #include "video_core/renderer_vulkan/vk_pipeline_cache.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
+#include "video_core/renderer_vulkan/vk_texture_cache.h"
 #include "video_core/renderer_vulkan/vk_update_descriptor.h"
 #include "video_core/vulkan_common/vulkan_device.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
@@ -99,14 +100,17 @@ VKGraphicsPipeline::VKGraphicsPipeline(const Device& device_, VKScheduler& sched
                                        VKUpdateDescriptorQueue& update_descriptor_queue_,
                                        const GraphicsPipelineCacheKey& key,
                                        vk::Span<VkDescriptorSetLayoutBinding> bindings,
-                                       const SPIRVProgram& program, u32 num_color_buffers)
+                                       const SPIRVProgram& program,
+                                       const RenderPassKey& renderpass_key,
+                                       VkPipelineCache pipeline_cache, VkPipeline base_pipeline)
     : device{device_}, scheduler{scheduler_}, cache_key{key}, hash{cache_key.Hash()},
       descriptor_set_layout{CreateDescriptorSetLayout(bindings)},
       descriptor_allocator{descriptor_pool_, *descriptor_set_layout},
       update_descriptor_queue{update_descriptor_queue_}, layout{CreatePipelineLayout()},
       descriptor_template{CreateDescriptorUpdateTemplate(program)},
       modules(CreateShaderModules(program)),
-      pipeline(CreatePipeline(program, cache_key.renderpass, num_color_buffers)) {}
+      pipeline(CreatePipeline(program, cache_key.renderpass, renderpass_key, pipeline_cache,
+                              base_pipeline)) {}
 
 VKGraphicsPipeline::~VKGraphicsPipeline() = default;
 
@@ -114,8 +118,14 @@ VkDescriptorSet VKGraphicsPipeline::CommitDescriptorSet() {
     if (!descriptor_template) {
         return {};
     }
+    const auto update_data = update_descriptor_queue.UpdateData();
+    if (const VkDescriptorSet cached = descriptor_set_cache.Find(update_data,
+                                                                 scheduler.CurrentTick())) {
+        return cached;
+    }
     const VkDescriptorSet set = descriptor_allocator.Commit();
     update_descriptor_queue.Send(*descriptor_template, set);
+    descriptor_set_cache.Add(update_data, set);
     return set;
 }
 
@@ -203,8 +213,13 @@ std::vector<vk::ShaderModule> VKGraphicsPipeline::CreateShaderModules(
 
 vk::Pipeline VKGraphicsPipeline::CreatePipeline(const SPIRVProgram& program,
                                                 VkRenderPass renderpass,
-                                                u32 num_color_buffers) const {
+                                                const RenderPassKey& renderpass_key,
+                                                VkPipelineCache pipeline_cache,
+                                                VkPipeline base_pipeline) const {
     const auto& state = cache_key.fixed_state;
+    const u32 num_color_buffers = static_cast<u32>(std::ranges::count_if(
+        renderpass_key.color_formats,
+        [](PixelFormat format) { return format != PixelFormat::Invalid; }));
     const auto& viewport_swizzles = state.viewport_swizzles;
 
     FixedPipelineState::DynamicState dynamic;
@@ -458,10 +473,17 @@ vk::Pipeline VKGraphicsPipeline::CreatePipeline(const SPIRVProgram& program,
             stage_ci.pNext = &subgroup_size_ci;
         }
     }
-    return device.GetLogical().CreateGraphicsPipeline(VkGraphicsPipelineCreateInfo{
+    // Every pipeline can become the parent of a variant that only differs in fixed state, giving
+    // the driver a chance to reuse the compiled shader stages of the parent
+    VkPipelineCreateFlags flags = VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT;
+    if (base_pipeline) {
+        flags |= VK_PIPELINE_CREATE_DERIVATIVE_BIT;
+    }
+    const RenderingFormats rendering_formats(device, renderpass_key);
+    const VkGraphicsPipelineCreateInfo ci{
         .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = 0,
+        .pNext = rendering_formats.CreateInfo(),
+        .flags = flags,
         .stageCount = static_cast<u32>(shader_stages.size()),
         .pStages = shader_stages.data(),
         .pVertexInputState = &vertex_input_ci,
@@ -474,11 +496,12 @@ vk::Pipeline VKGraphicsPipeline::CreatePipeline(const SPIRVProgram& program,
         .pColorBlendState = &color_blend_ci,
         .pDynamicState = &dynamic_state_ci,
         .layout = *layout,
-        .renderPass = renderpass,
+        .renderPass = rendering_formats.PipelineRenderPass(renderpass),
         .subpass = 0,
-        .basePipelineHandle = nullptr,
-        .basePipelineIndex = 0,
-    });
+        .basePipelineHandle = base_pipeline,
+        .basePipelineIndex = -1,
+    };
+    return device.GetLogical().CreateGraphicsPipeline(ci, pipeline_cache);
 }
 
 } // namespace Vulkan
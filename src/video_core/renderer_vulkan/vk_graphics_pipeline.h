@@ -13,6 +13,7 @@
 #include "video_core/renderer_vulkan/fixed_pipeline_state.h"
 #include "video_core/renderer_vulkan/vk_descriptor_pool.h"
 #include "video_core/renderer_vulkan/vk_shader_decompiler.h"
+#include "video_core/renderer_vulkan/vk_update_descriptor.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
 
 namespace Vulkan {
@@ -44,6 +45,7 @@ class Device;
 class VKDescriptorPool;
 class VKScheduler;
 class VKUpdateDescriptorQueue;
+struct RenderPassKey;
 
 using SPIRVProgram = std::array<std::optional<SPIRVShader>, Maxwell::MaxShaderStage>;
 
@@ -54,7 +56,9 @@ public:
                                 VKUpdateDescriptorQueue& update_descriptor_queue_,
                                 const GraphicsPipelineCacheKey& key,
                                 vk::Span<VkDescriptorSetLayoutBinding> bindings,
-                                const SPIRVProgram& program, u32 num_color_buffers);
+                                const SPIRVProgram& program,
+                                const RenderPassKey& renderpass_key,
+                                VkPipelineCache pipeline_cache, VkPipeline base_pipeline);
     ~VKGraphicsPipeline();
 
     VkDescriptorSet CommitDescriptorSet();
@@ -71,6 +75,12 @@ public:
         return cache_key;
     }
 
+    /// Rebinds the pipeline to a key describing the same state, used by pipelines loaded from disk
+    void SetCacheKey(const GraphicsPipelineCacheKey& key) {
+        cache_key = key;
+        hash = cache_key.Hash();
+    }
+
 private:
     vk::DescriptorSetLayout CreateDescriptorSetLayout(
         vk::Span<VkDescriptorSetLayoutBinding> bindings) const;
@@ -83,15 +93,17 @@ private:
     std::vector<vk::ShaderModule> CreateShaderModules(const SPIRVProgram& program) const;
 
     vk::Pipeline CreatePipeline(const SPIRVProgram& program, VkRenderPass renderpass,
-                                u32 num_color_buffers) const;
+                                const RenderPassKey& renderpass_key,
+                                VkPipelineCache pipeline_cache, VkPipeline base_pipeline) const;
 
     const Device& device;
     VKScheduler& scheduler;
-    const GraphicsPipelineCacheKey cache_key;
-    const u64 hash;
+    GraphicsPipelineCacheKey cache_key;
+    u64 hash;
 
     vk::DescriptorSetLayout descriptor_set_layout;
     DescriptorAllocator descriptor_allocator;
+    DescriptorSetCache descriptor_set_cache;
     VKUpdateDescriptorQueue& update_descriptor_queue;
     vk::PipelineLayout layout;
     vk::DescriptorUpdateTemplateKHR descriptor_template;
@@ -4,7 +4,7 @@
 
 #include <thread>
 
-#include "common/settings.h"
+#include "common/thread.h"
 #include "video_core/renderer_vulkan/vk_master_semaphore.h"
 #include "video_core/vulkan_common/vulkan_device.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
@@ -25,22 +25,24 @@ MasterSemaphore::MasterSemaphore(const Device& device) {
     };
     semaphore = device.GetLogical().CreateSemaphore(semaphore_ci);
 
-    if (!Settings::values.renderer_debug) {
-        return;
-    }
-    // Validation layers have a bug where they fail to track resource usage when using timeline
-    // semaphores and synchronizing with GetSemaphoreCounterValueKHR. To workaround this issue, have
-    // a separate thread waiting for each timeline semaphore value.
-    debug_thread = std::jthread([this](std::stop_token stop_token) {
-        u64 counter = 0;
-        while (!stop_token.stop_requested()) {
-            if (semaphore.Wait(counter, 10'000'000)) {
-                ++counter;
-            }
-        }
-    });
+    wait_thread = std::jthread([this](std::stop_token stop_token) { WaitThread(stop_token); });
 }
 
 MasterSemaphore::~MasterSemaphore() = default;
 
+void MasterSemaphore::WaitThread(std::stop_token stop_token) {
+    Common::SetCurrentThreadName("yuzu:VulkanSemaphoreWait");
+
+    // Waiting for each value in order also works around validation layers failing to track
+    // resource usage when synchronizing with GetSemaphoreCounterValueKHR.
+    // Ticks that were already hit return immediately, a timeout lets stop requests through.
+    u64 counter = 1;
+    while (!stop_token.stop_requested()) {
+        if (semaphore.Wait(counter, 10'000'000)) {
+            UpdateGpuTick(counter);
+            ++counter;
+        }
+    }
+}
+
 } // namespace Vulkan
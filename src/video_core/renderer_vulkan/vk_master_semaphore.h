@@ -5,6 +5,7 @@
 #pragma once
 
 #include <atomic>
+#include <stop_token>
 #include <thread>
 
 #include "common/common_types.h"
@@ -24,7 +25,7 @@ public:
         return current_tick.load(std::memory_order_relaxed);
     }
 
-    /// Returns the last known GPU tick.
+    /// Returns the last known GPU tick, kept up to date by the wait thread.
     [[nodiscard]] u64 KnownGpuTick() const noexcept {
         return gpu_tick.load(std::memory_order_relaxed);
     }
@@ -46,7 +47,7 @@ public:
 
     /// Refresh the known GPU tick
     void Refresh() {
-        gpu_tick.store(semaphore.GetCounter(), std::memory_order_relaxed);
+        UpdateGpuTick(semaphore.GetCounter());
     }
 
     /// Waits for a tick to be hit on the GPU
@@ -65,10 +66,21 @@ public:
     }
 
 private:
+    /// Blocks on each tick in order, publishing it as soon as the GPU hits it.
+    void WaitThread(std::stop_token stop_token);
+
+    /// Raises the known GPU tick, it never goes backwards when racing with another thread.
+    void UpdateGpuTick(u64 tick) noexcept {
+        u64 known = gpu_tick.load(std::memory_order_relaxed);
+        while (known < tick &&
+               !gpu_tick.compare_exchange_weak(known, tick, std::memory_order_relaxed)) {
+        }
+    }
+
     vk::Semaphore semaphore;          ///< Timeline semaphore.
     std::atomic<u64> gpu_tick{0};     ///< Current known GPU tick.
     std::atomic<u64> current_tick{1}; ///< Current logical tick.
-    std::jthread debug_thread;        ///< Debug thread to workaround validation layer bugs.
+    std::jthread wait_thread;         ///< Thread waiting for the GPU to hit each tick.
 };
 
 } // namespace Vulkan
@@ -4,7 +4,10 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <memory>
+#include <optional>
+#include <tuple>
 #include <vector>
 
 #include "common/bit_cast.h"
@@ -12,6 +15,7 @@
 #include "common/microprofile.h"
 #include "core/core.h"
 #include "core/memory.h"
+#include "core/perf_stats.h"
 #include "video_core/engines/kepler_compute.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/memory_manager.h"
@@ -23,9 +27,11 @@
 #include "video_core/renderer_vulkan/vk_pipeline_cache.h"
 #include "video_core/renderer_vulkan/vk_rasterizer.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
+#include "video_core/renderer_vulkan/vk_texture_cache.h"
 #include "video_core/renderer_vulkan/vk_update_descriptor.h"
 #include "video_core/shader/compiler_settings.h"
 #include "video_core/shader/memory_util.h"
+#include "video_core/shader/prewarm_scheduler.h"
 #include "video_core/shader_cache.h"
 #include "video_core/shader_notify.h"
 #include "video_core/vulkan_common/vulkan_device.h"
@@ -38,8 +44,11 @@ MICROPROFILE_DECLARE(Vulkan_PipelineCache);
 using Tegra::Engines::ShaderType;
 using VideoCommon::Shader::GetShaderAddress;
 using VideoCommon::Shader::GetShaderCode;
+using VideoCommon::Shader::GetUniqueIdentifier;
 using VideoCommon::Shader::KERNEL_MAIN_OFFSET;
 using VideoCommon::Shader::ProgramCode;
+using VideoCommon::Shader::Registry;
+using VideoCommon::Shader::ShaderDiskCacheEntry;
 using VideoCommon::Shader::STAGE_MAIN_OFFSET;
 
 namespace {
@@ -102,6 +111,12 @@ void AddBindings(std::vector<VkDescriptorSetLayoutBinding>& bindings, u32& bindi
     }
 }
 
+Registry MakeRegistry(const ShaderDiskCacheEntry& entry) {
+    Registry registry(entry.type, entry.GetRegistryInfo());
+    entry.FillRegistry(registry);
+    return registry;
+}
+
 u32 FillDescriptorLayout(const ShaderEntries& entries,
                          std::vector<VkDescriptorSetLayoutBinding>& bindings,
                          Maxwell::ShaderProgram program_type, u32 base_binding) {
@@ -139,25 +154,191 @@ bool ComputePipelineCacheKey::operator==(const ComputePipelineCacheKey& rhs) con
 }
 
 Shader::Shader(Tegra::Engines::ConstBufferEngineInterface& engine_, ShaderType stage_,
-               GPUVAddr gpu_addr_, VAddr cpu_addr_, ProgramCode program_code_, u32 main_offset_)
-    : gpu_addr(gpu_addr_), program_code(std::move(program_code_)), registry(stage_, engine_),
-      shader_ir(program_code, main_offset_, compiler_settings, registry),
-      entries(GenerateShaderEntries(shader_ir)) {}
+               GPUVAddr gpu_addr_, VAddr cpu_addr_, ProgramCode program_code_, u32 main_offset_,
+               VideoCommon::Shader::ShaderPredecoder* predecoder)
+    : gpu_addr(gpu_addr_), stage(stage_), program_code(std::move(program_code_)),
+      main_offset(main_offset_),
+      unique_identifier(GetUniqueIdentifier(stage_, false, program_code)),
+      registry(stage_, engine_) {
+    if (predecoder) {
+        predecoded = predecoder->Take(unique_identifier, registry);
+    }
+    if (!predecoded) {
+        shader_ir.emplace(program_code, main_offset_, compiler_settings, registry);
+    }
+    entries = GenerateShaderEntries(GetIR());
+}
+
+Shader::Shader(const ShaderDiskCacheEntry& entry, u32 main_offset_)
+    : stage(entry.type), program_code(entry.code), main_offset(main_offset_),
+      unique_identifier(entry.unique_identifier), registry(MakeRegistry(entry)),
+      shader_ir(std::in_place, program_code, main_offset_, compiler_settings, registry),
+      entries(GenerateShaderEntries(*shader_ir)) {}
 
 Shader::~Shader() = default;
 
+void Shader::DecodeIR() {
+    if (HasIR()) {
+        return;
+    }
+    ASSERT_MSG(!program_code.empty(), "Decoding a compacted shader");
+    shader_ir.emplace(program_code, main_offset, compiler_settings, registry);
+}
+
+void Shader::ReleaseIR() {
+    predecoded.reset();
+    shader_ir.reset();
+}
+
+void Shader::Compact() {
+    ReleaseIR();
+    program_code = ProgramCode{};
+}
+
+ShaderDiskCacheEntry Shader::MakeDiskCacheEntry() const {
+    ShaderDiskCacheEntry entry;
+    entry.type = stage;
+    entry.code = program_code;
+    entry.unique_identifier = unique_identifier;
+    entry.CopyRegistry(registry);
+    return entry;
+}
+
 VKPipelineCache::VKPipelineCache(RasterizerVulkan& rasterizer_, Tegra::GPU& gpu_,
                                  Tegra::Engines::Maxwell3D& maxwell3d_,
                                  Tegra::Engines::KeplerCompute& kepler_compute_,
                                  Tegra::MemoryManager& gpu_memory_, const Device& device_,
                                  VKScheduler& scheduler_, VKDescriptorPool& descriptor_pool_,
-                                 VKUpdateDescriptorQueue& update_descriptor_queue_)
+                                 VKUpdateDescriptorQueue& update_descriptor_queue_,
+                                 TextureCacheRuntime& texture_cache_runtime_)
     : VideoCommon::ShaderCache<Shader>{rasterizer_}, gpu{gpu_}, maxwell3d{maxwell3d_},
       kepler_compute{kepler_compute_}, gpu_memory{gpu_memory_}, device{device_},
-      scheduler{scheduler_}, descriptor_pool{descriptor_pool_}, update_descriptor_queue{
-                                                                    update_descriptor_queue_} {}
+      scheduler{scheduler_}, descriptor_pool{descriptor_pool_},
+      update_descriptor_queue{update_descriptor_queue_},
+      texture_cache_runtime{texture_cache_runtime_}, disk_cache{device_},
+      spirv_optimizer{disk_cache} {}
+
+VKPipelineCache::~VKPipelineCache() {
+    if (!vk_pipeline_cache) {
+        return;
+    }
+    try {
+        disk_cache.SavePipelineCacheData(vk_pipeline_cache.GetData());
+    } catch (const vk::Exception& exception) {
+        LOG_ERROR(Render_Vulkan, "Failed to get pipeline cache data: {}", exception.what());
+    }
+}
+
+void VKPipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
+                                        const VideoCore::DiskResourceLoadCallback& callback) {
+    disk_cache.BindTitleID(title_id);
+    const std::optional transferable = disk_cache.LoadTransferable();
+    spirv_optimizer.LoadDiskResources();
+
+    const std::vector<u8> pipeline_cache_data = disk_cache.LoadPipelineCacheData();
+    vk_pipeline_cache = device.GetLogical().CreatePipelineCache({
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .initialDataSize = pipeline_cache_data.size(),
+        .pInitialData = pipeline_cache_data.data(),
+    });
+
+    if (!transferable) {
+        return;
+    }
+    const auto& shader_entries = transferable->shaders;
+    const auto& graphics_keys = transferable->graphics_pipelines;
+    const auto& compute_keys = transferable->compute_pipelines;
+    LOG_INFO(Render_Vulkan, "Total Pipeline Count: {} graphics, {} compute", graphics_keys.size(),
+             compute_keys.size());
+
+    const std::size_t total = shader_entries.size() + graphics_keys.size() + compute_keys.size();
+    if (callback) {
+        callback(VideoCore::LoadCallbackStage::Build, 0, total);
+    }
+    std::size_t built = 0; // It doesn't have be atomic since it's used behind a mutex
+    const auto report_progress = [&](std::size_t) {
+        if (callback) {
+            callback(VideoCore::LoadCallbackStage::Build, ++built, total);
+        }
+    };
+
+    VideoCommon::Shader::PrewarmScheduler scheduler;
+
+    // Decode all shaders before building pipelines, as these are shared between pipelines
+    std::vector<std::unique_ptr<Shader>> shaders(shader_entries.size());
+    scheduler.Run(
+        shader_entries.size(), {}, stop_loading,
+        [&](std::size_t index) {
+            const ShaderDiskCacheEntry& entry = shader_entries[index];
+            const bool is_compute = entry.type == ShaderType::Compute;
+            const u32 main_offset = is_compute ? KERNEL_MAIN_OFFSET : STAGE_MAIN_OFFSET;
+            shaders[index] = std::make_unique<Shader>(entry, main_offset);
+        },
+        report_progress);
+    if (stop_loading.stop_requested()) {
+        return;
+    }
+    for (auto& shader : shaders) {
+        const u64 uid = shader->GetUniqueIdentifier();
+        disk_shaders.emplace(uid, std::move(shader));
+    }
+
+    // Render passes are created here because the texture cache runtime is not thread safe
+    std::vector<VkRenderPass> renderpasses(graphics_keys.size());
+    for (std::size_t i = 0; i < graphics_keys.size(); ++i) {
+        renderpasses[i] = texture_cache_runtime.GetRenderPass(graphics_keys[i].renderpass);
+    }
+
+    // Graphics and compute pipelines are built in the same pass, graphics indices go first
+    std::vector<std::unique_ptr<VKGraphicsPipeline>> graphics_pipelines(graphics_keys.size());
+    std::vector<std::unique_ptr<VKComputePipeline>> compute_pipelines(compute_keys.size());
+    scheduler.Run(
+        graphics_keys.size() + compute_keys.size(), {}, stop_loading,
+        [&](std::size_t index) {
+            if (index < graphics_keys.size()) {
+                graphics_pipelines[index] =
+                    CreateDiskGraphicsPipeline(graphics_keys[index], renderpasses[index]);
+            } else {
+                index -= graphics_keys.size();
+                compute_pipelines[index] = CreateDiskComputePipeline(compute_keys[index]);
+            }
+        },
+        report_progress);
+    if (stop_loading.stop_requested()) {
+        return;
+    }
+    for (std::size_t i = 0; i < graphics_keys.size(); ++i) {
+        if (graphics_pipelines[i]) {
+            disk_graphics_cache.emplace(graphics_keys[i], std::move(graphics_pipelines[i]));
+        }
+    }
+    for (std::size_t i = 0; i < compute_keys.size(); ++i) {
+        if (compute_pipelines[i]) {
+            disk_compute_cache.emplace(compute_keys[i], std::move(compute_pipelines[i]));
+        }
+    }
+    // Disk shaders are only compared against guest shaders from now on
+    for (auto& [uid, shader] : disk_shaders) {
+        shader->Compact();
+    }
+}
 
-VKPipelineCache::~VKPipelineCache() = default;
+void VKPipelineCache::PrepareShader(Maxwell::ShaderProgram program) {
+    const GPUVAddr gpu_addr{GetShaderAddress(maxwell3d, program)};
+    const std::optional<VAddr> cpu_addr = gpu_memory.GpuToCpuAddress(gpu_addr);
+    if (!cpu_addr || TryGet(*cpu_addr)) {
+        return;
+    }
+    const auto index = static_cast<std::size_t>(program);
+    const auto stage = static_cast<ShaderType>(index == 0 ? 0 : index - 1);
+    const u8* const host_ptr{gpu_memory.GetPointer(gpu_addr)};
+    ProgramCode code = GetShaderCode(gpu_memory, gpu_addr, host_ptr, false);
+    const u64 unique_identifier = GetUniqueIdentifier(stage, false, code);
+    predecoder.Queue(stage, unique_identifier, std::move(code), STAGE_MAIN_OFFSET,
+                     compiler_settings, maxwell3d);
+}
 
 std::array<Shader*, Maxwell::MaxShaderProgram> VKPipelineCache::GetShaders() {
     std::array<Shader*, Maxwell::MaxShaderProgram> shaders{};
@@ -185,10 +366,11 @@ std::array<Shader*, Maxwell::MaxShaderProgram> VKPipelineCache::GetShaders() {
             const std::size_t size_in_bytes = code.size() * sizeof(u64);
 
             auto shader = std::make_unique<Shader>(maxwell3d, stage, gpu_addr, *cpu_addr,
-                                                   std::move(code), stage_offset);
+                                                   std::move(code), stage_offset, &predecoder);
             result = shader.get();
 
             if (cpu_addr) {
+                decoded_shaders.push_back(result);
                 Register(std::move(shader), *cpu_addr, size_in_bytes);
             } else {
                 null_shader = std::move(shader);
@@ -200,7 +382,7 @@ std::array<Shader*, Maxwell::MaxShaderProgram> VKPipelineCache::GetShaders() {
 }
 
 VKGraphicsPipeline* VKPipelineCache::GetGraphicsPipeline(
-    const GraphicsPipelineCacheKey& key, u32 num_color_buffers,
+    const GraphicsPipelineCacheKey& key, const RenderPassKey& renderpass_key,
     VideoCommon::Shader::AsyncShaders& async_shaders) {
     MICROPROFILE_SCOPE(Vulkan_PipelineCache);
 
@@ -213,12 +395,22 @@ VKGraphicsPipeline* VKPipelineCache::GetGraphicsPipeline(
         std::unique_lock lock{pipeline_cache};
         const auto [pair, is_cache_miss] = graphics_cache.try_emplace(key);
         if (is_cache_miss) {
-            gpu.ShaderNotify().MarkSharderBuilding();
-            LOG_INFO(Render_Vulkan, "Compile 0x{:016X}", key.Hash());
-            const auto [program, bindings] = DecompileShaders(key.fixed_state);
-            async_shaders.QueueVulkanShader(this, device, scheduler, descriptor_pool,
-                                            update_descriptor_queue, bindings, program, key,
-                                            num_color_buffers);
+            const std::optional disk_key = MakeGraphicsDiskKey(key);
+            if (disk_key) {
+                pair->second = TakeDiskGraphicsPipeline(*disk_key);
+            }
+            if (pair->second) {
+                pair->second->SetCacheKey(key);
+            } else {
+                gpu.ShaderNotify().MarkSharderBuilding();
+                LOG_INFO(Render_Vulkan, "Compile 0x{:016X}", key.Hash());
+                DecodeShaders(last_shaders);
+                const auto [program, bindings] = DecompileShaders(key.fixed_state, last_shaders);
+                SaveDiskGraphicsPipeline(disk_key);
+                async_shaders.QueueVulkanShader(this, device, scheduler, descriptor_pool,
+                                                update_descriptor_queue, bindings, program, key,
+                                                renderpass_key);
+            }
         }
         last_graphics_pipeline = pair->second.get();
         return last_graphics_pipeline;
@@ -227,27 +419,58 @@ VKGraphicsPipeline* VKPipelineCache::GetGraphicsPipeline(
     const auto [pair, is_cache_miss] = graphics_cache.try_emplace(key);
     auto& entry = pair->second;
     if (is_cache_miss) {
-        gpu.ShaderNotify().MarkSharderBuilding();
-        LOG_INFO(Render_Vulkan, "Compile 0x{:016X}", key.Hash());
-        const auto [program, bindings] = DecompileShaders(key.fixed_state);
-        entry = std::make_unique<VKGraphicsPipeline>(device, scheduler, descriptor_pool,
-                                                     update_descriptor_queue, key, bindings,
-                                                     program, num_color_buffers);
-        gpu.ShaderNotify().MarkShaderComplete();
+        const std::optional disk_key = MakeGraphicsDiskKey(key);
+        if (disk_key) {
+            entry = TakeDiskGraphicsPipeline(*disk_key);
+        }
+        if (entry) {
+            entry->SetCacheKey(key);
+        } else {
+            const Core::ScopedStall stall{maxwell3d.System().GetPerfStats(),
+                                          Core::StallCause::ShaderCompile};
+            gpu.ShaderNotify().MarkSharderBuilding();
+            LOG_INFO(Render_Vulkan, "Compile 0x{:016X}", key.Hash());
+            DecodeShaders(last_shaders);
+            auto [program, bindings] = DecompileShaders(key.fixed_state, last_shaders);
+            OptimizeProgram(program);
+            entry = std::make_unique<VKGraphicsPipeline>(
+                device, scheduler, descriptor_pool, update_descriptor_queue, key, bindings,
+                program, renderpass_key, *vk_pipeline_cache, FindBasePipeline(key));
+            SaveDiskGraphicsPipeline(disk_key);
+            gpu.ShaderNotify().MarkShaderComplete();
+        }
     }
     last_graphics_pipeline = entry.get();
     return last_graphics_pipeline;
 }
 
+VkPipeline VKPipelineCache::FindBasePipeline(const GraphicsPipelineCacheKey& key) const {
+    // Games usually go through several fixed states with the same program in a row, so the last
+    // bound pipeline is a good candidate to derive from
+    if (!last_graphics_pipeline) {
+        return nullptr;
+    }
+    const GraphicsPipelineCacheKey& base_key = last_graphics_pipeline->GetCacheKey();
+    if (base_key.shaders != key.shaders) {
+        return nullptr;
+    }
+    return last_graphics_pipeline->GetHandle();
+}
+
 VKComputePipeline& VKPipelineCache::GetComputePipeline(const ComputePipelineCacheKey& key) {
     MICROPROFILE_SCOPE(Vulkan_PipelineCache);
 
+    // Kernels are usually dispatched many times in a row
+    if (last_compute_pipeline && last_compute_key == key) {
+        return *last_compute_pipeline;
+    }
     const auto [pair, is_cache_miss] = compute_cache.try_emplace(key);
     auto& entry = pair->second;
     if (!is_cache_miss) {
+        last_compute_key = key;
+        last_compute_pipeline = entry.get();
         return *entry;
     }
-    LOG_INFO(Render_Vulkan, "Compile 0x{:016X}", key.Hash());
 
     const GPUVAddr gpu_addr = key.shader;
 
@@ -267,36 +490,70 @@ VKComputePipeline& VKPipelineCache::GetComputePipeline(const ComputePipelineCach
         shader = shader_info.get();
 
         if (cpu_addr) {
+            decoded_shaders.push_back(shader);
             Register(std::move(shader_info), *cpu_addr, size_in_bytes);
         } else {
             null_kernel = std::move(shader_info);
         }
     }
 
-    const Specialization specialization{
-        .base_binding = 0,
-        .workgroup_size = key.workgroup_size,
+    const ComputePipelineDiskKey disk_key{
+        .unique_identifier = shader->GetUniqueIdentifier(),
         .shared_memory_size = key.shared_memory_size,
-        .point_size = std::nullopt,
-        .enabled_attributes = {},
-        .attribute_types = {},
-        .ndc_minus_one_to_one = false,
+        .workgroup_size = key.workgroup_size,
     };
-    const SPIRVShader spirv_shader{Decompile(device, shader->GetIR(), ShaderType::Compute,
-                                             shader->GetRegistry(), specialization),
-                                   shader->GetEntries()};
-    entry = std::make_unique<VKComputePipeline>(device, scheduler, descriptor_pool,
-                                                update_descriptor_queue, spirv_shader);
+    const auto disk_it = disk_compute_cache.find(disk_key);
+    if (disk_it != disk_compute_cache.end() && HasConsistentDiskShaders({shader})) {
+        entry = std::move(disk_it->second);
+        disk_compute_cache.erase(disk_it);
+        last_compute_key = key;
+        last_compute_pipeline = entry.get();
+        return *entry;
+    }
+    LOG_INFO(Render_Vulkan, "Compile 0x{:016X}", key.Hash());
+
+    const Core::ScopedStall stall{maxwell3d.System().GetPerfStats(),
+                                  Core::StallCause::ShaderCompile};
+    DecodeShaders(std::span(&shader, 1));
+    entry = CreateComputePipeline(*shader, key.shared_memory_size, key.workgroup_size);
+    disk_cache.SaveShader(shader->MakeDiskCacheEntry());
+    disk_cache.SaveComputePipeline(disk_key);
+    last_compute_key = key;
+    last_compute_pipeline = entry.get();
     return *entry;
 }
 
+VKGraphicsPipeline* VKPipelineCache::WaitForGraphicsPipeline(const GraphicsPipelineCacheKey& key,
+                                                             std::chrono::milliseconds timeout) {
+    MICROPROFILE_SCOPE(Vulkan_PipelineCache);
+    const Core::ScopedStall stall{maxwell3d.System().GetPerfStats(),
+                                  Core::StallCause::ShaderCompile};
+
+    std::unique_lock lock{pipeline_cache};
+    VKGraphicsPipeline* pipeline = nullptr;
+    pipeline_emplaced.wait_for(lock, timeout, [&] {
+        const auto it = graphics_cache.find(key);
+        pipeline = it != graphics_cache.end() ? it->second.get() : nullptr;
+        return pipeline != nullptr;
+    });
+    if (pipeline && key == last_graphics_key) {
+        last_graphics_pipeline = pipeline;
+    }
+    return pipeline;
+}
+
 void VKPipelineCache::EmplacePipeline(std::unique_ptr<VKGraphicsPipeline> pipeline) {
     gpu.ShaderNotify().MarkShaderComplete();
-    std::unique_lock lock{pipeline_cache};
-    graphics_cache.at(pipeline->GetCacheKey()) = std::move(pipeline);
+    {
+        std::unique_lock lock{pipeline_cache};
+        graphics_cache.at(pipeline->GetCacheKey()) = std::move(pipeline);
+    }
+    pipeline_emplaced.notify_all();
 }
 
 void VKPipelineCache::OnShaderRemoval(Shader* shader) {
+    std::erase(decoded_shaders, shader);
+
     bool finished = false;
     const auto Finish = [&] {
         // TODO(Rodrigo): Instead of finishing here, wait for the fences that use this pipeline and
@@ -317,6 +574,9 @@ void VKPipelineCache::OnShaderRemoval(Shader* shader) {
             continue;
         }
         Finish();
+        if (it->second.get() == last_graphics_pipeline) {
+            last_graphics_pipeline = nullptr;
+        }
         it = graphics_cache.erase(it);
     }
     for (auto it = compute_cache.begin(); it != compute_cache.end();) {
@@ -326,12 +586,16 @@ void VKPipelineCache::OnShaderRemoval(Shader* shader) {
             continue;
         }
         Finish();
+        if (it->second.get() == last_compute_pipeline) {
+            last_compute_pipeline = nullptr;
+        }
         it = compute_cache.erase(it);
     }
 }
 
 std::pair<SPIRVProgram, std::vector<VkDescriptorSetLayoutBinding>>
-VKPipelineCache::DecompileShaders(const FixedPipelineState& fixed_state) {
+VKPipelineCache::DecompileShaders(const FixedPipelineState& fixed_state,
+                                  const ShaderArray& shaders) const {
     Specialization specialization;
     if (fixed_state.topology == Maxwell::PrimitiveTopology::Points) {
         float point_size;
@@ -357,14 +621,11 @@ VKPipelineCache::DecompileShaders(const FixedPipelineState& fixed_state) {
 
     for (std::size_t index = 1; index < Maxwell::MaxShaderProgram; ++index) {
         const auto program_enum = static_cast<Maxwell::ShaderProgram>(index);
+        const Shader* const shader = shaders[index];
         // Skip stages that are not enabled
-        if (!maxwell3d.regs.IsShaderConfigEnabled(index)) {
+        if (!shader) {
             continue;
         }
-        const GPUVAddr gpu_addr = GetShaderAddress(maxwell3d, program_enum);
-        const std::optional<VAddr> cpu_addr = gpu_memory.GpuToCpuAddress(gpu_addr);
-        Shader* const shader = cpu_addr ? TryGet(*cpu_addr) : null_shader.get();
-
         const std::size_t stage = index == 0 ? 0 : index - 1; // Stage indices are 0 - 5
         const ShaderType program_type = GetShaderType(program_enum);
         const auto& entries = shader->GetEntries();
@@ -381,6 +642,184 @@ VKPipelineCache::DecompileShaders(const FixedPipelineState& fixed_state) {
     return {std::move(program), std::move(bindings)};
 }
 
+void VKPipelineCache::OptimizeProgram(SPIRVProgram& program) const {
+    for (std::optional<SPIRVShader>& stage : program) {
+        if (stage) {
+            spirv_optimizer.Optimize(stage->code);
+        }
+    }
+}
+
+std::unique_ptr<VKComputePipeline> VKPipelineCache::CreateComputePipeline(
+    const Shader& shader, u32 shared_memory_size, const std::array<u32, 3>& workgroup_size) const {
+    const Specialization specialization{
+        .base_binding = 0,
+        .workgroup_size = workgroup_size,
+        .shared_memory_size = shared_memory_size,
+        .point_size = std::nullopt,
+        .enabled_attributes = {},
+        .attribute_types = {},
+        .ndc_minus_one_to_one = false,
+    };
+    SPIRVShader spirv_shader{Decompile(device, shader.GetIR(), ShaderType::Compute,
+                                       shader.GetRegistry(), specialization),
+                             shader.GetEntries()};
+    spirv_optimizer.Optimize(spirv_shader.code);
+    return std::make_unique<VKComputePipeline>(device, scheduler, descriptor_pool,
+                                               update_descriptor_queue, spirv_shader,
+                                               *vk_pipeline_cache);
+}
+
+std::unique_ptr<VKGraphicsPipeline> VKPipelineCache::CreateDiskGraphicsPipeline(
+    const GraphicsPipelineDiskKey& key, VkRenderPass renderpass) const {
+    ShaderArray shaders{};
+    for (std::size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
+        const u64 unique_identifier = key.unique_identifiers[index];
+        if (unique_identifier == 0) {
+            continue;
+        }
+        shaders[index] = FindDiskShader(unique_identifier);
+        if (!shaders[index]) {
+            LOG_WARNING(Render_Vulkan, "Shader 0x{:016X} is missing from the disk cache",
+                        unique_identifier);
+            return nullptr;
+        }
+    }
+    // Guest addresses are unknown at this point, they are filled when the pipeline is used
+    GraphicsPipelineCacheKey cache_key{};
+    cache_key.renderpass = renderpass;
+    cache_key.fixed_state = key.fixed_state;
+
+    auto [program, bindings] = DecompileShaders(key.fixed_state, shaders);
+    OptimizeProgram(program);
+    return std::make_unique<VKGraphicsPipeline>(device, scheduler, descriptor_pool,
+                                                update_descriptor_queue, cache_key, bindings,
+                                                program, key.renderpass, *vk_pipeline_cache,
+                                                nullptr);
+}
+
+std::unique_ptr<VKComputePipeline> VKPipelineCache::CreateDiskComputePipeline(
+    const ComputePipelineDiskKey& key) const {
+    const Shader* const shader = FindDiskShader(key.unique_identifier);
+    if (!shader) {
+        LOG_WARNING(Render_Vulkan, "Kernel 0x{:016X} is missing from the disk cache",
+                    key.unique_identifier);
+        return nullptr;
+    }
+    return CreateComputePipeline(*shader, key.shared_memory_size, key.workgroup_size);
+}
+
+std::optional<GraphicsPipelineDiskKey> VKPipelineCache::MakeGraphicsDiskKey(
+    const GraphicsPipelineCacheKey& key) const {
+    const std::optional<RenderPassKey> renderpass =
+        texture_cache_runtime.FindRenderPassKey(key.renderpass);
+    if (!renderpass) {
+        return std::nullopt;
+    }
+    GraphicsPipelineDiskKey disk_key{};
+    for (std::size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
+        const Shader* const shader = last_shaders[index];
+        disk_key.unique_identifiers[index] = shader ? shader->GetUniqueIdentifier() : 0;
+    }
+    disk_key.renderpass = *renderpass;
+    std::memcpy(&disk_key.fixed_state, &key.fixed_state, key.fixed_state.Size());
+    return disk_key;
+}
+
+std::unique_ptr<VKGraphicsPipeline> VKPipelineCache::TakeDiskGraphicsPipeline(
+    const GraphicsPipelineDiskKey& disk_key) {
+    const auto it = disk_graphics_cache.find(disk_key);
+    if (it == disk_graphics_cache.end() || !HasConsistentDiskShaders(last_shaders)) {
+        return nullptr;
+    }
+    std::unique_ptr<VKGraphicsPipeline> pipeline = std::move(it->second);
+    disk_graphics_cache.erase(it);
+    return pipeline;
+}
+
+void VKPipelineCache::SaveDiskGraphicsPipeline(
+    const std::optional<GraphicsPipelineDiskKey>& disk_key) {
+    if (!disk_key) {
+        return;
+    }
+    for (const Shader* const shader : last_shaders) {
+        if (shader) {
+            disk_cache.SaveShader(shader->MakeDiskCacheEntry());
+        }
+    }
+    disk_cache.SaveGraphicsPipeline(*disk_key);
+}
+
+bool VKPipelineCache::HasConsistentDiskShaders(const ShaderArray& shaders) const {
+    for (const Shader* const shader : shaders) {
+        if (!shader) {
+            continue;
+        }
+        const Shader* const disk_shader = FindDiskShader(shader->GetUniqueIdentifier());
+        if (!disk_shader) {
+            return false;
+        }
+        const Registry& registry = shader->GetRegistry();
+        const Registry& disk_registry = disk_shader->GetRegistry();
+        if (!registry.HasEqualKeys(disk_registry)) {
+            return false;
+        }
+        if (shader->GetStage() == ShaderType::Compute) {
+            continue;
+        }
+        // Graphics state baked into the shader must match too, compute state is keyed
+        const auto& info = registry.GetGraphicsInfo();
+        const auto& disk_info = disk_registry.GetGraphicsInfo();
+        if (std::tie(info.primitive_topology, info.tessellation_primitive,
+                     info.tessellation_spacing, info.tfb_enabled, info.tessellation_clockwise) !=
+            std::tie(disk_info.primitive_topology, disk_info.tessellation_primitive,
+                     disk_info.tessellation_spacing, disk_info.tfb_enabled,
+                     disk_info.tessellation_clockwise)) {
+            return false;
+        }
+        if (info.tfb_enabled &&
+            (std::memcmp(&info.tfb_layouts, &disk_info.tfb_layouts, sizeof(info.tfb_layouts)) !=
+                 0 ||
+             info.tfb_varying_locs != disk_info.tfb_varying_locs)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Shader* VKPipelineCache::FindDiskShader(u64 unique_identifier) const {
+    const auto it = disk_shaders.find(unique_identifier);
+    return it != disk_shaders.end() ? it->second.get() : nullptr;
+}
+
+void VKPipelineCache::DecodeShaders(std::span<Shader* const> shaders) {
+    // Shaders keep their decoded program while they are among the most recently built ones
+    static constexpr std::size_t MAX_DECODED_SHADERS = 256;
+    static constexpr std::size_t DECODED_SHADERS_AFTER_RELEASE = MAX_DECODED_SHADERS * 3 / 4;
+
+    ++pipeline_build_tick;
+    for (Shader* const shader : shaders) {
+        if (!shader) {
+            continue;
+        }
+        const bool is_registered = shader != null_shader.get() && shader != null_kernel.get();
+        if (is_registered && !shader->HasIR()) {
+            decoded_shaders.push_back(shader);
+        }
+        shader->DecodeIR();
+        shader->SetLastBuildTick(pipeline_build_tick);
+    }
+    if (decoded_shaders.size() <= MAX_DECODED_SHADERS) {
+        return;
+    }
+    const auto release_end = decoded_shaders.end() - DECODED_SHADERS_AFTER_RELEASE;
+    std::ranges::nth_element(decoded_shaders, release_end, {}, &Shader::GetLastBuildTick);
+    for (auto it = decoded_shaders.begin(); it != release_end; ++it) {
+        (*it)->ReleaseIR();
+    }
+    decoded_shaders.erase(decoded_shaders.begin(), release_end);
+}
+
 template <VkDescriptorType descriptor_type, class Container>
 void AddEntry(std::vector<VkDescriptorUpdateTemplateEntry>& template_entries, u32& binding,
               u32& offset, const Container& container) {
@@ -5,8 +5,14 @@
 #pragma once
 
 #include <array>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stop_token>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
@@ -17,11 +23,16 @@
 #include "common/common_types.h"
 #include "video_core/engines/const_buffer_engine_interface.h"
 #include "video_core/engines/maxwell_3d.h"
+#include "video_core/rasterizer_interface.h"
 #include "video_core/renderer_vulkan/fixed_pipeline_state.h"
 #include "video_core/renderer_vulkan/vk_graphics_pipeline.h"
+#include "video_core/renderer_vulkan/vk_pipeline_disk_cache.h"
+#include "video_core/renderer_vulkan/vk_spirv_optimizer.h"
 #include "video_core/renderer_vulkan/vk_shader_decompiler.h"
 #include "video_core/shader/async_shaders.h"
+#include "video_core/shader/disk_cache_entry.h"
 #include "video_core/shader/memory_util.h"
+#include "video_core/shader/predecoder.h"
 #include "video_core/shader/registry.h"
 #include "video_core/shader/shader_ir.h"
 #include "video_core/shader_cache.h"
@@ -35,6 +46,7 @@ namespace Vulkan {
 
 class Device;
 class RasterizerVulkan;
+class TextureCacheRuntime;
 class VKComputePipeline;
 class VKDescriptorPool;
 class VKScheduler;
@@ -85,19 +97,52 @@ class Shader {
 public:
     explicit Shader(Tegra::Engines::ConstBufferEngineInterface& engine_,
                     Tegra::Engines::ShaderType stage_, GPUVAddr gpu_addr, VAddr cpu_addr_,
-                    VideoCommon::Shader::ProgramCode program_code, u32 main_offset_);
+                    VideoCommon::Shader::ProgramCode program_code, u32 main_offset_,
+                    VideoCommon::Shader::ShaderPredecoder* predecoder = nullptr);
+    explicit Shader(const VideoCommon::Shader::ShaderDiskCacheEntry& entry, u32 main_offset_);
     ~Shader();
 
     GPUVAddr GetGpuAddr() const {
         return gpu_addr;
     }
 
-    VideoCommon::Shader::ShaderIR& GetIR() {
-        return shader_ir;
+    Tegra::Engines::ShaderType GetStage() const {
+        return stage;
     }
 
+    u64 GetUniqueIdentifier() const {
+        return unique_identifier;
+    }
+
+    /// Returns a description of this shader that can be stored in the pipeline disk cache
+    VideoCommon::Shader::ShaderDiskCacheEntry MakeDiskCacheEntry() const;
+
+    /// Returns the decoded program, DecodeIR has to be called first if it was released
     const VideoCommon::Shader::ShaderIR& GetIR() const {
-        return shader_ir;
+        return predecoded ? predecoded->ir : *shader_ir;
+    }
+
+    /// Returns true when the decoded program is held in memory
+    bool HasIR() const {
+        return predecoded || shader_ir;
+    }
+
+    /// Decodes the program again from its guest code if it was released
+    void DecodeIR();
+
+    /// Releases the decoded program, only the guest code, registry and entries are kept
+    void ReleaseIR();
+
+    /// Releases the decoded program and the guest code, the shader can't be decompiled again
+    void Compact();
+
+    /// Returns the pipeline build tick this shader was last decompiled on
+    u64 GetLastBuildTick() const {
+        return last_build_tick;
+    }
+
+    void SetLastBuildTick(u64 tick) {
+        last_build_tick = tick;
     }
 
     const VideoCommon::Shader::Registry& GetRegistry() const {
@@ -110,10 +155,15 @@ public:
 
 private:
     GPUVAddr gpu_addr{};
+    Tegra::Engines::ShaderType stage{};
     VideoCommon::Shader::ProgramCode program_code;
+    u32 main_offset{};
+    u64 unique_identifier{};
     VideoCommon::Shader::Registry registry;
-    VideoCommon::Shader::ShaderIR shader_ir;
+    std::unique_ptr<VideoCommon::Shader::PredecodedShader> predecoded;
+    std::optional<VideoCommon::Shader::ShaderIR> shader_ir;
     ShaderEntries entries;
+    u64 last_build_tick{};
 };
 
 class VKPipelineCache final : public VideoCommon::ShaderCache<Shader> {
@@ -123,25 +173,83 @@ public:
                              Tegra::Engines::KeplerCompute& kepler_compute,
                              Tegra::MemoryManager& gpu_memory, const Device& device,
                              VKScheduler& scheduler, VKDescriptorPool& descriptor_pool,
-                             VKUpdateDescriptorQueue& update_descriptor_queue);
+                             VKUpdateDescriptorQueue& update_descriptor_queue,
+                             TextureCacheRuntime& texture_cache_runtime);
     ~VKPipelineCache() override;
 
+    /// Loads the pipeline disk cache for the current game and builds its pipelines
+    void LoadDiskResources(u64 title_id, std::stop_token stop_loading,
+                           const VideoCore::DiskResourceLoadCallback& callback);
+
+    /// Starts decoding a newly bound shader program in the background
+    void PrepareShader(Maxwell::ShaderProgram program);
+
     std::array<Shader*, Maxwell::MaxShaderProgram> GetShaders();
 
     VKGraphicsPipeline* GetGraphicsPipeline(const GraphicsPipelineCacheKey& key,
-                                            u32 num_color_buffers,
+                                            const RenderPassKey& renderpass_key,
                                             VideoCommon::Shader::AsyncShaders& async_shaders);
 
     VKComputePipeline& GetComputePipeline(const ComputePipelineCacheKey& key);
 
+    /// Waits for a pipeline queued for asynchronous compilation, returns null on timeout
+    VKGraphicsPipeline* WaitForGraphicsPipeline(const GraphicsPipelineCacheKey& key,
+                                                std::chrono::milliseconds timeout);
+
     void EmplacePipeline(std::unique_ptr<VKGraphicsPipeline> pipeline);
 
+    /// Returns the driver pipeline cache used to create pipelines, it may be null
+    VkPipelineCache GetVkPipelineCache() const {
+        return *vk_pipeline_cache;
+    }
+
+    /// Optimizes the SPIR-V of every stage when the optimizer is enabled, thread-safe
+    void OptimizeProgram(SPIRVProgram& program) const;
+
 protected:
     void OnShaderRemoval(Shader* shader) final;
 
 private:
+    using ShaderArray = std::array<Shader*, Maxwell::MaxShaderProgram>;
+
     std::pair<SPIRVProgram, std::vector<VkDescriptorSetLayoutBinding>> DecompileShaders(
-        const FixedPipelineState& fixed_state);
+        const FixedPipelineState& fixed_state, const ShaderArray& shaders) const;
+
+    std::unique_ptr<VKComputePipeline> CreateComputePipeline(
+        const Shader& shader, u32 shared_memory_size,
+        const std::array<u32, 3>& workgroup_size) const;
+
+    /// Creates a pipeline from a disk cache key, returns null if its shaders are not available
+    std::unique_ptr<VKGraphicsPipeline> CreateDiskGraphicsPipeline(
+        const GraphicsPipelineDiskKey& key, VkRenderPass renderpass) const;
+
+    /// Creates a compute pipeline from a disk cache key, returns null if its shader is missing
+    std::unique_ptr<VKComputePipeline> CreateDiskComputePipeline(
+        const ComputePipelineDiskKey& key) const;
+
+    /// Builds the disk cache key of a graphics pipeline using the last bound shaders
+    std::optional<GraphicsPipelineDiskKey> MakeGraphicsDiskKey(
+        const GraphicsPipelineCacheKey& key) const;
+
+    /// Takes a pipeline built from the disk cache if its shaders match the current ones
+    std::unique_ptr<VKGraphicsPipeline> TakeDiskGraphicsPipeline(
+        const GraphicsPipelineDiskKey& disk_key);
+
+    /// Saves the last bound shaders and the given pipeline to the disk cache
+    void SaveDiskGraphicsPipeline(const std::optional<GraphicsPipelineDiskKey>& disk_key);
+
+    /// Returns a pipeline with the same shaders as the given key to derive from, or null
+    VkPipeline FindBasePipeline(const GraphicsPipelineCacheKey& key) const;
+
+    /// Returns true when the shaders used to build disk pipelines match the given ones
+    bool HasConsistentDiskShaders(const ShaderArray& shaders) const;
+
+    /// Returns a shader loaded from the disk cache, or null if it's not present
+    Shader* FindDiskShader(u64 unique_identifier) const;
+
+    /// Decodes the given shaders for a pipeline build and releases the decoded programs of the
+    /// shaders that haven't been used to build a pipeline for the longest time
+    void DecodeShaders(std::span<Shader* const> shaders);
 
     Tegra::GPU& gpu;
     Tegra::Engines::Maxwell3D& maxwell3d;
@@ -152,19 +260,39 @@ private:
     VKScheduler& scheduler;
     VKDescriptorPool& descriptor_pool;
     VKUpdateDescriptorQueue& update_descriptor_queue;
+    TextureCacheRuntime& texture_cache_runtime;
+
+    PipelineDiskCache disk_cache;
+    SPIRVOptimizer spirv_optimizer;
+    vk::PipelineCache vk_pipeline_cache;
+    VideoCommon::Shader::ShaderPredecoder predecoder;
 
     std::unique_ptr<Shader> null_shader;
     std::unique_ptr<Shader> null_kernel;
 
     std::array<Shader*, Maxwell::MaxShaderProgram> last_shaders{};
 
+    /// Registered shaders holding their decoded program
+    std::vector<Shader*> decoded_shaders;
+    u64 pipeline_build_tick = 0;
+
     GraphicsPipelineCacheKey last_graphics_key;
     VKGraphicsPipeline* last_graphics_pipeline = nullptr;
 
+    ComputePipelineCacheKey last_compute_key{};
+    VKComputePipeline* last_compute_pipeline = nullptr;
+
     std::mutex pipeline_cache;
+    std::condition_variable pipeline_emplaced;
     std::unordered_map<GraphicsPipelineCacheKey, std::unique_ptr<VKGraphicsPipeline>>
         graphics_cache;
     std::unordered_map<ComputePipelineCacheKey, std::unique_ptr<VKComputePipeline>> compute_cache;
+
+    std::unordered_map<u64, std::unique_ptr<Shader>> disk_shaders;
+    std::unordered_map<GraphicsPipelineDiskKey, std::unique_ptr<VKGraphicsPipeline>>
+        disk_graphics_cache;
+    std::unordered_map<ComputePipelineDiskKey, std::unique_ptr<VKComputePipeline>>
+        disk_compute_cache;
 };
 
 void FillDescriptorUpdateTemplateEntries(
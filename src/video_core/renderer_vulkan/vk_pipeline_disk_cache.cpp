@@ -0,0 +1,458 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+
+#include <fmt/format.h>
+
+#include "common/cityhash.h"
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "common/zstd_compression.h"
+#include "video_core/renderer_vulkan/vk_pipeline_disk_cache.h"
+#include "video_core/vulkan_common/vulkan_device.h"
+
+namespace Vulkan {
+
+using VideoCommon::Shader::ShaderDiskCacheEntry;
+
+namespace {
+
+constexpr u32 NativeVersion = 1;
+constexpr u32 PipelineCacheDataVersion = 1;
+constexpr u32 OptimizedShadersVersion = 1;
+
+enum class TransferableEntryType : u32 {
+    Shader,
+    GraphicsPipeline,
+    ComputePipeline,
+};
+
+/// Identifies the device and driver that generated a pipeline cache blob
+struct PipelineCacheDataHeader {
+    u32 version;
+    u32 vendor_id;
+    u32 driver_version;
+    std::array<u8, VK_UUID_SIZE> uuid;
+};
+static_assert(std::has_unique_object_representations_v<PipelineCacheDataHeader>);
+
+PipelineCacheDataHeader MakePipelineCacheDataHeader(const Device& device) {
+    PipelineCacheDataHeader header{
+        .version = PipelineCacheDataVersion,
+        .vendor_id = device.GetVendorID(),
+        .driver_version = device.GetDriverVersion(),
+        .uuid{},
+    };
+    const auto uuid = device.GetPipelineCacheUUID();
+    std::ranges::copy(uuid, header.uuid.begin());
+    return header;
+}
+
+bool LoadGraphicsPipelineKey(Common::FS::IOFile& file, GraphicsPipelineDiskKey& key) {
+    u32 size;
+    if (!file.ReadObject(size) || size > sizeof(key)) {
+        return false;
+    }
+    std::memset(&key, 0, sizeof(key));
+    std::vector<u8> raw(size);
+    if (file.Read(raw) != size) {
+        return false;
+    }
+    std::memcpy(&key, raw.data(), size);
+    return key.Size() == size;
+}
+
+bool SaveGraphicsPipelineKey(Common::FS::IOFile& file, const GraphicsPipelineDiskKey& key) {
+    const u32 size = static_cast<u32>(key.Size());
+    return file.WriteObject(size) &&
+           file.WriteSpan(std::span(reinterpret_cast<const u8*>(&key), size)) == size;
+}
+
+} // Anonymous namespace
+
+std::size_t GraphicsPipelineDiskKey::Hash() const noexcept {
+    const u64 hash = Common::CityHash64(reinterpret_cast<const char*>(this), Size());
+    return static_cast<std::size_t>(hash);
+}
+
+bool GraphicsPipelineDiskKey::operator==(const GraphicsPipelineDiskKey& rhs) const noexcept {
+    return std::memcmp(&rhs, this, Size()) == 0;
+}
+
+std::size_t ComputePipelineDiskKey::Hash() const noexcept {
+    const u64 hash = Common::CityHash64(reinterpret_cast<const char*>(this), sizeof *this);
+    return static_cast<std::size_t>(hash);
+}
+
+bool ComputePipelineDiskKey::operator==(const ComputePipelineDiskKey& rhs) const noexcept {
+    return std::memcmp(&rhs, this, sizeof *this) == 0;
+}
+
+PipelineDiskCache::PipelineDiskCache(const Device& device_) : device{device_} {}
+
+PipelineDiskCache::~PipelineDiskCache() = default;
+
+void PipelineDiskCache::BindTitleID(u64 title_id_) {
+    title_id = title_id_;
+}
+
+std::optional<PipelineDiskCacheTransferable> PipelineDiskCache::LoadTransferable() {
+    // Skip games without title id
+    const bool has_title_id = title_id != 0;
+    if (!Settings::values.use_disk_shader_cache.GetValue() || !has_title_id) {
+        return std::nullopt;
+    }
+
+    Common::FS::IOFile file{GetTransferablePath(), Common::FS::FileAccessMode::Read,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        LOG_INFO(Render_Vulkan, "No transferable pipeline cache found");
+        is_usable = true;
+        return std::nullopt;
+    }
+
+    u32 version{};
+    if (!file.ReadObject(version)) {
+        LOG_ERROR(Render_Vulkan, "Failed to get transferable cache version, skipping it");
+        return std::nullopt;
+    }
+    if (version < NativeVersion) {
+        LOG_INFO(Render_Vulkan, "Transferable pipeline cache is old, removing");
+        file.Close();
+        InvalidateTransferable();
+        is_usable = true;
+        return std::nullopt;
+    }
+    if (version > NativeVersion) {
+        LOG_WARNING(Render_Vulkan, "Transferable pipeline cache was generated with a newer version "
+                                   "of the emulator, skipping");
+        return std::nullopt;
+    }
+
+    PipelineDiskCacheTransferable transferable;
+    while (static_cast<u64>(file.Tell()) < file.GetSize()) {
+        TransferableEntryType type{};
+        if (!file.ReadObject(type)) {
+            LOG_ERROR(Render_Vulkan, "Failed to load transferable entry type, skipping");
+            return std::nullopt;
+        }
+        bool success = false;
+        switch (type) {
+        case TransferableEntryType::Shader: {
+            ShaderDiskCacheEntry& entry = transferable.shaders.emplace_back();
+            success = entry.Load(file);
+            stored_shaders.insert(entry.unique_identifier);
+            break;
+        }
+        case TransferableEntryType::GraphicsPipeline: {
+            GraphicsPipelineDiskKey& key = transferable.graphics_pipelines.emplace_back();
+            success = LoadGraphicsPipelineKey(file, key);
+            stored_graphics_pipelines.insert(key);
+            break;
+        }
+        case TransferableEntryType::ComputePipeline: {
+            ComputePipelineDiskKey& key = transferable.compute_pipelines.emplace_back();
+            success = file.ReadObject(key);
+            stored_compute_pipelines.insert(key);
+            break;
+        }
+        }
+        if (!success) {
+            LOG_ERROR(Render_Vulkan, "Failed to load transferable raw entry, removing");
+            file.Close();
+            InvalidateTransferable();
+            stored_shaders.clear();
+            stored_graphics_pipelines.clear();
+            stored_compute_pipelines.clear();
+            is_usable = true;
+            return std::nullopt;
+        }
+    }
+
+    is_usable = true;
+    return {std::move(transferable)};
+}
+
+std::vector<u8> PipelineDiskCache::LoadPipelineCacheData() {
+    if (!is_usable) {
+        return {};
+    }
+
+    Common::FS::IOFile file{GetPipelineCachePath(), Common::FS::FileAccessMode::Read,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        LOG_INFO(Render_Vulkan, "No driver pipeline cache found");
+        return {};
+    }
+
+    PipelineCacheDataHeader header;
+    if (!file.ReadObject(header)) {
+        LOG_INFO(Render_Vulkan, "Failed to load driver pipeline cache header, removing");
+        file.Close();
+        InvalidatePipelineCacheData();
+        return {};
+    }
+    const PipelineCacheDataHeader expected = MakePipelineCacheDataHeader(device);
+    if (std::memcmp(&header, &expected, sizeof(header)) != 0) {
+        LOG_INFO(Render_Vulkan, "Driver pipeline cache is from another driver or device, "
+                                "discarding it");
+        return {};
+    }
+
+    std::vector<u8> compressed(file.GetSize() - sizeof(header));
+    if (file.Read(compressed) != compressed.size()) {
+        LOG_INFO(Render_Vulkan, "Failed to load driver pipeline cache, removing");
+        file.Close();
+        InvalidatePipelineCacheData();
+        return {};
+    }
+    return Common::Compression::DecompressDataZSTD(compressed);
+}
+
+std::unordered_map<u64, std::vector<u32>> PipelineDiskCache::LoadOptimizedShaders() {
+    if (!is_usable) {
+        return {};
+    }
+
+    Common::FS::IOFile file{GetOptimizedShadersPath(), Common::FS::FileAccessMode::Read,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        LOG_INFO(Render_Vulkan, "No optimized shader cache found");
+        return {};
+    }
+
+    u32 version{};
+    if (!file.ReadObject(version) || version != OptimizedShadersVersion) {
+        LOG_INFO(Render_Vulkan, "Optimized shader cache is from another version, removing");
+        file.Close();
+        InvalidateOptimizedShaders();
+        return {};
+    }
+
+    std::unordered_map<u64, std::vector<u32>> modules;
+    while (static_cast<u64>(file.Tell()) < file.GetSize()) {
+        u64 hash{};
+        u32 num_words{};
+        if (!file.ReadObject(hash) || !file.ReadObject(num_words) ||
+            static_cast<u64>(num_words) * sizeof(u32) > file.GetSize()) {
+            LOG_ERROR(Render_Vulkan, "Failed to load optimized shader entry, removing");
+            file.Close();
+            InvalidateOptimizedShaders();
+            return {};
+        }
+        std::vector<u32> code(num_words);
+        if (file.ReadSpan<u32>(code) != code.size()) {
+            LOG_ERROR(Render_Vulkan, "Failed to load optimized shader 0x{:016X}, removing", hash);
+            file.Close();
+            InvalidateOptimizedShaders();
+            return {};
+        }
+        modules.insert_or_assign(hash, std::move(code));
+    }
+    return modules;
+}
+
+void PipelineDiskCache::InvalidateTransferable() {
+    if (!Common::FS::RemoveFile(GetTransferablePath())) {
+        LOG_ERROR(Render_Vulkan, "Failed to invalidate transferable file={}",
+                  Common::FS::PathToUTF8String(GetTransferablePath()));
+    }
+    InvalidatePipelineCacheData();
+}
+
+void PipelineDiskCache::InvalidatePipelineCacheData() {
+    if (!Common::FS::RemoveFile(GetPipelineCachePath())) {
+        LOG_ERROR(Render_Vulkan, "Failed to invalidate pipeline cache file={}",
+                  Common::FS::PathToUTF8String(GetPipelineCachePath()));
+    }
+}
+
+void PipelineDiskCache::InvalidateOptimizedShaders() {
+    if (!Common::FS::RemoveFile(GetOptimizedShadersPath())) {
+        LOG_ERROR(Render_Vulkan, "Failed to invalidate optimized shaders file={}",
+                  Common::FS::PathToUTF8String(GetOptimizedShadersPath()));
+    }
+}
+
+void PipelineDiskCache::SaveShader(const ShaderDiskCacheEntry& entry) {
+    if (!is_usable) {
+        return;
+    }
+    if (stored_shaders.contains(entry.unique_identifier)) {
+        // The shader already exists
+        return;
+    }
+    Common::FS::IOFile file = AppendTransferableFile();
+    if (!file.IsOpen()) {
+        return;
+    }
+    if (!file.WriteObject(TransferableEntryType::Shader) || !entry.Save(file)) {
+        LOG_ERROR(Render_Vulkan, "Failed to save raw transferable shader entry, removing");
+        file.Close();
+        InvalidateTransferable();
+        return;
+    }
+    stored_shaders.insert(entry.unique_identifier);
+}
+
+void PipelineDiskCache::SaveGraphicsPipeline(const GraphicsPipelineDiskKey& key) {
+    if (!is_usable || stored_graphics_pipelines.contains(key)) {
+        return;
+    }
+    Common::FS::IOFile file = AppendTransferableFile();
+    if (!file.IsOpen()) {
+        return;
+    }
+    if (!file.WriteObject(TransferableEntryType::GraphicsPipeline) ||
+        !SaveGraphicsPipelineKey(file, key)) {
+        LOG_ERROR(Render_Vulkan, "Failed to save graphics pipeline key, removing");
+        file.Close();
+        InvalidateTransferable();
+        return;
+    }
+    stored_graphics_pipelines.insert(key);
+}
+
+void PipelineDiskCache::SaveComputePipeline(const ComputePipelineDiskKey& key) {
+    if (!is_usable || stored_compute_pipelines.contains(key)) {
+        return;
+    }
+    Common::FS::IOFile file = AppendTransferableFile();
+    if (!file.IsOpen()) {
+        return;
+    }
+    if (!file.WriteObject(TransferableEntryType::ComputePipeline) || !file.WriteObject(key)) {
+        LOG_ERROR(Render_Vulkan, "Failed to save compute pipeline key, removing");
+        file.Close();
+        InvalidateTransferable();
+        return;
+    }
+    stored_compute_pipelines.insert(key);
+}
+
+void PipelineDiskCache::SavePipelineCacheData(std::span<const u8> data) {
+    if (!is_usable || data.empty() || !EnsureDirectories()) {
+        return;
+    }
+    const std::vector<u8> compressed =
+        Common::Compression::CompressDataZSTDDefault(data.data(), data.size());
+
+    const auto pipeline_cache_path = GetPipelineCachePath();
+    Common::FS::IOFile file{pipeline_cache_path, Common::FS::FileAccessMode::Write,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        LOG_ERROR(Render_Vulkan, "Failed to open pipeline cache in path={}",
+                  Common::FS::PathToUTF8String(pipeline_cache_path));
+        return;
+    }
+    if (!file.WriteObject(MakePipelineCacheDataHeader(device)) ||
+        file.Write(compressed) != compressed.size()) {
+        LOG_ERROR(Render_Vulkan, "Failed to write pipeline cache in path={}",
+                  Common::FS::PathToUTF8String(pipeline_cache_path));
+    }
+}
+
+void PipelineDiskCache::SaveOptimizedShader(u64 hash, std::span<const u32> code) {
+    if (!is_usable || !EnsureDirectories()) {
+        return;
+    }
+    const auto optimized_path = GetOptimizedShadersPath();
+    const bool existed = Common::FS::Exists(optimized_path);
+
+    Common::FS::IOFile file{optimized_path, Common::FS::FileAccessMode::Append,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        LOG_ERROR(Render_Vulkan, "Failed to open optimized shaders in path={}",
+                  Common::FS::PathToUTF8String(optimized_path));
+        return;
+    }
+    const bool write_version = !existed || file.GetSize() == 0;
+    if ((write_version && !file.WriteObject(OptimizedShadersVersion)) || !file.WriteObject(hash) ||
+        !file.WriteObject(static_cast<u32>(code.size())) || file.WriteSpan(code) != code.size()) {
+        LOG_ERROR(Render_Vulkan, "Failed to save optimized shader 0x{:016X}, removing", hash);
+        file.Close();
+        InvalidateOptimizedShaders();
+    }
+}
+
+Common::FS::IOFile PipelineDiskCache::AppendTransferableFile() const {
+    if (!EnsureDirectories()) {
+        return {};
+    }
+
+    const auto transferable_path{GetTransferablePath()};
+    const bool existed = Common::FS::Exists(transferable_path);
+
+    Common::FS::IOFile file{transferable_path, Common::FS::FileAccessMode::Append,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        LOG_ERROR(Render_Vulkan, "Failed to open transferable cache in path={}",
+                  Common::FS::PathToUTF8String(transferable_path));
+        return {};
+    }
+    if (!existed || file.GetSize() == 0) {
+        // If the file didn't exist, write its version
+        if (!file.WriteObject(NativeVersion)) {
+            LOG_ERROR(Render_Vulkan, "Failed to write transferable cache version in path={}",
+                      Common::FS::PathToUTF8String(transferable_path));
+            return {};
+        }
+    }
+    return file;
+}
+
+bool PipelineDiskCache::EnsureDirectories() const {
+    const auto CreateDir = [](const std::filesystem::path& dir) {
+        if (!Common::FS::CreateDir(dir)) {
+            LOG_ERROR(Render_Vulkan, "Failed to create directory={}",
+                      Common::FS::PathToUTF8String(dir));
+            return false;
+        }
+        return true;
+    };
+
+    return CreateDir(Common::FS::GetYuzuPath(Common::FS::YuzuPath::ShaderDir)) &&
+           CreateDir(GetBaseDir()) && CreateDir(GetTransferableDir()) &&
+           CreateDir(GetPipelineCacheDir()) && CreateDir(GetOptimizedShadersDir());
+}
+
+std::filesystem::path PipelineDiskCache::GetTransferablePath() const {
+    return GetTransferableDir() / fmt::format("{}.bin", GetTitleID());
+}
+
+std::filesystem::path PipelineDiskCache::GetPipelineCachePath() const {
+    return GetPipelineCacheDir() / fmt::format("{}.bin", GetTitleID());
+}
+
+std::filesystem::path PipelineDiskCache::GetOptimizedShadersPath() const {
+    return GetOptimizedShadersDir() / fmt::format("{}.bin", GetTitleID());
+}
+
+std::filesystem::path PipelineDiskCache::GetTransferableDir() const {
+    return GetBaseDir() / "transferable";
+}
+
+std::filesystem::path PipelineDiskCache::GetPipelineCacheDir() const {
+    return GetBaseDir() / "pipeline";
+}
+
+std::filesystem::path PipelineDiskCache::GetOptimizedShadersDir() const {
+    return GetBaseDir() / "optimized";
+}
+
+std::filesystem::path PipelineDiskCache::GetBaseDir() const {
+    return Common::FS::GetYuzuPath(Common::FS::YuzuPath::ShaderDir) / "vulkan";
+}
+
+std::string PipelineDiskCache::GetTitleID() const {
+    return fmt::format("{:016X}", title_id);
+}
+
+} // namespace Vulkan
@@ -0,0 +1,193 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/renderer_vulkan/fixed_pipeline_state.h"
+#include "video_core/renderer_vulkan/vk_texture_cache.h"
+#include "video_core/shader/disk_cache_entry.h"
+
+namespace Common::FS {
+class IOFile;
+}
+
+namespace Vulkan {
+
+class Device;
+
+using Maxwell = Tegra::Engines::Maxwell3D::Regs;
+
+/// Describes a graphics pipeline independently from guest addresses and host handles
+struct GraphicsPipelineDiskKey {
+    std::array<u64, Maxwell::MaxShaderProgram> unique_identifiers;
+    RenderPassKey renderpass;
+    FixedPipelineState fixed_state;
+
+    std::size_t Hash() const noexcept;
+
+    bool operator==(const GraphicsPipelineDiskKey& rhs) const noexcept;
+
+    bool operator!=(const GraphicsPipelineDiskKey& rhs) const noexcept {
+        return !operator==(rhs);
+    }
+
+    std::size_t Size() const noexcept {
+        return sizeof(unique_identifiers) + sizeof(renderpass) + fixed_state.Size();
+    }
+};
+static_assert(std::is_trivially_copyable_v<GraphicsPipelineDiskKey>);
+static_assert(std::is_trivially_constructible_v<GraphicsPipelineDiskKey>);
+
+/// Describes a compute pipeline independently from guest addresses
+struct ComputePipelineDiskKey {
+    u64 unique_identifier;
+    u32 shared_memory_size;
+    std::array<u32, 3> workgroup_size;
+
+    std::size_t Hash() const noexcept;
+
+    bool operator==(const ComputePipelineDiskKey& rhs) const noexcept;
+
+    bool operator!=(const ComputePipelineDiskKey& rhs) const noexcept {
+        return !operator==(rhs);
+    }
+};
+static_assert(std::has_unique_object_representations_v<ComputePipelineDiskKey>);
+static_assert(std::is_trivially_copyable_v<ComputePipelineDiskKey>);
+static_assert(std::is_trivially_constructible_v<ComputePipelineDiskKey>);
+
+} // namespace Vulkan
+
+namespace std {
+
+template <>
+struct hash<Vulkan::GraphicsPipelineDiskKey> {
+    std::size_t operator()(const Vulkan::GraphicsPipelineDiskKey& k) const noexcept {
+        return k.Hash();
+    }
+};
+
+template <>
+struct hash<Vulkan::ComputePipelineDiskKey> {
+    std::size_t operator()(const Vulkan::ComputePipelineDiskKey& k) const noexcept {
+        return k.Hash();
+    }
+};
+
+} // namespace std
+
+namespace Vulkan {
+
+/// Contents of a transferable pipeline cache file
+struct PipelineDiskCacheTransferable {
+    std::vector<VideoCommon::Shader::ShaderDiskCacheEntry> shaders;
+    std::vector<GraphicsPipelineDiskKey> graphics_pipelines;
+    std::vector<ComputePipelineDiskKey> compute_pipelines;
+};
+
+/**
+ * Persists the guest shaders and pipeline keys used by a title, plus the driver's pipeline cache.
+ * The transferable file can be replayed on any host, while the pipeline cache blob is only valid
+ * on the same driver and physical device that generated it.
+ */
+class PipelineDiskCache {
+public:
+    explicit PipelineDiskCache(const Device& device);
+    ~PipelineDiskCache();
+
+    /// Binds a title ID for all future operations.
+    void BindTitleID(u64 title_id);
+
+    /// Loads transferable cache. If file has a old version or on failure, it deletes the file.
+    std::optional<PipelineDiskCacheTransferable> LoadTransferable();
+
+    /// Loads the driver pipeline cache blob. Returns empty if it's missing or from another driver.
+    std::vector<u8> LoadPipelineCacheData();
+
+    /// Loads the optimized SPIR-V modules, keyed by the hash of the module they were made from.
+    std::unordered_map<u64, std::vector<u32>> LoadOptimizedShaders();
+
+    /// Removes the transferable (and pipeline cache) file.
+    void InvalidateTransferable();
+
+    /// Removes the pipeline cache blob file.
+    void InvalidatePipelineCacheData();
+
+    /// Removes the optimized SPIR-V file.
+    void InvalidateOptimizedShaders();
+
+    /// Saves a guest shader to the transferable file. Checks for collisions.
+    void SaveShader(const VideoCommon::Shader::ShaderDiskCacheEntry& entry);
+
+    /// Saves a graphics pipeline key to the transferable file. Checks for collisions.
+    void SaveGraphicsPipeline(const GraphicsPipelineDiskKey& key);
+
+    /// Saves a compute pipeline key to the transferable file. Checks for collisions.
+    void SaveComputePipeline(const ComputePipelineDiskKey& key);
+
+    /// Serializes the driver pipeline cache blob to disk.
+    void SavePipelineCacheData(std::span<const u8> data);
+
+    /// Appends an optimized SPIR-V module to the optimized shaders file.
+    void SaveOptimizedShader(u64 hash, std::span<const u32> code);
+
+private:
+    /// Opens current game's transferable file and write it's header if it doesn't exist
+    Common::FS::IOFile AppendTransferableFile() const;
+
+    /// Create pipeline disk cache directories. Returns true on success.
+    bool EnsureDirectories() const;
+
+    /// Gets current game's transferable file path
+    std::filesystem::path GetTransferablePath() const;
+
+    /// Gets current game's pipeline cache blob path
+    std::filesystem::path GetPipelineCachePath() const;
+
+    /// Gets current game's optimized SPIR-V path
+    std::filesystem::path GetOptimizedShadersPath() const;
+
+    /// Get user's transferable directory path
+    std::filesystem::path GetTransferableDir() const;
+
+    /// Get user's pipeline cache blob directory path
+    std::filesystem::path GetPipelineCacheDir() const;
+
+    /// Get user's optimized SPIR-V directory path
+    std::filesystem::path GetOptimizedShadersDir() const;
+
+    /// Get user's shader directory path
+    std::filesystem::path GetBaseDir() const;
+
+    /// Get current game's title id
+    std::string GetTitleID() const;
+
+    const Device& device;
+
+    // Stored transferable entries
+    std::unordered_set<u64> stored_shaders;
+    std::unordered_set<GraphicsPipelineDiskKey> stored_graphics_pipelines;
+    std::unordered_set<ComputePipelineDiskKey> stored_compute_pipelines;
+
+    /// Title ID to operate on
+    u64 title_id = 0;
+
+    // The cache has been loaded at boot
+    bool is_usable = false;
+};
+
+} // namespace Vulkan
@@ -134,4 +134,26 @@ u64 HostCounter::BlockingQuery() const {
     }
 }
 
+bool HostCounter::IsHostReady() const {
+    if (tick >= cache.GetScheduler().CurrentTick()) {
+        // The query has not been submitted yet, its result can't be available.
+        return false;
+    }
+    u64 data;
+    const VkResult query_result = cache.GetDevice().GetLogical().GetQueryResults(
+        query.first, query.second, 1, sizeof(data), &data, sizeof(data), VK_QUERY_RESULT_64_BIT);
+
+    switch (query_result) {
+    case VK_SUCCESS:
+        return true;
+    case VK_NOT_READY:
+        return false;
+    case VK_ERROR_DEVICE_LOST:
+        cache.GetDevice().ReportLoss();
+        [[fallthrough]];
+    default:
+        throw vk::Exception(query_result);
+    }
+}
+
 } // namespace Vulkan
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -15,6 +16,7 @@
 #include "common/scope_exit.h"
 #include "common/settings.h"
 #include "core/core.h"
+#include "core/perf_stats.h"
 #include "video_core/engines/kepler_compute.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/renderer_vulkan/blit_image.h"
@@ -60,14 +62,15 @@ struct DrawParams {
 
 constexpr auto COMPUTE_SHADER_INDEX = static_cast<size_t>(Tegra::Engines::ShaderType::Compute);
 
-VkViewport GetViewportState(const Device& device, const Maxwell& regs, size_t index) {
+VkViewport GetViewportState(const Device& device, const Maxwell& regs, size_t index,
+                            float scale) {
     const auto& src = regs.viewport_transform[index];
-    const float width = src.scale_x * 2.0f;
-    const float height = src.scale_y * 2.0f;
+    const float width = src.scale_x * 2.0f * scale;
+    const float height = src.scale_y * 2.0f * scale;
     const float reduce_z = regs.depth_mode == Maxwell::DepthMode::MinusOneToOne ? 1.0f : 0.0f;
     VkViewport viewport{
-        .x = src.translate_x - src.scale_x,
-        .y = src.translate_y - src.scale_y,
+        .x = (src.translate_x - src.scale_x) * scale,
+        .y = (src.translate_y - src.scale_y) * scale,
         .width = width != 0.0f ? width : 1.0f,
         .height = height != 0.0f ? height : 1.0f,
         .minDepth = src.translate_z - src.scale_z * reduce_z,
@@ -80,14 +83,17 @@ VkViewport GetViewportState(const Device& device, const Maxwell& regs, size_t in
     return viewport;
 }
 
-VkRect2D GetScissorState(const Maxwell& regs, size_t index) {
+VkRect2D GetScissorState(const Maxwell& regs, size_t index, float scale) {
     const auto& src = regs.scissor_test[index];
+    const auto scale_value = [scale](u32 value) {
+        return static_cast<u32>(static_cast<float>(value) * scale);
+    };
     VkRect2D scissor;
     if (src.enable) {
-        scissor.offset.x = static_cast<s32>(src.min_x);
-        scissor.offset.y = static_cast<s32>(src.min_y);
-        scissor.extent.width = src.max_x - src.min_x;
-        scissor.extent.height = src.max_y - src.min_y;
+        scissor.offset.x = static_cast<s32>(scale_value(src.min_x));
+        scissor.offset.y = static_cast<s32>(scale_value(src.min_y));
+        scissor.extent.width = scale_value(src.max_x - src.min_x);
+        scissor.extent.height = scale_value(src.max_y - src.min_y);
     } else {
         scissor.offset.x = 0;
         scissor.offset.y = 0;
@@ -243,14 +249,15 @@ RasterizerVulkan::RasterizerVulkan(Core::Frontend::EmuWindow& emu_window_, Tegra
       blit_image(device, scheduler, state_tracker, descriptor_pool),
       astc_decoder_pass(device, scheduler, descriptor_pool, staging_pool, update_descriptor_queue,
                         memory_allocator),
-      texture_cache_runtime{device,       scheduler,  memory_allocator,
-                            staging_pool, blit_image, astc_decoder_pass},
+      bcn_decoder_pass(device, scheduler, descriptor_pool, update_descriptor_queue),
+      texture_cache_runtime{device,     scheduler,         memory_allocator, staging_pool,
+                            blit_image, astc_decoder_pass, bcn_decoder_pass},
       texture_cache(texture_cache_runtime, *this, maxwell3d, kepler_compute, gpu_memory),
       buffer_cache_runtime(device, memory_allocator, scheduler, staging_pool,
                            update_descriptor_queue, descriptor_pool),
       buffer_cache(*this, maxwell3d, kepler_compute, gpu_memory, cpu_memory_, buffer_cache_runtime),
       pipeline_cache(*this, gpu, maxwell3d, kepler_compute, gpu_memory, device, scheduler,
-                     descriptor_pool, update_descriptor_queue),
+                     descriptor_pool, update_descriptor_queue, texture_cache_runtime),
       query_cache{*this, maxwell3d, gpu_memory, device, scheduler}, accelerate_dma{buffer_cache},
       fence_manager(*this, gpu, texture_cache, buffer_cache, query_cache, device, scheduler),
       wfi_event(device.GetLogical().CreateEvent()), async_shaders(emu_window_) {
@@ -262,6 +269,11 @@ RasterizerVulkan::RasterizerVulkan(Core::Frontend::EmuWindow& emu_window_, Tegra
 
 RasterizerVulkan::~RasterizerVulkan() = default;
 
+void RasterizerVulkan::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
+                                         const VideoCore::DiskResourceLoadCallback& callback) {
+    pipeline_cache.LoadDiskResources(title_id, stop_loading, callback);
+}
+
 void RasterizerVulkan::Draw(bool is_indexed, bool is_instanced) {
     MICROPROFILE_SCOPE(Vulkan_Drawing);
 
@@ -275,21 +287,34 @@ void RasterizerVulkan::Draw(bool is_indexed, bool is_instanced) {
     std::scoped_lock lock{buffer_cache.mutex, texture_cache.mutex};
 
     texture_cache.SynchronizeGraphicsDescriptors();
-    texture_cache.UpdateRenderTargets(false);
 
     const auto shaders = pipeline_cache.GetShaders();
     graphics_key.shaders = GetShaderAddresses(shaders);
 
     SetupShaderDescriptors(shaders, is_indexed);
 
+    const Shader* const fragment_shader =
+        shaders[static_cast<size_t>(Maxwell::ShaderProgram::Fragment)];
+    const bool uses_frag_coord = fragment_shader && fragment_shader->GetEntries().uses_frag_coord;
+    texture_cache.UpdateRenderTargets(false, uses_frag_coord);
+    UpdateRenderScale();
+
     const Framebuffer* const framebuffer = texture_cache.GetFramebuffer();
     graphics_key.renderpass = framebuffer->RenderPass();
 
-    VKGraphicsPipeline* const pipeline = pipeline_cache.GetGraphicsPipeline(
-        graphics_key, framebuffer->NumColorBuffers(), async_shaders);
+    VKGraphicsPipeline* pipeline = pipeline_cache.GetGraphicsPipeline(
+        graphics_key, framebuffer->GetRenderPassKey(), async_shaders);
     if (pipeline == nullptr || pipeline->GetHandle() == VK_NULL_HANDLE) {
-        // Async graphics pipeline was not ready.
-        return;
+        // Async graphics pipeline was not ready, wait for it when the title allows it
+        const std::chrono::milliseconds wait_time{
+            Settings::values.async_shader_wait_time.GetValue()};
+        if (wait_time.count() == 0) {
+            return;
+        }
+        pipeline = pipeline_cache.WaitForGraphicsPipeline(graphics_key, wait_time);
+        if (pipeline == nullptr) {
+            return;
+        }
     }
 
     BeginTransformFeedback();
@@ -340,12 +365,13 @@ void RasterizerVulkan::Clear() {
 
     std::scoped_lock lock{texture_cache.mutex};
     texture_cache.UpdateRenderTargets(true);
+    UpdateRenderScale();
     const Framebuffer* const framebuffer = texture_cache.GetFramebuffer();
     const VkExtent2D render_area = framebuffer->RenderArea();
     scheduler.RequestRenderpass(framebuffer);
 
     VkClearRect clear_rect{
-        .rect = GetScissorState(regs, 0),
+        .rect = GetScissorState(regs, 0, render_scale),
         .baseArrayLayer = regs.clear_buffers.layer,
         .layerCount = 1,
     };
@@ -360,18 +386,36 @@ void RasterizerVulkan::Clear() {
     const u32 color_attachment = regs.clear_buffers.RT;
     const auto attachment_aspect_mask = framebuffer->ImageRanges()[color_attachment].aspectMask;
     const bool is_color_rt = (attachment_aspect_mask & VK_IMAGE_ASPECT_COLOR_BIT) != 0;
+
+    // Clears of whole attachments issued before anything else is recorded in the renderpass are
+    // folded into its load operations, skipping a separate clear on tilers
+    const bool is_full_clear = clear_rect.rect.offset.x == 0 && clear_rect.rect.offset.y == 0 &&
+                               clear_rect.rect.extent.width == render_area.width &&
+                               clear_rect.rect.extent.height == render_area.height &&
+                               clear_rect.baseArrayLayer == 0 && framebuffer->NumLayers() == 1;
     if (use_color && is_color_rt) {
         VkClearValue clear_value;
         std::memcpy(clear_value.color.float32, regs.clear_color, sizeof(regs.clear_color));
 
-        scheduler.Record([color_attachment, clear_value, clear_rect](vk::CommandBuffer cmdbuf) {
-            const VkClearAttachment attachment{
-                .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-                .colorAttachment = color_attachment,
-                .clearValue = clear_value,
-            };
-            cmdbuf.ClearAttachments(attachment, clear_rect);
-        });
+        if (is_full_clear && scheduler.IsRenderPassPending() &&
+            color_attachment < framebuffer->NumColorBuffers()) {
+            const u32 clear_mask = scheduler.RenderPassClearMask() | (1U << color_attachment);
+            scheduler.SetRenderPassClear(
+                texture_cache_runtime.GetClearRenderPass(framebuffer->GetRenderPassKey(),
+                                                         clear_mask),
+                clear_mask);
+            scheduler.RenderPassClearValue(color_attachment) = clear_value;
+        } else {
+            scheduler.Record(
+                [color_attachment, clear_value, clear_rect](vk::CommandBuffer cmdbuf) {
+                    const VkClearAttachment attachment{
+                        .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                        .colorAttachment = color_attachment,
+                        .clearValue = clear_value,
+                    };
+                    cmdbuf.ClearAttachments(attachment, clear_rect);
+                });
+        }
     }
 
     if (!use_depth && !use_stencil) {
@@ -384,6 +428,25 @@ void RasterizerVulkan::Clear() {
     if (use_stencil) {
         aspect_flags |= VK_IMAGE_ASPECT_STENCIL_BIT;
     }
+    const u32 depth_attachment = framebuffer->NumColorBuffers();
+    const bool has_depth_attachment = depth_attachment < framebuffer->NumImages();
+    if (is_full_clear && scheduler.IsRenderPassPending() && has_depth_attachment &&
+        (framebuffer->ImageRanges()[depth_attachment].aspectMask & aspect_flags) == aspect_flags) {
+        u32 clear_mask = scheduler.RenderPassClearMask();
+        VkClearValue& clear_value = scheduler.RenderPassClearValue(depth_attachment);
+        if (use_depth) {
+            clear_mask |= RENDER_PASS_CLEAR_DEPTH_BIT;
+            clear_value.depthStencil.depth = regs.clear_depth;
+        }
+        if (use_stencil) {
+            clear_mask |= RENDER_PASS_CLEAR_STENCIL_BIT;
+            clear_value.depthStencil.stencil = static_cast<u32>(regs.clear_stencil);
+        }
+        scheduler.SetRenderPassClear(
+            texture_cache_runtime.GetClearRenderPass(framebuffer->GetRenderPassKey(), clear_mask),
+            clear_mask);
+        return;
+    }
     scheduler.Record([clear_depth = regs.clear_depth, clear_stencil = regs.clear_stencil,
                       clear_rect, aspect_flags](vk::CommandBuffer cmdbuf) {
         VkClearAttachment attachment;
@@ -415,6 +478,7 @@ void RasterizerVulkan::DispatchCompute(GPUVAddr code_addr) {
     scheduler.RequestOutsideRenderPassOperationContext();
 
     image_view_indices.clear();
+    native_image_view_indices.clear();
     sampler_handles.clear();
 
     std::scoped_lock lock{buffer_cache.mutex, texture_cache.mutex};
@@ -437,6 +501,8 @@ void RasterizerVulkan::DispatchCompute(GPUVAddr code_addr) {
     SetupComputeStorageTexels(entries);
     SetupComputeImages(entries);
 
+    texture_cache.RequireNativeComputeImages(
+        std::span(native_image_view_indices.data(), native_image_view_indices.size()));
     const std::span indices_span(image_view_indices.data(), image_view_indices.size());
     texture_cache.FillComputeImageViews(indices_span, image_view_ids);
 
@@ -452,6 +518,11 @@ void RasterizerVulkan::DispatchCompute(GPUVAddr code_addr) {
     const VkPipeline pipeline_handle = pipeline.GetHandle();
     const VkPipelineLayout pipeline_layout = pipeline.GetLayout();
     const VkDescriptorSet descriptor_set = pipeline.CommitDescriptorSet();
+    if (scheduler.IsProfiling()) {
+        scheduler.BeginProfileScope(fmt::format("Dispatch 0x{:x}", code_addr));
+    } else {
+        scheduler.BeginProfileScope({});
+    }
     scheduler.Record([grid_x = launch_desc.grid_dim_x, grid_y = launch_desc.grid_dim_y,
                       grid_z = launch_desc.grid_dim_z, pipeline_handle, pipeline_layout,
                       descriptor_set](vk::CommandBuffer cmdbuf) {
@@ -462,6 +533,7 @@ void RasterizerVulkan::DispatchCompute(GPUVAddr code_addr) {
         }
         cmdbuf.Dispatch(grid_x, grid_y, grid_z);
     });
+    scheduler.EndProfileScope();
 }
 
 void RasterizerVulkan::ResetCounter(VideoCore::QueryType type) {
@@ -473,6 +545,10 @@ void RasterizerVulkan::Query(GPUVAddr gpu_addr, VideoCore::QueryType type,
     query_cache.Query(gpu_addr, type, timestamp);
 }
 
+bool RasterizerVulkan::IsQueryPending(GPUVAddr gpu_addr, u64 size) {
+    return query_cache.IsRegionPending(gpu_addr, size);
+}
+
 void RasterizerVulkan::BindGraphicsUniformBuffer(size_t stage, u32 index, GPUVAddr gpu_addr,
                                                  u32 size) {
     buffer_cache.BindGraphicsUniformBuffer(stage, index, gpu_addr, size);
@@ -482,6 +558,10 @@ void Vulkan::RasterizerVulkan::DisableGraphicsUniformBuffer(size_t stage, u32 in
     buffer_cache.DisableGraphicsUniformBuffer(stage, index);
 }
 
+void RasterizerVulkan::PrepareGraphicsShader(size_t program) {
+    pipeline_cache.PrepareShader(static_cast<Maxwell::ShaderProgram>(program));
+}
+
 void RasterizerVulkan::FlushAll() {}
 
 void RasterizerVulkan::FlushRegion(VAddr addr, u64 size) {
@@ -635,12 +715,16 @@ void RasterizerVulkan::TiledCacheBarrier() {
 void RasterizerVulkan::FlushCommands() {
     if (draw_counter > 0) {
         draw_counter = 0;
+        last_flush_time = std::chrono::steady_clock::now();
         scheduler.Flush();
     }
 }
 
 void RasterizerVulkan::TickFrame() {
     draw_counter = 0;
+    last_flush_time = std::chrono::steady_clock::now();
+    maxwell3d.System().GetPerfStats().AddGpuIdle(scheduler.TakeGpuIdleTime());
+    scheduler.TickFrame();
     update_descriptor_queue.TickFrame();
     fence_manager.TickFrame();
     staging_pool.TickFrame();
@@ -654,6 +738,14 @@ void RasterizerVulkan::TickFrame() {
     }
 }
 
+VideoCore::RasterizerMemoryUsage RasterizerVulkan::GetMemoryUsage() const {
+    return VideoCore::RasterizerMemoryUsage{
+        .texture_cache = texture_cache.GetUsedMemory(),
+        .buffer_cache = buffer_cache.GetUsedMemory(),
+        .staging_buffers = staging_pool.GetUsedMemory(),
+    };
+}
+
 bool RasterizerVulkan::AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Surface& src,
                                              const Tegra::Engines::Fermi2D::Surface& dst,
                                              const Tegra::Engines::Fermi2D::Config& copy_config) {
@@ -684,24 +776,34 @@ bool RasterizerVulkan::AccelerateDisplay(const Tegra::FramebufferConfig& config,
 }
 
 void RasterizerVulkan::FlushWork() {
-    static constexpr u32 DRAWS_TO_DISPATCH = 4096;
+    static constexpr u32 MIN_DRAWS_TO_FLUSH = 128;
+    static constexpr u32 DRAWS_TO_FLUSH = 4096;
+    static constexpr auto TIME_TO_FLUSH = std::chrono::milliseconds{2};
 
     // Only check multiples of 8 draws
-    static_assert(DRAWS_TO_DISPATCH % 8 == 0);
+    static_assert(MIN_DRAWS_TO_FLUSH % 8 == 0 && DRAWS_TO_FLUSH % 8 == 0);
     if ((++draw_counter & 7) != 7) {
         return;
     }
 
-    if (draw_counter < DRAWS_TO_DISPATCH) {
+    // Submit early when the GPU has run out of work or the batch has been building for a while,
+    // so the GPU isn't left waiting for a large batch. Small batches are kept to amortize the
+    // submission overhead.
+    bool flush = draw_counter >= DRAWS_TO_FLUSH;
+    if (!flush && draw_counter >= MIN_DRAWS_TO_FLUSH) {
+        const auto now = std::chrono::steady_clock::now();
+        flush = scheduler.PollGpuIdle() || now - last_flush_time >= TIME_TO_FLUSH;
+    }
+    if (!flush) {
         // Send recorded tasks to the worker thread
         scheduler.DispatchWork();
         return;
     }
 
-    // Otherwise (every certain number of draws) flush execution.
     // This submits commands to the Vulkan driver.
     scheduler.Flush();
     draw_counter = 0;
+    last_flush_time = std::chrono::steady_clock::now();
 }
 
 AccelerateDMA::AccelerateDMA(BufferCache& buffer_cache_) : buffer_cache{buffer_cache_} {}
@@ -714,6 +816,7 @@ bool AccelerateDMA::BufferCopy(GPUVAddr src_address, GPUVAddr dest_address, u64
 void RasterizerVulkan::SetupShaderDescriptors(
     const std::array<Shader*, Maxwell::MaxShaderProgram>& shaders, bool is_indexed) {
     image_view_indices.clear();
+    native_image_view_indices.clear();
     sampler_handles.clear();
     for (size_t stage = 0; stage < Maxwell::MaxShaderStage; ++stage) {
         Shader* const shader = shaders[stage + 1];
@@ -737,6 +840,8 @@ void RasterizerVulkan::SetupShaderDescriptors(
     }
     const std::span indices_span(image_view_indices.data(), image_view_indices.size());
     buffer_cache.UpdateGraphicsBuffers(is_indexed);
+    texture_cache.RequireNativeGraphicsImages(
+        std::span(native_image_view_indices.data(), native_image_view_indices.size()));
     texture_cache.FillGraphicsImageViews(indices_span, image_view_ids);
 
     buffer_cache.BindHostGeometryBuffers(is_indexed);
@@ -805,6 +910,16 @@ void RasterizerVulkan::EndTransformFeedback() {
         [](vk::CommandBuffer cmdbuf) { cmdbuf.EndTransformFeedbackEXT(0, 0, nullptr, nullptr); });
 }
 
+void RasterizerVulkan::UpdateRenderScale() {
+    const float scale = texture_cache.RenderTargetScale();
+    if (scale == render_scale) {
+        return;
+    }
+    render_scale = scale;
+    state_tracker.InvalidateViewports();
+    state_tracker.InvalidateScissors();
+}
+
 void RasterizerVulkan::SetupGraphicsUniformTexels(const ShaderEntries& entries, size_t stage) {
     const auto& regs = maxwell3d.regs;
     const bool via_header_index = regs.sampler_index == Maxwell::SamplerIndex::ViaHeaderIndex;
@@ -822,8 +937,11 @@ void RasterizerVulkan::SetupGraphicsTextures(const ShaderEntries& entries, size_
             const TextureHandle handle =
                 GetTextureInfo(maxwell3d, via_header_index, entry, stage, index);
             image_view_indices.push_back(handle.image);
+            if (entry.is_fetched) {
+                native_image_view_indices.push_back(handle.image);
+            }
 
-            Sampler* const sampler = texture_cache.GetGraphicsSampler(handle.sampler);
+            Sampler* const sampler = texture_cache.GetGraphicsSampler(handle.sampler, handle.image);
             sampler_handles.push_back(sampler->Handle());
         }
     }
@@ -835,6 +953,7 @@ void RasterizerVulkan::SetupGraphicsStorageTexels(const ShaderEntries& entries,
     for (const auto& entry : entries.storage_texels) {
         const TextureHandle handle = GetTextureInfo(maxwell3d, via_header_index, entry, stage);
         image_view_indices.push_back(handle.image);
+        native_image_view_indices.push_back(handle.image);
     }
 }
 
@@ -844,6 +963,7 @@ void RasterizerVulkan::SetupGraphicsImages(const ShaderEntries& entries, size_t
     for (const auto& entry : entries.images) {
         const TextureHandle handle = GetTextureInfo(maxwell3d, via_header_index, entry, stage);
         image_view_indices.push_back(handle.image);
+        native_image_view_indices.push_back(handle.image);
     }
 }
 
@@ -863,8 +983,11 @@ void RasterizerVulkan::SetupComputeTextures(const ShaderEntries& entries) {
             const TextureHandle handle = GetTextureInfo(kepler_compute, via_header_index, entry,
                                                         COMPUTE_SHADER_INDEX, index);
             image_view_indices.push_back(handle.image);
+            if (entry.is_fetched) {
+                native_image_view_indices.push_back(handle.image);
+            }
 
-            Sampler* const sampler = texture_cache.GetComputeSampler(handle.sampler);
+            Sampler* const sampler = texture_cache.GetComputeSampler(handle.sampler, handle.image);
             sampler_handles.push_back(sampler->Handle());
         }
     }
@@ -876,6 +999,7 @@ void RasterizerVulkan::SetupComputeStorageTexels(const ShaderEntries& entries) {
         const TextureHandle handle =
             GetTextureInfo(kepler_compute, via_header_index, entry, COMPUTE_SHADER_INDEX);
         image_view_indices.push_back(handle.image);
+        native_image_view_indices.push_back(handle.image);
     }
 }
 
@@ -885,6 +1009,7 @@ void RasterizerVulkan::SetupComputeImages(const ShaderEntries& entries) {
         const TextureHandle handle =
             GetTextureInfo(kepler_compute, via_header_index, entry, COMPUTE_SHADER_INDEX);
         image_view_indices.push_back(handle.image);
+        native_image_view_indices.push_back(handle.image);
     }
 }
 
@@ -893,14 +1018,22 @@ void RasterizerVulkan::UpdateViewportsState(Tegra::Engines::Maxwell3D::Regs& reg
         return;
     }
     const std::array viewports{
-        GetViewportState(device, regs, 0),  GetViewportState(device, regs, 1),
-        GetViewportState(device, regs, 2),  GetViewportState(device, regs, 3),
-        GetViewportState(device, regs, 4),  GetViewportState(device, regs, 5),
-        GetViewportState(device, regs, 6),  GetViewportState(device, regs, 7),
-        GetViewportState(device, regs, 8),  GetViewportState(device, regs, 9),
-        GetViewportState(device, regs, 10), GetViewportState(device, regs, 11),
-        GetViewportState(device, regs, 12), GetViewportState(device, regs, 13),
-        GetViewportState(device, regs, 14), GetViewportState(device, regs, 15),
+        GetViewportState(device, regs, 0, render_scale),
+        GetViewportState(device, regs, 1, render_scale),
+        GetViewportState(device, regs, 2, render_scale),
+        GetViewportState(device, regs, 3, render_scale),
+        GetViewportState(device, regs, 4, render_scale),
+        GetViewportState(device, regs, 5, render_scale),
+        GetViewportState(device, regs, 6, render_scale),
+        GetViewportState(device, regs, 7, render_scale),
+        GetViewportState(device, regs, 8, render_scale),
+        GetViewportState(device, regs, 9, render_scale),
+        GetViewportState(device, regs, 10, render_scale),
+        GetViewportState(device, regs, 11, render_scale),
+        GetViewportState(device, regs, 12, render_scale),
+        GetViewportState(device, regs, 13, render_scale),
+        GetViewportState(device, regs, 14, render_scale),
+        GetViewportState(device, regs, 15, render_scale),
     };
     scheduler.Record([viewports](vk::CommandBuffer cmdbuf) { cmdbuf.SetViewport(0, viewports); });
 }
@@ -910,12 +1043,14 @@ void RasterizerVulkan::UpdateScissorsState(Tegra::Engines::Maxwell3D::Regs& regs
         return;
     }
     const std::array scissors{
-        GetScissorState(regs, 0),  GetScissorState(regs, 1),  GetScissorState(regs, 2),
-        GetScissorState(regs, 3),  GetScissorState(regs, 4),  GetScissorState(regs, 5),
-        GetScissorState(regs, 6),  GetScissorState(regs, 7),  GetScissorState(regs, 8),
-        GetScissorState(regs, 9),  GetScissorState(regs, 10), GetScissorState(regs, 11),
-        GetScissorState(regs, 12), GetScissorState(regs, 13), GetScissorState(regs, 14),
-        GetScissorState(regs, 15),
+        GetScissorState(regs, 0, render_scale), GetScissorState(regs, 1, render_scale),
+        GetScissorState(regs, 2, render_scale), GetScissorState(regs, 3, render_scale),
+        GetScissorState(regs, 4, render_scale), GetScissorState(regs, 5, render_scale),
+        GetScissorState(regs, 6, render_scale), GetScissorState(regs, 7, render_scale),
+        GetScissorState(regs, 8, render_scale), GetScissorState(regs, 9, render_scale),
+        GetScissorState(regs, 10, render_scale), GetScissorState(regs, 11, render_scale),
+        GetScissorState(regs, 12, render_scale), GetScissorState(regs, 13, render_scale),
+        GetScissorState(regs, 14, render_scale), GetScissorState(regs, 15, render_scale),
     };
     scheduler.Record([scissors](vk::CommandBuffer cmdbuf) { cmdbuf.SetScissor(0, scissors); });
 }
@@ -6,6 +6,7 @@
 
 #include <array>
 #include <bitset>
+#include <chrono>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -69,13 +70,17 @@ public:
                               VKScheduler& scheduler_);
     ~RasterizerVulkan() override;
 
+    void LoadDiskResources(u64 title_id, std::stop_token stop_loading,
+                           const VideoCore::DiskResourceLoadCallback& callback) override;
     void Draw(bool is_indexed, bool is_instanced) override;
     void Clear() override;
     void DispatchCompute(GPUVAddr code_addr) override;
     void ResetCounter(VideoCore::QueryType type) override;
     void Query(GPUVAddr gpu_addr, VideoCore::QueryType type, std::optional<u64> timestamp) override;
+    bool IsQueryPending(GPUVAddr gpu_addr, u64 size) override;
     void BindGraphicsUniformBuffer(size_t stage, u32 index, GPUVAddr gpu_addr, u32 size) override;
     void DisableGraphicsUniformBuffer(size_t stage, u32 index) override;
+    void PrepareGraphicsShader(size_t program) override;
     void FlushAll() override;
     void FlushRegion(VAddr addr, u64 size) override;
     bool MustFlushRegion(VAddr addr, u64 size) override;
@@ -94,6 +99,7 @@ public:
     void TiledCacheBarrier() override;
     void FlushCommands() override;
     void TickFrame() override;
+    VideoCore::RasterizerMemoryUsage GetMemoryUsage() const override;
     bool AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Surface& src,
                                const Tegra::Engines::Fermi2D::Surface& dst,
                                const Tegra::Engines::Fermi2D::Config& copy_config) override;
@@ -133,6 +139,9 @@ private:
 
     void EndTransformFeedback();
 
+    /// Invalidates viewports and scissors when the scale of the bound render targets has changed
+    void UpdateRenderScale();
+
     /// Setup uniform texels in the graphics pipeline.
     void SetupGraphicsUniformTexels(const ShaderEntries& entries, std::size_t stage);
 
@@ -189,6 +198,7 @@ private:
     VKUpdateDescriptorQueue update_descriptor_queue;
     BlitImageHelper blit_image;
     ASTCDecoderPass astc_decoder_pass;
+    BCnDecoderPass bcn_decoder_pass;
 
     GraphicsPipelineCacheKey graphics_key;
 
@@ -205,10 +215,13 @@ private:
     VideoCommon::Shader::AsyncShaders async_shaders;
 
     boost::container::static_vector<u32, MAX_IMAGE_VIEWS> image_view_indices;
+    boost::container::static_vector<u32, MAX_IMAGE_VIEWS> native_image_view_indices;
     std::array<VideoCommon::ImageViewId, MAX_IMAGE_VIEWS> image_view_ids;
     boost::container::static_vector<VkSampler, MAX_TEXTURES> sampler_handles;
 
     u32 draw_counter = 0;
+    std::chrono::steady_clock::time_point last_flush_time = std::chrono::steady_clock::now();
+    float render_scale = 1.0f;
 };
 
 } // namespace Vulkan
@@ -15,8 +15,7 @@ ResourcePool::ResourcePool(MasterSemaphore& master_semaphore_, size_t grow_step_
 ResourcePool::~ResourcePool() = default;
 
 size_t ResourcePool::CommitResource() {
-    // Refresh semaphore to query updated results
-    master_semaphore.Refresh();
+    // The known tick is kept up to date by the semaphore wait thread
     const u64 gpu_tick = master_semaphore.KnownGpuTick();
     const auto search = [this, gpu_tick](size_t begin, size_t end) -> std::optional<size_t> {
         for (size_t iterator = begin; iterator < end; ++iterator) {
@@ -2,20 +2,25 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <thread>
 #include <utility>
 
+#include "common/assert.h"
 #include "common/microprofile.h"
 #include "common/thread.h"
+#include "common/thread_placement.h"
 #include "video_core/renderer_vulkan/vk_command_pool.h"
+#include "video_core/renderer_vulkan/vk_gpu_profiler.h"
 #include "video_core/renderer_vulkan/vk_master_semaphore.h"
 #include "video_core/renderer_vulkan/vk_query_cache.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_state_tracker.h"
 #include "video_core/renderer_vulkan/vk_texture_cache.h"
+#include "video_core/renderer_vulkan/vk_async_scheduler.h"
 #include "video_core/vulkan_common/vulkan_device.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
 
@@ -40,8 +45,19 @@ void VKScheduler::CommandChunk::ExecuteAll(vk::CommandBuffer cmdbuf) {
 VKScheduler::VKScheduler(const Device& device_, StateTracker& state_tracker_)
     : device{device_}, state_tracker{state_tracker_},
       master_semaphore{std::make_unique<MasterSemaphore>(device)},
-      command_pool{std::make_unique<CommandPool>(*master_semaphore, device)} {
+      command_pool{
+          std::make_unique<CommandPool>(*master_semaphore, device, device.GetGraphicsFamily())},
+      profiler{std::make_unique<GPUProfiler>(device, *master_semaphore)} {
+    if (device.HasTransferQueue()) {
+        transfer_scheduler = std::make_unique<AsyncScheduler>(device, device.GetTransferQueue(),
+                                                              device.GetTransferFamily());
+    }
+    if (device.HasComputeQueue()) {
+        compute_scheduler = std::make_unique<AsyncScheduler>(device, device.GetComputeQueue(),
+                                                             device.GetComputeFamily());
+    }
     AcquireNewChunk();
+    AllocateNewCommandBuffer();
     AllocateNewContext();
     worker_thread = std::thread(&VKScheduler::WorkerThread, this);
 }
@@ -76,6 +92,17 @@ void VKScheduler::WaitWorker() {
     } while (!finished);
 }
 
+bool VKScheduler::PollGpuIdle() {
+    if (gpu_idle_begin) {
+        return true;
+    }
+    if (!IsFree(CurrentTick() - 1)) {
+        return false;
+    }
+    gpu_idle_begin = std::chrono::steady_clock::now();
+    return true;
+}
+
 void VKScheduler::DispatchWork() {
     if (chunk->Empty()) {
         return;
@@ -89,8 +116,9 @@ void VKScheduler::RequestRenderpass(const Framebuffer* framebuffer) {
     const VkRenderPass renderpass = framebuffer->RenderPass();
     const VkFramebuffer framebuffer_handle = framebuffer->Handle();
     const VkExtent2D render_area = framebuffer->RenderArea();
+    // Framebuffers don't have a handle with dynamic rendering, they are told apart by their object
     if (renderpass == state.renderpass && framebuffer_handle == state.framebuffer &&
-        render_area.width == state.render_area.width &&
+        framebuffer == renderpass_framebuffer && render_area.width == state.render_area.width &&
         render_area.height == state.render_area.height) {
         return;
     }
@@ -98,8 +126,43 @@ void VKScheduler::RequestRenderpass(const Framebuffer* framebuffer) {
     state.renderpass = renderpass;
     state.framebuffer = framebuffer_handle;
     state.render_area = render_area;
+    renderpass_framebuffer = framebuffer;
 
-    Record([renderpass, framebuffer_handle, render_area](vk::CommandBuffer cmdbuf) {
+    // Beginning the renderpass is deferred to the first command recorded in it, so clears issued
+    // before any other command can be folded into its load operations.
+    renderpass_pending = true;
+    renderpass_clear_mask = 0;
+    num_renderpass_images = framebuffer->NumImages();
+    renderpass_images = framebuffer->Images();
+    renderpass_image_ranges = framebuffer->ImageRanges();
+    if (profiler->IsEnabled()) {
+        renderpass_label = framebuffer->ProfileLabel();
+    }
+}
+
+void VKScheduler::BeginPendingRenderPass() {
+    renderpass_pending = false;
+
+    const bool has_clears = renderpass_clear_mask != 0;
+    const VkRenderPass renderpass = has_clears ? renderpass_clear : state.renderpass;
+    const u32 num_clear_values = has_clears ? num_renderpass_images : 0;
+    if (profiler->IsEnabled()) {
+        const GPUProfiler::Scope scope = profiler->BeginScope(
+            std::move(renderpass_label), GPUProfiler::RENDER_PASS_TRACK, CurrentTick());
+        renderpass_scope = {.id = scope.id, .pool = scope.pool, .query = scope.query};
+    }
+#ifdef VK_KHR_dynamic_rendering
+    if (device.IsKhrDynamicRenderingSupported()) {
+        BeginDynamicRendering();
+        return;
+    }
+#endif
+    Record([renderpass, framebuffer_handle = state.framebuffer, render_area = state.render_area,
+            clear_values = renderpass_clear_values, num_clear_values,
+            scope = renderpass_scope](vk::CommandBuffer cmdbuf) {
+        if (scope.id != 0) {
+            cmdbuf.WriteTimestamp(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, scope.pool, scope.query);
+        }
         const VkRenderPassBeginInfo renderpass_bi{
             .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
             .pNext = nullptr,
@@ -110,20 +173,105 @@ void VKScheduler::RequestRenderpass(const Framebuffer* framebuffer) {
                     .offset = {.x = 0, .y = 0},
                     .extent = render_area,
                 },
-            .clearValueCount = 0,
-            .pClearValues = nullptr,
+            .clearValueCount = num_clear_values,
+            .pClearValues = num_clear_values != 0 ? clear_values.data() : nullptr,
         };
         cmdbuf.BeginRenderPass(renderpass_bi, VK_SUBPASS_CONTENTS_INLINE);
     });
-    num_renderpass_images = framebuffer->NumImages();
-    renderpass_images = framebuffer->Images();
-    renderpass_image_ranges = framebuffer->ImageRanges();
 }
 
+#ifdef VK_KHR_dynamic_rendering
+void VKScheduler::BeginDynamicRendering() {
+    const Framebuffer* const framebuffer = renderpass_framebuffer;
+    const u32 num_colors = framebuffer->NumColorBuffers();
+    const bool has_depth_attachment = num_colors < framebuffer->NumImages();
+    const VkImageAspectFlags depth_aspect_mask =
+        has_depth_attachment ? framebuffer->ImageRanges()[num_colors].aspectMask : 0;
+    Record([views = framebuffer->ImageViews(), num_colors, depth_aspect_mask,
+            num_layers = framebuffer->NumLayers(), render_area = state.render_area,
+            clear_values = renderpass_clear_values, clear_mask = renderpass_clear_mask,
+            scope = renderpass_scope](vk::CommandBuffer cmdbuf) {
+        if (scope.id != 0) {
+            cmdbuf.WriteTimestamp(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, scope.pool, scope.query);
+        }
+        const auto make_attachment = [&](u32 index, bool clear) {
+            return VkRenderingAttachmentInfoKHR{
+                .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR,
+                .pNext = nullptr,
+                .imageView = views[index],
+                .imageLayout = VK_IMAGE_LAYOUT_GENERAL,
+                .resolveMode = VK_RESOLVE_MODE_NONE,
+                .resolveImageView = VK_NULL_HANDLE,
+                .resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+                .loadOp = clear ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_LOAD,
+                .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+                .clearValue = clear_values[index],
+            };
+        };
+        std::array<VkRenderingAttachmentInfoKHR, NUM_RT> color_attachments;
+        for (u32 index = 0; index < num_colors; ++index) {
+            color_attachments[index] = make_attachment(index, ((clear_mask >> index) & 1) != 0);
+        }
+        const VkRenderingAttachmentInfoKHR depth_attachment =
+            make_attachment(num_colors, (clear_mask & RENDER_PASS_CLEAR_DEPTH_BIT) != 0);
+        const VkRenderingAttachmentInfoKHR stencil_attachment =
+            make_attachment(num_colors, (clear_mask & RENDER_PASS_CLEAR_STENCIL_BIT) != 0);
+        const bool has_depth = (depth_aspect_mask & VK_IMAGE_ASPECT_DEPTH_BIT) != 0;
+        const bool has_stencil = (depth_aspect_mask & VK_IMAGE_ASPECT_STENCIL_BIT) != 0;
+        cmdbuf.BeginRenderingKHR(VkRenderingInfoKHR{
+            .sType = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR,
+            .pNext = nullptr,
+            .flags = 0,
+            .renderArea =
+                {
+                    .offset = {.x = 0, .y = 0},
+                    .extent = render_area,
+                },
+            .layerCount = num_layers,
+            .viewMask = 0,
+            .colorAttachmentCount = num_colors,
+            .pColorAttachments = num_colors != 0 ? color_attachments.data() : nullptr,
+            .pDepthAttachment = has_depth ? &depth_attachment : nullptr,
+            .pStencilAttachment = has_stencil ? &stencil_attachment : nullptr,
+        });
+    });
+}
+#endif
+
 void VKScheduler::RequestOutsideRenderPassOperationContext() {
     EndRenderPass();
 }
 
+bool VKScheduler::IsProfiling() const noexcept {
+    return profiler->IsEnabled();
+}
+
+void VKScheduler::BeginProfileScope(std::string_view label) {
+    if (!profiler->IsEnabled()) {
+        profile_scopes.emplace_back();
+        return;
+    }
+    const GPUProfiler::Scope scope =
+        profiler->BeginScope(std::string(label), GPUProfiler::PASS_TRACK, CurrentTick());
+    profile_scopes.push_back({.id = scope.id, .pool = scope.pool, .query = scope.query});
+    Record([pool = scope.pool, query = scope.query](vk::CommandBuffer cmdbuf) {
+        cmdbuf.WriteTimestamp(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, pool, query);
+    });
+}
+
+void VKScheduler::EndProfileScope() {
+    ASSERT(!profile_scopes.empty());
+    const ProfileScope scope = profile_scopes.back();
+    profile_scopes.pop_back();
+    if (scope.id == 0) {
+        return;
+    }
+    Record([pool = scope.pool, query = scope.query + 1](vk::CommandBuffer cmdbuf) {
+        cmdbuf.WriteTimestamp(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, pool, query);
+    });
+    profiler->EndScope(scope.id, CurrentTick());
+}
+
 void VKScheduler::BindGraphicsPipeline(VkPipeline pipeline) {
     if (state.graphics_pipeline == pipeline) {
         return;
@@ -136,6 +284,7 @@ void VKScheduler::BindGraphicsPipeline(VkPipeline pipeline) {
 
 void VKScheduler::WorkerThread() {
     Common::SetCurrentThreadPriority(Common::ThreadPriority::High);
+    Common::PlaceCurrentThread(Common::PlacedThread::GpuSubmission);
     std::unique_lock lock{mutex};
     do {
         cv.wait(lock, [this] { return !chunk_queue.Empty() || quit; });
@@ -149,60 +298,108 @@ void VKScheduler::WorkerThread() {
     } while (!quit);
 }
 
+void VKScheduler::TickFrame() {
+    command_pool->TickFrame();
+    profiler->Resolve();
+    for (AsyncScheduler* const async_scheduler :
+         {transfer_scheduler.get(), compute_scheduler.get()}) {
+        if (async_scheduler) {
+            async_scheduler->TickFrame();
+        }
+    }
+}
+
 void VKScheduler::SubmitExecution(VkSemaphore semaphore) {
+    if (gpu_idle_begin) {
+        gpu_idle_time += std::chrono::steady_clock::now() - *gpu_idle_begin;
+        gpu_idle_begin.reset();
+    }
     EndPendingOperations();
     InvalidateState();
-    WaitWorker();
 
-    std::unique_lock lock{mutex};
+    const u64 signal_value = master_semaphore->CurrentTick();
+    profiler->OnSubmit(signal_value);
+    master_semaphore->NextTick();
 
-    current_cmdbuf.End();
+    // Work recorded on the async queues is submitted now, this submission waits for it
+    std::array<VkSemaphore, 3> wait_semaphores{master_semaphore->Handle()};
+    std::array<u64, 3> wait_values{signal_value - 1};
+    u32 num_wait_semaphores = 1;
+    for (AsyncScheduler* const async_scheduler :
+         {transfer_scheduler.get(), compute_scheduler.get()}) {
+        const u64 async_value = async_scheduler ? async_scheduler->Submit() : 0;
+        if (async_value != 0) {
+            wait_semaphores[num_wait_semaphores] = async_scheduler->Semaphore();
+            wait_values[num_wait_semaphores] = async_value;
+            ++num_wait_semaphores;
+        }
+    }
 
-    const VkSemaphore timeline_semaphore = master_semaphore->Handle();
-    const u32 num_signal_semaphores = semaphore ? 2U : 1U;
+    // Ending and submitting the command buffer is left to the worker thread, so the caller doesn't
+    // have to wait for the worker to catch up with everything recorded so far.
+    Record([this, semaphore, signal_value, wait_semaphores, wait_values,
+            num_wait_semaphores](vk::CommandBuffer cmdbuf) {
+        cmdbuf.End();
 
-    const u64 signal_value = master_semaphore->CurrentTick();
-    const u64 wait_value = signal_value - 1;
-    const VkPipelineStageFlags wait_stage_mask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        const VkSemaphore timeline_semaphore = master_semaphore->Handle();
+        const u32 num_signal_semaphores = semaphore ? 2U : 1U;
 
-    master_semaphore->NextTick();
+        static constexpr std::array<VkPipelineStageFlags, 3> wait_stage_masks{
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        };
 
-    const std::array signal_values{signal_value, u64(0)};
-    const std::array signal_semaphores{timeline_semaphore, semaphore};
+        const std::array signal_values{signal_value, u64(0)};
+        const std::array signal_semaphores{timeline_semaphore, semaphore};
 
-    const VkTimelineSemaphoreSubmitInfoKHR timeline_si{
-        .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR,
-        .pNext = nullptr,
-        .waitSemaphoreValueCount = 1,
-        .pWaitSemaphoreValues = &wait_value,
-        .signalSemaphoreValueCount = num_signal_semaphores,
-        .pSignalSemaphoreValues = signal_values.data(),
-    };
-    const VkSubmitInfo submit_info{
-        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-        .pNext = &timeline_si,
-        .waitSemaphoreCount = 1,
-        .pWaitSemaphores = &timeline_semaphore,
-        .pWaitDstStageMask = &wait_stage_mask,
-        .commandBufferCount = 1,
-        .pCommandBuffers = current_cmdbuf.address(),
-        .signalSemaphoreCount = num_signal_semaphores,
-        .pSignalSemaphores = signal_semaphores.data(),
-    };
-    switch (const VkResult result = device.GetGraphicsQueue().Submit(submit_info)) {
-    case VK_SUCCESS:
-        break;
-    case VK_ERROR_DEVICE_LOST:
-        device.ReportLoss();
-        [[fallthrough]];
-    default:
-        vk::Check(result);
+        const VkTimelineSemaphoreSubmitInfoKHR timeline_si{
+            .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR,
+            .pNext = nullptr,
+            .waitSemaphoreValueCount = num_wait_semaphores,
+            .pWaitSemaphoreValues = wait_values.data(),
+            .signalSemaphoreValueCount = num_signal_semaphores,
+            .pSignalSemaphoreValues = signal_values.data(),
+        };
+        const VkSubmitInfo submit_info{
+            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+            .pNext = &timeline_si,
+            .waitSemaphoreCount = num_wait_semaphores,
+            .pWaitSemaphores = wait_semaphores.data(),
+            .pWaitDstStageMask = wait_stage_masks.data(),
+            .commandBufferCount = 1,
+            .pCommandBuffers = cmdbuf.address(),
+            .signalSemaphoreCount = num_signal_semaphores,
+            .pSignalSemaphores = signal_semaphores.data(),
+        };
+        switch (const VkResult result = device.GetGraphicsQueue().Submit(submit_info)) {
+        case VK_SUCCESS:
+            break;
+        case VK_ERROR_DEVICE_LOST:
+            device.ReportLoss();
+            [[fallthrough]];
+        default:
+            vk::Check(result);
+        }
+        AllocateNewCommandBuffer();
+    });
+    if (semaphore) {
+        // The semaphore is waited on by presentation right after, so it has to be submitted now.
+        WaitWorker();
+    } else {
+        // The submit has to be the last command of its chunk, the next ones use the new buffer.
+        DispatchWork();
     }
 }
 
 void VKScheduler::AllocateNewContext() {
-    std::unique_lock lock{mutex};
+    // Enable counters once again. These are disabled when a command buffer is finished.
+    if (query_cache) {
+        query_cache->UpdateCounters();
+    }
+}
 
+void VKScheduler::AllocateNewCommandBuffer() {
     current_cmdbuf = vk::CommandBuffer(command_pool->Commit(), device.GetDispatchLoader());
     current_cmdbuf.Begin({
         .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
@@ -210,11 +407,6 @@ void VKScheduler::AllocateNewContext() {
         .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
         .pInheritanceInfo = nullptr,
     });
-
-    // Enable counters once again. These are disabled when a command buffer is finished.
-    if (query_cache) {
-        query_cache->UpdateCounters();
-    }
 }
 
 void VKScheduler::InvalidateState() {
@@ -231,8 +423,20 @@ void VKScheduler::EndRenderPass() {
     if (!state.renderpass) {
         return;
     }
+    if (renderpass_pending) {
+        if (renderpass_clear_mask == 0) {
+            // Nothing was recorded in this renderpass, skip it entirely
+            renderpass_pending = false;
+            state.renderpass = nullptr;
+            renderpass_framebuffer = nullptr;
+            num_renderpass_images = 0;
+            return;
+        }
+        BeginPendingRenderPass();
+    }
     Record([num_images = num_renderpass_images, images = renderpass_images,
-            ranges = renderpass_image_ranges](vk::CommandBuffer cmdbuf) {
+            ranges = renderpass_image_ranges, scope = renderpass_scope,
+            is_dynamic = device.IsKhrDynamicRenderingSupported()](vk::CommandBuffer cmdbuf) {
         std::array<VkImageMemoryBarrier, 9> barriers;
         for (size_t i = 0; i < num_images; ++i) {
             barriers[i] = VkImageMemoryBarrier{
@@ -253,14 +457,29 @@ void VKScheduler::EndRenderPass() {
                 .subresourceRange = ranges[i],
             };
         }
-        cmdbuf.EndRenderPass();
+        if (is_dynamic) {
+#ifdef VK_KHR_dynamic_rendering
+            cmdbuf.EndRenderingKHR();
+#endif
+        } else {
+            cmdbuf.EndRenderPass();
+        }
         cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
                                    VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
                                    VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
                                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, nullptr, nullptr,
                                vk::Span(barriers.data(), num_images));
+        if (scope.id != 0) {
+            cmdbuf.WriteTimestamp(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, scope.pool,
+                                  scope.query + 1);
+        }
     });
+    if (renderpass_scope.id != 0) {
+        profiler->EndScope(renderpass_scope.id, CurrentTick());
+        renderpass_scope = {};
+    }
     state.renderpass = nullptr;
+    renderpass_framebuffer = nullptr;
     num_renderpass_images = 0;
 }
 
@@ -5,12 +5,17 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <stack>
+#include <string>
+#include <string_view>
 #include <thread>
 #include <utility>
+#include <vector>
 #include "common/alignment.h"
 #include "common/common_types.h"
 #include "common/threadsafe_queue.h"
@@ -22,7 +27,9 @@ namespace Vulkan {
 class CommandPool;
 class Device;
 class Framebuffer;
+class GPUProfiler;
 class StateTracker;
+class AsyncScheduler;
 class VKQueryCache;
 
 /// The scheduler abstracts command buffer and fence management with an interface that's able to do
@@ -48,6 +55,27 @@ public:
     /// Requests to begin a renderpass.
     void RequestRenderpass(const Framebuffer* framebuffer);
 
+    /// Returns true when the requested renderpass hasn't begun yet, no command was recorded in it.
+    [[nodiscard]] bool IsRenderPassPending() const noexcept {
+        return renderpass_pending;
+    }
+
+    /// Returns the attachments the pending renderpass clears on load.
+    [[nodiscard]] u32 RenderPassClearMask() const noexcept {
+        return renderpass_clear_mask;
+    }
+
+    /// Returns the value an attachment of the pending renderpass is cleared to on load.
+    [[nodiscard]] VkClearValue& RenderPassClearValue(u32 attachment) noexcept {
+        return renderpass_clear_values[attachment];
+    }
+
+    /// Begins the pending renderpass with a compatible one that clears attachments on load.
+    void SetRenderPassClear(VkRenderPass clear_renderpass, u32 clear_mask) noexcept {
+        renderpass_clear = clear_renderpass;
+        renderpass_clear_mask = clear_mask;
+    }
+
     /// Requests the current executino context to be able to execute operations only allowed outside
     /// of a renderpass.
     void RequestOutsideRenderPassOperationContext();
@@ -58,6 +86,16 @@ public:
     /// Invalidates current command buffer state except for render passes
     void InvalidateState();
 
+    /// Returns true while the GPU time of passes is measured for the trace recorder.
+    [[nodiscard]] bool IsProfiling() const noexcept;
+
+    /// Measures the GPU time of the commands recorded until the matching EndProfileScope, while
+    /// the trace recorder is recording. Render passes are measured on their own.
+    void BeginProfileScope(std::string_view label);
+
+    /// Ends the innermost scope begun with BeginProfileScope.
+    void EndProfileScope();
+
     /// Assigns the query cache.
     void SetQueryCache(VKQueryCache& query_cache_) {
         query_cache = &query_cache_;
@@ -66,6 +104,9 @@ public:
     /// Send work to a separate thread.
     template <typename T>
     void Record(T&& command) {
+        if (renderpass_pending) {
+            BeginPendingRenderPass();
+        }
         if (chunk->Record(command)) {
             return;
         }
@@ -88,11 +129,33 @@ public:
         master_semaphore->Wait(tick);
     }
 
+    /// Returns true when the GPU has executed every submission, the GPU is then accounted as idle
+    /// until the next submission.
+    bool PollGpuIdle();
+
+    /// Signals a frame boundary, command buffers of the next frame come from another pool.
+    void TickFrame();
+
+    /// Returns the host time the GPU was seen idle since the last call.
+    [[nodiscard]] std::chrono::nanoseconds TakeGpuIdleTime() noexcept {
+        return std::exchange(gpu_idle_time, std::chrono::nanoseconds{});
+    }
+
     /// Returns the master timeline semaphore.
     [[nodiscard]] MasterSemaphore& GetMasterSemaphore() const noexcept {
         return *master_semaphore;
     }
 
+    /// Returns the scheduler of the dedicated transfer queue, null when uploads can't use it.
+    [[nodiscard]] AsyncScheduler* GetTransferScheduler() const noexcept {
+        return transfer_scheduler.get();
+    }
+
+    /// Returns the scheduler of the dedicated compute queue, null when decoding can't use it.
+    [[nodiscard]] AsyncScheduler* GetComputeScheduler() const noexcept {
+        return compute_scheduler.get();
+    }
+
 private:
     class Command {
     public:
@@ -166,6 +229,13 @@ private:
         alignas(std::max_align_t) std::array<u8, 0x8000> data{};
     };
 
+    /// Scope measured by the profiler, an id of zero when it isn't measured
+    struct ProfileScope {
+        u64 id = 0;
+        VkQueryPool pool = nullptr;
+        u32 query = 0;
+    };
+
     struct State {
         VkRenderPass renderpass = nullptr;
         VkFramebuffer framebuffer = nullptr;
@@ -179,8 +249,18 @@ private:
 
     void AllocateNewContext();
 
+    /// Allocates and begins a new command buffer. Called from the worker thread after a submit.
+    void AllocateNewCommandBuffer();
+
     void EndPendingOperations();
 
+    void BeginPendingRenderPass();
+
+#ifdef VK_KHR_dynamic_rendering
+    /// Begins the pending renderpass with VK_KHR_dynamic_rendering, from its framebuffer views
+    void BeginDynamicRendering();
+#endif
+
     void EndRenderPass();
 
     void AcquireNewChunk();
@@ -190,6 +270,9 @@ private:
 
     std::unique_ptr<MasterSemaphore> master_semaphore;
     std::unique_ptr<CommandPool> command_pool;
+    std::unique_ptr<AsyncScheduler> transfer_scheduler;
+    std::unique_ptr<AsyncScheduler> compute_scheduler;
+    std::unique_ptr<GPUProfiler> profiler;
 
     VKQueryCache* query_cache = nullptr;
 
@@ -200,10 +283,23 @@ private:
 
     State state;
 
+    const Framebuffer* renderpass_framebuffer = nullptr;
     u32 num_renderpass_images = 0;
     std::array<VkImage, 9> renderpass_images{};
     std::array<VkImageSubresourceRange, 9> renderpass_image_ranges{};
 
+    bool renderpass_pending = false;
+    u32 renderpass_clear_mask = 0;
+    VkRenderPass renderpass_clear = nullptr;
+    std::array<VkClearValue, 9> renderpass_clear_values{};
+
+    std::string renderpass_label;
+    ProfileScope renderpass_scope{};
+    std::vector<ProfileScope> profile_scopes;
+
+    std::optional<std::chrono::steady_clock::time_point> gpu_idle_begin;
+    std::chrono::nanoseconds gpu_idle_time{};
+
     Common::SPSCQueue<std::unique_ptr<CommandChunk>> chunk_queue;
     Common::SPSCQueue<std::unique_ptr<CommandChunk>> chunk_reserve;
     std::mutex mutex;
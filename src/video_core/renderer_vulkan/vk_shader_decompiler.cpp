@@ -1723,6 +1723,8 @@ private:
 
     Id GetCoordinates(Operation operation, Type type) {
         std::vector<Id> coords;
+        // One more for the array coordinate
+        coords.reserve(operation.GetOperandsCount() + 1);
         for (std::size_t i = 0; i < operation.GetOperandsCount(); ++i) {
             coords.push_back(As(Visit(operation[i]), type));
         }
@@ -3154,6 +3156,8 @@ ShaderEntries GenerateShaderEntries(const VideoCommon::Shader::ShaderIR& ir) {
     entries.clip_distances = ir.GetClipDistances();
     entries.shader_length = ir.GetLength();
     entries.uses_warps = ir.UsesWarps();
+    entries.uses_frag_coord = ir.GetInputAttributes().contains(Attribute::Index::Position) ||
+                              ir.HasPhysicalAttributes();
     return entries;
 }
 
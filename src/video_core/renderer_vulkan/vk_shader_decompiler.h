@@ -63,6 +63,7 @@ struct ShaderEntries {
     std::size_t shader_length{};
     u32 enabled_uniform_buffers{};
     bool uses_warps{};
+    bool uses_frag_coord{};
 };
 
 struct Specialization final {
@@ -0,0 +1,89 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <utility>
+
+#ifdef HAS_SPIRV_OPT
+#include <spirv-tools/optimizer.hpp>
+#endif
+
+#include "common/cityhash.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "video_core/renderer_vulkan/vk_pipeline_disk_cache.h"
+#include "video_core/renderer_vulkan/vk_spirv_optimizer.h"
+
+namespace Vulkan {
+
+SPIRVOptimizer::SPIRVOptimizer(PipelineDiskCache& disk_cache_) : disk_cache{disk_cache_} {}
+
+SPIRVOptimizer::~SPIRVOptimizer() = default;
+
+bool SPIRVOptimizer::IsEnabled() {
+#ifdef HAS_SPIRV_OPT
+    return Settings::values.use_spirv_optimizer.GetValue();
+#else
+    return false;
+#endif
+}
+
+void SPIRVOptimizer::LoadDiskResources() {
+    if (!IsEnabled()) {
+        if (Settings::values.use_spirv_optimizer.GetValue()) {
+            LOG_WARNING(Render_Vulkan, "yuzu was built without SPIRV-Tools, shaders won't be "
+                                       "optimized");
+        }
+        return;
+    }
+    std::unordered_map<u64, std::vector<u32>> modules = disk_cache.LoadOptimizedShaders();
+    LOG_INFO(Render_Vulkan, "Loaded {} optimized shaders", modules.size());
+
+    std::scoped_lock lock{mutex};
+    optimized_modules = std::move(modules);
+}
+
+void SPIRVOptimizer::Optimize([[maybe_unused]] std::vector<u32>& code) const {
+#ifdef HAS_SPIRV_OPT
+    if (!IsEnabled()) {
+        return;
+    }
+    const u64 hash = Common::CityHash64(reinterpret_cast<const char*>(code.data()),
+                                        code.size() * sizeof(u32));
+    {
+        std::scoped_lock lock{mutex};
+        if (const auto it = optimized_modules.find(hash); it != optimized_modules.end()) {
+            code = it->second;
+            return;
+        }
+    }
+
+    // The decompiler emits SPIR-V 1.3, the version of Vulkan 1.1
+    spvtools::Optimizer optimizer(SPV_ENV_VULKAN_1_1);
+    optimizer.SetMessageConsumer([hash](spv_message_level_t level, const char*,
+                                        const spv_position_t&, const char* message) {
+        if (level <= SPV_MSG_ERROR) {
+            LOG_ERROR(Render_Vulkan, "Shader 0x{:016X}: {}", hash, message);
+        } else {
+            LOG_DEBUG(Render_Vulkan, "Shader 0x{:016X}: {}", hash, message);
+        }
+    });
+    optimizer.RegisterPerformancePasses();
+
+    // Modules that fail to optimize are cached as is, so they're not retried
+    std::vector<u32> optimized;
+    if (!optimizer.Run(code.data(), code.size(), &optimized)) {
+        LOG_WARNING(Render_Vulkan, "Failed to optimize shader 0x{:016X}, using it as is", hash);
+        optimized = code;
+    }
+
+    std::scoped_lock lock{mutex};
+    const auto [it, is_new] = optimized_modules.try_emplace(hash, std::move(optimized));
+    if (is_new) {
+        disk_cache.SaveOptimizedShader(hash, it->second);
+    }
+    code = it->second;
+#endif
+}
+
+} // namespace Vulkan
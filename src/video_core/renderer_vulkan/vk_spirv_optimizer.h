@@ -0,0 +1,44 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Vulkan {
+
+class PipelineDiskCache;
+
+/**
+ * Runs the SPIRV-Tools performance passes over the modules emitted by the shader decompiler.
+ * Optimized modules are keyed by the hash of the module they were made from and kept in the disk
+ * cache, so each module of a title is only optimized once.
+ */
+class SPIRVOptimizer {
+public:
+    explicit SPIRVOptimizer(PipelineDiskCache& disk_cache_);
+    ~SPIRVOptimizer();
+
+    /// Returns true when yuzu was built with SPIRV-Tools and the optimizer is enabled
+    [[nodiscard]] static bool IsEnabled();
+
+    /// Loads the modules optimized by previous sessions of the title bound to the disk cache
+    void LoadDiskResources();
+
+    /// Replaces the module with its optimized version, it is kept as is when optimization fails.
+    /// Thread-safe, called from the asynchronous shader workers.
+    void Optimize(std::vector<u32>& code) const;
+
+private:
+    PipelineDiskCache& disk_cache;
+
+    mutable std::mutex mutex;
+    mutable std::unordered_map<u64, std::vector<u32>> optimized_modules;
+};
+
+} // namespace Vulkan
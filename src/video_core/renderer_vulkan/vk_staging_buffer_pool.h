@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <climits>
 #include <vector>
 
@@ -21,6 +22,8 @@ struct StagingBufferRef {
     VkBuffer buffer;
     VkDeviceSize offset;
     std::span<u8> mapped_span;
+    MemoryUsage usage;
+    u32 log2_level;
 };
 
 class StagingBufferPool {
@@ -31,10 +34,26 @@ public:
                                VKScheduler& scheduler);
     ~StagingBufferPool();
 
-    StagingBufferRef Request(size_t size, MemoryUsage usage);
+    /// Requests a staging buffer, deferred buffers are not reused until they are freed
+    StagingBufferRef Request(size_t size, MemoryUsage usage, bool deferred = false);
+
+    /// Returns a deferred buffer to the pool, it is reused once the current tick is completed
+    void FreeDeferred(const StagingBufferRef& ref);
 
     void TickFrame();
 
+    /// Returns true when the stream buffer lives in device local memory, as it does on devices
+    /// exposing their memory to the host (resizable BAR)
+    [[nodiscard]] bool IsStreamBufferDeviceLocal() const noexcept {
+        return is_stream_device_local;
+    }
+
+    /// Returns the host memory held by the stream buffer and the pooled staging buffers, can be
+    /// called from any thread
+    [[nodiscard]] u64 GetUsedMemory() const noexcept {
+        return used_memory.load(std::memory_order_relaxed);
+    }
+
 private:
     struct StreamBufferCommit {
         size_t upper_bound;
@@ -45,13 +64,18 @@ private:
         vk::Buffer buffer;
         MemoryCommit commit;
         std::span<u8> mapped_span;
+        MemoryUsage usage;
+        u32 log2_level;
         u64 tick = 0;
+        bool deferred = false;
 
         StagingBufferRef Ref() const noexcept {
             return {
                 .buffer = *buffer,
                 .offset = 0,
                 .mapped_span = mapped_span,
+                .usage = usage,
+                .log2_level = log2_level,
             };
         }
     };
@@ -69,11 +93,12 @@ private:
 
     bool AreRegionsActive(size_t region_begin, size_t region_end) const;
 
-    StagingBufferRef GetStagingBuffer(size_t size, MemoryUsage usage);
+    StagingBufferRef GetStagingBuffer(size_t size, MemoryUsage usage, bool deferred);
 
-    std::optional<StagingBufferRef> TryGetReservedBuffer(size_t size, MemoryUsage usage);
+    std::optional<StagingBufferRef> TryGetReservedBuffer(size_t size, MemoryUsage usage,
+                                                         bool deferred);
 
-    StagingBufferRef CreateStagingBuffer(size_t size, MemoryUsage usage);
+    StagingBufferRef CreateStagingBuffer(size_t size, MemoryUsage usage, bool deferred);
 
     StagingBuffersCache& GetCache(MemoryUsage usage);
 
@@ -88,6 +113,7 @@ private:
     vk::Buffer stream_buffer;
     vk::DeviceMemory stream_memory;
     u8* stream_pointer = nullptr;
+    bool is_stream_device_local = false;
 
     size_t iterator = 0;
     size_t used_iterator = 0;
@@ -100,6 +126,7 @@ private:
 
     size_t current_delete_level = 0;
     u64 buffer_index = 0;
+    std::atomic<u64> used_memory{0};
 };
 
 } // namespace Vulkan
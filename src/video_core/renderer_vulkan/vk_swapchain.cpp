@@ -9,6 +9,7 @@
 
 #include "common/assert.h"
 #include "common/logging/log.h"
+#include "common/settings.h"
 #include "core/core.h"
 #include "core/frontend/framebuffer_layout.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
@@ -35,10 +36,36 @@ VkSurfaceFormatKHR ChooseSwapSurfaceFormat(vk::Span<VkSurfaceFormatKHR> formats,
     return found != formats.end() ? *found : formats[0];
 }
 
-VkPresentModeKHR ChooseSwapPresentMode(vk::Span<VkPresentModeKHR> modes) {
-    // Mailbox doesn't lock the application like fifo (vsync), prefer it
-    const auto found = std::find(modes.begin(), modes.end(), VK_PRESENT_MODE_MAILBOX_KHR);
-    return found != modes.end() ? *found : VK_PRESENT_MODE_FIFO_KHR;
+VkPresentModeKHR ToVkPresentMode(Settings::PresentMode mode) {
+    switch (mode) {
+    case Settings::PresentMode::Automatic:
+    case Settings::PresentMode::Mailbox:
+        // Mailbox doesn't lock the application like fifo (vsync), prefer it
+        return VK_PRESENT_MODE_MAILBOX_KHR;
+    case Settings::PresentMode::Fifo:
+        return VK_PRESENT_MODE_FIFO_KHR;
+    case Settings::PresentMode::FifoRelaxed:
+        return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+    case Settings::PresentMode::Immediate:
+        return VK_PRESENT_MODE_IMMEDIATE_KHR;
+    }
+    UNREACHABLE_MSG("Invalid present mode={}", static_cast<u32>(mode));
+    return VK_PRESENT_MODE_FIFO_KHR;
+}
+
+VkPresentModeKHR ChooseSwapPresentMode(vk::Span<VkPresentModeKHR> modes,
+                                       Settings::PresentMode requested_mode) {
+    // FIFO is the only mode every surface is required to support
+    const VkPresentModeKHR requested = ToVkPresentMode(requested_mode);
+    const auto found = std::find(modes.begin(), modes.end(), requested);
+    if (found != modes.end()) {
+        return *found;
+    }
+    if (requested_mode != Settings::PresentMode::Automatic) {
+        LOG_WARNING(Render_Vulkan, "Present mode {} is not supported, falling back to FIFO",
+                    static_cast<u32>(requested_mode));
+    }
+    return VK_PRESENT_MODE_FIFO_KHR;
 }
 
 VkExtent2D ChooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities, u32 width, u32 height) {
@@ -132,7 +159,8 @@ bool VKSwapchain::Present(VkSemaphore render_semaphore) {
 
 bool VKSwapchain::HasFramebufferChanged(const Layout::FramebufferLayout& framebuffer) const {
     // TODO(Rodrigo): Handle framebuffer pixel format changes
-    return framebuffer.width != current_width || framebuffer.height != current_height;
+    return framebuffer.width != current_width || framebuffer.height != current_height ||
+           Settings::values.present_mode.GetValue() != current_present_mode;
 }
 
 void VKSwapchain::CreateSwapchain(const VkSurfaceCapabilitiesKHR& capabilities, u32 width,
@@ -142,7 +170,9 @@ void VKSwapchain::CreateSwapchain(const VkSurfaceCapabilitiesKHR& capabilities,
     const auto present_modes{physical_device.GetSurfacePresentModesKHR(surface)};
 
     const VkSurfaceFormatKHR surface_format{ChooseSwapSurfaceFormat(formats, srgb)};
-    const VkPresentModeKHR present_mode{ChooseSwapPresentMode(present_modes)};
+    const Settings::PresentMode requested_present_mode = Settings::values.present_mode.GetValue();
+    const VkPresentModeKHR present_mode{
+        ChooseSwapPresentMode(present_modes, requested_present_mode)};
 
     u32 requested_image_count{capabilities.minImageCount + 1};
     if (capabilities.maxImageCount > 0 && requested_image_count > capabilities.maxImageCount) {
@@ -189,6 +219,7 @@ void VKSwapchain::CreateSwapchain(const VkSurfaceCapabilitiesKHR& capabilities,
     current_width = extent.width;
     current_height = extent.height;
     current_srgb = srgb;
+    current_present_mode = requested_present_mode;
 
     images = swapchain.GetImages();
     image_count = static_cast<u32>(images.size());
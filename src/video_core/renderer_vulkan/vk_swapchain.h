@@ -13,6 +13,10 @@ namespace Layout {
 struct FramebufferLayout;
 }
 
+namespace Settings {
+enum class PresentMode : u32;
+}
+
 namespace Vulkan {
 
 class Device;
@@ -34,7 +38,7 @@ public:
     /// recreated. Takes responsability for the ownership of fence.
     bool Present(VkSemaphore render_semaphore);
 
-    /// Returns true when the framebuffer layout has changed.
+    /// Returns true when the framebuffer layout or the requested present mode has changed.
     bool HasFramebufferChanged(const Layout::FramebufferLayout& framebuffer) const;
 
     VkExtent2D GetSize() const {
@@ -95,6 +99,7 @@ private:
     u32 current_width{};
     u32 current_height{};
     bool current_srgb{};
+    Settings::PresentMode current_present_mode{};
 };
 
 } // namespace Vulkan
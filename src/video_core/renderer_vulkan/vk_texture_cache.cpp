@@ -18,6 +18,7 @@
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_staging_buffer_pool.h"
 #include "video_core/renderer_vulkan/vk_texture_cache.h"
+#include "video_core/renderer_vulkan/vk_async_scheduler.h"
 #include "video_core/vulkan_common/vulkan_device.h"
 #include "video_core/vulkan_common/vulkan_memory_allocator.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
@@ -32,9 +33,13 @@ using VideoCommon::ImageInfo;
 using VideoCommon::ImageType;
 using VideoCommon::SubresourceRange;
 using VideoCore::Surface::IsPixelFormatASTC;
+using VideoCore::Surface::IsPixelFormatBC1To5;
 
 namespace {
 
+// Smaller uploads aren't worth the ownership transfer they need on the transfer queue
+constexpr size_t MIN_TRANSFER_QUEUE_UPLOAD_SIZE = 64 * 1024;
+
 constexpr std::array ATTACHMENT_REFERENCES{
     VkAttachmentReference{0, VK_IMAGE_LAYOUT_GENERAL},
     VkAttachmentReference{1, VK_IMAGE_LAYOUT_GENERAL},
@@ -227,22 +232,67 @@ constexpr VkBorderColor ConvertBorderColor(const std::array<float, 4>& color) {
 }
 
 [[nodiscard]] VkAttachmentDescription AttachmentDescription(const Device& device,
-                                                            const ImageView* image_view) {
+                                                            PixelFormat pixel_format,
+                                                            VkSampleCountFlagBits samples,
+                                                            bool clear = false,
+                                                            bool clear_stencil = false) {
     using MaxwellToVK::SurfaceFormat;
-    const PixelFormat pixel_format = image_view->format;
     return VkAttachmentDescription{
         .flags = VK_ATTACHMENT_DESCRIPTION_MAY_ALIAS_BIT,
         .format = SurfaceFormat(device, FormatType::Optimal, true, pixel_format).format,
-        .samples = image_view->Samples(),
-        .loadOp = VK_ATTACHMENT_LOAD_OP_LOAD,
+        .samples = samples,
+        .loadOp = clear ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_LOAD,
         .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
-        .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_LOAD,
+        .stencilLoadOp = clear_stencil ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_LOAD,
         .stencilStoreOp = VK_ATTACHMENT_STORE_OP_STORE,
         .initialLayout = VK_IMAGE_LAYOUT_GENERAL,
         .finalLayout = VK_IMAGE_LAYOUT_GENERAL,
     };
 }
 
+[[nodiscard]] vk::RenderPass CreateRenderPass(const Device& device, const RenderPassKey& key,
+                                              u32 clear_mask) {
+    std::vector<VkAttachmentDescription> descriptions;
+    for (const PixelFormat format : key.color_formats) {
+        if (format != PixelFormat::Invalid) {
+            const bool clear = ((clear_mask >> descriptions.size()) & 1) != 0;
+            descriptions.push_back(AttachmentDescription(device, format, key.samples, clear));
+        }
+    }
+    const size_t num_colors = descriptions.size();
+    const VkAttachmentReference* depth_attachment = nullptr;
+    if (key.depth_format != PixelFormat::Invalid) {
+        const bool clear_depth = (clear_mask & RENDER_PASS_CLEAR_DEPTH_BIT) != 0;
+        const bool clear_stencil = (clear_mask & RENDER_PASS_CLEAR_STENCIL_BIT) != 0;
+        descriptions.push_back(AttachmentDescription(device, key.depth_format, key.samples,
+                                                     clear_depth, clear_stencil));
+        depth_attachment = &ATTACHMENT_REFERENCES[num_colors];
+    }
+    const VkSubpassDescription subpass{
+        .flags = 0,
+        .pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
+        .inputAttachmentCount = 0,
+        .pInputAttachments = nullptr,
+        .colorAttachmentCount = static_cast<u32>(num_colors),
+        .pColorAttachments = num_colors != 0 ? ATTACHMENT_REFERENCES.data() : nullptr,
+        .pResolveAttachments = nullptr,
+        .pDepthStencilAttachment = depth_attachment,
+        .preserveAttachmentCount = 0,
+        .pPreserveAttachments = nullptr,
+    };
+    return device.GetLogical().CreateRenderPass(VkRenderPassCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .attachmentCount = static_cast<u32>(descriptions.size()),
+        .pAttachments = descriptions.data(),
+        .subpassCount = 1,
+        .pSubpasses = &subpass,
+        .dependencyCount = 0,
+        .pDependencies = nullptr,
+    });
+}
+
 [[nodiscard]] VkComponentSwizzle ComponentSwizzle(SwizzleSource swizzle) {
     switch (swizzle) {
     case SwizzleSource::Zero:
@@ -491,6 +541,64 @@ void CopyBufferToImage(vk::CommandBuffer cmdbuf, VkBuffer src_buffer, VkImage im
                            write_barrier);
 }
 
+void TransferCopyBufferToImage(AsyncScheduler& transfer_scheduler, VKScheduler& scheduler,
+                               VkBuffer src_buffer, VkImage image, VkImageAspectFlags aspect_mask,
+                               std::span<const VkBufferImageCopy> copies) {
+    const VkImageSubresourceRange subresource_range{
+        .aspectMask = aspect_mask,
+        .baseMipLevel = 0,
+        .levelCount = VK_REMAINING_MIP_LEVELS,
+        .baseArrayLayer = 0,
+        .layerCount = VK_REMAINING_ARRAY_LAYERS,
+    };
+    const VkImageMemoryBarrier read_barrier{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .pNext = nullptr,
+        .srcAccessMask = 0,
+        .dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        .newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .image = image,
+        .subresourceRange = subresource_range,
+    };
+    // The image is released to the graphics queue, which acquires it with the same barrier
+    const VkImageMemoryBarrier release_barrier{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .pNext = nullptr,
+        .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask = 0,
+        .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+        .srcQueueFamilyIndex = transfer_scheduler.QueueFamily(),
+        .dstQueueFamilyIndex = transfer_scheduler.GraphicsFamily(),
+        .image = image,
+        .subresourceRange = subresource_range,
+    };
+    VkImageMemoryBarrier acquire_barrier = release_barrier;
+    acquire_barrier.srcAccessMask = 0;
+    acquire_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT |
+                                    VK_ACCESS_COLOR_ATTACHMENT_READ_BIT |
+                                    VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                                    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                                    VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    transfer_scheduler.Record([&](vk::CommandBuffer cmdbuf) {
+        cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                               0, read_barrier);
+        cmdbuf.CopyBufferToImage(src_buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, copies);
+        cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT,
+                               VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, release_barrier);
+    });
+    scheduler.RequestOutsideRenderPassOperationContext();
+    scheduler.Record([acquire_barrier](vk::CommandBuffer cmdbuf) {
+        cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                               VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, acquire_barrier);
+    });
+}
+
 [[nodiscard]] VkImageBlit MakeImageBlit(const Region2D& dst_region, const Region2D& src_region,
                                         const VkImageSubresourceLayers& dst_layers,
                                         const VkImageSubresourceLayers& src_layers) {
@@ -554,6 +662,105 @@ void CopyBufferToImage(vk::CommandBuffer cmdbuf, VkBuffer src_buffer, VkImage im
     };
 }
 
+void BlitScale(VKScheduler& scheduler, VkImage dst_image, const VideoCommon::Extent2D& dst_size,
+               VkImage src_image, const VideoCommon::Extent2D& src_size,
+               VkImageAspectFlags aspect_mask, VkFilter filter, bool is_src_initialized) {
+    const VkImageSubresourceLayers layers{
+        .aspectMask = aspect_mask,
+        .mipLevel = 0,
+        .baseArrayLayer = 0,
+        .layerCount = 1,
+    };
+    const VkImageBlit blit = MakeImageBlit(
+        Region2D{
+            .start = {0, 0},
+            .end = {static_cast<s32>(dst_size.width), static_cast<s32>(dst_size.height)},
+        },
+        Region2D{
+            .start = {0, 0},
+            .end = {static_cast<s32>(src_size.width), static_cast<s32>(src_size.height)},
+        },
+        layers, layers);
+    scheduler.RequestOutsideRenderPassOperationContext();
+    scheduler.Record([dst_image, src_image, aspect_mask, filter, is_src_initialized,
+                      blit](vk::CommandBuffer cmdbuf) {
+        const VkImageSubresourceRange range{
+            .aspectMask = aspect_mask,
+            .baseMipLevel = 0,
+            .levelCount = VK_REMAINING_MIP_LEVELS,
+            .baseArrayLayer = 0,
+            .layerCount = VK_REMAINING_ARRAY_LAYERS,
+        };
+        // The destination is fully overwritten, its previous contents can be discarded
+        const VkImageMemoryBarrier dst_write_barrier{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .pNext = nullptr,
+            .srcAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            .newLayout = is_src_initialized ? VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+                                            : VK_IMAGE_LAYOUT_GENERAL,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = dst_image,
+            .subresourceRange = range,
+        };
+        if (!is_src_initialized) {
+            // Nothing to copy, leave the destination in the layout used by the rest of the cache
+            cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                                   VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, dst_write_barrier);
+            return;
+        }
+        const std::array read_barriers{
+            VkImageMemoryBarrier{
+                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                .pNext = nullptr,
+                .srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT,
+                .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT,
+                .oldLayout = VK_IMAGE_LAYOUT_GENERAL,
+                .newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .image = src_image,
+                .subresourceRange = range,
+            },
+            dst_write_barrier,
+        };
+        const std::array write_barriers{
+            VkImageMemoryBarrier{
+                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                .pNext = nullptr,
+                .srcAccessMask = 0,
+                .dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT,
+                .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .image = src_image,
+                .subresourceRange = range,
+            },
+            VkImageMemoryBarrier{
+                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                .pNext = nullptr,
+                .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                .dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT,
+                .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .image = dst_image,
+                .subresourceRange = range,
+            },
+        };
+        cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                               0, nullptr, nullptr, read_barriers);
+        cmdbuf.BlitImage(src_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dst_image,
+                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, blit, filter);
+        cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                               0, nullptr, nullptr, write_barriers);
+    });
+}
+
 [[nodiscard]] bool IsFormatFlipped(PixelFormat format) {
     switch (format) {
     case PixelFormat::A1B5G5R5_UNORM:
@@ -589,6 +796,45 @@ struct RangedBarrierRange {
 
 } // Anonymous namespace
 
+RenderingFormats::RenderingFormats(const Device& device, [[maybe_unused]] const RenderPassKey& key)
+    : is_enabled{device.IsKhrDynamicRenderingSupported()} {
+#ifdef VK_KHR_dynamic_rendering
+    using MaxwellToVK::SurfaceFormat;
+    if (!is_enabled) {
+        return;
+    }
+    u32 num_colors = 0;
+    for (const PixelFormat format : key.color_formats) {
+        if (format != PixelFormat::Invalid) {
+            color_formats[num_colors++] =
+                SurfaceFormat(device, FormatType::Optimal, true, format).format;
+        }
+    }
+    VkFormat depth_format = VK_FORMAT_UNDEFINED;
+    VkFormat stencil_format = VK_FORMAT_UNDEFINED;
+    if (key.depth_format != PixelFormat::Invalid) {
+        const VkFormat format =
+            SurfaceFormat(device, FormatType::Optimal, true, key.depth_format).format;
+        const VkImageAspectFlags aspect_mask = ImageAspectMask(key.depth_format);
+        if ((aspect_mask & VK_IMAGE_ASPECT_DEPTH_BIT) != 0) {
+            depth_format = format;
+        }
+        if ((aspect_mask & VK_IMAGE_ASPECT_STENCIL_BIT) != 0) {
+            stencil_format = format;
+        }
+    }
+    create_info = VkPipelineRenderingCreateInfoKHR{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR,
+        .pNext = nullptr,
+        .viewMask = 0,
+        .colorAttachmentCount = num_colors,
+        .pColorAttachmentFormats = color_formats.data(),
+        .depthAttachmentFormat = depth_format,
+        .stencilAttachmentFormat = stencil_format,
+    };
+#endif
+}
+
 void TextureCacheRuntime::Finish() {
     scheduler.Finish();
 }
@@ -597,8 +843,12 @@ StagingBufferRef TextureCacheRuntime::UploadStagingBuffer(size_t size) {
     return staging_buffer_pool.Request(size, MemoryUsage::Upload);
 }
 
-StagingBufferRef TextureCacheRuntime::DownloadStagingBuffer(size_t size) {
-    return staging_buffer_pool.Request(size, MemoryUsage::Download);
+StagingBufferRef TextureCacheRuntime::DownloadStagingBuffer(size_t size, bool deferred) {
+    return staging_buffer_pool.Request(size, MemoryUsage::Download, deferred);
+}
+
+void TextureCacheRuntime::FreeDeferredStagingBuffer(const StagingBufferRef& ref) {
+    staging_buffer_pool.FreeDeferred(ref);
 }
 
 void TextureCacheRuntime::BlitImage(Framebuffer* dst_framebuffer, ImageView& dst, ImageView& src,
@@ -818,28 +1068,73 @@ void TextureCacheRuntime::CopyImage(Image& dst, Image& src,
     });
 }
 
+VkRenderPass TextureCacheRuntime::GetRenderPass(const RenderPassKey& key) {
+    const auto [cache_pair, is_new] = renderpass_cache.try_emplace(key);
+    if (is_new) {
+        cache_pair->second = CreateRenderPass(device, key, 0);
+    }
+    return *cache_pair->second;
+}
+
+VkRenderPass TextureCacheRuntime::GetClearRenderPass(const RenderPassKey& key, u32 clear_mask) {
+    if (clear_mask == 0 || device.IsKhrDynamicRenderingSupported()) {
+        return GetRenderPass(key);
+    }
+    const auto [cache_pair, is_new] = clear_renderpass_cache.try_emplace(ClearRenderPassKey{
+        .key = key,
+        .clear_mask = clear_mask,
+    });
+    if (is_new) {
+        cache_pair->second = CreateRenderPass(device, key, clear_mask);
+    }
+    return *cache_pair->second;
+}
+
+std::optional<RenderPassKey> TextureCacheRuntime::FindRenderPassKey(
+    VkRenderPass renderpass) const {
+    const auto it = std::ranges::find_if(renderpass_cache, [renderpass](const auto& pair) {
+        return *pair.second == renderpass;
+    });
+    if (it == renderpass_cache.end()) {
+        return std::nullopt;
+    }
+    return it->first;
+}
+
+bool TextureCacheRuntime::HasNativeBcn() const noexcept {
+    return device.IsOptimalBcnSupported();
+}
+
 u64 TextureCacheRuntime::GetDeviceLocalMemory() const {
     return device.GetDeviceLocalMemory();
 }
 
-Image::Image(TextureCacheRuntime& runtime, const ImageInfo& info_, GPUVAddr gpu_addr_,
+Image::Image(TextureCacheRuntime& runtime_, const ImageInfo& info_, GPUVAddr gpu_addr_,
              VAddr cpu_addr_)
-    : VideoCommon::ImageBase(info_, gpu_addr_, cpu_addr_), scheduler{&runtime.scheduler},
-      image(MakeImage(runtime.device, info)), buffer(MakeBuffer(runtime.device, info)),
+    : VideoCommon::ImageBase(info_, gpu_addr_, cpu_addr_), runtime{&runtime_},
+      scheduler{&runtime_.scheduler}, image(MakeImage(runtime_.device, info)),
+      buffer(MakeBuffer(runtime_.device, info)),
       aspect_mask(ImageAspectMask(info.format)) {
     if (image) {
-        commit = runtime.memory_allocator.Commit(image, MemoryUsage::DeviceLocal);
+        commit = runtime_.memory_allocator.Commit(image, MemoryUsage::DeviceLocal);
     } else {
-        commit = runtime.memory_allocator.Commit(buffer, MemoryUsage::DeviceLocal);
+        commit = runtime_.memory_allocator.Commit(buffer, MemoryUsage::DeviceLocal);
     }
-    if (IsPixelFormatASTC(info.format) && !runtime.device.IsOptimalAstcSupported()) {
-        if (Settings::values.accelerate_astc.GetValue()) {
+    if (IsPixelFormatASTC(info.format) && !runtime_.device.IsOptimalAstcSupported()) {
+        if (runtime_.device.UseAstcTranscoding()) {
+            flags |= VideoCommon::ImageFlagBits::Converted | VideoCommon::ImageFlagBits::Transcoded;
+        } else if (Settings::values.accelerate_astc.GetValue()) {
             flags |= VideoCommon::ImageFlagBits::AcceleratedUpload;
         } else {
             flags |= VideoCommon::ImageFlagBits::Converted;
         }
     }
-    if (runtime.device.HasDebuggingToolAttached()) {
+    const bool is_bcn_decoded =
+        IsPixelFormatBC1To5(info.format) && !runtime_.device.IsOptimalBcnSupported();
+    if (is_bcn_decoded) {
+        flags |= VideoCommon::ImageFlagBits::AcceleratedUpload;
+    }
+    if (runtime_.device.HasDebuggingToolAttached()) {
         if (image) {
             image.SetObjectNameEXT(VideoCommon::Name(*this).c_str());
         } else {
@@ -851,8 +1146,10 @@ Image::Image(TextureCacheRuntime& runtime, const ImageInfo& info_, GPUVAddr gpu_
         .pNext = nullptr,
         .usage = VK_IMAGE_USAGE_STORAGE_BIT,
     };
-    if (IsPixelFormatASTC(info.format) && !runtime.device.IsOptimalAstcSupported()) {
-        const auto& device = runtime.device.GetLogical();
+    if ((IsPixelFormatASTC(info.format) && !runtime_.device.IsOptimalAstcSupported() &&
+         !runtime_.device.UseAstcTranscoding()) ||
+        is_bcn_decoded) {
+        const auto& device = runtime_.device.GetLogical();
         storage_image_views.reserve(info.resources.levels);
         for (s32 level = 0; level < info.resources.levels; ++level) {
             storage_image_views.push_back(device.CreateImageView(VkImageViewCreateInfo{
@@ -883,13 +1180,22 @@ Image::Image(TextureCacheRuntime& runtime, const ImageInfo& info_, GPUVAddr gpu_
 Image::~Image() = default;
 
 void Image::UploadMemory(const StagingBufferRef& map, std::span<const BufferImageCopy> copies) {
-    // TODO: Move this to another API
-    scheduler->RequestOutsideRenderPassOperationContext();
     std::vector vk_copies = TransformBufferImageCopies(copies, map.offset, aspect_mask);
     const VkBuffer src_buffer = map.buffer;
     const VkImage vk_image = *image;
     const VkImageAspectFlags vk_aspect_mask = aspect_mask;
     const bool is_initialized = std::exchange(initialized, true);
+    AsyncScheduler* const transfer_scheduler = scheduler->GetTransferScheduler();
+    // Images that have never been used on the GPU can't be referenced by pending graphics work,
+    // so their first upload can run ahead of it on the transfer queue
+    if (transfer_scheduler && !is_initialized && modification_tick == 0 &&
+        map.mapped_span.size_bytes() >= MIN_TRANSFER_QUEUE_UPLOAD_SIZE) {
+        TransferCopyBufferToImage(*transfer_scheduler, *scheduler, src_buffer, vk_image,
+                                  vk_aspect_mask, vk_copies);
+        return;
+    }
+    // TODO: Move this to another API
+    scheduler->RequestOutsideRenderPassOperationContext();
     scheduler->Record([src_buffer, vk_image, vk_aspect_mask, is_initialized,
                        vk_copies](vk::CommandBuffer cmdbuf) {
         CopyBufferToImage(cmdbuf, src_buffer, vk_image, vk_aspect_mask, is_initialized, vk_copies);
@@ -963,11 +1269,56 @@ void Image::DownloadMemory(const StagingBufferRef& map, std::span<const BufferIm
     });
 }
 
+bool Image::ScaleUp(u32 up, u32 shift) {
+    const Device& device = runtime->device;
+    const VideoCommon::Extent2D native_size{info.size.width, info.size.height};
+    if (!scaled_image) {
+        static constexpr VkFormatFeatureFlags BLIT_FEATURES =
+            VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT;
+        ImageInfo scaled_info = info;
+        scaled_info.size.width = VideoCommon::ScaleDimension(info.size.width, up, shift);
+        scaled_info.size.height = VideoCommon::ScaleDimension(info.size.height, up, shift);
+        const VkImageCreateInfo create_info = MakeImageCreateInfo(device, scaled_info);
+        if (!device.IsFormatSupported(create_info.format, BLIT_FEATURES, FormatType::Optimal)) {
+            return false;
+        }
+        scaled_image = device.GetLogical().CreateImage(create_info);
+        scaled_commit = runtime->memory_allocator.Commit(scaled_image, MemoryUsage::DeviceLocal);
+        scaled_size = VideoCommon::Extent2D{scaled_info.size.width, scaled_info.size.height};
+    }
+    BlitScale(*scheduler, *scaled_image, scaled_size, *image, native_size, aspect_mask,
+              RescaleFilter(), initialized);
+    initialized = true;
+    is_rescaled = true;
+    return true;
+}
+
+void Image::ScaleDown() {
+    const VideoCommon::Extent2D native_size{info.size.width, info.size.height};
+    BlitScale(*scheduler, *image, native_size, *scaled_image, scaled_size, aspect_mask,
+              RescaleFilter(), true);
+    is_rescaled = false;
+}
+
+VkFilter Image::RescaleFilter() const {
+    // Depth, stencil and integer contents can't be interpolated
+    if (aspect_mask != VK_IMAGE_ASPECT_COLOR_BIT) {
+        return VK_FILTER_NEAREST;
+    }
+    const Device& device = runtime->device;
+    const VkFormat format =
+        MaxwellToVK::SurfaceFormat(device, FormatType::Optimal, false, StorageFormat(info.format))
+            .format;
+    const bool is_linear = device.IsFormatSupported(
+        format, VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT, FormatType::Optimal);
+    return is_linear ? VK_FILTER_LINEAR : VK_FILTER_NEAREST;
+}
+
 ImageView::ImageView(TextureCacheRuntime& runtime, const VideoCommon::ImageViewInfo& info,
                      ImageId image_id_, Image& image)
     : VideoCommon::ImageViewBase{info, image.info, image_id_}, device{&runtime.device},
-      image_handle{image.Handle()}, image_format{image.info.format}, samples{ConvertSampleCount(
-                                                                         image.info.num_samples)} {
+      image_handle{image.Handle()}, image_format{image.info.format},
+      image_gpu_addr{image.gpu_addr}, samples{ConvertSampleCount(image.info.num_samples)} {
     const VkImageAspectFlags aspect_mask = ImageViewAspectMask(info);
     std::array<SwizzleSource, 4> swizzle{
         SwizzleSource::R,
@@ -1146,10 +1497,8 @@ Sampler::Sampler(TextureCacheRuntime& runtime, const Tegra::Texture::TSCEntry& t
 
 Framebuffer::Framebuffer(TextureCacheRuntime& runtime, std::span<ImageView*, NUM_RT> color_buffers,
                          ImageView* depth_buffer, const VideoCommon::RenderTargets& key) {
-    std::vector<VkAttachmentDescription> descriptions;
     std::vector<VkImageView> attachments;
-    RenderPassKey renderpass_key{};
-    s32 num_layers = 1;
+    s32 max_layers = 1;
 
     for (size_t index = 0; index < NUM_RT; ++index) {
         const ImageView* const color_buffer = color_buffers[index];
@@ -1157,23 +1506,19 @@ Framebuffer::Framebuffer(TextureCacheRuntime& runtime, std::span<ImageView*, NUM
             renderpass_key.color_formats[index] = PixelFormat::Invalid;
             continue;
         }
-        descriptions.push_back(AttachmentDescription(runtime.device, color_buffer));
         attachments.push_back(color_buffer->RenderTarget());
         renderpass_key.color_formats[index] = color_buffer->format;
-        num_layers = std::max(num_layers, color_buffer->range.extent.layers);
+        max_layers = std::max(max_layers, color_buffer->range.extent.layers);
         images[num_images] = color_buffer->ImageHandle();
         image_ranges[num_images] = MakeSubresourceRange(color_buffer);
         samples = color_buffer->Samples();
         ++num_images;
     }
     const size_t num_colors = attachments.size();
-    const VkAttachmentReference* depth_attachment =
-        depth_buffer ? &ATTACHMENT_REFERENCES[num_colors] : nullptr;
     if (depth_buffer) {
-        descriptions.push_back(AttachmentDescription(runtime.device, depth_buffer));
         attachments.push_back(depth_buffer->RenderTarget());
         renderpass_key.depth_format = depth_buffer->format;
-        num_layers = std::max(num_layers, depth_buffer->range.extent.layers);
+        max_layers = std::max(max_layers, depth_buffer->range.extent.layers);
         images[num_images] = depth_buffer->ImageHandle();
         image_ranges[num_images] = MakeSubresourceRange(depth_buffer);
         samples = depth_buffer->Samples();
@@ -1184,51 +1529,42 @@ Framebuffer::Framebuffer(TextureCacheRuntime& runtime, std::span<ImageView*, NUM
     renderpass_key.samples = samples;
 
     const auto& device = runtime.device.GetLogical();
-    const auto [cache_pair, is_new] = runtime.renderpass_cache.try_emplace(renderpass_key);
-    if (is_new) {
-        const VkSubpassDescription subpass{
-            .flags = 0,
-            .pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
-            .inputAttachmentCount = 0,
-            .pInputAttachments = nullptr,
-            .colorAttachmentCount = static_cast<u32>(num_colors),
-            .pColorAttachments = num_colors != 0 ? ATTACHMENT_REFERENCES.data() : nullptr,
-            .pResolveAttachments = nullptr,
-            .pDepthStencilAttachment = depth_attachment,
-            .preserveAttachmentCount = 0,
-            .pPreserveAttachments = nullptr,
-        };
-        cache_pair->second = device.CreateRenderPass(VkRenderPassCreateInfo{
-            .sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
-            .pNext = nullptr,
-            .flags = 0,
-            .attachmentCount = static_cast<u32>(descriptions.size()),
-            .pAttachments = descriptions.data(),
-            .subpassCount = 1,
-            .pSubpasses = &subpass,
-            .dependencyCount = 0,
-            .pDependencies = nullptr,
-        });
-    }
-    renderpass = *cache_pair->second;
+    renderpass = runtime.GetRenderPass(renderpass_key);
+    num_layers = static_cast<u32>(std::max(max_layers, 1));
     render_area = VkExtent2D{
         .width = key.size.width,
         .height = key.size.height,
     };
     num_color_buffers = static_cast<u32>(num_colors);
-    framebuffer = device.CreateFramebuffer(VkFramebufferCreateInfo{
-        .sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = 0,
-        .renderPass = renderpass,
-        .attachmentCount = static_cast<u32>(attachments.size()),
-        .pAttachments = attachments.data(),
-        .width = key.size.width,
-        .height = key.size.height,
-        .layers = static_cast<u32>(std::max(num_layers, 1)),
-    });
-    if (runtime.device.HasDebuggingToolAttached()) {
-        framebuffer.SetObjectNameEXT(VideoCommon::Name(key).c_str());
+    std::ranges::copy(attachments, image_views.begin());
+    // With dynamic rendering the attachments are given when rendering begins, the render pass is
+    // only kept to identify compatible pipelines
+    if (!runtime.device.IsKhrDynamicRenderingSupported()) {
+        framebuffer = device.CreateFramebuffer(VkFramebufferCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = 0,
+            .renderPass = renderpass,
+            .attachmentCount = static_cast<u32>(attachments.size()),
+            .pAttachments = attachments.data(),
+            .width = key.size.width,
+            .height = key.size.height,
+            .layers = num_layers,
+        });
+        if (runtime.device.HasDebuggingToolAttached()) {
+            framebuffer.SetObjectNameEXT(VideoCommon::Name(key).c_str());
+        }
+    }
+    profile_label = fmt::format("Render pass {}x{}", key.size.width, key.size.height);
+    for (size_t index = 0; index < NUM_RT; ++index) {
+        if (const ImageView* const color_buffer = color_buffers[index]) {
+            profile_label += fmt::format(" RT{} 0x{:x} {}", index, color_buffer->ImageGpuAddr(),
+                                         color_buffer->format);
+        }
+    }
+    if (depth_buffer) {
+        profile_label +=
+            fmt::format(" Z 0x{:x} {}", depth_buffer->ImageGpuAddr(), depth_buffer->format);
     }
 }
 
@@ -1238,6 +1574,9 @@ void TextureCacheRuntime::AccelerateImageUpload(
     if (IsPixelFormatASTC(image.info.format)) {
         return astc_decoder_pass.Assemble(image, map, swizzles);
     }
+    if (IsPixelFormatBC1To5(image.info.format)) {
+        return bcn_decoder_pass.Assemble(image, map, swizzles);
+    }
     UNREACHABLE();
 }
 
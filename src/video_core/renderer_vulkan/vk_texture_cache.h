@@ -5,7 +5,9 @@
 #pragma once
 
 #include <compare>
+#include <optional>
 #include <span>
+#include <string>
 
 #include "video_core/renderer_vulkan/vk_staging_buffer_pool.h"
 #include "video_core/texture_cache/texture_cache.h"
@@ -21,6 +23,7 @@ using VideoCommon::RenderTargets;
 using VideoCore::Surface::PixelFormat;
 
 class ASTCDecoderPass;
+class BCnDecoderPass;
 class BlitImageHelper;
 class Device;
 class Image;
@@ -37,6 +40,18 @@ struct RenderPassKey {
     VkSampleCountFlagBits samples;
 };
 
+/// Bit in a render pass clear mask for the depth aspect of the depth attachment
+constexpr u32 RENDER_PASS_CLEAR_DEPTH_BIT = 1U << NUM_RT;
+/// Bit in a render pass clear mask for the stencil aspect of the depth attachment
+constexpr u32 RENDER_PASS_CLEAR_STENCIL_BIT = 1U << (NUM_RT + 1);
+
+struct ClearRenderPassKey {
+    constexpr auto operator<=>(const ClearRenderPassKey&) const noexcept = default;
+
+    RenderPassKey key;
+    u32 clear_mask; ///< Color attachments by index and depth/stencil bits cleared on load
+};
+
 } // namespace Vulkan
 
 namespace std {
@@ -51,10 +66,47 @@ struct hash<Vulkan::RenderPassKey> {
         return value;
     }
 };
+
+template <>
+struct hash<Vulkan::ClearRenderPassKey> {
+    [[nodiscard]] size_t operator()(const Vulkan::ClearRenderPassKey& key) const noexcept {
+        return hash<Vulkan::RenderPassKey>{}(key.key) ^ (static_cast<size_t>(key.clear_mask) << 56);
+    }
+};
 } // namespace std
 
 namespace Vulkan {
 
+/// Attachment formats of a render pass, chained into the pipelines used with dynamic rendering
+class RenderingFormats {
+public:
+    explicit RenderingFormats(const Device& device, const RenderPassKey& key);
+
+    RenderingFormats(const RenderingFormats&) = delete;
+    RenderingFormats& operator=(const RenderingFormats&) = delete;
+
+    /// Returns the structure to chain into pipeline create infos, null without dynamic rendering
+    [[nodiscard]] const void* CreateInfo() const noexcept {
+#ifdef VK_KHR_dynamic_rendering
+        return is_enabled ? &create_info : nullptr;
+#else
+        return nullptr;
+#endif
+    }
+
+    /// Returns the render pass pipelines are created with, null with dynamic rendering
+    [[nodiscard]] VkRenderPass PipelineRenderPass(VkRenderPass renderpass) const noexcept {
+        return is_enabled ? VK_NULL_HANDLE : renderpass;
+    }
+
+private:
+    bool is_enabled = false;
+#ifdef VK_KHR_dynamic_rendering
+    std::array<VkFormat, NUM_RT> color_formats{};
+    VkPipelineRenderingCreateInfoKHR create_info{};
+#endif
+};
+
 struct TextureCacheRuntime {
     const Device& device;
     VKScheduler& scheduler;
@@ -62,13 +114,28 @@ struct TextureCacheRuntime {
     StagingBufferPool& staging_buffer_pool;
     BlitImageHelper& blit_image_helper;
     ASTCDecoderPass& astc_decoder_pass;
+    BCnDecoderPass& bcn_decoder_pass;
     std::unordered_map<RenderPassKey, vk::RenderPass> renderpass_cache{};
+    std::unordered_map<ClearRenderPassKey, vk::RenderPass> clear_renderpass_cache{};
 
     void Finish();
 
     [[nodiscard]] StagingBufferRef UploadStagingBuffer(size_t size);
 
-    [[nodiscard]] StagingBufferRef DownloadStagingBuffer(size_t size);
+    [[nodiscard]] StagingBufferRef DownloadStagingBuffer(size_t size, bool deferred = false);
+
+    void FreeDeferredStagingBuffer(const StagingBufferRef& ref);
+
+    /// Returns a render pass compatible with the given key, creating it if it doesn't exist
+    [[nodiscard]] VkRenderPass GetRenderPass(const RenderPassKey& key);
+
+    /// Returns a render pass compatible with the given key that clears the attachments in the mask
+    /// on load, creating it if it doesn't exist. With dynamic rendering load operations are given
+    /// when rendering begins, and this is the render pass of the key.
+    [[nodiscard]] VkRenderPass GetClearRenderPass(const RenderPassKey& key, u32 clear_mask);
+
+    /// Returns the key used to create a render pass from this runtime, if any
+    [[nodiscard]] std::optional<RenderPassKey> FindRenderPassKey(VkRenderPass renderpass) const;
 
     void BlitImage(Framebuffer* dst_framebuffer, ImageView& dst, ImageView& src,
                    const Region2D& dst_region, const Region2D& src_region,
@@ -98,6 +165,8 @@ struct TextureCacheRuntime {
         return true;
     }
 
+    bool HasNativeBcn() const noexcept;
+
     u64 GetDeviceLocalMemory() const;
 };
 
@@ -122,8 +191,15 @@ public:
     void DownloadMemory(const StagingBufferRef& map,
                         std::span<const VideoCommon::BufferImageCopy> copies);
 
+    /// Blits the contents to a scaled copy of the image and makes it the active handle.
+    /// Returns false when the format can't be scaled by this device.
+    bool ScaleUp(u32 up, u32 shift);
+
+    /// Blits the scaled contents back to the native image and makes it the active handle.
+    void ScaleDown();
+
     [[nodiscard]] VkImage Handle() const noexcept {
-        return *image;
+        return is_rescaled ? *scaled_image : *image;
     }
 
     [[nodiscard]] VkBuffer Buffer() const noexcept {
@@ -143,15 +219,27 @@ public:
         return std::exchange(initialized, true);
     }
 
+    /// Returns true when the image memory is keeping a mostly empty allocation alive
+    [[nodiscard]] bool IsInSparseMemory() const noexcept {
+        return commit.IsInSparseAllocation();
+    }
+
 private:
+    [[nodiscard]] VkFilter RescaleFilter() const;
+
+    TextureCacheRuntime* runtime;
     VKScheduler* scheduler;
     vk::Image image;
     vk::Buffer buffer;
     MemoryCommit commit;
     vk::ImageView image_view;
     std::vector<vk::ImageView> storage_image_views;
+    vk::Image scaled_image;
+    MemoryCommit scaled_commit;
+    VideoCommon::Extent2D scaled_size{};
     VkImageAspectFlags aspect_mask = 0;
     bool initialized = false;
+    bool is_rescaled = false;
 };
 
 class ImageView : public VideoCommon::ImageViewBase {
@@ -183,6 +271,10 @@ public:
         return image_format;
     }
 
+    [[nodiscard]] GPUVAddr ImageGpuAddr() const noexcept {
+        return image_gpu_addr;
+    }
+
     [[nodiscard]] VkSampleCountFlagBits Samples() const noexcept {
         return samples;
     }
@@ -198,6 +290,7 @@ private:
     VkImage image_handle = VK_NULL_HANDLE;
     VkImageView render_target = VK_NULL_HANDLE;
     PixelFormat image_format = PixelFormat::Invalid;
+    GPUVAddr image_gpu_addr = 0;
     VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
 };
 
@@ -220,6 +313,7 @@ public:
     explicit Framebuffer(TextureCacheRuntime&, std::span<ImageView*, NUM_RT> color_buffers,
                          ImageView* depth_buffer, const VideoCommon::RenderTargets& key);
 
+    /// Returns the framebuffer object, null when the device uses dynamic rendering
     [[nodiscard]] VkFramebuffer Handle() const noexcept {
         return *framebuffer;
     }
@@ -240,6 +334,14 @@ public:
         return num_color_buffers;
     }
 
+    [[nodiscard]] u32 NumLayers() const noexcept {
+        return num_layers;
+    }
+
+    [[nodiscard]] const RenderPassKey& GetRenderPassKey() const noexcept {
+        return renderpass_key;
+    }
+
     [[nodiscard]] u32 NumImages() const noexcept {
         return num_images;
     }
@@ -252,15 +354,29 @@ public:
         return image_ranges;
     }
 
+    /// Returns the views of the attachments, color ones first and the depth one last
+    [[nodiscard]] const std::array<VkImageView, 9>& ImageViews() const noexcept {
+        return image_views;
+    }
+
+    /// Returns the label of render passes on this framebuffer in GPU profiles
+    [[nodiscard]] const std::string& ProfileLabel() const noexcept {
+        return profile_label;
+    }
+
 private:
     vk::Framebuffer framebuffer;
     VkRenderPass renderpass{};
     VkExtent2D render_area{};
     VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
     u32 num_color_buffers = 0;
+    u32 num_layers = 1;
     u32 num_images = 0;
+    RenderPassKey renderpass_key{};
     std::array<VkImage, 9> images{};
     std::array<VkImageSubresourceRange, 9> image_ranges{};
+    std::array<VkImageView, 9> image_views{};
+    std::string profile_label;
 };
 
 struct TextureCacheParams {
@@ -268,6 +384,8 @@ struct TextureCacheParams {
     static constexpr bool FRAMEBUFFER_BLITS = false;
     static constexpr bool HAS_EMULATED_COPIES = false;
     static constexpr bool HAS_DEVICE_MEMORY_INFO = true;
+    static constexpr bool IMPLEMENTS_ASYNC_DOWNLOADS = true;
+    static constexpr bool HAS_MEMORY_DEFRAGMENTATION = true;
 
     using Runtime = Vulkan::TextureCacheRuntime;
     using Image = Vulkan::Image;
@@ -275,6 +393,7 @@ struct TextureCacheParams {
     using ImageView = Vulkan::ImageView;
     using Sampler = Vulkan::Sampler;
     using Framebuffer = Vulkan::Framebuffer;
+    using AsyncBuffer = Vulkan::StagingBufferRef;
 };
 
 using TextureCache = VideoCommon::TextureCache<TextureCacheParams>;
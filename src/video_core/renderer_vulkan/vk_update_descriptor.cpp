@@ -2,10 +2,13 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <cstring>
 #include <variant>
 #include <boost/container/static_vector.hpp>
 
 #include "common/assert.h"
+#include "common/cityhash.h"
 #include "common/logging/log.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_update_descriptor.h"
@@ -45,4 +48,45 @@ void VKUpdateDescriptorQueue::Send(VkDescriptorUpdateTemplateKHR update_template
     });
 }
 
+void VKUpdateDescriptorQueue::UpdateNow(VkDescriptorUpdateTemplateKHR update_template,
+                                        VkDescriptorSet set) {
+    device.GetLogical().UpdateDescriptorSet(set, update_template, upload_start);
+}
+
+VkDescriptorSet DescriptorSetCache::Find(std::span<const DescriptorUpdateEntry> update_data,
+                                         u64 tick) {
+    if (tick != current_tick) {
+        current_tick = tick;
+        cached_sets.clear();
+        payloads.clear();
+    }
+    last_hash = Common::CityHash64(reinterpret_cast<const char*>(update_data.data()),
+                                   update_data.size_bytes());
+    const auto it = cached_sets.find(last_hash);
+    if (it == cached_sets.end()) {
+        return VK_NULL_HANDLE;
+    }
+    const CachedSet& cached = it->second;
+    if (cached.payload_size != update_data.size() ||
+        std::memcmp(payloads.data() + cached.payload_offset, update_data.data(),
+                    update_data.size_bytes()) != 0) {
+        return VK_NULL_HANDLE;
+    }
+    return cached.set;
+}
+
+void DescriptorSetCache::Add(std::span<const DescriptorUpdateEntry> update_data,
+                             VkDescriptorSet set) {
+    if (cached_sets.size() >= MAX_CACHED_SETS) {
+        return;
+    }
+    const size_t payload_offset = payloads.size();
+    payloads.insert(payloads.end(), update_data.begin(), update_data.end());
+    cached_sets.insert_or_assign(last_hash, CachedSet{
+                                                .payload_offset = payload_offset,
+                                                .payload_size = update_data.size(),
+                                                .set = set,
+                                            });
+}
+
 } // namespace Vulkan
@@ -5,6 +5,9 @@
 #pragma once
 
 #include <array>
+#include <span>
+#include <unordered_map>
+#include <vector>
 
 #include "common/common_types.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
@@ -18,17 +21,29 @@ struct DescriptorUpdateEntry {
     struct Empty {};
 
     DescriptorUpdateEntry() = default;
-    DescriptorUpdateEntry(VkDescriptorImageInfo image_) : image{image_} {}
-    DescriptorUpdateEntry(VkDescriptorBufferInfo buffer_) : buffer{buffer_} {}
-    DescriptorUpdateEntry(VkBufferView texel_buffer_) : texel_buffer{texel_buffer_} {}
+
+    // Unused bytes are kept zeroed, payloads are compared bytewise by DescriptorSetCache.
+    DescriptorUpdateEntry(VkDescriptorImageInfo image_) : raw{} {
+        image.sampler = image_.sampler;
+        image.imageView = image_.imageView;
+        image.imageLayout = image_.imageLayout;
+    }
+    DescriptorUpdateEntry(VkDescriptorBufferInfo buffer_) : raw{} {
+        buffer = buffer_;
+    }
+    DescriptorUpdateEntry(VkBufferView texel_buffer_) : raw{} {
+        texel_buffer = texel_buffer_;
+    }
 
     union {
         Empty empty{};
+        std::array<u8, sizeof(VkDescriptorImageInfo)> raw;
         VkDescriptorImageInfo image;
         VkDescriptorBufferInfo buffer;
         VkBufferView texel_buffer;
     };
 };
+static_assert(sizeof(VkDescriptorImageInfo) >= sizeof(VkDescriptorBufferInfo));
 
 class VKUpdateDescriptorQueue final {
 public:
@@ -41,6 +56,14 @@ public:
 
     void Send(VkDescriptorUpdateTemplateKHR update_template, VkDescriptorSet set);
 
+    /// Updates the set on the caller thread, for sets used outside of the scheduler.
+    void UpdateNow(VkDescriptorUpdateTemplateKHR update_template, VkDescriptorSet set);
+
+    /// Returns the entries added since the last call to Acquire.
+    [[nodiscard]] std::span<const DescriptorUpdateEntry> UpdateData() const noexcept {
+        return std::span(upload_start, payload_cursor);
+    }
+
     void AddSampledImage(VkImageView image_view, VkSampler sampler) {
         *(payload_cursor++) = VkDescriptorImageInfo{
             .sampler = sampler,
@@ -78,4 +101,30 @@ private:
     std::array<DescriptorUpdateEntry, 0x10000> payload;
 };
 
+/// Remembers the descriptor sets a pipeline committed during the current scheduler tick, so draws
+/// binding the exact same resources reuse a set instead of allocating and updating a new one.
+/// Sets are only reused within the tick they were committed in, as that's what keeps them alive.
+class DescriptorSetCache {
+public:
+    /// Returns a set committed during this tick with the same payload, or VK_NULL_HANDLE on miss.
+    [[nodiscard]] VkDescriptorSet Find(std::span<const DescriptorUpdateEntry> update_data, u64 tick);
+
+    /// Records a set committed during the tick of the last call to Find with the same payload.
+    void Add(std::span<const DescriptorUpdateEntry> update_data, VkDescriptorSet set);
+
+private:
+    static constexpr size_t MAX_CACHED_SETS = 64;
+
+    struct CachedSet {
+        size_t payload_offset;
+        size_t payload_size;
+        VkDescriptorSet set;
+    };
+
+    u64 current_tick = 0;
+    u64 last_hash = 0;
+    std::unordered_map<u64, CachedSet> cached_sets;
+    std::vector<DescriptorUpdateEntry> payloads;
+};
+
 } // namespace Vulkan
@@ -6,6 +6,7 @@
 #include <mutex>
 #include <thread>
 #include <vector>
+#include "common/thread_placement.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/renderer_base.h"
 #include "video_core/renderer_opengl/gl_shader_cache.h"
@@ -117,7 +118,8 @@ void AsyncShaders::QueueOpenGLShader(const OpenGL::Device& device,
                                      Tegra::Engines::ShaderType shader_type, u64 uid,
                                      std::vector<u64> code, std::vector<u64> code_b,
                                      u32 main_offset, CompilerSettings compiler_settings,
-                                     const Registry& registry, VAddr cpu_addr) {
+                                     const Registry& registry, VAddr cpu_addr,
+                                     std::optional<SpecializationValues> specialization) {
     std::unique_lock lock(queue_mutex);
     pending_queue.push({
         .backend = device.UseAssemblyShaders() ? Backend::GLASM : Backend::OpenGL,
@@ -130,6 +132,7 @@ void AsyncShaders::QueueOpenGLShader(const OpenGL::Device& device,
         .compiler_settings = compiler_settings,
         .registry = registry,
         .cpu_address = cpu_addr,
+        .specialization = specialization,
         .pp_cache = nullptr,
         .vk_device = nullptr,
         .scheduler = nullptr,
@@ -138,7 +141,7 @@ void AsyncShaders::QueueOpenGLShader(const OpenGL::Device& device,
         .bindings{},
         .program{},
         .key{},
-        .num_color_buffers = 0,
+        .renderpass_key{},
     });
     cv.notify_one();
 }
@@ -149,7 +152,8 @@ void AsyncShaders::QueueVulkanShader(Vulkan::VKPipelineCache* pp_cache,
                                      Vulkan::VKUpdateDescriptorQueue& update_descriptor_queue,
                                      std::vector<VkDescriptorSetLayoutBinding> bindings,
                                      Vulkan::SPIRVProgram program,
-                                     Vulkan::GraphicsPipelineCacheKey key, u32 num_color_buffers) {
+                                     Vulkan::GraphicsPipelineCacheKey key,
+                                     const Vulkan::RenderPassKey& renderpass_key) {
     std::unique_lock lock(queue_mutex);
     pending_queue.push({
         .backend = Backend::Vulkan,
@@ -162,6 +166,7 @@ void AsyncShaders::QueueVulkanShader(Vulkan::VKPipelineCache* pp_cache,
         .compiler_settings{},
         .registry{},
         .cpu_address = 0,
+        .specialization{},
         .pp_cache = pp_cache,
         .vk_device = &device,
         .scheduler = &scheduler,
@@ -170,12 +175,13 @@ void AsyncShaders::QueueVulkanShader(Vulkan::VKPipelineCache* pp_cache,
         .bindings = std::move(bindings),
         .program = std::move(program),
         .key = key,
-        .num_color_buffers = num_color_buffers,
+        .renderpass_key = renderpass_key,
     });
     cv.notify_one();
 }
 
 void AsyncShaders::ShaderCompilerThread(Core::Frontend::GraphicsContext* context) {
+    Common::PlaceCurrentThread(Common::PlacedThread::ShaderCompile);
     while (!is_thread_exiting.load(std::memory_order_relaxed)) {
         std::unique_lock lock{queue_mutex};
         cv.wait(lock, [this] { return HasWorkQueued() || is_thread_exiting; });
@@ -209,6 +215,7 @@ void AsyncShaders::ShaderCompilerThread(Core::Frontend::GraphicsContext* context
             result.code = std::move(work.code);
             result.code_b = std::move(work.code_b);
             result.shader_type = work.shader_type;
+            result.specialization = work.specialization;
 
             if (work.backend == Backend::OpenGL) {
                 result.program.opengl = std::move(program->source_program);
@@ -221,10 +228,11 @@ void AsyncShaders::ShaderCompilerThread(Core::Frontend::GraphicsContext* context
                 finished_work.push_back(std::move(result));
             }
         } else if (work.backend == Backend::Vulkan) {
+            work.pp_cache->OptimizeProgram(work.program);
             auto pipeline = std::make_unique<Vulkan::VKGraphicsPipeline>(
                 *work.vk_device, *work.scheduler, *work.descriptor_pool,
                 *work.update_descriptor_queue, work.key, work.bindings, work.program,
-                work.num_color_buffers);
+                work.renderpass_key, work.pp_cache->GetVkPipelineCache(), nullptr);
 
             work.pp_cache->EmplacePipeline(std::move(pipeline));
         }
@@ -55,6 +55,8 @@ public:
         std::vector<u64> code;
         std::vector<u64> code_b;
         Tegra::Engines::ShaderType shader_type;
+        /// Values the program has been specialized on, when it's a variant of the shader
+        std::optional<SpecializationValues> specialization;
     };
 
     explicit AsyncShaders(Core::Frontend::EmuWindow& emu_window_);
@@ -83,7 +85,8 @@ public:
     void QueueOpenGLShader(const OpenGL::Device& device, Tegra::Engines::ShaderType shader_type,
                            u64 uid, std::vector<u64> code, std::vector<u64> code_b, u32 main_offset,
                            CompilerSettings compiler_settings, const Registry& registry,
-                           VAddr cpu_addr);
+                           VAddr cpu_addr,
+                           std::optional<SpecializationValues> specialization = std::nullopt);
 
     void QueueVulkanShader(Vulkan::VKPipelineCache* pp_cache, const Vulkan::Device& device,
                            Vulkan::VKScheduler& scheduler,
@@ -91,7 +94,7 @@ public:
                            Vulkan::VKUpdateDescriptorQueue& update_descriptor_queue,
                            std::vector<VkDescriptorSetLayoutBinding> bindings,
                            Vulkan::SPIRVProgram program, Vulkan::GraphicsPipelineCacheKey key,
-                           u32 num_color_buffers);
+                           const Vulkan::RenderPassKey& renderpass_key);
 
 private:
     void ShaderCompilerThread(Core::Frontend::GraphicsContext* context);
@@ -111,6 +114,7 @@ private:
         CompilerSettings compiler_settings;
         std::optional<Registry> registry;
         VAddr cpu_address;
+        std::optional<SpecializationValues> specialization;
 
         // For Vulkan
         Vulkan::VKPipelineCache* pp_cache;
@@ -121,7 +125,7 @@ private:
         std::vector<VkDescriptorSetLayoutBinding> bindings;
         Vulkan::SPIRVProgram program;
         Vulkan::GraphicsPipelineCacheKey key;
-        u32 num_color_buffers;
+        Vulkan::RenderPassKey renderpass_key;
     };
 
     std::condition_variable cv;
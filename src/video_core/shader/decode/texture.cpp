@@ -220,6 +220,7 @@ u32 ShaderIR::DecodeTexture(NodeBlock& bb, u32 pc) {
         const std::optional<SamplerEntry> sampler =
             is_bindless ? GetBindlessSampler(instr.gpr8, {}, index_var)
                         : GetSampler(instr.sampler, {});
+        MarkSamplerFetched(sampler);
 
         if (!sampler) {
             u32 indexer = 0;
@@ -479,6 +480,18 @@ std::optional<SamplerEntry> ShaderIR::GetBindlessSampler(Tegra::Shader::Register
     return std::nullopt;
 }
 
+void ShaderIR::MarkSamplerFetched(const std::optional<SamplerEntry>& sampler) {
+    if (!sampler) {
+        return;
+    }
+    const auto it = std::find_if(
+        used_samplers.begin(), used_samplers.end(),
+        [index = sampler->index](const SamplerEntry& entry) { return entry.index == index; });
+    if (it != used_samplers.end()) {
+        it->is_fetched = true;
+    }
+}
+
 void ShaderIR::WriteTexInstructionFloat(NodeBlock& bb, Instruction instr, const Node4& components) {
     u32 dest_elem = 0;
     for (u32 elem = 0; elem < 4; ++elem) {
@@ -786,6 +799,7 @@ Node4 ShaderIR::GetTldCode(Tegra::Shader::Instruction instr) {
     // const Node multisample{is_multisample ? GetRegister(gpr20_cursor++) : nullptr};
 
     const std::optional<SamplerEntry> sampler = GetSampler(instr.sampler, {});
+    MarkSamplerFetched(sampler);
 
     Node4 values;
     for (u32 element = 0; element < values.size(); ++element) {
@@ -803,6 +817,7 @@ Node4 ShaderIR::GetTldsCode(Instruction instr, TextureType texture_type, bool is
     info.is_array = is_array;
     info.is_shadow = false;
     const std::optional<SamplerEntry> sampler = GetSampler(instr.sampler, info);
+    MarkSamplerFetched(sampler);
 
     const std::size_t type_coord_count = GetCoordCount(texture_type);
     const bool lod_enabled = instr.tlds.GetTextureProcessMode() == TextureProcessMode::LL;
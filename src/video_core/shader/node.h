@@ -318,6 +318,7 @@ struct SamplerEntry {
     bool is_bindless = false;  ///< Whether this sampler belongs to a bindless texture or not.
     bool is_indexed = false;   ///< Whether this sampler is an indexed array of textures.
     bool is_separated = false; ///< Whether the image and sampler is separated or not.
+    bool is_fetched = false;   ///< Whether texels are read by coordinate or the size is queried.
 };
 
 /// Represents a tracked bindless sampler into a direct const buffer
@@ -0,0 +1,560 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <optional>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/shader/ast.h"
+#include "video_core/shader/node.h"
+#include "video_core/shader/node_helper.h"
+#include "video_core/shader/shader_ir.h"
+
+namespace VideoCommon::Shader {
+
+using Tegra::Shader::Pred;
+using Tegra::Shader::Register;
+
+namespace {
+
+/// Returns the value of a node known at compile time
+std::optional<u32> GetConstant(const Node& node) {
+    if (const auto immediate = std::get_if<ImmediateNode>(&*node)) {
+        return immediate->GetValue();
+    }
+    if (const auto gpr = std::get_if<GprNode>(&*node)) {
+        if (gpr->GetIndex() == Register::ZeroIndex) {
+            return 0;
+        }
+    }
+    return std::nullopt;
+}
+
+/// Returns the value of a boolean node known at compile time
+std::optional<bool> GetConstantBool(const Node& node) {
+    if (const auto predicate = std::get_if<PredicateNode>(&*node)) {
+        switch (predicate->GetIndex()) {
+        case Pred::UnusedIndex:
+            return !predicate->IsNegated();
+        case Pred::NeverExecute:
+            return predicate->IsNegated();
+        default:
+            break;
+        }
+    }
+    return std::nullopt;
+}
+
+Node ConstantBool(bool value) {
+    return MakeNode<PredicateNode>(value ? Pred::UnusedIndex : Pred::NeverExecute, false);
+}
+
+bool HasSideEffects(OperationCode code) {
+    switch (code) {
+    case OperationCode::Assign:
+    case OperationCode::LogicalAssign:
+    case OperationCode::ImageStore:
+    case OperationCode::Branch:
+    case OperationCode::BranchIndirect:
+    case OperationCode::PushFlowStack:
+    case OperationCode::PopFlowStack:
+    case OperationCode::Exit:
+    case OperationCode::Discard:
+    case OperationCode::EmitVertex:
+    case OperationCode::EndPrimitive:
+    case OperationCode::Barrier:
+    case OperationCode::MemoryBarrierGroup:
+    case OperationCode::MemoryBarrierGlobal:
+        return true;
+    default:
+        // Image atomics, memory atomics and reductions are declared next to each other
+        return code >= OperationCode::AtomicImageAdd && code <= OperationCode::ReduceIXor;
+    }
+}
+
+/// Returns true when a node can be removed without changing the behavior of the shader
+bool IsPure(const Node& node) {
+    if (std::holds_alternative<ConditionalNode>(*node)) {
+        return false;
+    }
+    const auto operation = std::get_if<OperationNode>(&*node);
+    if (!operation) {
+        return true;
+    }
+    // Amended code is emitted before the operation itself
+    if (operation->GetAmendIndex() || HasSideEffects(operation->GetCode())) {
+        return false;
+    }
+    for (std::size_t i = 0; i < operation->GetOperandsCount(); ++i) {
+        if (!IsPure((*operation)[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Node Simplify(const Node& node, const KeyMap& specialized_keys);
+
+std::optional<Node> FoldLogicalNegate(const Node& value) {
+    if (const auto constant = GetConstantBool(value)) {
+        return ConstantBool(!*constant);
+    }
+    if (const auto predicate = std::get_if<PredicateNode>(&*value)) {
+        return MakeNode<PredicateNode>(predicate->GetIndex(), !predicate->IsNegated());
+    }
+    if (const auto operation = std::get_if<OperationNode>(&*value)) {
+        if (operation->GetCode() == OperationCode::LogicalNegate && !operation->GetAmendIndex()) {
+            return (*operation)[0];
+        }
+    }
+    return std::nullopt;
+}
+
+/// Folds an operation whose operands have already been simplified
+std::optional<Node> FoldOperation(OperationCode code, const std::vector<Node>& operands) {
+    const auto unary = [&](auto&& func) -> std::optional<Node> {
+        if (const auto value = GetConstant(operands[0])) {
+            return Immediate(static_cast<u32>(func(*value)));
+        }
+        return std::nullopt;
+    };
+    const auto binary = [&](auto&& func) -> std::optional<Node> {
+        const auto a = GetConstant(operands[0]);
+        const auto b = GetConstant(operands[1]);
+        if (a && b) {
+            return Immediate(static_cast<u32>(func(*a, *b)));
+        }
+        return std::nullopt;
+    };
+    const auto compare = [&](auto&& func) -> std::optional<Node> {
+        const auto a = GetConstant(operands[0]);
+        const auto b = GetConstant(operands[1]);
+        if (a && b) {
+            return ConstantBool(func(*a, *b));
+        }
+        return std::nullopt;
+    };
+    const auto signed_compare = [&](auto&& func) {
+        return compare(
+            [&](u32 a, u32 b) { return func(static_cast<s32>(a), static_cast<s32>(b)); });
+    };
+    // Drops an operand that doesn't change the result, e.g. additions of zero
+    const auto identity = [&](u32 identity_value, bool commutative) -> std::optional<Node> {
+        if (GetConstant(operands[1]) == identity_value) {
+            return operands[0];
+        }
+        if (commutative && GetConstant(operands[0]) == identity_value) {
+            return operands[1];
+        }
+        return std::nullopt;
+    };
+    // Replaces the operation with a constant when either operand forces the result
+    const auto absorb = [&](u32 absorbing_value) -> std::optional<Node> {
+        for (std::size_t i = 0; i < 2; ++i) {
+            if (GetConstant(operands[i]) == absorbing_value && IsPure(operands[1 - i])) {
+                return Immediate(absorbing_value);
+            }
+        }
+        return std::nullopt;
+    };
+    const auto first_of = [](std::initializer_list<std::optional<Node>> results) {
+        for (const auto& result : results) {
+            if (result) {
+                return result;
+            }
+        }
+        return std::optional<Node>{};
+    };
+
+    switch (code) {
+    case OperationCode::FNegate:
+        return unary([](u32 value) { return value ^ 0x80000000U; });
+    case OperationCode::FAbsolute:
+        return unary([](u32 value) { return value & 0x7FFFFFFFU; });
+    case OperationCode::INegate:
+        return unary([](u32 value) { return 0U - value; });
+    case OperationCode::IBitwiseNot:
+    case OperationCode::UBitwiseNot:
+        return unary([](u32 value) { return ~value; });
+    case OperationCode::IAdd:
+    case OperationCode::UAdd:
+        return first_of({binary([](u32 a, u32 b) { return a + b; }), identity(0, true)});
+    case OperationCode::IMul:
+    case OperationCode::UMul:
+        return first_of({binary([](u32 a, u32 b) { return a * b; }), identity(1, true),
+                         absorb(0)});
+    case OperationCode::IBitwiseAnd:
+    case OperationCode::UBitwiseAnd:
+        return first_of({binary([](u32 a, u32 b) { return a & b; }), identity(~0U, true),
+                         absorb(0)});
+    case OperationCode::IBitwiseOr:
+    case OperationCode::UBitwiseOr:
+        return first_of({binary([](u32 a, u32 b) { return a | b; }), identity(0, true),
+                         absorb(~0U)});
+    case OperationCode::IBitwiseXor:
+    case OperationCode::UBitwiseXor:
+        return first_of({binary([](u32 a, u32 b) { return a ^ b; }), identity(0, true)});
+    case OperationCode::ILogicalShiftLeft:
+    case OperationCode::ULogicalShiftLeft:
+    case OperationCode::ILogicalShiftRight:
+    case OperationCode::ULogicalShiftRight:
+    case OperationCode::IArithmeticShiftRight:
+    case OperationCode::UArithmeticShiftRight: {
+        const auto shift = GetConstant(operands[1]);
+        if (!shift) {
+            return std::nullopt;
+        }
+        if (*shift == 0) {
+            return operands[0];
+        }
+        // Shifts of 32 bits or more are undefined in the backends, leave them as they are
+        if (*shift >= 32) {
+            return std::nullopt;
+        }
+        if (code == OperationCode::ILogicalShiftLeft || code == OperationCode::ULogicalShiftLeft) {
+            return binary([](u32 a, u32 b) { return a << b; });
+        }
+        if (code == OperationCode::IArithmeticShiftRight) {
+            return binary([](u32 a, u32 b) { return static_cast<s32>(a) >> b; });
+        }
+        return binary([](u32 a, u32 b) { return a >> b; });
+    }
+    case OperationCode::LogicalIEqual:
+    case OperationCode::LogicalUEqual:
+        return compare([](u32 a, u32 b) { return a == b; });
+    case OperationCode::LogicalINotEqual:
+    case OperationCode::LogicalUNotEqual:
+        return compare([](u32 a, u32 b) { return a != b; });
+    case OperationCode::LogicalULessThan:
+        return compare([](u32 a, u32 b) { return a < b; });
+    case OperationCode::LogicalULessEqual:
+        return compare([](u32 a, u32 b) { return a <= b; });
+    case OperationCode::LogicalUGreaterThan:
+        return compare([](u32 a, u32 b) { return a > b; });
+    case OperationCode::LogicalUGreaterEqual:
+        return compare([](u32 a, u32 b) { return a >= b; });
+    case OperationCode::LogicalILessThan:
+        return signed_compare([](s32 a, s32 b) { return a < b; });
+    case OperationCode::LogicalILessEqual:
+        return signed_compare([](s32 a, s32 b) { return a <= b; });
+    case OperationCode::LogicalIGreaterThan:
+        return signed_compare([](s32 a, s32 b) { return a > b; });
+    case OperationCode::LogicalIGreaterEqual:
+        return signed_compare([](s32 a, s32 b) { return a >= b; });
+    case OperationCode::LogicalNegate:
+        return FoldLogicalNegate(operands[0]);
+    case OperationCode::LogicalAnd:
+    case OperationCode::LogicalOr: {
+        const bool is_and = code == OperationCode::LogicalAnd;
+        for (std::size_t i = 0; i < 2; ++i) {
+            const auto value = GetConstantBool(operands[i]);
+            if (!value) {
+                continue;
+            }
+            const Node& other = operands[1 - i];
+            if (*value == is_and) {
+                return other;
+            }
+            if (IsPure(other)) {
+                return ConstantBool(!is_and);
+            }
+        }
+        return std::nullopt;
+    }
+    case OperationCode::LogicalXor:
+        for (std::size_t i = 0; i < 2; ++i) {
+            const auto value = GetConstantBool(operands[i]);
+            if (!value) {
+                continue;
+            }
+            const Node& other = operands[1 - i];
+            if (!*value) {
+                return other;
+            }
+            if (auto negated = FoldLogicalNegate(other)) {
+                return negated;
+            }
+            return Operation(OperationCode::LogicalNegate, other);
+        }
+        return std::nullopt;
+    case OperationCode::Select: {
+        const auto condition = GetConstantBool(operands[0]);
+        if (!condition) {
+            return std::nullopt;
+        }
+        const Node& taken = operands[*condition ? 1 : 2];
+        const Node& ignored = operands[*condition ? 2 : 1];
+        if (!IsPure(ignored)) {
+            return std::nullopt;
+        }
+        return taken;
+    }
+    default:
+        return std::nullopt;
+    }
+}
+
+Node SimplifyOperation(const Node& node, const OperationNode& operation,
+                       const KeyMap& specialized_keys) {
+    const std::size_t num_operands = operation.GetOperandsCount();
+    std::vector<Node> operands;
+    operands.reserve(num_operands);
+    bool changed = false;
+    for (std::size_t i = 0; i < num_operands; ++i) {
+        operands.push_back(Simplify(operation[i], specialized_keys));
+        changed |= operands.back() != operation[i];
+    }
+    const auto amend_index = operation.GetAmendIndex();
+    if (!amend_index && num_operands > 0) {
+        if (auto folded = FoldOperation(operation.GetCode(), operands)) {
+            return *folded;
+        }
+    }
+    if (!changed) {
+        return node;
+    }
+    Node result = MakeNode<OperationNode>(operation.GetCode(), operation.GetMeta(),
+                                          std::move(operands));
+    if (amend_index) {
+        std::get<OperationNode>(*result).SetAmendIndex(*amend_index);
+    }
+    return result;
+}
+
+Node Simplify(const Node& node, const KeyMap& specialized_keys) {
+    if (const auto operation = std::get_if<OperationNode>(&*node)) {
+        return SimplifyOperation(node, *operation, specialized_keys);
+    }
+    if (const auto cbuf = std::get_if<CbufNode>(&*node)) {
+        if (const auto offset = std::get_if<ImmediateNode>(&*cbuf->GetOffset())) {
+            const auto it = specialized_keys.find({cbuf->GetIndex(), offset->GetValue()});
+            if (it != specialized_keys.end()) {
+                return Immediate(it->second);
+            }
+        }
+    }
+    return node;
+}
+
+/// Returns true when a statement writes to a register or predicate that discards writes
+bool IsDeadStore(const Node& node) {
+    const auto operation = std::get_if<OperationNode>(&*node);
+    if (!operation || operation->GetAmendIndex()) {
+        return false;
+    }
+    const Node& dest = (*operation)[0];
+    switch (operation->GetCode()) {
+    case OperationCode::Assign:
+        if (const auto gpr = std::get_if<GprNode>(&*dest);
+            !gpr || gpr->GetIndex() != Register::ZeroIndex) {
+            return false;
+        }
+        break;
+    case OperationCode::LogicalAssign:
+        if (!GetConstantBool(dest)) {
+            return false;
+        }
+        break;
+    default:
+        return false;
+    }
+    return IsPure((*operation)[1]);
+}
+
+void OptimizeBlock(NodeBlock& block, const KeyMap& specialized_keys) {
+    NodeBlock result;
+    result.reserve(block.size());
+    for (const Node& node : block) {
+        const auto conditional = std::get_if<ConditionalNode>(&*node);
+        if (!conditional) {
+            Node simplified = Simplify(node, specialized_keys);
+            if (!IsDeadStore(simplified)) {
+                result.push_back(std::move(simplified));
+            }
+            continue;
+        }
+        const auto amend_index = conditional->GetAmendIndex();
+        Node condition = Simplify(conditional->GetCondition(), specialized_keys);
+        if (const auto value = GetConstantBool(condition); !amend_index && value && !*value) {
+            continue;
+        }
+        NodeBlock code = conditional->GetCode();
+        OptimizeBlock(code, specialized_keys);
+        if (!amend_index && code.empty() && IsPure(condition)) {
+            continue;
+        }
+        Node new_conditional = Conditional(std::move(condition), std::move(code));
+        if (amend_index) {
+            std::get<ConditionalNode>(*new_conditional).SetAmendIndex(*amend_index);
+        }
+        result.push_back(std::move(new_conditional));
+    }
+    block = std::move(result);
+}
+
+/// Calls a function on every decoded block of an AST
+class ASTBlockVisitor {
+public:
+    explicit ASTBlockVisitor(std::function<void(NodeBlock&)> on_block_)
+        : on_block{std::move(on_block_)} {}
+
+    void operator()(ASTProgram& ast) {
+        VisitList(ast.nodes);
+    }
+
+    void operator()(ASTIfThen& ast) {
+        VisitList(ast.nodes);
+    }
+
+    void operator()(ASTIfElse& ast) {
+        VisitList(ast.nodes);
+    }
+
+    void operator()([[maybe_unused]] ASTBlockEncoded& ast) {}
+
+    void operator()(ASTBlockDecoded& ast) {
+        on_block(ast.nodes);
+    }
+
+    void operator()([[maybe_unused]] ASTVarSet& ast) {}
+
+    void operator()([[maybe_unused]] ASTLabel& ast) {}
+
+    void operator()([[maybe_unused]] ASTGoto& ast) {}
+
+    void operator()(ASTDoWhile& ast) {
+        VisitList(ast.nodes);
+    }
+
+    void operator()([[maybe_unused]] ASTReturn& ast) {}
+
+    void operator()([[maybe_unused]] ASTBreak& ast) {}
+
+    void Visit(const ASTNode& node) {
+        std::visit(*this, *node->GetInnerData());
+    }
+
+private:
+    void VisitList(ASTZipper& nodes) {
+        ASTNode current = nodes.GetFirst();
+        while (current) {
+            Visit(current);
+            current = current->GetNext();
+        }
+    }
+
+    std::function<void(NodeBlock&)> on_block;
+};
+
+/// Collects the const buffer words read by a node, returns false when the node depends on
+/// anything other than const buffers and constants
+bool CollectUniformKeys(const Node& node, SpecializationKeys& keys) {
+    if (GetConstant(node) || GetConstantBool(node)) {
+        return true;
+    }
+    if (const auto cbuf = std::get_if<CbufNode>(&*node)) {
+        const auto offset = std::get_if<ImmediateNode>(&*cbuf->GetOffset());
+        if (!offset) {
+            return false;
+        }
+        const std::pair key{cbuf->GetIndex(), offset->GetValue()};
+        if (std::ranges::find(keys, key) == keys.end()) {
+            keys.push_back(key);
+        }
+        return true;
+    }
+    const auto operation = std::get_if<OperationNode>(&*node);
+    if (!operation || operation->GetAmendIndex() || HasSideEffects(operation->GetCode())) {
+        return false;
+    }
+    for (std::size_t i = 0; i < operation->GetOperandsCount(); ++i) {
+        if (!CollectUniformKeys((*operation)[i], keys)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void FindSpecializationKeysInBlock(const NodeBlock& block, std::size_t max_keys,
+                                   SpecializationKeys& keys) {
+    for (const Node& node : block) {
+        if (const auto conditional = std::get_if<ConditionalNode>(&*node)) {
+            FindSpecializationKeysInBlock(conditional->GetCode(), max_keys, keys);
+            continue;
+        }
+        const auto operation = std::get_if<OperationNode>(&*node);
+        if (!operation || operation->GetCode() != OperationCode::LogicalAssign) {
+            continue;
+        }
+        const Node& source = (*operation)[1];
+        SpecializationKeys source_keys;
+        if (!CollectUniformKeys(source, source_keys) || source_keys.empty()) {
+            continue;
+        }
+        SpecializationKeys merged_keys = keys;
+        for (const auto& key : source_keys) {
+            if (std::ranges::find(merged_keys, key) == merged_keys.end()) {
+                merged_keys.push_back(key);
+            }
+        }
+        if (merged_keys.size() > max_keys) {
+            continue;
+        }
+        // Only keep predicates that fold into a constant once the words are known
+        KeyMap placeholder_keys;
+        for (const auto& key : source_keys) {
+            placeholder_keys.emplace(key, 0);
+        }
+        if (!GetConstantBool(Simplify(source, placeholder_keys))) {
+            continue;
+        }
+        keys = std::move(merged_keys);
+    }
+}
+
+} // Anonymous namespace
+
+void ShaderIR::Optimize() {
+    // Tracking during decode looks for the nodes it emitted, so the IR is only rewritten once
+    // every instruction has been decoded.
+    // Specialized const buffer values are replaced too, so the branches they choose fold away
+    const KeyMap& specialized_keys = registry.GetSpecializedKeys();
+    for (auto& [label, block] : basic_blocks) {
+        OptimizeBlock(block, specialized_keys);
+    }
+    if (decompiled) {
+        if (const ASTNode program = GetASTProgram()) {
+            ASTBlockVisitor visitor{
+                [&](NodeBlock& block) { OptimizeBlock(block, specialized_keys); }};
+            visitor.Visit(program);
+        }
+    }
+    for (Node& amend : amend_code) {
+        amend = Simplify(amend, specialized_keys);
+    }
+}
+
+SpecializationKeys ShaderIR::FindSpecializationKeys() const {
+    SpecializationKeys keys;
+    const auto find = [&keys](const NodeBlock& block) {
+        FindSpecializationKeysInBlock(block, MAX_SPECIALIZATION_KEYS, keys);
+    };
+    for (const auto& [label, block] : basic_blocks) {
+        find(block);
+    }
+    if (decompiled) {
+        if (const ASTNode program = GetASTProgram()) {
+            ASTBlockVisitor visitor{find};
+            visitor.Visit(program);
+        }
+    }
+    return keys;
+}
+
+} // namespace VideoCommon::Shader
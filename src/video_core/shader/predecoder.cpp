@@ -0,0 +1,145 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <utility>
+
+#include "video_core/engines/const_buffer_engine_interface.h"
+#include "video_core/shader/predecoder.h"
+
+namespace VideoCommon::Shader {
+
+PredecodedShader::PredecodedShader(Tegra::Engines::ShaderType stage, u64 unique_identifier_,
+                                   ProgramCode code_, u32 main_offset, CompilerSettings settings,
+                                   const SerializedRegistryInfo& info)
+    : unique_identifier{unique_identifier_}, code{std::move(code_)}, registry{stage, info},
+      ir{code, main_offset, settings, registry} {}
+
+ShaderPredecoder::ShaderPredecoder(std::size_t max_workers_)
+    : max_workers{std::max<std::size_t>(max_workers_, 1)} {}
+
+ShaderPredecoder::~ShaderPredecoder() {
+    stop_source.request_stop();
+    workers.Wait();
+}
+
+std::size_t ShaderPredecoder::DefaultNumWorkers() {
+    return std::max(1U, std::thread::hardware_concurrency() / 4);
+}
+
+void ShaderPredecoder::Queue(Tegra::Engines::ShaderType stage, u64 unique_identifier,
+                             ProgramCode code, u32 main_offset, CompilerSettings settings,
+                             Tegra::Engines::ConstBufferEngineInterface& engine) {
+    bool spawn_worker = false;
+    {
+        std::scoped_lock lock{mutex};
+        if (jobs.contains(unique_identifier)) {
+            return;
+        }
+        if (jobs.size() >= MAX_JOBS && !EvictOldestJob()) {
+            return;
+        }
+        Job& job = jobs[unique_identifier];
+        job.stage = stage;
+        job.code = std::move(code);
+        job.main_offset = main_offset;
+        job.settings = settings;
+        // Workers have no engine, results that need anything else from it are discarded
+        job.info.guest_driver_profile = engine.AccessGuestDriverProfile();
+        job.info.bound_buffer = engine.GetBoundBuffer();
+        pending.push_back(unique_identifier);
+        insertion_order.push_back(unique_identifier);
+        if (num_workers < max_workers) {
+            ++num_workers;
+            spawn_worker = true;
+        }
+    }
+    if (spawn_worker) {
+        Common::ThreadPool::Instance().Submit(
+            Common::TaskPriority::BackgroundCompile,
+            [this](std::stop_token stop_token) { DecodeJobs(stop_token); },
+            stop_source.get_token(), &workers);
+    }
+}
+
+std::unique_ptr<PredecodedShader> ShaderPredecoder::Take(u64 unique_identifier,
+                                                         Registry& registry) {
+    std::unique_lock lock{mutex};
+    auto it = jobs.find(unique_identifier);
+    if (it == jobs.end()) {
+        return nullptr;
+    }
+    if (it->second.state == JobState::Queued) {
+        // Decoding it on the caller is faster than waiting for a worker to pick it up
+        std::erase(pending, unique_identifier);
+        std::erase(insertion_order, unique_identifier);
+        jobs.erase(it);
+        return nullptr;
+    }
+    // Jobs being decoded are never evicted and only this thread inserts new ones
+    done_cv.wait(lock, [&] { return it->second.state == JobState::Done; });
+    std::unique_ptr<PredecodedShader> result = std::move(it->second.result);
+    std::erase(insertion_order, unique_identifier);
+    jobs.erase(it);
+    lock.unlock();
+
+    // Decoding diverges from the real registry as soon as it needs state the worker didn't have
+    Registry& predecoded_registry = result->registry;
+    if (predecoded_registry.HasMissedLookups() ||
+        predecoded_registry.GetBoundBuffer() != registry.GetBoundBuffer() ||
+        predecoded_registry.AccessGuestDriverProfile().GetTextureHandlerSize() !=
+            registry.AccessGuestDriverProfile().GetTextureHandlerSize()) {
+        return nullptr;
+    }
+    return result;
+}
+
+void ShaderPredecoder::DecodeJobs(std::stop_token stop_token) {
+    while (true) {
+        u64 unique_identifier;
+        Job job;
+        {
+            std::scoped_lock lock{mutex};
+            if (pending.empty() || stop_token.stop_requested()) {
+                --num_workers;
+                return;
+            }
+            unique_identifier = pending.front();
+            pending.pop_front();
+            Job& queued_job = jobs.at(unique_identifier);
+            queued_job.state = JobState::Decoding;
+            job.stage = queued_job.stage;
+            job.code = std::move(queued_job.code);
+            job.main_offset = queued_job.main_offset;
+            job.settings = queued_job.settings;
+            job.info = queued_job.info;
+        }
+        auto result =
+            std::make_unique<PredecodedShader>(job.stage, unique_identifier, std::move(job.code),
+                                               job.main_offset, job.settings, job.info);
+        {
+            std::scoped_lock lock{mutex};
+            Job& decoded_job = jobs.at(unique_identifier);
+            decoded_job.result = std::move(result);
+            decoded_job.state = JobState::Done;
+        }
+        done_cv.notify_all();
+    }
+}
+
+bool ShaderPredecoder::EvictOldestJob() {
+    const auto it = std::ranges::find_if(insertion_order, [this](u64 unique_identifier) {
+        return jobs.at(unique_identifier).state != JobState::Decoding;
+    });
+    if (it == insertion_order.end()) {
+        return false;
+    }
+    const u64 unique_identifier = *it;
+    insertion_order.erase(it);
+    std::erase(pending, unique_identifier);
+    jobs.erase(unique_identifier);
+    return true;
+}
+
+} // namespace VideoCommon::Shader
@@ -0,0 +1,103 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <unordered_map>
+
+#include "common/common_types.h"
+#include "common/thread_pool.h"
+#include "video_core/engines/shader_type.h"
+#include "video_core/shader/compiler_settings.h"
+#include "video_core/shader/memory_util.h"
+#include "video_core/shader/registry.h"
+#include "video_core/shader/shader_ir.h"
+
+namespace VideoCommon::Shader {
+
+/// Program decoded ahead of the draw that uses it, the IR references the code and the registry
+struct PredecodedShader {
+    explicit PredecodedShader(Tegra::Engines::ShaderType stage, u64 unique_identifier_,
+                              ProgramCode code_, u32 main_offset, CompilerSettings settings,
+                              const SerializedRegistryInfo& info);
+
+    u64 unique_identifier;
+    ProgramCode code;
+    Registry registry;
+    ShaderIR ir;
+};
+
+/**
+ * Decodes graphics programs on the shared thread pool as soon as they are bound, so their control
+ * flow analysis and IR are ready when the draw that uses them looks them up.
+ * Workers don't have access to the engine. A program that needs const buffer or sampler state to
+ * be decoded is thrown away when it is taken, and the caller decodes it with the real registry.
+ */
+class ShaderPredecoder {
+public:
+    explicit ShaderPredecoder(std::size_t max_workers_ = DefaultNumWorkers());
+    ~ShaderPredecoder();
+
+    /// Returns the default number of pool tasks decoding at once, a quarter of the host cores.
+    [[nodiscard]] static std::size_t DefaultNumWorkers();
+
+    /// Queues a program to be decoded, programs already queued are ignored.
+    void Queue(Tegra::Engines::ShaderType stage, u64 unique_identifier, ProgramCode code,
+               u32 main_offset, CompilerSettings settings,
+               Tegra::Engines::ConstBufferEngineInterface& engine);
+
+    /**
+     * Takes the decoded program with the given identifier, waiting for it if it's being decoded.
+     * @param registry Registry the caller would decode the program with.
+     * @returns The decoded program, or null when it wasn't queued, hasn't been started or its
+     *          decoding depends on state it didn't have.
+     */
+    [[nodiscard]] std::unique_ptr<PredecodedShader> Take(u64 unique_identifier,
+                                                         Registry& registry);
+
+private:
+    /// Number of programs that can be queued or waiting to be taken
+    static constexpr std::size_t MAX_JOBS = 64;
+
+    enum class JobState {
+        Queued,
+        Decoding,
+        Done,
+    };
+
+    struct Job {
+        JobState state = JobState::Queued;
+        Tegra::Engines::ShaderType stage{};
+        ProgramCode code;
+        u32 main_offset{};
+        CompilerSettings settings;
+        SerializedRegistryInfo info;
+        std::unique_ptr<PredecodedShader> result;
+    };
+
+    /// Decodes pending jobs until there are none left or decoding is cancelled
+    void DecodeJobs(std::stop_token stop_token);
+
+    /// Drops the oldest job workers aren't decoding, returns false when there is none
+    bool EvictOldestJob();
+
+    std::size_t max_workers;   ///< Number of pool tasks allowed to decode at once
+    std::size_t num_workers{}; ///< Number of pool tasks currently queued or decoding
+    std::stop_source stop_source;
+    Common::TaskGroup workers;
+
+    std::mutex mutex;
+    std::condition_variable done_cv;
+    std::unordered_map<u64, Job> jobs;
+    std::deque<u64> pending;         ///< Identifiers to decode in order
+    std::deque<u64> insertion_order; ///< Identifiers of all jobs, oldest first
+};
+
+} // namespace VideoCommon::Shader
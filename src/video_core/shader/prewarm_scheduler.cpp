@@ -0,0 +1,34 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <numeric>
+
+#include "video_core/shader/prewarm_scheduler.h"
+
+namespace VideoCommon::Shader {
+
+PrewarmScheduler::PrewarmScheduler(std::size_t num_workers_)
+    : num_workers{std::max<std::size_t>(num_workers_, 1)} {}
+
+PrewarmScheduler::~PrewarmScheduler() = default;
+
+std::size_t PrewarmScheduler::DefaultNumWorkers() {
+    return Common::ThreadPool::Instance().NumWorkers();
+}
+
+std::vector<std::size_t> PrewarmScheduler::MakeBuildOrder(std::size_t num_items,
+                                                          std::span<const u64> usage_counts) {
+    std::vector<std::size_t> order(num_items);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    if (usage_counts.size() != num_items) {
+        return order;
+    }
+    std::ranges::stable_sort(order, [usage_counts](std::size_t lhs, std::size_t rhs) {
+        return usage_counts[lhs] > usage_counts[rhs];
+    });
+    return order;
+}
+
+} // namespace VideoCommon::Shader
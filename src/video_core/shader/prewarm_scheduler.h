@@ -0,0 +1,99 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/thread_pool.h"
+
+namespace VideoCommon::Shader {
+
+/**
+ * Rebuilds the programs stored in a disk cache on the shared thread pool at boot.
+ * Workers pull items one at a time from a shared queue, so a thread that finishes early keeps
+ * taking work instead of idling on a fixed slice. When usage counts from previous sessions are
+ * known, the most used items are handed out first.
+ */
+class PrewarmScheduler {
+public:
+    explicit PrewarmScheduler(std::size_t num_workers_ = DefaultNumWorkers());
+    ~PrewarmScheduler();
+
+    /// Returns the default number of workers, one per compute thread of the shared pool.
+    [[nodiscard]] static std::size_t DefaultNumWorkers();
+
+    /// Returns the order items are built in, sorted by usage count with ties in storage order.
+    [[nodiscard]] static std::vector<std::size_t> MakeBuildOrder(std::size_t num_items,
+                                                               std::span<const u64> usage_counts);
+
+    /// Returns the number of threads used to build items.
+    [[nodiscard]] std::size_t NumWorkers() const noexcept {
+        return num_workers;
+    }
+
+    /**
+     * Builds all items, blocking until they are built or a stop is requested.
+     * @param num_items    Number of items to build.
+     * @param usage_counts Times each item was used in previous sessions, it may be empty.
+     * @param stop_loading Stops handing out items when requested.
+     * @param make_state   Called on each worker before building, the result lives until it exits.
+     * @param build        Called concurrently with the index of the item to build.
+     * @param on_built     Called with the index of each built item, calls are serialized.
+     */
+    template <typename MakeState, typename Build, typename OnBuilt>
+    void Run(std::size_t num_items, std::span<const u64> usage_counts,
+             std::stop_token stop_loading, MakeState&& make_state, Build&& build,
+             OnBuilt&& on_built) {
+        const std::vector<std::size_t> order = MakeBuildOrder(num_items, usage_counts);
+        std::atomic_size_t next_item{0};
+        std::mutex on_built_mutex;
+
+        const auto worker = [&](std::size_t worker_index) {
+            [[maybe_unused]] const auto state = make_state(worker_index);
+            while (!stop_loading.stop_requested()) {
+                const std::size_t position = next_item.fetch_add(1, std::memory_order_relaxed);
+                if (position >= order.size()) {
+                    return;
+                }
+                const std::size_t index = order[position];
+                build(index);
+
+                std::scoped_lock lock{on_built_mutex};
+                on_built(index);
+            }
+        };
+        // Don't queue workers that would have nothing to build
+        const std::size_t num_tasks = std::min(num_workers, num_items);
+        Common::TaskGroup group;
+        for (std::size_t i = 0; i < num_tasks; ++i) {
+            Common::ThreadPool::Instance().Submit(
+                Common::TaskPriority::BackgroundCompile,
+                [&worker, i](std::stop_token) { worker(i); }, {}, &group);
+        }
+        group.Wait();
+    }
+
+    /// Builds all items without per-thread state.
+    template <typename Build, typename OnBuilt>
+    void Run(std::size_t num_items, std::span<const u64> usage_counts,
+             std::stop_token stop_loading, Build&& build, OnBuilt&& on_built) {
+        Run(
+            num_items, usage_counts, std::move(stop_loading), [](std::size_t) { return 0; },
+            std::forward<Build>(build), std::forward<OnBuilt>(on_built));
+    }
+
+private:
+    std::size_t num_workers;
+};
+
+} // namespace VideoCommon::Shader
@@ -73,6 +73,7 @@ std::optional<u32> Registry::ObtainKey(u32 buffer, u32 offset) {
         return iter->second;
     }
     if (!engine) {
+        missed_lookups = true;
         return std::nullopt;
     }
     const u32 value = engine->AccessConstBuffer32(stage, buffer, offset);
@@ -87,6 +88,7 @@ std::optional<SamplerDescriptor> Registry::ObtainBoundSampler(u32 offset) {
         return iter->second;
     }
     if (!engine) {
+        missed_lookups = true;
         return std::nullopt;
     }
     const SamplerDescriptor value = engine->AccessBoundSampler(stage, offset);
@@ -104,6 +106,7 @@ std::optional<Tegra::Engines::SamplerDescriptor> Registry::ObtainSeparateSampler
         return iter->second;
     }
     if (!engine) {
+        missed_lookups = true;
         return std::nullopt;
     }
 
@@ -121,6 +124,7 @@ std::optional<SamplerDescriptor> Registry::ObtainBindlessSampler(u32 buffer, u32
         return iter->second;
     }
     if (!engine) {
+        missed_lookups = true;
         return std::nullopt;
     }
     const SamplerDescriptor value = engine->AccessBindlessSampler(stage, buffer, offset);
@@ -140,6 +144,18 @@ void Registry::InsertBindlessSampler(u32 buffer, u32 offset, SamplerDescriptor s
     bindless_samplers.insert_or_assign({buffer, offset}, sampler);
 }
 
+void Registry::InsertSpecializedKey(u32 buffer, u32 offset, u32 value) {
+    specialized_keys.insert_or_assign({buffer, offset}, value);
+}
+
+std::optional<u32> Registry::GetSpecializedKey(u32 buffer, u32 offset) const {
+    const auto iter = specialized_keys.find({buffer, offset});
+    if (iter == specialized_keys.end()) {
+        return std::nullopt;
+    }
+    return iter->second;
+}
+
 bool Registry::IsConsistent() const {
     if (!engine) {
         return true;
@@ -9,6 +9,7 @@
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "common/common_types.h"
 #include "common/hash.h"
@@ -49,6 +50,11 @@ struct equal_to<VideoCommon::Shader::SeparateSamplerKey> {
 namespace VideoCommon::Shader {
 
 using KeyMap = std::unordered_map<std::pair<u32, u32>, u32, Common::PairHash>;
+using SpecializationKeys = std::vector<std::pair<u32, u32>>;
+
+/// Maximum number of const buffer words a shader is specialized on
+constexpr std::size_t MAX_SPECIALIZATION_KEYS = 4;
+using SpecializationValues = std::array<u32, MAX_SPECIALIZATION_KEYS>;
 using BoundSamplerMap = std::unordered_map<u32, Tegra::Engines::SamplerDescriptor>;
 using SeparateSamplerMap =
     std::unordered_map<SeparateSamplerKey, Tegra::Engines::SamplerDescriptor>;
@@ -118,6 +124,12 @@ public:
     /// Inserts a bindless sampler key.
     void InsertBindlessSampler(u32 buffer, u32 offset, Tegra::Engines::SamplerDescriptor sampler);
 
+    /// Inserts a const buffer value to be folded into shaders decoded with this registry.
+    void InsertSpecializedKey(u32 buffer, u32 offset, u32 value);
+
+    /// Returns the value a const buffer word has been specialized on, if any.
+    std::optional<u32> GetSpecializedKey(u32 buffer, u32 offset) const;
+
     /// Checks keys and samplers against engine's current const buffers.
     /// Returns true if they are the same value, false otherwise.
     bool IsConsistent() const;
@@ -146,11 +158,21 @@ public:
         return bindless_samplers;
     }
 
+    /// Gets the const buffer values shaders decoded with this registry are specialized on.
+    const KeyMap& GetSpecializedKeys() const {
+        return specialized_keys;
+    }
+
     /// Gets bound buffer used on this shader
     u32 GetBoundBuffer() const {
         return bound_buffer;
     }
 
+    /// Returns true when a key or sampler was requested without an engine to obtain it from.
+    bool HasMissedLookups() const {
+        return missed_lookups;
+    }
+
     /// Obtains access to the guest driver's profile.
     VideoCore::GuestDriverProfile& AccessGuestDriverProfile() {
         return engine ? engine->AccessGuestDriverProfile() : stored_guest_driver_profile;
@@ -164,9 +186,11 @@ private:
     BoundSamplerMap bound_samplers;
     SeparateSamplerMap separate_samplers;
     BindlessSamplerMap bindless_samplers;
+    KeyMap specialized_keys;
     u32 bound_buffer;
     GraphicsInfo graphics_info;
     ComputeInfo compute_info;
+    bool missed_lookups = false;
 };
 
 } // namespace VideoCommon::Shader
@@ -31,6 +31,7 @@ ShaderIR::ShaderIR(const ProgramCode& program_code_, u32 main_offset_, CompilerS
                                                                                        registry_} {
     Decode();
     PostDecode();
+    Optimize();
 }
 
 ShaderIR::~ShaderIR() = default;
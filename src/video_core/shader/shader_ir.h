@@ -190,6 +190,10 @@ public:
         return num_custom_variables;
     }
 
+    /// Returns the const buffer words that predicates are computed from and that would fold into
+    /// constants if their values were known, shaders can be specialized on their values.
+    SpecializationKeys FindSpecializationKeys() const;
+
 private:
     friend class ASTDecoder;
 
@@ -207,6 +211,9 @@ private:
     void Decode();
     void PostDecode();
 
+    /// Folds constants, simplifies predicates and removes dead stores once decoding has finished
+    void Optimize();
+
     NodeBlock DecodeRange(u32 begin, u32 end);
     void DecodeRangeInner(NodeBlock& bb, u32 begin, u32 end);
     void InsertControlFlow(NodeBlock& bb, const ShaderBlock& block);
@@ -344,6 +351,9 @@ private:
     std::optional<SamplerEntry> GetBindlessSampler(Tegra::Shader::Register reg, SamplerInfo info,
                                                    Node& index_var);
 
+    /// Marks a sampler as accessed with texel coordinates or queried for its dimensions.
+    void MarkSamplerFetched(const std::optional<SamplerEntry>& sampler);
+
     /// Accesses an image.
     ImageEntry& GetImage(Tegra::Shader::Image image, Tegra::Shader::ImageType type);
 
@@ -458,6 +458,9 @@ SurfaceType GetFormatType(PixelFormat pixel_format);
 
 bool IsPixelFormatASTC(PixelFormat format);
 
+/// Returns true for the BC1 to BC5 formats, BC6H and BC7 are not included
+bool IsPixelFormatBC1To5(PixelFormat format);
+
 bool IsPixelFormatSRGB(PixelFormat format);
 
 std::pair<u32, u32> GetASTCBlockSize(PixelFormat format);
@@ -0,0 +1,174 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <span>
+
+#include "common/common_types.h"
+#include "common/div_ceil.h"
+#include "video_core/texture_cache/encode_bc3.h"
+#include "video_core/texture_cache/types.h"
+
+namespace VideoCommon {
+
+namespace {
+
+constexpr u32 BLOCK_SIZE = 4;
+constexpr u32 BYTES_PER_BLOCK = 16;
+
+using Pixel = std::array<u8, 4>;
+using Block = std::array<Pixel, BLOCK_SIZE * BLOCK_SIZE>;
+
+[[nodiscard]] constexpr u16 PackRGB565(u32 r, u32 g, u32 b) {
+    return static_cast<u16>(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+}
+
+[[nodiscard]] constexpr std::array<u32, 3> UnpackRGB565(u16 color) {
+    const u32 r = (color >> 11) & 0x1f;
+    const u32 g = (color >> 5) & 0x3f;
+    const u32 b = color & 0x1f;
+    return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+// https://www.khronos.org/registry/OpenGL/extensions/EXT/EXT_texture_compression_s3tc.txt
+[[nodiscard]] u64 EncodeAlphaBlock(const Block& block) {
+    u32 min_alpha = 0xff;
+    u32 max_alpha = 0;
+    for (const Pixel& pixel : block) {
+        min_alpha = std::min<u32>(min_alpha, pixel[3]);
+        max_alpha = std::max<u32>(max_alpha, pixel[3]);
+    }
+    u64 bits = max_alpha | (min_alpha << 8);
+    if (min_alpha == max_alpha) {
+        return bits;
+    }
+    // With alpha0 > alpha1 the palette holds 6 values interpolated between the endpoints.
+    // Find the nearest step counting from the minimum and remap it to its code.
+    const u32 range = max_alpha - min_alpha;
+    for (u32 i = 0; i < block.size(); ++i) {
+        const u32 step = ((block[i][3] - min_alpha) * 7 + range / 2) / range;
+        const u64 code = step == 7 ? 0 : (step == 0 ? 1 : 8 - step);
+        bits |= code << (16 + 3 * i);
+    }
+    return bits;
+}
+
+[[nodiscard]] u64 EncodeColorBlock(const Block& block) {
+    std::array<u32, 3> min_color{0xff, 0xff, 0xff};
+    std::array<u32, 3> max_color{0, 0, 0};
+    for (const Pixel& pixel : block) {
+        for (size_t channel = 0; channel < 3; ++channel) {
+            min_color[channel] = std::min<u32>(min_color[channel], pixel[channel]);
+            max_color[channel] = std::max<u32>(max_color[channel], pixel[channel]);
+        }
+    }
+    // Inset the bounding box slightly, this reduces the error of the interpolated colors
+    for (size_t channel = 0; channel < 3; ++channel) {
+        const u32 inset = (max_color[channel] - min_color[channel]) / 16;
+        min_color[channel] += inset;
+        max_color[channel] -= inset;
+    }
+    // The bounding box diagonal only follows the colors when all channels grow together,
+    // flip the channels that decrease while the channel with the widest range increases
+    size_t main_channel = 0;
+    for (size_t channel = 1; channel < 3; ++channel) {
+        if (max_color[channel] - min_color[channel] >
+            max_color[main_channel] - min_color[main_channel]) {
+            main_channel = channel;
+        }
+    }
+    std::array<u32, 3> end_color0 = max_color;
+    std::array<u32, 3> end_color1 = min_color;
+    for (size_t channel = 0; channel < 3; ++channel) {
+        if (channel == main_channel) {
+            continue;
+        }
+        const s32 center_main = static_cast<s32>(min_color[main_channel] + max_color[main_channel]);
+        const s32 center = static_cast<s32>(min_color[channel] + max_color[channel]);
+        s32 covariance = 0;
+        for (const Pixel& pixel : block) {
+            covariance += (2 * pixel[main_channel] - center_main) * (2 * pixel[channel] - center);
+        }
+        if (covariance < 0) {
+            std::swap(end_color0[channel], end_color1[channel]);
+        }
+    }
+    u16 color0 = PackRGB565(end_color0[0], end_color0[1], end_color0[2]);
+    u16 color1 = PackRGB565(end_color1[0], end_color1[1], end_color1[2]);
+    if (color0 < color1) {
+        std::swap(color0, color1);
+    }
+    u64 bits = color0 | (u64{color1} << 16);
+    if (color0 == color1) {
+        return bits;
+    }
+    const auto endpoint0 = UnpackRGB565(color0);
+    const auto endpoint1 = UnpackRGB565(color1);
+    std::array<std::array<u32, 3>, 4> palette;
+    for (size_t channel = 0; channel < 3; ++channel) {
+        palette[0][channel] = endpoint0[channel];
+        palette[1][channel] = endpoint1[channel];
+        palette[2][channel] = (2 * endpoint0[channel] + endpoint1[channel]) / 3;
+        palette[3][channel] = (endpoint0[channel] + 2 * endpoint1[channel]) / 3;
+    }
+    for (u32 i = 0; i < block.size(); ++i) {
+        u64 best_code = 0;
+        s32 best_error = std::numeric_limits<s32>::max();
+        for (u32 code = 0; code < palette.size(); ++code) {
+            s32 error = 0;
+            for (size_t channel = 0; channel < 3; ++channel) {
+                const s32 delta =
+                    static_cast<s32>(block[i][channel]) - static_cast<s32>(palette[code][channel]);
+                error += delta * delta;
+            }
+            if (error < best_error) {
+                best_error = error;
+                best_code = code;
+            }
+        }
+        bits |= best_code << (32 + 2 * i);
+    }
+    return bits;
+}
+
+} // Anonymous namespace
+
+u32 CalculateBC3SizeBytes(Extent3D extent) noexcept {
+    return Common::DivCeil(extent.width, BLOCK_SIZE) * Common::DivCeil(extent.height, BLOCK_SIZE) *
+           extent.depth * BYTES_PER_BLOCK;
+}
+
+void CompressBC3(std::span<const u8> input, Extent3D extent, std::span<u8> output) {
+    const u32 blocks_x = Common::DivCeil(extent.width, BLOCK_SIZE);
+    const u32 blocks_y = Common::DivCeil(extent.height, BLOCK_SIZE);
+    size_t output_offset = 0;
+    Block block;
+    for (u32 slice = 0; slice < extent.depth; ++slice) {
+        const size_t slice_offset = static_cast<size_t>(slice) * extent.width * extent.height;
+        for (u32 block_y = 0; block_y < blocks_y; ++block_y) {
+            for (u32 block_x = 0; block_x < blocks_x; ++block_x) {
+                // Replicate the edge pixels on blocks that cross the image bounds
+                for (u32 y = 0; y < BLOCK_SIZE; ++y) {
+                    const u32 linear_y = std::min(block_y * BLOCK_SIZE + y, extent.height - 1);
+                    for (u32 x = 0; x < BLOCK_SIZE; ++x) {
+                        const u32 linear_x = std::min(block_x * BLOCK_SIZE + x, extent.width - 1);
+                        const size_t offset = slice_offset + linear_y * extent.width + linear_x;
+                        std::memcpy(block[y * BLOCK_SIZE + x].data(), &input[offset * 4],
+                                    sizeof(Pixel));
+                    }
+                }
+                const u64 alpha_bits = EncodeAlphaBlock(block);
+                const u64 color_bits = EncodeColorBlock(block);
+                std::memcpy(&output[output_offset], &alpha_bits, sizeof(alpha_bits));
+                std::memcpy(&output[output_offset + 8], &color_bits, sizeof(color_bits));
+                output_offset += BYTES_PER_BLOCK;
+            }
+        }
+    }
+}
+
+} // namespace VideoCommon
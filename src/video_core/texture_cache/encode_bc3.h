@@ -0,0 +1,20 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <span>
+
+#include "common/common_types.h"
+#include "video_core/texture_cache/types.h"
+
+namespace VideoCommon {
+
+/// Returns the size in bytes of a BC3 image with the given dimensions.
+[[nodiscard]] u32 CalculateBC3SizeBytes(Extent3D extent) noexcept;
+
+/// Compresses a linear A8B8G8R8 image into BC3 blocks, the extent doesn't have to be 4x4 aligned.
+void CompressBC3(std::span<const u8> input, Extent3D extent, std::span<u8> output);
+
+} // namespace VideoCommon
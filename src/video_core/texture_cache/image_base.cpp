@@ -133,6 +133,17 @@ bool ImageBase::IsSafeDownload() const noexcept {
     return true;
 }
 
+bool ImageBase::IsRescalable() const noexcept {
+    static constexpr u32 MIN_RESCALE_SIZE = 128;
+    if (True(flags & (ImageFlagBits::NoRescale | ImageFlagBits::Converted))) {
+        return false;
+    }
+    // Only plain render targets are scaled, guests rarely index the texels of anything else
+    return info.type == ImageType::e2D && info.num_samples == 1 && info.resources.levels == 1 &&
+           info.resources.layers == 1 && info.size.width >= MIN_RESCALE_SIZE &&
+           info.size.height >= MIN_RESCALE_SIZE;
+}
+
 void ImageBase::CheckBadOverlapState() {
     if (False(flags & ImageFlagBits::BadOverlap)) {
         return;
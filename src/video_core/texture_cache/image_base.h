@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <optional>
 #include <vector>
@@ -27,6 +28,9 @@ enum class ImageFlagBits : u32 {
     Picked = 1 << 7,      ///< Temporary flag to mark the image as picked
     Remapped = 1 << 8,    ///< Image has been remapped.
     Sparse = 1 << 9,      ///< Image has non continous submemory.
+    Transcoded = 1 << 12, ///< Converted image is stored as BC3 instead of A8B8G8R8
+    Rescaled = 1 << 13,   ///< Contents are stored below the native resolution
+    NoRescale = 1 << 14,  ///< Accessed in guest pixel coordinates, it must stay at native size
 
     // Garbage Collection Flags
     BadOverlap = 1 << 10, ///< This image overlaps other but doesn't fit, has higher
@@ -38,6 +42,11 @@ DECLARE_ENUM_FLAG_OPERATORS(ImageFlagBits)
 
 struct ImageViewInfo;
 
+/// Returns a dimension scaled by up / (1 << shift), never smaller than one
+[[nodiscard]] constexpr u32 ScaleDimension(u32 value, u32 up, u32 shift) noexcept {
+    return std::max((value * up) >> shift, 1U);
+}
+
 struct AliasedImage {
     std::vector<ImageCopy> copies;
     ImageId id;
@@ -54,6 +63,9 @@ struct ImageBase {
 
     [[nodiscard]] bool IsSafeDownload() const noexcept;
 
+    /// Returns true when the image can be rendered below its native resolution
+    [[nodiscard]] bool IsRescalable() const noexcept;
+
     [[nodiscard]] bool Overlaps(VAddr overlap_cpu_addr, size_t overlap_size) const noexcept {
         const VAddr overlap_end = overlap_cpu_addr + overlap_size;
         return cpu_addr < overlap_end && overlap_cpu_addr < cpu_addr_end;
@@ -81,6 +93,10 @@ struct ImageBase {
 
     u64 modification_tick = 0;
     u64 frame_tick = 0;
+    /// Hash of the guest data last uploaded, zero when the image contents no longer match it
+    u64 content_hash = 0;
+    /// First mip level with valid contents, the levels before it are still being streamed in
+    s32 resident_level = 0;
 
     std::array<u32, MAX_MIP_LEVELS> mip_level_offsets{};
 
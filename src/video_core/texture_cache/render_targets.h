@@ -28,6 +28,7 @@ struct RenderTargets {
     ImageViewId depth_buffer_id;
     std::array<u8, NUM_RT> draw_buffers{};
     Extent2D size;
+    bool is_rescaled{};
 };
 
 } // namespace VideoCommon
@@ -44,6 +45,7 @@ struct hash<VideoCommon::RenderTargets> {
         }
         value ^= Common::BitCast<u64>(rt.draw_buffers);
         value ^= Common::BitCast<u64>(rt.size);
+        value ^= static_cast<size_t>(rt.is_rescaled) << 63;
         return value;
     }
 };
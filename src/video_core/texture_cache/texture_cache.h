@@ -6,7 +6,11 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <bit>
+#include <chrono>
+#include <cstring>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -20,10 +24,13 @@
 #include <boost/container/small_vector.hpp>
 
 #include "common/alignment.h"
+#include "common/cityhash.h"
 #include "common/common_types.h"
 #include "common/literals.h"
 #include "common/logging/log.h"
 #include "common/settings.h"
+#include "core/core.h"
+#include "core/perf_stats.h"
 #include "video_core/compatible_formats.h"
 #include "video_core/delayed_destruction_ring.h"
 #include "video_core/dirty_flags.h"
@@ -74,6 +81,10 @@ class TextureCache {
     static constexpr bool HAS_EMULATED_COPIES = P::HAS_EMULATED_COPIES;
     /// True when the API can provide info about the memory of the device.
     static constexpr bool HAS_DEVICE_MEMORY_INFO = P::HAS_DEVICE_MEMORY_INFO;
+    /// True when downloads can be recorded into staging memory and read after a fence
+    static constexpr bool IMPLEMENTS_ASYNC_DOWNLOADS = P::IMPLEMENTS_ASYNC_DOWNLOADS;
+    /// True when images can tell if their memory keeps a mostly empty allocation alive
+    static constexpr bool HAS_MEMORY_DEFRAGMENTATION = P::HAS_MEMORY_DEFRAGMENTATION;
 
     /// Image view ID for null descriptors
     static constexpr ImageViewId NULL_IMAGE_VIEW_ID{0};
@@ -83,12 +94,45 @@ class TextureCache {
     static constexpr u64 DEFAULT_EXPECTED_MEMORY = 1_GiB;
     static constexpr u64 DEFAULT_CRITICAL_MEMORY = 2_GiB;
 
+    /// Images at least this large upload their larger mip levels over the next frames
+    static constexpr u32 STREAMING_MIN_SIZE = 4_MiB;
+    /// Smallest mip levels of a streamed image uploaded on its first use
+    static constexpr size_t STREAMING_TAIL_SIZE = 256_KiB;
+    /// Guest bytes of streamed mip levels uploaded on each frame
+    static constexpr size_t STREAMING_FRAME_BYTES = 16_MiB;
+    /// Host time spent uploading streamed mip levels on each frame
+    static constexpr std::chrono::microseconds STREAMING_FRAME_TIME{2000};
+
     using Runtime = typename P::Runtime;
     using Image = typename P::Image;
     using ImageAlloc = typename P::ImageAlloc;
     using ImageView = typename P::ImageView;
     using Sampler = typename P::Sampler;
     using Framebuffer = typename P::Framebuffer;
+    using AsyncBuffer = typename P::AsyncBuffer;
+
+    /// Image contents waiting in a staging buffer to be swizzled into guest memory
+    struct AsyncImageDownload {
+        ImageInfo info;
+        GPUVAddr gpu_addr;
+        VAddr cpu_addr;
+        size_t size_bytes;
+        size_t staging_offset;
+    };
+
+    /// Downloads recorded when a fence was signaled, written back once the fence is reached
+    struct PendingImageDownloads {
+        AsyncBuffer staging{};
+        std::vector<AsyncImageDownload> images;
+    };
+
+    /// Result of a recent image lookup, valid until images are registered or unregistered
+    struct ImageLookup {
+        GPUVAddr gpu_addr = 0;
+        ImageInfo info;
+        RelaxedOptions options{};
+        ImageId image_id{};
+    };
 
     struct BlitImages {
         ImageId dst_id;
@@ -111,6 +155,11 @@ public:
     /// Notify the cache that a new frame has been queued
     void TickFrame();
 
+    /// Return the host memory held by the cached images, can be called from any thread
+    [[nodiscard]] u64 GetUsedMemory() const noexcept {
+        return total_used_memory.load(std::memory_order_relaxed);
+    }
+
     /// Return a constant reference to the given image view id
     [[nodiscard]] const ImageView& GetImageView(ImageViewId id) const noexcept;
 
@@ -124,11 +173,19 @@ public:
     /// Fill image_view_ids with the compute images in indices
     void FillComputeImageViews(std::span<const u32> indices, std::span<ImageViewId> image_view_ids);
 
-    /// Get the sampler from the graphics descriptor table in the specified index
-    Sampler* GetGraphicsSampler(u32 index);
+    /// Keep the graphics images in indices at native resolution, as they are read by texel
+    void RequireNativeGraphicsImages(std::span<const u32> indices);
+
+    /// Keep the compute images in indices at native resolution, as they are read by texel
+    void RequireNativeComputeImages(std::span<const u32> indices);
 
-    /// Get the sampler from the compute descriptor table in the specified index
-    Sampler* GetComputeSampler(u32 index);
+    /// Get the sampler from the graphics descriptor table in the specified index, clamped to the
+    /// mip levels of the image view in image_index that have been streamed in
+    Sampler* GetGraphicsSampler(u32 index, u32 image_index);
+
+    /// Get the sampler from the compute descriptor table in the specified index, clamped to the
+    /// mip levels of the image view in image_index that have been streamed in
+    Sampler* GetComputeSampler(u32 index, u32 image_index);
 
     /// Refresh the state for graphics image view and sampler descriptors
     void SynchronizeGraphicsDescriptors();
@@ -137,8 +194,12 @@ public:
     void SynchronizeComputeDescriptors();
 
     /// Update bound render targets and upload memory if necessary
-    /// @param is_clear True when the render targets are being used for clears
-    void UpdateRenderTargets(bool is_clear);
+    /// @param is_clear       True when the render targets are being used for clears
+    /// @param require_native True when the bound shaders depend on guest pixel coordinates
+    void UpdateRenderTargets(bool is_clear, bool require_native = false);
+
+    /// Returns the factor the bound render targets are scaled by, one when they are native
+    [[nodiscard]] float RenderTargetScale() const noexcept;
 
     /// Find a framebuffer with the currently bound render targets
     /// UpdateRenderTargets should be called before this
@@ -224,6 +285,24 @@ private:
     /// Runs the Garbage Collector.
     void RunGarbageCollector();
 
+    /// Records the downloads of the uncommitted images into a staging buffer without waiting
+    void CommitAsyncDownloads();
+
+    /// Swizzles pending asynchronous downloads into guest memory and releases their staging
+    void WriteBackPendingDownloads(PendingImageDownloads& pending);
+
+    /// Waits for and writes back asynchronous downloads overlapping the given region
+    void WaitPendingDownloads(VAddr cpu_addr, size_t size);
+
+    /// Evicts the least recently used images while the cache is over its memory budget.
+    void RunBudgetEviction();
+
+    /// Removes an image from the cache, writing its contents back to guest memory when requested
+    void EvictImage(ImageId image_id, bool download);
+
+    /// Evicts unused images in sparse allocations, so they are recreated in denser memory
+    void RunDefragmentation();
+
     /// Fills image_view_ids in the image views in indices
     void FillImageViews(DescriptorTable<TICEntry>& table,
                         std::span<ImageViewId> cached_image_view_ids, std::span<const u32> indices,
@@ -233,12 +312,51 @@ private:
     ImageViewId VisitImageView(DescriptorTable<TICEntry>& table,
                                std::span<ImageViewId> cached_image_view_ids, u32 index);
 
+    /// Restore the images in indices to native resolution and keep them there
+    void RequireNativeImages(DescriptorTable<TICEntry>& table,
+                             std::span<ImageViewId> cached_image_view_ids,
+                             std::span<const u32> indices);
+
+    /// Bring the bound render targets to a common resolution, below native when possible
+    void RescaleRenderTargets(bool require_native);
+
+    /// Store an image below native resolution, returns true when the image is rescaled
+    bool ScaleUp(ImageId image_id);
+
+    /// Restore an image to native resolution, keeping it there for good when requested
+    void ScaleDown(ImageId image_id, bool keep_native);
+
+    /// Recreate the views of an image and drop its framebuffers after its storage has changed
+    void InvalidateScale(ImageId image_id);
+
+    /// Scale a region in native texels to the rescaled resolution
+    [[nodiscard]] Region2D ScaleRegion(const Region2D& region) const noexcept;
+
     /// Find or create a framebuffer with the given render target parameters
     FramebufferId GetFramebufferId(const RenderTargets& key);
 
     /// Refresh the contents (pixel data) of an image
     void RefreshContents(Image& image, ImageId image_id);
 
+    /// Copy the contents of an identical image uploaded before, returns true on success
+    [[nodiscard]] bool TryDeduplicateUpload(Image& image, ImageId image_id);
+
+    /// Upload the smallest mip levels of a large image, returns true when the others are streamed
+    [[nodiscard]] bool StartStreaming(Image& image, ImageId image_id);
+
+    /// Upload the mip levels in [first_level, last_level) of an image from guest memory
+    void UploadImageLevels(Image& image, s32 first_level, s32 last_level);
+
+    /// Upload the next mip levels of streamed images within the frame budget
+    void StreamImages();
+
+    /// Upload every mip level of an image that is still being streamed in
+    void FinishStreaming(ImageId image_id);
+
+    /// Find a sampler that only samples the mip levels of an image view that have been streamed in
+    [[nodiscard]] SamplerId ClampStreamedLevels(SamplerId sampler_id, const TSCEntry& config,
+                                                ImageViewId image_view_id);
+
     /// Upload data from guest to an image
     template <typename StagingBuffer>
     void UploadImageContents(Image& image, StagingBuffer& staging_buffer);
@@ -257,6 +375,13 @@ private:
     [[nodiscard]] ImageId FindImage(const ImageInfo& info, GPUVAddr gpu_addr,
                                     RelaxedOptions options);
 
+    /// Find an image in the recent lookup cache, returns an invalid id on misses
+    [[nodiscard]] ImageId FindCachedImage(const ImageInfo& info, GPUVAddr gpu_addr,
+                                          RelaxedOptions options) const noexcept;
+
+    /// Drop all recent image lookups
+    void ClearImageLookups() noexcept;
+
     /// Create an image from the given parameters
     [[nodiscard]] ImageId InsertImage(const ImageInfo& info, GPUVAddr gpu_addr,
                                       RelaxedOptions options);
@@ -323,7 +448,8 @@ private:
     /// Mark an image as modified from the GPU
     void MarkModification(ImageBase& image) noexcept;
 
-    /// Synchronize image aliases, copying data if needed
+    /// Synchronize image aliases, copying or converting data only from aliases modified after the
+    /// image was last written or synchronized
     void SynchronizeAliases(ImageId image_id);
 
     /// Prepare an image to be used
@@ -345,6 +471,9 @@ private:
     /// Returns true if the current clear parameters clear the whole image of a given image view
     [[nodiscard]] bool IsFullClear(ImageViewId id);
 
+    /// Returns true if accelerated uploads of the format decode it into A8B8G8R8 on the host
+    [[nodiscard]] bool IsDecodedOnUpload(PixelFormat format) const noexcept;
+
     Runtime& runtime;
     VideoCore::RasterizerInterface& rasterizer;
     Tegra::Engines::Maxwell3D& maxwell3d;
@@ -373,10 +502,15 @@ private:
 
     std::unordered_map<ImageId, std::vector<ImageViewId>> sparse_views;
 
+    /// Render targets and samplers look up the same few images over and over within a frame
+    static constexpr size_t NUM_IMAGE_LOOKUPS = 16;
+    std::array<ImageLookup, NUM_IMAGE_LOOKUPS> image_lookups;
+    size_t image_lookup_cursor = 0;
+
     VAddr virtual_invalid_space{};
 
     bool has_deleted_images = false;
-    u64 total_used_memory = 0;
+    std::atomic<u64> total_used_memory{0};
     u64 minimum_memory;
     u64 expected_memory;
     u64 critical_memory;
@@ -391,6 +525,14 @@ private:
     // TODO: This data structure is not optimal and it should be reworked
     std::vector<ImageId> uncommitted_downloads;
     std::queue<std::vector<ImageId>> committed_downloads;
+    std::deque<PendingImageDownloads> pending_downloads;
+    bool use_async_downloads = false;
+    bool use_memory_defragmentation = false;
+    size_t frame_image_insertions = 0;
+
+    /// Rescaled images are stored at (native * rescale_up) >> rescale_shift
+    u32 rescale_up = 1;
+    u32 rescale_shift = 0;
 
     static constexpr size_t TICKS_TO_DESTROY = 6;
     DelayedDestructionRing<Image, TICKS_TO_DESTROY> sentenced_images;
@@ -399,6 +541,13 @@ private:
 
     std::unordered_map<GPUVAddr, ImageAllocId> image_allocs_table;
 
+    /// Last image uploaded with the guest data of each content hash
+    std::unordered_map<u64, ImageId> content_hash_images;
+    std::vector<u8> content_hash_buffer;
+
+    /// Images with mip levels still waiting to be uploaded, oldest first
+    std::deque<ImageId> streaming_images;
+
     u64 modification_tick = 0;
     u64 frame_tick = 0;
     typename SlotVector<Image>::Iterator deletion_iterator;
@@ -425,15 +574,42 @@ TextureCache<P>::TextureCache(Runtime& runtime_, VideoCore::RasterizerInterface&
 
     deletion_iterator = slot_images.begin();
 
+    if constexpr (IMPLEMENTS_ASYNC_DOWNLOADS) {
+        use_async_downloads = Settings::values.use_asynchronous_downloads.GetValue();
+    }
+    if constexpr (HAS_MEMORY_DEFRAGMENTATION) {
+        use_memory_defragmentation = Settings::values.use_memory_defragmentation.GetValue();
+    }
+    switch (Settings::values.render_scale.GetValue()) {
+    case Settings::RenderScale::Native:
+        break;
+    case Settings::RenderScale::ThreeQuarters:
+        rescale_up = 3;
+        rescale_shift = 2;
+        break;
+    case Settings::RenderScale::Half:
+        rescale_up = 1;
+        rescale_shift = 1;
+        break;
+    }
+
+    u64 device_memory = 0;
     if constexpr (HAS_DEVICE_MEMORY_INFO) {
-        const auto device_memory = runtime.GetDeviceLocalMemory();
+        device_memory = runtime.GetDeviceLocalMemory();
+    }
+    const u64 memory_budget = static_cast<u64>(Settings::values.vram_budget.GetValue()) * 1_MiB;
+    if (memory_budget != 0) {
+        expected_memory = memory_budget / 2;
+        critical_memory = memory_budget;
+        minimum_memory = 0;
+    } else if (device_memory != 0) {
         const u64 possible_expected_memory = (device_memory * 3) / 10;
         const u64 possible_critical_memory = (device_memory * 6) / 10;
         expected_memory = std::max(possible_expected_memory, DEFAULT_EXPECTED_MEMORY);
         critical_memory = std::max(possible_critical_memory, DEFAULT_CRITICAL_MEMORY);
         minimum_memory = 0;
     } else {
-        // on OGL we can be more conservatives as the driver takes care.
+        // When the device memory is unknown, be conservative as the driver takes care.
         expected_memory = DEFAULT_EXPECTED_MEMORY + 512_MiB;
         critical_memory = DEFAULT_CRITICAL_MEMORY + 1_GiB;
         minimum_memory = expected_memory;
@@ -476,27 +652,14 @@ void TextureCache<P>::RunGarbageCollector() {
                     continue;
                 }
             }
-            if (!is_bad_overlap && must_download) {
-                const bool alias_check = std::ranges::none_of(
-                    image->aliased_images, [&, image](const AliasedImage& alias) {
-                        auto& alias_image = slot_images[alias.id];
-                        return (alias_image.frame_tick < image->frame_tick) ||
-                               (alias_image.modification_tick < image->modification_tick);
-                    });
-
-                if (alias_check) {
-                    auto map = runtime.DownloadStagingBuffer(image->unswizzled_size_bytes);
-                    const auto copies = FullDownloadCopies(image->info);
-                    image->DownloadMemory(map, copies);
-                    runtime.Finish();
-                    SwizzleImage(gpu_memory, image->gpu_addr, image->info, copies, map.mapped_span);
-                }
-            }
-            if (True(image->flags & ImageFlagBits::Tracked)) {
-                UntrackImage(*image, image_id);
-            }
-            UnregisterImage(image_id);
-            DeleteImage(image_id);
+            const bool download =
+                !is_bad_overlap && must_download &&
+                std::ranges::none_of(image->aliased_images, [&, image](const AliasedImage& alias) {
+                    auto& alias_image = slot_images[alias.id];
+                    return (alias_image.frame_tick < image->frame_tick) ||
+                           (alias_image.modification_tick < image->modification_tick);
+                });
+            EvictImage(image_id, download);
             if (is_bad_overlap) {
                 ++num_iterations;
             }
@@ -505,11 +668,109 @@ void TextureCache<P>::RunGarbageCollector() {
     }
 }
 
+template <class P>
+void TextureCache<P>::RunBudgetEviction() {
+    // Images used in the last frames are likely still in use, leave them to the regular collector
+    static constexpr u64 MIN_TICKS_UNUSED = 4;
+    // Downloads stall the GPU, spread them across frames
+    static constexpr size_t MAX_DOWNLOADS_PER_FRAME = 8;
+    static constexpr size_t MAX_EVICTIONS_PER_FRAME = 256;
+
+    std::vector<std::pair<u64, ImageId>> candidates;
+    for (auto [image_id, image] : slot_images) {
+        if (image->frame_tick + MIN_TICKS_UNUSED < frame_tick) {
+            candidates.emplace_back(image->frame_tick, image_id);
+        }
+    }
+    std::ranges::sort(candidates);
+
+    size_t num_downloads = 0;
+    size_t num_evictions = 0;
+    for (const auto& [tick, image_id] : candidates) {
+        if (total_used_memory < expected_memory || num_evictions == MAX_EVICTIONS_PER_FRAME) {
+            break;
+        }
+        const bool must_download = slot_images[image_id].IsSafeDownload();
+        if (must_download) {
+            if (num_downloads == MAX_DOWNLOADS_PER_FRAME) {
+                continue;
+            }
+            ++num_downloads;
+        }
+        EvictImage(image_id, must_download);
+        ++num_evictions;
+    }
+    // The iterator may point to a deleted image
+    deletion_iterator = slot_images.begin();
+}
+
+template <class P>
+void TextureCache<P>::EvictImage(ImageId image_id, bool download) {
+    if (download) {
+        ScaleDown(image_id, true);
+    }
+    Image& image = slot_images[image_id];
+    if (download) {
+        auto map = runtime.DownloadStagingBuffer(image.unswizzled_size_bytes);
+        const auto copies = FullDownloadCopies(image.info);
+        image.DownloadMemory(map, copies);
+        runtime.Finish();
+        SwizzleImage(gpu_memory, image.gpu_addr, image.info, copies, map.mapped_span);
+    }
+    if (True(image.flags & ImageFlagBits::Tracked)) {
+        UntrackImage(image, image_id);
+    }
+    UnregisterImage(image_id);
+    DeleteImage(image_id);
+}
+
+template <class P>
+void TextureCache<P>::RunDefragmentation() {
+    static constexpr u64 MIN_TICKS_UNUSED = 30;
+    static constexpr size_t MAX_RELOCATIONS_PER_FRAME = 16;
+
+    // Recreated images pick dense allocations first, leaving the sparse ones to drain.
+    // Only images whose contents are still in guest memory are moved, to avoid downloads.
+    boost::container::small_vector<ImageId, MAX_RELOCATIONS_PER_FRAME> candidates;
+    for (auto [image_id, image] : slot_images) {
+        if (candidates.size() == MAX_RELOCATIONS_PER_FRAME) {
+            break;
+        }
+        if (image->frame_tick + MIN_TICKS_UNUSED >= frame_tick ||
+            True(image->flags & ImageFlagBits::GpuModified) || !image->aliased_images.empty() ||
+            !image->overlapping_images.empty() || !image->IsInSparseMemory()) {
+            continue;
+        }
+        candidates.push_back(image_id);
+    }
+    for (const ImageId image_id : candidates) {
+        EvictImage(image_id, false);
+    }
+    // The iterator may point to a deleted image
+    deletion_iterator = slot_images.begin();
+}
+
 template <class P>
 void TextureCache<P>::TickFrame() {
     if (Settings::values.use_caches_gc.GetValue() && total_used_memory > minimum_memory) {
         RunGarbageCollector();
+        if (total_used_memory >= critical_memory) {
+            RunBudgetEviction();
+        }
+    }
+    if constexpr (HAS_MEMORY_DEFRAGMENTATION) {
+        // Scanning images is not free, only do it once in a while on frames without new images
+        static constexpr u64 DEFRAGMENTATION_INTERVAL = 16;
+        if (use_memory_defragmentation && frame_image_insertions == 0 &&
+            frame_tick % DEFRAGMENTATION_INTERVAL == 0) {
+            RunDefragmentation();
+        }
+    }
+    frame_image_insertions = 0;
+    if (!streaming_images.empty()) {
+        StreamImages();
     }
+    ClearImageLookups();
     sentenced_images.Tick();
     sentenced_framebuffers.Tick();
     sentenced_image_view.Tick();
@@ -539,7 +800,17 @@ void TextureCache<P>::FillComputeImageViews(std::span<const u32> indices,
 }
 
 template <class P>
-typename P::Sampler* TextureCache<P>::GetGraphicsSampler(u32 index) {
+void TextureCache<P>::RequireNativeGraphicsImages(std::span<const u32> indices) {
+    RequireNativeImages(graphics_image_table, graphics_image_view_ids, indices);
+}
+
+template <class P>
+void TextureCache<P>::RequireNativeComputeImages(std::span<const u32> indices) {
+    RequireNativeImages(compute_image_table, compute_image_view_ids, indices);
+}
+
+template <class P>
+typename P::Sampler* TextureCache<P>::GetGraphicsSampler(u32 index, u32 image_index) {
     [[unlikely]] if (index > graphics_sampler_table.Limit()) {
         LOG_ERROR(HW_GPU, "Invalid sampler index={}", index);
         return &slot_samplers[NULL_SAMPLER_ID];
@@ -549,11 +820,17 @@ typename P::Sampler* TextureCache<P>::GetGraphicsSampler(u32 index) {
     [[unlikely]] if (is_new) {
         id = FindSampler(descriptor);
     }
+    if (Settings::values.use_texture_streaming.GetValue()) {
+        // Prepare the image now, so a stream started for it is already clamped on this draw
+        const ImageViewId image_view_id =
+            VisitImageView(graphics_image_table, graphics_image_view_ids, image_index);
+        return &slot_samplers[ClampStreamedLevels(id, descriptor, image_view_id)];
+    }
     return &slot_samplers[id];
 }
 
 template <class P>
-typename P::Sampler* TextureCache<P>::GetComputeSampler(u32 index) {
+typename P::Sampler* TextureCache<P>::GetComputeSampler(u32 index, u32 image_index) {
     [[unlikely]] if (index > compute_sampler_table.Limit()) {
         LOG_ERROR(HW_GPU, "Invalid sampler index={}", index);
         return &slot_samplers[NULL_SAMPLER_ID];
@@ -563,6 +840,11 @@ typename P::Sampler* TextureCache<P>::GetComputeSampler(u32 index) {
     [[unlikely]] if (is_new) {
         id = FindSampler(descriptor);
     }
+    if (Settings::values.use_texture_streaming.GetValue()) {
+        const ImageViewId image_view_id =
+            VisitImageView(compute_image_table, compute_image_view_ids, image_index);
+        return &slot_samplers[ClampStreamedLevels(id, descriptor, image_view_id)];
+    }
     return &slot_samplers[id];
 }
 
@@ -595,10 +877,10 @@ void TextureCache<P>::SynchronizeComputeDescriptors() {
 }
 
 template <class P>
-void TextureCache<P>::UpdateRenderTargets(bool is_clear) {
+void TextureCache<P>::UpdateRenderTargets(bool is_clear, bool require_native) {
     using namespace VideoCommon::Dirty;
     auto& flags = maxwell3d.dirty.flags;
-    if (!flags[Dirty::RenderTargets]) {
+    if (!flags[Dirty::RenderTargets] && !(require_native && render_targets.is_rescaled)) {
         return;
     }
     flags[Dirty::RenderTargets] = false;
@@ -625,10 +907,26 @@ void TextureCache<P>::UpdateRenderTargets(bool is_clear) {
     for (size_t index = 0; index < NUM_RT; ++index) {
         render_targets.draw_buffers[index] = static_cast<u8>(maxwell3d.regs.rt_control.Map(index));
     }
-    render_targets.size = Extent2D{
-        maxwell3d.regs.render_area.width,
-        maxwell3d.regs.render_area.height,
-    };
+    RescaleRenderTargets(require_native);
+
+    const u32 width = maxwell3d.regs.render_area.width;
+    const u32 height = maxwell3d.regs.render_area.height;
+    if (render_targets.is_rescaled) {
+        render_targets.size = Extent2D{
+            ScaleDimension(width, rescale_up, rescale_shift),
+            ScaleDimension(height, rescale_up, rescale_shift),
+        };
+    } else {
+        render_targets.size = Extent2D{width, height};
+    }
+}
+
+template <class P>
+float TextureCache<P>::RenderTargetScale() const noexcept {
+    if (!render_targets.is_rescaled) {
+        return 1.0f;
+    }
+    return static_cast<float>(rescale_up) / static_cast<float>(1U << rescale_shift);
 }
 
 template <class P>
@@ -669,6 +967,117 @@ ImageViewId TextureCache<P>::VisitImageView(DescriptorTable<TICEntry>& table,
     return image_view_id;
 }
 
+template <class P>
+void TextureCache<P>::RequireNativeImages(DescriptorTable<TICEntry>& table,
+                                          std::span<ImageViewId> cached_image_view_ids,
+                                          std::span<const u32> indices) {
+    if (rescale_shift == 0 && streaming_images.empty()) {
+        return;
+    }
+    for (const u32 index : indices) {
+        const ImageViewId image_view_id = VisitImageView(table, cached_image_view_ids, index);
+        if (image_view_id == NULL_IMAGE_VIEW_ID) {
+            continue;
+        }
+        // Texel reads and storage images ignore the sampler, they need every level
+        const ImageId image_id = slot_image_views[image_view_id].image_id;
+        FinishStreaming(image_id);
+        if (rescale_shift != 0) {
+            ScaleDown(image_id, true);
+        }
+    }
+}
+
+template <class P>
+void TextureCache<P>::RescaleRenderTargets(bool require_native) {
+    if (rescale_shift == 0) {
+        return;
+    }
+    boost::container::small_vector<ImageId, NUM_RT + 1> image_ids;
+    const auto add_image = [this, &image_ids](ImageViewId image_view_id) {
+        if (image_view_id) {
+            image_ids.push_back(slot_image_views[image_view_id].image_id);
+        }
+    };
+    std::ranges::for_each(render_targets.color_buffer_ids, add_image);
+    add_image(render_targets.depth_buffer_id);
+
+    // All attachments of a framebuffer share the same scale, a single native one forces the rest
+    bool is_rescaled = !require_native && !image_ids.empty() &&
+                       std::ranges::all_of(image_ids, [this](ImageId image_id) {
+                           return slot_images[image_id].IsRescalable();
+                       });
+    if (is_rescaled) {
+        is_rescaled = std::ranges::all_of(image_ids, [this](ImageId id) { return ScaleUp(id); });
+    }
+    if (!is_rescaled) {
+        for (const ImageId image_id : image_ids) {
+            ScaleDown(image_id, require_native);
+        }
+    }
+    render_targets.is_rescaled = is_rescaled;
+}
+
+template <class P>
+bool TextureCache<P>::ScaleUp(ImageId image_id) {
+    Image& image = slot_images[image_id];
+    if (True(image.flags & ImageFlagBits::Rescaled)) {
+        return true;
+    }
+    if (rescale_shift == 0 || !image.IsRescalable()) {
+        return false;
+    }
+    FinishStreaming(image_id);
+    if (!image.ScaleUp(rescale_up, rescale_shift)) {
+        // The backend can't scale this image, don't try again
+        image.flags |= ImageFlagBits::NoRescale;
+        return false;
+    }
+    image.flags |= ImageFlagBits::Rescaled;
+    image.content_hash = 0;
+    InvalidateScale(image_id);
+    return true;
+}
+
+template <class P>
+void TextureCache<P>::ScaleDown(ImageId image_id, bool keep_native) {
+    Image& image = slot_images[image_id];
+    if (keep_native) {
+        image.flags |= ImageFlagBits::NoRescale;
+    }
+    if (False(image.flags & ImageFlagBits::Rescaled)) {
+        return;
+    }
+    image.ScaleDown();
+    image.flags &= ~ImageFlagBits::Rescaled;
+    InvalidateScale(image_id);
+}
+
+template <class P>
+void TextureCache<P>::InvalidateScale(ImageId image_id) {
+    Image& image = slot_images[image_id];
+    // Views keep their ids, so descriptor tables and bound render targets remain valid
+    maxwell3d.dirty.flags[Dirty::RenderTargets] = true;
+    const std::span<const ImageViewId> image_view_ids = image.image_view_ids;
+    RemoveFramebuffers(image_view_ids);
+    for (size_t index = 0; index < image_view_ids.size(); ++index) {
+        ImageView& image_view = slot_image_views[image_view_ids[index]];
+        sentenced_image_view.Push(std::move(image_view));
+        image_view = ImageView(runtime, image.image_view_infos[index], image_id, image);
+    }
+}
+
+template <class P>
+Region2D TextureCache<P>::ScaleRegion(const Region2D& region) const noexcept {
+    const auto scale = [this](s32 value) {
+        return static_cast<s32>((static_cast<s64>(value) * rescale_up) >> rescale_shift);
+    };
+    return Region2D{
+        .start = {.x = scale(region.start.x), .y = scale(region.start.y)},
+        .end = {.x = scale(region.end.x), .y = scale(region.end.y)},
+    };
+}
+
 template <class P>
 FramebufferId TextureCache<P>::GetFramebufferId(const RenderTargets& key) {
     const auto [pair, is_new] = framebuffers.try_emplace(key);
@@ -700,6 +1109,9 @@ void TextureCache<P>::WriteMemory(VAddr cpu_addr, size_t size) {
 
 template <class P>
 void TextureCache<P>::DownloadMemory(VAddr cpu_addr, size_t size) {
+    // Pending contents are older than the ones downloaded here, write them first
+    WaitPendingDownloads(cpu_addr, size);
+
     std::vector<ImageId> images;
     ForEachImageInRegion(cpu_addr, size, [this, &images](ImageId image_id, ImageBase& image) {
         if (!image.IsSafeDownload()) {
@@ -715,6 +1127,7 @@ void TextureCache<P>::DownloadMemory(VAddr cpu_addr, size_t size) {
         return slot_images[lhs].modification_tick < slot_images[rhs].modification_tick;
     });
     for (const ImageId image_id : images) {
+        ScaleDown(image_id, true);
         Image& image = slot_images[image_id];
         auto map = runtime.DownloadStagingBuffer(image.unswizzled_size_bytes);
         const auto copies = FullDownloadCopies(image.info);
@@ -740,6 +1153,7 @@ void TextureCache<P>::UnmapMemory(VAddr cpu_addr, size_t size) {
 
 template <class P>
 void TextureCache<P>::UnmapGPUMemory(GPUVAddr gpu_addr, size_t size) {
+    ClearImageLookups();
     std::vector<ImageId> deleted_images;
     ForEachImageInRegionGPU(gpu_addr, size,
                             [&](ImageId id, Image&) { deleted_images.push_back(id); });
@@ -763,8 +1177,19 @@ void TextureCache<P>::BlitImage(const Tegra::Engines::Fermi2D::Surface& dst,
     const ImageId dst_id = images.dst_id;
     const ImageId src_id = images.src_id;
     PrepareImage(src_id, false, false);
+    FinishStreaming(src_id);
     PrepareImage(dst_id, true, false);
 
+    // Blits filter between arbitrary regions, so each side can be at its own resolution.
+    // Keep the destination of rescaled sources rescaled, so chains of passes stay cheap.
+    if (True(slot_images[src_id].flags & ImageFlagBits::Rescaled)) {
+        void(ScaleUp(dst_id));
+    }
+    if (slot_images[src_id].info.num_samples > 1) {
+        // Resolves need matching extents
+        ScaleDown(dst_id, false);
+    }
+
     ImageBase& dst_image = slot_images[dst_id];
     const ImageBase& src_image = slot_images[src_id];
 
@@ -774,20 +1199,26 @@ void TextureCache<P>::BlitImage(const Tegra::Engines::Fermi2D::Surface& dst,
     const ImageViewInfo src_view_info(ImageViewType::e2D, images.src_format, src_range);
     const auto [src_framebuffer_id, src_view_id] = RenderTargetFromImage(src_id, src_view_info);
     const auto [src_samples_x, src_samples_y] = SamplesLog2(src_image.info.num_samples);
-    const Region2D src_region{
+    Region2D src_region{
         Offset2D{.x = copy.src_x0 >> src_samples_x, .y = copy.src_y0 >> src_samples_y},
         Offset2D{.x = copy.src_x1 >> src_samples_x, .y = copy.src_y1 >> src_samples_y},
     };
+    if (True(src_image.flags & ImageFlagBits::Rescaled)) {
+        src_region = ScaleRegion(src_region);
+    }
 
     const std::optional dst_base = dst_image.TryFindBase(dst.Address());
     const SubresourceRange dst_range{.base = dst_base.value(), .extent = {1, 1}};
     const ImageViewInfo dst_view_info(ImageViewType::e2D, images.dst_format, dst_range);
     const auto [dst_framebuffer_id, dst_view_id] = RenderTargetFromImage(dst_id, dst_view_info);
     const auto [dst_samples_x, dst_samples_y] = SamplesLog2(dst_image.info.num_samples);
-    const Region2D dst_region{
+    Region2D dst_region{
         Offset2D{.x = copy.dst_x0 >> dst_samples_x, .y = copy.dst_y0 >> dst_samples_y},
         Offset2D{.x = copy.dst_x1 >> dst_samples_x, .y = copy.dst_y1 >> dst_samples_y},
     };
+    if (True(dst_image.flags & ImageFlagBits::Rescaled)) {
+        dst_region = ScaleRegion(dst_region);
+    }
 
     // Always call this after src_framebuffer_id was queried, as the address might be invalidated.
     Framebuffer* const dst_framebuffer = &slot_framebuffers[dst_framebuffer_id];
@@ -869,18 +1300,104 @@ bool TextureCache<P>::HasUncommittedFlushes() const noexcept {
 
 template <class P>
 bool TextureCache<P>::ShouldWaitAsyncFlushes() const noexcept {
+    if (use_async_downloads) {
+        return !pending_downloads.empty() && !pending_downloads.front().images.empty();
+    }
     return !committed_downloads.empty() && !committed_downloads.front().empty();
 }
 
 template <class P>
 void TextureCache<P>::CommitAsyncFlushes() {
+    if (use_async_downloads) {
+        CommitAsyncDownloads();
+        return;
+    }
     // This is intentionally passing the value by copy
     committed_downloads.push(uncommitted_downloads);
     uncommitted_downloads.clear();
 }
 
+template <class P>
+void TextureCache<P>::CommitAsyncDownloads() {
+    PendingImageDownloads& pending = pending_downloads.emplace_back();
+    if constexpr (IMPLEMENTS_ASYNC_DOWNLOADS) {
+        if (uncommitted_downloads.empty()) {
+            return;
+        }
+        size_t total_size_bytes = 0;
+        for (const ImageId image_id : uncommitted_downloads) {
+            total_size_bytes += slot_images[image_id].unswizzled_size_bytes;
+        }
+        pending.staging = runtime.DownloadStagingBuffer(total_size_bytes, true);
+        auto& download_map = pending.staging;
+        const size_t original_offset = download_map.offset;
+        size_t staging_offset = 0;
+        // The fence signaled after this commit covers the copies recorded here
+        for (const ImageId image_id : uncommitted_downloads) {
+            ScaleDown(image_id, true);
+            Image& image = slot_images[image_id];
+            const auto copies = FullDownloadCopies(image.info);
+            image.DownloadMemory(download_map, copies);
+            pending.images.push_back({
+                .info = image.info,
+                .gpu_addr = image.gpu_addr,
+                .cpu_addr = image.cpu_addr,
+                .size_bytes = image.guest_size_bytes,
+                .staging_offset = staging_offset,
+            });
+            download_map.offset += image.unswizzled_size_bytes;
+            staging_offset += image.unswizzled_size_bytes;
+        }
+        download_map.offset = original_offset;
+    }
+    uncommitted_downloads.clear();
+}
+
+template <class P>
+void TextureCache<P>::WriteBackPendingDownloads(PendingImageDownloads& pending) {
+    if constexpr (IMPLEMENTS_ASYNC_DOWNLOADS) {
+        if (pending.images.empty()) {
+            return;
+        }
+        const std::span<u8> mapped_span = pending.staging.mapped_span;
+        for (const AsyncImageDownload& download : pending.images) {
+            const auto copies = FullDownloadCopies(download.info);
+            SwizzleImage(gpu_memory, download.gpu_addr, download.info, copies,
+                         mapped_span.subspan(download.staging_offset));
+        }
+        runtime.FreeDeferredStagingBuffer(pending.staging);
+        pending.images.clear();
+    }
+}
+
+template <class P>
+void TextureCache<P>::WaitPendingDownloads(VAddr cpu_addr, size_t size) {
+    const VAddr cpu_addr_end = cpu_addr + size;
+    const auto overlaps = [cpu_addr, cpu_addr_end](const PendingImageDownloads& pending) {
+        return std::ranges::any_of(pending.images, [&](const AsyncImageDownload& download) {
+            return download.cpu_addr < cpu_addr_end &&
+                   cpu_addr < download.cpu_addr + download.size_bytes;
+        });
+    };
+    const auto last = std::find_if(pending_downloads.rbegin(), pending_downloads.rend(), overlaps);
+    if (last == pending_downloads.rend()) {
+        return;
+    }
+    runtime.Finish();
+    for (auto it = pending_downloads.begin(); it != last.base(); ++it) {
+        WriteBackPendingDownloads(*it);
+    }
+}
+
 template <class P>
 void TextureCache<P>::PopAsyncFlushes() {
+    if (use_async_downloads) {
+        if (!pending_downloads.empty()) {
+            WriteBackPendingDownloads(pending_downloads.front());
+            pending_downloads.pop_front();
+        }
+        return;
+    }
     if (committed_downloads.empty()) {
         return;
     }
@@ -896,6 +1413,7 @@ void TextureCache<P>::PopAsyncFlushes() {
     auto download_map = runtime.DownloadStagingBuffer(total_size_bytes);
     const size_t original_offset = download_map.offset;
     for (const ImageId image_id : download_ids) {
+        ScaleDown(image_id, true);
         Image& image = slot_images[image_id];
         const auto copies = FullDownloadCopies(image.info);
         image.DownloadMemory(download_map, copies);
@@ -942,11 +1460,207 @@ void TextureCache<P>::RefreshContents(Image& image, ImageId image_id) {
         LOG_WARNING(HW_GPU, "MSAA image uploads are not implemented");
         return;
     }
+    // Guest data is laid out at native resolution, the image is scaled again when rendered to
+    ScaleDown(image_id, false);
+    if (TryDeduplicateUpload(image, image_id)) {
+        image.resident_level = 0;
+        return;
+    }
+    if (StartStreaming(image, image_id)) {
+        return;
+    }
+    image.resident_level = 0;
     auto staging = runtime.UploadStagingBuffer(MapSizeBytes(image));
     UploadImageContents(image, staging);
     runtime.InsertUploadMemoryBarrier();
 }
 
+template <class P>
+bool TextureCache<P>::TryDeduplicateUpload(Image& image, ImageId image_id) {
+    image.content_hash = 0;
+    if (!Settings::values.use_texture_deduplication.GetValue() ||
+        image.info.type != ImageType::e2D) {
+        return false;
+    }
+    content_hash_buffer.resize(image.guest_size_bytes);
+    gpu_memory.ReadBlockUnsafe(image.gpu_addr, content_hash_buffer.data(),
+                               content_hash_buffer.size());
+    const u64 hash = Common::CityHash64(reinterpret_cast<const char*>(content_hash_buffer.data()),
+                                        content_hash_buffer.size());
+    // Zero is reserved for images without a known hash
+    const u64 content_hash = hash != 0 ? hash : 1;
+    image.content_hash = content_hash;
+
+    const auto [it, is_new] = content_hash_images.try_emplace(content_hash, image_id);
+    if (is_new || it->second == image_id) {
+        return false;
+    }
+    const ImageId source_id = it->second;
+    Image& source = slot_images[source_id];
+    if (source.resident_level != 0) {
+        return false;
+    }
+    if (source.content_hash != content_hash || True(source.flags & ImageFlagBits::Rescaled) ||
+        !IsSameLayout(source.info, image.info)) {
+        // The indexed image can't be used, this one becomes the source for later uploads
+        it->second = image_id;
+        return false;
+    }
+    if constexpr (HAS_EMULATED_COPIES) {
+        if (!runtime.CanImageBeCopied(image, source)) {
+            return false;
+        }
+    }
+    const auto copies = MakeShrinkImageCopies(image.info, source.info, SubresourceBase{});
+    runtime.CopyImage(image, source, copies);
+    return true;
+}
+
+template <class P>
+bool TextureCache<P>::StartStreaming(Image& image, ImageId image_id) {
+    const ImageInfo& info = image.info;
+    if (!Settings::values.use_texture_streaming.GetValue() || info.type != ImageType::e2D ||
+        info.resources.levels <= 1 || image.guest_size_bytes < STREAMING_MIN_SIZE ||
+        True(image.flags & ImageFlagBits::AcceleratedUpload)) {
+        return false;
+    }
+    // Upload the smallest levels now, at least the last one
+    const LevelArray level_sizes = CalculateMipLevelSizes(info);
+    const size_t layers = static_cast<size_t>(info.resources.layers);
+    s32 level = info.resources.levels - 1;
+    size_t tail_size = level_sizes[level] * layers;
+    while (level > 0 && tail_size + level_sizes[level - 1] * layers <= STREAMING_TAIL_SIZE) {
+        --level;
+        tail_size += level_sizes[level] * layers;
+    }
+    if (level == 0) {
+        return false;
+    }
+    UploadImageLevels(image, level, info.resources.levels);
+    runtime.InsertUploadMemoryBarrier();
+    if (image.resident_level == 0) {
+        streaming_images.push_back(image_id);
+    }
+    image.resident_level = level;
+    return true;
+}
+
+template <class P>
+void TextureCache<P>::UploadImageLevels(Image& image, s32 first_level, s32 last_level) {
+    static constexpr size_t LEVEL_ALIGNMENT = 16;
+    const ImageInfo& info = image.info;
+    const bool is_converted = True(image.flags & ImageFlagBits::Converted);
+    const auto level_size_bytes = [&](s32 level) {
+        return is_converted ? CalculateConvertedLevelSizeBytes(info, level)
+                            : CalculateUnswizzledLevelSizeBytes(info, level);
+    };
+    size_t staging_size = 0;
+    for (s32 level = first_level; level < last_level; ++level) {
+        staging_size += Common::AlignUp(level_size_bytes(level), LEVEL_ALIGNMENT);
+    }
+    auto staging = runtime.UploadStagingBuffer(staging_size);
+    const std::span<u8> mapped_span = staging.mapped_span;
+
+    boost::container::small_vector<BufferImageCopy, MAX_MIP_LEVELS> copies;
+    std::vector<u8> unswizzled_data;
+    size_t offset = 0;
+    for (s32 level = first_level; level < last_level; ++level) {
+        const std::span<u8> output = mapped_span.subspan(offset);
+        if (is_converted) {
+            const Core::ScopedStall stall{maxwell3d.System().GetPerfStats(),
+                                          Core::StallCause::TextureDecode};
+            unswizzled_data.resize(CalculateUnswizzledLevelSizeBytes(info, level));
+            BufferImageCopy copy =
+                UnswizzleImageLevel(gpu_memory, image.gpu_addr, info, level, unswizzled_data);
+            ConvertImage(unswizzled_data, info, output, std::span(&copy, 1),
+                         True(image.flags & ImageFlagBits::Transcoded));
+            copy.buffer_offset = offset;
+            copies.push_back(copy);
+        } else {
+            BufferImageCopy copy =
+                UnswizzleImageLevel(gpu_memory, image.gpu_addr, info, level, output);
+            copy.buffer_offset = offset;
+            copies.push_back(copy);
+        }
+        offset += Common::AlignUp(level_size_bytes(level), LEVEL_ALIGNMENT);
+    }
+    image.UploadMemory(staging, std::span(copies.data(), copies.size()));
+}
+
+template <class P>
+void TextureCache<P>::StreamImages() {
+    const auto start_time = std::chrono::steady_clock::now();
+    size_t uploaded_bytes = 0;
+    while (!streaming_images.empty() && uploaded_bytes < STREAMING_FRAME_BYTES &&
+           std::chrono::steady_clock::now() - start_time < STREAMING_FRAME_TIME) {
+        const ImageId image_id = streaming_images.front();
+        Image& image = slot_images[image_id];
+        if (image.resident_level == 0) {
+            // Fully uploaded by some other path
+            streaming_images.pop_front();
+            continue;
+        }
+        const s32 level = image.resident_level - 1;
+        UploadImageLevels(image, level, level + 1);
+        uploaded_bytes += CalculateMipLevelSizes(image.info)[level] *
+                          static_cast<size_t>(image.info.resources.layers);
+        image.resident_level = level;
+        if (level == 0) {
+            streaming_images.pop_front();
+        }
+    }
+    if (uploaded_bytes > 0) {
+        runtime.InsertUploadMemoryBarrier();
+    }
+}
+
+template <class P>
+void TextureCache<P>::FinishStreaming(ImageId image_id) {
+    Image& image = slot_images[image_id];
+    if (image.resident_level == 0) {
+        return;
+    }
+    UploadImageLevels(image, 0, image.resident_level);
+    runtime.InsertUploadMemoryBarrier();
+    image.resident_level = 0;
+}
+
+template <class P>
+SamplerId TextureCache<P>::ClampStreamedLevels(SamplerId sampler_id, const TSCEntry& config,
+                                               ImageViewId image_view_id) {
+    using Tegra::Texture::TextureMipmapFilter;
+    if (image_view_id == NULL_IMAGE_VIEW_ID || sampler_id == NULL_SAMPLER_ID) {
+        return sampler_id;
+    }
+    const ImageViewBase& image_view = slot_image_views[image_view_id];
+    const ImageId image_id = image_view.image_id;
+    if (!image_id || slot_images[image_id].resident_level == 0) {
+        return sampler_id;
+    }
+    const s32 resident_level = slot_images[image_id].resident_level;
+    const s32 view_level = image_view.range.base.level;
+    const s32 view_end_level = view_level + image_view.range.extent.levels;
+    const bool is_mipmapped = config.mipmap_filter == TextureMipmapFilter::Nearest ||
+                              config.mipmap_filter == TextureMipmapFilter::Linear;
+    if (!is_mipmapped || resident_level >= view_end_level) {
+        // The sampler can't be kept off the missing levels, upload them now
+        FinishStreaming(image_id);
+        return sampler_id;
+    }
+    if (resident_level <= view_level) {
+        return sampler_id;
+    }
+    // Level of detail clamps are unsigned 4.8 fixed point numbers
+    static constexpr u32 MAX_LOD_CLAMP = 0xFFF;
+    const u32 min_lod = static_cast<u32>(resident_level - view_level) << 8;
+    TSCEntry clamped = config;
+    clamped.min_lod_clamp.Assign(std::min(std::max<u32>(config.min_lod_clamp, min_lod),
+                                          MAX_LOD_CLAMP));
+    clamped.max_lod_clamp.Assign(
+        std::max<u32>(config.max_lod_clamp, clamped.min_lod_clamp.Value()));
+    return FindSampler(clamped);
+}
+
 template <class P>
 template <typename StagingBuffer>
 void TextureCache<P>::UploadImageContents(Image& image, StagingBuffer& staging) {
@@ -958,9 +1672,12 @@ void TextureCache<P>::UploadImageContents(Image& image, StagingBuffer& staging)
         const auto uploads = FullUploadSwizzles(image.info);
         runtime.AccelerateImageUpload(image, staging, uploads);
     } else if (True(image.flags & ImageFlagBits::Converted)) {
+        const Core::ScopedStall stall{maxwell3d.System().GetPerfStats(),
+                                      Core::StallCause::TextureDecode};
         std::vector<u8> unswizzled_data(image.unswizzled_size_bytes);
         auto copies = UnswizzleImage(gpu_memory, gpu_addr, image.info, unswizzled_data);
-        ConvertImage(unswizzled_data, image.info, mapped_span, copies);
+        ConvertImage(unswizzled_data, image.info, mapped_span, copies,
+                     True(image.flags & ImageFlagBits::Transcoded));
         image.UploadMemory(staging, copies);
     } else if (image.info.type == ImageType::Buffer) {
         const std::array copies{UploadBufferCopy(gpu_memory, gpu_addr, image, mapped_span)};
@@ -1015,6 +1732,9 @@ ImageId TextureCache<P>::FindOrInsertImage(const ImageInfo& info, GPUVAddr gpu_a
 template <class P>
 ImageId TextureCache<P>::FindImage(const ImageInfo& info, GPUVAddr gpu_addr,
                                    RelaxedOptions options) {
+    if (const ImageId cached_id = FindCachedImage(info, gpu_addr, options); cached_id) {
+        return cached_id;
+    }
     std::optional<VAddr> cpu_addr = gpu_memory.GpuToCpuAddress(gpu_addr);
     if (!cpu_addr) {
         cpu_addr = gpu_memory.GpuToCpuAddress(gpu_addr, CalculateGuestSizeInBytes(info));
@@ -1048,9 +1768,45 @@ ImageId TextureCache<P>::FindImage(const ImageInfo& info, GPUVAddr gpu_addr,
         return false;
     };
     ForEachImageInRegion(*cpu_addr, CalculateGuestSizeInBytes(info), lambda);
+    if (image_id) {
+        image_lookups[image_lookup_cursor] = ImageLookup{
+            .gpu_addr = gpu_addr,
+            .info = info,
+            .options = options,
+            .image_id = image_id,
+        };
+        image_lookup_cursor = (image_lookup_cursor + 1) % NUM_IMAGE_LOOKUPS;
+    }
     return image_id;
 }
 
+template <class P>
+ImageId TextureCache<P>::FindCachedImage(const ImageInfo& info, GPUVAddr gpu_addr,
+                                         RelaxedOptions options) const noexcept {
+    static_assert(std::is_trivially_copyable_v<ImageInfo>);
+    for (const ImageLookup& lookup : image_lookups) {
+        if (lookup.gpu_addr != gpu_addr || !lookup.image_id || lookup.options != options) {
+            continue;
+        }
+        // Image infos are always fully initialized, including the inactive part of the union
+        if (std::memcmp(&lookup.info, &info, sizeof(ImageInfo)) != 0) {
+            continue;
+        }
+        if (True(slot_images[lookup.image_id].flags & ImageFlagBits::Remapped)) {
+            continue;
+        }
+        return lookup.image_id;
+    }
+    return ImageId{};
+}
+
+template <class P>
+void TextureCache<P>::ClearImageLookups() noexcept {
+    for (ImageLookup& lookup : image_lookups) {
+        lookup.image_id = ImageId{};
+    }
+}
+
 template <class P>
 ImageId TextureCache<P>::InsertImage(const ImageInfo& info, GPUVAddr gpu_addr,
                                      RelaxedOptions options) {
@@ -1139,6 +1895,7 @@ ImageId TextureCache<P>::JoinImages(const ImageInfo& info, GPUVAddr gpu_addr, VA
     ForEachSparseImageInRegion(gpu_addr, size_bytes, region_check_gpu);
     const ImageId new_image_id = slot_images.insert(runtime, new_info, gpu_addr, cpu_addr);
     Image& new_image = slot_images[new_image_id];
+    ++frame_image_insertions;
 
     if (!gpu_memory.IsContinousRange(new_image.gpu_addr, new_image.guest_size_bytes)) {
         new_image.flags |= ImageFlagBits::Sparse;
@@ -1158,6 +1915,7 @@ ImageId TextureCache<P>::JoinImages(const ImageInfo& info, GPUVAddr gpu_addr, VA
 
     // TODO: Only upload what we need
     RefreshContents(new_image, new_image_id);
+    FinishStreaming(new_image_id);
 
     for (const ImageId overlap_id : overlap_ids) {
         Image& overlap = slot_images[overlap_id];
@@ -1166,7 +1924,10 @@ ImageId TextureCache<P>::JoinImages(const ImageInfo& info, GPUVAddr gpu_addr, VA
         } else {
             const SubresourceBase base = new_image.TryFindBase(overlap.gpu_addr).value();
             const auto copies = MakeShrinkImageCopies(new_info, overlap.info, base);
+            ScaleDown(overlap_id, true);
+            FinishStreaming(overlap_id);
             runtime.CopyImage(new_image, overlap, copies);
+            new_image.content_hash = 0;
         }
         if (True(overlap.flags & ImageFlagBits::Tracked)) {
             UntrackImage(overlap, overlap_id);
@@ -1472,8 +2233,10 @@ void TextureCache<P>::RegisterImage(ImageId image_id) {
     ASSERT_MSG(False(image.flags & ImageFlagBits::Registered),
                "Trying to register an already registered image");
     image.flags |= ImageFlagBits::Registered;
+    // The new image can shadow or be joined with images found by earlier lookups
+    ClearImageLookups();
     u64 tentative_size = std::max(image.guest_size_bytes, image.unswizzled_size_bytes);
-    if ((IsPixelFormatASTC(image.info.format) &&
+    if ((IsDecodedOnUpload(image.info.format) &&
          True(image.flags & ImageFlagBits::AcceleratedUpload)) ||
         True(image.flags & ImageFlagBits::Converted)) {
         tentative_size = EstimatedDecompressedSize(tentative_size, image.info.format);
@@ -1508,9 +2271,10 @@ void TextureCache<P>::UnregisterImage(ImageId image_id) {
     ASSERT_MSG(True(image.flags & ImageFlagBits::Registered),
                "Trying to unregister an already registered image");
     image.flags &= ~ImageFlagBits::Registered;
+    ClearImageLookups();
     image.flags &= ~ImageFlagBits::BadOverlap;
     u64 tentative_size = std::max(image.guest_size_bytes, image.unswizzled_size_bytes);
-    if ((IsPixelFormatASTC(image.info.format) &&
+    if ((IsDecodedOnUpload(image.info.format) &&
          True(image.flags & ImageFlagBits::AcceleratedUpload)) ||
         True(image.flags & ImageFlagBits::Converted)) {
         tentative_size = EstimatedDecompressedSize(tentative_size, image.info.format);
@@ -1657,6 +2421,16 @@ void TextureCache<P>::DeleteImage(ImageId image_id) {
     ASSERT_MSG(False(image.flags & ImageFlagBits::Tracked), "Image was not untracked");
     ASSERT_MSG(False(image.flags & ImageFlagBits::Registered), "Image was not unregistered");
 
+    if (image.content_hash != 0) {
+        const auto hash_it = content_hash_images.find(image.content_hash);
+        if (hash_it != content_hash_images.end() && hash_it->second == image_id) {
+            content_hash_images.erase(hash_it);
+        }
+    }
+    if (!streaming_images.empty()) {
+        std::erase(streaming_images, image_id);
+    }
+
     // Mark render targets as dirty
     auto& dirty = maxwell3d.dirty.flags;
     dirty[Dirty::RenderTargets] = true;
@@ -1741,6 +2515,7 @@ void TextureCache<P>::RemoveFramebuffers(std::span<const ImageViewId> removed_vi
 template <class P>
 void TextureCache<P>::MarkModification(ImageBase& image) noexcept {
     image.flags |= ImageFlagBits::GpuModified;
+    image.content_hash = 0;
     image.modification_tick = ++modification_tick;
 }
 
@@ -1783,6 +2558,8 @@ void TextureCache<P>::PrepareImage(ImageId image_id, bool is_modification, bool
         SynchronizeAliases(image_id);
     }
     if (is_modification) {
+        // Streamed levels would overwrite what is rendered to them
+        FinishStreaming(image_id);
         MarkModification(image);
     }
     image.frame_tick = frame_tick;
@@ -1800,8 +2577,14 @@ void TextureCache<P>::PrepareImageView(ImageViewId image_view_id, bool is_modifi
 
 template <class P>
 void TextureCache<P>::CopyImage(ImageId dst_id, ImageId src_id, std::span<const ImageCopy> copies) {
+    FinishStreaming(dst_id);
+    FinishStreaming(src_id);
+    // Copies address texels, images sharing memory this way always stay at native resolution
+    ScaleDown(dst_id, true);
+    ScaleDown(src_id, true);
     Image& dst = slot_images[dst_id];
     Image& src = slot_images[src_id];
+    dst.content_hash = 0;
     const auto dst_format_type = GetFormatType(dst.info.format);
     const auto src_format_type = GetFormatType(src.info.format);
     if (src_format_type == dst_format_type) {
@@ -1875,11 +2658,17 @@ std::pair<FramebufferId, ImageViewId> TextureCache<P>::RenderTargetFromImage(
     const Extent3D extent = MipSize(image.info.size, view_info.range.base.level);
     const u32 num_samples = image.info.num_samples;
     const auto [samples_x, samples_y] = SamplesLog2(num_samples);
-    const FramebufferId framebuffer_id = GetFramebufferId(RenderTargets{
+    RenderTargets key{
         .color_buffer_ids = {color_view_id},
         .depth_buffer_id = depth_view_id,
         .size = {extent.width >> samples_x, extent.height >> samples_y},
-    });
+        .is_rescaled = True(image.flags & ImageFlagBits::Rescaled),
+    };
+    if (key.is_rescaled) {
+        key.size.width = ScaleDimension(key.size.width, rescale_up, rescale_shift);
+        key.size.height = ScaleDimension(key.size.height, rescale_up, rescale_shift);
+    }
+    const FramebufferId framebuffer_id = GetFramebufferId(key);
     return {framebuffer_id, view_id};
 }
 
@@ -1906,4 +2695,9 @@ bool TextureCache<P>::IsFullClear(ImageViewId id) {
            scissor.max_y >= size.height;
 }
 
+template <class P>
+bool TextureCache<P>::IsDecodedOnUpload(PixelFormat format) const noexcept {
+    return IsPixelFormatASTC(format) || (IsPixelFormatBC1To5(format) && !runtime.HasNativeBcn());
+}
+
 } // namespace VideoCommon
@@ -38,16 +38,19 @@
 #include "common/bit_util.h"
 #include "common/common_types.h"
 #include "common/div_ceil.h"
+#include "common/settings.h"
 #include "video_core/compatible_formats.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/memory_manager.h"
 #include "video_core/surface.h"
 #include "video_core/texture_cache/decode_bc4.h"
+#include "video_core/texture_cache/encode_bc3.h"
 #include "video_core/texture_cache/format_lookup_table.h"
 #include "video_core/texture_cache/formatter.h"
 #include "video_core/texture_cache/samples_helper.h"
 #include "video_core/texture_cache/util.h"
 #include "video_core/textures/astc.h"
+#include "video_core/textures/astc_disk_cache.h"
 #include "video_core/textures/decoders.h"
 
 namespace VideoCommon {
@@ -594,6 +597,31 @@ void SwizzleBlockLinearImage(Tegra::MemoryManager& gpu_memory, GPUVAddr gpu_addr
     ASSERT(host_offset - copy.buffer_offset == copy.buffer_size);
 }
 
+void DecompressASTC(std::span<const u8> input, Extent3D size, u32 num_layers, Extent2D tile_size,
+                    std::span<u8> output) {
+    if (!Settings::values.use_astc_disk_cache.GetValue()) {
+        Tegra::Texture::ASTC::Decompress(input, size.width, size.height, num_layers,
+                                         tile_size.width, tile_size.height, output);
+        return;
+    }
+    const std::size_t input_size =
+        static_cast<std::size_t>(NumBlocks(size, tile_size)) * num_layers * 16;
+    const std::size_t output_size =
+        static_cast<std::size_t>(size.width) * size.height * num_layers * 4;
+    const std::span<const u8> blocks = input.subspan(0, input_size);
+    const std::span<u8> decoded = output.subspan(0, output_size);
+
+    const u64 key = Tegra::Texture::ASTC::MakeDiskCacheKey(blocks, size.width, size.height,
+                                                           num_layers, tile_size.width,
+                                                           tile_size.height);
+    if (Tegra::Texture::ASTC::LoadFromDiskCache(key, decoded)) {
+        return;
+    }
+    Tegra::Texture::ASTC::Decompress(blocks, size.width, size.height, num_layers, tile_size.width,
+                                     tile_size.height, decoded);
+    Tegra::Texture::ASTC::SaveToDiskCache(key, decoded);
+}
+
 } // Anonymous namespace
 
 u32 CalculateGuestSizeInBytes(const ImageInfo& info) noexcept {
@@ -634,6 +662,20 @@ u32 CalculateConvertedSizeBytes(const ImageInfo& info) noexcept {
     return NumBlocksPerLayer(info, TILE_SIZE) * info.resources.layers * CONVERTED_BYTES_PER_BLOCK;
 }
 
+u32 CalculateUnswizzledLevelSizeBytes(const ImageInfo& info, s32 level) noexcept {
+    ASSERT(info.type != ImageType::Linear && info.type != ImageType::Buffer);
+    const Extent2D tile_size = DefaultBlockSize(info.format);
+    const Extent3D level_size = AdjustMipSize(info.size, level);
+    return NumBlocks(level_size, tile_size) * info.resources.layers * BytesPerBlock(info.format);
+}
+
+u32 CalculateConvertedLevelSizeBytes(const ImageInfo& info, s32 level) noexcept {
+    ASSERT(info.type != ImageType::Linear && info.type != ImageType::Buffer);
+    static constexpr Extent2D TILE_SIZE{1, 1};
+    const Extent3D level_size = AdjustMipSize(info.size, level);
+    return NumBlocks(level_size, TILE_SIZE) * info.resources.layers * CONVERTED_BYTES_PER_BLOCK;
+}
+
 u32 CalculateLayerStride(const ImageInfo& info) noexcept {
     ASSERT(info.type != ImageType::Linear);
     const u32 layer_size = CalculateLayerSize(info);
@@ -880,6 +922,53 @@ std::vector<BufferImageCopy> UnswizzleImage(Tegra::MemoryManager& gpu_memory, GP
     return copies;
 }
 
+BufferImageCopy UnswizzleImageLevel(Tegra::MemoryManager& gpu_memory, GPUVAddr gpu_addr,
+                                    const ImageInfo& info, s32 level, std::span<u8> output) {
+    ASSERT(info.type != ImageType::Linear && info.type != ImageType::Buffer);
+    const u32 bpp_log2 = BytesPerBlockLog2(info.format);
+    const Extent3D size = info.size;
+    const LevelInfo level_info = MakeLevelInfo(info);
+    const s32 num_levels = info.resources.levels;
+    const Extent2D tile_size = DefaultBlockSize(info.format);
+    const std::array level_sizes = CalculateLevelSizes(level_info, num_levels);
+    const Extent2D gob = GobSize(bpp_log2, info.block.height, info.tile_width_spacing);
+    const u32 layer_size = CalculateLevelBytes(level_sizes, num_levels);
+    const u32 layer_stride = AlignLayerSize(layer_size, size, level_info.block, tile_size.height,
+                                            info.tile_width_spacing);
+    const Extent3D level_size = AdjustMipSize(size, level);
+    const u32 host_bytes_per_layer = NumBlocks(level_size, tile_size) << bpp_log2;
+    const Extent3D num_tiles = AdjustTileSize(level_size, tile_size);
+    const Extent3D block = AdjustMipBlockSize(num_tiles, level_info.block, level);
+    const u32 stride_alignment = StrideAlignment(num_tiles, info.block, gob, bpp_log2);
+
+    // Only the level is read from guest memory, one layer at a time
+    std::vector<u8> input(level_sizes[level]);
+    GPUVAddr guest_addr = gpu_addr + CalculateLevelBytes(level_sizes, level);
+    u32 host_offset = 0;
+    for (s32 layer = 0; layer < info.resources.layers; ++layer) {
+        gpu_memory.ReadBlockUnsafe(guest_addr, input.data(), input.size());
+        UnswizzleTexture(output.subspan(host_offset), input, 1U << bpp_log2, num_tiles.width,
+                         num_tiles.height, num_tiles.depth, block.height, block.depth,
+                         stride_alignment);
+        guest_addr += layer_stride;
+        host_offset += host_bytes_per_layer;
+    }
+    return BufferImageCopy{
+        .buffer_offset = 0,
+        .buffer_size = static_cast<size_t>(host_bytes_per_layer) * info.resources.layers,
+        .buffer_row_length = Common::AlignUp(level_size.width, tile_size.width),
+        .buffer_image_height = Common::AlignUp(level_size.height, tile_size.height),
+        .image_subresource =
+            {
+                .base_level = level,
+                .base_layer = 0,
+                .num_layers = info.resources.layers,
+            },
+        .image_offset = {0, 0, 0},
+        .image_extent = level_size,
+    };
+}
+
 BufferCopy UploadBufferCopy(Tegra::MemoryManager& gpu_memory, GPUVAddr gpu_addr,
                             const ImageBase& image, std::span<u8> output) {
     gpu_memory.ReadBlockUnsafe(gpu_addr, output.data(), image.guest_size_bytes);
@@ -891,8 +980,9 @@ BufferCopy UploadBufferCopy(Tegra::MemoryManager& gpu_memory, GPUVAddr gpu_addr,
 }
 
 void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
-                  std::span<BufferImageCopy> copies) {
+                  std::span<BufferImageCopy> copies, bool transcode) {
     u32 output_offset = 0;
+    std::vector<u8> decoded;
 
     const Extent2D tile_size = DefaultBlockSize(info.format);
     for (BufferImageCopy& copy : copies) {
@@ -903,12 +993,32 @@ void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8
         ASSERT(copy.image_extent == mip_size);
         ASSERT(copy.buffer_row_length == Common::AlignUp(mip_size.width, tile_size.width));
         ASSERT(copy.buffer_image_height == Common::AlignUp(mip_size.height, tile_size.height));
+        if (IsPixelFormatASTC(info.format) && transcode) {
+            ASSERT(copy.image_extent.depth == 1);
+            const Extent3D decoded_extent{
+                .width = mip_size.width,
+                .height = mip_size.height,
+                .depth = static_cast<u32>(copy.image_subresource.num_layers),
+            };
+            decoded.resize(static_cast<size_t>(decoded_extent.width) * decoded_extent.height *
+                           decoded_extent.depth * CONVERTED_BYTES_PER_BLOCK);
+            DecompressASTC(input.subspan(copy.buffer_offset), copy.image_extent,
+                           copy.image_subresource.num_layers, tile_size, decoded);
+            CompressBC3(decoded, decoded_extent, output.subspan(output_offset));
+
+            const u32 bc3_size = CalculateBC3SizeBytes(decoded_extent);
+            copy.buffer_offset = output_offset;
+            copy.buffer_size = bc3_size;
+            copy.buffer_row_length = Common::AlignUp(mip_size.width, 4);
+            copy.buffer_image_height = Common::AlignUp(mip_size.height, 4);
+            output_offset += bc3_size;
+            continue;
+        }
         if (IsPixelFormatASTC(info.format)) {
             ASSERT(copy.image_extent.depth == 1);
-            Tegra::Texture::ASTC::Decompress(input.subspan(copy.buffer_offset),
-                                             copy.image_extent.width, copy.image_extent.height,
-                                             copy.image_subresource.num_layers, tile_size.width,
-                                             tile_size.height, output.subspan(output_offset));
+            DecompressASTC(input.subspan(copy.buffer_offset), copy.image_extent,
+                           copy.image_subresource.num_layers, tile_size,
+                           output.subspan(output_offset));
         } else {
             DecompressBC4(input.subspan(copy.buffer_offset), copy.image_extent,
                           output.subspan(output_offset));
@@ -1056,6 +1166,18 @@ bool IsPitchLinearSameSize(const ImageInfo& lhs, const ImageInfo& rhs, bool stri
     }
 }
 
+bool IsSameLayout(const ImageInfo& lhs, const ImageInfo& rhs) noexcept {
+    if (lhs.format != rhs.format || lhs.type != rhs.type || lhs.resources != rhs.resources ||
+        lhs.size != rhs.size || lhs.layer_stride != rhs.layer_stride ||
+        lhs.num_samples != rhs.num_samples || lhs.tile_width_spacing != rhs.tile_width_spacing) {
+        return false;
+    }
+    if (lhs.type == ImageType::Linear) {
+        return lhs.pitch == rhs.pitch;
+    }
+    return lhs.block == rhs.block;
+}
+
 std::optional<OverlapResult> ResolveOverlap(const ImageInfo& new_info, GPUVAddr gpu_addr,
                                             VAddr cpu_addr, const ImageBase& overlap,
                                             bool strict_size, bool broken_views, bool native_bgr) {
@@ -34,6 +34,10 @@ struct OverlapResult {
 
 [[nodiscard]] u32 CalculateConvertedSizeBytes(const ImageInfo& info) noexcept;
 
+[[nodiscard]] u32 CalculateUnswizzledLevelSizeBytes(const ImageInfo& info, s32 level) noexcept;
+
+[[nodiscard]] u32 CalculateConvertedLevelSizeBytes(const ImageInfo& info, s32 level) noexcept;
+
 [[nodiscard]] u32 CalculateLayerStride(const ImageInfo& info) noexcept;
 
 [[nodiscard]] u32 CalculateLayerSize(const ImageInfo& info) noexcept;
@@ -63,11 +67,15 @@ struct OverlapResult {
                                                           GPUVAddr gpu_addr, const ImageInfo& info,
                                                           std::span<u8> output);
 
+[[nodiscard]] BufferImageCopy UnswizzleImageLevel(Tegra::MemoryManager& gpu_memory,
+                                                  GPUVAddr gpu_addr, const ImageInfo& info,
+                                                  s32 level, std::span<u8> output);
+
 [[nodiscard]] BufferCopy UploadBufferCopy(Tegra::MemoryManager& gpu_memory, GPUVAddr gpu_addr,
                                           const ImageBase& image, std::span<u8> output);
 
 void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
-                  std::span<BufferImageCopy> copies);
+                  std::span<BufferImageCopy> copies, bool transcode = false);
 
 [[nodiscard]] std::vector<BufferImageCopy> FullDownloadCopies(const ImageInfo& info);
 
@@ -87,6 +95,8 @@ void SwizzleImage(Tegra::MemoryManager& gpu_memory, GPUVAddr gpu_addr, const Ima
 [[nodiscard]] bool IsPitchLinearSameSize(const ImageInfo& lhs, const ImageInfo& rhs,
                                          bool strict_size) noexcept;
 
+[[nodiscard]] bool IsSameLayout(const ImageInfo& lhs, const ImageInfo& rhs) noexcept;
+
 [[nodiscard]] std::optional<OverlapResult> ResolveOverlap(const ImageInfo& new_info,
                                                           GPUVAddr gpu_addr, VAddr cpu_addr,
                                                           const ImageBase& overlap,
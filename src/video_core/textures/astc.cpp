@@ -16,14 +16,19 @@
 // <http://gamma.cs.unc.edu/FasTC/>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
 #include <cstring>
+#include <memory>
+#include <mutex>
 #include <span>
 #include <vector>
 
 #include <boost/container/static_vector.hpp>
 
 #include "common/common_types.h"
+#include "common/thread_pool.h"
 #include "video_core/textures/astc.h"
 
 class InputBitStream {
@@ -1548,32 +1553,91 @@ static void DecompressBlock(std::span<const u8, 16> inBuf, const u32 blockWidth,
         }
 }
 
+/// Decodes the rows of blocks [first_row, last_row), counted across all layers
+static void DecompressRows(std::span<const u8> data, u32 width, u32 height, u32 block_width,
+                           u32 block_height, u32 first_row, u32 last_row, std::span<u8> output) {
+    const u32 blocks_x = (width + block_width - 1) / block_width;
+    const u32 rows_per_layer = (height + block_height - 1) / block_height;
+    for (u32 row = first_row; row < last_row; ++row) {
+        const u32 z = row / rows_per_layer;
+        const u32 y = (row % rows_per_layer) * block_height;
+        const std::size_t depth_offset = static_cast<std::size_t>(z) * height * width * 4;
+        u32 block_index = row * blocks_x;
+        for (u32 x = 0; x < width; x += block_width) {
+            const std::span<const u8, 16> blockPtr{data.subspan(block_index * 16, 16)};
+
+            // Blocks can be at most 12x12
+            std::array<u32, 12 * 12> uncompData;
+            DecompressBlock(blockPtr, block_width, block_height, uncompData);
+
+            u32 decompWidth = std::min(block_width, width - x);
+            u32 decompHeight = std::min(block_height, height - y);
+
+            const std::span<u8> outRow = output.subspan(depth_offset + (y * width + x) * 4);
+            for (u32 jj = 0; jj < decompHeight; jj++) {
+                std::memcpy(outRow.data() + jj * width * 4, uncompData.data() + jj * block_width,
+                            decompWidth * 4);
+            }
+            ++block_index;
+        }
+    }
+}
+
 void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
                 uint32_t block_width, uint32_t block_height, std::span<uint8_t> output) {
-    u32 block_index = 0;
-    std::size_t depth_offset = 0;
-    for (u32 z = 0; z < depth; z++) {
-        for (u32 y = 0; y < height; y += block_height) {
-            for (u32 x = 0; x < width; x += block_width) {
-                const std::span<const u8, 16> blockPtr{data.subspan(block_index * 16, 16)};
-
-                // Blocks can be at most 12x12
-                std::array<u32, 12 * 12> uncompData;
-                DecompressBlock(blockPtr, block_width, block_height, uncompData);
-
-                u32 decompWidth = std::min(block_width, width - x);
-                u32 decompHeight = std::min(block_height, height - y);
-
-                const std::span<u8> outRow = output.subspan(depth_offset + (y * width + x) * 4);
-                for (u32 jj = 0; jj < decompHeight; jj++) {
-                    std::memcpy(outRow.data() + jj * width * 4,
-                                uncompData.data() + jj * block_width, decompWidth * 4);
-                }
-                ++block_index;
-            }
+    // Images smaller than this are decoded on the calling thread, as the handoff costs more than
+    // the decode itself
+    static constexpr u32 MIN_BLOCKS_TO_SPLIT = 4096;
+    // Rows of blocks decoded by each task
+    static constexpr u32 ROWS_PER_TASK = 4;
+
+    const u32 blocks_x = (width + block_width - 1) / block_width;
+    const u32 num_rows = ((height + block_height - 1) / block_height) * depth;
+    if (blocks_x * num_rows < MIN_BLOCKS_TO_SPLIT) {
+        DecompressRows(data, width, height, block_width, block_height, 0, num_rows, output);
+        return;
+    }
+
+    // Tasks and the calling thread take chunks of rows until none are left. The caller only waits
+    // for the chunks to be decoded; tasks started after that find nothing left and never touch the
+    // spans, so busy pool workers can't hold up the caller.
+    struct DecodeState {
+        std::atomic<u32> next_chunk{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+        u32 chunks_done = 0;
+    };
+    const u32 num_chunks = (num_rows + ROWS_PER_TASK - 1) / ROWS_PER_TASK;
+    const auto state = std::make_shared<DecodeState>();
+    const auto decode_chunks = [=] {
+        u32 decoded = 0;
+        for (u32 chunk = state->next_chunk++; chunk < num_chunks; chunk = state->next_chunk++) {
+            const u32 first_row = chunk * ROWS_PER_TASK;
+            const u32 last_row = std::min(first_row + ROWS_PER_TASK, num_rows);
+            DecompressRows(data, width, height, block_width, block_height, first_row, last_row,
+                           output);
+            ++decoded;
+        }
+        if (decoded == 0) {
+            return;
         }
-        depth_offset += height * width * 4;
+        std::scoped_lock lock{state->mutex};
+        state->chunks_done += decoded;
+        if (state->chunks_done == num_chunks) {
+            state->cv.notify_all();
+        }
+    };
+
+    Common::ThreadPool& pool = Common::ThreadPool::Instance();
+    const u32 num_tasks = std::min(num_chunks - 1, static_cast<u32>(pool.NumWorkers()));
+    for (u32 task = 0; task < num_tasks; ++task) {
+        pool.Submit(Common::TaskPriority::LatencyCritical,
+                    [decode_chunks](std::stop_token) { decode_chunks(); });
     }
+    decode_chunks();
+
+    std::unique_lock lock{state->mutex};
+    state->cv.wait(lock, [&] { return state->chunks_done == num_chunks; });
 }
 
 } // namespace Tegra::Texture::ASTC
@@ -0,0 +1,98 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <filesystem>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/cityhash.h"
+#include "common/detached_tasks.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/zstd_compression.h"
+#include "video_core/textures/astc_disk_cache.h"
+
+namespace Tegra::Texture::ASTC {
+namespace {
+// Increment this when the decoder output changes
+constexpr u32 NativeVersion = 1;
+
+std::filesystem::path GetCacheDir() {
+    return Common::FS::GetYuzuPath(Common::FS::YuzuPath::ShaderDir) / "astc";
+}
+
+std::filesystem::path GetCachePath(u64 key) {
+    return GetCacheDir() / fmt::format("{:016X}.bin", key);
+}
+} // Anonymous namespace
+
+u64 MakeDiskCacheKey(std::span<const u8> data, u32 width, u32 height, u32 depth, u32 block_width,
+                     u32 block_height) {
+    const u64 dimensions = (static_cast<u64>(width) << 32) | (static_cast<u64>(height) << 16) |
+                           (static_cast<u64>(depth) << 8) | (block_width << 4) | block_height;
+    return Common::CityHash64WithSeed(reinterpret_cast<const char*>(data.data()), data.size(),
+                                      dimensions);
+}
+
+bool LoadFromDiskCache(u64 key, std::span<u8> output) {
+    Common::FS::IOFile file{GetCachePath(key), Common::FS::FileAccessMode::Read,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        return false;
+    }
+    u32 version{};
+    u64 decoded_size{};
+    if (!file.ReadObject(version) || !file.ReadObject(decoded_size)) {
+        return false;
+    }
+    if (version != NativeVersion || decoded_size != output.size()) {
+        return false;
+    }
+    const u64 compressed_size = file.GetSize() - static_cast<u64>(file.Tell());
+    std::vector<u8> compressed(compressed_size);
+    if (file.Read(compressed) != compressed.size()) {
+        LOG_ERROR(HW_GPU, "Failed to read decoded ASTC cache entry {:016X}", key);
+        return false;
+    }
+    const std::vector<u8> decoded = Common::Compression::DecompressDataZSTD(compressed);
+    if (decoded.size() != output.size()) {
+        LOG_ERROR(HW_GPU, "Decoded ASTC cache entry {:016X} is corrupted", key);
+        return false;
+    }
+    std::ranges::copy(decoded, output.begin());
+    return true;
+}
+
+void SaveToDiskCache(u64 key, std::span<const u8> decoded) {
+    // Compress on the calling thread so the decoded data doesn't have to be copied
+    std::vector<u8> compressed =
+        Common::Compression::CompressDataZSTDDefault(decoded.data(), decoded.size());
+    if (compressed.empty()) {
+        return;
+    }
+    Common::DetachedTasks::AddTask(
+        [key, decoded_size = static_cast<u64>(decoded.size()), compressed = std::move(compressed)] {
+            if (!Common::FS::CreateDirs(GetCacheDir())) {
+                LOG_ERROR(HW_GPU, "Failed to create decoded ASTC cache directory");
+                return;
+            }
+            Common::FS::IOFile file{GetCachePath(key), Common::FS::FileAccessMode::Write,
+                                    Common::FS::FileType::BinaryFile};
+            if (!file.IsOpen()) {
+                LOG_ERROR(HW_GPU, "Failed to create decoded ASTC cache entry {:016X}", key);
+                return;
+            }
+            if (!file.WriteObject(NativeVersion) || !file.WriteObject(decoded_size) ||
+                file.Write(compressed) != compressed.size()) {
+                LOG_ERROR(HW_GPU, "Failed to write decoded ASTC cache entry {:016X}", key);
+            }
+        });
+}
+
+} // namespace Tegra::Texture::ASTC
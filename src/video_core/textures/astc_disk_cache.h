@@ -0,0 +1,24 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <span>
+
+#include "common/common_types.h"
+
+namespace Tegra::Texture::ASTC {
+
+/// Returns the key of the decoded result of an ASTC image, built from its blocks and dimensions.
+[[nodiscard]] u64 MakeDiskCacheKey(std::span<const u8> data, u32 width, u32 height, u32 depth,
+                                   u32 block_width, u32 block_height);
+
+/// Loads a decoded image from the disk cache.
+/// Returns false when it's missing or its size doesn't match the output.
+[[nodiscard]] bool LoadFromDiskCache(u64 key, std::span<u8> output);
+
+/// Stores a decoded image in the disk cache. The file is written in the background.
+void SaveToDiskCache(u64 key, std::span<const u8> decoded);
+
+} // namespace Tegra::Texture::ASTC
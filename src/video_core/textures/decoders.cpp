@@ -18,6 +18,89 @@
 
 namespace Tegra::Texture {
 namespace {
+/// Number of bytes in a GOB row that are contiguous in memory
+constexpr u32 GOB_RUN_SIZE = 16;
+
+/// Copies a fixed amount of bytes between swizzled and linear memory.
+/// The size being a constant lets the copy compile to plain vector loads and stores.
+template <bool TO_LINEAR, u32 SIZE>
+void CopyBytes(u8* output, const u8* input, u32 swizzled_offset, u32 unswizzled_offset) {
+    u8* const dst = output + (TO_LINEAR ? swizzled_offset : unswizzled_offset);
+    const u8* const src = input + (TO_LINEAR ? unswizzled_offset : swizzled_offset);
+    std::memcpy(dst, src, SIZE);
+}
+
+/**
+ * Copies the bytes [x_begin, x_end) of a row between swizzled and linear memory.
+ * Each row of a GOB is made of 16 byte runs that are contiguous in memory, so whole runs are copied
+ * at once and only the unaligned pixels at the edges are copied one by one.
+ */
+template <bool TO_LINEAR, u32 BYTES_PER_PIXEL>
+void SwizzleRow(u8* output, const u8* input, u32 swizzled_base, u32 unswizzled_base,
+                const std::array<u32, GOB_SIZE_X>& table, u32 x_shift, u32 x_begin, u32 x_end) {
+    static_assert(GOB_RUN_SIZE % BYTES_PER_PIXEL == 0);
+    const auto swizzled_offset = [&](u32 x) {
+        return swizzled_base + ((x >> GOB_SIZE_X_SHIFT) << x_shift) + table[x % GOB_SIZE_X];
+    };
+    const auto unswizzled_offset = [&](u32 x) { return unswizzled_base + x - x_begin; };
+
+    u32 x = x_begin;
+    for (; x < x_end && x % GOB_RUN_SIZE != 0; x += BYTES_PER_PIXEL) {
+        CopyBytes<TO_LINEAR, BYTES_PER_PIXEL>(output, input, swizzled_offset(x),
+                                              unswizzled_offset(x));
+    }
+    for (; x + GOB_RUN_SIZE <= x_end; x += GOB_RUN_SIZE) {
+        CopyBytes<TO_LINEAR, GOB_RUN_SIZE>(output, input, swizzled_offset(x), unswizzled_offset(x));
+    }
+    for (; x < x_end; x += BYTES_PER_PIXEL) {
+        CopyBytes<TO_LINEAR, BYTES_PER_PIXEL>(output, input, swizzled_offset(x),
+                                              unswizzled_offset(x));
+    }
+}
+
+/// Copies the bytes [x_begin, x_end) of a row with a pixel size that doesn't divide a GOB run.
+template <bool TO_LINEAR>
+void SwizzleRowGeneric(u8* output, const u8* input, u32 swizzled_base, u32 unswizzled_base,
+                       const std::array<u32, GOB_SIZE_X>& table, u32 x_shift, u32 x_begin,
+                       u32 x_end, u32 bytes_per_pixel) {
+    for (u32 x = x_begin; x < x_end; x += bytes_per_pixel) {
+        const u32 swizzled_offset =
+            swizzled_base + ((x >> GOB_SIZE_X_SHIFT) << x_shift) + table[x % GOB_SIZE_X];
+        const u32 unswizzled_offset = unswizzled_base + x - x_begin;
+
+        u8* const dst = output + (TO_LINEAR ? swizzled_offset : unswizzled_offset);
+        const u8* const src = input + (TO_LINEAR ? unswizzled_offset : swizzled_offset);
+        std::memcpy(dst, src, bytes_per_pixel);
+    }
+}
+
+/// Dispatches a row copy to the kernel specialized for the pixel size.
+template <bool TO_LINEAR>
+void SwizzleRow(u8* output, const u8* input, u32 swizzled_base, u32 unswizzled_base,
+                const std::array<u32, GOB_SIZE_X>& table, u32 x_shift, u32 x_begin, u32 x_end,
+                u32 bytes_per_pixel) {
+    switch (bytes_per_pixel) {
+    case 1:
+        return SwizzleRow<TO_LINEAR, 1>(output, input, swizzled_base, unswizzled_base, table,
+                                        x_shift, x_begin, x_end);
+    case 2:
+        return SwizzleRow<TO_LINEAR, 2>(output, input, swizzled_base, unswizzled_base, table,
+                                        x_shift, x_begin, x_end);
+    case 4:
+        return SwizzleRow<TO_LINEAR, 4>(output, input, swizzled_base, unswizzled_base, table,
+                                        x_shift, x_begin, x_end);
+    case 8:
+        return SwizzleRow<TO_LINEAR, 8>(output, input, swizzled_base, unswizzled_base, table,
+                                        x_shift, x_begin, x_end);
+    case 16:
+        return SwizzleRow<TO_LINEAR, 16>(output, input, swizzled_base, unswizzled_base, table,
+                                         x_shift, x_begin, x_end);
+    default:
+        return SwizzleRowGeneric<TO_LINEAR>(output, input, swizzled_base, unswizzled_base, table,
+                                            x_shift, x_begin, x_end, bytes_per_pixel);
+    }
+}
+
 template <bool TO_LINEAR>
 void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
              u32 height, u32 depth, u32 block_height, u32 block_depth, u32 stride_alignment) {
@@ -27,6 +110,10 @@ void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixe
     static constexpr u32 origin_y = 0;
     static constexpr u32 origin_z = 0;
 
+    if (width == 0) {
+        return;
+    }
+
     // We can configure here a custom pitch
     // As it's not exposed 'width * bpp' will be the expected pitch.
     const u32 pitch = width * bytes_per_pixel;
@@ -41,6 +128,10 @@ void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixe
     const u32 block_depth_mask = (1U << block_depth) - 1;
     const u32 x_shift = GOB_SIZE_SHIFT + block_height + block_depth;
 
+    const u32 x_begin = origin_x * bytes_per_pixel;
+    const u32 x_end = x_begin + pitch;
+    const u32 last_x = x_end - bytes_per_pixel;
+
     for (u32 slice = 0; slice < depth; ++slice) {
         const u32 z = slice + origin_z;
         const u32 offset_z = (z >> block_depth) * slice_size +
@@ -53,28 +144,24 @@ void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixe
             const u32 offset_y = (block_y >> block_height) * block_size +
                                  ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
 
-            for (u32 column = 0; column < width; ++column) {
-                const u32 x = (column + origin_x) * bytes_per_pixel;
-                const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << x_shift;
-
-                const u32 base_swizzled_offset = offset_z + offset_y + offset_x;
-                const u32 swizzled_offset = base_swizzled_offset + table[x % GOB_SIZE_X];
-
-                const u32 unswizzled_offset =
-                    slice * pitch * height + line * pitch + column * bytes_per_pixel;
-
-                if (const auto offset = (TO_LINEAR ? unswizzled_offset : swizzled_offset);
-                    offset >= input.size()) {
-                    // TODO(Rodrigo): This is an out of bounds access that should never happen. To
-                    // avoid crashing the emulator, break.
-                    ASSERT_MSG(false, "offset {} exceeds input size {}!", offset, input.size());
-                    break;
-                }
-
-                u8* const dst = &output[TO_LINEAR ? swizzled_offset : unswizzled_offset];
-                const u8* const src = &input[TO_LINEAR ? unswizzled_offset : swizzled_offset];
-                std::memcpy(dst, src, bytes_per_pixel);
+            const u32 swizzled_base = offset_z + offset_y;
+            const u32 unswizzled_base = slice * pitch * height + line * pitch;
+
+            // Offsets grow along a row on both sides, so checking the last pixel covers the row
+            const u32 last_swizzled_offset = swizzled_base +
+                                             ((last_x >> GOB_SIZE_X_SHIFT) << x_shift) +
+                                             table[last_x % GOB_SIZE_X];
+            const u32 last_unswizzled_offset = unswizzled_base + last_x - x_begin;
+            if (const auto offset = (TO_LINEAR ? last_unswizzled_offset : last_swizzled_offset);
+                offset >= input.size()) {
+                // TODO(Rodrigo): This is an out of bounds access that should never happen. To
+                // avoid crashing the emulator, skip the row.
+                ASSERT_MSG(false, "offset {} exceeds input size {}!", offset, input.size());
+                continue;
             }
+
+            SwizzleRow<TO_LINEAR>(output.data(), input.data(), swizzled_base, unswizzled_base,
+                                  table, x_shift, x_begin, x_end, bytes_per_pixel);
         }
     }
 }
@@ -100,23 +187,17 @@ void SwizzleSubrect(u32 subrect_width, u32 subrect_height, u32 source_pitch, u32
     const u32 block_height = 1U << block_height_bit;
     const u32 image_width_in_gobs =
         (swizzled_width * bytes_per_pixel + (GOB_SIZE_X - 1)) / GOB_SIZE_X;
+    const u32 x_shift = GOB_SIZE_SHIFT + block_height_bit;
+    const u32 x_begin = offset_x * bytes_per_pixel;
+    const u32 x_end = x_begin + subrect_width * bytes_per_pixel;
     for (u32 line = 0; line < subrect_height; ++line) {
         const u32 dst_y = line + offset_y;
         const u32 gob_address_y =
             (dst_y / (GOB_SIZE_Y * block_height)) * GOB_SIZE * block_height * image_width_in_gobs +
             ((dst_y % (GOB_SIZE_Y * block_height)) / GOB_SIZE_Y) * GOB_SIZE;
         const auto& table = SWIZZLE_TABLE[dst_y % GOB_SIZE_Y];
-        for (u32 x = 0; x < subrect_width; ++x) {
-            const u32 dst_x = x + offset_x;
-            const u32 gob_address =
-                gob_address_y + (dst_x * bytes_per_pixel / GOB_SIZE_X) * GOB_SIZE * block_height;
-            const u32 swizzled_offset = gob_address + table[(dst_x * bytes_per_pixel) % GOB_SIZE_X];
-            const u32 unswizzled_offset = line * source_pitch + x * bytes_per_pixel;
-
-            const u8* const source_line = unswizzled_data + unswizzled_offset;
-            u8* const dest_addr = swizzled_data + swizzled_offset;
-            std::memcpy(dest_addr, source_line, bytes_per_pixel);
-        }
+        SwizzleRow<true>(swizzled_data, unswizzled_data, gob_address_y, line * source_pitch, table,
+                         x_shift, x_begin, x_end, bytes_per_pixel);
     }
 }
 
@@ -128,6 +209,8 @@ void UnswizzleSubrect(u32 line_length_in, u32 line_count, u32 pitch, u32 width,
 
     const u32 block_height_mask = (1U << block_height) - 1;
     const u32 x_shift = GOB_SIZE_SHIFT + block_height;
+    const u32 x_begin = origin_x * bytes_per_pixel;
+    const u32 x_end = x_begin + line_length_in * bytes_per_pixel;
 
     for (u32 line = 0; line < line_count; ++line) {
         const u32 src_y = line + origin_y;
@@ -136,15 +219,8 @@ void UnswizzleSubrect(u32 line_length_in, u32 line_count, u32 pitch, u32 width,
         const u32 block_y = src_y >> GOB_SIZE_Y_SHIFT;
         const u32 src_offset_y = (block_y >> block_height) * block_size +
                                  ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
-        for (u32 column = 0; column < line_length_in; ++column) {
-            const u32 src_x = (column + origin_x) * bytes_per_pixel;
-            const u32 src_offset_x = (src_x >> GOB_SIZE_X_SHIFT) << x_shift;
-
-            const u32 swizzled_offset = src_offset_y + src_offset_x + table[src_x % GOB_SIZE_X];
-            const u32 unswizzled_offset = line * pitch + column * bytes_per_pixel;
-
-            std::memcpy(output + unswizzled_offset, input + swizzled_offset, bytes_per_pixel);
-        }
+        SwizzleRow<false>(output, input, src_offset_y, line * pitch, table, x_shift, x_begin,
+                          x_end, bytes_per_pixel);
     }
 }
 
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <bitset>
 #include <chrono>
 #include <optional>
@@ -230,7 +231,7 @@ Device::Device(VkInstance instance_, vk::PhysicalDevice physical_, VkSurfaceKHR
             .samplerAnisotropy = true,
             .textureCompressionETC2 = false,
             .textureCompressionASTC_LDR = is_optimal_astc_supported,
-            .textureCompressionBC = false,
+            .textureCompressionBC = is_optimal_bcn_supported,
             .occlusionQueryPrecise = true,
             .pipelineStatisticsQuery = false,
             .vertexPipelineStoresAndAtomics = true,
@@ -389,6 +390,20 @@ Device::Device(VkInstance instance_, vk::PhysicalDevice physical_, VkSurfaceKHR
         LOG_INFO(Render_Vulkan, "Device doesn't support extended dynamic state");
     }
 
+#ifdef VK_KHR_dynamic_rendering
+    VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamic_rendering;
+    if (khr_dynamic_rendering) {
+        dynamic_rendering = {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR,
+            .pNext = nullptr,
+            .dynamicRendering = VK_TRUE,
+        };
+        SetNext(next, dynamic_rendering);
+    } else {
+        LOG_INFO(Render_Vulkan, "Device doesn't support dynamic rendering");
+    }
+#endif
+
     if (!ext_depth_range_unrestricted) {
         LOG_INFO(Render_Vulkan, "Device doesn't support depth range unrestricted");
     }
@@ -426,8 +441,16 @@ Device::Device(VkInstance instance_, vk::PhysicalDevice physical_, VkSurfaceKHR
 
     graphics_queue = logical.GetQueue(graphics_family);
     present_queue = logical.GetQueue(present_family);
+    if (has_transfer_queue) {
+        transfer_queue = logical.GetQueue(transfer_family);
+    }
+    if (has_compute_queue) {
+        compute_queue = logical.GetQueue(compute_family);
+    }
 
     use_asynchronous_shaders = Settings::values.use_asynchronous_shaders.GetValue();
+    use_astc_transcoding = Settings::values.transcode_astc.GetValue() &&
+                           !is_optimal_astc_supported && IsOptimalBc3Supported();
 }
 
 Device::~Device() = default;
@@ -511,6 +534,33 @@ bool Device::IsOptimalAstcSupported(const VkPhysicalDeviceFeatures& features) co
     return true;
 }
 
+bool Device::IsOptimalBcnSupported(const VkPhysicalDeviceFeatures& features) const {
+    static constexpr std::array bcn_formats = {
+        VK_FORMAT_BC1_RGBA_UNORM_BLOCK, VK_FORMAT_BC1_RGBA_SRGB_BLOCK, VK_FORMAT_BC2_UNORM_BLOCK,
+        VK_FORMAT_BC2_SRGB_BLOCK,       VK_FORMAT_BC3_UNORM_BLOCK,     VK_FORMAT_BC3_SRGB_BLOCK,
+        VK_FORMAT_BC4_UNORM_BLOCK,      VK_FORMAT_BC4_SNORM_BLOCK,     VK_FORMAT_BC5_UNORM_BLOCK,
+        VK_FORMAT_BC5_SNORM_BLOCK,
+    };
+    if (!features.textureCompressionBC) {
+        return false;
+    }
+    static constexpr VkFormatFeatureFlags required_features =
+        VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_TRANSFER_SRC_BIT |
+        VK_FORMAT_FEATURE_TRANSFER_DST_BIT;
+    return std::ranges::all_of(bcn_formats, [this](VkFormat format) {
+        const auto format_features = physical.GetFormatProperties(format).optimalTilingFeatures;
+        return (format_features & required_features) == required_features;
+    });
+}
+
+bool Device::IsOptimalBc3Supported() const {
+    static constexpr VkFormatFeatureFlags required_features =
+        VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_TRANSFER_SRC_BIT |
+        VK_FORMAT_FEATURE_TRANSFER_DST_BIT;
+    return IsFormatSupported(VK_FORMAT_BC3_UNORM_BLOCK, required_features, FormatType::Optimal) &&
+           IsFormatSupported(VK_FORMAT_BC3_SRGB_BLOCK, required_features, FormatType::Optimal);
+}
+
 bool Device::TestDepthStencilBlits() const {
     static constexpr VkFormatFeatureFlags required_features =
         VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT;
@@ -651,6 +701,11 @@ std::vector<const char*> Device::LoadExtensions(bool requires_surface) {
     bool has_ext_transform_feedback{};
     bool has_ext_custom_border_color{};
     bool has_ext_extended_dynamic_state{};
+#ifdef VK_KHR_dynamic_rendering
+    bool has_khr_dynamic_rendering{};
+    bool has_khr_create_renderpass2{};
+    bool has_khr_depth_stencil_resolve{};
+#endif
     for (const VkExtensionProperties& extension : physical.EnumerateDeviceExtensionProperties()) {
         const auto test = [&](std::optional<std::reference_wrapper<bool>> status, const char* name,
                               bool push) {
@@ -675,10 +730,16 @@ std::vector<const char*> Device::LoadExtensions(bool requires_surface) {
              true);
         test(ext_tooling_info, VK_EXT_TOOLING_INFO_EXTENSION_NAME, true);
         test(ext_shader_stencil_export, VK_EXT_SHADER_STENCIL_EXPORT_EXTENSION_NAME, true);
+        test(ext_memory_budget, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME, true);
         test(has_ext_transform_feedback, VK_EXT_TRANSFORM_FEEDBACK_EXTENSION_NAME, false);
         test(has_ext_custom_border_color, VK_EXT_CUSTOM_BORDER_COLOR_EXTENSION_NAME, false);
         test(has_ext_extended_dynamic_state, VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME, false);
         test(has_ext_subgroup_size_control, VK_EXT_SUBGROUP_SIZE_CONTROL_EXTENSION_NAME, false);
+#ifdef VK_KHR_dynamic_rendering
+        test(has_khr_dynamic_rendering, VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME, false);
+        test(has_khr_create_renderpass2, VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME, false);
+        test(has_khr_depth_stencil_resolve, VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME, false);
+#endif
         if (Settings::values.renderer_debug) {
             test(nv_device_diagnostics_config, VK_NV_DEVICE_DIAGNOSTICS_CONFIG_EXTENSION_NAME,
                  true);
@@ -771,6 +832,24 @@ std::vector<const char*> Device::LoadExtensions(bool requires_surface) {
             ext_extended_dynamic_state = true;
         }
     }
+#ifdef VK_KHR_dynamic_rendering
+    // VK_KHR_dynamic_rendering depends on VK_KHR_depth_stencil_resolve, which depends on
+    // VK_KHR_create_renderpass2
+    if (has_khr_dynamic_rendering && has_khr_create_renderpass2 && has_khr_depth_stencil_resolve) {
+        VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamic_rendering;
+        dynamic_rendering.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+        dynamic_rendering.pNext = nullptr;
+        features.pNext = &dynamic_rendering;
+        physical.GetFeatures2KHR(features);
+
+        if (dynamic_rendering.dynamicRendering) {
+            extensions.push_back(VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME);
+            extensions.push_back(VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME);
+            extensions.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+            khr_dynamic_rendering = true;
+        }
+    }
+#endif
     return extensions;
 }
 
@@ -803,6 +882,46 @@ void Device::SetupFamilies(VkSurfaceKHR surface) {
     }
     graphics_family = *graphics;
     present_family = *present;
+    sharing_families[num_sharing_families++] = graphics_family;
+
+    // Only queues without graphics run on separate engines, in parallel with rendering
+    const auto find_family = [&](VkQueueFlags wanted_flags,
+                                 VkQueueFlags unwanted_flags) -> std::optional<u32> {
+        for (u32 index = 0; index < static_cast<u32>(queue_family_properties.size()); ++index) {
+            const VkQueueFamilyProperties& queue_family = queue_family_properties[index];
+            const VkExtent3D& granularity = queue_family.minImageTransferGranularity;
+            if (queue_family.queueCount == 0 ||
+                (queue_family.queueFlags & (wanted_flags | unwanted_flags)) != wanted_flags) {
+                continue;
+            }
+            if (granularity.width != 1 || granularity.height != 1 || granularity.depth != 1) {
+                continue;
+            }
+            return index;
+        }
+        return std::nullopt;
+    };
+    if (Settings::values.use_transfer_queue.GetValue()) {
+        const std::optional<u32> transfer = find_family(
+            VK_QUEUE_TRANSFER_BIT, VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+        if (transfer) {
+            transfer_family = *transfer;
+            sharing_families[num_sharing_families++] = transfer_family;
+            has_transfer_queue = true;
+        } else {
+            LOG_INFO(Render_Vulkan, "Device lacks a dedicated transfer queue");
+        }
+    }
+    if (Settings::values.use_async_compute.GetValue()) {
+        const std::optional<u32> compute = find_family(VK_QUEUE_COMPUTE_BIT, VK_QUEUE_GRAPHICS_BIT);
+        if (compute) {
+            compute_family = *compute;
+            sharing_families[num_sharing_families++] = compute_family;
+            has_compute_queue = true;
+        } else {
+            LOG_INFO(Render_Vulkan, "Device lacks an async compute queue");
+        }
+    }
 }
 
 void Device::SetupFeatures() {
@@ -811,6 +930,7 @@ void Device::SetupFeatures() {
     is_shader_storage_image_multisample = supported_features.shaderStorageImageMultisample;
     is_blit_depth_stencil_supported = TestDepthStencilBlits();
     is_optimal_astc_supported = IsOptimalAstcSupported(supported_features);
+    is_optimal_bcn_supported = IsOptimalBcnSupported(supported_features);
 }
 
 void Device::CollectTelemetryParameters() {
@@ -841,13 +961,35 @@ void Device::CollectTelemetryParameters() {
 }
 
 void Device::CollectPhysicalMemoryInfo() {
-    const auto mem_properties = physical.GetMemoryProperties();
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budget{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT,
+        .pNext = nullptr,
+        .heapBudget = {},
+        .heapUsage = {},
+    };
+    VkPhysicalDeviceMemoryProperties2KHR mem_properties2{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2_KHR,
+        .pNext = &budget,
+        .memoryProperties = {},
+    };
+    const bool has_budget = ext_memory_budget && dld.vkGetPhysicalDeviceMemoryProperties2KHR;
+    if (has_budget) {
+        physical.GetMemoryProperties2KHR(mem_properties2);
+    } else {
+        mem_properties2.memoryProperties = physical.GetMemoryProperties();
+    }
+    const auto& mem_properties = mem_properties2.memoryProperties;
     const size_t num_properties = mem_properties.memoryHeapCount;
     device_access_memory = 0;
     for (size_t element = 0; element < num_properties; ++element) {
-        if ((mem_properties.memoryHeaps[element].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0) {
-            device_access_memory += mem_properties.memoryHeaps[element].size;
+        if ((mem_properties.memoryHeaps[element].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) == 0) {
+            continue;
         }
+        // The budget accounts for memory used by other processes, prefer it when available
+        const VkDeviceSize heap_size = mem_properties.memoryHeaps[element].size;
+        const VkDeviceSize heap_budget = budget.heapBudget[element];
+        device_access_memory +=
+            has_budget && heap_budget != 0 ? std::min(heap_size, heap_budget) : heap_size;
     }
 }
 
@@ -881,6 +1023,12 @@ std::vector<VkDeviceQueueCreateInfo> Device::GetDeviceQueueCreateInfos() const {
     static constexpr float QUEUE_PRIORITY = 1.0f;
 
     std::unordered_set<u32> unique_queue_families{graphics_family, present_family};
+    if (has_transfer_queue) {
+        unique_queue_families.insert(transfer_family);
+    }
+    if (has_compute_queue) {
+        unique_queue_families.insert(compute_family);
+    }
     std::vector<VkDeviceQueueCreateInfo> queue_cis;
     queue_cis.reserve(unique_queue_families.size());
 
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <array>
+#include <span>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -39,6 +41,10 @@ public:
     VkFormat GetSupportedFormat(VkFormat wanted_format, VkFormatFeatureFlags wanted_usage,
                                 FormatType format_type) const;
 
+    /// Returns true if a format is supported.
+    bool IsFormatSupported(VkFormat wanted_format, VkFormatFeatureFlags wanted_usage,
+                           FormatType format_type) const;
+
     /// Reports a device loss.
     void ReportLoss() const;
 
@@ -83,6 +89,44 @@ public:
         return present_family;
     }
 
+    /// Returns true when a dedicated transfer queue is used for uploads.
+    bool HasTransferQueue() const {
+        return has_transfer_queue;
+    }
+
+    /// Returns the dedicated transfer queue.
+    vk::Queue GetTransferQueue() const {
+        return transfer_queue;
+    }
+
+    /// Returns the dedicated transfer queue family index.
+    u32 GetTransferFamily() const {
+        return transfer_family;
+    }
+
+    /// Returns true when a dedicated compute queue is used for texture decoding.
+    bool HasComputeQueue() const {
+        return has_compute_queue;
+    }
+
+    /// Returns the dedicated compute queue.
+    vk::Queue GetComputeQueue() const {
+        return compute_queue;
+    }
+
+    /// Returns the dedicated compute queue family index.
+    u32 GetComputeFamily() const {
+        return compute_family;
+    }
+
+    /// Returns the queue families staging buffers have to be shared with, empty when exclusive.
+    std::span<const u32> GetStagingSharingFamilies() const {
+        if (num_sharing_families < 2) {
+            return {};
+        }
+        return std::span(sharing_families.data(), num_sharing_families);
+    }
+
     /// Returns the current Vulkan API version provided in Vulkan-formatted version numbers.
     u32 ApiVersion() const {
         return properties.apiVersion;
@@ -93,6 +137,11 @@ public:
         return properties.driverVersion;
     }
 
+    /// Returns the PCI vendor ID of the physical device.
+    u32 GetVendorID() const {
+        return properties.vendorID;
+    }
+
     /// Returns the device name.
     std::string_view GetModelName() const {
         return properties.deviceName;
@@ -103,6 +152,11 @@ public:
         return driver_id;
     }
 
+    /// Returns the UUID identifying pipeline caches compatible with this device and driver.
+    std::span<const u8, VK_UUID_SIZE> GetPipelineCacheUUID() const {
+        return properties.pipelineCacheUUID;
+    }
+
     /// Returns uniform buffer alignment requeriment.
     VkDeviceSize GetUniformBufferAlignment() const {
         return properties.limits.minUniformBufferOffsetAlignment;
@@ -128,11 +182,26 @@ public:
         return properties.limits.maxComputeSharedMemorySize;
     }
 
+    /// Returns true if the graphics and compute queues support timestamp queries.
+    bool IsTimestampQuerySupported() const {
+        return properties.limits.timestampComputeAndGraphics != VK_FALSE;
+    }
+
+    /// Returns the nanoseconds a timestamp query unit lasts.
+    float GetTimestampPeriod() const {
+        return properties.limits.timestampPeriod;
+    }
+
     /// Returns true if ASTC is natively supported.
     bool IsOptimalAstcSupported() const {
         return is_optimal_astc_supported;
     }
 
+    /// Returns true if BC1 to BC5 are natively supported.
+    bool IsOptimalBcnSupported() const {
+        return is_optimal_bcn_supported;
+    }
+
     /// Returns true if the device supports float16 natively
     bool IsFloat16Supported() const {
         return is_float16_supported;
@@ -203,6 +272,16 @@ public:
         return ext_extended_dynamic_state;
     }
 
+    /// Returns true if the device supports VK_KHR_dynamic_rendering.
+    bool IsKhrDynamicRenderingSupported() const {
+        return khr_dynamic_rendering;
+    }
+
+    /// Returns true if the device supports VK_EXT_memory_budget.
+    bool IsExtMemoryBudgetSupported() const {
+        return ext_memory_budget;
+    }
+
     /// Returns true if the device supports VK_EXT_shader_stencil_export.
     bool IsExtShaderStencilExportSupported() const {
         return ext_shader_stencil_export;
@@ -228,6 +307,11 @@ public:
         return use_asynchronous_shaders;
     }
 
+    /// Returns true if ASTC images are stored as BC3 on the host.
+    bool UseAstcTranscoding() const {
+        return use_astc_transcoding;
+    }
+
     u64 GetDeviceLocalMemory() const {
         return device_access_memory;
     }
@@ -260,13 +344,15 @@ private:
     /// Returns true if ASTC textures are natively supported.
     bool IsOptimalAstcSupported(const VkPhysicalDeviceFeatures& features) const;
 
+    /// Returns true if BC1 to BC5 textures are natively supported.
+    bool IsOptimalBcnSupported(const VkPhysicalDeviceFeatures& features) const;
+
+    /// Returns true if the device can sample and upload BC3 images.
+    bool IsOptimalBc3Supported() const;
+
     /// Returns true if the device natively supports blitting depth stencil images.
     bool TestDepthStencilBlits() const;
 
-    /// Returns true if a format is supported.
-    bool IsFormatSupported(VkFormat wanted_format, VkFormatFeatureFlags wanted_usage,
-                           FormatType format_type) const;
-
     VkInstance instance;                        ///< Vulkan instance.
     vk::DeviceDispatch dld;                     ///< Device function pointers.
     vk::PhysicalDevice physical;                ///< Physical device.
@@ -274,13 +360,22 @@ private:
     vk::Device logical;                         ///< Logical device.
     vk::Queue graphics_queue;                   ///< Main graphics queue.
     vk::Queue present_queue;                    ///< Main present queue.
+    vk::Queue transfer_queue;                   ///< Dedicated transfer queue.
+    vk::Queue compute_queue;                    ///< Dedicated compute queue.
     u32 instance_version{};                     ///< Vulkan onstance version.
     u32 graphics_family{};                      ///< Main graphics queue family index.
     u32 present_family{};                       ///< Main present queue family index.
+    u32 transfer_family{};                      ///< Dedicated transfer queue family index.
+    u32 compute_family{};                       ///< Dedicated compute queue family index.
+    std::array<u32, 3> sharing_families{};      ///< Families sharing staging buffers.
+    u32 num_sharing_families{};                 ///< Number of families sharing staging buffers.
+    bool has_transfer_queue{};                  ///< Uploads can be done on the transfer queue.
+    bool has_compute_queue{};                   ///< Decoding can be done on the compute queue.
     VkDriverIdKHR driver_id{};                  ///< Driver ID.
     VkShaderStageFlags guest_warp_stages{};     ///< Stages where the guest warp size can be forced.
-    u64 device_access_memory{};                 ///< Total size of device local memory in bytes.
+    u64 device_access_memory{};                 ///< Usable size of device local memory in bytes.
     bool is_optimal_astc_supported{};           ///< Support for native ASTC.
+    bool is_optimal_bcn_supported{};            ///< Support for native BC1 to BC5.
     bool is_float16_supported{};                ///< Support for float16 arithmetics.
     bool is_warp_potentially_bigger{};          ///< Host warp size can be bigger than guest.
     bool is_formatless_image_load_supported{};  ///< Support for shader image read without format.
@@ -297,12 +392,15 @@ private:
     bool ext_custom_border_color{};             ///< Support for VK_EXT_custom_border_color.
     bool ext_extended_dynamic_state{};          ///< Support for VK_EXT_extended_dynamic_state.
     bool ext_shader_stencil_export{};           ///< Support for VK_EXT_shader_stencil_export.
+    bool ext_memory_budget{};                   ///< Support for VK_EXT_memory_budget.
+    bool khr_dynamic_rendering{};               ///< Support for VK_KHR_dynamic_rendering.
     bool nv_device_diagnostics_config{};        ///< Support for VK_NV_device_diagnostics_config.
     bool has_renderdoc{};                       ///< Has RenderDoc attached
     bool has_nsight_graphics{};                 ///< Has Nsight Graphics attached
 
     // Asynchronous Graphics Pipeline setting
     bool use_asynchronous_shaders{}; ///< Setting to use asynchronous shaders/graphics pipeline
+    bool use_astc_transcoding{};     ///< Setting to transcode ASTC images to BC3
 
     // Telemetry parameters
     std::string vendor_name;                      ///< Device's driver name.
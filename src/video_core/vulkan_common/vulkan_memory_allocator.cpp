@@ -19,6 +19,12 @@
 
 namespace Vulkan {
 namespace {
+/// Size of the pages backing the slab allocator; a page holds many commits of one size class
+constexpr u64 SLAB_PAGE_SIZE = 1ULL << 20;
+
+/// Number of empty allocations kept alive while their heap is within budget
+constexpr size_t MAX_EMPTY_ALLOCATIONS = 2;
+
 struct Range {
     u64 begin;
     u64 end;
@@ -99,12 +105,14 @@ public:
             .end = *alloc + size,
         };
         commits.insert(std::ranges::upper_bound(commits, *alloc, {}, &Range::begin), range);
+        used_size += size;
         return std::make_optional<MemoryCommit>(this, *memory, *alloc, *alloc + size);
     }
 
     void Free(u64 begin) {
         const auto it = std::ranges::find(commits, begin, &Range::begin);
         ASSERT_MSG(it != commits.end(), "Invalid commit");
+        used_size -= it->end - it->begin;
         commits.erase(it);
         if (commits.empty()) {
             // Do not call any code involving 'this' after this call, the object will be destroyed
@@ -150,6 +158,21 @@ public:
         return (flags & property_flags) == property_flags && (type_mask & shifted_memory_type) != 0;
     }
 
+    /// Returns true when the allocation has no commits.
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return commits.empty();
+    }
+
+    /// Returns true when less than a quarter of the allocation is in use.
+    [[nodiscard]] bool IsSparse() const noexcept {
+        return !commits.empty() && used_size * 4 < allocation_size;
+    }
+
+    /// Returns the Vulkan memory type index of the allocation.
+    [[nodiscard]] u32 MemoryType() const noexcept {
+        return static_cast<u32>(std::countr_zero(shifted_memory_type));
+    }
+
 private:
     [[nodiscard]] static constexpr u32 ShiftType(u32 type) {
         return 1U << type;
@@ -181,15 +204,65 @@ private:
     const VkMemoryPropertyFlags property_flags; ///< Vulkan memory property flags.
     const u32 shifted_memory_type;              ///< Shifted Vulkan memory type.
     std::vector<Range> commits;                 ///< All commit ranges done from this allocation.
+    u64 used_size = 0;                          ///< Bytes used by commits.
     std::span<u8> memory_mapped_span; ///< Memory mapped span. Empty if not queried before.
 #if defined(_WIN32) || defined(__unix__)
     u32 owning_opengl_handle{}; ///< Owning OpenGL memory object handle.
 #endif
 };
 
+class MemorySlab {
+public:
+    explicit MemorySlab(MemoryAllocator* allocator_, MemoryCommit page_, u64 slot_size_)
+        : allocator{allocator_}, page{std::move(page_)}, slot_size{slot_size_},
+          num_slots{static_cast<size_t>((page.end - page.begin) / slot_size)} {
+        // Hand out the lowest offsets first
+        free_slots.reserve(num_slots);
+        for (size_t slot = num_slots; slot-- > 0;) {
+            free_slots.push_back(page.begin + slot * slot_size);
+        }
+    }
+
+    MemorySlab& operator=(const MemorySlab&) = delete;
+    MemorySlab(const MemorySlab&) = delete;
+
+    [[nodiscard]] MemoryCommit Commit(u64 size) {
+        const u64 offset = free_slots.back();
+        free_slots.pop_back();
+        return MemoryCommit(page.allocation, page.memory, offset, offset + size, this);
+    }
+
+    void Free(u64 offset) {
+        free_slots.push_back(offset);
+        if (free_slots.size() == num_slots) {
+            // Do not call any code involving 'this' after this call, the object may be destroyed
+            allocator->ReleaseSlab(this);
+        }
+    }
+
+    [[nodiscard]] bool HasFreeSlots() const noexcept {
+        return !free_slots.empty();
+    }
+
+    [[nodiscard]] bool IsCompatible(VkMemoryPropertyFlags flags, u32 type_mask) const {
+        return page.allocation->IsCompatible(flags, type_mask);
+    }
+
+    [[nodiscard]] bool IsSparse() const noexcept {
+        return page.allocation->IsSparse();
+    }
+
+private:
+    MemoryAllocator* const allocator; ///< Parent memory allocator.
+    MemoryCommit page;                ///< Commit backing all the slots of this slab.
+    const u64 slot_size;              ///< Size in bytes of each slot.
+    const size_t num_slots;           ///< Number of slots in the page.
+    std::vector<u64> free_slots;      ///< Offsets of the slots available for new commits.
+};
+
 MemoryCommit::MemoryCommit(MemoryAllocation* allocation_, VkDeviceMemory memory_, u64 begin_,
-                           u64 end_) noexcept
-    : allocation{allocation_}, memory{memory_}, begin{begin_}, end{end_} {}
+                           u64 end_, MemorySlab* slab_) noexcept
+    : allocation{allocation_}, slab{slab_}, memory{memory_}, begin{begin_}, end{end_} {}
 
 MemoryCommit::~MemoryCommit() {
     Release();
@@ -198,6 +271,7 @@ MemoryCommit::~MemoryCommit() {
 MemoryCommit& MemoryCommit::operator=(MemoryCommit&& rhs) noexcept {
     Release();
     allocation = std::exchange(rhs.allocation, nullptr);
+    slab = std::exchange(rhs.slab, nullptr);
     memory = rhs.memory;
     begin = rhs.begin;
     end = rhs.end;
@@ -206,8 +280,9 @@ MemoryCommit& MemoryCommit::operator=(MemoryCommit&& rhs) noexcept {
 }
 
 MemoryCommit::MemoryCommit(MemoryCommit&& rhs) noexcept
-    : allocation{std::exchange(rhs.allocation, nullptr)}, memory{rhs.memory}, begin{rhs.begin},
-      end{rhs.end}, span{std::exchange(rhs.span, std::span<u8>{})} {}
+    : allocation{std::exchange(rhs.allocation, nullptr)}, slab{std::exchange(rhs.slab, nullptr)},
+      memory{rhs.memory}, begin{rhs.begin}, end{rhs.end},
+      span{std::exchange(rhs.span, std::span<u8>{})} {}
 
 std::span<u8> MemoryCommit::Map() {
     if (span.empty()) {
@@ -220,8 +295,17 @@ u32 MemoryCommit::ExportOpenGLHandle() const {
     return allocation->ExportOpenGLHandle();
 }
 
+bool MemoryCommit::IsInSparseAllocation() const {
+    return allocation && allocation->IsSparse();
+}
+
 void MemoryCommit::Release() {
-    if (allocation) {
+    if (!allocation) {
+        return;
+    }
+    if (slab) {
+        slab->Free(begin);
+    } else {
         allocation->Free(begin);
     }
 }
@@ -237,30 +321,91 @@ MemoryCommit MemoryAllocator::Commit(const VkMemoryRequirements& requirements, M
     const u32 type_mask = requirements.memoryTypeBits;
     const VkMemoryPropertyFlags usage_flags = MemoryUsagePropertyFlags(usage);
     const VkMemoryPropertyFlags flags = MemoryPropertyFlags(type_mask, usage_flags);
+    return CommitWithFlags(requirements, flags);
+}
+
+MemoryCommit MemoryAllocator::Commit(const vk::Buffer& buffer, MemoryUsage usage) {
+    const VkMemoryRequirements requirements =
+        device.GetLogical().GetBufferMemoryRequirements(*buffer);
+    const VkMemoryPropertyFlags flags =
+        MemoryPropertyFlags(requirements.memoryTypeBits, MemoryUsagePropertyFlags(usage));
+    // Small buffers come and go often, take them from slabs to skip the region search
+    std::optional<MemoryCommit> commit = TrySlabCommit(requirements, flags);
+    if (!commit) {
+        commit = CommitWithFlags(requirements, flags);
+    }
+    buffer.BindMemory(commit->Memory(), commit->Offset());
+    return std::move(*commit);
+}
+
+MemoryCommit MemoryAllocator::Commit(const vk::Image& image, MemoryUsage usage) {
+    auto commit = Commit(device.GetLogical().GetImageMemoryRequirements(*image), usage);
+    image.BindMemory(commit.Memory(), commit.Offset());
+    return commit;
+}
+
+MemoryCommit MemoryAllocator::CommitWithFlags(const VkMemoryRequirements& requirements,
+                                              VkMemoryPropertyFlags flags) {
     if (std::optional<MemoryCommit> commit = TryCommit(requirements, flags)) {
         return std::move(*commit);
     }
     // Commit has failed, allocate more memory.
+    const u32 type_mask = requirements.memoryTypeBits;
     const u64 chunk_size = AllocationChunkSize(requirements.size);
+    if (IsOverBudget(FindType(flags, type_mask).value())) {
+        // Give back cached chunks before asking the driver for more
+        ReleaseEmptyAllocations();
+    }
     if (!TryAllocMemory(flags, type_mask, chunk_size)) {
-        // TODO(Rodrigo): Handle out of memory situations in some way like flushing to guest memory.
-        throw vk::Exception(VK_ERROR_OUT_OF_DEVICE_MEMORY);
+        ReleaseEmptyAllocations();
+        if (!TryAllocMemory(flags, type_mask, chunk_size)) {
+            // TODO(Rodrigo): Handle out of memory situations in some way like flushing to guest
+            // memory.
+            throw vk::Exception(VK_ERROR_OUT_OF_DEVICE_MEMORY);
+        }
     }
     // Commit again, this time it won't fail since there's a fresh allocation above.
     // If it does, there's a bug.
     return TryCommit(requirements, flags).value();
 }
 
-MemoryCommit MemoryAllocator::Commit(const vk::Buffer& buffer, MemoryUsage usage) {
-    auto commit = Commit(device.GetLogical().GetBufferMemoryRequirements(*buffer), usage);
-    buffer.BindMemory(commit.Memory(), commit.Offset());
-    return commit;
+std::optional<MemoryCommit> MemoryAllocator::TrySlabCommit(const VkMemoryRequirements& requirements,
+                                                           VkMemoryPropertyFlags flags) {
+    const u64 slot_size = std::bit_ceil(std::max<u64>(
+        {requirements.size, requirements.alignment, 1ULL << MIN_SLAB_SIZE_LOG2}));
+    if (slot_size > (1ULL << MAX_SLAB_SIZE_LOG2)) {
+        return std::nullopt;
+    }
+    const u32 type_mask = requirements.memoryTypeBits;
+    auto& bucket = slabs[std::countr_zero(slot_size) - MIN_SLAB_SIZE_LOG2];
+    for (const auto& slab : bucket) {
+        if (slab->HasFreeSlots() && slab->IsCompatible(flags, type_mask)) {
+            return slab->Commit(requirements.size);
+        }
+    }
+    const VkMemoryRequirements page_requirements{
+        .size = SLAB_PAGE_SIZE,
+        .alignment = 1ULL << MAX_SLAB_SIZE_LOG2,
+        .memoryTypeBits = type_mask,
+    };
+    MemoryCommit page = CommitWithFlags(page_requirements, flags);
+    return bucket.emplace_back(std::make_unique<MemorySlab>(this, std::move(page), slot_size))
+        ->Commit(requirements.size);
 }
 
-MemoryCommit MemoryAllocator::Commit(const vk::Image& image, MemoryUsage usage) {
-    auto commit = Commit(device.GetLogical().GetImageMemoryRequirements(*image), usage);
-    image.BindMemory(commit.Memory(), commit.Offset());
-    return commit;
+void MemoryAllocator::ReleaseSlab(MemorySlab* slab) {
+    for (auto& bucket : slabs) {
+        const auto it = std::ranges::find(bucket, slab, &std::unique_ptr<MemorySlab>::get);
+        if (it == bucket.end()) {
+            continue;
+        }
+        // Keep the last page of a size class unless it pins down a mostly empty allocation
+        if (bucket.size() > 1 || slab->IsSparse()) {
+            bucket.erase(it);
+        }
+        return;
+    }
+    UNREACHABLE_MSG("Invalid slab");
 }
 
 bool MemoryAllocator::TryAllocMemory(VkMemoryPropertyFlags flags, u32 type_mask, u64 size) {
@@ -286,19 +431,59 @@ bool MemoryAllocator::TryAllocMemory(VkMemoryPropertyFlags flags, u32 type_mask,
 }
 
 void MemoryAllocator::ReleaseMemory(MemoryAllocation* alloc) {
+    // Keep a few empty chunks while there is budget left, refilling them is cheaper than asking
+    // the driver for new memory on the next scene load
+    const auto num_empty = std::ranges::count_if(
+        allocations, [](const auto& allocation) { return allocation->IsEmpty(); });
+    if (static_cast<size_t>(num_empty) <= MAX_EMPTY_ALLOCATIONS &&
+        !IsOverBudget(alloc->MemoryType())) {
+        return;
+    }
     const auto it = std::ranges::find(allocations, alloc, &std::unique_ptr<MemoryAllocation>::get);
     ASSERT(it != allocations.end());
     allocations.erase(it);
 }
 
+void MemoryAllocator::ReleaseEmptyAllocations() {
+    std::erase_if(allocations, [](const auto& allocation) { return allocation->IsEmpty(); });
+}
+
+bool MemoryAllocator::IsOverBudget(u32 type) const {
+    if (!device.IsExtMemoryBudgetSupported()) {
+        return false;
+    }
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budget{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT,
+        .pNext = nullptr,
+        .heapBudget = {},
+        .heapUsage = {},
+    };
+    VkPhysicalDeviceMemoryProperties2KHR mem_properties2{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2_KHR,
+        .pNext = &budget,
+        .memoryProperties = {},
+    };
+    device.GetPhysical().GetMemoryProperties2KHR(mem_properties2);
+    // The budget includes other processes, leave some headroom before it is reached
+    const u32 heap = properties.memoryTypes[type].heapIndex;
+    const VkDeviceSize heap_budget = budget.heapBudget[heap];
+    return heap_budget != 0 && budget.heapUsage[heap] >= heap_budget - heap_budget / 10;
+}
+
 std::optional<MemoryCommit> MemoryAllocator::TryCommit(const VkMemoryRequirements& requirements,
                                                        VkMemoryPropertyFlags flags) {
-    for (auto& allocation : allocations) {
-        if (!allocation->IsCompatible(flags, requirements.memoryTypeBits)) {
-            continue;
-        }
-        if (auto commit = allocation->Commit(requirements.size, requirements.alignment)) {
-            return commit;
+    // Fill dense allocations first, so sparse ones drain and can be released
+    for (const bool allow_sparse : {false, true}) {
+        for (auto& allocation : allocations) {
+            if (!allocation->IsCompatible(flags, requirements.memoryTypeBits)) {
+                continue;
+            }
+            if (!allow_sparse && allocation->IsSparse()) {
+                continue;
+            }
+            if (auto commit = allocation->Commit(requirements.size, requirements.alignment)) {
+                return commit;
+            }
         }
     }
     if ((flags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) != 0) {
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <span>
 #include <utility>
@@ -16,6 +17,7 @@ namespace Vulkan {
 class Device;
 class MemoryMap;
 class MemoryAllocation;
+class MemorySlab;
 
 /// Hints and requirements for the backing memory type of a commit
 enum class MemoryUsage {
@@ -27,10 +29,12 @@ enum class MemoryUsage {
 /// Ownership handle of a memory commitment.
 /// Points to a subregion of a memory allocation.
 class MemoryCommit {
+    friend MemorySlab;
+
 public:
     explicit MemoryCommit() noexcept = default;
     explicit MemoryCommit(MemoryAllocation* allocation_, VkDeviceMemory memory_, u64 begin_,
-                          u64 end_) noexcept;
+                          u64 end_, MemorySlab* slab_ = nullptr) noexcept;
     ~MemoryCommit();
 
     MemoryCommit& operator=(MemoryCommit&&) noexcept;
@@ -56,10 +60,14 @@ public:
         return static_cast<VkDeviceSize>(begin);
     }
 
+    /// Returns true when the backing allocation is mostly unused and holding it back from release.
+    [[nodiscard]] bool IsInSparseAllocation() const;
+
 private:
     void Release();
 
     MemoryAllocation* allocation{}; ///< Pointer to the large memory allocation.
+    MemorySlab* slab{};             ///< Slab page the commit was taken from, if any.
     VkDeviceMemory memory{};        ///< Vulkan device memory handler.
     u64 begin{};                    ///< Beginning offset in bytes to where the commit exists.
     u64 end{};                      ///< Offset in bytes where the commit ends.
@@ -70,6 +78,7 @@ private:
 /// Allocates and releases memory allocations on demand.
 class MemoryAllocator {
     friend MemoryAllocation;
+    friend MemorySlab;
 
 public:
     /**
@@ -103,12 +112,35 @@ public:
     MemoryCommit Commit(const vk::Image& image, MemoryUsage usage);
 
 private:
+    /// Smallest size class of the slab allocator, in log2 bytes.
+    static constexpr u32 MIN_SLAB_SIZE_LOG2 = 8;
+    /// Largest size class of the slab allocator, in log2 bytes.
+    static constexpr u32 MAX_SLAB_SIZE_LOG2 = 16;
+    static constexpr size_t NUM_SLAB_CLASSES = MAX_SLAB_SIZE_LOG2 - MIN_SLAB_SIZE_LOG2 + 1;
+
+    /// Commits memory with already resolved property flags, allocating more memory on demand.
+    MemoryCommit CommitWithFlags(const VkMemoryRequirements& requirements,
+                                 VkMemoryPropertyFlags flags);
+
+    /// Tries to commit a small request from a slab page of its size class.
+    std::optional<MemoryCommit> TrySlabCommit(const VkMemoryRequirements& requirements,
+                                              VkMemoryPropertyFlags flags);
+
+    /// Releases an empty slab page, the last page of a size class is kept for reuse.
+    void ReleaseSlab(MemorySlab* slab);
+
     /// Tries to allocate a chunk of memory.
     bool TryAllocMemory(VkMemoryPropertyFlags flags, u32 type_mask, u64 size);
 
-    /// Releases a chunk of memory.
+    /// Releases a chunk of memory, or keeps it for reuse while its heap is within budget.
     void ReleaseMemory(MemoryAllocation* alloc);
 
+    /// Releases all allocations without commits.
+    void ReleaseEmptyAllocations();
+
+    /// Returns true when the heap of a memory type is close to the budget given by the driver.
+    bool IsOverBudget(u32 type) const;
+
     /// Tries to allocate a memory commit.
     std::optional<MemoryCommit> TryCommit(const VkMemoryRequirements& requirements,
                                           VkMemoryPropertyFlags flags);
@@ -123,6 +155,7 @@ private:
     const VkPhysicalDeviceMemoryProperties properties; ///< Physical device properties.
     const bool export_allocations; ///< True when memory allocations have to be exported.
     std::vector<std::unique_ptr<MemoryAllocation>> allocations; ///< Current allocations.
+    std::array<std::vector<std::unique_ptr<MemorySlab>>, NUM_SLAB_CLASSES> slabs; ///< Slab pages.
 };
 
 /// Returns true when a memory usage is guaranteed to be host visible.
@@ -80,6 +80,9 @@ void Load(VkDevice device, DeviceDispatch& dld) noexcept {
     X(vkBindImageMemory);
     X(vkCmdBeginQuery);
     X(vkCmdBeginRenderPass);
+#ifdef VK_KHR_dynamic_rendering
+    X(vkCmdBeginRenderingKHR);
+#endif
     X(vkCmdBeginTransformFeedbackEXT);
     X(vkCmdBeginDebugUtilsLabelEXT);
     X(vkCmdBindDescriptorSets);
@@ -98,6 +101,9 @@ void Load(VkDevice device, DeviceDispatch& dld) noexcept {
     X(vkCmdDrawIndexed);
     X(vkCmdEndQuery);
     X(vkCmdEndRenderPass);
+#ifdef VK_KHR_dynamic_rendering
+    X(vkCmdEndRenderingKHR);
+#endif
     X(vkCmdEndTransformFeedbackEXT);
     X(vkCmdEndDebugUtilsLabelEXT);
     X(vkCmdFillBuffer);
@@ -113,6 +119,7 @@ void Load(VkDevice device, DeviceDispatch& dld) noexcept {
     X(vkCmdSetStencilWriteMask);
     X(vkCmdSetViewport);
     X(vkCmdWaitEvents);
+    X(vkCmdWriteTimestamp);
     X(vkCmdBindVertexBuffers2EXT);
     X(vkCmdSetCullModeEXT);
     X(vkCmdSetDepthBoundsTestEnableEXT);
@@ -137,6 +144,7 @@ void Load(VkDevice device, DeviceDispatch& dld) noexcept {
     X(vkCreateGraphicsPipelines);
     X(vkCreateImage);
     X(vkCreateImageView);
+    X(vkCreatePipelineCache);
     X(vkCreatePipelineLayout);
     X(vkCreateQueryPool);
     X(vkCreateRenderPass);
@@ -156,6 +164,7 @@ void Load(VkDevice device, DeviceDispatch& dld) noexcept {
     X(vkDestroyImage);
     X(vkDestroyImageView);
     X(vkDestroyPipeline);
+    X(vkDestroyPipelineCache);
     X(vkDestroyPipelineLayout);
     X(vkDestroyQueryPool);
     X(vkDestroyRenderPass);
@@ -177,10 +186,12 @@ void Load(VkDevice device, DeviceDispatch& dld) noexcept {
 #ifdef _WIN32
     X(vkGetMemoryWin32HandleKHR);
 #endif
+    X(vkGetPipelineCacheData);
     X(vkGetQueryPoolResults);
     X(vkGetSemaphoreCounterValueKHR);
     X(vkMapMemory);
     X(vkQueueSubmit);
+    X(vkResetCommandPool);
     X(vkResetFences);
     X(vkResetQueryPoolEXT);
     X(vkSetDebugUtilsObjectNameEXT);
@@ -223,6 +234,7 @@ bool Load(VkInstance instance, InstanceDispatch& dld) noexcept {
     X(vkDestroyDebugUtilsMessengerEXT);
     X(vkDestroySurfaceKHR);
     X(vkGetPhysicalDeviceFeatures2KHR);
+    X(vkGetPhysicalDeviceMemoryProperties2KHR);
     X(vkGetPhysicalDeviceProperties2KHR);
     X(vkGetPhysicalDeviceSurfaceCapabilitiesKHR);
     X(vkGetPhysicalDeviceSurfaceFormatsKHR);
@@ -390,6 +402,10 @@ void Destroy(VkDevice device, VkPipeline handle, const DeviceDispatch& dld) noex
     dld.vkDestroyPipeline(device, handle, nullptr);
 }
 
+void Destroy(VkDevice device, VkPipelineCache handle, const DeviceDispatch& dld) noexcept {
+    dld.vkDestroyPipelineCache(device, handle, nullptr);
+}
+
 void Destroy(VkDevice device, VkPipelineLayout handle, const DeviceDispatch& dld) noexcept {
     dld.vkDestroyPipelineLayout(device, handle, nullptr);
 }
@@ -596,6 +612,15 @@ std::vector<VkImage> SwapchainKHR::GetImages() const {
     return images;
 }
 
+std::vector<u8> PipelineCache::GetData() const {
+    size_t size;
+    Check(dld->vkGetPipelineCacheData(owner, handle, &size, nullptr));
+    std::vector<u8> data(size);
+    Check(dld->vkGetPipelineCacheData(owner, handle, &size, data.data()));
+    data.resize(size);
+    return data;
+}
+
 void Event::SetObjectNameEXT(const char* name) const {
     SetObjectName(dld, owner, handle, VK_OBJECT_TYPE_EVENT, name);
 }
@@ -705,15 +730,23 @@ PipelineLayout Device::CreatePipelineLayout(const VkPipelineLayoutCreateInfo& ci
     return PipelineLayout(object, handle, *dld);
 }
 
-Pipeline Device::CreateGraphicsPipeline(const VkGraphicsPipelineCreateInfo& ci) const {
+PipelineCache Device::CreatePipelineCache(const VkPipelineCacheCreateInfo& ci) const {
+    VkPipelineCache object;
+    Check(dld->vkCreatePipelineCache(handle, &ci, nullptr, &object));
+    return PipelineCache(object, handle, *dld);
+}
+
+Pipeline Device::CreateGraphicsPipeline(const VkGraphicsPipelineCreateInfo& ci,
+                                        VkPipelineCache cache) const {
     VkPipeline object;
-    Check(dld->vkCreateGraphicsPipelines(handle, nullptr, 1, &ci, nullptr, &object));
+    Check(dld->vkCreateGraphicsPipelines(handle, cache, 1, &ci, nullptr, &object));
     return Pipeline(object, handle, *dld);
 }
 
-Pipeline Device::CreateComputePipeline(const VkComputePipelineCreateInfo& ci) const {
+Pipeline Device::CreateComputePipeline(const VkComputePipelineCreateInfo& ci,
+                                       VkPipelineCache cache) const {
     VkPipeline object;
-    Check(dld->vkCreateComputePipelines(handle, nullptr, 1, &ci, nullptr, &object));
+    Check(dld->vkCreateComputePipelines(handle, cache, 1, &ci, nullptr, &object));
     return Pipeline(object, handle, *dld);
 }
 
@@ -895,6 +928,11 @@ VkPhysicalDeviceMemoryProperties PhysicalDevice::GetMemoryProperties() const noe
     return properties;
 }
 
+void PhysicalDevice::GetMemoryProperties2KHR(
+    VkPhysicalDeviceMemoryProperties2KHR& properties) const noexcept {
+    dld->vkGetPhysicalDeviceMemoryProperties2KHR(physical_device, &properties);
+}
+
 u32 AvailableVersion(const InstanceDispatch& dld) noexcept {
     PFN_vkEnumerateInstanceVersion vkEnumerateInstanceVersion;
     if (!Proc(vkEnumerateInstanceVersion, dld, "vkEnumerateInstanceVersion")) {
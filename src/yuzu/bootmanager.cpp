@@ -26,6 +26,7 @@
 #include <fmt/format.h>
 
 #include "common/assert.h"
+#include "common/detached_tasks.h"
 #include "common/microprofile.h"
 #include "common/scm_rev.h"
 #include "common/scope_exit.h"
@@ -33,6 +34,7 @@
 #include "core/core.h"
 #include "core/frontend/framebuffer_layout.h"
 #include "core/hle/kernel/k_process.h"
+#include "core/startup_timeline.h"
 #include "input_common/keyboard.h"
 #include "input_common/main.h"
 #include "input_common/mouse/mouse_input.h"
@@ -64,11 +66,13 @@ void EmuThread::run() {
 
     emit LoadProgress(VideoCore::LoadCallbackStage::Prepare, 0, 0);
 
+    system.GetStartupTimeline().BeginPhase("shader_cache");
     system.Renderer().ReadRasterizer()->LoadDiskResources(
         system.CurrentProcess()->GetTitleID(), stop_token,
         [this](VideoCore::LoadCallbackStage stage, std::size_t value, std::size_t total) {
             emit LoadProgress(stage, value, total);
         });
+    system.GetStartupTimeline().EndPhase();
 
     emit LoadProgress(VideoCore::LoadCallbackStage::Complete, 0, 0);
 
@@ -297,7 +301,9 @@ GRenderWindow::GRenderWindow(GMainWindow* parent, EmuThread* emu_thread_,
 
     this->setMouseTracking(true);
 
-    connect(this, &GRenderWindow::FirstFrameDisplayed, parent, &GMainWindow::OnLoadComplete);
+    // The first frame is reported by the renderer, which presents on its own thread
+    connect(this, &GRenderWindow::FirstFrameDisplayed, parent, &GMainWindow::OnLoadComplete,
+            Qt::QueuedConnection);
     connect(this, &GRenderWindow::ExecuteProgramSignal, parent, &GMainWindow::OnExecuteProgram,
             Qt::QueuedConnection);
 }
@@ -311,16 +317,17 @@ GRenderWindow::~GRenderWindow() {
 }
 
 void GRenderWindow::OnFrameDisplayed() {
-    if (!first_frame) {
-        first_frame = true;
+    if (!first_frame.exchange(true)) {
         emit FirstFrameDisplayed();
     }
 }
 
 bool GRenderWindow::IsShown() const {
-    return !isMinimized();
+    return is_shown;
 }
 
+// Called from the GUI thread, the renderer picks up the new layout on its next present.
+//
 // On Qt 5.0+, this correctly gets the size of the framebuffer (pixels).
 //
 // Older versions get the window size (density independent pixels),
@@ -577,6 +584,9 @@ bool GRenderWindow::InitRenderTarget() {
             return false;
         }
         break;
+    case Settings::RendererBackend::Null:
+        InitializeNull();
+        break;
     }
 
     // Update the Window System information with the new render target
@@ -623,12 +633,17 @@ void GRenderWindow::CaptureScreenshot(u32 res_scale, const QString& screenshot_p
     renderer.RequestScreenshot(
         screenshot_image.bits(),
         [=, this] {
-            const std::string std_screenshot_path = screenshot_path.toStdString();
-            if (screenshot_image.mirrored(false, true).save(screenshot_path)) {
-                LOG_INFO(Frontend, "Screenshot saved to \"{}\"", std_screenshot_path);
-            } else {
-                LOG_ERROR(Frontend, "Failed to save screenshot to \"{}\"", std_screenshot_path);
-            }
+            // Encoding is slow, so it's done off the render thread. The image is shared with the
+            // task, as the next capture may replace it before the task is done.
+            Common::DetachedTasks::AddTask([image = screenshot_image, screenshot_path] {
+                const std::string std_screenshot_path = screenshot_path.toStdString();
+                if (image.mirrored(false, true).save(screenshot_path)) {
+                    LOG_INFO(Frontend, "Screenshot saved to \"{}\"", std_screenshot_path);
+                } else {
+                    LOG_ERROR(Frontend, "Failed to save screenshot to \"{}\"",
+                              std_screenshot_path);
+                }
+            });
         },
         layout);
 }
@@ -670,6 +685,12 @@ bool GRenderWindow::InitializeVulkan() {
     return true;
 }
 
+void GRenderWindow::InitializeNull() {
+    child_widget = new RenderWidget(this);
+    child_widget->windowHandle()->create();
+    main_context = std::make_unique<DummyContext>();
+}
+
 bool GRenderWindow::LoadOpenGL() {
     auto context = CreateSharedContext();
     auto scope = context->Acquire();
@@ -744,6 +765,13 @@ void GRenderWindow::showEvent(QShowEvent* event) {
             Qt::UniqueConnection);
 }
 
+void GRenderWindow::changeEvent(QEvent* event) {
+    QWidget::changeEvent(event);
+    if (event->type() == QEvent::WindowStateChange) {
+        is_shown = !isMinimized();
+    }
+}
+
 bool GRenderWindow::eventFilter(QObject* object, QEvent* event) {
     if (event->type() == QEvent::HoverMove) {
         if (Settings::values.mouse_panning) {
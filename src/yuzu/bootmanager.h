@@ -206,6 +206,7 @@ private:
 
     bool InitializeOpenGL();
     bool InitializeVulkan();
+    void InitializeNull();
     bool LoadOpenGL();
     QStringList GetUnsupportedGLExtensions() const;
 
@@ -224,11 +225,15 @@ private:
 
     QWidget* child_widget = nullptr;
 
-    bool first_frame = false;
+    /// Written by the renderer when it presents, read by the GUI thread
+    std::atomic_bool first_frame{false};
+    /// Mirrors !isMinimized() so the renderer never queries the widget from its own thread
+    std::atomic_bool is_shown{true};
 
     std::array<std::size_t, 16> touch_ids{};
 
 protected:
     void showEvent(QShowEvent* event) override;
+    void changeEvent(QEvent* event) override;
     bool eventFilter(QObject* object, QEvent* event) override;
 };
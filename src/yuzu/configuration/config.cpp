@@ -541,6 +541,7 @@ void Config::ReadAudioValues() {
     if (global) {
         ReadBasicSetting(Settings::values.audio_device_id);
         ReadBasicSetting(Settings::values.sink_id);
+        ReadBasicSetting(Settings::values.audio_low_latency);
     }
     ReadGlobalSetting(Settings::values.enable_audio_stretching);
     ReadGlobalSetting(Settings::values.volume);
@@ -625,6 +626,18 @@ void Config::ReadCoreValues() {
     qt_config->beginGroup(QStringLiteral("Core"));
 
     ReadGlobalSetting(Settings::values.use_multi_core);
+    ReadBasicSetting(Settings::values.service_thread_affinity);
+    ReadBasicSetting(Settings::values.service_thread_priority);
+    ReadBasicSetting(Settings::values.fs_service_thread_affinity);
+    ReadBasicSetting(Settings::values.fs_service_thread_priority);
+    ReadBasicSetting(Settings::values.nvdrv_service_thread_affinity);
+    ReadBasicSetting(Settings::values.nvdrv_service_thread_priority);
+    ReadBasicSetting(Settings::values.audio_service_thread_affinity);
+    ReadBasicSetting(Settings::values.audio_service_thread_priority);
+    ReadBasicSetting(Settings::values.precise_core_timing);
+    ReadBasicSetting(Settings::values.use_huge_pages);
+    ReadBasicSetting(Settings::values.use_thread_placement);
+    ReadBasicSetting(Settings::values.perf_tuning);
 
     qt_config->endGroup();
 }
@@ -664,6 +677,8 @@ void Config::ReadDataStorageValues() {
     ReadBasicSetting(Settings::values.gamecard_inserted);
     ReadBasicSetting(Settings::values.gamecard_current_game);
     ReadBasicSetting(Settings::values.gamecard_path);
+    ReadBasicSetting(Settings::values.romfs_cache_size);
+    ReadBasicSetting(Settings::values.use_shared_content_cache);
 
     qt_config->endGroup();
 }
@@ -681,6 +696,9 @@ void Config::ReadDebuggingValues() {
     ReadBasicSetting(Settings::values.reporting_services);
     ReadBasicSetting(Settings::values.quest_flag);
     ReadBasicSetting(Settings::values.disable_macro_jit);
+    ReadBasicSetting(Settings::values.dump_macro_profile);
+    ReadBasicSetting(Settings::values.dump_audio_renderer);
+    ReadBasicSetting(Settings::values.gpu_capture_frames);
     ReadBasicSetting(Settings::values.extended_logging);
     ReadBasicSetting(Settings::values.use_debug_asserts);
     ReadBasicSetting(Settings::values.use_auto_stub);
@@ -775,6 +793,7 @@ void Config::ReadCpuValues() {
     } else {
         ReadGlobalSetting(Settings::values.cpu_accuracy);
     }
+    ReadGlobalSetting(Settings::values.cpu_code_cache_size);
 
     ReadGlobalSetting(Settings::values.cpuopt_unsafe_unfuse_fma);
     ReadGlobalSetting(Settings::values.cpuopt_unsafe_reduce_fp_error);
@@ -793,6 +812,7 @@ void Config::ReadCpuValues() {
         ReadBasicSetting(Settings::values.cpuopt_misc_ir);
         ReadBasicSetting(Settings::values.cpuopt_reduce_misalign_checks);
         ReadBasicSetting(Settings::values.cpuopt_fastmem);
+        ReadBasicSetting(Settings::values.cpuopt_hle_memory_functions);
     }
 
     qt_config->endGroup();
@@ -814,8 +834,17 @@ void Config::ReadRendererValues() {
     ReadGlobalSetting(Settings::values.use_nvdec_emulation);
     ReadGlobalSetting(Settings::values.accelerate_astc);
     ReadGlobalSetting(Settings::values.use_vsync);
+    ReadGlobalSetting(Settings::values.present_mode);
+    ReadGlobalSetting(Settings::values.render_scale);
     ReadGlobalSetting(Settings::values.use_assembly_shaders);
     ReadGlobalSetting(Settings::values.use_asynchronous_shaders);
+    ReadGlobalSetting(Settings::values.async_shader_wait_time);
+    ReadGlobalSetting(Settings::values.use_shader_specialization);
+    ReadGlobalSetting(Settings::values.use_bindless_textures);
+    ReadGlobalSetting(Settings::values.use_draw_batching);
+    ReadGlobalSetting(Settings::values.use_transfer_queue);
+    ReadGlobalSetting(Settings::values.use_async_compute);
+    ReadGlobalSetting(Settings::values.use_memory_defragmentation);
     ReadGlobalSetting(Settings::values.use_fast_gpu_time);
     ReadGlobalSetting(Settings::values.use_caches_gc);
     ReadGlobalSetting(Settings::values.bg_red);
@@ -824,6 +853,14 @@ void Config::ReadRendererValues() {
 
     if (global) {
         ReadBasicSetting(Settings::values.renderer_debug);
+        ReadBasicSetting(Settings::values.use_astc_disk_cache);
+        ReadBasicSetting(Settings::values.use_texture_deduplication);
+        ReadBasicSetting(Settings::values.use_texture_streaming);
+        ReadBasicSetting(Settings::values.transcode_astc);
+        ReadBasicSetting(Settings::values.vram_budget);
+        ReadBasicSetting(Settings::values.use_asynchronous_downloads);
+        ReadBasicSetting(Settings::values.use_spirv_optimizer);
+        ReadBasicSetting(Settings::values.use_nvdec_hwaccel);
     }
 
     qt_config->endGroup();
@@ -1157,6 +1194,7 @@ void Config::SaveAudioValues() {
     if (global) {
         WriteBasicSetting(Settings::values.sink_id);
         WriteBasicSetting(Settings::values.audio_device_id);
+        WriteBasicSetting(Settings::values.audio_low_latency);
     }
     WriteGlobalSetting(Settings::values.enable_audio_stretching);
     WriteGlobalSetting(Settings::values.volume);
@@ -1190,6 +1228,18 @@ void Config::SaveCoreValues() {
     qt_config->beginGroup(QStringLiteral("Core"));
 
     WriteGlobalSetting(Settings::values.use_multi_core);
+    WriteBasicSetting(Settings::values.service_thread_affinity);
+    WriteBasicSetting(Settings::values.service_thread_priority);
+    WriteBasicSetting(Settings::values.fs_service_thread_affinity);
+    WriteBasicSetting(Settings::values.fs_service_thread_priority);
+    WriteBasicSetting(Settings::values.nvdrv_service_thread_affinity);
+    WriteBasicSetting(Settings::values.nvdrv_service_thread_priority);
+    WriteBasicSetting(Settings::values.audio_service_thread_affinity);
+    WriteBasicSetting(Settings::values.audio_service_thread_priority);
+    WriteBasicSetting(Settings::values.precise_core_timing);
+    WriteBasicSetting(Settings::values.use_huge_pages);
+    WriteBasicSetting(Settings::values.use_thread_placement);
+    WriteBasicSetting(Settings::values.perf_tuning);
 
     qt_config->endGroup();
 }
@@ -1213,6 +1263,8 @@ void Config::SaveDataStorageValues() {
     WriteBasicSetting(Settings::values.gamecard_inserted);
     WriteBasicSetting(Settings::values.gamecard_current_game);
     WriteBasicSetting(Settings::values.gamecard_path);
+    WriteBasicSetting(Settings::values.romfs_cache_size);
+    WriteBasicSetting(Settings::values.use_shared_content_cache);
 
     qt_config->endGroup();
 }
@@ -1229,6 +1281,9 @@ void Config::SaveDebuggingValues() {
     WriteBasicSetting(Settings::values.quest_flag);
     WriteBasicSetting(Settings::values.use_debug_asserts);
     WriteBasicSetting(Settings::values.disable_macro_jit);
+    WriteBasicSetting(Settings::values.dump_macro_profile);
+    WriteBasicSetting(Settings::values.dump_audio_renderer);
+    WriteBasicSetting(Settings::values.gpu_capture_frames);
 
     qt_config->endGroup();
 }
@@ -1298,6 +1353,7 @@ void Config::SaveCpuValues() {
                  static_cast<u32>(Settings::values.cpu_accuracy.GetValue(global)),
                  static_cast<u32>(Settings::values.cpu_accuracy.GetDefault()),
                  Settings::values.cpu_accuracy.UsingGlobal());
+    WriteGlobalSetting(Settings::values.cpu_code_cache_size);
 
     WriteGlobalSetting(Settings::values.cpuopt_unsafe_unfuse_fma);
     WriteGlobalSetting(Settings::values.cpuopt_unsafe_reduce_fp_error);
@@ -1316,6 +1372,7 @@ void Config::SaveCpuValues() {
         WriteBasicSetting(Settings::values.cpuopt_misc_ir);
         WriteBasicSetting(Settings::values.cpuopt_reduce_misalign_checks);
         WriteBasicSetting(Settings::values.cpuopt_fastmem);
+        WriteBasicSetting(Settings::values.cpuopt_hle_memory_functions);
     }
 
     qt_config->endGroup();
@@ -1343,8 +1400,23 @@ void Config::SaveRendererValues() {
     WriteGlobalSetting(Settings::values.use_nvdec_emulation);
     WriteGlobalSetting(Settings::values.accelerate_astc);
     WriteGlobalSetting(Settings::values.use_vsync);
+    WriteSetting(QString::fromStdString(Settings::values.present_mode.GetLabel()),
+                 static_cast<u32>(Settings::values.present_mode.GetValue(global)),
+                 static_cast<u32>(Settings::values.present_mode.GetDefault()),
+                 Settings::values.present_mode.UsingGlobal());
+    WriteSetting(QString::fromStdString(Settings::values.render_scale.GetLabel()),
+                 static_cast<u32>(Settings::values.render_scale.GetValue(global)),
+                 static_cast<u32>(Settings::values.render_scale.GetDefault()),
+                 Settings::values.render_scale.UsingGlobal());
     WriteGlobalSetting(Settings::values.use_assembly_shaders);
     WriteGlobalSetting(Settings::values.use_asynchronous_shaders);
+    WriteGlobalSetting(Settings::values.async_shader_wait_time);
+    WriteGlobalSetting(Settings::values.use_shader_specialization);
+    WriteGlobalSetting(Settings::values.use_bindless_textures);
+    WriteGlobalSetting(Settings::values.use_draw_batching);
+    WriteGlobalSetting(Settings::values.use_transfer_queue);
+    WriteGlobalSetting(Settings::values.use_async_compute);
+    WriteGlobalSetting(Settings::values.use_memory_defragmentation);
     WriteGlobalSetting(Settings::values.use_fast_gpu_time);
     WriteGlobalSetting(Settings::values.use_caches_gc);
     WriteGlobalSetting(Settings::values.bg_red);
@@ -1353,6 +1425,14 @@ void Config::SaveRendererValues() {
 
     if (global) {
         WriteBasicSetting(Settings::values.renderer_debug);
+        WriteBasicSetting(Settings::values.use_astc_disk_cache);
+        WriteBasicSetting(Settings::values.use_texture_deduplication);
+        WriteBasicSetting(Settings::values.use_texture_streaming);
+        WriteBasicSetting(Settings::values.transcode_astc);
+        WriteBasicSetting(Settings::values.vram_budget);
+        WriteBasicSetting(Settings::values.use_asynchronous_downloads);
+        WriteBasicSetting(Settings::values.use_spirv_optimizer);
+        WriteBasicSetting(Settings::values.use_nvdec_hwaccel);
     }
 
     qt_config->endGroup();
@@ -2,16 +2,21 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <filesystem>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <QDataStream>
+#include <QDateTime>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
 #include <QSettings>
 
+#include "common/cityhash.h"
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
 #include "core/core.h"
@@ -132,6 +137,88 @@ std::pair<std::vector<u8>, std::string> GetGameListCachedObject(
     return std::make_pair(vec, data.toStdString());
 }
 
+/// Metadata of a game file, cached so that unchanged files are not parsed again on every scan.
+struct GameFileMetadata {
+    u64 program_id{};
+    Loader::FileType file_type{};
+    std::string name;
+    std::vector<u8> icon;
+    /// Version of the installed update when the metadata was read, as it affects name and icon.
+    u32 update_version{};
+};
+
+constexpr quint32 GAME_FILE_METADATA_VERSION = 1;
+
+std::filesystem::path GetGameFileMetadataPath(const std::string& physical_name) {
+    const u64 hash = Common::CityHash64(physical_name.data(), physical_name.size());
+    return Common::FS::GetYuzuPath(Common::FS::YuzuPath::CacheDir) / "game_list" / "files" /
+           fmt::format("{:016X}.bin", hash);
+}
+
+/// Returns the cached metadata of the file, if the file has not changed since it was cached.
+std::optional<GameFileMetadata> ReadGameFileMetadata(const std::string& physical_name) {
+    const auto path = Common::FS::PathToUTF8String(GetGameFileMetadataPath(physical_name));
+    QFile file{QString::fromStdString(path)};
+    if (!file.open(QFile::ReadOnly)) {
+        return std::nullopt;
+    }
+
+    QDataStream stream{&file};
+    quint32 version{};
+    stream >> version;
+    if (version != GAME_FILE_METADATA_VERSION) {
+        return std::nullopt;
+    }
+
+    QString cached_path;
+    qint64 size{};
+    qint64 modified{};
+    quint32 update_version{};
+    quint64 program_id{};
+    quint32 file_type{};
+    QByteArray name;
+    QByteArray icon;
+    stream >> cached_path >> size >> modified >> update_version >> program_id >> file_type >>
+        name >> icon;
+    if (stream.status() != QDataStream::Ok) {
+        return std::nullopt;
+    }
+
+    const QFileInfo info{QString::fromStdString(physical_name)};
+    if (cached_path != info.filePath() || size != info.size() ||
+        modified != info.lastModified().toMSecsSinceEpoch()) {
+        return std::nullopt;
+    }
+
+    return GameFileMetadata{
+        .program_id = program_id,
+        .file_type = static_cast<Loader::FileType>(file_type),
+        .name = name.toStdString(),
+        .icon = std::vector<u8>(icon.begin(), icon.end()),
+        .update_version = update_version,
+    };
+}
+
+void WriteGameFileMetadata(const std::string& physical_name, const GameFileMetadata& metadata) {
+    const auto path = GetGameFileMetadataPath(physical_name);
+    void(Common::FS::CreateParentDirs(path));
+
+    QFile file{QString::fromStdString(Common::FS::PathToUTF8String(path))};
+    if (!file.open(QFile::WriteOnly)) {
+        LOG_ERROR(Frontend, "Failed to open cache file.");
+        return;
+    }
+
+    const QFileInfo info{QString::fromStdString(physical_name)};
+    QDataStream stream{&file};
+    stream << GAME_FILE_METADATA_VERSION << info.filePath() << info.size()
+           << info.lastModified().toMSecsSinceEpoch() << quint32{metadata.update_version}
+           << quint64{metadata.program_id} << static_cast<quint32>(metadata.file_type)
+           << QByteArray::fromStdString(metadata.name)
+           << QByteArray(reinterpret_cast<const char*>(metadata.icon.data()),
+                         static_cast<int>(metadata.icon.size()));
+}
+
 void GetMetadataFromControlNCA(const FileSys::PatchManager& patch_manager, const FileSys::NCA& nca,
                                std::vector<u8>& icon, std::string& name) {
     std::tie(icon, name) = GetGameListCachedObject(
@@ -193,9 +280,10 @@ QString FormatPatchNameVersions(const FileSys::PatchManager& patch_manager,
 }
 
 QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::string& name,
-                                        const std::vector<u8>& icon, Loader::AppLoader& loader,
+                                        const std::vector<u8>& icon, Loader::FileType file_type,
                                         u64 program_id, const CompatibilityList& compatibility_list,
-                                        const FileSys::PatchManager& patch) {
+                                        const FileSys::PatchManager& patch,
+                                        const std::function<QString()>& patch_versions_generator) {
     const auto it = FindMatchingCompatibilityEntry(compatibility_list, program_id);
 
     // The game list uses this as compatibility number for untested games
@@ -204,7 +292,6 @@ QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::stri
         compatibility = it->second.first;
     }
 
-    const auto file_type = loader.GetFileType();
     const auto file_type_string = QString::fromStdString(Loader::GetFileTypeString(file_type));
 
     QList<QStandardItem*> list{
@@ -216,9 +303,7 @@ QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::stri
     };
 
     const auto patch_versions = GetGameListCachedObject(
-        fmt::format("{:016X}", patch.GetTitleID()), "pv.txt", [&patch, &loader] {
-            return FormatPatchNameVersions(patch, loader, loader.IsRomFSUpdatable());
-        });
+        fmt::format("{:016X}", patch.GetTitleID()), "pv.txt", patch_versions_generator);
     list.insert(2, new GameListItem(patch_versions));
 
     return list;
@@ -277,12 +362,51 @@ void GameListWorker::AddTitlesToGameList(GameListDir* parent_dir) {
             GetMetadataFromControlNCA(patch, *control, icon, name);
         }
 
-        emit EntryReady(MakeGameListEntry(file->GetFullPath(), name, icon, *loader, program_id,
-                                          compatibility_list, patch),
+        emit EntryReady(MakeGameListEntry(file->GetFullPath(), name, icon, loader->GetFileType(),
+                                          program_id, compatibility_list, patch,
+                                          [&patch, &loader] {
+                                              return FormatPatchNameVersions(
+                                                  patch, *loader, loader->IsRomFSUpdatable());
+                                          }),
                         parent_dir);
     }
 }
 
+bool GameListWorker::AddCachedGameListEntry(const std::string& physical_name,
+                                            GameListDir* parent_dir) {
+    if (!UISettings::values.cache_game_list) {
+        return false;
+    }
+
+    const auto metadata = ReadGameFileMetadata(physical_name);
+    if (!metadata) {
+        return false;
+    }
+
+    auto& system = Core::System::GetInstance();
+    const FileSys::PatchManager patch{metadata->program_id, system.GetFileSystemController(),
+                                      system.GetContentProvider()};
+    if (metadata->update_version != patch.GetGameVersion().value_or(0)) {
+        return false;
+    }
+
+    // The patch versions are cached separately, the file is only parsed when they are not.
+    const auto patch_versions_generator = [this, &system, &physical_name, &patch] {
+        const auto file = vfs->OpenFile(physical_name, FileSys::Mode::Read);
+        const auto loader = file ? Loader::GetLoader(system, file) : nullptr;
+        if (!loader) {
+            return QString{};
+        }
+        return FormatPatchNameVersions(patch, *loader, loader->IsRomFSUpdatable());
+    };
+
+    emit EntryReady(MakeGameListEntry(physical_name, metadata->name, metadata->icon,
+                                      metadata->file_type, metadata->program_id,
+                                      compatibility_list, patch, patch_versions_generator),
+                    parent_dir);
+    return true;
+}
+
 void GameListWorker::ScanFileSystem(ScanTarget target, const std::string& dir_path, bool deep_scan,
                                     GameListDir* parent_dir) {
     auto& system = Core::System::GetInstance();
@@ -299,6 +423,11 @@ void GameListWorker::ScanFileSystem(ScanTarget target, const std::string& dir_pa
 
         if (!is_dir &&
             (HasSupportedFileExtension(physical_name) || IsExtractedNCAMain(physical_name))) {
+            if (target == ScanTarget::PopulateGameList &&
+                AddCachedGameListEntry(physical_name, parent_dir)) {
+                return true;
+            }
+
             const auto file = vfs->OpenFile(physical_name, FileSys::Mode::Read);
             if (!file) {
                 return true;
@@ -345,8 +474,24 @@ void GameListWorker::ScanFileSystem(ScanTarget target, const std::string& dir_pa
                 const FileSys::PatchManager patch{program_id, system.GetFileSystemController(),
                                                   system.GetContentProvider()};
 
-                emit EntryReady(MakeGameListEntry(physical_name, name, icon, *loader, program_id,
-                                                  compatibility_list, patch),
+                if (UISettings::values.cache_game_list) {
+                    WriteGameFileMetadata(physical_name,
+                                          {
+                                              .program_id = program_id,
+                                              .file_type = file_type,
+                                              .name = name,
+                                              .icon = icon,
+                                              .update_version = patch.GetGameVersion().value_or(0),
+                                          });
+                }
+
+                emit EntryReady(MakeGameListEntry(physical_name, name, icon, file_type, program_id,
+                                                  compatibility_list, patch,
+                                                  [&patch, &loader] {
+                                                      return FormatPatchNameVersions(
+                                                          patch, *loader,
+                                                          loader->IsRomFSUpdatable());
+                                                  }),
                                 parent_dir);
             }
         } else if (is_dir) {
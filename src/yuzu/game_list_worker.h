@@ -70,6 +70,9 @@ private:
         PopulateGameList,
     };
 
+    /// Adds the entry of an unchanged file from the metadata cache. Returns false on a cache miss.
+    bool AddCachedGameListEntry(const std::string& physical_name, GameListDir* parent_dir);
+
     void ScanFileSystem(ScanTarget target, const std::string& dir_path, bool deep_scan,
                         GameListDir* parent_dir);
 
@@ -67,6 +67,7 @@ static FileSys::VirtualFile VfsDirectoryCreateFileWrapper(const FileSys::Virtual
 
 #include <fmt/format.h>
 #include "common/detached_tasks.h"
+#include "common/div_ceil.h"
 #include "common/fs/fs.h"
 #include "common/fs/fs_paths.h"
 #include "common/fs/path_util.h"
@@ -495,7 +496,7 @@ void GMainWindow::SoftwareKeyboardShowNormal() {
         return;
     }
 
-    const auto& layout = render_window->GetFramebufferLayout();
+    const auto layout = render_window->GetFramebufferLayout();
 
     const auto x = layout.screen.left;
     const auto y = layout.screen.top;
@@ -523,7 +524,7 @@ void GMainWindow::SoftwareKeyboardShowInline(
         return;
     }
 
-    const auto& layout = render_window->GetFramebufferLayout();
+    const auto layout = render_window->GetFramebufferLayout();
 
     const auto x =
         static_cast<int>(layout.screen.left + (0.5f * layout.screen.GetWidth() *
@@ -615,7 +616,7 @@ void GMainWindow::WebBrowserOpenWebPage(const std::string& main_url,
             render_window->hide();
         }
 
-        const auto& layout = render_window->GetFramebufferLayout();
+        const auto layout = render_window->GetFramebufferLayout();
         web_browser_view.resize(layout.screen.GetWidth(), layout.screen.GetHeight());
         web_browser_view.move(layout.screen.left, layout.screen.top + menuBar()->height());
         web_browser_view.setZoomFactor(static_cast<qreal>(layout.screen.GetWidth()) /
@@ -753,9 +754,14 @@ void GMainWindow::InitializeWidgets() {
     emu_frametime_label->setToolTip(
         tr("Time taken to emulate a Switch frame, not counting framelimiting or v-sync. For "
            "full-speed emulation this should be at most 16.67 ms."));
-
-    for (auto& label :
-         {shader_building_label, emu_speed_label, game_fps_label, emu_frametime_label}) {
+    cpu_usage_label = new QLabel();
+    cpu_usage_label->setToolTip(
+        tr("Share of time each emulated CPU core spends running guest code. The remainder is "
+           "spent in system calls, in the emulator or waiting for work."));
+    memory_usage_label = new QLabel();
+
+    for (auto& label : {shader_building_label, emu_speed_label, game_fps_label,
+                        emu_frametime_label, cpu_usage_label, memory_usage_label}) {
         label->setVisible(false);
         label->setFrameStyle(QFrame::NoFrame);
         label->setContentsMargins(4, 0, 4, 0);
@@ -1505,6 +1511,8 @@ void GMainWindow::ShutdownGame() {
     emu_speed_label->setVisible(false);
     game_fps_label->setVisible(false);
     emu_frametime_label->setVisible(false);
+    cpu_usage_label->setVisible(false);
+    memory_usage_label->setVisible(false);
     async_status_button->setEnabled(true);
     multicore_status_button->setEnabled(true);
     renderer_status_button->setEnabled(true);
@@ -2115,8 +2123,8 @@ void GMainWindow::OnMenuLoadFolder() {
     }
 }
 
-void GMainWindow::IncrementInstallProgress() {
-    install_progress->setValue(install_progress->value() + 1);
+void GMainWindow::IncrementInstallProgress(int increment) {
+    install_progress->setValue(install_progress->value() + increment);
 }
 
 void GMainWindow::OnMenuInstallToNAND() {
@@ -2242,27 +2250,14 @@ void GMainWindow::OnMenuInstallToNAND() {
 InstallResult GMainWindow::InstallNSPXCI(const QString& filename) {
     const auto qt_raw_copy = [this](const FileSys::VirtualFile& src,
                                     const FileSys::VirtualFile& dest, std::size_t block_size) {
-        if (src == nullptr || dest == nullptr) {
-            return false;
-        }
-        if (!dest->Resize(src->GetSize())) {
-            return false;
-        }
-
-        std::array<u8, 0x1000> buffer{};
-
-        for (std::size_t i = 0; i < src->GetSize(); i += buffer.size()) {
+        return FileSys::VfsRawCopyPipelined(src, dest, block_size, [this](std::size_t copied) {
             if (install_progress->wasCanceled()) {
-                dest->Resize(0);
                 return false;
             }
-
-            emit UpdateInstallProgress();
-
-            const auto read = src->Read(buffer.data(), buffer.size(), i);
-            dest->Write(buffer.data(), read, i);
-        }
-        return true;
+            // The progress dialog counts in units of 4 KiB
+            emit UpdateInstallProgress(static_cast<int>(Common::DivCeil(copied, std::size_t{0x1000})));
+            return true;
+        });
     };
 
     std::shared_ptr<FileSys::NSP> nsp;
@@ -2299,27 +2294,14 @@ InstallResult GMainWindow::InstallNSPXCI(const QString& filename) {
 InstallResult GMainWindow::InstallNCA(const QString& filename) {
     const auto qt_raw_copy = [this](const FileSys::VirtualFile& src,
                                     const FileSys::VirtualFile& dest, std::size_t block_size) {
-        if (src == nullptr || dest == nullptr) {
-            return false;
-        }
-        if (!dest->Resize(src->GetSize())) {
-            return false;
-        }
-
-        std::array<u8, 0x1000> buffer{};
-
-        for (std::size_t i = 0; i < src->GetSize(); i += buffer.size()) {
+        return FileSys::VfsRawCopyPipelined(src, dest, block_size, [this](std::size_t copied) {
             if (install_progress->wasCanceled()) {
-                dest->Resize(0);
                 return false;
             }
-
-            emit UpdateInstallProgress();
-
-            const auto read = src->Read(buffer.data(), buffer.size(), i);
-            dest->Write(buffer.data(), read, i);
-        }
-        return true;
+            // The progress dialog counts in units of 4 KiB
+            emit UpdateInstallProgress(static_cast<int>(Common::DivCeil(copied, std::size_t{0x1000})));
+            return true;
+        });
     };
 
     const auto nca =
@@ -2926,9 +2908,29 @@ void GMainWindow::UpdateStatusBar() {
     }
     emu_frametime_label->setText(tr("Frame: %1 ms").arg(results.frametime * 1000.0, 0, 'f', 2));
 
+    QStringList core_usage;
+    for (const auto& core : results.cores) {
+        core_usage.append(QStringLiteral("%1%").arg(core.busy * 100.0, 0, 'f', 0));
+    }
+    cpu_usage_label->setText(tr("CPU: %1").arg(core_usage.join(QLatin1Char{' '})));
+
+    const auto memory = Core::System::GetInstance().GetMemoryUsage();
+    const auto to_mib = [](u64 bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); };
+    memory_usage_label->setText(tr("Memory: %1 MiB").arg(to_mib(memory.Total()), 0, 'f', 0));
+    memory_usage_label->setToolTip(tr("Host memory held by the emulator, in MiB\n"
+                                      "Guest memory: %1\nTexture cache: %2\nBuffer cache: %3\n"
+                                      "Staging buffers: %4\nFile cache: %5")
+                                       .arg(to_mib(memory.guest_memory), 0, 'f', 1)
+                                       .arg(to_mib(memory.texture_cache), 0, 'f', 1)
+                                       .arg(to_mib(memory.buffer_cache), 0, 'f', 1)
+                                       .arg(to_mib(memory.staging_buffers), 0, 'f', 1)
+                                       .arg(to_mib(memory.file_cache), 0, 'f', 1));
+
     emu_speed_label->setVisible(!Settings::values.use_multi_core.GetValue());
     game_fps_label->setVisible(true);
     emu_frametime_label->setVisible(true);
+    cpu_usage_label->setVisible(true);
+    memory_usage_label->setVisible(true);
 }
 
 void GMainWindow::UpdateStatusButtons() {
@@ -0,0 +1,166 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <fmt/format.h>
+#include "common/logging/log.h"
+#include "common/scm_rev.h"
+#include "common/settings.h"
+#include "core/core.h"
+#include "core/hle/kernel/k_process.h"
+#include "core/startup_timeline.h"
+#include "video_core/renderer_base.h"
+#include "yuzu_cmd/benchmark.h"
+#include "yuzu_cmd/emu_window/emu_window_sdl2.h"
+
+namespace {
+/// Interval at which the frame count is checked while measuring
+constexpr std::chrono::milliseconds POLL_INTERVAL{100};
+
+/// Escapes the characters that can't appear as is in a JSON string
+std::string EscapeJson(std::string_view string) {
+    std::string escaped;
+    escaped.reserve(string.size());
+    for (const char c : string) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+double ToMiB(u64 bytes) {
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+} // Anonymous namespace
+
+Benchmark::Benchmark(u64 frames, std::chrono::seconds duration)
+    : target_frames{frames}, target_duration{duration} {}
+
+Benchmark::~Benchmark() = default;
+
+void Benchmark::Begin(Core::System& system, EmuWindow_SDL2& emu_window, std::string path) {
+    current = Result{
+        .path = std::move(path),
+        .title_id = system.CurrentProcess()->GetTitleID(),
+        .driver = system.Renderer().GetDeviceVendor(),
+        .booted = true,
+    };
+    // The title bar resets the stats when it reads them
+    emu_window.HidePerfStats();
+    measure_thread = std::jthread([this, &system, &emu_window](std::stop_token token) {
+        Measure(token, system, emu_window);
+    });
+}
+
+void Benchmark::End() {
+    measure_thread = {};
+    results.push_back(std::move(current));
+}
+
+void Benchmark::AddFailure(std::string path) {
+    results.push_back(Result{
+        .path = std::move(path),
+    });
+}
+
+bool Benchmark::IsSuccessful() const {
+    return std::ranges::all_of(results, &Result::completed);
+}
+
+std::string Benchmark::ToJson() const {
+    const auto& values = Settings::values;
+    std::string json = fmt::format(
+        "{{\n  \"build\": \"{} {}\",\n  \"settings\": {{\"renderer_backend\": {}, "
+        "\"use_multi_core\": {}, \"cpu_accuracy\": {}, \"gpu_accuracy\": {}, "
+        "\"use_asynchronous_gpu_emulation\": {}, \"use_asynchronous_shaders\": {}}},\n"
+        "  \"titles\": [",
+        Common::g_scm_branch, Common::g_scm_desc,
+        static_cast<u32>(values.renderer_backend.GetValue()), values.use_multi_core.GetValue(),
+        static_cast<u32>(values.cpu_accuracy.GetValue()),
+        static_cast<u32>(values.gpu_accuracy.GetValue()),
+        values.use_asynchronous_gpu_emulation.GetValue(),
+        values.use_asynchronous_shaders.GetValue());
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        json += fmt::format("{}\n    {{\"path\": \"{}\", \"title_id\": \"{:016X}\", "
+                            "\"driver\": \"{}\", \"booted\": {}, \"completed\": {}",
+                            i == 0 ? "" : ",", EscapeJson(result.path), result.title_id,
+                            EscapeJson(result.driver), result.booted, result.completed);
+        if (!result.booted) {
+            json += "}";
+            continue;
+        }
+        const Core::PerfStatsResults& stats = result.stats;
+        const Core::MemoryUsage& memory = result.memory;
+        // The startup timeline is already a JSON object, only its trailing newline is dropped
+        std::string_view startup{result.startup_json};
+        if (!startup.empty() && startup.back() == '\n') {
+            startup.remove_suffix(1);
+        }
+        json += fmt::format(
+            ",\n     \"frames\": {}, \"seconds\": {:.3f}, \"system_fps\": {:.2f}, "
+            "\"game_fps\": {:.2f}, \"emulation_speed\": {:.4f}, \"frametime_ms\": {:.3f}, "
+            "\"frametime_p50_ms\": {:.3f}, \"frametime_p95_ms\": {:.3f}, "
+            "\"frametime_p99_ms\": {:.3f}, \"stutters\": {}, \"gpu_idle\": {:.4f},\n"
+            "     \"memory_mib\": {{\"guest\": {:.1f}, \"texture_cache\": {:.1f}, "
+            "\"buffer_cache\": {:.1f}, \"staging_buffers\": {:.1f}, \"file_cache\": {:.1f}}},\n"
+            "     \"startup\": {}}}",
+            result.frames, result.seconds, stats.system_fps, stats.average_game_fps,
+            stats.emulation_speed, stats.frametime * 1000.0, stats.frametime_p50 * 1000.0,
+            stats.frametime_p95 * 1000.0, stats.frametime_p99 * 1000.0, stats.stutters,
+            stats.gpu_idle, ToMiB(memory.guest_memory), ToMiB(memory.texture_cache),
+            ToMiB(memory.buffer_cache), ToMiB(memory.staging_buffers), ToMiB(memory.file_cache),
+            startup.empty() ? "null" : startup);
+    }
+    json += "\n  ]\n}\n";
+    return json;
+}
+
+void Benchmark::Measure(std::stop_token token, Core::System& system, EmuWindow_SDL2& emu_window) {
+    const Core::PerfStats& perf_stats = system.GetPerfStats();
+    // Measurements start from the first frame, so they don't include the boot
+    while (perf_stats.GetFrametimeCount() == 0) {
+        if (!Wait(token, POLL_INTERVAL)) {
+            return;
+        }
+    }
+    void(system.GetAndResetPerfStats());
+    const std::size_t first_frame = perf_stats.GetFrametimeCount();
+    const auto begin = std::chrono::steady_clock::now();
+    const auto is_done = [&] {
+        if (target_frames != 0) {
+            return perf_stats.GetFrametimeCount() - first_frame >= target_frames;
+        }
+        return std::chrono::steady_clock::now() - begin >= target_duration;
+    };
+    bool completed = true;
+    while (!is_done()) {
+        if (!Wait(token, POLL_INTERVAL)) {
+            completed = false;
+            break;
+        }
+    }
+    current.stats = system.GetAndResetPerfStats();
+    current.frames = perf_stats.GetFrametimeCount() - first_frame;
+    current.seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    current.memory = system.GetMemoryUsage();
+    current.startup_json = system.GetStartupTimeline().ToJson();
+    current.completed = completed;
+    if (!completed) {
+        LOG_WARNING(Frontend, "Benchmark of {} was stopped after {} frames", current.path,
+                    current.frames);
+        return;
+    }
+    LOG_INFO(Frontend, "Benchmark of {}: {} frames in {:.2f} s, {:.3f} ms per frame", current.path,
+             current.frames, current.seconds, current.stats.frametime * 1000.0);
+    emu_window.RequestClose();
+}
+
+bool Benchmark::Wait(std::stop_token token, std::chrono::milliseconds time) {
+    std::unique_lock lock{mutex};
+    return !cv.wait_for(lock, token, time, [&token] { return token.stop_requested(); });
+}
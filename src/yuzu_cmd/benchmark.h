@@ -0,0 +1,79 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_types.h"
+#include "core/perf_stats.h"
+
+namespace Core {
+class System;
+}
+
+class EmuWindow_SDL2;
+
+/**
+ * Measures titles run one after the other for a fixed number of frames or seconds, starting from
+ * their first frame, and writes the results as JSON. The window of each title is closed once its
+ * measurement is done.
+ */
+class Benchmark {
+public:
+    /// Measures for the given number of system frames, or seconds when frames is zero
+    explicit Benchmark(u64 frames, std::chrono::seconds duration);
+    ~Benchmark();
+
+    /// Starts measuring the title that was just booted
+    void Begin(Core::System& system, EmuWindow_SDL2& emu_window, std::string path);
+
+    /// Stops measuring the current title and records its results
+    void End();
+
+    /// Records a title that failed to boot
+    void AddFailure(std::string path);
+
+    /// Returns true when every title was measured to completion
+    [[nodiscard]] bool IsSuccessful() const;
+
+    /// Returns the results of every title as JSON
+    [[nodiscard]] std::string ToJson() const;
+
+private:
+    struct Result {
+        std::string path;
+        u64 title_id{};
+        std::string driver;
+        bool booted{};
+        /// True when the measurement ran for as long as requested
+        bool completed{};
+        u64 frames{};
+        double seconds{};
+        Core::PerfStatsResults stats{};
+        Core::MemoryUsage memory{};
+        std::string startup_json;
+    };
+
+    /// Waits for the first frame then measures the title, runs on its own thread
+    void Measure(std::stop_token token, Core::System& system, EmuWindow_SDL2& emu_window);
+
+    /// Waits for the given time, returns false when the measurement was stopped
+    bool Wait(std::stop_token token, std::chrono::milliseconds time);
+
+    u64 target_frames;
+    std::chrono::seconds target_duration;
+
+    std::mutex mutex;
+    std::condition_variable_any cv;
+    std::jthread measure_thread;
+    /// Result of the title being measured, only touched by the measure thread while it runs
+    Result current;
+    std::vector<Result> results;
+};
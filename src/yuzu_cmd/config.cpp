@@ -30,9 +30,10 @@
 
 namespace FS = Common::FS;
 
-Config::Config() {
+Config::Config(std::optional<std::filesystem::path> config_path) {
     // TODO: Don't hardcode the path; let the frontend decide where to put the config files.
-    sdl2_config_loc = FS::GetYuzuPath(FS::YuzuPath::ConfigDir) / "sdl2-config.ini";
+    sdl2_config_loc = config_path.value_or(FS::GetYuzuPath(FS::YuzuPath::ConfigDir) /
+                                           "sdl2-config.ini");
     sdl2_config = std::make_unique<INIReader>(FS::PathToUTF8String(sdl2_config_loc));
 
     Reload();
@@ -390,6 +391,8 @@ void Config::ReadValues() {
     ReadSetting("Data Storage", Settings::values.gamecard_inserted);
     ReadSetting("Data Storage", Settings::values.gamecard_current_game);
     ReadSetting("Data Storage", Settings::values.gamecard_path);
+    ReadSetting("Data Storage", Settings::values.romfs_cache_size);
+    ReadSetting("Data Storage", Settings::values.use_shared_content_cache);
 
     // System
     ReadSetting("System", Settings::values.use_docked_mode);
@@ -418,6 +421,21 @@ void Config::ReadValues() {
 
     // Core
     ReadSetting("Core", Settings::values.use_multi_core);
+    ReadSetting("Core", Settings::values.service_thread_affinity);
+    ReadSetting("Core", Settings::values.service_thread_priority);
+    ReadSetting("Core", Settings::values.fs_service_thread_affinity);
+    ReadSetting("Core", Settings::values.fs_service_thread_priority);
+    ReadSetting("Core", Settings::values.nvdrv_service_thread_affinity);
+    ReadSetting("Core", Settings::values.nvdrv_service_thread_priority);
+    ReadSetting("Core", Settings::values.audio_service_thread_affinity);
+    ReadSetting("Core", Settings::values.audio_service_thread_priority);
+    ReadSetting("Core", Settings::values.precise_core_timing);
+    ReadSetting("Core", Settings::values.use_huge_pages);
+    ReadSetting("Core", Settings::values.use_thread_placement);
+    ReadSetting("Core", Settings::values.perf_tuning);
+
+    // Cpu
+    ReadSetting("Cpu", Settings::values.cpu_code_cache_size);
 
     // Renderer
     ReadSetting("Renderer", Settings::values.renderer_backend);
@@ -429,14 +447,31 @@ void Config::ReadValues() {
     ReadSetting("Renderer", Settings::values.use_frame_limit);
     ReadSetting("Renderer", Settings::values.frame_limit);
     ReadSetting("Renderer", Settings::values.use_disk_shader_cache);
+    ReadSetting("Renderer", Settings::values.use_astc_disk_cache);
+    ReadSetting("Renderer", Settings::values.use_texture_deduplication);
+    ReadSetting("Renderer", Settings::values.use_texture_streaming);
     ReadSetting("Renderer", Settings::values.gpu_accuracy);
     ReadSetting("Renderer", Settings::values.use_asynchronous_gpu_emulation);
     ReadSetting("Renderer", Settings::values.use_vsync);
+    ReadSetting("Renderer", Settings::values.present_mode);
+    ReadSetting("Renderer", Settings::values.render_scale);
     ReadSetting("Renderer", Settings::values.disable_fps_limit);
     ReadSetting("Renderer", Settings::values.use_assembly_shaders);
     ReadSetting("Renderer", Settings::values.use_asynchronous_shaders);
+    ReadSetting("Renderer", Settings::values.async_shader_wait_time);
+    ReadSetting("Renderer", Settings::values.use_spirv_optimizer);
+    ReadSetting("Renderer", Settings::values.use_shader_specialization);
+    ReadSetting("Renderer", Settings::values.use_bindless_textures);
+    ReadSetting("Renderer", Settings::values.use_draw_batching);
+    ReadSetting("Renderer", Settings::values.use_transfer_queue);
+    ReadSetting("Renderer", Settings::values.use_async_compute);
+    ReadSetting("Renderer", Settings::values.use_memory_defragmentation);
     ReadSetting("Renderer", Settings::values.use_nvdec_emulation);
+    ReadSetting("Renderer", Settings::values.use_nvdec_hwaccel);
     ReadSetting("Renderer", Settings::values.accelerate_astc);
+    ReadSetting("Renderer", Settings::values.transcode_astc);
+    ReadSetting("Renderer", Settings::values.vram_budget);
+    ReadSetting("Renderer", Settings::values.use_asynchronous_downloads);
     ReadSetting("Renderer", Settings::values.use_fast_gpu_time);
 
     ReadSetting("Renderer", Settings::values.bg_red);
@@ -447,6 +482,7 @@ void Config::ReadValues() {
     ReadSetting("Audio", Settings::values.sink_id);
     ReadSetting("Audio", Settings::values.enable_audio_stretching);
     ReadSetting("Audio", Settings::values.audio_device_id);
+    ReadSetting("Audio", Settings::values.audio_low_latency);
     ReadSetting("Audio", Settings::values.volume);
 
     // Miscellaneous
@@ -467,6 +503,9 @@ void Config::ReadValues() {
     ReadSetting("Debugging", Settings::values.use_debug_asserts);
     ReadSetting("Debugging", Settings::values.use_auto_stub);
     ReadSetting("Debugging", Settings::values.disable_macro_jit);
+    ReadSetting("Debugging", Settings::values.dump_macro_profile);
+    ReadSetting("Debugging", Settings::values.dump_audio_renderer);
+    ReadSetting("Debugging", Settings::values.gpu_capture_frames);
 
     const auto title_list = sdl2_config->Get("AddOns", "title_ids", "");
     std::stringstream ss(title_list);
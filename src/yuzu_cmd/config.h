@@ -6,6 +6,7 @@
 
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "common/settings.h"
@@ -20,7 +21,8 @@ class Config {
     void ReadValues();
 
 public:
-    Config();
+    /// Loads the settings from the given file, or from the default one when none is given
+    explicit Config(std::optional<std::filesystem::path> config_path = std::nullopt);
     ~Config();
 
     void Reload();
@@ -117,7 +117,52 @@ udp_pad_index=
 # 0: Disabled, 1 (default): Enabled
 use_multi_core=
 
+# Host cores HLE service threads may run on, as a bit mask of the first 32 logical cores
+# 0 (default): Any core
+service_thread_affinity =
+
+# Host priority of HLE service threads
+# 0: Low, 1 (default): Normal, 2: High, 3: Very high
+service_thread_priority =
+
+# Overrides of the above for the filesystem (fsp-srv), graphics (nvdrv) and audio (audren)
+# services. An affinity of 0 uses service_thread_affinity, priorities default to Normal.
+fs_service_thread_affinity =
+fs_service_thread_priority =
+nvdrv_service_thread_affinity =
+nvdrv_service_thread_priority =
+audio_service_thread_affinity =
+audio_service_thread_priority =
+
+# Whether the multi-core timing thread spins for the last moments before an event instead of
+# relying on the OS timer resolution. Smoother frame pacing at the cost of extra CPU usage.
+# 0 (default): Disabled, 1: Enabled
+precise_core_timing =
+
+# Whether to back emulated memory with transparent huge pages, reducing host TLB misses.
+# Only supported on Linux, with /sys/kernel/mm/transparent_hugepage/shmem_enabled set to advise.
+# 0 (default): Disabled, 1: Enabled
+use_huge_pages =
+
+# Whether to pin the guest cores and GPU threads to their own physical host cores, the fastest ones
+# first, leaving the service threads and shader compiles on the remaining cores.
+# Needs at least 7 physical cores in multicore mode, 4 otherwise.
+# 0 (default): Disabled, 1: Enabled
+use_thread_placement =
+
+# Whether to record the frame times of each title per combination of the asynchronous GPU, GPU
+# accuracy, asynchronous shaders, fast GPU time and CPU accuracy settings, in the custom config
+# directory. Auto tuning also tries combinations one setting away from the configured one, then
+# runs every session with the fastest one that never crashed. Tuned values are never saved.
+# 0 (default): Disabled, 1: Record, 2: Auto tune
+perf_tuning =
+
 [Cpu]
+# Size in MiB of the code cache of each JIT instance, clamped between 64 and 1536.
+# Titles filling the cache stutter while everything is translated again, raise it for them.
+# 512 (default)
+cpu_code_cache_size =
+
 # Enable inline page tables optimization (faster guest memory access)
 # 0: Disabled, 1 (default): Enabled
 cpuopt_page_tables =
@@ -154,9 +199,14 @@ cpuopt_reduce_misalign_checks =
 # 0: Disabled, 1 (default): Enabled
 cpuopt_fastmem =
 
+# Replace the memcpy, memmove, memset and strlen functions of game modules with host
+# implementations
+# 0: Disabled, 1 (default): Enabled
+cpuopt_hle_memory_functions =
+
 [Renderer]
 # Which backend API to use.
-# 0 (default): OpenGL, 1: Vulkan
+# 0 (default): OpenGL, 1: Vulkan, 2: Null (no host rendering, for profiling and testing)
 backend =
 
 # Enable graphics API debugging mode.
@@ -194,14 +244,72 @@ use_assembly_shaders =
 # 0 (default): Off, 1: On
 use_asynchronous_shaders =
 
+# Milliseconds a draw waits for its pipeline to be built asynchronously before it's skipped.
+# 0 (default): Skip the draw, 1 - 65535: Wait up to that time
+async_shader_wait_time =
+
+# Whether to run the SPIRV-Tools performance passes over Vulkan shaders before handing them to the
+# driver. Optimized shaders are kept in the disk shader cache, so each one is optimized once.
+# Only available when yuzu was built with SPIRV-Tools.
+# 0 (default): Off, 1: On
+use_spirv_optimizer =
+
+# Build variants of OpenGL shaders with the const buffer values their branches depend on folded in.
+# Variants are built asynchronously, so it requires use_asynchronous_shaders.
+# 0 (default): Off, 1: On
+use_shader_specialization =
+
+# Read OpenGL textures through bindless handles instead of binding them to texture units.
+# Only used with GLSL shaders on NVIDIA and AMD drivers that expose GL_ARB_bindless_texture.
+# 0 (default): Off, 1: On
+use_bindless_textures =
+
+# Merge consecutive OpenGL draws that only differ in their vertex or index ranges into indirect
+# multi-draws.
+# 0 (default): Off, 1: On
+use_draw_batching =
+
+# Upload new textures on a dedicated Vulkan transfer queue, overlapping them with rendering.
+# Ignored when the device doesn't expose a transfer-only queue family.
+# 0 (default): Off, 1: On
+use_transfer_queue =
+
+# Decode new ASTC textures on a dedicated Vulkan compute queue, overlapping them with rendering.
+# Ignored when the device doesn't expose a compute queue family without graphics.
+# 0 (default): Off, 1: On
+use_async_compute =
+
+# Recreate long unused textures living in mostly empty Vulkan memory chunks on idle frames,
+# so the chunks can be given back to the driver.
+# 0 (default): Off, 1: On
+use_memory_defragmentation =
+
 # Enable NVDEC emulation.
 # 0: Off, 1 (default): On
 use_nvdec_emulation =
 
+# Decode NVDEC video streams on the host GPU when FFmpeg supports it, falling back to the CPU.
+# 0: Off, 1 (default): On
+use_nvdec_hwaccel =
+
 # Accelerate ASTC texture decoding.
 # 0: Off, 1 (default): On
 accelerate_astc =
 
+# Store ASTC textures as BC3 on hosts without native ASTC support, uses less video memory
+# 0 (default): Off, 1: On
+transcode_astc =
+
+# Video memory in MiB the texture cache tries to stay under, least recently used textures are
+# evicted first when it is exceeded
+# 0 (default): Use a budget based on the device memory, any other value: Budget in MiB
+vram_budget =
+
+# Record GPU to CPU downloads at fences and write them back once the fence is reached, instead of
+# waiting for the GPU when the downloads are committed. Only implemented on Vulkan.
+# 0 (default): Off, 1: On
+use_asynchronous_downloads =
+
 # Turns on the frame limiter, which will limit frames output to the target game speed
 # 0: Off, 1: On (default)
 use_frame_limit =
@@ -214,6 +322,20 @@ frame_limit =
 # 0 (default): Off, 1 : On
 use_disk_shader_cache =
 
+# Whether to store the results of decoding ASTC textures on the CPU to disk
+# 0 (default): Off, 1 : On
+use_astc_disk_cache =
+
+# Whether to copy identical textures uploaded at different addresses from the GPU instead of
+# decoding them again
+# 0 (default): Off, 1 : On
+use_texture_deduplication =
+
+# Whether to upload the larger mip levels of big textures over the frames after their first use,
+# sampling them at a lower detail level until they are complete
+# 0 (default): Off, 1 : On
+use_texture_streaming =
+
 # Which gpu accuracy level to use
 # 0 (Normal), 1 (High), 2 (Extreme)
 gpu_accuracy =
@@ -227,6 +349,18 @@ use_asynchronous_gpu_emulation =
 # 0: Off, 1 (default): On
 use_vsync =
 
+# Which Vulkan present mode to request, falls back to FIFO when the surface doesn't support it.
+# FIFO waits for vertical blank, FIFO relaxed tears when a frame is late, mailbox replaces queued
+# frames without tearing and immediate presents right away with tearing.
+# 0 (default): Automatic (mailbox when available), 1: FIFO, 2: FIFO relaxed, 3: Mailbox,
+# 4: Immediate
+present_mode =
+
+# Render target scale, below native trades image quality for fill rate on weak GPUs.
+# Targets read with guest pixel coordinates by shaders are kept at native resolution.
+# 0 (default): Native, 1: 0.75x, 2: 0.5x
+render_scale =
+
 # Whether to use garbage collection or not for GPU caches.
 # 0 (default): Off, 1: On
 use_caches_gc =
@@ -280,6 +414,12 @@ enable_audio_stretching =
 # auto (default): Auto-select
 output_device =
 
+# Whether to keep the audio output queue as short as the device timing allows.
+# The queue is sized from the measured device callback jitter, dropping samples when it grows.
+# Only supported by the cubeb audio engine.
+# 0 (default): No, 1: Yes
+audio_low_latency =
+
 # Output volume.
 # 100 (default): 100%, 0; mute
 volume =
@@ -303,6 +443,15 @@ gamecard_current_game =
 # If 'gamecard_current_game' is 1 this setting is irrelevant
 gamecard_path =
 
+# Size in MiB of the cache of decrypted sectors kept for each encrypted game content archive
+# 0: Disabled, 4 (default)
+romfs_cache_size =
+
+# Keep decrypted game contents in the cache directory, memory mapped and shared by every instance
+# running the same content. The first run copies them in the background, decrypted.
+# 0 (default): Disabled, 1: Enabled
+use_shared_content_cache =
+
 [System]
 # Whether the system is docked
 # 1 (default): Yes, 0: No
@@ -366,7 +515,17 @@ use_debug_asserts =
 use_auto_stub =
 # Enables/Disables the macro JIT compiler
 disable_macro_jit=false
-# Presents guest frames as they become available. Experimental.
+# Records how often each macro runs and how long it takes, written to the dump directory per title
+# false: Disabled (default), true: Enabled
+dump_macro_profile=false
+# Saves the inputs of every audio renderer to a capture in the dump directory, for offline replay
+# false: Disabled (default), true: Enabled
+dump_audio_renderer=false
+# Records the GPU command stream of the first N frames to the dump directory and logs per frame
+# times and method counts for each engine. 0 (default): Disabled
+gpu_capture_frames=0
+# Presents guest frames as soon as they are ready instead of at the next vsync. The guest keeps
+# seeing vsync at its nominal rate. Experimental.
 # false: Disabled (default), true: Enabled
 disable_fps_limit=false
 
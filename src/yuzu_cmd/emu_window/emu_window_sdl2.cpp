@@ -211,7 +211,7 @@ void EmuWindow_SDL2::WaitEvent() {
     }
 
     const u32 current_time = SDL_GetTicks();
-    if (current_time > last_time + 2000) {
+    if (show_perf_stats && current_time > last_time + 2000) {
         const auto results = Core::System::GetInstance().GetAndResetPerfStats();
         const auto title =
             fmt::format("yuzu {} | {}-{} | FPS: {:.0f} ({:.0f}%)", Common::g_build_fullname,
@@ -222,6 +222,16 @@ void EmuWindow_SDL2::WaitEvent() {
     }
 }
 
+void EmuWindow_SDL2::RequestClose() {
+    SDL_Event event{};
+    event.type = SDL_QUIT;
+    SDL_PushEvent(&event);
+}
+
+void EmuWindow_SDL2::HidePerfStats() {
+    show_perf_stats = false;
+}
+
 void EmuWindow_SDL2::SetWindowIcon() {
     SDL_RWops* const yuzu_icon_stream = SDL_RWFromConstMem((void*)yuzu_icon, yuzu_icon_size);
     if (yuzu_icon_stream == nullptr) {
@@ -36,6 +36,12 @@ public:
     /// Wait for the next event on the main thread.
     void WaitEvent();
 
+    /// Requests the window to close, can be called from any thread
+    void RequestClose();
+
+    /// Stops showing the performance stats in the title bar, reading them resets them
+    void HidePerfStats();
+
     // Sets the window icon from yuzu.bmp
     void SetWindowIcon();
 
@@ -85,6 +91,9 @@ protected:
     /// Keeps track of how often to update the title bar during gameplay
     u32 last_time = 0;
 
+    /// Whether the performance stats are shown in the title bar
+    bool show_perf_stats = true;
+
     /// Input subsystem to use with this window.
     InputCommon::InputSubsystem* input_subsystem;
 };
@@ -2,15 +2,22 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <charconv>
 #include <chrono>
+#include <condition_variable>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <vector>
 
 #include <fmt/ostream.h>
 
 #include "common/detached_tasks.h"
+#include "common/fs/file.h"
 #include "common/fs/fs.h"
 #include "common/fs/fs_paths.h"
 #include "common/fs/path_util.h"
@@ -24,19 +31,25 @@
 #include "common/settings.h"
 #include "common/string_util.h"
 #include "common/telemetry.h"
+#include "common/trace_recorder.h"
 #include "core/core.h"
 #include "core/crypto/key_manager.h"
 #include "core/file_sys/registered_cache.h"
 #include "core/file_sys/vfs_real.h"
 #include "core/hle/kernel/k_process.h"
 #include "core/hle/service/filesystem/filesystem.h"
+#include "core/hle/service/ipc_profiler.h"
 #include "core/loader/loader.h"
+#include "core/perf_stats.h"
+#include "core/startup_timeline.h"
 #include "core/telemetry_session.h"
 #include "input_common/main.h"
 #include "video_core/renderer_base.h"
+#include "yuzu_cmd/benchmark.h"
 #include "yuzu_cmd/config.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2_gl.h"
+#include "yuzu_cmd/emu_window/emu_window_sdl2_null.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2_vk.h"
 
 #ifdef _WIN32
@@ -63,11 +76,23 @@ __declspec(dllexport) int AmdPowerXpressRequestHighPerformance = 1;
 
 static void PrintHelp(const char* argv0) {
     std::cout << "Usage: " << argv0
-              << " [options] <filename>\n"
+              << " [options] <filename>...\n"
                  "-f, --fullscreen      Start in fullscreen mode\n"
                  "-h, --help            Display this help and exit\n"
                  "-v, --version         Output version information and exit\n"
-                 "-p, --program         Pass following string as arguments to executable\n";
+                 "-p, --program         Pass following string as arguments to executable\n"
+                 "--trace FILE          Export profiled scopes as a Chrome trace to FILE\n"
+                 "--trace-frames F:N    Only trace the N frames starting at frame F\n"
+                 "--startup-report FILE Write the boot phase timings as JSON to FILE on exit\n"
+                 "--ipc-report FILE     Profile HLE service commands, written as JSON to FILE on "
+                 "exit\n"
+                 "--memory-report SECS  Log the host memory held by each subsystem every SECS "
+                 "seconds\n"
+                 "-c, --config FILE     Load the settings from FILE instead of sdl2-config.ini\n"
+                 "--benchmark FILE      Run each of the given ROMs in turn and write their "
+                 "performance as JSON to FILE\n"
+                 "--benchmark-frames N  Measure each ROM for N frames from its first frame\n"
+                 "--benchmark-seconds S Measure each ROM for S seconds from its first frame\n";
 }
 
 static void PrintVersion() {
@@ -91,10 +116,43 @@ static void InitializeLogging() {
 #endif
 }
 
+/// Logs the reason a ROM failed to load, returns false when it did
+static bool CheckLoadResult(Core::System::ResultStatus load_result, const std::string& filepath) {
+    switch (load_result) {
+    case Core::System::ResultStatus::ErrorGetLoader:
+        LOG_CRITICAL(Frontend, "Failed to obtain loader for {}!", filepath);
+        return false;
+    case Core::System::ResultStatus::ErrorLoader:
+        LOG_CRITICAL(Frontend, "Failed to load ROM!");
+        return false;
+    case Core::System::ResultStatus::ErrorNotInitialized:
+        LOG_CRITICAL(Frontend, "CPUCore not initialized");
+        return false;
+    case Core::System::ResultStatus::ErrorVideoCore:
+        LOG_CRITICAL(Frontend, "Failed to initialize VideoCore!");
+        return false;
+    case Core::System::ResultStatus::Success:
+        break; // Expected case
+    default:
+        if (static_cast<u32>(load_result) >
+            static_cast<u32>(Core::System::ResultStatus::ErrorLoader)) {
+            const u16 loader_id = static_cast<u16>(Core::System::ResultStatus::ErrorLoader);
+            const u16 error_id = static_cast<u16>(load_result) - loader_id;
+            LOG_CRITICAL(Frontend,
+                         "While attempting to load the ROM requested, an error occurred. Please "
+                         "refer to the yuzu wiki for more information or the yuzu discord for "
+                         "additional help.\n\nError Code: {:04X}-{:04X}\nError Description: {}",
+                         loader_id, error_id, static_cast<Loader::ResultStatus>(error_id));
+            return false;
+        }
+    }
+    return true;
+}
+
 /// Application entry point
 int main(int argc, char** argv) {
     Common::DetachedTasks detached_tasks;
-    Config config;
+    std::optional<Config> config{std::in_place};
 
     int option_index = 0;
 
@@ -108,22 +166,43 @@ int main(int argc, char** argv) {
         return -1;
     }
 #endif
-    std::string filepath;
+    std::vector<std::string> filepaths;
 
     bool fullscreen = false;
+    std::string trace_path;
+    u64 trace_first_frame = 0;
+    u64 trace_num_frames = 0;
+    std::string startup_report_path;
+    std::string ipc_report_path;
+    u32 memory_report_interval = 0;
+    std::string benchmark_report_path;
+    u64 benchmark_frames = 0;
+    u32 benchmark_seconds = 0;
 
     static struct option long_options[] = {
+        {"config", required_argument, 0, 'c'},
         {"fullscreen", no_argument, 0, 'f'},
         {"help", no_argument, 0, 'h'},
         {"version", no_argument, 0, 'v'},
         {"program", optional_argument, 0, 'p'},
+        {"trace", required_argument, 0, 't'},
+        {"trace-frames", required_argument, 0, 'T'},
+        {"startup-report", required_argument, 0, 'S'},
+        {"ipc-report", required_argument, 0, 'I'},
+        {"memory-report", required_argument, 0, 'M'},
+        {"benchmark", required_argument, 0, 'B'},
+        {"benchmark-frames", required_argument, 0, 'F'},
+        {"benchmark-seconds", required_argument, 0, 'D'},
         {0, 0, 0, 0},
     };
 
     while (optind < argc) {
-        int arg = getopt_long(argc, argv, "g:fhvp::", long_options, &option_index);
+        int arg = getopt_long(argc, argv, "g:c:fhvp::", long_options, &option_index);
         if (arg != -1) {
             switch (static_cast<char>(arg)) {
+            case 'c':
+                config.emplace(std::filesystem::path{optarg});
+                break;
             case 'f':
                 fullscreen = true;
                 LOG_INFO(Frontend, "Starting in fullscreen mode...");
@@ -138,12 +217,61 @@ int main(int argc, char** argv) {
                 Settings::values.program_args = argv[optind];
                 ++optind;
                 break;
+            case 't':
+                trace_path = optarg;
+                break;
+            case 'S':
+                startup_report_path = optarg;
+                break;
+            case 'I':
+                ipc_report_path = optarg;
+                break;
+            case 'B':
+                benchmark_report_path = optarg;
+                break;
+            case 'F':
+            case 'D': {
+                const std::string_view value{optarg};
+                const char* const end = value.data() + value.size();
+                const bool is_valid =
+                    arg == 'F' ? std::from_chars(value.data(), end, benchmark_frames).ptr == end
+                               : std::from_chars(value.data(), end, benchmark_seconds).ptr == end;
+                if (!is_valid) {
+                    LOG_CRITICAL(Frontend, "Invalid benchmark length {}", value);
+                    return -1;
+                }
+                break;
+            }
+            case 'M': {
+                const std::string_view interval{optarg};
+                const char* const end = interval.data() + interval.size();
+                if (std::from_chars(interval.data(), end, memory_report_interval).ptr != end ||
+                    memory_report_interval == 0) {
+                    LOG_CRITICAL(Frontend, "Invalid memory report interval {}", interval);
+                    return -1;
+                }
+                break;
+            }
+            case 'T': {
+                const std::string_view frames{optarg};
+                const std::size_t separator = frames.find(':');
+                const char* const end = frames.data() + frames.size();
+                if (separator == std::string_view::npos ||
+                    std::from_chars(frames.data(), frames.data() + separator, trace_first_frame)
+                            .ptr != frames.data() + separator ||
+                    std::from_chars(frames.data() + separator + 1, end, trace_num_frames).ptr !=
+                        end) {
+                    LOG_CRITICAL(Frontend, "Invalid trace frame range {}, expected F:N", frames);
+                    return -1;
+                }
+                break;
+            }
             }
         } else {
 #ifdef _WIN32
-            filepath = Common::UTF16ToUTF8(argv_w[optind]);
+            filepaths.push_back(Common::UTF16ToUTF8(argv_w[optind]));
 #else
-            filepath = argv[optind];
+            filepaths.push_back(argv[optind]);
 #endif
             optind++;
         }
@@ -158,10 +286,18 @@ int main(int argc, char** argv) {
 
     Common::ConfigureNvidiaEnvironmentFlags();
 
-    if (filepath.empty()) {
+    if (filepaths.empty()) {
         LOG_CRITICAL(Frontend, "Failed to load ROM: No ROM specified");
         return -1;
     }
+    if (benchmark_report_path.empty() && filepaths.size() > 1) {
+        LOG_CRITICAL(Frontend, "Only one ROM can be booted outside of benchmark mode");
+        return -1;
+    }
+    if (!benchmark_report_path.empty() && benchmark_frames == 0 && benchmark_seconds == 0) {
+        LOG_CRITICAL(Frontend, "Benchmarks need --benchmark-frames or --benchmark-seconds");
+        return -1;
+    }
 
     auto& system{Core::System::GetInstance()};
     InputCommon::InputSubsystem input_subsystem;
@@ -169,66 +305,120 @@ int main(int argc, char** argv) {
     // Apply the command line arguments
     system.ApplySettings();
 
-    std::unique_ptr<EmuWindow_SDL2> emu_window;
-    switch (Settings::values.renderer_backend.GetValue()) {
-    case Settings::RendererBackend::OpenGL:
-        emu_window = std::make_unique<EmuWindow_SDL2_GL>(&input_subsystem, fullscreen);
-        break;
-    case Settings::RendererBackend::Vulkan:
-        emu_window = std::make_unique<EmuWindow_SDL2_VK>(&input_subsystem);
-        break;
+    std::optional<Benchmark> benchmark;
+    if (!benchmark_report_path.empty()) {
+        benchmark.emplace(benchmark_frames, std::chrono::seconds{benchmark_seconds});
     }
 
-    system.SetContentProvider(std::make_unique<FileSys::ContentProviderUnion>());
-    system.SetFilesystem(std::make_shared<FileSys::RealVfsFilesystem>());
-    system.GetFileSystemController().CreateFactories(*system.GetFilesystem());
+    for (const std::string& filepath : filepaths) {
+        std::unique_ptr<EmuWindow_SDL2> emu_window;
+        switch (Settings::values.renderer_backend.GetValue()) {
+        case Settings::RendererBackend::OpenGL:
+            emu_window = std::make_unique<EmuWindow_SDL2_GL>(&input_subsystem, fullscreen);
+            break;
+        case Settings::RendererBackend::Vulkan:
+            emu_window = std::make_unique<EmuWindow_SDL2_VK>(&input_subsystem);
+            break;
+        case Settings::RendererBackend::Null:
+            emu_window = std::make_unique<EmuWindow_SDL2_Null>(&input_subsystem);
+            break;
+        }
 
-    const Core::System::ResultStatus load_result{system.Load(*emu_window, filepath)};
+        system.SetContentProvider(std::make_unique<FileSys::ContentProviderUnion>());
+        system.SetFilesystem(std::make_shared<FileSys::RealVfsFilesystem>());
+        system.GetFileSystemController().CreateFactories(*system.GetFilesystem());
+        system.GetIPCProfiler().SetEnabled(!ipc_report_path.empty());
 
-    switch (load_result) {
-    case Core::System::ResultStatus::ErrorGetLoader:
-        LOG_CRITICAL(Frontend, "Failed to obtain loader for {}!", filepath);
-        return -1;
-    case Core::System::ResultStatus::ErrorLoader:
-        LOG_CRITICAL(Frontend, "Failed to load ROM!");
-        return -1;
-    case Core::System::ResultStatus::ErrorNotInitialized:
-        LOG_CRITICAL(Frontend, "CPUCore not initialized");
-        return -1;
-    case Core::System::ResultStatus::ErrorVideoCore:
-        LOG_CRITICAL(Frontend, "Failed to initialize VideoCore!");
-        return -1;
-    case Core::System::ResultStatus::Success:
-        break; // Expected case
-    default:
-        if (static_cast<u32>(load_result) >
-            static_cast<u32>(Core::System::ResultStatus::ErrorLoader)) {
-            const u16 loader_id = static_cast<u16>(Core::System::ResultStatus::ErrorLoader);
-            const u16 error_id = static_cast<u16>(load_result) - loader_id;
-            LOG_CRITICAL(Frontend,
-                         "While attempting to load the ROM requested, an error occurred. Please "
-                         "refer to the yuzu wiki for more information or the yuzu discord for "
-                         "additional help.\n\nError Code: {:04X}-{:04X}\nError Description: {}",
-                         loader_id, error_id, static_cast<Loader::ResultStatus>(error_id));
+        const Core::System::ResultStatus load_result{system.Load(*emu_window, filepath)};
+
+        if (!CheckLoadResult(load_result, filepath)) {
+            if (!benchmark) {
+                return -1;
+            }
+            benchmark->AddFailure(filepath);
+            continue;
         }
-    }
 
-    system.TelemetrySession().AddField(Common::Telemetry::FieldType::App, "Frontend", "SDL");
+        system.TelemetrySession().AddField(Common::Telemetry::FieldType::App, "Frontend", "SDL");
+
+        // Core is loaded, start the GPU (makes the GPU contexts current to this thread)
+        system.GPU().Start();
 
-    // Core is loaded, start the GPU (makes the GPU contexts current to this thread)
-    system.GPU().Start();
+        system.GetStartupTimeline().BeginPhase("shader_cache");
+        system.Renderer().ReadRasterizer()->LoadDiskResources(
+            system.CurrentProcess()->GetTitleID(), std::stop_token{},
+            [](VideoCore::LoadCallbackStage, size_t value, size_t total) {});
+        system.GetStartupTimeline().EndPhase();
 
-    system.Renderer().ReadRasterizer()->LoadDiskResources(
-        system.CurrentProcess()->GetTitleID(), std::stop_token{},
-        [](VideoCore::LoadCallbackStage, size_t value, size_t total) {});
+        if (!trace_path.empty()) {
+            Common::TraceRecorder::RecordFrames(trace_path, trace_first_frame, trace_num_frames);
+        }
+
+        void(system.Run());
+        if (benchmark) {
+            benchmark->Begin(system, *emu_window, filepath);
+        }
+        std::jthread memory_report_thread;
+        if (memory_report_interval != 0) {
+            const std::chrono::seconds interval{memory_report_interval};
+            memory_report_thread = std::jthread([&system, interval](std::stop_token token) {
+                static constexpr auto to_mib = [](u64 bytes) { return bytes >> 20; };
+                std::mutex mutex;
+                std::condition_variable_any cv;
+                std::unique_lock lock{mutex};
+                const auto is_stopped = [&token] { return token.stop_requested(); };
+                while (!cv.wait_for(lock, token, interval, is_stopped)) {
+                    const Core::MemoryUsage usage = system.GetMemoryUsage();
+                    LOG_INFO(Frontend,
+                             "Memory: {} MiB (guest {} MiB, textures {} MiB, buffers {} MiB, "
+                             "staging {} MiB, file cache {} MiB)",
+                             to_mib(usage.Total()), to_mib(usage.guest_memory),
+                             to_mib(usage.texture_cache), to_mib(usage.buffer_cache),
+                             to_mib(usage.staging_buffers), to_mib(usage.file_cache));
+                }
+            });
+        }
+        while (emu_window->IsOpen()) {
+            emu_window->WaitEvent();
+        }
+        // Stops the memory report and the benchmark before the system is torn down
+        memory_report_thread = {};
+        if (benchmark) {
+            benchmark->End();
+        }
+        void(system.Pause());
+        Common::TraceRecorder::Finish();
+        if (!startup_report_path.empty()) {
+            const std::string report = system.GetStartupTimeline().ToJson();
+            if (Common::FS::WriteStringToFile(startup_report_path, Common::FS::FileType::TextFile,
+                                              report) != report.size()) {
+                LOG_ERROR(Frontend, "Failed to write startup report to {}", startup_report_path);
+            }
+        }
+        if (!ipc_report_path.empty()) {
+            const std::string report = system.GetIPCProfiler().ToJson();
+            if (Common::FS::WriteStringToFile(ipc_report_path, Common::FS::FileType::TextFile,
+                                              report) != report.size()) {
+                LOG_ERROR(Frontend, "Failed to write IPC report to {}", ipc_report_path);
+            }
+        }
+        system.Shutdown();
+    }
 
-    void(system.Run());
-    while (emu_window->IsOpen()) {
-        emu_window->WaitEvent();
+    int exit_code = 0;
+    if (benchmark) {
+        const std::string report = benchmark->ToJson();
+        if (Common::FS::WriteStringToFile(benchmark_report_path, Common::FS::FileType::TextFile,
+                                          report) != report.size()) {
+            LOG_ERROR(Frontend, "Failed to write benchmark report to {}", benchmark_report_path);
+            exit_code = -1;
+        }
+        // Titles that failed to boot or were closed early fail the run, so scripts notice
+        if (!benchmark->IsSuccessful()) {
+            exit_code = -1;
+        }
     }
-    void(system.Pause());
-    system.Shutdown();
 
     detached_tasks.WaitForAllTasks();
-    return 0;
+    return exit_code;
 }